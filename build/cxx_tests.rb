@@ -33,10 +33,14 @@
 
   "#{TEST_OUTPUT_DIR}cxx/Core/ApplicationPool/OptionsTest.o" =>
     "test/cxx/Core/ApplicationPool/OptionsTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/Core/ApplicationPool/DemandEstimatorTest.o" =>
+    "test/cxx/Core/ApplicationPool/DemandEstimatorTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/Core/ApplicationPool/ProcessTest.o" =>
     "test/cxx/Core/ApplicationPool/ProcessTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/Core/ApplicationPool/PoolTest.o" =>
     "test/cxx/Core/ApplicationPool/PoolTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/Core/ApplicationPool/PoolContentionTest.o" =>
+    "test/cxx/Core/ApplicationPool/PoolContentionTest.cpp",
 
   "#{TEST_OUTPUT_DIR}cxx/Core/SpawningKit/ConfigTest.o" =>
     "test/cxx/Core/SpawningKit/ConfigTest.cpp",
@@ -52,9 +56,15 @@
     "test/cxx/Core/SpawningKit/DirectSpawnerTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/Core/SpawningKit/SmartSpawnerTest.o" =>
     "test/cxx/Core/SpawningKit/SmartSpawnerTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/Core/SpawningKit/PipeWatcherTest.o" =>
+    "test/cxx/Core/SpawningKit/PipeWatcherTest.cpp",
 
+  "#{TEST_OUTPUT_DIR}cxx/Core/OpenFileCacheTest.o" =>
+    "test/cxx/Core/OpenFileCacheTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/Core/ResponseCacheTest.o" =>
     "test/cxx/Core/ResponseCacheTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/Core/ResponseCompressorTest.o" =>
+    "test/cxx/Core/ResponseCompressorTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/Core/SecurityUpdateCheckerTest.o" =>
       "test/cxx/Core/SecurityUpdateCheckerTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/Core/ControllerTest.o" =>
@@ -65,14 +75,22 @@
 
   "#{TEST_OUTPUT_DIR}cxx/ServerKit/ChannelTest.o" =>
     "test/cxx/ServerKit/ChannelTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/ServerKit/FdSourceChannelTest.o" =>
+    "test/cxx/ServerKit/FdSourceChannelTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/ServerKit/FileBufferedChannelTest.o" =>
     "test/cxx/ServerKit/FileBufferedChannelTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/ServerKit/HeaderTableTest.o" =>
     "test/cxx/ServerKit/HeaderTableTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/ServerKit/ServerTest.o" =>
     "test/cxx/ServerKit/ServerTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/ServerKit/AcceptLoadBalancerTest.o" =>
+    "test/cxx/ServerKit/AcceptLoadBalancerTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/ServerKit/HttpServerTest.o" =>
     "test/cxx/ServerKit/HttpServerTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/ServerKit/HpackTest.o" =>
+    "test/cxx/ServerKit/HpackTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/ServerKit/HttpCharScannerTest.o" =>
+    "test/cxx/ServerKit/HttpCharScannerTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/ServerKit/CookieUtilsTest.o" =>
     "test/cxx/ServerKit/CookieUtilsTest.cpp",
 
@@ -86,6 +104,8 @@
     "test/cxx/ConfigKit/TranslationTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/ConfigKit/SubSchemaTest.o" =>
     "test/cxx/ConfigKit/SubSchemaTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/LoggingKit/AsyncWriterTest.o" =>
+    "test/cxx/LoggingKit/AsyncWriterTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/MemoryKit/MbufTest.o" =>
     "test/cxx/MemoryKit/MbufTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/MemoryKit/PallocTest.o" =>
@@ -124,12 +144,18 @@
     "test/cxx/UtilsTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/Utils/StrIntUtilsTest.o" =>
     "test/cxx/Utils/StrIntUtilsTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/Utils/HasherTest.o" =>
+    "test/cxx/Utils/HasherTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/Utils/LatencyHistogramTest.o" =>
+    "test/cxx/Utils/LatencyHistogramTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/IOUtilsTest.o" =>
     "test/cxx/IOUtilsTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/TemplateTest.o" =>
     "test/cxx/TemplateTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/Base64DecodingTest.o" =>
-    "test/cxx/Base64DecodingTest.cpp"
+    "test/cxx/Base64DecodingTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/Apache2Module/AppTypeDetectionCacheTest.o" =>
+    "test/cxx/Apache2Module/AppTypeDetectionCacheTest.cpp"
 }
 
 let(:basic_test_cxx_flags) do
@@ -198,6 +224,45 @@
   )
 end
 
+# Define compilation tasks for the microbenchmarks. These are not run as
+# part of the test suite.
+TEST_CXX_BENCHMARKS = {
+  "#{TEST_OUTPUT_DIR}cxx/Benchmarks/FdSourceChannelBenchmark" =>
+    "test/cxx/Benchmarks/FdSourceChannelBenchmark.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/Benchmarks/HttpHeaderParserBenchmark" =>
+    "test/cxx/Benchmarks/HttpHeaderParserBenchmark.cpp"
+}
+
+TEST_CXX_BENCHMARKS.each_pair do |target, source|
+  object = "#{target}.o"
+  define_cxx_object_compilation_task(
+    object,
+    source,
+    lambda { {
+      :include_paths => test_cxx_include_paths,
+      :flags => basic_test_cxx_flags
+    } }
+  )
+
+  dependencies = [
+    object,
+    LIBEV_TARGET,
+    LIBUV_TARGET,
+    TEST_BOOST_OXT_LIBRARY,
+    TEST_COMMON_LIBRARY.link_objects
+  ].flatten.compact
+  file(target => dependencies) do
+    create_cxx_executable(target, object, :flags => test_cxx_ldflags)
+  end
+end
+
+desc "Run microbenchmarks for the C++ components"
+task 'test:cxx:benchmarks' => TEST_CXX_BENCHMARKS.keys do
+  TEST_CXX_BENCHMARKS.each_key do |target|
+    sh(File.expand_path(target))
+  end
+end
+
 dependencies = [
   TEST_CXX_TARGET,
   "#{TEST_OUTPUT_DIR}allocate_memory",
@@ -8,19 +8,27 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
+   "src/agent/Core/ConfigHandleRegistry.h",
    "src/agent/Core/Controller.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/Controller/LatencyStats.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseCompressor.h",
    "src/agent/Core/Controller/TurboCaching.h",
+   "src/agent/Core/OpenFileCache.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -43,6 +51,7 @@
    "src/agent/Shared/ApplicationPoolApiKey.h",
    "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/AsyncUtils.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
@@ -64,6 +73,7 @@
    "src/cxx_supportlib/InstanceDirectory.h",
    "src/cxx_supportlib/Integrations/LibevJsonUtils.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
    "src/cxx_supportlib/LoggingKit/Config.h",
    "src/cxx_supportlib/LoggingKit/Context.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
@@ -92,6 +102,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -116,6 +128,7 @@
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
@@ -153,20 +166,28 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
    "src/agent/Core/ConfigChange.h",
+   "src/agent/Core/ConfigHandleRegistry.h",
    "src/agent/Core/Controller.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/Controller/LatencyStats.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseCompressor.h",
    "src/agent/Core/Controller/TurboCaching.h",
+   "src/agent/Core/OpenFileCache.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -191,6 +212,7 @@
    "src/agent/Shared/ApplicationPoolApiKey.h",
    "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -210,6 +232,7 @@
    "src/cxx_supportlib/Hooks.h",
    "src/cxx_supportlib/Integrations/LibevJsonUtils.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
    "src/cxx_supportlib/LoggingKit/Config.h",
    "src/cxx_supportlib/LoggingKit/Context.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
@@ -237,6 +260,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -260,6 +285,7 @@
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
@@ -321,6 +347,7 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -344,6 +371,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -402,6 +430,7 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -425,6 +454,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -483,6 +513,7 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -507,6 +538,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -565,6 +597,7 @@
    "src/agent/Core/SpawningKit/SmartSpawner.h",
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -588,6 +621,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -623,12 +657,124 @@
    "src/cxx_supportlib/oxt/system_calls.hpp",
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
+ "src/agent/Core/ApplicationPool/DemandEstimator.h"=>
+  ["src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/Utils/SpeedMeter.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp"],
  "src/agent/Core/ApplicationPool/Group.h"=>
   ["src/agent/Core/ApplicationPool/AbstractSession.h",
    "src/agent/Core/ApplicationPool/BasicGroupInfo.h",
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
+   "src/agent/Core/ApplicationPool/Options.h",
+   "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/Session.h",
+   "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/SpawningKit/Config.h",
+   "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
+   "src/agent/Core/SpawningKit/Context.h",
+   "src/agent/Core/SpawningKit/DirectSpawner.h",
+   "src/agent/Core/SpawningKit/DummySpawner.h",
+   "src/agent/Core/SpawningKit/Exceptions.h",
+   "src/agent/Core/SpawningKit/Factory.h",
+   "src/agent/Core/SpawningKit/Handshake/BackgroundIOCapturer.h",
+   "src/agent/Core/SpawningKit/Handshake/Perform.h",
+   "src/agent/Core/SpawningKit/Handshake/Prepare.h",
+   "src/agent/Core/SpawningKit/Handshake/Session.h",
+   "src/agent/Core/SpawningKit/Handshake/WorkDir.h",
+   "src/agent/Core/SpawningKit/Journey.h",
+   "src/agent/Core/SpawningKit/PipeWatcher.h",
+   "src/agent/Core/SpawningKit/Result.h",
+   "src/agent/Core/SpawningKit/Result/AutoGeneratedCode.h",
+   "src/agent/Core/SpawningKit/SmartSpawner.h",
+   "src/agent/Core/SpawningKit/Spawner.h",
+   "src/agent/Core/SpawningKit/UserSwitchingRules.h",
+   "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/ConfigKit/Common.h",
+   "src/cxx_supportlib/ConfigKit/ConfigKit.h",
+   "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
+   "src/cxx_supportlib/ConfigKit/Schema.h",
+   "src/cxx_supportlib/ConfigKit/Store.h",
+   "src/cxx_supportlib/ConfigKit/Translator.h",
+   "src/cxx_supportlib/ConfigKit/Utils.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/StringKeyTable.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/FileTools/PathManip.h",
+   "src/cxx_supportlib/Hooks.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/LveLoggingDecorator.h",
+   "src/cxx_supportlib/MemoryKit/palloc.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/AnsiColorConstants.h",
+   "src/cxx_supportlib/Utils/BufferedIO.h",
+   "src/cxx_supportlib/Utils/CachedFileStat.hpp",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/HashMap.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/Lock.h",
+   "src/cxx_supportlib/Utils/MemZeroGuard.h",
+   "src/cxx_supportlib/Utils/MessageIO.h",
+   "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
+   "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/SpeedMeter.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/StringMap.h",
+   "src/cxx_supportlib/Utils/StringScanning.h",
+   "src/cxx_supportlib/Utils/SystemMetricsCollector.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/Utils/Timer.h",
+   "src/cxx_supportlib/Utils/VariantMap.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/dynamic_thread_group.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp"],
+ "src/agent/Core/ApplicationPool/Group/Autoscaling.cpp"=>
+  ["src/agent/Core/ApplicationPool/AbstractSession.h",
+   "src/agent/Core/ApplicationPool/BasicGroupInfo.h",
+   "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
+   "src/agent/Core/ApplicationPool/Common.h",
+   "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
+   "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
@@ -653,7 +799,9 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -679,6 +827,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -725,6 +874,7 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Process.h",
@@ -750,7 +900,9 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -776,6 +928,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -822,6 +975,7 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Process.h",
@@ -847,7 +1001,9 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -873,6 +1029,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -919,6 +1076,7 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Process.h",
@@ -944,7 +1102,9 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -970,6 +1130,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -1016,6 +1177,7 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Process.h",
@@ -1041,7 +1203,9 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -1067,6 +1231,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -1113,6 +1278,7 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Process.h",
@@ -1138,7 +1304,9 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -1165,6 +1333,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -1211,6 +1380,7 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Process.h",
@@ -1236,7 +1406,9 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -1262,6 +1434,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -1308,6 +1481,7 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Process.h",
@@ -1333,7 +1507,9 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -1359,6 +1535,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -1405,6 +1582,7 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Process.h",
@@ -1430,7 +1608,9 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -1456,6 +1636,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -1502,11 +1683,13 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -1527,7 +1710,9 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -1553,6 +1738,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -1599,6 +1785,7 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Process.h",
@@ -1624,7 +1811,9 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -1650,6 +1839,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -1696,7 +1886,9 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
+   "src/agent/Core/ApplicationPool/Group/Autoscaling.cpp",
    "src/agent/Core/ApplicationPool/Group/InitializationAndShutdown.cpp",
    "src/agent/Core/ApplicationPool/Group/InternalUtils.cpp",
    "src/agent/Core/ApplicationPool/Group/LifetimeAndBasics.cpp",
@@ -1710,6 +1902,8 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Pool/AnalyticsCollection.cpp",
+   "src/agent/Core/ApplicationPool/Pool/Autoscaling.cpp",
+   "src/agent/Core/ApplicationPool/Pool/ConnectionWarming.cpp",
    "src/agent/Core/ApplicationPool/Pool/GarbageCollection.cpp",
    "src/agent/Core/ApplicationPool/Pool/GeneralUtils.cpp",
    "src/agent/Core/ApplicationPool/Pool/GroupUtils.cpp",
@@ -1717,10 +1911,13 @@
    "src/agent/Core/ApplicationPool/Pool/Miscellaneous.cpp",
    "src/agent/Core/ApplicationPool/Pool/ProcessUtils.cpp",
    "src/agent/Core/ApplicationPool/Pool/StateInspection.cpp",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.cpp",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.cpp",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -1742,7 +1939,9 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -1769,6 +1968,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -1847,11 +2047,14 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -1872,7 +2075,9 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -1898,6 +2103,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -1945,12 +2151,15 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -1971,7 +2180,9 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -1997,6 +2208,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -2038,18 +2250,21 @@
    "src/cxx_supportlib/oxt/system_calls.hpp",
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
- "src/agent/Core/ApplicationPool/Pool/GarbageCollection.cpp"=>
+ "src/agent/Core/ApplicationPool/Pool/Autoscaling.cpp"=>
   ["src/agent/Core/ApplicationPool/AbstractSession.h",
    "src/agent/Core/ApplicationPool/BasicGroupInfo.h",
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -2070,7 +2285,9 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -2096,6 +2313,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -2137,18 +2355,21 @@
    "src/cxx_supportlib/oxt/system_calls.hpp",
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
- "src/agent/Core/ApplicationPool/Pool/GeneralUtils.cpp"=>
+ "src/agent/Core/ApplicationPool/Pool/ConnectionWarming.cpp"=>
   ["src/agent/Core/ApplicationPool/AbstractSession.h",
    "src/agent/Core/ApplicationPool/BasicGroupInfo.h",
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -2169,7 +2390,9 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -2195,6 +2418,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -2236,18 +2460,21 @@
    "src/cxx_supportlib/oxt/system_calls.hpp",
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
- "src/agent/Core/ApplicationPool/Pool/GroupUtils.cpp"=>
+ "src/agent/Core/ApplicationPool/Pool/GarbageCollection.cpp"=>
   ["src/agent/Core/ApplicationPool/AbstractSession.h",
    "src/agent/Core/ApplicationPool/BasicGroupInfo.h",
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -2268,7 +2495,9 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -2294,6 +2523,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -2335,18 +2565,21 @@
    "src/cxx_supportlib/oxt/system_calls.hpp",
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
- "src/agent/Core/ApplicationPool/Pool/InitializationAndShutdown.cpp"=>
+ "src/agent/Core/ApplicationPool/Pool/GeneralUtils.cpp"=>
   ["src/agent/Core/ApplicationPool/AbstractSession.h",
    "src/agent/Core/ApplicationPool/BasicGroupInfo.h",
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -2367,7 +2600,9 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -2393,6 +2628,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -2434,18 +2670,21 @@
    "src/cxx_supportlib/oxt/system_calls.hpp",
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
- "src/agent/Core/ApplicationPool/Pool/Miscellaneous.cpp"=>
+ "src/agent/Core/ApplicationPool/Pool/GroupUtils.cpp"=>
   ["src/agent/Core/ApplicationPool/AbstractSession.h",
    "src/agent/Core/ApplicationPool/BasicGroupInfo.h",
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -2466,7 +2705,9 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -2492,6 +2733,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -2533,18 +2775,21 @@
    "src/cxx_supportlib/oxt/system_calls.hpp",
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
- "src/agent/Core/ApplicationPool/Pool/ProcessUtils.cpp"=>
+ "src/agent/Core/ApplicationPool/Pool/InitializationAndShutdown.cpp"=>
   ["src/agent/Core/ApplicationPool/AbstractSession.h",
    "src/agent/Core/ApplicationPool/BasicGroupInfo.h",
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -2565,7 +2810,9 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -2591,6 +2838,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -2632,18 +2880,21 @@
    "src/cxx_supportlib/oxt/system_calls.hpp",
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
- "src/agent/Core/ApplicationPool/Pool/StateInspection.cpp"=>
+ "src/agent/Core/ApplicationPool/Pool/Miscellaneous.cpp"=>
   ["src/agent/Core/ApplicationPool/AbstractSession.h",
    "src/agent/Core/ApplicationPool/BasicGroupInfo.h",
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -2664,7 +2915,9 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -2690,6 +2943,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -2731,17 +2985,21 @@
    "src/cxx_supportlib/oxt/system_calls.hpp",
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
- "src/agent/Core/ApplicationPool/Process.cpp"=>
+ "src/agent/Core/ApplicationPool/Pool/ProcessUtils.cpp"=>
   ["src/agent/Core/ApplicationPool/AbstractSession.h",
    "src/agent/Core/ApplicationPool/BasicGroupInfo.h",
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
+   "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -2762,7 +3020,9 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -2788,6 +3048,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -2802,6 +3063,7 @@
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
+   "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
@@ -2828,15 +3090,21 @@
    "src/cxx_supportlib/oxt/system_calls.hpp",
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
- "src/agent/Core/ApplicationPool/Process.h"=>
+ "src/agent/Core/ApplicationPool/Pool/StateInspection.cpp"=>
   ["src/agent/Core/ApplicationPool/AbstractSession.h",
    "src/agent/Core/ApplicationPool/BasicGroupInfo.h",
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
+   "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
+   "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
+   "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -2857,7 +3125,9 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -2872,6 +3142,7 @@
    "src/cxx_supportlib/FileDescriptor.h",
    "src/cxx_supportlib/FileTools/FileManip.h",
    "src/cxx_supportlib/FileTools/PathManip.h",
+   "src/cxx_supportlib/Hooks.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
    "src/cxx_supportlib/LoggingKit/Logging.h",
@@ -2882,6 +3153,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -2896,6 +3168,7 @@
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
+   "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
@@ -2916,18 +3189,25 @@
    "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
    "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
    "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/dynamic_thread_group.hpp",
    "src/cxx_supportlib/oxt/macros.hpp",
    "src/cxx_supportlib/oxt/spin_lock.hpp",
    "src/cxx_supportlib/oxt/system_calls.hpp",
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
- "src/agent/Core/ApplicationPool/Session.h"=>
+ "src/agent/Core/ApplicationPool/PoolMutex.h"=>
+  ["src/cxx_supportlib/oxt/macros.hpp"],
+ "src/agent/Core/ApplicationPool/Process.cpp"=>
   ["src/agent/Core/ApplicationPool/AbstractSession.h",
    "src/agent/Core/ApplicationPool/BasicGroupInfo.h",
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
+   "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
+   "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
@@ -2949,7 +3229,9 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -2964,6 +3246,7 @@
    "src/cxx_supportlib/FileDescriptor.h",
    "src/cxx_supportlib/FileTools/FileManip.h",
    "src/cxx_supportlib/FileTools/PathManip.h",
+   "src/cxx_supportlib/Hooks.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
    "src/cxx_supportlib/LoggingKit/Logging.h",
@@ -2974,6 +3257,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -3008,15 +3292,21 @@
    "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
    "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
    "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/dynamic_thread_group.hpp",
    "src/cxx_supportlib/oxt/macros.hpp",
    "src/cxx_supportlib/oxt/spin_lock.hpp",
    "src/cxx_supportlib/oxt/system_calls.hpp",
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
- "src/agent/Core/ApplicationPool/Socket.h"=>
-  ["src/agent/Core/ApplicationPool/Common.h",
+ "src/agent/Core/ApplicationPool/Process.h"=>
+  ["src/agent/Core/ApplicationPool/AbstractSession.h",
+   "src/agent/Core/ApplicationPool/BasicGroupInfo.h",
+   "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
+   "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
    "src/agent/Core/ApplicationPool/Options.h",
+   "src/agent/Core/ApplicationPool/Session.h",
+   "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -3036,7 +3326,9 @@
    "src/agent/Core/SpawningKit/SmartSpawner.h",
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
+   "src/agent/Shared/ApplicationPoolApiKey.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -3061,6 +3353,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -3072,6 +3365,7 @@
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
@@ -3099,27 +3393,412 @@
    "src/cxx_supportlib/oxt/system_calls.hpp",
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
- "src/agent/Core/ApplicationPool/TestSession.h"=>
+ "src/agent/Core/ApplicationPool/Session.h"=>
   ["src/agent/Core/ApplicationPool/AbstractSession.h",
-   "src/agent/Shared/ApplicationPoolApiKey.h",
-   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
-   "src/cxx_supportlib/Exceptions.h",
-   "src/cxx_supportlib/FileDescriptor.h",
-   "src/cxx_supportlib/LoggingKit/Assert.h",
-   "src/cxx_supportlib/LoggingKit/Forward.h",
-   "src/cxx_supportlib/LoggingKit/Logging.h",
-   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
-   "src/cxx_supportlib/StaticString.h",
-   "src/cxx_supportlib/Utils/BufferedIO.h",
-   "src/cxx_supportlib/Utils/FastStringStream.h",
-   "src/cxx_supportlib/Utils/Hasher.h",
-   "src/cxx_supportlib/Utils/IOUtils.h",
-   "src/cxx_supportlib/Utils/StrIntUtils.h",
-   "src/cxx_supportlib/oxt/backtrace.hpp",
-   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
-   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
-   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
-   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/agent/Core/ApplicationPool/BasicGroupInfo.h",
+   "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
+   "src/agent/Core/ApplicationPool/Common.h",
+   "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/Options.h",
+   "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/SpawningKit/Config.h",
+   "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
+   "src/agent/Core/SpawningKit/Context.h",
+   "src/agent/Core/SpawningKit/DirectSpawner.h",
+   "src/agent/Core/SpawningKit/DummySpawner.h",
+   "src/agent/Core/SpawningKit/Exceptions.h",
+   "src/agent/Core/SpawningKit/Factory.h",
+   "src/agent/Core/SpawningKit/Handshake/BackgroundIOCapturer.h",
+   "src/agent/Core/SpawningKit/Handshake/Perform.h",
+   "src/agent/Core/SpawningKit/Handshake/Prepare.h",
+   "src/agent/Core/SpawningKit/Handshake/Session.h",
+   "src/agent/Core/SpawningKit/Handshake/WorkDir.h",
+   "src/agent/Core/SpawningKit/Journey.h",
+   "src/agent/Core/SpawningKit/PipeWatcher.h",
+   "src/agent/Core/SpawningKit/Result.h",
+   "src/agent/Core/SpawningKit/Result/AutoGeneratedCode.h",
+   "src/agent/Core/SpawningKit/SmartSpawner.h",
+   "src/agent/Core/SpawningKit/Spawner.h",
+   "src/agent/Core/SpawningKit/UserSwitchingRules.h",
+   "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/ConfigKit/Common.h",
+   "src/cxx_supportlib/ConfigKit/ConfigKit.h",
+   "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
+   "src/cxx_supportlib/ConfigKit/Schema.h",
+   "src/cxx_supportlib/ConfigKit/Store.h",
+   "src/cxx_supportlib/ConfigKit/Translator.h",
+   "src/cxx_supportlib/ConfigKit/Utils.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/StringKeyTable.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/FileTools/PathManip.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/LveLoggingDecorator.h",
+   "src/cxx_supportlib/MemoryKit/palloc.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/AnsiColorConstants.h",
+   "src/cxx_supportlib/Utils/BufferedIO.h",
+   "src/cxx_supportlib/Utils/CachedFileStat.hpp",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/HashMap.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/Lock.h",
+   "src/cxx_supportlib/Utils/MemZeroGuard.h",
+   "src/cxx_supportlib/Utils/MessageIO.h",
+   "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
+   "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/SpeedMeter.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/StringMap.h",
+   "src/cxx_supportlib/Utils/StringScanning.h",
+   "src/cxx_supportlib/Utils/SystemMetricsCollector.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/Utils/Timer.h",
+   "src/cxx_supportlib/Utils/VariantMap.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp"],
+ "src/agent/Core/ApplicationPool/Socket.h"=>
+  ["src/agent/Core/ApplicationPool/Common.h",
+   "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/Options.h",
+   "src/agent/Core/SpawningKit/Config.h",
+   "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
+   "src/agent/Core/SpawningKit/Context.h",
+   "src/agent/Core/SpawningKit/DirectSpawner.h",
+   "src/agent/Core/SpawningKit/DummySpawner.h",
+   "src/agent/Core/SpawningKit/Exceptions.h",
+   "src/agent/Core/SpawningKit/Factory.h",
+   "src/agent/Core/SpawningKit/Handshake/BackgroundIOCapturer.h",
+   "src/agent/Core/SpawningKit/Handshake/Perform.h",
+   "src/agent/Core/SpawningKit/Handshake/Prepare.h",
+   "src/agent/Core/SpawningKit/Handshake/Session.h",
+   "src/agent/Core/SpawningKit/Handshake/WorkDir.h",
+   "src/agent/Core/SpawningKit/Journey.h",
+   "src/agent/Core/SpawningKit/PipeWatcher.h",
+   "src/agent/Core/SpawningKit/Result.h",
+   "src/agent/Core/SpawningKit/Result/AutoGeneratedCode.h",
+   "src/agent/Core/SpawningKit/SmartSpawner.h",
+   "src/agent/Core/SpawningKit/Spawner.h",
+   "src/agent/Core/SpawningKit/UserSwitchingRules.h",
+   "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/ConfigKit/Common.h",
+   "src/cxx_supportlib/ConfigKit/ConfigKit.h",
+   "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
+   "src/cxx_supportlib/ConfigKit/Schema.h",
+   "src/cxx_supportlib/ConfigKit/Store.h",
+   "src/cxx_supportlib/ConfigKit/Translator.h",
+   "src/cxx_supportlib/ConfigKit/Utils.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/StringKeyTable.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/FileTools/PathManip.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/LveLoggingDecorator.h",
+   "src/cxx_supportlib/MemoryKit/palloc.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/AnsiColorConstants.h",
+   "src/cxx_supportlib/Utils/BufferedIO.h",
+   "src/cxx_supportlib/Utils/CachedFileStat.hpp",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/HashMap.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/MemZeroGuard.h",
+   "src/cxx_supportlib/Utils/MessageIO.h",
+   "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
+   "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/SpeedMeter.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/StringMap.h",
+   "src/cxx_supportlib/Utils/StringScanning.h",
+   "src/cxx_supportlib/Utils/SystemMetricsCollector.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/Utils/Timer.h",
+   "src/cxx_supportlib/Utils/VariantMap.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp"],
+ "src/agent/Core/ApplicationPool/StatusSnapshot.cpp"=>
+  ["src/agent/Core/ApplicationPool/AbstractSession.h",
+   "src/agent/Core/ApplicationPool/BasicGroupInfo.h",
+   "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
+   "src/agent/Core/ApplicationPool/Common.h",
+   "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
+   "src/agent/Core/ApplicationPool/Group.h",
+   "src/agent/Core/ApplicationPool/Options.h",
+   "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/Session.h",
+   "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
+   "src/agent/Core/SpawningKit/Config.h",
+   "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
+   "src/agent/Core/SpawningKit/Context.h",
+   "src/agent/Core/SpawningKit/DirectSpawner.h",
+   "src/agent/Core/SpawningKit/DummySpawner.h",
+   "src/agent/Core/SpawningKit/Exceptions.h",
+   "src/agent/Core/SpawningKit/Factory.h",
+   "src/agent/Core/SpawningKit/Handshake/BackgroundIOCapturer.h",
+   "src/agent/Core/SpawningKit/Handshake/Perform.h",
+   "src/agent/Core/SpawningKit/Handshake/Prepare.h",
+   "src/agent/Core/SpawningKit/Handshake/Session.h",
+   "src/agent/Core/SpawningKit/Handshake/WorkDir.h",
+   "src/agent/Core/SpawningKit/Journey.h",
+   "src/agent/Core/SpawningKit/PipeWatcher.h",
+   "src/agent/Core/SpawningKit/Result.h",
+   "src/agent/Core/SpawningKit/Result/AutoGeneratedCode.h",
+   "src/agent/Core/SpawningKit/SmartSpawner.h",
+   "src/agent/Core/SpawningKit/Spawner.h",
+   "src/agent/Core/SpawningKit/UserSwitchingRules.h",
+   "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/ConfigKit/Common.h",
+   "src/cxx_supportlib/ConfigKit/ConfigKit.h",
+   "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
+   "src/cxx_supportlib/ConfigKit/Schema.h",
+   "src/cxx_supportlib/ConfigKit/Store.h",
+   "src/cxx_supportlib/ConfigKit/Translator.h",
+   "src/cxx_supportlib/ConfigKit/Utils.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/StringKeyTable.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/FileTools/PathManip.h",
+   "src/cxx_supportlib/Hooks.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/LveLoggingDecorator.h",
+   "src/cxx_supportlib/MemoryKit/palloc.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/AnsiColorConstants.h",
+   "src/cxx_supportlib/Utils/BufferedIO.h",
+   "src/cxx_supportlib/Utils/CachedFileStat.hpp",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/HashMap.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/Lock.h",
+   "src/cxx_supportlib/Utils/MemZeroGuard.h",
+   "src/cxx_supportlib/Utils/MessageIO.h",
+   "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
+   "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/SpeedMeter.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/StringMap.h",
+   "src/cxx_supportlib/Utils/StringScanning.h",
+   "src/cxx_supportlib/Utils/SystemMetricsCollector.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/Utils/Timer.h",
+   "src/cxx_supportlib/Utils/VariantMap.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/dynamic_thread_group.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp"],
+ "src/agent/Core/ApplicationPool/StatusSnapshot.h"=>
+  ["src/agent/Core/ApplicationPool/AbstractSession.h",
+   "src/agent/Core/ApplicationPool/BasicGroupInfo.h",
+   "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
+   "src/agent/Core/ApplicationPool/Common.h",
+   "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
+   "src/agent/Core/ApplicationPool/Group.h",
+   "src/agent/Core/ApplicationPool/Options.h",
+   "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/Session.h",
+   "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/SpawningKit/Config.h",
+   "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
+   "src/agent/Core/SpawningKit/Context.h",
+   "src/agent/Core/SpawningKit/DirectSpawner.h",
+   "src/agent/Core/SpawningKit/DummySpawner.h",
+   "src/agent/Core/SpawningKit/Exceptions.h",
+   "src/agent/Core/SpawningKit/Factory.h",
+   "src/agent/Core/SpawningKit/Handshake/BackgroundIOCapturer.h",
+   "src/agent/Core/SpawningKit/Handshake/Perform.h",
+   "src/agent/Core/SpawningKit/Handshake/Prepare.h",
+   "src/agent/Core/SpawningKit/Handshake/Session.h",
+   "src/agent/Core/SpawningKit/Handshake/WorkDir.h",
+   "src/agent/Core/SpawningKit/Journey.h",
+   "src/agent/Core/SpawningKit/PipeWatcher.h",
+   "src/agent/Core/SpawningKit/Result.h",
+   "src/agent/Core/SpawningKit/Result/AutoGeneratedCode.h",
+   "src/agent/Core/SpawningKit/SmartSpawner.h",
+   "src/agent/Core/SpawningKit/Spawner.h",
+   "src/agent/Core/SpawningKit/UserSwitchingRules.h",
+   "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/ConfigKit/Common.h",
+   "src/cxx_supportlib/ConfigKit/ConfigKit.h",
+   "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
+   "src/cxx_supportlib/ConfigKit/Schema.h",
+   "src/cxx_supportlib/ConfigKit/Store.h",
+   "src/cxx_supportlib/ConfigKit/Translator.h",
+   "src/cxx_supportlib/ConfigKit/Utils.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/StringKeyTable.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/FileTools/PathManip.h",
+   "src/cxx_supportlib/Hooks.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/LveLoggingDecorator.h",
+   "src/cxx_supportlib/MemoryKit/palloc.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/AnsiColorConstants.h",
+   "src/cxx_supportlib/Utils/BufferedIO.h",
+   "src/cxx_supportlib/Utils/CachedFileStat.hpp",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/HashMap.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/Lock.h",
+   "src/cxx_supportlib/Utils/MemZeroGuard.h",
+   "src/cxx_supportlib/Utils/MessageIO.h",
+   "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
+   "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/SpeedMeter.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/StringMap.h",
+   "src/cxx_supportlib/Utils/StringScanning.h",
+   "src/cxx_supportlib/Utils/SystemMetricsCollector.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/Utils/Timer.h",
+   "src/cxx_supportlib/Utils/VariantMap.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/dynamic_thread_group.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp"],
+ "src/agent/Core/ApplicationPool/TestSession.h"=>
+  ["src/agent/Core/ApplicationPool/AbstractSession.h",
+   "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils/BufferedIO.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
    "src/cxx_supportlib/oxt/macros.hpp",
    "src/cxx_supportlib/oxt/system_calls.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
@@ -3131,21 +3810,29 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
    "src/agent/Core/ConfigChange.h",
+   "src/agent/Core/ConfigHandleRegistry.h",
    "src/agent/Core/Controller.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/Controller/LatencyStats.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseCompressor.h",
    "src/agent/Core/Controller/TurboCaching.h",
+   "src/agent/Core/OpenFileCache.h",
    "src/agent/Core/ResponseCache.h",
    "src/agent/Core/SecurityUpdateChecker.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -3170,6 +3857,7 @@
    "src/agent/Shared/ApplicationPoolApiKey.h",
    "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/AsyncUtils.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
@@ -3194,6 +3882,7 @@
    "src/cxx_supportlib/InstanceDirectory.h",
    "src/cxx_supportlib/Integrations/LibevJsonUtils.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
    "src/cxx_supportlib/LoggingKit/Config.h",
    "src/cxx_supportlib/LoggingKit/Context.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
@@ -3222,6 +3911,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -3247,6 +3938,7 @@
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
@@ -3286,22 +3978,30 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
    "src/agent/Core/Config.h",
    "src/agent/Core/ConfigChange.h",
+   "src/agent/Core/ConfigHandleRegistry.h",
    "src/agent/Core/Controller.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/Controller/LatencyStats.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseCompressor.h",
    "src/agent/Core/Controller/TurboCaching.h",
+   "src/agent/Core/OpenFileCache.h",
    "src/agent/Core/ResponseCache.h",
    "src/agent/Core/SecurityUpdateChecker.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -3326,6 +4026,7 @@
    "src/agent/Shared/ApplicationPoolApiKey.h",
    "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/AsyncUtils.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
@@ -3350,6 +4051,7 @@
    "src/cxx_supportlib/InstanceDirectory.h",
    "src/cxx_supportlib/Integrations/LibevJsonUtils.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
    "src/cxx_supportlib/LoggingKit/Config.h",
    "src/cxx_supportlib/LoggingKit/Context.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
@@ -3378,6 +4080,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -3403,6 +4107,7 @@
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
@@ -3460,24 +4165,38 @@
    "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
    "src/cxx_supportlib/oxt/macros.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
+ "src/agent/Core/ConfigHandleRegistry.h"=>
+  ["src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/StringKeyTable.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/oxt/macros.hpp"],
  "src/agent/Core/Controller.h"=>
   ["src/agent/Core/ApplicationPool/AbstractSession.h",
    "src/agent/Core/ApplicationPool/BasicGroupInfo.h",
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
+   "src/agent/Core/ConfigHandleRegistry.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/Controller/LatencyStats.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseCompressor.h",
    "src/agent/Core/Controller/TurboCaching.h",
+   "src/agent/Core/OpenFileCache.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -3500,6 +4219,7 @@
    "src/agent/Shared/ApplicationPoolApiKey.h",
    "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -3544,6 +4264,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -3567,6 +4289,7 @@
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
@@ -3665,19 +4388,27 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
+   "src/agent/Core/ConfigHandleRegistry.h",
    "src/agent/Core/Controller.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/Controller/LatencyStats.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseCompressor.h",
    "src/agent/Core/Controller/TurboCaching.h",
+   "src/agent/Core/OpenFileCache.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -3700,6 +4431,7 @@
    "src/agent/Shared/ApplicationPoolApiKey.h",
    "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -3744,6 +4476,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -3767,6 +4501,7 @@
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
@@ -3803,19 +4538,27 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
+   "src/agent/Core/ConfigHandleRegistry.h",
    "src/agent/Core/Controller.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/Controller/LatencyStats.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseCompressor.h",
    "src/agent/Core/Controller/TurboCaching.h",
+   "src/agent/Core/OpenFileCache.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -3839,6 +4582,7 @@
    "src/agent/Shared/ApplicationPoolApiKey.h",
    "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -3883,6 +4627,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -3906,6 +4652,7 @@
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
@@ -3943,14 +4690,18 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/Controller/LatencyStats.h",
    "src/agent/Core/Controller/Request.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
@@ -3974,6 +4725,7 @@
    "src/agent/Shared/ApplicationPoolApiKey.h",
    "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -4016,6 +4768,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -4038,6 +4792,7 @@
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
@@ -4074,19 +4829,27 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
+   "src/agent/Core/ConfigHandleRegistry.h",
    "src/agent/Core/Controller.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/Controller/LatencyStats.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseCompressor.h",
    "src/agent/Core/Controller/TurboCaching.h",
+   "src/agent/Core/OpenFileCache.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -4109,6 +4872,7 @@
    "src/agent/Shared/ApplicationPoolApiKey.h",
    "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -4153,6 +4917,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -4176,6 +4942,7 @@
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
@@ -4244,6 +5011,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -4291,19 +5060,27 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
+   "src/agent/Core/ConfigHandleRegistry.h",
    "src/agent/Core/Controller.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/Controller/LatencyStats.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseCompressor.h",
    "src/agent/Core/Controller/TurboCaching.h",
+   "src/agent/Core/OpenFileCache.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -4326,6 +5103,7 @@
    "src/agent/Shared/ApplicationPoolApiKey.h",
    "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -4370,6 +5148,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -4393,6 +5173,7 @@
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
@@ -4429,19 +5210,27 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
+   "src/agent/Core/ConfigHandleRegistry.h",
    "src/agent/Core/Controller.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/Controller/LatencyStats.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseCompressor.h",
    "src/agent/Core/Controller/TurboCaching.h",
+   "src/agent/Core/OpenFileCache.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -4464,6 +5253,7 @@
    "src/agent/Shared/ApplicationPoolApiKey.h",
    "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -4508,6 +5298,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -4531,6 +5323,7 @@
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
@@ -4567,12 +5360,16 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
+   "src/agent/Core/ConfigHandleRegistry.h",
    "src/agent/Core/Controller.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/BufferBody.cpp",
@@ -4585,12 +5382,17 @@
    "src/agent/Core/Controller/InitRequest.cpp",
    "src/agent/Core/Controller/InitializationAndShutdown.cpp",
    "src/agent/Core/Controller/InternalUtils.cpp",
+   "src/agent/Core/Controller/LatencyStats.h",
    "src/agent/Core/Controller/Miscellaneous.cpp",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseCompressor.h",
+   "src/agent/Core/Controller/SendFile.cpp",
    "src/agent/Core/Controller/SendRequest.cpp",
    "src/agent/Core/Controller/StateInspection.cpp",
    "src/agent/Core/Controller/TurboCaching.h",
+   "src/agent/Core/OpenFileCache.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -4614,6 +5416,7 @@
    "src/agent/Shared/ApplicationPoolApiKey.h",
    "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -4658,6 +5461,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -4681,6 +5486,7 @@
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
@@ -4718,19 +5524,27 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
+   "src/agent/Core/ConfigHandleRegistry.h",
    "src/agent/Core/Controller.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/Controller/LatencyStats.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseCompressor.h",
    "src/agent/Core/Controller/TurboCaching.h",
+   "src/agent/Core/OpenFileCache.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -4753,6 +5567,7 @@
    "src/agent/Shared/ApplicationPoolApiKey.h",
    "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -4797,6 +5612,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -4820,6 +5637,7 @@
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
@@ -4856,19 +5674,27 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
+   "src/agent/Core/ConfigHandleRegistry.h",
    "src/agent/Core/Controller.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/Controller/LatencyStats.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseCompressor.h",
    "src/agent/Core/Controller/TurboCaching.h",
+   "src/agent/Core/OpenFileCache.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -4891,6 +5717,7 @@
    "src/agent/Shared/ApplicationPoolApiKey.h",
    "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -4935,6 +5762,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -4958,6 +5787,7 @@
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
@@ -4994,19 +5824,27 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
+   "src/agent/Core/ConfigHandleRegistry.h",
    "src/agent/Core/Controller.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/Controller/LatencyStats.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseCompressor.h",
    "src/agent/Core/Controller/TurboCaching.h",
+   "src/agent/Core/OpenFileCache.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -5029,6 +5867,7 @@
    "src/agent/Shared/ApplicationPoolApiKey.h",
    "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -5073,6 +5912,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -5096,6 +5937,7 @@
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
@@ -5126,25 +5968,61 @@
    "src/cxx_supportlib/oxt/system_calls.hpp",
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
+ "src/agent/Core/Controller/LatencyStats.h"=>
+  ["src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
+   "src/cxx_supportlib/Utils/MemZeroGuard.h",
+   "src/cxx_supportlib/Utils/MessageIO.h",
+   "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/Utils/VariantMap.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp"],
  "src/agent/Core/Controller/Miscellaneous.cpp"=>
   ["src/agent/Core/ApplicationPool/AbstractSession.h",
    "src/agent/Core/ApplicationPool/BasicGroupInfo.h",
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
+   "src/agent/Core/ConfigHandleRegistry.h",
    "src/agent/Core/Controller.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/Controller/LatencyStats.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseCompressor.h",
    "src/agent/Core/Controller/TurboCaching.h",
+   "src/agent/Core/OpenFileCache.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -5167,6 +6045,7 @@
    "src/agent/Shared/ApplicationPoolApiKey.h",
    "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -5211,6 +6090,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -5234,6 +6115,7 @@
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
@@ -5270,14 +6152,174 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
+   "src/agent/Core/ApplicationPool/Group.h",
+   "src/agent/Core/ApplicationPool/Options.h",
+   "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
+   "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/Session.h",
+   "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
+   "src/agent/Core/Controller/AppResponse.h",
+   "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/Controller/LatencyStats.h",
+   "src/agent/Core/SpawningKit/Config.h",
+   "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
+   "src/agent/Core/SpawningKit/Context.h",
+   "src/agent/Core/SpawningKit/DirectSpawner.h",
+   "src/agent/Core/SpawningKit/DummySpawner.h",
+   "src/agent/Core/SpawningKit/Exceptions.h",
+   "src/agent/Core/SpawningKit/Factory.h",
+   "src/agent/Core/SpawningKit/Handshake/BackgroundIOCapturer.h",
+   "src/agent/Core/SpawningKit/Handshake/Perform.h",
+   "src/agent/Core/SpawningKit/Handshake/Prepare.h",
+   "src/agent/Core/SpawningKit/Handshake/Session.h",
+   "src/agent/Core/SpawningKit/Handshake/WorkDir.h",
+   "src/agent/Core/SpawningKit/Journey.h",
+   "src/agent/Core/SpawningKit/PipeWatcher.h",
+   "src/agent/Core/SpawningKit/Result.h",
+   "src/agent/Core/SpawningKit/Result/AutoGeneratedCode.h",
+   "src/agent/Core/SpawningKit/SmartSpawner.h",
+   "src/agent/Core/SpawningKit/Spawner.h",
+   "src/agent/Core/SpawningKit/UserSwitchingRules.h",
+   "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/ConfigKit/Common.h",
+   "src/cxx_supportlib/ConfigKit/ConfigKit.h",
+   "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
+   "src/cxx_supportlib/ConfigKit/Schema.h",
+   "src/cxx_supportlib/ConfigKit/SchemaUtils.h",
+   "src/cxx_supportlib/ConfigKit/Store.h",
+   "src/cxx_supportlib/ConfigKit/Translator.h",
+   "src/cxx_supportlib/ConfigKit/Utils.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/LString.h",
+   "src/cxx_supportlib/DataStructures/StringKeyTable.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/FileTools/PathManip.h",
+   "src/cxx_supportlib/Hooks.h",
+   "src/cxx_supportlib/Integrations/LibevJsonUtils.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/LveLoggingDecorator.h",
+   "src/cxx_supportlib/MemoryKit/mbuf.h",
+   "src/cxx_supportlib/MemoryKit/palloc.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
+   "src/cxx_supportlib/ServerKit/Channel.h",
+   "src/cxx_supportlib/ServerKit/Client.h",
+   "src/cxx_supportlib/ServerKit/ClientRef.h",
+   "src/cxx_supportlib/ServerKit/Config.h",
+   "src/cxx_supportlib/ServerKit/Context.h",
+   "src/cxx_supportlib/ServerKit/Errors.h",
+   "src/cxx_supportlib/ServerKit/FdSinkChannel.h",
+   "src/cxx_supportlib/ServerKit/FdSourceChannel.h",
+   "src/cxx_supportlib/ServerKit/FileBufferedChannel.h",
+   "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
+   "src/cxx_supportlib/ServerKit/HeaderTable.h",
+   "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
+   "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
+   "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
+   "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
+   "src/cxx_supportlib/ServerKit/HttpRequest.h",
+   "src/cxx_supportlib/ServerKit/HttpRequestRef.h",
+   "src/cxx_supportlib/ServerKit/HttpServer.h",
+   "src/cxx_supportlib/ServerKit/Server.h",
+   "src/cxx_supportlib/ServerKit/http_parser.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/AnsiColorConstants.h",
+   "src/cxx_supportlib/Utils/BufferedIO.h",
+   "src/cxx_supportlib/Utils/CachedFileStat.hpp",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/HashMap.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/HttpConstants.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
+   "src/cxx_supportlib/Utils/Lock.h",
+   "src/cxx_supportlib/Utils/MemZeroGuard.h",
+   "src/cxx_supportlib/Utils/MessageIO.h",
+   "src/cxx_supportlib/Utils/MessagePassing.h",
+   "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
+   "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/SpeedMeter.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/StringMap.h",
+   "src/cxx_supportlib/Utils/StringScanning.h",
+   "src/cxx_supportlib/Utils/SystemMetricsCollector.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/Utils/Timer.h",
+   "src/cxx_supportlib/Utils/VariantMap.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/dynamic_thread_group.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp"],
+ "src/agent/Core/Controller/ResponseCompressor.h"=>
+  ["src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/MemoryKit/mbuf.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp"],
+ "src/agent/Core/Controller/SendFile.cpp"=>
+  ["src/agent/Core/ApplicationPool/AbstractSession.h",
+   "src/agent/Core/ApplicationPool/BasicGroupInfo.h",
+   "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
+   "src/agent/Core/ApplicationPool/Common.h",
+   "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
+   "src/agent/Core/ConfigHandleRegistry.h",
+   "src/agent/Core/Controller.h",
    "src/agent/Core/Controller/AppResponse.h",
+   "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/Controller/LatencyStats.h",
+   "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseCompressor.h",
+   "src/agent/Core/Controller/TurboCaching.h",
+   "src/agent/Core/OpenFileCache.h",
+   "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -5300,6 +6342,7 @@
    "src/agent/Shared/ApplicationPoolApiKey.h",
    "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -5325,6 +6368,7 @@
    "src/cxx_supportlib/LveLoggingDecorator.h",
    "src/cxx_supportlib/MemoryKit/mbuf.h",
    "src/cxx_supportlib/MemoryKit/palloc.h",
+   "src/cxx_supportlib/MessageReadersWriters.h",
    "src/cxx_supportlib/ProcessManagement/Spawn.h",
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
@@ -5335,6 +6379,7 @@
    "src/cxx_supportlib/ServerKit/ClientRef.h",
    "src/cxx_supportlib/ServerKit/Config.h",
    "src/cxx_supportlib/ServerKit/Context.h",
+   "src/cxx_supportlib/ServerKit/CookieUtils.h",
    "src/cxx_supportlib/ServerKit/Errors.h",
    "src/cxx_supportlib/ServerKit/FdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/FdSourceChannel.h",
@@ -5342,6 +6387,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -5357,6 +6404,7 @@
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
    "src/cxx_supportlib/Utils/BufferedIO.h",
    "src/cxx_supportlib/Utils/CachedFileStat.hpp",
+   "src/cxx_supportlib/Utils/DateParsing.h",
    "src/cxx_supportlib/Utils/FastStringStream.h",
    "src/cxx_supportlib/Utils/HashMap.h",
    "src/cxx_supportlib/Utils/Hasher.h",
@@ -5364,6 +6412,7 @@
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
@@ -5400,19 +6449,27 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
+   "src/agent/Core/ConfigHandleRegistry.h",
    "src/agent/Core/Controller.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/Controller/LatencyStats.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseCompressor.h",
    "src/agent/Core/Controller/TurboCaching.h",
+   "src/agent/Core/OpenFileCache.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -5435,6 +6492,7 @@
    "src/agent/Shared/ApplicationPoolApiKey.h",
    "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -5479,6 +6537,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -5502,6 +6562,7 @@
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
@@ -5538,19 +6599,27 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
+   "src/agent/Core/ConfigHandleRegistry.h",
    "src/agent/Core/Controller.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/Controller/LatencyStats.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseCompressor.h",
    "src/agent/Core/Controller/TurboCaching.h",
+   "src/agent/Core/OpenFileCache.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -5573,6 +6642,7 @@
    "src/agent/Shared/ApplicationPoolApiKey.h",
    "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -5617,6 +6687,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -5640,6 +6712,7 @@
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
@@ -5672,6 +6745,7 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
  "src/agent/Core/Controller/TurboCaching.h"=>
   ["src/agent/Core/ResponseCache.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -5733,24 +6807,32 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
    "src/agent/Core/Config.h",
    "src/agent/Core/ConfigChange.cpp",
    "src/agent/Core/ConfigChange.h",
+   "src/agent/Core/ConfigHandleRegistry.h",
    "src/agent/Core/Controller.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/Controller/LatencyStats.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseCompressor.h",
    "src/agent/Core/Controller/TurboCaching.h",
+   "src/agent/Core/OpenFileCache.h",
    "src/agent/Core/OptionParser.h",
    "src/agent/Core/ResponseCache.h",
    "src/agent/Core/SecurityUpdateChecker.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -5806,6 +6888,7 @@
    "src/cxx_supportlib/Integrations/LibevJsonUtils.h",
    "src/cxx_supportlib/JsonTools/Autocast.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
    "src/cxx_supportlib/LoggingKit/Config.h",
    "src/cxx_supportlib/LoggingKit/Context.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
@@ -5835,6 +6918,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -5860,6 +6945,7 @@
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
@@ -5892,6 +6978,27 @@
    "src/cxx_supportlib/oxt/system_calls.hpp",
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
+ "src/agent/Core/OpenFileCache.h"=>
+  ["src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/HashMap.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/StringMap.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp"],
  "src/agent/Core/OptionParser.h"=>
   ["src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -5905,8 +7012,10 @@
    "src/cxx_supportlib/oxt/macros.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
  "src/agent/Core/ResponseCache.h"=>
-  ["src/cxx_supportlib/DataStructures/HashedStaticString.h",
+  ["src/agent/Core/SharedResponseCache.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
    "src/cxx_supportlib/DataStructures/LString.h",
+   "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/MemoryKit/mbuf.h",
    "src/cxx_supportlib/MemoryKit/palloc.h",
    "src/cxx_supportlib/ServerKit/CookieUtils.h",
@@ -5960,6 +7069,18 @@
    "src/cxx_supportlib/oxt/system_calls.hpp",
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
+ "src/agent/Core/SharedResponseCache.h"=>
+  ["src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/LString.h",
+   "src/cxx_supportlib/MemoryKit/mbuf.h",
+   "src/cxx_supportlib/MemoryKit/palloc.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp"],
  "src/agent/Core/SpawningKit/Config.h"=>
   ["src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/cxx_supportlib/Constants.h",
@@ -6247,6 +7368,7 @@
    "src/agent/Core/SpawningKit/SmartSpawner.h",
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -6270,6 +7392,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -6532,7 +7655,8 @@
    "src/cxx_supportlib/oxt/system_calls.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
  "src/agent/Core/SpawningKit/PipeWatcher.h"=>
-  ["src/cxx_supportlib/Constants.h",
+  ["src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
@@ -6540,10 +7664,12 @@
    "src/cxx_supportlib/LoggingKit/Forward.h",
    "src/cxx_supportlib/LoggingKit/Logging.h",
    "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/FastStringStream.h",
    "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/oxt/backtrace.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
@@ -6623,6 +7749,7 @@
    "src/agent/Core/SpawningKit/Result/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -6646,6 +7773,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -6824,6 +7952,7 @@
    "src/cxx_supportlib/FileDescriptor.h",
    "src/cxx_supportlib/FileTools/PathManip.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
    "src/cxx_supportlib/LoggingKit/Config.h",
    "src/cxx_supportlib/LoggingKit/Context.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
@@ -6897,6 +8026,7 @@
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileTools/FileManip.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
    "src/cxx_supportlib/LoggingKit/Config.h",
    "src/cxx_supportlib/LoggingKit/Context.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
@@ -6950,6 +8080,7 @@
    "src/cxx_supportlib/FileDescriptor.h",
    "src/cxx_supportlib/FileTools/FileManip.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
    "src/cxx_supportlib/LoggingKit/Config.h",
    "src/cxx_supportlib/LoggingKit/Context.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
@@ -7003,6 +8134,7 @@
    "src/cxx_supportlib/FileDescriptor.h",
    "src/cxx_supportlib/FileTools/FileManip.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
    "src/cxx_supportlib/LoggingKit/Config.h",
    "src/cxx_supportlib/LoggingKit/Context.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
@@ -7092,6 +8224,7 @@
    "src/cxx_supportlib/FileTools/FileManip.h",
    "src/cxx_supportlib/FileTools/PathManip.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
    "src/cxx_supportlib/LoggingKit/Config.h",
    "src/cxx_supportlib/LoggingKit/Context.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
@@ -7183,6 +8316,7 @@
    "src/cxx_supportlib/FileTools/PathManip.h",
    "src/cxx_supportlib/Integrations/LibevJsonUtils.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
    "src/cxx_supportlib/LoggingKit/Config.h",
    "src/cxx_supportlib/LoggingKit/Context.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
@@ -7202,6 +8336,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -7249,22 +8385,30 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
    "src/agent/Core/Config.h",
    "src/agent/Core/ConfigChange.h",
+   "src/agent/Core/ConfigHandleRegistry.h",
    "src/agent/Core/Controller.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/Controller/LatencyStats.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseCompressor.h",
    "src/agent/Core/Controller/TurboCaching.h",
+   "src/agent/Core/OpenFileCache.h",
    "src/agent/Core/ResponseCache.h",
    "src/agent/Core/SecurityUpdateChecker.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -7290,6 +8434,7 @@
    "src/agent/Watchdog/ApiServer.h",
    "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/AsyncUtils.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
@@ -7314,6 +8459,7 @@
    "src/cxx_supportlib/InstanceDirectory.h",
    "src/cxx_supportlib/Integrations/LibevJsonUtils.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
    "src/cxx_supportlib/LoggingKit/Config.h",
    "src/cxx_supportlib/LoggingKit/Context.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
@@ -7342,6 +8488,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -7367,6 +8515,7 @@
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
@@ -7436,23 +8585,31 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
    "src/agent/Core/Config.h",
    "src/agent/Core/ConfigChange.h",
+   "src/agent/Core/ConfigHandleRegistry.h",
    "src/agent/Core/Controller.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/Controller/LatencyStats.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseCompressor.h",
    "src/agent/Core/Controller/TurboCaching.h",
+   "src/agent/Core/OpenFileCache.h",
    "src/agent/Core/OptionParser.h",
    "src/agent/Core/ResponseCache.h",
    "src/agent/Core/SecurityUpdateChecker.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -7511,6 +8668,7 @@
    "src/cxx_supportlib/Integrations/LibevJsonUtils.h",
    "src/cxx_supportlib/JsonTools/Autocast.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
    "src/cxx_supportlib/LoggingKit/Config.h",
    "src/cxx_supportlib/LoggingKit/Context.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
@@ -7539,6 +8697,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -7564,6 +8724,7 @@
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
@@ -7590,11 +8751,38 @@
    "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
    "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
    "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
-   "src/cxx_supportlib/oxt/dynamic_thread_group.hpp",
+   "src/cxx_supportlib/oxt/dynamic_thread_group.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp"],
+ "src/apache2_module/AppTypeDetectionCache.h"=>
+  ["src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/FileTools/PathManip.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/CachedFileStat.hpp",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/HashMap.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/StringMap.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
    "src/cxx_supportlib/oxt/macros.hpp",
-   "src/cxx_supportlib/oxt/spin_lock.hpp",
    "src/cxx_supportlib/oxt/system_calls.hpp",
-   "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
  "src/apache2_module/Bucket.cpp"=>
   ["src/apache2_module/Bucket.h",
@@ -7812,7 +9000,8 @@
  "src/apache2_module/DirConfig/AutoGeneratedStruct.h"=>
   [],
  "src/apache2_module/DirectoryMapper.h"=>
-  ["src/apache2_module/Config.h",
+  ["src/apache2_module/AppTypeDetectionCache.h",
+   "src/apache2_module/Config.h",
    "src/apache2_module/DirConfig/AutoGeneratedStruct.h",
    "src/apache2_module/ServerConfig/AutoGeneratedStruct.h",
    "src/cxx_supportlib/AppTypes.h",
@@ -7843,7 +9032,8 @@
    "src/cxx_supportlib/oxt/system_calls.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
  "src/apache2_module/Hooks.cpp"=>
-  ["src/apache2_module/Bucket.h",
+  ["src/apache2_module/AppTypeDetectionCache.h",
+   "src/apache2_module/Bucket.h",
    "src/apache2_module/Config.h",
    "src/apache2_module/DirConfig/AutoGeneratedHeaderSerialization.cpp",
    "src/apache2_module/DirConfig/AutoGeneratedStruct.h",
@@ -7867,6 +9057,7 @@
    "src/cxx_supportlib/FileTools/PathManip.h",
    "src/cxx_supportlib/JsonTools/CBindings.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
    "src/cxx_supportlib/LoggingKit/Config.h",
    "src/cxx_supportlib/LoggingKit/Context.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
@@ -8421,6 +9612,16 @@
    "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
    "src/cxx_supportlib/oxt/macros.hpp"],
+ "src/cxx_supportlib/LoggingKit/AsyncWriter.h"=>
+  ["src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp"],
  "src/cxx_supportlib/LoggingKit/Config.h"=>
   ["src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -8431,6 +9632,7 @@
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
    "src/cxx_supportlib/LoggingKit/Logging.h",
    "src/cxx_supportlib/LoggingKit/LoggingKit.h",
@@ -8441,9 +9643,17 @@
    "src/cxx_supportlib/oxt/backtrace.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
    "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
    "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
    "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
  "src/cxx_supportlib/LoggingKit/Context.h"=>
   ["src/cxx_supportlib/ConfigKit/Common.h",
@@ -8457,6 +9667,7 @@
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
    "src/cxx_supportlib/LoggingKit/Config.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
    "src/cxx_supportlib/LoggingKit/Logging.h",
@@ -8498,6 +9709,7 @@
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileTools/PathManip.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
    "src/cxx_supportlib/LoggingKit/Config.h",
    "src/cxx_supportlib/LoggingKit/Context.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
@@ -9167,6 +10379,74 @@
    "src/cxx_supportlib/oxt/macros.hpp"],
  "src/cxx_supportlib/ServerKit/Hooks.h"=>
   [],
+ "src/cxx_supportlib/ServerKit/Hpack.cpp"=>
+  ["src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/oxt/macros.hpp"],
+ "src/cxx_supportlib/ServerKit/Hpack.h"=>
+  ["src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/oxt/macros.hpp"],
+ "src/cxx_supportlib/ServerKit/Http2Session.h"=>
+  ["src/cxx_supportlib/ConfigKit/Common.h",
+   "src/cxx_supportlib/ConfigKit/ConfigKit.h",
+   "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
+   "src/cxx_supportlib/ConfigKit/Schema.h",
+   "src/cxx_supportlib/ConfigKit/Store.h",
+   "src/cxx_supportlib/ConfigKit/Translator.h",
+   "src/cxx_supportlib/ConfigKit/Utils.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/StringKeyTable.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/PathManip.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/MemoryKit/mbuf.h",
+   "src/cxx_supportlib/SafeLibev.h",
+   "src/cxx_supportlib/ServerKit/Channel.h",
+   "src/cxx_supportlib/ServerKit/Config.h",
+   "src/cxx_supportlib/ServerKit/Context.h",
+   "src/cxx_supportlib/ServerKit/Errors.h",
+   "src/cxx_supportlib/ServerKit/FdSourceChannel.h",
+   "src/cxx_supportlib/ServerKit/FileBufferedChannel.h",
+   "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
+   "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/http_parser.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/MemZeroGuard.h",
+   "src/cxx_supportlib/Utils/MessageIO.h",
+   "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/Utils/VariantMap.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp"],
+ "src/cxx_supportlib/ServerKit/HttpCharScanner.cpp"=>
+  ["src/cxx_supportlib/ServerKit/HttpCharScanner.h"],
+ "src/cxx_supportlib/ServerKit/HttpCharScanner.h"=>
+  [],
  "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h"=>
   ["src/cxx_supportlib/ServerKit/Errors.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
@@ -9409,6 +10689,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -9511,7 +10793,8 @@
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
  "src/cxx_supportlib/ServerKit/http_parser.cpp"=>
-  ["src/cxx_supportlib/ServerKit/http_parser.h"],
+  ["src/cxx_supportlib/ServerKit/HttpCharScanner.h",
+   "src/cxx_supportlib/ServerKit/http_parser.h"],
  "src/cxx_supportlib/ServerKit/http_parser.h"=>
   [],
  "src/cxx_supportlib/StaticString.h"=>
@@ -9716,6 +10999,33 @@
    "src/cxx_supportlib/oxt/macros.hpp",
    "src/cxx_supportlib/oxt/system_calls.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
+ "src/cxx_supportlib/Utils/LatencyHistogram.h"=>
+  ["src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/MemZeroGuard.h",
+   "src/cxx_supportlib/Utils/MessageIO.h",
+   "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/Utils/VariantMap.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp"],
  "src/cxx_supportlib/Utils/Lock.h"=>
   [],
  "src/cxx_supportlib/Utils/MemZeroGuard.h"=>
@@ -9943,6 +11253,7 @@
    "src/cxx_supportlib/FileTools/FileManip.h",
    "src/cxx_supportlib/JsonTools/CBindings.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
    "src/cxx_supportlib/LoggingKit/Config.h",
    "src/cxx_supportlib/LoggingKit/Context.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
@@ -9996,6 +11307,7 @@
    "src/cxx_supportlib/FileTools/FileManip.h",
    "src/cxx_supportlib/JsonTools/CBindings.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
    "src/cxx_supportlib/LoggingKit/Config.h",
    "src/cxx_supportlib/LoggingKit/Context.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
@@ -10351,6 +11663,7 @@
    "src/cxx_supportlib/FileTools/PathManip.h",
    "src/cxx_supportlib/JsonTools/CBindings.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
    "src/cxx_supportlib/LoggingKit/Config.h",
    "src/cxx_supportlib/LoggingKit/Context.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
@@ -10402,22 +11715,30 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
    "src/agent/Core/Config.h",
    "src/agent/Core/ConfigChange.h",
+   "src/agent/Core/ConfigHandleRegistry.h",
    "src/agent/Core/Controller.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/Controller/LatencyStats.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseCompressor.h",
    "src/agent/Core/Controller/TurboCaching.h",
+   "src/agent/Core/OpenFileCache.h",
    "src/agent/Core/ResponseCache.h",
    "src/agent/Core/SecurityUpdateChecker.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -10444,6 +11765,7 @@
    "src/agent/Watchdog/Config.h",
    "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/AsyncUtils.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
@@ -10468,6 +11790,7 @@
    "src/cxx_supportlib/InstanceDirectory.h",
    "src/cxx_supportlib/Integrations/LibevJsonUtils.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
    "src/cxx_supportlib/LoggingKit/Config.h",
    "src/cxx_supportlib/LoggingKit/Context.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
@@ -10496,6 +11819,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -10521,21 +11846,163 @@
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
-   "src/cxx_supportlib/Utils/SpeedMeter.h",
+   "src/cxx_supportlib/Utils/SpeedMeter.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/StringMap.h",
+   "src/cxx_supportlib/Utils/StringScanning.h",
+   "src/cxx_supportlib/Utils/SystemMetricsCollector.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/Utils/Timer.h",
+   "src/cxx_supportlib/Utils/VariantMap.h",
+   "src/cxx_supportlib/WebSocketCommandReverseServer.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/dynamic_thread_group.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp"],
+ "test/cxx/Apache2Module/AppTypeDetectionCacheTest.cpp"=>
+  ["src/apache2_module/AppTypeDetectionCache.h",
+   "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/FileTools/PathManip.h",
+   "src/cxx_supportlib/InstanceDirectory.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/CachedFileStat.hpp",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/HashMap.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/StringMap.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp",
+   "test/cxx/TestSupport.h",
+   "test/tut/tut.h"],
+ "test/cxx/Base64DecodingTest.cpp"=>
+  ["src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/InstanceDirectory.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp",
+   "test/cxx/TestSupport.h",
+   "test/tut/tut.h"],
+ "test/cxx/Benchmarks/FdSourceChannelBenchmark.cpp"=>
+  ["src/cxx_supportlib/ConfigKit/Common.h",
+   "src/cxx_supportlib/ConfigKit/ConfigKit.h",
+   "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
+   "src/cxx_supportlib/ConfigKit/Schema.h",
+   "src/cxx_supportlib/ConfigKit/Store.h",
+   "src/cxx_supportlib/ConfigKit/Translator.h",
+   "src/cxx_supportlib/ConfigKit/Utils.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/StringKeyTable.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/PathManip.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/MemoryKit/mbuf.h",
+   "src/cxx_supportlib/SafeLibev.h",
+   "src/cxx_supportlib/ServerKit/Channel.h",
+   "src/cxx_supportlib/ServerKit/Config.h",
+   "src/cxx_supportlib/ServerKit/Context.h",
+   "src/cxx_supportlib/ServerKit/FdSourceChannel.h",
+   "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/MemZeroGuard.h",
+   "src/cxx_supportlib/Utils/MessageIO.h",
+   "src/cxx_supportlib/Utils/ScopeGuard.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
-   "src/cxx_supportlib/Utils/StringMap.h",
-   "src/cxx_supportlib/Utils/StringScanning.h",
-   "src/cxx_supportlib/Utils/SystemMetricsCollector.h",
    "src/cxx_supportlib/Utils/SystemTime.h",
-   "src/cxx_supportlib/Utils/Timer.h",
    "src/cxx_supportlib/Utils/VariantMap.h",
-   "src/cxx_supportlib/WebSocketCommandReverseServer.h",
    "src/cxx_supportlib/oxt/backtrace.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
@@ -10546,13 +12013,25 @@
    "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
    "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
    "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
-   "src/cxx_supportlib/oxt/dynamic_thread_group.hpp",
    "src/cxx_supportlib/oxt/macros.hpp",
    "src/cxx_supportlib/oxt/spin_lock.hpp",
    "src/cxx_supportlib/oxt/system_calls.hpp",
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
- "test/cxx/Base64DecodingTest.cpp"=>
+ "test/cxx/Benchmarks/HttpHeaderParserBenchmark.cpp"=>
+  ["src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/ServerKit/HttpCharScanner.h",
+   "src/cxx_supportlib/ServerKit/http_parser.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp"],
+ "test/cxx/BufferedIOTest.cpp"=>
   ["src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
@@ -10570,12 +12049,14 @@
    "src/cxx_supportlib/ResourceLocator.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/BufferedIO.h",
    "src/cxx_supportlib/Utils/FastStringStream.h",
    "src/cxx_supportlib/Utils/Hasher.h",
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/Utils/Timer.h",
    "src/cxx_supportlib/oxt/backtrace.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
@@ -10593,7 +12074,7 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
- "test/cxx/BufferedIOTest.cpp"=>
+ "test/cxx/CachedFileStatTest.cpp"=>
   ["src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
@@ -10611,14 +12092,15 @@
    "src/cxx_supportlib/ResourceLocator.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
-   "src/cxx_supportlib/Utils/BufferedIO.h",
+   "src/cxx_supportlib/Utils/CachedFileStat.hpp",
    "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/HashMap.h",
    "src/cxx_supportlib/Utils/Hasher.h",
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/StringMap.h",
    "src/cxx_supportlib/Utils/SystemTime.h",
-   "src/cxx_supportlib/Utils/Timer.h",
    "src/cxx_supportlib/oxt/backtrace.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
@@ -10636,8 +12118,9 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
- "test/cxx/CachedFileStatTest.cpp"=>
+ "test/cxx/ConfigKit/ErrorTest.cpp"=>
   ["src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -10654,14 +12137,11 @@
    "src/cxx_supportlib/ResourceLocator.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
-   "src/cxx_supportlib/Utils/CachedFileStat.hpp",
    "src/cxx_supportlib/Utils/FastStringStream.h",
-   "src/cxx_supportlib/Utils/HashMap.h",
    "src/cxx_supportlib/Utils/Hasher.h",
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
-   "src/cxx_supportlib/Utils/StringMap.h",
    "src/cxx_supportlib/Utils/SystemTime.h",
    "src/cxx_supportlib/oxt/backtrace.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
@@ -10680,11 +12160,16 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
- "test/cxx/ConfigKit/ErrorTest.cpp"=>
+ "test/cxx/ConfigKit/SchemaTest.cpp"=>
   ["src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
+   "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
+   "src/cxx_supportlib/ConfigKit/Schema.h",
+   "src/cxx_supportlib/ConfigKit/Translator.h",
+   "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
    "src/cxx_supportlib/FileTools/FileManip.h",
@@ -10722,11 +12207,12 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
- "test/cxx/ConfigKit/SchemaTest.cpp"=>
+ "test/cxx/ConfigKit/StoreTest.cpp"=>
   ["src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
    "src/cxx_supportlib/ConfigKit/Schema.h",
+   "src/cxx_supportlib/ConfigKit/Store.h",
    "src/cxx_supportlib/ConfigKit/Translator.h",
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
@@ -10769,12 +12255,14 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
- "test/cxx/ConfigKit/StoreTest.cpp"=>
+ "test/cxx/ConfigKit/SubSchemaTest.cpp"=>
   ["src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
+   "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
    "src/cxx_supportlib/ConfigKit/Schema.h",
    "src/cxx_supportlib/ConfigKit/Store.h",
+   "src/cxx_supportlib/ConfigKit/TableTranslator.h",
    "src/cxx_supportlib/ConfigKit/Translator.h",
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
@@ -10817,16 +12305,12 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
- "test/cxx/ConfigKit/SubSchemaTest.cpp"=>
+ "test/cxx/ConfigKit/TranslationTest.cpp"=>
   ["src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
-   "src/cxx_supportlib/ConfigKit/ConfigKit.h",
-   "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
-   "src/cxx_supportlib/ConfigKit/Schema.h",
-   "src/cxx_supportlib/ConfigKit/Store.h",
+   "src/cxx_supportlib/ConfigKit/PrefixTranslator.h",
    "src/cxx_supportlib/ConfigKit/TableTranslator.h",
    "src/cxx_supportlib/ConfigKit/Translator.h",
-   "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
@@ -10867,35 +12351,132 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
- "test/cxx/ConfigKit/TranslationTest.cpp"=>
-  ["src/cxx_supportlib/BackgroundEventLoop.h",
+ "test/cxx/Core/ApplicationPool/DemandEstimatorTest.cpp"=>
+  ["src/agent/Core/ApplicationPool/DemandEstimator.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/InstanceDirectory.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/SpeedMeter.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp",
+   "test/cxx/TestSupport.h",
+   "test/tut/tut.h"],
+ "test/cxx/Core/ApplicationPool/OptionsTest.cpp"=>
+  ["src/agent/Core/ApplicationPool/AbstractSession.h",
+   "src/agent/Core/ApplicationPool/BasicGroupInfo.h",
+   "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
+   "src/agent/Core/ApplicationPool/Common.h",
+   "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/Options.h",
+   "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/Session.h",
+   "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/SpawningKit/Config.h",
+   "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
+   "src/agent/Core/SpawningKit/Context.h",
+   "src/agent/Core/SpawningKit/DirectSpawner.h",
+   "src/agent/Core/SpawningKit/DummySpawner.h",
+   "src/agent/Core/SpawningKit/Exceptions.h",
+   "src/agent/Core/SpawningKit/Factory.h",
+   "src/agent/Core/SpawningKit/Handshake/BackgroundIOCapturer.h",
+   "src/agent/Core/SpawningKit/Handshake/Perform.h",
+   "src/agent/Core/SpawningKit/Handshake/Prepare.h",
+   "src/agent/Core/SpawningKit/Handshake/Session.h",
+   "src/agent/Core/SpawningKit/Handshake/WorkDir.h",
+   "src/agent/Core/SpawningKit/Journey.h",
+   "src/agent/Core/SpawningKit/PipeWatcher.h",
+   "src/agent/Core/SpawningKit/Result.h",
+   "src/agent/Core/SpawningKit/Result/AutoGeneratedCode.h",
+   "src/agent/Core/SpawningKit/SmartSpawner.h",
+   "src/agent/Core/SpawningKit/Spawner.h",
+   "src/agent/Core/SpawningKit/UserSwitchingRules.h",
+   "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
-   "src/cxx_supportlib/ConfigKit/PrefixTranslator.h",
-   "src/cxx_supportlib/ConfigKit/TableTranslator.h",
+   "src/cxx_supportlib/ConfigKit/ConfigKit.h",
+   "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
+   "src/cxx_supportlib/ConfigKit/Schema.h",
+   "src/cxx_supportlib/ConfigKit/Store.h",
    "src/cxx_supportlib/ConfigKit/Translator.h",
+   "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
    "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/FileTools/PathManip.h",
    "src/cxx_supportlib/InstanceDirectory.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
    "src/cxx_supportlib/LoggingKit/Logging.h",
    "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/LveLoggingDecorator.h",
+   "src/cxx_supportlib/MemoryKit/palloc.h",
    "src/cxx_supportlib/ProcessManagement/Spawn.h",
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/AnsiColorConstants.h",
+   "src/cxx_supportlib/Utils/BufferedIO.h",
+   "src/cxx_supportlib/Utils/CachedFileStat.hpp",
    "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/HashMap.h",
    "src/cxx_supportlib/Utils/Hasher.h",
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/Lock.h",
+   "src/cxx_supportlib/Utils/MemZeroGuard.h",
+   "src/cxx_supportlib/Utils/MessageIO.h",
+   "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
+   "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/StringMap.h",
+   "src/cxx_supportlib/Utils/StringScanning.h",
+   "src/cxx_supportlib/Utils/SystemMetricsCollector.h",
    "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/Utils/Timer.h",
+   "src/cxx_supportlib/Utils/VariantMap.h",
    "src/cxx_supportlib/oxt/backtrace.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
@@ -10913,16 +12494,21 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
- "test/cxx/Core/ApplicationPool/OptionsTest.cpp"=>
+ "test/cxx/Core/ApplicationPool/PoolContentionTest.cpp"=>
   ["src/agent/Core/ApplicationPool/AbstractSession.h",
    "src/agent/Core/ApplicationPool/BasicGroupInfo.h",
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
+   "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
+   "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -10943,6 +12529,7 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
@@ -10959,8 +12546,12 @@
    "src/cxx_supportlib/FileDescriptor.h",
    "src/cxx_supportlib/FileTools/FileManip.h",
    "src/cxx_supportlib/FileTools/PathManip.h",
+   "src/cxx_supportlib/Hooks.h",
    "src/cxx_supportlib/InstanceDirectory.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
+   "src/cxx_supportlib/LoggingKit/Config.h",
+   "src/cxx_supportlib/LoggingKit/Context.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
    "src/cxx_supportlib/LoggingKit/Logging.h",
    "src/cxx_supportlib/LoggingKit/LoggingKit.h",
@@ -10970,6 +12561,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -10984,6 +12576,7 @@
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
+   "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
@@ -11004,6 +12597,7 @@
    "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
    "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
    "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/dynamic_thread_group.hpp",
    "src/cxx_supportlib/oxt/macros.hpp",
    "src/cxx_supportlib/oxt/spin_lock.hpp",
    "src/cxx_supportlib/oxt/system_calls.hpp",
@@ -11017,12 +12611,15 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -11043,6 +12640,7 @@
    "src/agent/Core/SpawningKit/Spawner.h",
    "src/agent/Core/SpawningKit/UserSwitchingRules.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
@@ -11062,6 +12660,7 @@
    "src/cxx_supportlib/Hooks.h",
    "src/cxx_supportlib/InstanceDirectory.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
    "src/cxx_supportlib/LoggingKit/Config.h",
    "src/cxx_supportlib/LoggingKit/Context.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
@@ -11074,6 +12673,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -11165,6 +12765,7 @@
    "src/cxx_supportlib/FileTools/PathManip.h",
    "src/cxx_supportlib/InstanceDirectory.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
    "src/cxx_supportlib/LoggingKit/Config.h",
    "src/cxx_supportlib/LoggingKit/Context.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
@@ -11176,6 +12777,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -11223,20 +12825,28 @@
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
    "src/agent/Core/ApplicationPool/TestSession.h",
+   "src/agent/Core/ConfigHandleRegistry.h",
    "src/agent/Core/Controller.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/Controller/LatencyStats.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseCompressor.h",
    "src/agent/Core/Controller/TurboCaching.h",
+   "src/agent/Core/OpenFileCache.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -11305,6 +12915,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -11328,6 +12940,7 @@
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
@@ -11360,22 +12973,71 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
+ "test/cxx/Core/OpenFileCacheTest.cpp"=>
+  ["src/agent/Core/OpenFileCache.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/InstanceDirectory.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/HashMap.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/StringMap.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp",
+   "test/cxx/TestSupport.h",
+   "test/tut/tut.h"],
  "test/cxx/Core/ResponseCacheTest.cpp"=>
   ["src/agent/Core/ApplicationPool/AbstractSession.h",
    "src/agent/Core/ApplicationPool/BasicGroupInfo.h",
    "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
    "src/agent/Core/ApplicationPool/Common.h",
    "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/DemandEstimator.h",
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/PoolMutex.h",
    "src/agent/Core/ApplicationPool/Process.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/ApplicationPool/StatusSnapshot.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/Controller/LatencyStats.h",
    "src/agent/Core/Controller/Request.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/Config/AutoGeneratedCode.h",
    "src/agent/Core/SpawningKit/Context.h",
@@ -11443,6 +13105,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -11466,6 +13130,7 @@
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
    "src/cxx_supportlib/Utils/Lock.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
@@ -11498,6 +13163,49 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
+ "test/cxx/Core/ResponseCompressorTest.cpp"=>
+  ["src/agent/Core/Controller/ResponseCompressor.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/InstanceDirectory.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/MemoryKit/mbuf.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp",
+   "test/cxx/TestSupport.h",
+   "test/tut/tut.h"],
  "test/cxx/Core/SecurityUpdateCheckerTest.cpp"=>
   ["src/agent/Core/SecurityUpdateChecker.h",
    "src/cxx_supportlib/BackgroundEventLoop.h",
@@ -11629,6 +13337,7 @@
    "src/cxx_supportlib/FileTools/PathManip.h",
    "src/cxx_supportlib/InstanceDirectory.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
    "src/cxx_supportlib/LoggingKit/Config.h",
    "src/cxx_supportlib/LoggingKit/Context.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
@@ -11708,6 +13417,7 @@
    "src/cxx_supportlib/FileTools/PathManip.h",
    "src/cxx_supportlib/InstanceDirectory.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
    "src/cxx_supportlib/LoggingKit/Config.h",
    "src/cxx_supportlib/LoggingKit/Context.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
@@ -11869,6 +13579,49 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
+ "test/cxx/Core/SpawningKit/PipeWatcherTest.cpp"=>
+  ["src/agent/Core/SpawningKit/PipeWatcher.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/InstanceDirectory.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp",
+   "test/cxx/TestSupport.h",
+   "test/tut/tut.h"],
  "test/cxx/Core/SpawningKit/SmartSpawnerTest.cpp"=>
   ["src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/SpawningKit/Config.h",
@@ -11905,6 +13658,7 @@
    "src/cxx_supportlib/FileTools/PathManip.h",
    "src/cxx_supportlib/InstanceDirectory.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
    "src/cxx_supportlib/LoggingKit/Config.h",
    "src/cxx_supportlib/LoggingKit/Context.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
@@ -11915,6 +13669,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/AnsiColorConstants.h",
@@ -12078,7 +13833,220 @@
   ["src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
-   "src/cxx_supportlib/DataStructures/LString.h",
+   "src/cxx_supportlib/DataStructures/LString.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/InstanceDirectory.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/MemoryKit/mbuf.h",
+   "src/cxx_supportlib/MemoryKit/palloc.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp",
+   "test/cxx/TestSupport.h",
+   "test/tut/tut.h"],
+ "test/cxx/DataStructures/StringKeyTableTest.cpp"=>
+  ["src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/StringKeyTable.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/InstanceDirectory.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp",
+   "test/cxx/TestSupport.h",
+   "test/tut/tut.h"],
+ "test/cxx/DateParsingTest.cpp"=>
+  ["src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/InstanceDirectory.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/DateParsing.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp",
+   "test/cxx/TestSupport.h",
+   "test/tut/tut.h"],
+ "test/cxx/FileChangeCheckerTest.cpp"=>
+  ["src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/InstanceDirectory.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/CachedFileStat.hpp",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/FileChangeChecker.h",
+   "src/cxx_supportlib/Utils/HashMap.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/StringMap.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp",
+   "test/cxx/TestSupport.h",
+   "test/tut/tut.h"],
+ "test/cxx/FileDescriptorTest.cpp"=>
+  ["src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/InstanceDirectory.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp",
+   "test/cxx/TestSupport.h",
+   "test/tut/tut.h"],
+ "test/cxx/IOUtilsTest.cpp"=>
+  ["src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
    "src/cxx_supportlib/FileTools/FileManip.h",
@@ -12087,8 +14055,6 @@
    "src/cxx_supportlib/LoggingKit/Forward.h",
    "src/cxx_supportlib/LoggingKit/Logging.h",
    "src/cxx_supportlib/LoggingKit/LoggingKit.h",
-   "src/cxx_supportlib/MemoryKit/mbuf.h",
-   "src/cxx_supportlib/MemoryKit/palloc.h",
    "src/cxx_supportlib/ProcessManagement/Spawn.h",
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
@@ -12118,8 +14084,15 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
- "test/cxx/DataStructures/StringKeyTableTest.cpp"=>
+ "test/cxx/LoggingKit/AsyncWriterTest.cpp"=>
   ["src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/ConfigKit/Common.h",
+   "src/cxx_supportlib/ConfigKit/ConfigKit.h",
+   "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
+   "src/cxx_supportlib/ConfigKit/Schema.h",
+   "src/cxx_supportlib/ConfigKit/Store.h",
+   "src/cxx_supportlib/ConfigKit/Translator.h",
+   "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
@@ -12128,6 +14101,9 @@
    "src/cxx_supportlib/FileTools/FileManip.h",
    "src/cxx_supportlib/InstanceDirectory.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/AsyncWriter.h",
+   "src/cxx_supportlib/LoggingKit/Config.h",
+   "src/cxx_supportlib/LoggingKit/Context.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
    "src/cxx_supportlib/LoggingKit/Logging.h",
    "src/cxx_supportlib/LoggingKit/LoggingKit.h",
@@ -12160,7 +14136,7 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
- "test/cxx/DateParsingTest.cpp"=>
+ "test/cxx/MemoryKit/MbufTest.cpp"=>
   ["src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
@@ -12172,13 +14148,13 @@
    "src/cxx_supportlib/LoggingKit/Forward.h",
    "src/cxx_supportlib/LoggingKit/Logging.h",
    "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/MemoryKit/mbuf.h",
    "src/cxx_supportlib/ProcessManagement/Spawn.h",
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
-   "src/cxx_supportlib/Utils/DateParsing.h",
    "src/cxx_supportlib/Utils/FastStringStream.h",
    "src/cxx_supportlib/Utils/Hasher.h",
    "src/cxx_supportlib/Utils/IOUtils.h",
@@ -12202,7 +14178,7 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
- "test/cxx/FileChangeCheckerTest.cpp"=>
+ "test/cxx/MemoryKit/PallocTest.cpp"=>
   ["src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
@@ -12214,21 +14190,18 @@
    "src/cxx_supportlib/LoggingKit/Forward.h",
    "src/cxx_supportlib/LoggingKit/Logging.h",
    "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/MemoryKit/palloc.h",
    "src/cxx_supportlib/ProcessManagement/Spawn.h",
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
-   "src/cxx_supportlib/Utils/CachedFileStat.hpp",
    "src/cxx_supportlib/Utils/FastStringStream.h",
-   "src/cxx_supportlib/Utils/FileChangeChecker.h",
-   "src/cxx_supportlib/Utils/HashMap.h",
    "src/cxx_supportlib/Utils/Hasher.h",
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
-   "src/cxx_supportlib/Utils/StringMap.h",
    "src/cxx_supportlib/Utils/SystemTime.h",
    "src/cxx_supportlib/oxt/backtrace.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
@@ -12247,7 +14220,7 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
- "test/cxx/FileDescriptorTest.cpp"=>
+ "test/cxx/MessageIOTest.cpp"=>
   ["src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
@@ -12269,6 +14242,9 @@
    "src/cxx_supportlib/Utils/Hasher.h",
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/MemZeroGuard.h",
+   "src/cxx_supportlib/Utils/MessageIO.h",
+   "src/cxx_supportlib/Utils/ScopeGuard.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/SystemTime.h",
    "src/cxx_supportlib/oxt/backtrace.hpp",
@@ -12288,7 +14264,7 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
- "test/cxx/IOUtilsTest.cpp"=>
+ "test/cxx/MessagePassingTest.cpp"=>
   ["src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
@@ -12310,8 +14286,14 @@
    "src/cxx_supportlib/Utils/Hasher.h",
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/MemZeroGuard.h",
+   "src/cxx_supportlib/Utils/MessageIO.h",
+   "src/cxx_supportlib/Utils/MessagePassing.h",
+   "src/cxx_supportlib/Utils/ScopeGuard.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/Utils/Timer.h",
+   "src/cxx_supportlib/Utils/VariantMap.h",
    "src/cxx_supportlib/oxt/backtrace.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
@@ -12329,7 +14311,7 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
- "test/cxx/MemoryKit/MbufTest.cpp"=>
+ "test/cxx/MessageReadersWritersTest.cpp"=>
   ["src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
@@ -12341,7 +14323,7 @@
    "src/cxx_supportlib/LoggingKit/Forward.h",
    "src/cxx_supportlib/LoggingKit/Logging.h",
    "src/cxx_supportlib/LoggingKit/LoggingKit.h",
-   "src/cxx_supportlib/MemoryKit/mbuf.h",
+   "src/cxx_supportlib/MessageReadersWriters.h",
    "src/cxx_supportlib/ProcessManagement/Spawn.h",
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
@@ -12352,6 +14334,7 @@
    "src/cxx_supportlib/Utils/Hasher.h",
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/SystemTime.h",
    "src/cxx_supportlib/oxt/backtrace.hpp",
@@ -12371,7 +14354,7 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
- "test/cxx/MemoryKit/PallocTest.cpp"=>
+ "test/cxx/ProcessMetricsCollectorTest.cpp"=>
   ["src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
@@ -12383,7 +14366,6 @@
    "src/cxx_supportlib/LoggingKit/Forward.h",
    "src/cxx_supportlib/LoggingKit/Logging.h",
    "src/cxx_supportlib/LoggingKit/LoggingKit.h",
-   "src/cxx_supportlib/MemoryKit/palloc.h",
    "src/cxx_supportlib/ProcessManagement/Spawn.h",
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
@@ -12394,7 +14376,10 @@
    "src/cxx_supportlib/Utils/Hasher.h",
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
+   "src/cxx_supportlib/Utils/ScopeGuard.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/StringScanning.h",
    "src/cxx_supportlib/Utils/SystemTime.h",
    "src/cxx_supportlib/oxt/backtrace.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
@@ -12413,33 +14398,60 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
- "test/cxx/MessageIOTest.cpp"=>
-  ["src/cxx_supportlib/BackgroundEventLoop.h",
+ "test/cxx/ServerKit/AcceptLoadBalancerTest.cpp"=>
+  ["src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/ConfigKit/Common.h",
+   "src/cxx_supportlib/ConfigKit/ConfigKit.h",
+   "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
+   "src/cxx_supportlib/ConfigKit/Schema.h",
+   "src/cxx_supportlib/ConfigKit/Store.h",
+   "src/cxx_supportlib/ConfigKit/Translator.h",
+   "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
    "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/FileTools/PathManip.h",
    "src/cxx_supportlib/InstanceDirectory.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
    "src/cxx_supportlib/LoggingKit/Logging.h",
    "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/MemoryKit/mbuf.h",
    "src/cxx_supportlib/ProcessManagement/Spawn.h",
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
+   "src/cxx_supportlib/ServerKit/AcceptLoadBalancer.h",
+   "src/cxx_supportlib/ServerKit/Channel.h",
+   "src/cxx_supportlib/ServerKit/Client.h",
+   "src/cxx_supportlib/ServerKit/ClientRef.h",
+   "src/cxx_supportlib/ServerKit/Config.h",
+   "src/cxx_supportlib/ServerKit/Context.h",
+   "src/cxx_supportlib/ServerKit/Errors.h",
+   "src/cxx_supportlib/ServerKit/FdSourceChannel.h",
+   "src/cxx_supportlib/ServerKit/FileBufferedChannel.h",
+   "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
+   "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Server.h",
+   "src/cxx_supportlib/ServerKit/http_parser.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/FastStringStream.h",
    "src/cxx_supportlib/Utils/Hasher.h",
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/JsonUtils.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/Utils/VariantMap.h",
    "src/cxx_supportlib/oxt/backtrace.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
@@ -12457,35 +14469,49 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
- "test/cxx/MessagePassingTest.cpp"=>
+ "test/cxx/ServerKit/ChannelTest.cpp"=>
   ["src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/ConfigKit/Common.h",
+   "src/cxx_supportlib/ConfigKit/ConfigKit.h",
+   "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
+   "src/cxx_supportlib/ConfigKit/Schema.h",
+   "src/cxx_supportlib/ConfigKit/Store.h",
+   "src/cxx_supportlib/ConfigKit/Translator.h",
+   "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
    "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/FileTools/PathManip.h",
    "src/cxx_supportlib/InstanceDirectory.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
    "src/cxx_supportlib/LoggingKit/Logging.h",
    "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/MemoryKit/mbuf.h",
    "src/cxx_supportlib/ProcessManagement/Spawn.h",
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
+   "src/cxx_supportlib/ServerKit/Channel.h",
+   "src/cxx_supportlib/ServerKit/Config.h",
+   "src/cxx_supportlib/ServerKit/Context.h",
+   "src/cxx_supportlib/ServerKit/Hooks.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/FastStringStream.h",
    "src/cxx_supportlib/Utils/Hasher.h",
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/JsonUtils.h",
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
-   "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/SystemTime.h",
-   "src/cxx_supportlib/Utils/Timer.h",
    "src/cxx_supportlib/Utils/VariantMap.h",
    "src/cxx_supportlib/oxt/backtrace.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
@@ -12504,10 +14530,11 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
- "test/cxx/MessageReadersWritersTest.cpp"=>
+ "test/cxx/ServerKit/CookieUtilsTest.cpp"=>
   ["src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
    "src/cxx_supportlib/FileTools/FileManip.h",
@@ -12516,18 +14543,19 @@
    "src/cxx_supportlib/LoggingKit/Forward.h",
    "src/cxx_supportlib/LoggingKit/Logging.h",
    "src/cxx_supportlib/LoggingKit/LoggingKit.h",
-   "src/cxx_supportlib/MessageReadersWriters.h",
+   "src/cxx_supportlib/MemoryKit/mbuf.h",
+   "src/cxx_supportlib/MemoryKit/palloc.h",
    "src/cxx_supportlib/ProcessManagement/Spawn.h",
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/ServerKit/CookieUtils.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/FastStringStream.h",
    "src/cxx_supportlib/Utils/Hasher.h",
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
-   "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/SystemTime.h",
    "src/cxx_supportlib/oxt/backtrace.hpp",
@@ -12547,33 +14575,51 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
- "test/cxx/ProcessMetricsCollectorTest.cpp"=>
+ "test/cxx/ServerKit/FdSourceChannelTest.cpp"=>
   ["src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/ConfigKit/Common.h",
+   "src/cxx_supportlib/ConfigKit/ConfigKit.h",
+   "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
+   "src/cxx_supportlib/ConfigKit/Schema.h",
+   "src/cxx_supportlib/ConfigKit/Store.h",
+   "src/cxx_supportlib/ConfigKit/Translator.h",
+   "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
    "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/FileTools/PathManip.h",
    "src/cxx_supportlib/InstanceDirectory.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
    "src/cxx_supportlib/LoggingKit/Logging.h",
    "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/MemoryKit/mbuf.h",
    "src/cxx_supportlib/ProcessManagement/Spawn.h",
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
+   "src/cxx_supportlib/ServerKit/Channel.h",
+   "src/cxx_supportlib/ServerKit/Config.h",
+   "src/cxx_supportlib/ServerKit/Context.h",
+   "src/cxx_supportlib/ServerKit/FdSourceChannel.h",
+   "src/cxx_supportlib/ServerKit/Hooks.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/FastStringStream.h",
    "src/cxx_supportlib/Utils/Hasher.h",
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
-   "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
+   "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/MemZeroGuard.h",
+   "src/cxx_supportlib/Utils/MessageIO.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
-   "src/cxx_supportlib/Utils/StringScanning.h",
    "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/Utils/VariantMap.h",
    "src/cxx_supportlib/oxt/backtrace.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
@@ -12591,7 +14637,7 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
- "test/cxx/ServerKit/ChannelTest.cpp"=>
+ "test/cxx/ServerKit/FileBufferedChannelTest.cpp"=>
   ["src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
@@ -12621,7 +14667,10 @@
    "src/cxx_supportlib/ServerKit/Channel.h",
    "src/cxx_supportlib/ServerKit/Config.h",
    "src/cxx_supportlib/ServerKit/Context.h",
+   "src/cxx_supportlib/ServerKit/Errors.h",
+   "src/cxx_supportlib/ServerKit/FileBufferedChannel.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/http_parser.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/FastStringStream.h",
@@ -12652,7 +14701,7 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
- "test/cxx/ServerKit/CookieUtilsTest.cpp"=>
+ "test/cxx/ServerKit/HeaderTableTest.cpp"=>
   ["src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
@@ -12671,7 +14720,7 @@
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
-   "src/cxx_supportlib/ServerKit/CookieUtils.h",
+   "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/FastStringStream.h",
@@ -12697,53 +14746,31 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
- "test/cxx/ServerKit/FileBufferedChannelTest.cpp"=>
+ "test/cxx/ServerKit/HpackTest.cpp"=>
   ["src/cxx_supportlib/BackgroundEventLoop.h",
-   "src/cxx_supportlib/ConfigKit/Common.h",
-   "src/cxx_supportlib/ConfigKit/ConfigKit.h",
-   "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
-   "src/cxx_supportlib/ConfigKit/Schema.h",
-   "src/cxx_supportlib/ConfigKit/Store.h",
-   "src/cxx_supportlib/ConfigKit/Translator.h",
-   "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
-   "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
    "src/cxx_supportlib/FileTools/FileManip.h",
-   "src/cxx_supportlib/FileTools/PathManip.h",
    "src/cxx_supportlib/InstanceDirectory.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
    "src/cxx_supportlib/LoggingKit/Logging.h",
    "src/cxx_supportlib/LoggingKit/LoggingKit.h",
-   "src/cxx_supportlib/MemoryKit/mbuf.h",
    "src/cxx_supportlib/ProcessManagement/Spawn.h",
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
-   "src/cxx_supportlib/SafeLibev.h",
-   "src/cxx_supportlib/ServerKit/Channel.h",
-   "src/cxx_supportlib/ServerKit/Config.h",
-   "src/cxx_supportlib/ServerKit/Context.h",
-   "src/cxx_supportlib/ServerKit/Errors.h",
-   "src/cxx_supportlib/ServerKit/FileBufferedChannel.h",
-   "src/cxx_supportlib/ServerKit/Hooks.h",
-   "src/cxx_supportlib/ServerKit/http_parser.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/FastStringStream.h",
    "src/cxx_supportlib/Utils/Hasher.h",
    "src/cxx_supportlib/Utils/IOUtils.h",
    "src/cxx_supportlib/Utils/IniFile.h",
-   "src/cxx_supportlib/Utils/JsonUtils.h",
-   "src/cxx_supportlib/Utils/MemZeroGuard.h",
-   "src/cxx_supportlib/Utils/MessageIO.h",
-   "src/cxx_supportlib/Utils/ScopeGuard.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/SystemTime.h",
-   "src/cxx_supportlib/Utils/VariantMap.h",
    "src/cxx_supportlib/oxt/backtrace.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
@@ -12761,11 +14788,10 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
- "test/cxx/ServerKit/HeaderTableTest.cpp"=>
+ "test/cxx/ServerKit/HttpCharScannerTest.cpp"=>
   ["src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
-   "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
    "src/cxx_supportlib/FileTools/FileManip.h",
@@ -12774,13 +14800,12 @@
    "src/cxx_supportlib/LoggingKit/Forward.h",
    "src/cxx_supportlib/LoggingKit/Logging.h",
    "src/cxx_supportlib/LoggingKit/LoggingKit.h",
-   "src/cxx_supportlib/MemoryKit/mbuf.h",
-   "src/cxx_supportlib/MemoryKit/palloc.h",
    "src/cxx_supportlib/ProcessManagement/Spawn.h",
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
-   "src/cxx_supportlib/ServerKit/HeaderTable.h",
+   "src/cxx_supportlib/ServerKit/HttpCharScanner.h",
+   "src/cxx_supportlib/ServerKit/http_parser.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/FastStringStream.h",
@@ -12848,6 +14873,8 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Hpack.h",
+   "src/cxx_supportlib/ServerKit/Http2Session.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
@@ -13282,6 +15309,97 @@
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/tut/tut.h"],
+ "test/cxx/Utils/HasherTest.cpp"=>
+  ["src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/LString.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/InstanceDirectory.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/MemoryKit/mbuf.h",
+   "src/cxx_supportlib/MemoryKit/palloc.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp",
+   "test/cxx/TestSupport.h",
+   "test/tut/tut.h"],
+ "test/cxx/Utils/LatencyHistogramTest.cpp"=>
+  ["src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/InstanceDirectory.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/LatencyHistogram.h",
+   "src/cxx_supportlib/Utils/MemZeroGuard.h",
+   "src/cxx_supportlib/Utils/MessageIO.h",
+   "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/Utils/VariantMap.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp",
+   "test/cxx/TestSupport.h",
+   "test/tut/tut.h"],
  "test/cxx/Utils/StrIntUtilsTest.cpp"=>
   ["src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/Constants.h",
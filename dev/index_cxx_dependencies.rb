@@ -73,6 +73,7 @@
   alloca.h
   features.h
   cxxabi.h
+  immintrin.h
 
   unistd.h
   signal.h
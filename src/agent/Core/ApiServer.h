@@ -28,6 +28,7 @@
 
 #include <boost/config.hpp>
 #include <boost/scoped_ptr.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/regex.hpp>
 #include <oxt/thread.hpp>
 #include <string>
@@ -69,6 +70,8 @@ using namespace std;
  *   accept_burst_count             unsigned integer   -   default(32)
  *   authorizations                 array              -   default("[FILTERED]"),secret
  *   client_freelist_limit          unsigned integer   -   default(0)
+ *   http2                          boolean            -   default(false)
+ *   http2_max_concurrent_streams   unsigned integer   -   default(100)
  *   instance_dir                   string             -   -
  *   min_spare_clients              unsigned integer   -   default(0)
  *   request_freelist_limit         unsigned integer   -   default(1024)
@@ -117,6 +120,7 @@ public:
 	Authorization authorization;
 	unsigned int controllerStatesGathered;
 	vector<Json::Value> controllerStates;
+	RequestLatencyStatsMap latencyStats;
 
 	DEFINE_SERVER_KIT_BASE_HTTP_REQUEST_FOOTER(Passenger::Core::ApiServer::Request);
 };
@@ -157,12 +161,16 @@ private:
 	void route(Client *client, Request *req, const StaticString &path) {
 		if (path == P_STATIC_STRING("/server.json")) {
 			processServerStatus(client, req);
+		} else if (path == P_STATIC_STRING("/request_latency.json")) {
+			processRequestLatency(client, req);
 		} else if (regex_match(path, serverConnectionPath)) {
 			processServerConnectionOperation(client, req);
 		} else if (path == P_STATIC_STRING("/pool.xml")) {
 			processPoolStatusXml(client, req);
 		} else if (path == P_STATIC_STRING("/pool.txt")) {
 			processPoolStatusTxt(client, req);
+		} else if (path == P_STATIC_STRING("/pool.json")) {
+			processPoolStatusJson(client, req);
 		} else if (path == P_STATIC_STRING("/pool/restart_app_group.json")) {
 			processPoolRestartAppGroup(client, req);
 		} else if (path == P_STATIC_STRING("/pool/detach_process.json")) {
@@ -263,6 +271,9 @@ private:
 				string key = "thread" + toString(i + 1);
 				response[key] = req->controllerStates[i];
 			}
+			if (LoggingKit::context != NULL) {
+				response["async_log_writer"] = LoggingKit::context->inspectAsyncWriterState();
+			}
 
 			writeSimpleResponse(client, 200, &headers,
 				psg_pstrdup(req->pool, response.toStyledString()));
@@ -289,6 +300,81 @@ private:
 		}
 	}
 
+	void gatherLatencyStats(Client *client, Request *req, Controller *controller) {
+		boost::shared_ptr<RequestLatencyStatsMap> stats =
+			boost::make_shared<RequestLatencyStatsMap>();
+		controller->collectLatencyStats(*stats);
+		getContext()->libev->runLater(boost::bind(&ApiServer::latencyStatsGathered,
+			this, client, req, stats));
+	}
+
+	void latencyStatsGathered(Client *client, Request *req,
+		boost::shared_ptr<RequestLatencyStatsMap> stats)
+	{
+		if (req->ended()) {
+			unrefRequest(req, __FILE__, __LINE__);
+			return;
+		}
+
+		RequestLatencyStatsMap::const_iterator it, end = stats->end();
+		for (it = stats->begin(); it != end; it++) {
+			req->latencyStats[it->first].merge(it->second);
+		}
+		req->controllerStatesGathered++;
+
+		if (req->controllerStatesGathered == controllers.size()) {
+			HeaderTable headers;
+			headers.insert(req->pool, "Content-Type", "application/json");
+
+			Json::Value response;
+			Json::Value groups(Json::objectValue);
+			end = req->latencyStats.end();
+			for (it = req->latencyStats.begin(); it != end; it++) {
+				groups[it->first] = it->second.inspectAsJson();
+			}
+			response["threads"] = (Json::UInt) controllers.size();
+			response["app_groups"] = groups;
+
+			writeSimpleResponse(client, 200, &headers,
+				psg_pstrdup(req->pool, response.toStyledString()));
+			if (!req->ended()) {
+				Request *req2 = req;
+				endRequest(&client, &req2);
+			}
+		}
+
+		unrefRequest(req, __FILE__, __LINE__);
+	}
+
+	void processRequestLatency(Client *client, Request *req) {
+		if (authorizeStateInspectionOperation(this, client, req)) {
+			for (unsigned int i = 0; i < controllers.size(); i++) {
+				refRequest(req, __FILE__, __LINE__);
+				controllers[i]->getContext()->libev->runLater(boost::bind(
+					&ApiServer::gatherLatencyStats, this,
+					client, req, controllers[i]));
+			}
+		} else {
+			apiServerRespondWith401(this, client, req);
+		}
+	}
+
+	void respondWithPoolStatusUnauthorized(Client *client, Request *req) {
+		HeaderTable headers;
+		headers.insert(req->pool, "Cache-Control", "no-cache, no-store, must-revalidate");
+		headers.insert(req->pool, "WWW-Authenticate", "Basic realm=\"api\"");
+		if (clientOnUnixDomainSocket(client) && appPool->getGroupCount() == 0) {
+			// Allow admin tools that connected through the Unix domain socket
+			// to know that this authorization error is caused by the fact
+			// that the pool is empty.
+			headers.insert(req->pool, "Pool-Empty", "true");
+		}
+		writeSimpleResponse(client, 401, &headers, "Unauthorized");
+		if (!req->ended()) {
+			endRequest(&client, &req);
+		}
+	}
+
 	void processPoolStatusXml(Client *client, Request *req) {
 		Authorization auth(authorize(this, client, req));
 		if (auth.canReadPool) {
@@ -305,19 +391,7 @@ private:
 				endRequest(&client, &req);
 			}
 		} else {
-			HeaderTable headers;
-			headers.insert(req->pool, "Cache-Control", "no-cache, no-store, must-revalidate");
-			headers.insert(req->pool, "WWW-Authenticate", "Basic realm=\"api\"");
-			if (clientOnUnixDomainSocket(client) && appPool->getGroupCount() == 0) {
-				// Allow admin tools that connected through the Unix domain socket
-				// to know that this authorization error is caused by the fact
-				// that the pool is empty.
-				headers.insert(req->pool, "Pool-Empty", "true");
-			}
-			writeSimpleResponse(client, 401, &headers, "Unauthorized");
-			if (!req->ended()) {
-				endRequest(&client, &req);
-			}
+			respondWithPoolStatusUnauthorized(client, req);
 		}
 	}
 
@@ -337,19 +411,27 @@ private:
 				endRequest(&client, &req);
 			}
 		} else {
+			respondWithPoolStatusUnauthorized(client, req);
+		}
+	}
+
+	void processPoolStatusJson(Client *client, Request *req) {
+		Authorization auth(authorize(this, client, req));
+		if (auth.canReadPool) {
+			ApplicationPool2::Pool::ToXmlOptions options(
+				parseQueryString(req->getQueryString()));
+			options.uid = auth.uid;
+			options.apiKey = auth.apiKey;
+
 			HeaderTable headers;
-			headers.insert(req->pool, "Cache-Control", "no-cache, no-store, must-revalidate");
-			headers.insert(req->pool, "WWW-Authenticate", "Basic realm=\"api\"");
-			if (clientOnUnixDomainSocket(client) && appPool->getGroupCount() == 0) {
-				// Allow admin tools that connected through the Unix domain socket
-				// to know that this authorization error is caused by the fact
-				// that the pool is empty.
-				headers.insert(req->pool, "Pool-Empty", "true");
-			}
-			writeSimpleResponse(client, 401, &headers, "Unauthorized");
+			headers.insert(req->pool, "Content-Type", "application/json");
+			writeSimpleResponse(client, 200, &headers,
+				psg_pstrdup(req->pool, appPool->toCompactJson(options)));
 			if (!req->ended()) {
 				endRequest(&client, &req);
 			}
+		} else {
+			respondWithPoolStatusUnauthorized(client, req);
 		}
 	}
 
@@ -674,6 +756,7 @@ protected:
 		}
 		req->authorization = Authorization();
 		req->controllerStates.clear();
+		req->latencyStats.clear();
 		ParentClass::deinitializeRequest(client, req);
 	}
 
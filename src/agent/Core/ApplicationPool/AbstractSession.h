@@ -55,8 +55,28 @@ public:
 	virtual int fd() const = 0;
 	virtual bool isClosed() const = 0;
 
+	/**
+	 * In non-blocking mode, the connection with the process may not be
+	 * established by the time this method returns. In that case
+	 * isConnecting() returns true, and one must call continueConnecting()
+	 * until it returns true before using fd(). If canPollForConnect() is
+	 * true then one can wait until fd() becomes writable before doing so,
+	 * otherwise one must retry after a short delay.
+	 */
 	virtual void initiate(bool blocking = true) = 0;
 
+	virtual bool isConnecting() const {
+		return false;
+	}
+
+	virtual bool canPollForConnect() const {
+		return true;
+	}
+
+	virtual bool continueConnecting() {
+		return true;
+	}
+
 	virtual void requestOOBW() { /* Do nothing */ }
 
 	/**
@@ -0,0 +1,196 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_APPLICATION_POOL2_DEMAND_ESTIMATOR_H_
+#define _PASSENGER_APPLICATION_POOL2_DEMAND_ESTIMATOR_H_
+
+#include <algorithm>
+#include <cmath>
+#include <boost/config.hpp>
+#include <Algorithms/MovingAverage.h>
+#include <Utils/SpeedMeter.h>
+
+namespace Passenger {
+namespace ApplicationPool2 {
+
+using namespace std;
+
+
+/**
+ * Estimates the future demand on a Group, for the purpose of predictive
+ * autoscaling. It must be fed, about once per second, with the total number
+ * of sessions that the Group has opened so far and with the number of
+ * requests that the Group is currently handling or queuing (its concurrency).
+ *
+ * From that, it keeps track of:
+ *
+ *  - The request arrival rate over the last few seconds (through SpeedMeter),
+ *    and a moving average of that rate over the last few minutes. Their ratio
+ *    tells whether traffic is growing, so that processes can be spawned
+ *    before the concurrency itself has caught up. This is what allows
+ *    spawning ahead of the leading edge of a burst.
+ *  - A moving average and standard deviation of the concurrency. The
+ *    predicted concurrency is the average plus two standard deviations,
+ *    scaled by the arrival rate growth. Because the average decays with a
+ *    half-life of 30 seconds, the prediction (and thus the number of processes
+ *    that are kept around) goes down gradually after a burst.
+ *
+ * This class is not thread-safe.
+ */
+class DemandEstimator {
+private:
+	SpeedMeter<unsigned long long, 4, 500000, 10 * 1000000, 1000000> arrivalSpeedMeter;
+	DiscExpMovingAverage<500, 60 * 1000000, 1000000> longTermArrivalRate;
+	DiscExpMovingAverageWithStddev<500, 30 * 1000000, 1000000> concurrency;
+	double arrivalRate;
+	double lastConcurrency;
+
+public:
+	/** The maximum factor by which arrival rate growth scales the prediction. */
+	static const unsigned int MAX_GROWTH_FACTOR = 4;
+	/**
+	 * Predicted concurrencies below this are considered to be no demand at
+	 * all, so that an app that only receives the occasional request doesn't
+	 * keep a process around forever.
+	 */
+	static BOOST_CONSTEXPR double MIN_DEMAND() {
+		return 0.1;
+	}
+
+	DemandEstimator()
+		: arrivalRate(-1),
+		  lastConcurrency(0)
+		{ }
+
+	/**
+	 * @param totalArrivals The total number of sessions opened so far.
+	 * @param currentConcurrency The number of sessions that are currently open,
+	 *                           plus the number of requests that are queued.
+	 * @param now The current time, as returned by SystemTime::getUsec().
+	 */
+	void update(unsigned long long totalArrivals, double currentConcurrency,
+		unsigned long long now)
+	{
+		arrivalSpeedMeter.addSample(totalArrivals, now);
+		double speed = arrivalSpeedMeter.currentSpeed();
+		if (speed == SpeedMeter<unsigned long long>::unknownSpeed() || speed < 0) {
+			arrivalRate = -1;
+		} else {
+			arrivalRate = speed;
+			longTermArrivalRate.update(speed, now);
+		}
+		concurrency.update(currentConcurrency, now);
+		lastConcurrency = currentConcurrency;
+	}
+
+	/**
+	 * Whether enough data has been collected for the estimates
+	 * to be meaningful.
+	 */
+	bool available() const {
+		return concurrency.available();
+	}
+
+	/** Requests per second over the last few seconds, or -1 if not yet known. */
+	double getArrivalRate() const {
+		return arrivalRate;
+	}
+
+	/** Requests per second over the last few minutes, or -1 if not yet known. */
+	double getLongTermArrivalRate() const {
+		if (longTermArrivalRate.available()) {
+			return longTermArrivalRate.average();
+		} else {
+			return -1;
+		}
+	}
+
+	double getAverageConcurrency() const {
+		if (concurrency.available()) {
+			return concurrency.average();
+		} else {
+			return 0;
+		}
+	}
+
+	double getConcurrencyStddev() const {
+		if (concurrency.available()) {
+			double result = concurrency.stddev();
+			if (result != result) {
+				// NaN: rounding errors made the variance slightly negative.
+				return 0;
+			} else {
+				return result;
+			}
+		} else {
+			return 0;
+		}
+	}
+
+	/**
+	 * How much faster requests arrive now, compared to the long-term
+	 * average. At least 1 and at most MAX_GROWTH_FACTOR.
+	 */
+	double getGrowthFactor() const {
+		double longTerm = getLongTermArrivalRate();
+		if (arrivalRate <= 0 || longTerm <= 0) {
+			return 1;
+		} else {
+			return std::max(1.0, std::min<double>(MAX_GROWTH_FACTOR,
+				arrivalRate / longTerm));
+		}
+	}
+
+	double getPredictedConcurrency() const {
+		double expected = getAverageConcurrency() + 2 * getConcurrencyStddev();
+		return std::max(expected * getGrowthFactor(), lastConcurrency);
+	}
+
+	/**
+	 * The number of processes needed to handle the predicted concurrency,
+	 * given the number of concurrent sessions that a single process can
+	 * handle (where 0 means unlimited).
+	 */
+	unsigned int processesNeeded(int processConcurrency) const {
+		double predicted = getPredictedConcurrency();
+		if (predicted < MIN_DEMAND()) {
+			return 0;
+		} else if (processConcurrency <= 0) {
+			return 1;
+		} else {
+			// Allow a little bit of slack so that an average that is
+			// a tiny bit above a whole number of processes doesn't
+			// cause another process to be kept around.
+			return (unsigned int) std::max(1.0,
+				ceil(predicted / processConcurrency - 0.01));
+		}
+	}
+};
+
+
+} // namespace ApplicationPool2
+} // namespace Passenger
+
+#endif /* _PASSENGER_APPLICATION_POOL2_DEMAND_ESTIMATOR_H_ */
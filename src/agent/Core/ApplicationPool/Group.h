@@ -27,6 +27,7 @@
 #define _PASSENGER_APPLICATION_POOL2_GROUP_H_
 
 #include <string>
+#include <vector>
 #include <map>
 #include <queue>
 #include <deque>
@@ -51,6 +52,7 @@
 #include <Core/ApplicationPool/Common.h>
 #include <Core/ApplicationPool/Context.h>
 #include <Core/ApplicationPool/BasicGroupInfo.h>
+#include <Core/ApplicationPool/DemandEstimator.h>
 #include <Core/ApplicationPool/Process.h>
 #include <Core/ApplicationPool/Options.h>
 #include <Core/SpawningKit/Factory.h>
@@ -65,6 +67,9 @@ using namespace std;
 using namespace boost;
 using namespace oxt;
 
+struct GroupStatusSnapshot;
+struct ProcessSessionStatus;
+
 
 /**
  * Except for otherwise documented parts, this class is not thread-safe,
@@ -135,7 +140,10 @@ public:
 	 */
 	unsigned int restartsInitiated;
 	/**
-	 * The number of processes that are being spawned right now.
+	 * The number of processes that are being spawned right now. Each spawner
+	 * thread accounts for one process. There are at most
+	 * `options.spawnConcurrency` of them, although a restart may temporarily
+	 * leave aborted spawner threads running without them being counted here.
 	 *
 	 * Invariant:
 	 *     if processesBeingSpawned > 0: m_spawning
@@ -155,9 +163,9 @@ public:
 	 */
 	boost::atomic<boost::uint8_t> lifeStatus;
 	/**
-	 * Whether the spawner thread is currently working. Note that even
-	 * if it's working, it doesn't necessarily mean that processes are
-	 * being spawned (i.e. that processesBeingSpawned > 0). After the
+	 * Whether at least one spawner thread is currently working. Note that even
+	 * if one is working, it doesn't necessarily mean that processes are
+	 * being spawned (i.e. that processesBeingSpawned > 0). After a
 	 * thread is done spawning a process, it will attempt to attach
 	 * the newly-spawned process to the group. During that time it's not
 	 * technically spawning anything.
@@ -187,10 +195,47 @@ public:
 	 * whether any of the Processes can be shut down.
 	 */
 	bool detachedProcessesCheckerActive;
-	boost::condition_variable detachedProcessesCheckerCond;
+	boost::condition_variable_any detachedProcessesCheckerCond;
 	Callback shutdownCallback;
 	GroupPtr selfPointer;
 
+	/**
+	 * Serializes the session checkout/checkin fast paths of this Group.
+	 * Only used together with holding `pool->syncher` in fast path mode.
+	 * See PoolMutex.
+	 */
+	boost::mutex fastPathSyncher;
+
+	/**
+	 * The total number of sessions that this Group has opened so far. Part
+	 * of the session accounting state, so it is also updated on the fast path.
+	 * It's safe for the value to wrap around.
+	 */
+	unsigned long long sessionsOpened;
+
+	/**
+	 * Estimates future demand from the request arrival rate and concurrency
+	 * history. Only updated while predictive autoscaling is enabled.
+	 */
+	DemandEstimator demandEstimator;
+	/**
+	 * The number of processes that predictive autoscaling wants this Group to
+	 * have, based on `demandEstimator`. It acts as an additional lower bound
+	 * on the number of processes, next to `options.minProcesses`. 0 if
+	 * predictive autoscaling is disabled.
+	 */
+	unsigned int autoscalingTarget;
+
+	/**
+	 * Incremented every time the state that is reported by the pool status
+	 * inspection methods changes, so that `Pool::captureStatusSnapshot()` can
+	 * reuse the previous snapshot of this Group if it didn't change. Opening
+	 * and closing sessions doesn't count: the session counters are read
+	 * separately by `captureSessionStatus()`, so the fast path never has to
+	 * update this. It's safe for the value to wrap around.
+	 */
+	unsigned int statusVersion;
+
 
 	/****** Initialization and shutdown ******/
 
@@ -208,6 +253,9 @@ public:
 	static void _onSessionClose(Session *session);
 	OXT_FORCE_INLINE void onSessionInitiateFailure(Process *process, Session *session);
 	OXT_FORCE_INLINE void onSessionClose(Process *process, Session *session);
+	bool restartCheckDue(const Options &options) const;
+	bool tryGetFast(const Options &newOptions, SessionPtr &session);
+	bool tryCloseSessionFast(Process *process, Session *session);
 
 	/****** Spawning and restarting ******/
 
@@ -215,6 +263,8 @@ public:
 		unsigned int restartsInitiated);
 	void spawnThreadRealMain(const SpawningKit::SpawnerPtr &spawner, const Options &options,
 		unsigned int restartsInitiated);
+	void createSpawnThread();
+	bool shouldSpawnInParallel() const;
 	void finalizeRestart(GroupPtr self, Options oldOptions, Options newOptions,
 		RestartMethod method, SpawningKit::FactoryPtr spawningKitFactory,
 		unsigned int restartsInitiated, boost::container::vector<Callback> postLockActions);
@@ -247,6 +297,13 @@ public:
 	void spawnThreadOOBWRequest(GroupPtr self, ProcessPtr process);
 	void initiateNextOobwRequest();
 
+	/****** Predictive autoscaling ******/
+
+	unsigned int getConcurrency() const;
+	int estimateProcessConcurrency() const;
+	ProcessPtr findProcessToScaleDown(unsigned long long now) const;
+	void autoscale(unsigned long long now);
+
 	/****** Internal utilities ******/
 
 	static void runAllActions(const boost::container::vector<Callback> &actions);
@@ -255,6 +312,7 @@ public:
 
 	void resetOptions(const Options &newOptions, Options *destination = NULL);
 	void mergeOptions(const Options &other);
+	bool optionsNeedMerging(const Options &other) const;
 
 	bool prepareHookScriptOptions(HookScriptOptions &hsOptions, const char *name);
 	void runAttachHooks(const ProcessPtr process) const;
@@ -471,6 +529,7 @@ public:
 	/****** State inspection ******/
 
 	unsigned int getProcessCount() const;
+	unsigned int effectiveMinProcesses() const;
 	bool processLowerLimitsSatisfied() const;
 	bool processUpperLimitsReached() const;
 	bool allEnabledProcessesAreTotallyBusy() const;
@@ -479,7 +538,8 @@ public:
 	bool isWaitingForCapacity() const;
 	bool garbageCollectable(unsigned long long now = 0) const;
 
-	void inspectXml(std::ostream &stream, bool includeSecrets = true) const;
+	void captureStatusSnapshot(GroupStatusSnapshot &snapshot) const;
+	void captureSessionStatus(std::vector<ProcessSessionStatus> &result) const;
 	void inspectPropertiesInAdminPanelFormat(Json::Value &result) const;
 	void inspectConfigInAdminPanelFormat(Json::Value &result) const;
 
@@ -0,0 +1,152 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#include <Core/ApplicationPool/Group.h>
+
+/*************************************************************************
+ *
+ * Predictive autoscaling functions for ApplicationPool2::Group
+ *
+ *************************************************************************/
+
+namespace Passenger {
+namespace ApplicationPool2 {
+
+using namespace std;
+using namespace boost;
+
+
+/****************************
+ *
+ * Private methods
+ *
+ ****************************/
+
+
+/**
+ * Returns the number of requests that this group is currently handling,
+ * plus the number of requests that are waiting for a process.
+ */
+unsigned int
+Group::getConcurrency() const {
+	unsigned int result = getWaitlist.size();
+	ProcessList::const_iterator it;
+
+	for (it = enabledProcesses.begin(); it != enabledProcesses.end(); it++) {
+		result += (*it)->sessions;
+	}
+	for (it = disablingProcesses.begin(); it != disablingProcesses.end(); it++) {
+		result += (*it)->sessions;
+	}
+	return result;
+}
+
+/**
+ * Returns the number of concurrent sessions that a process in this group
+ * can handle, based on the processes that have been spawned so far.
+ * 0 means unlimited. If there are no processes then we assume 1, which is
+ * what most apps support.
+ */
+int
+Group::estimateProcessConcurrency() const {
+	if (enabledProcesses.empty()) {
+		return 1;
+	} else {
+		int concurrency = enabledProcesses.front()->getConcurrency();
+		// A concurrency of -1 means unknown.
+		return (concurrency < 0) ? 1 : concurrency;
+	}
+}
+
+/**
+ * Returns an enabled process that predictive autoscaling may shut down,
+ * or NULL if there is none. A process may be shut down if the group has more
+ * processes than `effectiveMinProcesses()` and if the process has been idle
+ * for at least the pool's max idle time, but no less than
+ * AUTOSCALING_SCALE_DOWN_IDLE_TIME. Of all such processes, the one that has
+ * been idle the longest is returned. If the max idle time is 0, then idle
+ * processes are never shut down, not even by autoscaling.
+ */
+ProcessPtr
+Group::findProcessToScaleDown(unsigned long long now) const {
+	const Pool *pool = getPool();
+	if (m_spawning || pool->maxIdleTime == 0
+	 || getProcessCount() <= effectiveMinProcesses())
+	{
+		return ProcessPtr();
+	}
+
+	unsigned long long idleTime = std::max(pool->maxIdleTime,
+		AUTOSCALING_SCALE_DOWN_IDLE_TIME * 1000000ull);
+
+	ProcessPtr result;
+	ProcessList::const_iterator it, end = enabledProcesses.end();
+	for (it = enabledProcesses.begin(); it != end; it++) {
+		const ProcessPtr &process = *it;
+		if (process->sessions == 0
+		 && process->lastUsed + idleTime <= now
+		 && (result == NULL || process->lastUsed < result->lastUsed))
+		{
+			result = process;
+		}
+	}
+	return result;
+}
+
+/**
+ * Feeds the current demand into `demandEstimator`, updates `autoscalingTarget`
+ * and spawns processes if the predicted demand calls for more than there are.
+ * Scaling down is done by Pool::realAutoscale(), one process at a time.
+ * Must be called about once per second.
+ */
+void
+Group::autoscale(unsigned long long now) {
+	assert(isAlive());
+	assert(!restarting());
+
+	demandEstimator.update(sessionsOpened, getConcurrency(), now);
+	statusVersion++;
+
+	unsigned int target = demandEstimator.processesNeeded(estimateProcessConcurrency());
+	if (options.maxProcesses != 0) {
+		target = std::min(target, options.maxProcesses);
+	}
+	target = std::min(target, pool->max);
+	if (target != autoscalingTarget) {
+		P_DEBUG("Autoscaling target for group " << info.name << ": "
+			<< autoscalingTarget << " -> " << target << " processes"
+			<< " (predicted concurrency = "
+			<< demandEstimator.getPredictedConcurrency() << ")");
+		autoscalingTarget = target;
+	}
+
+	if (shouldSpawn()) {
+		spawn();
+	}
+}
+
+
+} // namespace ApplicationPool2
+} // namespace Passenger
@@ -85,6 +85,7 @@ Group::finishShutdown(boost::container::vector<Callback> &postLockActions) {
 	postLockActions.push_back(boost::bind(interruptAndJoinAllThreads,
 		shared_from_this()));
 	this->lifeStatus.store(SHUT_DOWN, boost::memory_order_seq_cst);
+	statusVersion++;
 	selfPointer.reset();
 }
 
@@ -112,6 +113,9 @@ Group::Group(Pool *_pool, const Options &_options)
 	spawner        = getContext()->spawningKitFactory->create(options);
 	restartsInitiated = 0;
 	processesBeingSpawned = 0;
+	sessionsOpened = 0;
+	autoscalingTarget = 0;
+	statusVersion  = 0;
 	m_spawning     = false;
 	m_restarting   = false;
 	lifeStatus.store(ALIVE, boost::memory_order_relaxed);
@@ -174,6 +178,7 @@ Group::shutdown(const Callback &callback,
 	selfPointer = shared_from_this();
 	assert(disableWaitlist.empty());
 	lifeStatus.store(SHUTTING_DOWN, boost::memory_order_seq_cst);
+	statusVersion++;
 }
 
 
@@ -84,10 +84,27 @@ Group::resetOptions(const Options &newOptions, Options *destination) {
  */
 void
 Group::mergeOptions(const Options &other) {
+	if (!optionsNeedMerging(other)) {
+		return;
+	}
 	options.maxRequests      = other.maxRequests;
 	options.minProcesses     = other.minProcesses;
 	options.statThrottleRate = other.statThrottleRate;
 	options.maxPreloaderIdleTime = other.maxPreloaderIdleTime;
+	options.spawnConcurrency = other.spawnConcurrency;
+	statusVersion++;
+}
+
+/**
+ * Whether mergeOptions() would change anything.
+ */
+bool
+Group::optionsNeedMerging(const Options &other) const {
+	return options.maxRequests != other.maxRequests
+		|| options.minProcesses != other.minProcesses
+		|| options.statThrottleRate != other.statThrottleRate
+		|| options.maxPreloaderIdleTime != other.maxPreloaderIdleTime
+		|| options.spawnConcurrency != other.spawnConcurrency;
 }
 
 /* Given a hook name like "queue_full_error", we return HookScriptOptions filled in with this name and a spec
@@ -271,6 +288,7 @@ Group::pushGetWaiter(const Options &newOptions, const GetCallback &callback,
 		getWaitlist.push_back(GetWaiter(
 			newOptions.copyAndPersist(),
 			callback));
+		statusVersion++;
 		return true;
 	} else {
 		postLockActions.push_back(boost::bind(GetCallback::call,
@@ -309,6 +327,7 @@ Group::assignSessionsToGetWaitersQuickly(Lock &lock) {
 			action.callback = waiter.callback;
 			action.session  = newSession(result.process);
 			getWaitlist.erase(getWaitlist.begin() + i);
+			statusVersion++;
 			actions.push_back(action);
 		} else {
 			done = result.finished;
@@ -341,6 +360,7 @@ Group::assignSessionsToGetWaiters(boost::container::vector<Callback> &postLockAc
 				newSession(result.process),
 				ExceptionPtr()));
 			getWaitlist.erase(getWaitlist.begin() + i);
+			statusVersion++;
 		} else {
 			done = result.finished;
 			if (!result.finished) {
@@ -135,6 +135,7 @@ void
 Group::addProcessToList(const ProcessPtr &process, ProcessList &destination) {
 	destination.push_back(process);
 	process->setIndex(destination.size() - 1);
+	statusVersion++;
 	if (&destination == &enabledProcesses) {
 		process->enabled = Process::ENABLED;
 		enabledCount++;
@@ -175,6 +176,7 @@ Group::removeProcessFromList(const ProcessPtr &process, ProcessList &source) {
 
 	source.erase(source.begin() + process->getIndex());
 	process->setIndex(-1);
+	statusVersion++;
 
 	switch (process->enabled) {
 	case Process::ENABLED:
@@ -234,6 +236,7 @@ Group::removeFromDisableWaitlist(const ProcessPtr &p, DisableResult result,
 		}
 	}
 	disableWaitlist = newList;
+	statusVersion++;
 }
 
 void
@@ -249,6 +252,7 @@ Group::clearDisableWaitlist(DisableResult result,
 		postLockActions.push_back(boost::bind(waiter.callback, waiter.process, result));
 		disableWaitlist.pop_front();
 	}
+	statusVersion++;
 }
 
 void
@@ -301,7 +305,7 @@ Group::detachedProcessesCheckerMain(GroupPtr self) {
 		debug->messages->recv("Proceed with starting detached processes checker");
 	}
 
-	boost::unique_lock<boost::mutex> lock(pool->syncher);
+	PoolScopedLock lock(pool->syncher);
 	while (true) {
 		assert(detachedProcessesCheckerActive);
 
@@ -328,6 +332,7 @@ Group::detachedProcessesCheckerMain(GroupPtr self) {
 							" has 0 active sessions now. Triggering shutdown.");
 						process->triggerShutdown();
 						assert(process->getLifeStatus() == Process::SHUTDOWN_TRIGGERED);
+						statusVersion++;
 					}
 					break;
 				case Process::SHUTDOWN_TRIGGERED:
@@ -353,6 +358,12 @@ Group::detachedProcessesCheckerMain(GroupPtr self) {
 			for (it = processesToRemove.begin(); it != end; it++) {
 				removeProcessFromList(*it, detachedProcesses);
 			}
+
+			// Released together with `processesToRemove`.
+			PoolStatusSnapshotPtr statusSnapshot;
+			if (!processesToRemove.empty()) {
+				pool->discardStatusSnapshot(statusSnapshot);
+			}
 		}
 
 		UPDATE_TRACE_POINT();
@@ -425,6 +436,11 @@ Group::attach(const ProcessPtr &process,
 	P_DEBUG("Attaching process " << process->inspect());
 	addProcessToList(process, enabledProcesses);
 
+	if (getPool()->minIdleConnections > 0) {
+		process->setMinIdleConnections(getPool()->minIdleConnections);
+		getPool()->warmConnectionPoolsLater(process);
+	}
+
 	/* Now that there are enough resources, relevant processes in
 	 * 'disableWaitlist' can be disabled.
 	 */
@@ -602,6 +618,7 @@ Group::disable(const ProcessPtr &process, const DisableCallback &callback) {
 	} else if (process->enabled == Process::DISABLING) {
 		assert(disablingCount > 0);
 		disableWaitlist.push_back(DisableWaiter(process, callback));
+		statusVersion++;
 		P_DEBUG("Disabling DISABLING process " << process->inspect() <<
 			info.name << "; command queued, deferring disable command completion");
 		return DR_DEFERRED;
@@ -93,6 +93,7 @@ Group::newSession(Process *process, unsigned long long now) {
 	SessionPtr session = process->newSession(now);
 	session->onInitiateFailure = _onSessionInitiateFailure;
 	session->onClose   = _onSessionClose;
+	sessionsOpened++;
 	if (process->enabled == Process::ENABLED) {
 		enabledProcessBusynessLevels[process->getIndex()] = process->busyness();
 		if (!wasTotallyBusy && process->isTotallyBusy()) {
@@ -113,7 +114,52 @@ void
 Group::_onSessionClose(Session *session) {
 	Process *process = session->getProcess();
 	assert(process != NULL);
-	process->getGroup()->onSessionClose(process, session);
+	Group *group = process->getGroup();
+	if (!group->tryCloseSessionFast(process, session)) {
+		group->onSessionClose(process, session);
+	}
+}
+
+/* The session close fast path. Handles the common case in which closing a
+ * session only requires updating this Group's busyness statistics, i.e. in
+ * which no process needs to be detached or disabled, no OOBW needs to be
+ * started and no get waiters need to be assigned. Those cases require the
+ * pool lock in exclusive mode, so if any of them apply then this method does
+ * nothing and returns false, and the caller must call onSessionClose() instead.
+ */
+bool
+Group::tryCloseSessionFast(Process *process, Session *session) {
+	Pool *pool = getPool();
+	PoolFastPathLock poolLock(pool->syncher);
+	if (OXT_UNLIKELY(!poolLock.owns_lock())) {
+		return false;
+	}
+
+	boost::lock_guard<boost::mutex> l(fastPathSyncher);
+	assert(process->isAlive());
+
+	if (OXT_UNLIKELY(process->enabled != Process::ENABLED
+		|| !getWaitlist.empty()
+		|| shouldInitiateOobw(process)
+		|| (options.maxRequests > 0 && process->processed + 1 >= options.maxRequests)))
+	{
+		return false;
+	}
+	if (process->sessions == 1
+	 && (!pool->getWaitlist.empty() || anotherGroupIsWaitingForCapacity()))
+	{
+		return false;
+	}
+
+	P_TRACE(2, "Session closed for process " << process->inspect() << " (fast path)");
+	bool wasTotallyBusy = process->isTotallyBusy();
+	process->sessionClosed(session);
+	enabledProcessBusynessLevels[process->getIndex()] = process->busyness();
+	if (wasTotallyBusy) {
+		assert(nEnabledProcessesTotallyBusy >= 1);
+		nEnabledProcessesTotallyBusy--;
+	}
+	return true;
 }
 
 OXT_FORCE_INLINE void
@@ -123,7 +169,7 @@ Group::onSessionInitiateFailure(Process *process, Session *session) {
 	TRACE_POINT();
 	// Standard resource management boilerplate stuff...
 	Pool *pool = getPool();
-	boost::unique_lock<boost::mutex> lock(pool->syncher);
+	PoolScopedLock lock(pool->syncher);
 	assert(process->isAlive());
 	assert(isAlive() || getLifeStatus() == SHUTTING_DOWN);
 
@@ -143,7 +189,7 @@ Group::onSessionClose(Process *process, Session *session) {
 	TRACE_POINT();
 	// Standard resource management boilerplate stuff...
 	Pool *pool = getPool();
-	boost::unique_lock<boost::mutex> lock(pool->syncher);
+	PoolScopedLock lock(pool->syncher);
 	assert(process->isAlive());
 	assert(isAlive() || getLifeStatus() == SHUTTING_DOWN);
 
@@ -245,6 +291,62 @@ Group::onSessionClose(Process *process, Session *session) {
 }
 
 
+/* Whether needsRestart() would check the restart files right now. */
+bool
+Group::restartCheckDue(const Options &options) const {
+	if (m_restarting) {
+		return false;
+	}
+
+	time_t now;
+	if (options.currentTime != 0) {
+		now = options.currentTime / 1000000;
+	} else {
+		now = SystemTime::get();
+	}
+	return lastRestartFileCheckTime == 0
+		|| lastRestartFileCheckTime <= now - (time_t) options.statThrottleRate
+		|| alwaysRestartFileExists;
+}
+
+/* The get() fast path, for use by Pool::asyncGet(). Handles the common case
+ * in which the request can be routed to an existing enabled process without
+ * restarting, spawning or queuing. The caller must hold `pool->syncher`
+ * in fast path mode and `fastPathSyncher`.
+ *
+ * Returns false if that's not possible, in which case nothing has been
+ * changed and the caller must go through the normal get() code path.
+ */
+bool
+Group::tryGetFast(const Options &newOptions, SessionPtr &session) {
+	if (OXT_UNLIKELY(!isAlive()
+		|| restarting()
+		|| newOptions.noop
+		|| enabledCount == 0
+		|| restartCheckDue(newOptions)
+		// We may not modify the options here (see PoolMutex), so let
+		// the normal code path merge them.
+		|| optionsNeedMerging(newOptions)))
+	{
+		return false;
+	}
+
+	if (shouldSpawnForGetAction()) {
+		return false;
+	}
+
+	RouteResult result = route(newOptions);
+	if (result.process == NULL) {
+		return false;
+	}
+
+	P_DEBUG("Session checked out from process " << result.process->inspect()
+		<< " (fast path)");
+	session = newSession(result.process, newOptions.currentTime);
+	return true;
+}
+
+
 /****************************
  *
  * Public methods
@@ -119,7 +119,7 @@ Group::spawnThreadRealMain(const SpawningKit::SpawnerPtr &spawner,
 
 		UPDATE_TRACE_POINT();
 		ScopeGuard guard(boost::bind(Process::forceTriggerShutdownAndCleanup, process));
-		boost::unique_lock<boost::mutex> lock(pool->syncher);
+		PoolScopedLock lock(pool->syncher);
 
 		if (!isAlive()) {
 			if (process != NULL) {
@@ -152,7 +152,7 @@ Group::spawnThreadRealMain(const SpawningKit::SpawnerPtr &spawner,
 		assert(processesBeingSpawned > 0);
 
 		processesBeingSpawned--;
-		assert(processesBeingSpawned == 0);
+		statusVersion++;
 
 		UPDATE_TRACE_POINT();
 		boost::container::vector<Callback> actions;
@@ -180,22 +180,37 @@ Group::spawnThreadRealMain(const SpawningKit::SpawnerPtr &spawner,
 			if (enabledCount == 0) {
 				enableAllDisablingProcesses(actions);
 			}
-			Pool::assignExceptionToGetWaiters(getWaitlist, exception, actions);
+			// Other spawner threads may still succeed. Leave them as many
+			// get waiters as they can serve and only fail the rest, i.e.
+			// all of them if no other spawn is in flight.
+			while (getWaitlist.size() > (unsigned int) processesBeingSpawned) {
+				actions.push_back(boost::bind(GetCallback::call,
+					getWaitlist.back().callback, SessionPtr(), exception));
+				getWaitlist.pop_back();
+			}
 			pool->assignSessionsToGetWaiters(actions);
 			done = true;
 		}
 
+		// Other spawner threads may still be working for this group. Get waiters
+		// that will be served by the processes they're spawning don't need
+		// another process from us.
 		done = done
-			|| (processLowerLimitsSatisfied() && getWaitlist.empty())
+			|| (processLowerLimitsSatisfied() && getWaitlist.size() <= (unsigned int) processesBeingSpawned)
 			|| processUpperLimitsReached()
 			|| pool->atFullCapacityUnlocked();
-		m_spawning = !done;
 		if (done) {
 			P_DEBUG("Spawn loop done");
 		} else {
 			processesBeingSpawned++;
 			P_DEBUG("Continue spawning");
+			// Capacity that was unavailable when spawning began may have become
+			// available since then.
+			while (shouldSpawnInParallel()) {
+				createSpawnThread();
+			}
 		}
+		m_spawning = processesBeingSpawned > 0;
 
 		UPDATE_TRACE_POINT();
 		pool->fullVerifyInvariants();
@@ -210,6 +225,39 @@ Group::spawnThreadRealMain(const SpawningKit::SpawnerPtr &spawner,
 	}
 }
 
+void
+Group::createSpawnThread() {
+	interruptableThreads.create_thread(
+		boost::bind(&Group::spawnThreadMain,
+			this, shared_from_this(), spawner,
+			options.copyAndPersist().clearPerRequestFields(),
+			restartsInitiated),
+		"Group process spawner: " + info.name,
+		POOL_HELPER_THREAD_STACK_SIZE);
+	m_spawning = true;
+	processesBeingSpawned++;
+	statusVersion++;
+}
+
+/**
+ * Whether, while processes are already being spawned for this group, another
+ * spawner thread should be started next to them. This is the case when the
+ * processes being spawned are not enough to satisfy `minProcesses` or to serve
+ * the get waiters, and neither `options.spawnConcurrency`, the pool-wide
+ * spawn concurrency limit nor the process limits have been reached.
+ */
+bool
+Group::shouldSpawnInParallel() const {
+	const Pool *pool = getPool();
+	return processesBeingSpawned > 0
+		&& (unsigned int) processesBeingSpawned < options.spawnConcurrency
+		&& pool->processesBeingSpawnedUnlocked() < pool->maxSpawnConcurrency
+		&& (!processLowerLimitsSatisfied()
+			|| getWaitlist.size() > (unsigned int) processesBeingSpawned)
+		&& !processUpperLimitsReached()
+		&& !poolAtFullCapacity();
+}
+
 // The 'self' parameter is for keeping the current Group object alive while this thread is running.
 void
 Group::finalizeRestart(GroupPtr self,
@@ -245,7 +293,7 @@ Group::finalizeRestart(GroupPtr self,
 		debug->messages->recv("Finish restarting");
 	}
 
-	ScopedLock l(pool->syncher);
+	PoolScopedLock l(pool->syncher);
 	if (!isAlive()) {
 		P_DEBUG("Group " << getName() << " is shutting down, so aborting restart");
 		return;
@@ -271,6 +319,7 @@ Group::finalizeRestart(GroupPtr self,
 	spawner    = newSpawner;
 
 	m_restarting = false;
+	statusVersion++;
 	if (shouldSpawn()) {
 		spawn();
 	} else if (isWaitingForCapacity()) {
@@ -318,6 +367,7 @@ Group::restart(const Options &options, RestartMethod method) {
 	m_restarting = true;
 	uuid         = generateUuid(pool);
 	this->options.groupUuid = uuid;
+	statusVersion++;
 	detachAll(actions);
 	getPool()->interruptableThreads.create_thread(
 		boost::bind(&Group::finalizeRestart, this, shared_from_this(),
@@ -420,11 +470,16 @@ Group::needsRestart(const Options &options) {
  * resource limits. That is, this method will ensure that there are at least
  * `minProcesses` processes, but no more than `maxProcesses` processes, and no
  * more than `pool->max` processes in the entire pool.
+ *
+ * If `options.spawnConcurrency` allows it, then this method spawns multiple
+ * processes in parallel, as many as are needed to satisfy `minProcesses` and
+ * to serve the get waiters. This also happens when processes are already
+ * being spawned.
  */
 SpawnResult
 Group::spawn() {
 	assert(isAlive());
-	if (m_spawning) {
+	if (m_spawning && !shouldSpawnInParallel()) {
 		return SR_IN_PROGRESS;
 	} else if (restarting()) {
 		return SR_ERR_RESTARTING;
@@ -434,15 +489,9 @@ Group::spawn() {
 		return SR_ERR_POOL_AT_FULL_CAPACITY;
 	} else {
 		P_DEBUG("Requested spawning of new process for group " << info.name);
-		interruptableThreads.create_thread(
-			boost::bind(&Group::spawnThreadMain,
-				this, shared_from_this(), spawner,
-				options.copyAndPersist().clearPerRequestFields(),
-				restartsInitiated),
-			"Group process spawner: " + info.name,
-			POOL_HELPER_THREAD_STACK_SIZE);
-		m_spawning = true;
-		processesBeingSpawned++;
+		do {
+			createSpawnThread();
+		} while (shouldSpawnInParallel());
 		return SR_OK;
 	}
 }
@@ -24,6 +24,7 @@
  *  THE SOFTWARE.
  */
 #include <Core/ApplicationPool/Group.h>
+#include <Core/ApplicationPool/StatusSnapshot.h>
 #include <FileTools/PathManip.h>
 #include <cassert>
 #include <modp_b64.h>
@@ -53,6 +54,15 @@ Group::getProcessCount() const {
 	return enabledCount + disablingCount + disabledCount;
 }
 
+/**
+ * Returns the minimum number of processes that this group should have:
+ * `minProcesses`, or more if predictive autoscaling expects more demand.
+ */
+unsigned int
+Group::effectiveMinProcesses() const {
+	return std::max(options.minProcesses, autoscalingTarget);
+}
+
 /**
  * Returns whether the lower bound of the group-specific process limits
  * have been satisfied. Note that even if the result is false, the pool limits
@@ -60,7 +70,7 @@ Group::getProcessCount() const {
  */
 bool
 Group::processLowerLimitsSatisfied() const {
-	return capacityUsed() >= options.minProcesses;
+	return capacityUsed() >= effectiveMinProcesses();
 }
 
 /**
@@ -120,82 +130,73 @@ Group::garbageCollectable(unsigned long long now) const {
 	return false;
 }
 
+/**
+ * Copies the state that is reported by the pool status inspection methods
+ * into `snapshot`, so that it can be serialized without holding the pool lock.
+ */
 void
-Group::inspectXml(std::ostream &stream, bool includeSecrets) const {
+Group::captureStatusSnapshot(GroupStatusSnapshot &snapshot) const {
 	ProcessList::const_iterator it;
 
-	stream << "<name>" << escapeForXml(info.name) << "</name>";
-	stream << "<component_name>" << escapeForXml(info.name) << "</component_name>";
-	stream << "<app_root>" << escapeForXml(options.appRoot) << "</app_root>";
-	stream << "<app_type>" << escapeForXml(options.appType) << "</app_type>";
-	stream << "<environment>" << escapeForXml(options.environment) << "</environment>";
-	stream << "<uuid>" << toString(uuid) << "</uuid>";
-	stream << "<enabled_process_count>" << enabledCount << "</enabled_process_count>";
-	stream << "<disabling_process_count>" << disablingCount << "</disabling_process_count>";
-	stream << "<disabled_process_count>" << disabledCount << "</disabled_process_count>";
-	stream << "<capacity_used>" << capacityUsed() << "</capacity_used>";
-	stream << "<get_wait_list_size>" << getWaitlist.size() << "</get_wait_list_size>";
-	stream << "<disable_wait_list_size>" << disableWaitlist.size() << "</disable_wait_list_size>";
-	stream << "<processes_being_spawned>" << processesBeingSpawned << "</processes_being_spawned>";
-	if (m_spawning) {
-		stream << "<spawning/>";
+	snapshot.group = shared_from_this();
+	snapshot.version = statusVersion;
+	snapshot.options = options.copyAndPersist();
+	snapshot.uuid = uuid;
+	snapshot.lifeStatus = (LifeStatus) lifeStatus.load(boost::memory_order_relaxed);
+	snapshot.enabledCount = enabledCount;
+	snapshot.disablingCount = disablingCount;
+	snapshot.disabledCount = disabledCount;
+	snapshot.processCount = getProcessCount();
+	snapshot.capacityUsed = capacityUsed();
+	snapshot.getWaitlistSize = getWaitlist.size();
+	snapshot.disableWaitlistSize = disableWaitlist.size();
+	snapshot.processesBeingSpawned = processesBeingSpawned;
+	snapshot.spawning = m_spawning;
+	snapshot.restarting = restarting();
+	snapshot.predictiveAutoscaling = pool->predictiveAutoscaling;
+	snapshot.demandEstimator = demandEstimator;
+	snapshot.autoscalingTarget = autoscalingTarget;
+
+	snapshot.enabledProcesses.reserve(enabledProcesses.size());
+	for (it = enabledProcesses.begin(); it != enabledProcesses.end(); it++) {
+		snapshot.enabledProcesses.push_back(ProcessStatusSnapshot(*it));
 	}
-	if (restarting()) {
-		stream << "<restarting/>";
+	snapshot.disablingProcesses.reserve(disablingProcesses.size());
+	for (it = disablingProcesses.begin(); it != disablingProcesses.end(); it++) {
+		snapshot.disablingProcesses.push_back(ProcessStatusSnapshot(*it));
 	}
-	if (includeSecrets) {
-		stream << "<secret>" << escapeForXml(getApiKey().toStaticString()) << "</secret>";
-		stream << "<api_key>" << escapeForXml(getApiKey().toStaticString()) << "</api_key>";
+	snapshot.disabledProcesses.reserve(disabledProcesses.size());
+	for (it = disabledProcesses.begin(); it != disabledProcesses.end(); it++) {
+		snapshot.disabledProcesses.push_back(ProcessStatusSnapshot(*it));
 	}
-	LifeStatus lifeStatus = (LifeStatus) this->lifeStatus.load(boost::memory_order_relaxed);
-	switch (lifeStatus) {
-	case ALIVE:
-		stream << "<life_status>ALIVE</life_status>";
-		break;
-	case SHUTTING_DOWN:
-		stream << "<life_status>SHUTTING_DOWN</life_status>";
-		break;
-	case SHUT_DOWN:
-		stream << "<life_status>SHUT_DOWN</life_status>";
-		break;
-	default:
-		P_BUG("Unknown 'lifeStatus' state " << lifeStatus);
+	snapshot.detachedProcesses.reserve(detachedProcesses.size());
+	for (it = detachedProcesses.begin(); it != detachedProcesses.end(); it++) {
+		snapshot.detachedProcesses.push_back(ProcessStatusSnapshot(*it));
 	}
+}
 
-	SpawningKit::UserSwitchingInfo usInfo(SpawningKit::prepareUserSwitching(options));
-	stream << "<user>" << escapeForXml(usInfo.username) << "</user>";
-	stream << "<uid>" << usInfo.uid << "</uid>";
-	stream << "<group>" << escapeForXml(usInfo.groupname) << "</group>";
-	stream << "<gid>" << usInfo.gid << "</gid>";
-
-	stream << "<options>";
-	options.toXml(stream, getResourceLocator());
-	stream << "</options>";
-
-	stream << "<processes>";
+/**
+ * Copies the session counters of all processes into `result`, in the same
+ * order as the process lists of `captureStatusSnapshot()`. Unlike the rest of
+ * the status snapshot, these are not covered by `statusVersion`.
+ */
+void
+Group::captureSessionStatus(GroupSessionStatus &result) const {
+	ProcessList::const_iterator it;
 
+	result.reserve(getProcessCount() + detachedProcesses.size());
 	for (it = enabledProcesses.begin(); it != enabledProcesses.end(); it++) {
-		stream << "<process>";
-		(*it)->inspectXml(stream, includeSecrets);
-		stream << "</process>";
+		result.push_back(ProcessSessionStatus(**it));
 	}
 	for (it = disablingProcesses.begin(); it != disablingProcesses.end(); it++) {
-		stream << "<process>";
-		(*it)->inspectXml(stream, includeSecrets);
-		stream << "</process>";
+		result.push_back(ProcessSessionStatus(**it));
 	}
 	for (it = disabledProcesses.begin(); it != disabledProcesses.end(); it++) {
-		stream << "<process>";
-		(*it)->inspectXml(stream, includeSecrets);
-		stream << "</process>";
+		result.push_back(ProcessSessionStatus(**it));
 	}
 	for (it = detachedProcesses.begin(); it != detachedProcesses.end(); it++) {
-		stream << "<process>";
-		(*it)->inspectXml(stream, includeSecrets);
-		stream << "</process>";
+		result.push_back(ProcessSessionStatus(**it));
 	}
-
-	stream << "</processes>";
 }
 
 void
@@ -250,6 +251,8 @@ Group::inspectConfigInAdminPanelFormat(Json::Value &result) const {
 	result["max_processes"] = VAL(options.maxProcesses, 0u);
 	result["environment"] = SVAL(options.environment); // TODO: default value depends on integration mode
 	result["spawn_method"] = SVAL(options.spawnMethod, DEFAULT_SPAWN_METHOD);
+	result["spawn_concurrency"] = VAL(options.spawnConcurrency,
+		(Json::UInt) DEFAULT_SPAWN_CONCURRENCY);
 	result["start_timeout"] = VAL(options.startTimeout / 1000.0, DEFAULT_START_TIMEOUT / 1000.0);
 	result["max_preloader_idle_time"] = VAL((Json::UInt) options.maxPreloaderIdleTime,
 		(Json::UInt) DEFAULT_MAX_PRELOADER_IDLE_TIME);
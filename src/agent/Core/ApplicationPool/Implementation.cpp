@@ -47,6 +47,8 @@
 #include <Core/ApplicationPool/Group.h>
 #include <Core/ApplicationPool/Pool/InitializationAndShutdown.cpp>
 #include <Core/ApplicationPool/Pool/AnalyticsCollection.cpp>
+#include <Core/ApplicationPool/Pool/ConnectionWarming.cpp>
+#include <Core/ApplicationPool/Pool/Autoscaling.cpp>
 #include <Core/ApplicationPool/Pool/GarbageCollection.cpp>
 #include <Core/ApplicationPool/Pool/GeneralUtils.cpp>
 #include <Core/ApplicationPool/Pool/GroupUtils.cpp>
@@ -59,11 +61,13 @@
 #include <Core/ApplicationPool/Group/SpawningAndRestarting.cpp>
 #include <Core/ApplicationPool/Group/ProcessListManagement.cpp>
 #include <Core/ApplicationPool/Group/OutOfBandWork.cpp>
+#include <Core/ApplicationPool/Group/Autoscaling.cpp>
 #include <Core/ApplicationPool/Group/Miscellaneous.cpp>
 #include <Core/ApplicationPool/Group/InternalUtils.cpp>
 #include <Core/ApplicationPool/Group/StateInspection.cpp>
 #include <Core/ApplicationPool/Group/Verification.cpp>
 #include <Core/ApplicationPool/Process.cpp>
+#include <Core/ApplicationPool/StatusSnapshot.cpp>
 #include <Core/SpawningKit/ErrorRenderer.h>
 
 namespace Passenger {
@@ -250,6 +254,12 @@ Session::requestOOBW() {
 	process->getGroup()->requestOOBW(process);
 }
 
+void
+Session::requestConnectionPoolWarming() {
+	ProcessPtr process = getProcess()->shared_from_this();
+	process->getGroup()->getPool()->warmConnectionPoolsLater(process);
+}
+
 
 } // namespace ApplicationPool2
 } // namespace Passenger
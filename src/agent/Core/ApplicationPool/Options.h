@@ -341,6 +341,14 @@ public:
 	 */
 	unsigned int maxOutOfBandWorkInstances;
 
+	/**
+	 * The maximum number of processes that may be spawned for this group at
+	 * the same time. The pool-wide limit set with `Pool::setMaxSpawnConcurrency()`
+	 * takes precedence. A value of 1 means that processes are spawned one at
+	 * a time.
+	 */
+	unsigned int spawnConcurrency;
+
 	/**
 	 * The maximum number of requests that may live in the Group.getWaitlist queue.
 	 * A value of 0 means unlimited.
@@ -451,6 +459,7 @@ public:
 		  maxProcesses(0),
 		  maxPreloaderIdleTime(-1),
 		  maxOutOfBandWorkInstances(1),
+		  spawnConcurrency(DEFAULT_SPAWN_CONCURRENCY),
 		  maxRequestQueueSize(DEFAULT_MAX_REQUEST_QUEUE_SIZE),
 		  abortWebsocketsOnProcessShutdown(true),
 
@@ -582,6 +591,7 @@ public:
 			appendKeyValue3(vec, "max_processes",       maxProcesses);
 			appendKeyValue2(vec, "max_preloader_idle_time", maxPreloaderIdleTime);
 			appendKeyValue3(vec, "max_out_of_band_work_instances", maxOutOfBandWorkInstances);
+			appendKeyValue3(vec, "spawn_concurrency", spawnConcurrency);
 		}
 
 		/*********************************/
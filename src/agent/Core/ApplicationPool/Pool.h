@@ -61,10 +61,12 @@
 #include <Utils/SystemMetricsCollector.h>
 #include <Core/ApplicationPool/Common.h>
 #include <Core/ApplicationPool/Context.h>
+#include <Core/ApplicationPool/PoolMutex.h>
 #include <Core/ApplicationPool/Process.h>
 #include <Core/ApplicationPool/Group.h>
 #include <Core/ApplicationPool/Session.h>
 #include <Core/ApplicationPool/Options.h>
+#include <Core/ApplicationPool/StatusSnapshot.h>
 #include <Core/SpawningKit/Factory.h>
 #include <Shared/ApplicationPoolApiKey.h>
 
@@ -205,10 +207,32 @@ public:
 	friend class Process;
 	friend struct tut::ApplicationPool2_PoolTest;
 
-	mutable boost::mutex syncher;
+	/**
+	 * Protects all Pool, Group, Process and Socket state. See PoolMutex
+	 * for the locking modes and which state a fast path holder may touch.
+	 */
+	mutable PoolMutex syncher;
 	unsigned int max;
 	unsigned long long maxIdleTime;
+	unsigned int minIdleConnections;
+	/**
+	 * The maximum number of processes that may be spawned in the entire
+	 * pool at the same time through parallel spawning. Every group may
+	 * always spawn one process, regardless of this limit.
+	 */
+	unsigned int maxSpawnConcurrency;
 	bool selfchecking;
+	/**
+	 * Whether the number of processes in each group is adjusted ahead of
+	 * time based on predicted demand. See Group::autoscale().
+	 */
+	bool predictiveAutoscaling;
+	/**
+	 * Whether the autoscaler thread is running. It is started by
+	 * enablePredictiveAutoscaling() and exits on its own once predictive
+	 * autoscaling is disabled.
+	 */
+	bool autoscalerRunning;
 
 	Context *context;
 
@@ -272,6 +296,15 @@ public:
 	 */
 	vector<GetWaiter> getWaitlist;
 
+	/**
+	 * The snapshot that was returned by the last `captureStatusSnapshot()` call.
+	 * Its GroupStatusSnapshots are reused by the next call for Groups whose
+	 * `statusVersion` didn't change in the mean time. Discarded when a Process
+	 * or Group leaves the pool, so that it doesn't keep them alive. Protected
+	 * by `syncher`.
+	 */
+	mutable PoolStatusSnapshotPtr lastStatusSnapshot;
+
 // Actually private, but marked public so that unit tests can access the fields.
 public:
 	/****** Debugging support *******/
@@ -312,6 +345,7 @@ public:
 
 	/****** Analytics collection ******/
 
+	ProcessMetricsCollector processMetricsCollector;
 	SystemMetricsCollector systemMetricsCollector;
 	SystemMetrics systemMetrics;
 
@@ -324,6 +358,24 @@ public:
 	void realCollectAnalytics();
 
 
+	/****** Connection pre-warming ******/
+
+	boost::mutex connectionWarmingSyncher;
+	boost::condition_variable connectionWarmingCond;
+	ProcessList connectionWarmingQueue;
+
+	void initializeConnectionWarming();
+	static void warmConnectionPools(PoolPtr self);
+	void realWarmConnectionPools();
+
+
+	/****** Predictive autoscaling ******/
+
+	void startAutoscaler();
+	static void autoscale(PoolPtr self);
+	bool realAutoscale();
+
+
 	/****** Garbage collection ******/
 
 	struct GarbageCollectorState {
@@ -332,7 +384,7 @@ public:
 		boost::container::vector<Callback> actions;
 	};
 
-	boost::condition_variable garbageCollectionCond;
+	boost::condition_variable_any garbageCollectionCond;
 
 	void initializeGarbageCollection();
 	static void garbageCollect(PoolPtr self);
@@ -363,6 +415,7 @@ public:
 		boost::container::vector<Callback> &postLockActions);
 	static void syncGetCallback(const AbstractSessionPtr &session, const ExceptionPtr &e,
 		void *userData);
+	bool tryGetFromExistingGroupFast(const Options &options, SessionPtr &session);
 
 
 	/****** Group data structure utilities ******/
@@ -424,8 +477,18 @@ public:
 	static Json::Value makeSingleNonEmptyStrValueJsonConfigFormat(const StaticString &val);
 	unsigned int capacityUsedUnlocked() const;
 	bool atFullCapacityUnlocked() const;
-	void inspectProcessList(const InspectOptions &options, stringstream &result,
-		const Group *group, const ProcessList &processes) const;
+	unsigned int processesBeingSpawnedUnlocked() const;
+	boost::shared_ptr<PoolStatusSnapshot> createStatusSnapshot(
+		const PoolStatusSnapshot *previous) const;
+	static bool statusSnapshotChanged(const PoolStatusSnapshot &snapshot,
+		const PoolStatusSnapshot &previous);
+	void discardStatusSnapshot(PoolStatusSnapshotPtr &result);
+	static void releaseStatusSnapshot(PoolStatusSnapshotPtr snapshot);
+	static void inspectConnectionPools(stringstream &result, const ProcessStatusSnapshot &process);
+	static void inspectProcessList(const InspectOptions &options, stringstream &result,
+		const PoolStatusSnapshot &snapshot, const GroupStatusSnapshot &group,
+		const vector<ProcessStatusSnapshot> &processes,
+		GroupSessionStatus::const_iterator &sessionStatus);
 
 public:
 	typedef void (*AbortLongRunningConnectionsCallback)(const ProcessPtr &process);
@@ -484,6 +547,9 @@ public:
 		bool lock = true) const;
 	string toXml(const ToXmlOptions &options = ToXmlOptions::makeAuthorized(),
 		bool lock = true) const;
+	string toCompactJson(const ToXmlOptions &options = ToXmlOptions::makeAuthorized(),
+		bool lock = true) const;
+	PoolStatusSnapshotPtr captureStatusSnapshot(bool lock = true) const;
 	Json::Value inspectPropertiesInAdminPanelFormat(const ToJsonOptions &options = ToJsonOptions::makeAuthorized()) const;
 	Json::Value inspectConfigInAdminPanelFormat(const ToJsonOptions &options = ToJsonOptions::makeAuthorized()) const;
 
@@ -494,10 +560,18 @@ public:
 	SessionPtr get(const Options &options, Ticket *ticket);
 	void setMax(unsigned int max);
 	void setMaxIdleTime(unsigned long long value);
+	void setMaxSpawnConcurrency(unsigned int value);
+	void setMinIdleConnections(unsigned int value);
+	void enablePredictiveAutoscaling(bool enabled);
 	void enableSelfChecking(bool enabled);
 	bool isSpawning(bool lock = true) const;
 	bool authorizeByApiKey(const ApiKey &key, bool lock = true) const;
 	bool authorizeByUid(uid_t uid, bool lock = true) const;
+
+
+	/****** Connection pre-warming ******/
+
+	void warmConnectionPoolsLater(const ProcessPtr &process);
 };
 
 
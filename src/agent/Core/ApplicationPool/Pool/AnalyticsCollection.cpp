@@ -94,6 +94,7 @@ Pool::updateProcessMetrics(const ProcessList &processes,
 			allMetrics.find(process->getPid());
 		if (metrics_it != allMetrics.end()) {
 			process->metrics = metrics_it->second;
+			process->getGroup()->statusVersion++;
 		// If the process is missing from 'allMetrics' then either 'ps'
 		// failed or the process really is gone. We double check by sending
 		// it a signal.
@@ -117,13 +118,13 @@ Pool::realCollectAnalytics() {
 	// Collect all the PIDs.
 	{
 		UPDATE_TRACE_POINT();
-		LockGuard l(syncher);
+		PoolLockGuard l(syncher);
 		max = this->max;
 	}
 	pids.reserve(max);
 	{
 		UPDATE_TRACE_POINT();
-		LockGuard l(syncher);
+		PoolLockGuard l(syncher);
 		GroupMap::ConstIterator g_it(groups);
 
 		while (*g_it != NULL) {
@@ -141,7 +142,7 @@ Pool::realCollectAnalytics() {
 	try {
 		UPDATE_TRACE_POINT();
 		P_DEBUG("Collecting process metrics");
-		processMetrics = ProcessMetricsCollector().collect(pids);
+		processMetrics = processMetricsCollector.collect(pids);
 	} catch (const ParseException &) {
 		P_WARN("Unable to collect process metrics: cannot parse 'ps' output.");
 		return;
@@ -159,7 +160,7 @@ Pool::realCollectAnalytics() {
 		UPDATE_TRACE_POINT();
 		vector<ProcessPtr> processesToDetach;
 		boost::container::vector<Callback> actions;
-		ScopedLock l(syncher);
+		PoolScopedLock l(syncher);
 		GroupMap::ConstIterator g_it(groups);
 
 		UPDATE_TRACE_POINT();
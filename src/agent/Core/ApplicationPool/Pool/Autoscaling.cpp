@@ -0,0 +1,153 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#include <Core/ApplicationPool/Pool.h>
+
+/*************************************************************************
+ *
+ * Predictive autoscaling functions for ApplicationPool2::Pool
+ *
+ *************************************************************************/
+
+namespace Passenger {
+namespace ApplicationPool2 {
+
+using namespace std;
+using namespace boost;
+
+
+/**
+ * Starts the autoscaler thread if it isn't already running.
+ * Must be called with the lock held.
+ */
+void
+Pool::startAutoscaler() {
+	if (!autoscalerRunning) {
+		autoscalerRunning = true;
+		interruptableThreads.create_thread(
+			boost::bind(autoscale, shared_from_this()),
+			"Pool autoscaler",
+			POOL_HELPER_THREAD_STACK_SIZE
+		);
+	}
+}
+
+void
+Pool::autoscale(PoolPtr self) {
+	TRACE_POINT();
+	bool keepRunning = true;
+	while (keepRunning && !boost::this_thread::interruption_requested()) {
+		try {
+			UPDATE_TRACE_POINT();
+			syscalls::usleep(timeToNextMultipleULL(1000000, SystemTime::getUsec()));
+			UPDATE_TRACE_POINT();
+			keepRunning = self->realAutoscale();
+		} catch (const thread_interrupted &) {
+			break;
+		} catch (const tracable_exception &e) {
+			P_WARN("ERROR: " << e.what() << "\n  Backtrace:\n" << e.backtrace());
+		}
+	}
+}
+
+/**
+ * Lets every group update its demand estimate and spawn processes ahead of
+ * the predicted demand. Then shuts down at most one idle process per group
+ * that the predicted demand no longer needs, so that the process count
+ * follows a drop in demand gradually.
+ *
+ * Returns false if predictive autoscaling has been disabled in the meantime,
+ * in which case the autoscaler thread exits.
+ */
+bool
+Pool::realAutoscale() {
+	TRACE_POINT();
+	PoolScopedLock lock(syncher);
+	if (!predictiveAutoscaling || lifeStatus != ALIVE) {
+		autoscalerRunning = false;
+		return false;
+	}
+
+	boost::container::vector<Callback> actions;
+	unsigned long long now = SystemTime::getUsec();
+	GroupMap::ConstIterator g_it(groups);
+
+	verifyInvariants();
+
+	while (*g_it != NULL) {
+		const GroupPtr group = g_it.getValue();
+
+		if (group->isAlive() && !group->restarting()) {
+			group->autoscale(now);
+
+			ProcessPtr process = group->findProcessToScaleDown(now);
+			if (process != NULL) {
+				P_DEBUG("Autoscaling down idle process: " << process->inspect() <<
+					", group=" << group->getName());
+				detachProcessUnlocked(process, actions);
+			}
+		}
+
+		g_it.next();
+	}
+
+	fullVerifyInvariants();
+	lock.unlock();
+	UPDATE_TRACE_POINT();
+	runAllActions(actions);
+	return true;
+}
+
+
+/****************************
+ *
+ * Public methods
+ *
+ ****************************/
+
+
+void
+Pool::enablePredictiveAutoscaling(bool enabled) {
+	PoolLockGuard l(syncher);
+	predictiveAutoscaling = enabled;
+	if (enabled && lifeStatus == ALIVE) {
+		startAutoscaler();
+	}
+
+	GroupMap::ConstIterator g_it(groups);
+	while (*g_it != NULL) {
+		const GroupPtr &group = g_it.getValue();
+		if (!enabled) {
+			group->autoscalingTarget = 0;
+			group->demandEstimator = DemandEstimator();
+		}
+		group->statusVersion++;
+		g_it.next();
+	}
+}
+
+
+} // namespace ApplicationPool2
+} // namespace Passenger
@@ -0,0 +1,134 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#include <Core/ApplicationPool/Pool.h>
+
+/*************************************************************************
+ *
+ * Connection pre-warming functions for ApplicationPool2::Pool
+ *
+ *************************************************************************/
+
+namespace Passenger {
+namespace ApplicationPool2 {
+
+using namespace std;
+using namespace boost;
+
+
+void
+Pool::initializeConnectionWarming() {
+	interruptableThreads.create_thread(
+		boost::bind(warmConnectionPools, shared_from_this()),
+		"Pool connection warmer",
+		POOL_HELPER_THREAD_STACK_SIZE
+	);
+}
+
+void
+Pool::warmConnectionPools(PoolPtr self) {
+	TRACE_POINT();
+	try {
+		while (!boost::this_thread::interruption_requested()) {
+			UPDATE_TRACE_POINT();
+			self->realWarmConnectionPools();
+		}
+	} catch (const thread_interrupted &) {
+		// Fall through.
+	}
+
+	boost::lock_guard<boost::mutex> l(self->connectionWarmingSyncher);
+	self->connectionWarmingQueue.clear();
+}
+
+void
+Pool::realWarmConnectionPools() {
+	ProcessList processes;
+
+	{
+		boost::unique_lock<boost::mutex> l(connectionWarmingSyncher);
+		while (connectionWarmingQueue.empty()) {
+			connectionWarmingCond.wait(l);
+		}
+		processes.swap(connectionWarmingQueue);
+	}
+
+	ProcessList::const_iterator it, end = processes.end();
+	for (it = processes.begin(); it != end; it++) {
+		const ProcessPtr &process = *it;
+		if (!process->isAlive()) {
+			continue;
+		}
+		try {
+			process->warmConnectionPools();
+		} catch (const SystemException &e) {
+			P_DEBUG("Cannot pre-warm connections to process " << process->inspect()
+				<< ": " << e.what());
+		}
+	}
+}
+
+
+/****************************
+ *
+ * Public methods
+ *
+ ****************************/
+
+
+/**
+ * Asynchronously tops up the connection pools of the given process's
+ * sockets in a background thread. May be called with or without holding
+ * the pool lock.
+ */
+void
+Pool::warmConnectionPoolsLater(const ProcessPtr &process) {
+	boost::lock_guard<boost::mutex> l(connectionWarmingSyncher);
+	if (std::find(connectionWarmingQueue.begin(), connectionWarmingQueue.end(),
+		process) == connectionWarmingQueue.end())
+	{
+		connectionWarmingQueue.push_back(process);
+		connectionWarmingCond.notify_one();
+	}
+}
+
+void
+Pool::setMinIdleConnections(unsigned int value) {
+	PoolScopedLock l(syncher);
+	minIdleConnections = value;
+	vector<ProcessPtr> processes = getProcesses(false);
+	l.unlock();
+
+	foreach (ProcessPtr process, processes) {
+		process->setMinIdleConnections(value);
+		if (value > 0) {
+			warmConnectionPoolsLater(process);
+		}
+	}
+}
+
+
+} // namespace ApplicationPool2
+} // namespace Passenger
@@ -47,7 +47,7 @@ using namespace boost;
 
 const pair<uid_t, gid_t>
 Pool::getGroupRunUidAndGids(const StaticString &appGroupName) {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	GroupPtr *group;
 	if (!groups.lookup(appGroupName.c_str(), &group)) {
 		throw RuntimeException("Could not find group: " + appGroupName);
@@ -124,6 +124,10 @@ Pool::forceDetachGroup(const GroupPtr &group,
 	assert(removed);
 	(void) removed; // Shut up compiler warning.
 	group->shutdown(callback, postLockActions);
+
+	PoolStatusSnapshotPtr statusSnapshot;
+	discardStatusSnapshot(statusSnapshot);
+	postLockActions.push_back(boost::bind(releaseStatusSnapshot, statusSnapshot));
 }
 
 void
@@ -156,7 +160,7 @@ Pool::findOrCreateGroup(const Options &options) {
 
 	Ticket ticket;
 	{
-		LockGuard l(syncher);
+		PoolLockGuard l(syncher);
 		GroupPtr *group;
 		if (!groups.lookup(options.getAppGroupName(), &group)) {
 			// Forcefully create Group, don't care whether resource limits
@@ -169,7 +173,7 @@ Pool::findOrCreateGroup(const Options &options) {
 
 GroupPtr
 Pool::findGroupByApiKey(const StaticString &value, bool lock) const {
-	DynamicScopedLock l(syncher, lock);
+	DynamicPoolScopedLock l(syncher, lock);
 	GroupMap::ConstIterator g_it(groups);
 	while (*g_it != NULL) {
 		const GroupPtr &group = g_it.getValue();
@@ -184,7 +188,7 @@ Pool::findGroupByApiKey(const StaticString &value, bool lock) const {
 bool
 Pool::detachGroupByName(const HashedStaticString &name) {
 	TRACE_POINT();
-	ScopedLock l(syncher);
+	PoolScopedLock l(syncher);
 	GroupPtr group = groups.lookupCopy(name);
 
 	if (OXT_LIKELY(group != NULL)) {
@@ -227,7 +231,7 @@ Pool::detachGroupByName(const HashedStaticString &name) {
 
 bool
 Pool::detachGroupByApiKey(const StaticString &value) {
-	ScopedLock l(syncher);
+	PoolScopedLock l(syncher);
 	GroupPtr group = findGroupByApiKey(value, false);
 	if (group != NULL) {
 		string name = group->getName();
@@ -241,7 +245,7 @@ Pool::detachGroupByApiKey(const StaticString &value) {
 
 bool
 Pool::restartGroupByName(const StaticString &name, const RestartOptions &options) {
-	ScopedLock l(syncher);
+	PoolScopedLock l(syncher);
 	GroupMap::ConstIterator g_it(groups);
 	while (*g_it != NULL) {
 		const GroupPtr &group = g_it.getValue();
@@ -264,7 +268,7 @@ Pool::restartGroupByName(const StaticString &name, const RestartOptions &options
 
 unsigned int
 Pool::restartGroupsByAppRoot(const StaticString &appRoot, const RestartOptions &options) {
-	ScopedLock l(syncher);
+	PoolScopedLock l(syncher);
 	GroupMap::ConstIterator g_it(groups);
 	unsigned int result = 0;
 
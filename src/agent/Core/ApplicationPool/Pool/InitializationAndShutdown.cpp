@@ -51,7 +51,11 @@ Pool::Pool(Context *_context)
 	lifeStatus   = ALIVE;
 	max          = 6;
 	maxIdleTime  = 60 * 1000000;
+	minIdleConnections = 0;
+	maxSpawnConcurrency = DEFAULT_MAX_SPAWN_CONCURRENCY;
 	selfchecking = true;
+	predictiveAutoscaling = false;
+	autoscalerRunning = false;
 	palloc       = psg_create_pool(PSG_DEFAULT_POOL_SIZE);
 
 	// The following code only serve to instantiate certain inline methods
@@ -71,14 +75,15 @@ Pool::~Pool() {
 /** Must be called right after construction. */
 void
 Pool::initialize() {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	initializeAnalyticsCollection();
 	initializeGarbageCollection();
+	initializeConnectionWarming();
 }
 
 void
 Pool::initDebugging() {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	debugSupport = boost::make_shared<DebugSupport>();
 }
 
@@ -92,7 +97,7 @@ Pool::initDebugging() {
 void
 Pool::prepareForShutdown() {
 	TRACE_POINT();
-	ScopedLock lock(syncher);
+	PoolScopedLock lock(syncher);
 	assert(lifeStatus == ALIVE);
 	lifeStatus = PREPARED_FOR_SHUTDOWN;
 	if (abortLongRunningConnectionsCallback != NULL) {
@@ -100,6 +105,7 @@ Pool::prepareForShutdown() {
 		foreach (ProcessPtr process, processes) {
 			// Ensure that the process is not immediately respawned.
 			process->getGroup()->options.minProcesses = 0;
+			process->getGroup()->autoscalingTarget = 0;
 			abortLongRunningConnectionsCallback(process);
 		}
 	}
@@ -109,7 +115,7 @@ Pool::prepareForShutdown() {
 void
 Pool::destroy() {
 	TRACE_POINT();
-	ScopedLock lock(syncher);
+	PoolScopedLock lock(syncher);
 	assert(lifeStatus == ALIVE || lifeStatus == PREPARED_FOR_SHUTDOWN);
 
 	lifeStatus = SHUTTING_DOWN;
@@ -124,7 +130,12 @@ Pool::destroy() {
 	}
 
 	UPDATE_TRACE_POINT();
+	// Release the Groups and Processes that the last status snapshot
+	// refers to outside the lock.
+	PoolStatusSnapshotPtr statusSnapshot;
+	statusSnapshot.swap(lastStatusSnapshot);
 	lock.unlock();
+	statusSnapshot.reset();
 	P_DEBUG("Shutting down ApplicationPool background threads...");
 	interruptableThreads.interrupt_and_join_all();
 	nonInterruptableThreads.join_all();
@@ -38,11 +38,40 @@ using namespace std;
 using namespace boost;
 
 
+// Checks out a session from an existing Group while holding the pool lock
+// in fast path mode only, so that checkouts for different Groups do not
+// contend with each other. Returns false if that's not possible, in which
+// case the caller must take the normal asyncGet() code path.
+bool
+Pool::tryGetFromExistingGroupFast(const Options &options, SessionPtr &session) {
+	PoolFastPathLock lock(syncher);
+	if (OXT_UNLIKELY(!lock.owns_lock() || lifeStatus != ALIVE)) {
+		return false;
+	}
+
+	Group *group = findMatchingGroup(options);
+	if (OXT_UNLIKELY(group == NULL)) {
+		return false;
+	}
+
+	boost::lock_guard<boost::mutex> l(group->fastPathSyncher);
+	return group->tryGetFast(options, session);
+}
+
 // 'lockNow == false' may only be used during unit tests. Normally we
 // should never call the callback while holding the lock.
 void
 Pool::asyncGet(const Options &options, const GetCallback &callback, bool lockNow) {
-	DynamicScopedLock lock(syncher, lockNow);
+	if (OXT_LIKELY(lockNow)) {
+		SessionPtr session;
+		if (tryGetFromExistingGroupFast(options, session)) {
+			P_TRACE(2, "asyncGet() finished (fast path)");
+			callback(session, ExceptionPtr());
+			return;
+		}
+	}
+
+	DynamicPoolScopedLock lock(syncher, lockNow);
 
 	assert(lifeStatus == ALIVE || lifeStatus == PREPARED_FOR_SHUTDOWN);
 	verifyInvariants();
@@ -167,7 +196,7 @@ Pool::get(const Options &options, Ticket *ticket) {
 
 void
 Pool::setMax(unsigned int max) {
-	ScopedLock l(syncher);
+	PoolScopedLock l(syncher);
 	assert(max > 0);
 	fullVerifyInvariants();
 	bool bigger = max > this->max;
@@ -196,14 +225,21 @@ Pool::setMax(unsigned int max) {
 
 void
 Pool::setMaxIdleTime(unsigned long long value) {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	maxIdleTime = value;
 	wakeupGarbageCollector();
 }
 
+void
+Pool::setMaxSpawnConcurrency(unsigned int value) {
+	PoolLockGuard l(syncher);
+	assert(value > 0);
+	maxSpawnConcurrency = value;
+}
+
 void
 Pool::enableSelfChecking(bool enabled) {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	selfchecking = enabled;
 }
 
@@ -212,7 +248,7 @@ Pool::enableSelfChecking(bool enabled) {
  */
 bool
 Pool::isSpawning(bool lock) const {
-	DynamicScopedLock l(syncher, lock);
+	DynamicPoolScopedLock l(syncher, lock);
 	GroupMap::ConstIterator g_it(groups);
 	while (*g_it != NULL) {
 		const GroupPtr &group = g_it.getValue();
@@ -235,7 +271,7 @@ Pool::authorizeByUid(uid_t uid, bool lock) const {
 		return true;
 	}
 
-	DynamicScopedLock l(syncher, lock);
+	DynamicPoolScopedLock l(syncher, lock);
 	GroupMap::ConstIterator g_it(groups);
 	while (*g_it != NULL) {
 		const GroupPtr &group = g_it.getValue();
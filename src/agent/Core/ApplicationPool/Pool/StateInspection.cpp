@@ -68,21 +68,146 @@ Pool::atFullCapacityUnlocked() const {
 	return capacityUsedUnlocked() >= max;
 }
 
+unsigned int
+Pool::processesBeingSpawnedUnlocked() const {
+	GroupMap::ConstIterator g_it(groups);
+	unsigned int result = 0;
+	while (*g_it != NULL) {
+		const GroupPtr &group = g_it.getValue();
+		result += group->processesBeingSpawned;
+		g_it.next();
+	}
+	return result;
+}
+
+/**
+ * Copies the pool state into a new snapshot. The snapshots of Groups that
+ * haven't changed since `previous` was created are reused. The session
+ * counters are always copied. Must be called while holding the lock.
+ */
+boost::shared_ptr<PoolStatusSnapshot>
+Pool::createStatusSnapshot(const PoolStatusSnapshot *previous) const {
+	boost::shared_ptr<PoolStatusSnapshot> snapshot = boost::make_shared<PoolStatusSnapshot>();
+	vector<GroupStatusSnapshotPtr>::const_iterator prev_it, prev_end;
+	GroupMap::ConstIterator g_it(groups);
+
+	snapshot->max = max;
+	snapshot->minIdleConnections = minIdleConnections;
+	snapshot->predictiveAutoscaling = predictiveAutoscaling;
+	snapshot->getWaitlist.reserve(getWaitlist.size());
+	foreach (const GetWaiter &waiter, getWaitlist) {
+		snapshot->getWaitlist.push_back(waiter.options.getAppGroupName().toString());
+	}
+
+	if (previous != NULL) {
+		prev_it = previous->groups.begin();
+		prev_end = previous->groups.end();
+	}
+	snapshot->groups.reserve(groups.size());
+	snapshot->groupSessions.resize(groups.size());
+	while (*g_it != NULL) {
+		const GroupPtr &group = g_it.getValue();
+
+		// The group map is usually iterated in the same order as last time,
+		// so we look for a reusable snapshot at the same position only.
+		if (previous != NULL && prev_it != prev_end
+		 && (*prev_it)->group.get() == group.get()
+		 && (*prev_it)->version == group->statusVersion)
+		{
+			snapshot->groups.push_back(*prev_it);
+		} else {
+			boost::shared_ptr<GroupStatusSnapshot> groupSnapshot =
+				boost::make_shared<GroupStatusSnapshot>();
+			group->captureStatusSnapshot(*groupSnapshot);
+			snapshot->groups.push_back(groupSnapshot);
+		}
+		if (previous != NULL && prev_it != prev_end) {
+			prev_it++;
+		}
+		group->captureSessionStatus(snapshot->groupSessions[snapshot->groups.size() - 1]);
+
+		snapshot->processCount += snapshot->groups.back()->processCount;
+		snapshot->capacityUsed += snapshot->groups.back()->capacityUsed;
+		g_it.next();
+	}
+
+	return snapshot;
+}
+
+bool
+Pool::statusSnapshotChanged(const PoolStatusSnapshot &snapshot,
+	const PoolStatusSnapshot &previous)
+{
+	return snapshot.max != previous.max
+		|| snapshot.minIdleConnections != previous.minIdleConnections
+		|| snapshot.predictiveAutoscaling != previous.predictiveAutoscaling
+		|| snapshot.getWaitlist != previous.getWaitlist
+		|| snapshot.groups != previous.groups
+		|| snapshot.groupSessions != previous.groupSessions;
+}
+
+/**
+ * Moves `lastStatusSnapshot` into `result`, which must be empty. Called when
+ * a Process or Group leaves the pool, so that the snapshot doesn't keep it
+ * alive until the next `captureStatusSnapshot()` call. Must be called while
+ * holding the lock; the caller should release `result` outside the lock if
+ * possible.
+ */
+void
+Pool::discardStatusSnapshot(PoolStatusSnapshotPtr &result) {
+	assert(result == NULL);
+	result.swap(lastStatusSnapshot);
+}
+
+/**
+ * A post lock action that releases the given snapshot outside the lock.
+ */
+void
+Pool::releaseStatusSnapshot(PoolStatusSnapshotPtr snapshot) {
+	// Do nothing; `snapshot` is released when this action is destroyed.
+}
+
+void
+Pool::inspectConnectionPools(stringstream &result, const ProcessStatusSnapshot &process) {
+	SocketList::const_iterator it, end = process.process->getSockets().end();
+	unsigned int idle = 0;
+	unsigned long long hits = 0, misses = 0;
+	double connectsPerSecond = 0;
+	char buf[128];
+
+	for (it = process.process->getSockets().begin(); it != end; it++) {
+		if (it->acceptHttpRequests) {
+			ConnectionPoolStats stats = it->getConnectionPoolStats();
+			idle += stats.idleConnections;
+			hits += stats.hits;
+			misses += stats.misses;
+			connectsPerSecond += stats.connectsPerSecond;
+		}
+	}
+
+	snprintf(buf, sizeof(buf),
+		"    Conns: %-5u   Hits    : %-5llu   Misses   : %-5llu   Connects/sec: %.1f",
+		idle, hits, misses, connectsPerSecond);
+	result << buf << endl;
+}
+
 void
 Pool::inspectProcessList(const InspectOptions &options, stringstream &result,
-	const Group *group, const ProcessList &processes) const
+	const PoolStatusSnapshot &snapshot, const GroupStatusSnapshot &group,
+	const vector<ProcessStatusSnapshot> &processes,
+	GroupSessionStatus::const_iterator &sessionStatus)
 {
-	ProcessList::const_iterator p_it;
-	for (p_it = processes.begin(); p_it != processes.end(); p_it++) {
-		const ProcessPtr &process = *p_it;
+	vector<ProcessStatusSnapshot>::const_iterator p_it;
+	for (p_it = processes.begin(); p_it != processes.end(); p_it++, sessionStatus++) {
+		const ProcessStatusSnapshot &process = *p_it;
 		char buf[128];
 		char cpubuf[10];
 		char membuf[10];
 
-		 if (process->metrics.isValid()) {
-			snprintf(cpubuf, sizeof(cpubuf), "%d%%", (int) process->metrics.cpu);
+		 if (process.metrics.isValid()) {
+			snprintf(cpubuf, sizeof(cpubuf), "%d%%", (int) process.metrics.cpu);
 			snprintf(membuf, sizeof(membuf), "%ldM",
-				(unsigned long) (process->metrics.realMemory() / 1024));
+				(unsigned long) (process.metrics.realMemory() / 1024));
 		} else {
 			snprintf(cpubuf, sizeof(cpubuf), "0%%");
 			snprintf(membuf, sizeof(membuf), "0M");
@@ -90,27 +215,31 @@ Pool::inspectProcessList(const InspectOptions &options, stringstream &result,
 		snprintf(buf, sizeof(buf),
 			"  * PID: %-5lu   Sessions: %-2u      Processed: %-5u   Uptime: %s\n"
 			"    CPU: %-5s   Memory  : %-5s   Last used: %s ago",
-			(unsigned long) process->getPid(),
-			process->sessions,
-			process->processed,
-			process->uptime().c_str(),
+			(unsigned long) process.process->getPid(),
+			sessionStatus->sessions,
+			sessionStatus->processed,
+			process.process->uptime().c_str(),
 			cpubuf,
 			membuf,
-			distanceOfTimeInWords(process->lastUsed / 1000000).c_str());
+			distanceOfTimeInWords(sessionStatus->lastUsed / 1000000).c_str());
 		result << buf << endl;
 
-		if (process->enabled == Process::DISABLING) {
+		if (process.enabled == Process::DISABLING) {
 			result << "    Disabling..." << endl;
-		} else if (process->enabled == Process::DISABLED) {
+		} else if (process.enabled == Process::DISABLED) {
 			result << "    DISABLED" << endl;
-		} else if (process->enabled == Process::DETACHED) {
+		} else if (process.enabled == Process::DETACHED) {
 			result << "    Shutting down..." << endl;
 		}
 
+		if (snapshot.minIdleConnections > 0) {
+			inspectConnectionPools(result, process);
+		}
+
 		const Socket *socket;
-		if (options.verbose && (socket = process->getSockets().findFirstSocketWithProtocol("http")) != NULL) {
+		if (options.verbose && (socket = process.process->getSockets().findFirstSocketWithProtocol("http")) != NULL) {
 			result << "    URL     : http://" << replaceString(socket->address, "tcp://", "") << endl;
-			result << "    Password: " << group->getApiKey().toStaticString() << endl;
+			result << "    Password: " << group.getApiKey().toStaticString() << endl;
 		}
 	}
 }
@@ -123,81 +252,131 @@ Pool::inspectProcessList(const InspectOptions &options, stringstream &result,
  ****************************/
 
 
+/**
+ * Returns a snapshot of the state that is reported by `inspect()`, `toXml()`
+ * and `toCompactJson()`, so that it can be serialized without holding the
+ * lock. Only the Groups that changed since the last call are copied; the
+ * snapshots of the others are reused. If nothing changed at all, then the
+ * last snapshot itself is returned.
+ *
+ * If `lock` is false then the caller may or may not be holding the lock
+ * (e.g. because this is called from a crash handler), so the last snapshot
+ * is neither reused nor updated.
+ */
+PoolStatusSnapshotPtr
+Pool::captureStatusSnapshot(bool lock) const {
+	if (!lock) {
+		return createStatusSnapshot(NULL);
+	}
+
+	// Declared before the lock, so that the snapshot that it replaces
+	// (and the Groups and Processes that it refers to) is released
+	// outside the lock.
+	PoolStatusSnapshotPtr previous;
+	PoolScopedLock l(syncher);
+	boost::shared_ptr<PoolStatusSnapshot> snapshot =
+		createStatusSnapshot(lastStatusSnapshot.get());
+
+	if (lastStatusSnapshot == NULL) {
+		snapshot->version = 1;
+	} else if (statusSnapshotChanged(*snapshot, *lastStatusSnapshot)) {
+		snapshot->version = lastStatusSnapshot->version + 1;
+	} else {
+		return lastStatusSnapshot;
+	}
+	previous = lastStatusSnapshot;
+	lastStatusSnapshot = snapshot;
+	return snapshot;
+}
+
 string
 Pool::inspect(const InspectOptions &options, bool lock) const {
-	DynamicScopedLock l(syncher, lock);
+	PoolStatusSnapshotPtr snapshot = captureStatusSnapshot(lock);
 	stringstream result;
 	const char *headerColor = maybeColorize(options, ANSI_COLOR_YELLOW ANSI_COLOR_BLUE_BG ANSI_COLOR_BOLD);
 	const char *resetColor  = maybeColorize(options, ANSI_COLOR_RESET);
+	vector<GroupStatusSnapshotPtr>::const_iterator g_it;
 
-	if (!authorizeByUid(options.uid, false)
-	 && !authorizeByApiKey(options.apiKey, false))
+	if (!snapshot->authorizeByUid(options.uid)
+	 && !snapshot->authorizeByApiKey(options.apiKey))
 	{
 		throw SecurityException("Operation unauthorized");
 	}
 
 	result << headerColor << "----------- General information -----------" << resetColor << endl;
-	result << "Max pool size : " << max << endl;
-	result << "App groups    : " << groups.size() << endl;
-	result << "Processes     : " << getProcessCount(false) << endl;
-	result << "Requests in top-level queue : " << getWaitlist.size() << endl;
+	result << "Max pool size : " << snapshot->max << endl;
+	result << "App groups    : " << snapshot->groups.size() << endl;
+	result << "Processes     : " << snapshot->processCount << endl;
+	result << "Requests in top-level queue : " << snapshot->getWaitlist.size() << endl;
 	if (options.verbose) {
 		unsigned int i = 0;
-		foreach (const GetWaiter &waiter, getWaitlist) {
-			result << "  " << i << ": " << waiter.options.getAppGroupName() << endl;
+		foreach (const string &appGroupName, snapshot->getWaitlist) {
+			result << "  " << i << ": " << appGroupName << endl;
 			i++;
 		}
 	}
 	result << endl;
 
 	result << headerColor << "----------- Application groups -----------" << resetColor << endl;
-	GroupMap::ConstIterator g_it(groups);
-	while (*g_it != NULL) {
-		const GroupPtr &group = g_it.getValue();
-		if (!group->authorizeByUid(options.uid)
-		 && !group->authorizeByApiKey(options.apiKey))
+	for (g_it = snapshot->groups.begin(); g_it != snapshot->groups.end(); g_it++) {
+		const GroupStatusSnapshot &group = **g_it;
+		if (!group.authorizeByUid(options.uid)
+		 && !group.authorizeByApiKey(options.apiKey))
 		{
-			g_it.next();
 			continue;
 		}
 
-		ProcessList::const_iterator p_it;
-
-		result << group->getName() << ":" << endl;
-		result << "  App root: " << group->options.appRoot << endl;
-		if (group->restarting()) {
+		result << group.getName() << ":" << endl;
+		result << "  App root: " << group.options.appRoot << endl;
+		if (group.restarting) {
 			result << "  (restarting...)" << endl;
 		}
-		if (group->spawning()) {
-			if (group->processesBeingSpawned == 0) {
+		if (group.spawning) {
+			if (group.processesBeingSpawned == 0) {
 				result << "  (spawning...)" << endl;
 			} else {
-				result << "  (spawning " << group->processesBeingSpawned << " new " <<
-					maybePluralize(group->processesBeingSpawned, "process", "processes") <<
+				result << "  (spawning " << group.processesBeingSpawned << " new " <<
+					maybePluralize(group.processesBeingSpawned, "process", "processes") <<
 					"...)" << endl;
 			}
 		}
-		result << "  Requests in queue: " << group->getWaitlist.size() << endl;
-		inspectProcessList(options, result, group.get(), group->enabledProcesses);
-		inspectProcessList(options, result, group.get(), group->disablingProcesses);
-		inspectProcessList(options, result, group.get(), group->disabledProcesses);
-		inspectProcessList(options, result, group.get(), group->detachedProcesses);
+		result << "  Requests in queue: " << group.getWaitlistSize << endl;
+		if (snapshot->predictiveAutoscaling) {
+			const DemandEstimator &estimator = group.demandEstimator;
+			stringstream autoscaling;
+			autoscaling << std::fixed << std::setprecision(1);
+			if (estimator.getArrivalRate() < 0) {
+				autoscaling << "unknown";
+			} else {
+				autoscaling << estimator.getArrivalRate();
+			}
+			autoscaling << " req/s, concurrency " << estimator.getAverageConcurrency()
+				<< " +/- " << estimator.getConcurrencyStddev()
+				<< ", predicted " << estimator.getPredictedConcurrency();
+			result << "  Autoscaling: " << autoscaling.str() << " => target "
+				<< group.autoscalingTarget << " "
+				<< maybePluralize(group.autoscalingTarget, "process", "processes")
+				<< endl;
+		}
+		GroupSessionStatus::const_iterator s_it =
+			snapshot->groupSessions[g_it - snapshot->groups.begin()].begin();
+		inspectProcessList(options, result, *snapshot, group, group.enabledProcesses, s_it);
+		inspectProcessList(options, result, *snapshot, group, group.disablingProcesses, s_it);
+		inspectProcessList(options, result, *snapshot, group, group.disabledProcesses, s_it);
+		inspectProcessList(options, result, *snapshot, group, group.detachedProcesses, s_it);
 		result << endl;
-
-		g_it.next();
 	}
 	return result.str();
 }
 
 string
 Pool::toXml(const ToXmlOptions &options, bool lock) const {
-	DynamicScopedLock l(syncher, lock);
+	PoolStatusSnapshotPtr snapshot = captureStatusSnapshot(lock);
 	stringstream result;
-	GroupMap::ConstIterator g_it(groups);
-	ProcessList::const_iterator p_it;
+	vector<GroupStatusSnapshotPtr>::const_iterator g_it;
 
-	if (!authorizeByUid(options.uid, false)
-	 && !authorizeByApiKey(options.apiKey, false))
+	if (!snapshot->authorizeByUid(options.uid)
+	 && !snapshot->authorizeByApiKey(options.apiKey))
 	{
 		throw SecurityException("Operation unauthorized");
 	}
@@ -206,51 +385,46 @@ Pool::toXml(const ToXmlOptions &options, bool lock) const {
 	result << "<info version=\"3\">";
 
 	result << "<passenger_version>" << PASSENGER_VERSION << "</passenger_version>";
-	result << "<group_count>" << groups.size() << "</group_count>";
-	result << "<process_count>" << getProcessCount(false) << "</process_count>";
-	result << "<max>" << max << "</max>";
-	result << "<capacity_used>" << capacityUsedUnlocked() << "</capacity_used>";
-	result << "<get_wait_list_size>" << getWaitlist.size() << "</get_wait_list_size>";
+	result << "<group_count>" << snapshot->groups.size() << "</group_count>";
+	result << "<process_count>" << snapshot->processCount << "</process_count>";
+	result << "<max>" << snapshot->max << "</max>";
+	result << "<capacity_used>" << snapshot->capacityUsed << "</capacity_used>";
+	result << "<get_wait_list_size>" << snapshot->getWaitlist.size() << "</get_wait_list_size>";
 
 	if (options.secrets) {
-		vector<GetWaiter>::const_iterator w_it, w_end = getWaitlist.end();
-
 		result << "<get_wait_list>";
-		for (w_it = getWaitlist.begin(); w_it != w_end; w_it++) {
-			const GetWaiter &waiter = *w_it;
+		foreach (const string &appGroupName, snapshot->getWaitlist) {
 			result << "<item>";
-			result << "<app_group_name>" << escapeForXml(waiter.options.getAppGroupName()) << "</app_group_name>";
+			result << "<app_group_name>" << escapeForXml(appGroupName) << "</app_group_name>";
 			result << "</item>";
 		}
 		result << "</get_wait_list>";
 	}
 
 	result << "<supergroups>";
-	while (*g_it != NULL) {
-		const GroupPtr &group = g_it.getValue();
-		if (!group->authorizeByUid(options.uid)
-		 && !group->authorizeByApiKey(options.apiKey))
+	for (g_it = snapshot->groups.begin(); g_it != snapshot->groups.end(); g_it++) {
+		const GroupStatusSnapshot &group = **g_it;
+		if (!group.authorizeByUid(options.uid)
+		 && !group.authorizeByApiKey(options.apiKey))
 		{
-			g_it.next();
 			continue;
 		}
 
 		result << "<supergroup>";
-		result << "<name>" << escapeForXml(group->getName()) << "</name>";
+		result << "<name>" << escapeForXml(group.getName()) << "</name>";
 		result << "<state>READY</state>";
 		result << "<get_wait_list_size>0</get_wait_list_size>";
-		result << "<capacity_used>" << group->capacityUsed() << "</capacity_used>";
+		result << "<capacity_used>" << group.capacityUsed << "</capacity_used>";
 		if (options.secrets) {
-			result << "<secret>" << escapeForXml(group->getApiKey().toStaticString()) << "</secret>";
+			result << "<secret>" << escapeForXml(group.getApiKey().toStaticString()) << "</secret>";
 		}
 
 		result << "<group default=\"true\">";
-		group->inspectXml(result, options.secrets);
+		group.inspectXml(result, snapshot->groupSessions[g_it - snapshot->groups.begin()],
+			options.secrets);
 		result << "</group>";
 
 		result << "</supergroup>";
-
-		g_it.next();
 	}
 	result << "</supergroups>";
 
@@ -258,9 +432,54 @@ Pool::toXml(const ToXmlOptions &options, bool lock) const {
 	return result.str();
 }
 
+/**
+ * Like `toXml()`, but returns a much smaller JSON document that omits the
+ * group options, user switching information and socket details. Its
+ * `version` field changes only if the pool state has changed, so pollers
+ * can cheaply tell whether anything happened since their last poll.
+ */
+string
+Pool::toCompactJson(const ToXmlOptions &options, bool lock) const {
+	PoolStatusSnapshotPtr snapshot = captureStatusSnapshot(lock);
+	Json::Value doc(Json::objectValue);
+	Json::Value groupsDoc(Json::arrayValue);
+	vector<GroupStatusSnapshotPtr>::const_iterator g_it;
+
+	if (!snapshot->authorizeByUid(options.uid)
+	 && !snapshot->authorizeByApiKey(options.apiKey))
+	{
+		throw SecurityException("Operation unauthorized");
+	}
+
+	doc["version"] = (Json::UInt64) snapshot->version;
+	doc["passenger_version"] = PASSENGER_VERSION;
+	doc["group_count"] = (Json::UInt) snapshot->groups.size();
+	doc["process_count"] = snapshot->processCount;
+	doc["max"] = snapshot->max;
+	doc["capacity_used"] = snapshot->capacityUsed;
+	doc["get_wait_list_size"] = (Json::UInt) snapshot->getWaitlist.size();
+
+	for (g_it = snapshot->groups.begin(); g_it != snapshot->groups.end(); g_it++) {
+		const GroupStatusSnapshot &group = **g_it;
+		if (!group.authorizeByUid(options.uid)
+		 && !group.authorizeByApiKey(options.apiKey))
+		{
+			continue;
+		}
+
+		Json::Value groupDoc(Json::objectValue);
+		group.inspectJson(groupDoc, snapshot->groupSessions[g_it - snapshot->groups.begin()],
+			options.secrets);
+		groupsDoc.append(groupDoc);
+	}
+	doc["groups"] = groupsDoc;
+
+	return Json::FastWriter().write(doc);
+}
+
 Json::Value
 Pool::inspectPropertiesInAdminPanelFormat(const ToJsonOptions &options) const {
-	ScopedLock l(syncher);
+	PoolScopedLock l(syncher);
 	Json::Value result(Json::objectValue);
 	GroupMap::ConstIterator g_it(groups);
 	ProcessList::const_iterator p_it;
@@ -301,7 +520,7 @@ Pool::inspectPropertiesInAdminPanelFormat(const ToJsonOptions &options) const {
 
 Json::Value
 Pool::inspectConfigInAdminPanelFormat(const ToJsonOptions &options) const {
-	ScopedLock l(syncher);
+	PoolScopedLock l(syncher);
 	Json::Value result(Json::objectValue);
 	GroupMap::ConstIterator g_it(groups);
 	ProcessList::const_iterator p_it;
@@ -390,13 +609,13 @@ Pool::makeSingleNonEmptyStrValueJsonConfigFormat(const StaticString &val) {
 
 unsigned int
 Pool::capacityUsed() const {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	return capacityUsedUnlocked();
 }
 
 bool
 Pool::atFullCapacity() const {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	return atFullCapacityUnlocked();
 }
 
@@ -407,7 +626,7 @@ Pool::atFullCapacity() const {
  */
 unsigned int
 Pool::getProcessCount(bool lock) const {
-	DynamicScopedLock l(syncher, lock);
+	DynamicPoolScopedLock l(syncher, lock);
 	unsigned int result = 0;
 	GroupMap::ConstIterator g_it(groups);
 	while (*g_it != NULL) {
@@ -420,7 +639,7 @@ Pool::getProcessCount(bool lock) const {
 
 unsigned int
 Pool::getGroupCount() const {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	return groups.size();
 }
 
@@ -0,0 +1,170 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_APPLICATION_POOL2_POOL_MUTEX_H_
+#define _PASSENGER_APPLICATION_POOL2_POOL_MUTEX_H_
+
+#include <boost/thread.hpp>
+#include <boost/atomic.hpp>
+#include <oxt/macros.hpp>
+
+namespace Passenger {
+namespace ApplicationPool2 {
+
+using namespace boost;
+
+
+/**
+ * The lock that protects the entire ApplicationPool state. It can be held in
+ * two modes:
+ *
+ *  - Exclusive mode, through lock()/unlock(). This is what almost all code uses,
+ *    and it behaves exactly like a plain mutex. Holding the lock exclusively
+ *    allows one to access and modify any Pool, Group, Process and Socket field.
+ *  - Fast path mode, through tryLockFastPath()/unlockFastPath(). Multiple threads
+ *    may hold the lock in this mode at the same time, as long as no thread holds
+ *    it exclusively. A thread that holds the lock in fast path mode must also hold
+ *    the `fastPathSyncher` of the Group that it operates on, and may only modify
+ *    the session accounting state of that Group and its Processes (see
+ *    Group::tryGetFast() and Group::tryCloseSessionFast()). It may read, but not
+ *    modify, any other state.
+ *
+ * Acquiring the lock in fast path mode never blocks: if the lock is held
+ * exclusively (or about to be) then tryLockFastPath() fails, and the caller must
+ * fall back to the exclusive code path. Exclusive lockers wait until all fast
+ * path holders are gone. Fast path critical sections are very short, so that
+ * wait is a short spin.
+ *
+ * This type satisfies the Boost Lockable concept, so it can be used with
+ * boost::unique_lock, boost::lock_guard and boost::condition_variable_any.
+ */
+class PoolMutex {
+private:
+	boost::mutex exclusiveMutex;
+	boost::atomic<bool> exclusive;
+	boost::atomic<int> fastPathHolders;
+
+	void waitForFastPathHolders() {
+		unsigned int iterations = 0;
+		while (fastPathHolders.load(boost::memory_order_seq_cst) > 0) {
+			if (++iterations < 64) {
+				// Busy spin; the holder is most likely about to leave.
+			} else {
+				boost::this_thread::yield();
+			}
+		}
+	}
+
+public:
+	PoolMutex()
+		: exclusive(false),
+		  fastPathHolders(0)
+		{ }
+
+	void lock() {
+		exclusiveMutex.lock();
+		exclusive.store(true, boost::memory_order_seq_cst);
+		waitForFastPathHolders();
+	}
+
+	bool try_lock() {
+		if (!exclusiveMutex.try_lock()) {
+			return false;
+		}
+		exclusive.store(true, boost::memory_order_seq_cst);
+		waitForFastPathHolders();
+		return true;
+	}
+
+	void unlock() {
+		exclusive.store(false, boost::memory_order_release);
+		exclusiveMutex.unlock();
+	}
+
+	/**
+	 * Attempts to acquire the lock in fast path mode. Returns whether
+	 * that succeeded. Never blocks.
+	 */
+	bool tryLockFastPath() {
+		fastPathHolders.fetch_add(1, boost::memory_order_seq_cst);
+		if (OXT_UNLIKELY(exclusive.load(boost::memory_order_seq_cst))) {
+			fastPathHolders.fetch_sub(1, boost::memory_order_release);
+			return false;
+		} else {
+			return true;
+		}
+	}
+
+	void unlockFastPath() {
+		fastPathHolders.fetch_sub(1, boost::memory_order_release);
+	}
+};
+
+typedef boost::lock_guard<PoolMutex> PoolLockGuard;
+typedef boost::unique_lock<PoolMutex> PoolScopedLock;
+
+/** Like DynamicScopedLock, but for PoolMutex. */
+class DynamicPoolScopedLock: public boost::unique_lock<PoolMutex> {
+public:
+	DynamicPoolScopedLock(PoolMutex &m, bool lockNow = true)
+		: boost::unique_lock<PoolMutex>(m, boost::defer_lock)
+	{
+		if (lockNow) {
+			lock();
+		}
+	}
+};
+
+/**
+ * RAII helper for holding a PoolMutex in fast path mode. Acquisition may
+ * fail, so check `owns_lock()` after construction.
+ */
+class PoolFastPathLock {
+private:
+	PoolMutex &mutex;
+	bool locked;
+
+public:
+	PoolFastPathLock(PoolMutex &m)
+		: mutex(m),
+		  locked(m.tryLockFastPath())
+		{ }
+
+	~PoolFastPathLock() {
+		if (locked) {
+			mutex.unlockFastPath();
+		}
+	}
+
+	bool owns_lock() const {
+		return locked;
+	}
+};
+
+
+} // namespace ApplicationPool2
+} // namespace Passenger
+
+#endif /* _PASSENGER_APPLICATION_POOL2_POOL_MUTEX_H_ */
@@ -91,10 +91,15 @@ private:
 	void deinitiate(bool success, bool wantKeepAlive) {
 		connection.fail = !success;
 		connection.wantKeepAlive = wantKeepAlive;
-		socket->checkinConnection(connection);
+		bool needsWarming = socket->checkinConnection(connection);
 		connection.fd = -1;
+		if (needsWarming) {
+			requestConnectionPoolWarming();
+		}
 	}
 
+	void requestConnectionPoolWarming();
+
 	void callOnInitiateFailure() {
 		if (OXT_LIKELY(onInitiateFailure != NULL)) {
 			onInitiateFailure(this);
@@ -184,7 +189,7 @@ public:
 	virtual void initiate(bool blocking = true) {
 		assert(!closed);
 		ScopeGuard g(boost::bind(&Session::callOnInitiateFailure, this));
-		Connection connection = socket->checkoutConnection();
+		Connection connection = socket->checkoutConnection(blocking);
 		connection.fail = true;
 		if (connection.blocking && !blocking) {
 			FdGuard g2(connection.fd, NULL, 0);
@@ -196,6 +201,23 @@ public:
 		this->connection = connection;
 	}
 
+	virtual bool isConnecting() const {
+		return connection.connecting();
+	}
+
+	virtual bool canPollForConnect() const {
+		assert(!closed);
+		return Socket::canPollForConnect(connection);
+	}
+
+	virtual bool continueConnecting() {
+		assert(!closed);
+		ScopeGuard g(boost::bind(&Session::callOnInitiateFailure, this));
+		bool result = socket->continueConnecting(connection);
+		g.clear();
+		return result;
+	}
+
 	bool initiated() const {
 		return connection.fd != -1;
 	}
@@ -28,16 +28,19 @@
 
 #include <vector>
 #include <oxt/macros.hpp>
+#include <oxt/system_calls.hpp>
 #include <boost/thread.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/weak_ptr.hpp>
 #include <climits>
 #include <cassert>
+#include <poll.h>
 #include <SmallVector.h>
 #include <LoggingKit/LoggingKit.h>
 #include <StaticString.h>
 #include <MemoryKit/palloc.h>
 #include <Utils/IOUtils.h>
+#include <Utils/SystemTime.h>
 #include <Core/ApplicationPool/Common.h>
 
 namespace Passenger {
@@ -49,19 +52,36 @@ using namespace boost;
 
 struct Connection {
 	int fd;
+	/**
+	 * Non-NULL while a non-blocking connect is still in progress, in which
+	 * case the file descriptor is owned by this state structure.
+	 */
+	NConnect_State *connectState;
 	bool wantKeepAlive: 1;
 	bool fail: 1;
 	bool blocking: 1;
 
 	Connection()
 		: fd(-1),
+		  connectState(NULL),
 		  wantKeepAlive(false),
 		  fail(false),
 		  blocking(true)
 		{ }
 
+	bool connecting() const {
+		return connectState != NULL;
+	}
+
 	void close() {
-		if (fd != -1) {
+		if (connectState != NULL) {
+			NConnect_State *state = connectState;
+			connectState = NULL;
+			fd = -1;
+			wantKeepAlive = false;
+			// Closes the file descriptor.
+			delete state;
+		} else if (fd != -1) {
 			int fd2 = fd;
 			fd = -1;
 			wantKeepAlive = false;
@@ -71,18 +91,77 @@ struct Connection {
 	}
 };
 
+struct ConnectionPoolStats {
+	unsigned int idleConnections;
+	unsigned int totalConnections;
+	unsigned int minIdleConnections;
+	unsigned long long hits;
+	unsigned long long misses;
+	unsigned long long connects;
+	double connectsPerSecond;
+};
+
 /**
  * Not thread-safe except for the connection pooling methods, so only use
  * within the ApplicationPool lock.
  */
 class Socket {
 private:
-	boost::mutex connectionPoolLock;
+	mutable boost::mutex connectionPoolLock;
 	vector<Connection> idleConnections;
 
+	// Connection pool statistics. Protected by connectionPoolLock.
+	unsigned long long connectionPoolHits;
+	unsigned long long connectionPoolMisses;
+	unsigned long long connects;
+	MonotonicTimeUsec connectRateWindowStart;
+	unsigned int connectsInWindow;
+	double connectRate;
+
 	OXT_FORCE_INLINE
 	int connectionPoolLimit() const {
-		return concurrency;
+		if (concurrency == 0) {
+			return minIdleConnections;
+		} else {
+			return concurrency;
+		}
+	}
+
+	/**
+	 * Only sockets with unlimited concurrency are pre-warmed. A process
+	 * with a fixed number of workers would tie up one worker for every
+	 * idle connection that it accepted.
+	 */
+	bool connectionPoolNeedsWarming() const {
+		return !connectionPoolClosed
+			&& concurrency == 0
+			&& totalIdleConnections + warmingConnections < (int) minIdleConnections;
+	}
+
+	/**
+	 * An idle connection is not supposed to have anything to read. If it
+	 * is readable then the application has closed it (e.g. because of an
+	 * idle timeout) or sent something we did not ask for. Either way it
+	 * cannot be used for a new request.
+	 */
+	static bool idleConnectionIsUsable(const Connection &connection) {
+		struct pollfd pfd;
+		pfd.fd = connection.fd;
+		pfd.events = POLLIN;
+		pfd.revents = 0;
+		return oxt::syscalls::poll(&pfd, 1, 0) == 0;
+	}
+
+	void recordConnect() {
+		MonotonicTimeUsec now = SystemTime::getMonotonicUsecWithGranularity
+			<SystemTime::GRAN_10MSEC>();
+		connects++;
+		if (now - connectRateWindowStart >= 1000000) {
+			connectRate = connectsInWindow * 1000000.0 / (now - connectRateWindowStart);
+			connectRateWindowStart = now;
+			connectsInWindow = 0;
+		}
+		connectsInWindow++;
 	}
 
 	Connection connect() const {
@@ -96,6 +175,38 @@ private:
 		return connection;
 	}
 
+	Connection connectNonBlocking() const {
+		Connection connection;
+		NConnect_State *state = new NConnect_State();
+		P_TRACE(3, "Connecting to " << address << " (non-blocking)");
+		try {
+			setupNonBlockingSocket(*state, address, __FILE__, __LINE__);
+			if (connectToServer(*state)) {
+				connection.fd = getFd(*state).detach();
+				delete state;
+			} else {
+				connection.fd = getFd(*state);
+				connection.connectState = state;
+			}
+		} catch (...) {
+			delete state;
+			throw;
+		}
+		connection.fail = true;
+		connection.wantKeepAlive = false;
+		connection.blocking = false;
+		P_LOG_FILE_DESCRIPTOR_PURPOSE(connection.fd, "App " << pid << " connection");
+		return connection;
+	}
+
+	static FileDescriptor &getFd(NConnect_State &state) {
+		if (state.type == SAT_UNIX) {
+			return state.s_unix.fd;
+		} else {
+			return state.s_tcp.fd;
+		}
+	}
+
 public:
 	// Socket properties. Read-only.
 	StaticString address;
@@ -113,19 +224,34 @@ public:
 	// Private. In public section as alignment optimization.
 	int totalConnections;
 	int totalIdleConnections;
+	int warmingConnections;
+	unsigned int minIdleConnections;
+	bool connectionPoolClosed;
 
 	/** Invariant: sessions >= 0 */
 	int sessions;
 
 	Socket()
-		: pid(-1),
+		: connectionPoolHits(0),
+		  connectionPoolMisses(0),
+		  connects(0),
+		  connectRateWindowStart(0),
+		  connectsInWindow(0),
+		  connectRate(0),
+		  pid(-1),
 		  concurrency(-1),
 		  acceptHttpRequests(0)
 		{ }
 
 	Socket(pid_t _pid, const StaticString &_address, const StaticString &_protocol,
 		const StaticString &_description, int _concurrency, bool _acceptHttpRequests)
-		: address(_address),
+		: connectionPoolHits(0),
+		  connectionPoolMisses(0),
+		  connects(0),
+		  connectRateWindowStart(0),
+		  connectsInWindow(0),
+		  connectRate(0),
+		  address(_address),
 		  protocol(_protocol),
 		  description(_description),
 		  pid(_pid),
@@ -133,11 +259,20 @@ public:
 		  acceptHttpRequests(_acceptHttpRequests),
 		  totalConnections(0),
 		  totalIdleConnections(0),
+		  warmingConnections(0),
+		  minIdleConnections(0),
+		  connectionPoolClosed(false),
 		  sessions(0)
 		{ }
 
 	Socket(const Socket &other)
 		: idleConnections(other.idleConnections),
+		  connectionPoolHits(other.connectionPoolHits),
+		  connectionPoolMisses(other.connectionPoolMisses),
+		  connects(other.connects),
+		  connectRateWindowStart(other.connectRateWindowStart),
+		  connectsInWindow(other.connectsInWindow),
+		  connectRate(other.connectRate),
 		  address(other.address),
 		  protocol(other.protocol),
 		  description(other.description),
@@ -146,13 +281,25 @@ public:
 		  acceptHttpRequests(other.acceptHttpRequests),
 		  totalConnections(other.totalConnections),
 		  totalIdleConnections(other.totalIdleConnections),
+		  warmingConnections(other.warmingConnections),
+		  minIdleConnections(other.minIdleConnections),
+		  connectionPoolClosed(other.connectionPoolClosed),
 		  sessions(other.sessions)
 		{ }
 
 	Socket &operator=(const Socket &other) {
 		totalConnections = other.totalConnections;
 		totalIdleConnections = other.totalIdleConnections;
+		warmingConnections = other.warmingConnections;
+		minIdleConnections = other.minIdleConnections;
+		connectionPoolClosed = other.connectionPoolClosed;
 		idleConnections = other.idleConnections;
+		connectionPoolHits = other.connectionPoolHits;
+		connectionPoolMisses = other.connectionPoolMisses;
+		connects = other.connects;
+		connectRateWindowStart = other.connectRateWindowStart;
+		connectsInWindow = other.connectsInWindow;
+		connectRate = other.connectRate;
 		address = other.address;
 		protocol = other.protocol;
 		description = other.description;
@@ -166,31 +313,85 @@ public:
 	/**
 	 * Connect to this socket or reuse an existing connection.
 	 *
+	 * If `blocking` is false and a new connection has to be made, then
+	 * connecting is done in non-blocking mode. If the connection cannot be
+	 * established immediately, then the returned Connection is still
+	 * `connecting()`, and one must call continueConnecting() until it
+	 * returns true before using the connection.
+	 *
 	 * One MUST call checkinConnection() when one's done using the Connection.
 	 * Failure to do so will result in a resource leak.
 	 */
-	Connection checkoutConnection() {
+	Connection checkoutConnection(bool blocking = true) {
 		boost::unique_lock<boost::mutex> l(connectionPoolLock);
 
-		if (!idleConnections.empty()) {
-			P_TRACE(3, "Socket " << address << ": checking out connection from connection pool (" <<
-				idleConnections.size() << " -> " << (idleConnections.size() - 1) <<
-				" items). Current total number of connections: " << totalConnections);
+		while (!idleConnections.empty()) {
 			Connection connection = idleConnections.back();
 			idleConnections.pop_back();
 			totalIdleConnections--;
+			if (OXT_UNLIKELY(!idleConnectionIsUsable(connection))) {
+				totalConnections--;
+				P_DEBUG("Socket " << address << ": discarding idle connection "
+					"that was closed by the application. There are now " <<
+					totalConnections << " connections in total");
+				connection.close();
+				continue;
+			}
+			P_TRACE(3, "Socket " << address << ": checking out connection from connection pool (" <<
+				(idleConnections.size() + 1) << " -> " << idleConnections.size() <<
+				" items). Current total number of connections: " << totalConnections);
+			connectionPoolHits++;
 			return connection;
+		}
+
+		Connection connection = blocking ? connect() : connectNonBlocking();
+		totalConnections++;
+		connectionPoolMisses++;
+		recordConnect();
+		P_TRACE(3, "Socket " << address << ": there are now " <<
+			totalConnections << " total connections");
+		l.unlock();
+		return connection;
+	}
+
+	/**
+	 * Checks whether a connection returned by a non-blocking
+	 * checkoutConnection() has been established. Returns false if
+	 * connecting is still in progress.
+	 *
+	 * @throws SystemException Connecting failed.
+	 */
+	bool continueConnecting(Connection &connection) const {
+		assert(connection.connecting());
+		if (connectToServer(*connection.connectState)) {
+			getFd(*connection.connectState).detach();
+			delete connection.connectState;
+			connection.connectState = NULL;
+			P_TRACE(3, "Socket " << address << ": connection established");
+			return true;
 		} else {
-			Connection connection = connect();
-			totalConnections++;
-			P_TRACE(3, "Socket " << address << ": there are now " <<
-				totalConnections << " total connections");
-			l.unlock();
-			return connection;
+			return false;
 		}
 	}
 
-	void checkinConnection(Connection &connection) {
+	/**
+	 * Whether one can wait for a connection that is still connecting by
+	 * polling its file descriptor for writability. This is not the case for
+	 * Unix domain sockets: connecting to one fails with EAGAIN when its listen
+	 * backlog is full, and the socket does not become writable once there is
+	 * room again. One must retry continueConnecting() periodically instead.
+	 */
+	static bool canPollForConnect(const Connection &connection) {
+		assert(connection.connecting());
+		return connection.connectState->type != SAT_UNIX;
+	}
+
+	/**
+	 * Returns whether the connection pool has dropped below its minimum
+	 * number of idle connections, in which case the caller should arrange
+	 * for warmConnectionPool() to be called.
+	 */
+	bool checkinConnection(Connection &connection) {
 		boost::unique_lock<boost::mutex> l(connectionPoolLock);
 
 		if (connection.fail || !connection.wantKeepAlive || totalIdleConnections >= connectionPoolLimit()) {
@@ -199,21 +400,97 @@ public:
 			P_TRACE(3, "Socket " << address << ": connection not checked back into "
 				"connection pool. There are now " << totalConnections <<
 				" connections in total");
+			bool needsWarming = connectionPoolNeedsWarming();
 			l.unlock();
 			connection.close();
+			return needsWarming;
 		} else {
 			P_TRACE(3, "Socket " << address << ": checking in connection into connection pool (" <<
 				totalIdleConnections << " -> " << (totalIdleConnections + 1) <<
 				" items). Current total number of connections: " << totalConnections);
 			totalIdleConnections++;
 			idleConnections.push_back(connection);
+			return connectionPoolNeedsWarming();
+		}
+	}
+
+	void setMinIdleConnections(unsigned int value) {
+		boost::lock_guard<boost::mutex> l(connectionPoolLock);
+		minIdleConnections = value;
+	}
+
+	/**
+	 * Establishes new idle connections until the connection pool contains
+	 * at least the minimum number of idle connections. Connecting is done
+	 * without holding the lock, and may block, so don't call this from an
+	 * event loop.
+	 *
+	 * @throws SystemException Connecting failed.
+	 */
+	void warmConnectionPool() {
+		boost::unique_lock<boost::mutex> l(connectionPoolLock);
+
+		while (connectionPoolNeedsWarming()) {
+			Connection connection;
+
+			totalConnections++;
+			warmingConnections++;
+			l.unlock();
+			try {
+				connection = connect();
+			} catch (...) {
+				l.lock();
+				warmingConnections--;
+				if (!connectionPoolClosed) {
+					totalConnections--;
+				}
+				throw;
+			}
+			l.lock();
+			warmingConnections--;
+
+			if (connectionPoolClosed) {
+				l.unlock();
+				connection.close();
+				return;
+			}
+			P_TRACE(3, "Socket " << address << ": pre-warmed a connection (" <<
+				totalIdleConnections << " -> " << (totalIdleConnections + 1) <<
+				" idle connections)");
+			totalIdleConnections++;
+			idleConnections.push_back(connection);
+			recordConnect();
+		}
+	}
+
+	ConnectionPoolStats getConnectionPoolStats() const {
+		boost::lock_guard<boost::mutex> l(connectionPoolLock);
+		ConnectionPoolStats stats;
+		MonotonicTimeUsec now = SystemTime::getMonotonicUsecWithGranularity
+			<SystemTime::GRAN_10MSEC>();
+
+		stats.idleConnections = totalIdleConnections;
+		stats.totalConnections = totalConnections;
+		stats.minIdleConnections = minIdleConnections;
+		stats.hits = connectionPoolHits;
+		stats.misses = connectionPoolMisses;
+		stats.connects = connects;
+		if (now - connectRateWindowStart >= 1000000) {
+			// No connects have been made for a while, so the rate of the
+			// last completed window is stale.
+			stats.connectsPerSecond = connectsInWindow * 1000000.0
+				/ (now - connectRateWindowStart);
+		} else {
+			stats.connectsPerSecond = connectRate;
 		}
+		return stats;
 	}
 
 	void closeAllConnections() {
 		boost::unique_lock<boost::mutex> l(connectionPoolLock);
 		assert(sessions == 0);
-		assert(totalConnections == totalIdleConnections);
+		assert(totalConnections == totalIdleConnections + warmingConnections);
+		connectionPoolClosed = true;
 		vector<Connection>::iterator it, end = idleConnections.end();
 
 		for (it = idleConnections.begin(); it != end; it++) {
@@ -0,0 +1,449 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+#include <Core/ApplicationPool/StatusSnapshot.h>
+#include <Core/ApplicationPool/Group.h>
+#include <Core/SpawningKit/UserSwitchingRules.h>
+#include <Utils.h>
+
+namespace Passenger {
+namespace ApplicationPool2 {
+
+using namespace std;
+using namespace boost;
+
+
+static const char *
+processLifeStatusString(Process::LifeStatus lifeStatus) {
+	switch (lifeStatus) {
+	case Process::ALIVE:
+		return "ALIVE";
+	case Process::SHUTDOWN_TRIGGERED:
+		return "SHUTDOWN_TRIGGERED";
+	case Process::DEAD:
+		return "DEAD";
+	default:
+		P_BUG("Unknown 'lifeStatus' state " << (int) lifeStatus);
+		return NULL;
+	}
+}
+
+static const char *
+processEnabledStatusString(Process::EnabledStatus enabled) {
+	switch (enabled) {
+	case Process::ENABLED:
+		return "ENABLED";
+	case Process::DISABLING:
+		return "DISABLING";
+	case Process::DISABLED:
+		return "DISABLED";
+	case Process::DETACHED:
+		return "DETACHED";
+	default:
+		P_BUG("Unknown 'enabled' state " << (int) enabled);
+		return NULL;
+	}
+}
+
+static const char *
+groupLifeStatusString(Group::LifeStatus lifeStatus) {
+	switch (lifeStatus) {
+	case Group::ALIVE:
+		return "ALIVE";
+	case Group::SHUTTING_DOWN:
+		return "SHUTTING_DOWN";
+	case Group::SHUT_DOWN:
+		return "SHUT_DOWN";
+	default:
+		P_BUG("Unknown 'lifeStatus' state " << (int) lifeStatus);
+		return NULL;
+	}
+}
+
+template<typename Stream>
+static void
+inspectProcessListXml(Stream &stream, const vector<ProcessStatusSnapshot> &processes,
+	GroupSessionStatus::const_iterator &sessionStatus, bool includeSockets)
+{
+	vector<ProcessStatusSnapshot>::const_iterator it, end = processes.end();
+	for (it = processes.begin(); it != end; it++, sessionStatus++) {
+		stream << "<process>";
+		it->inspectXml(stream, *sessionStatus, includeSockets);
+		stream << "</process>";
+	}
+}
+
+static void
+inspectProcessListJson(Json::Value &doc, const vector<ProcessStatusSnapshot> &processes,
+	GroupSessionStatus::const_iterator &sessionStatus)
+{
+	vector<ProcessStatusSnapshot>::const_iterator it, end = processes.end();
+	for (it = processes.begin(); it != end; it++, sessionStatus++) {
+		Json::Value processDoc(Json::objectValue);
+		it->inspectJson(processDoc, *sessionStatus);
+		doc.append(processDoc);
+	}
+}
+
+
+/****************************
+ *
+ * ProcessSessionStatus
+ *
+ ****************************/
+
+
+/**
+ * Must be called while holding the pool lock.
+ */
+ProcessSessionStatus::ProcessSessionStatus(const Process &process)
+	: sessions(process.sessions),
+	  busyness(process.busyness()),
+	  processed(process.processed),
+	  lastUsed(process.lastUsed)
+{
+	const SocketList &sockets = process.getSockets();
+	SocketList::const_iterator it, end = sockets.end();
+
+	socketSessions.reserve(sockets.size());
+	for (it = sockets.begin(); it != end; it++) {
+		socketSessions.push_back(it->sessions);
+	}
+}
+
+bool
+ProcessSessionStatus::operator==(const ProcessSessionStatus &other) const {
+	return sessions == other.sessions
+		&& busyness == other.busyness
+		&& processed == other.processed
+		&& lastUsed == other.lastUsed
+		&& socketSessions == other.socketSessions;
+}
+
+
+/****************************
+ *
+ * ProcessStatusSnapshot
+ *
+ ****************************/
+
+
+/**
+ * Must be called while holding the pool lock.
+ */
+ProcessStatusSnapshot::ProcessStatusSnapshot(const ProcessPtr &_process)
+	: process(_process),
+	  concurrency(_process->getConcurrency()),
+	  lifeStatus(_process->getLifeStatus()),
+	  enabled(_process->enabled),
+	  metrics(_process->metrics)
+	{ }
+
+void
+ProcessStatusSnapshot::inspectXml(std::ostream &stream,
+	const ProcessSessionStatus &sessionStatus, bool includeSockets) const
+{
+	stream << "<pid>" << process->getPid() << "</pid>";
+	stream << "<sticky_session_id>" << process->getStickySessionId() << "</sticky_session_id>";
+	stream << "<gupid>" << process->getGupid() << "</gupid>";
+	stream << "<concurrency>" << concurrency << "</concurrency>";
+	stream << "<sessions>" << sessionStatus.sessions << "</sessions>";
+	stream << "<busyness>" << sessionStatus.busyness << "</busyness>";
+	stream << "<processed>" << sessionStatus.processed << "</processed>";
+	stream << "<spawner_creation_time>" << process->getSpawnerCreationTime() << "</spawner_creation_time>";
+	stream << "<spawn_start_time>" << process->getSpawnStartTime() << "</spawn_start_time>";
+	stream << "<spawn_end_time>" << process->getSpawnEndTime() << "</spawn_end_time>";
+	stream << "<last_used>" << sessionStatus.lastUsed << "</last_used>";
+	stream << "<last_used_desc>" << distanceOfTimeInWords(sessionStatus.lastUsed / 1000000).c_str() << " ago</last_used_desc>";
+	stream << "<uptime>" << process->uptime() << "</uptime>";
+	if (!process->getCodeRevision().empty()) {
+		stream << "<code_revision>" << escapeForXml(process->getCodeRevision()) << "</code_revision>";
+	}
+	stream << "<life_status>" << processLifeStatusString(lifeStatus) << "</life_status>";
+	stream << "<enabled>" << processEnabledStatusString(enabled) << "</enabled>";
+	if (metrics.isValid()) {
+		stream << "<has_metrics>true</has_metrics>";
+		stream << "<cpu>" << (int) metrics.cpu << "</cpu>";
+		stream << "<rss>" << metrics.rss << "</rss>";
+		stream << "<pss>" << metrics.pss << "</pss>";
+		stream << "<private_dirty>" << metrics.privateDirty << "</private_dirty>";
+		stream << "<swap>" << metrics.swap << "</swap>";
+		stream << "<real_memory>" << metrics.realMemory() << "</real_memory>";
+		stream << "<vmsize>" << metrics.vmsize << "</vmsize>";
+		stream << "<process_group_id>" << metrics.processGroupId << "</process_group_id>";
+		stream << "<command>" << escapeForXml(metrics.command) << "</command>";
+	}
+	if (includeSockets) {
+		const SocketList &sockets = process->getSockets();
+		unsigned int i;
+
+		stream << "<sockets>";
+		for (i = 0; i < sockets.size(); i++) {
+			const Socket &socket = sockets[i];
+			stream << "<socket>";
+			stream << "<address>" << escapeForXml(socket.address) << "</address>";
+			stream << "<protocol>" << escapeForXml(socket.protocol) << "</protocol>";
+			if (!socket.description.empty()) {
+				stream << "<description>" << escapeForXml(socket.description) << "</description>";
+			}
+			stream << "<concurrency>" << socket.concurrency << "</concurrency>";
+			stream << "<accept_http_requests>" << socket.acceptHttpRequests << "</accept_http_requests>";
+			stream << "<sessions>" << sessionStatus.socketSessions[i] << "</sessions>";
+			ConnectionPoolStats stats = socket.getConnectionPoolStats();
+			stream << "<connection_pool>";
+			stream << "<idle_connections>" << stats.idleConnections << "</idle_connections>";
+			stream << "<total_connections>" << stats.totalConnections << "</total_connections>";
+			stream << "<min_idle_connections>" << stats.minIdleConnections << "</min_idle_connections>";
+			stream << "<hits>" << stats.hits << "</hits>";
+			stream << "<misses>" << stats.misses << "</misses>";
+			stream << "<connects>" << stats.connects << "</connects>";
+			stream << "<connects_per_second>" << stats.connectsPerSecond << "</connects_per_second>";
+			stream << "</connection_pool>";
+			stream << "</socket>";
+		}
+		stream << "</sockets>";
+	}
+}
+
+void
+ProcessStatusSnapshot::inspectJson(Json::Value &doc,
+	const ProcessSessionStatus &sessionStatus) const
+{
+	doc["pid"] = (Json::Int) process->getPid();
+	doc["gupid"] = process->getGupid().toString();
+	doc["sticky_session_id"] = process->getStickySessionId();
+	doc["concurrency"] = concurrency;
+	doc["sessions"] = sessionStatus.sessions;
+	doc["busyness"] = sessionStatus.busyness;
+	doc["processed"] = sessionStatus.processed;
+	doc["spawn_end_time"] = (Json::UInt64) process->getSpawnEndTime();
+	doc["last_used"] = (Json::UInt64) sessionStatus.lastUsed;
+	doc["life_status"] = processLifeStatusString(lifeStatus);
+	doc["enabled"] = processEnabledStatusString(enabled);
+	if (metrics.isValid()) {
+		doc["cpu"] = (int) metrics.cpu;
+		doc["rss"] = (Json::UInt64) metrics.rss;
+		doc["real_memory"] = (Json::UInt64) metrics.realMemory();
+	}
+}
+
+
+/****************************
+ *
+ * GroupStatusSnapshot
+ *
+ ****************************/
+
+
+GroupStatusSnapshot::GroupStatusSnapshot()
+	: version(0),
+	  lifeStatus(Group::ALIVE),
+	  enabledCount(0),
+	  disablingCount(0),
+	  disabledCount(0),
+	  processCount(0),
+	  capacityUsed(0),
+	  getWaitlistSize(0),
+	  disableWaitlistSize(0),
+	  processesBeingSpawned(0),
+	  spawning(false),
+	  restarting(false),
+	  predictiveAutoscaling(false),
+	  autoscalingTarget(0)
+	{ }
+
+StaticString
+GroupStatusSnapshot::getName() const {
+	return group->getName();
+}
+
+const ApiKey &
+GroupStatusSnapshot::getApiKey() const {
+	return group->getApiKey();
+}
+
+bool
+GroupStatusSnapshot::authorizeByUid(uid_t uid) const {
+	return uid == 0 || SpawningKit::prepareUserSwitching(options).uid == uid;
+}
+
+bool
+GroupStatusSnapshot::authorizeByApiKey(const ApiKey &key) const {
+	return key.isSuper() || key == getApiKey();
+}
+
+void
+GroupStatusSnapshot::inspectXml(std::ostream &stream,
+	const GroupSessionStatus &sessionStatus, bool includeSecrets) const
+{
+	stream << "<name>" << escapeForXml(getName()) << "</name>";
+	stream << "<component_name>" << escapeForXml(getName()) << "</component_name>";
+	stream << "<app_root>" << escapeForXml(options.appRoot) << "</app_root>";
+	stream << "<app_type>" << escapeForXml(options.appType) << "</app_type>";
+	stream << "<environment>" << escapeForXml(options.environment) << "</environment>";
+	stream << "<uuid>" << uuid << "</uuid>";
+	stream << "<enabled_process_count>" << enabledCount << "</enabled_process_count>";
+	stream << "<disabling_process_count>" << disablingCount << "</disabling_process_count>";
+	stream << "<disabled_process_count>" << disabledCount << "</disabled_process_count>";
+	stream << "<capacity_used>" << capacityUsed << "</capacity_used>";
+	stream << "<get_wait_list_size>" << getWaitlistSize << "</get_wait_list_size>";
+	stream << "<disable_wait_list_size>" << disableWaitlistSize << "</disable_wait_list_size>";
+	stream << "<processes_being_spawned>" << processesBeingSpawned << "</processes_being_spawned>";
+	if (spawning) {
+		stream << "<spawning/>";
+	}
+	if (restarting) {
+		stream << "<restarting/>";
+	}
+	if (predictiveAutoscaling) {
+		stream << "<autoscaling>";
+		stream << "<arrival_rate>" << demandEstimator.getArrivalRate() << "</arrival_rate>";
+		stream << "<long_term_arrival_rate>" << demandEstimator.getLongTermArrivalRate()
+			<< "</long_term_arrival_rate>";
+		stream << "<average_concurrency>" << demandEstimator.getAverageConcurrency()
+			<< "</average_concurrency>";
+		stream << "<concurrency_stddev>" << demandEstimator.getConcurrencyStddev()
+			<< "</concurrency_stddev>";
+		stream << "<predicted_concurrency>" << demandEstimator.getPredictedConcurrency()
+			<< "</predicted_concurrency>";
+		stream << "<target_process_count>" << autoscalingTarget << "</target_process_count>";
+		stream << "</autoscaling>";
+	}
+	if (includeSecrets) {
+		stream << "<secret>" << escapeForXml(getApiKey().toStaticString()) << "</secret>";
+		stream << "<api_key>" << escapeForXml(getApiKey().toStaticString()) << "</api_key>";
+	}
+	stream << "<life_status>" << groupLifeStatusString(lifeStatus) << "</life_status>";
+
+	SpawningKit::UserSwitchingInfo usInfo(SpawningKit::prepareUserSwitching(options));
+	stream << "<user>" << escapeForXml(usInfo.username) << "</user>";
+	stream << "<uid>" << usInfo.uid << "</uid>";
+	stream << "<group>" << escapeForXml(usInfo.groupname) << "</group>";
+	stream << "<gid>" << usInfo.gid << "</gid>";
+
+	stream << "<options>";
+	options.toXml(stream, group->getResourceLocator());
+	stream << "</options>";
+
+	GroupSessionStatus::const_iterator s_it = sessionStatus.begin();
+	stream << "<processes>";
+	inspectProcessListXml(stream, enabledProcesses, s_it, includeSecrets);
+	inspectProcessListXml(stream, disablingProcesses, s_it, includeSecrets);
+	inspectProcessListXml(stream, disabledProcesses, s_it, includeSecrets);
+	inspectProcessListXml(stream, detachedProcesses, s_it, includeSecrets);
+	stream << "</processes>";
+}
+
+void
+GroupStatusSnapshot::inspectJson(Json::Value &doc,
+	const GroupSessionStatus &sessionStatus, bool includeSecrets) const
+{
+	doc["name"] = getName().toString();
+	doc["app_root"] = options.appRoot.toString();
+	doc["app_type"] = options.appType.toString();
+	doc["environment"] = options.environment.toString();
+	doc["uuid"] = uuid;
+	doc["life_status"] = groupLifeStatusString(lifeStatus);
+	doc["enabled_process_count"] = enabledCount;
+	doc["disabling_process_count"] = disablingCount;
+	doc["disabled_process_count"] = disabledCount;
+	doc["capacity_used"] = capacityUsed;
+	doc["get_wait_list_size"] = getWaitlistSize;
+	doc["disable_wait_list_size"] = disableWaitlistSize;
+	doc["processes_being_spawned"] = processesBeingSpawned;
+	doc["spawning"] = spawning;
+	doc["restarting"] = restarting;
+	if (predictiveAutoscaling) {
+		Json::Value autoscaling(Json::objectValue);
+		autoscaling["arrival_rate"] = demandEstimator.getArrivalRate();
+		autoscaling["average_concurrency"] = demandEstimator.getAverageConcurrency();
+		autoscaling["predicted_concurrency"] = demandEstimator.getPredictedConcurrency();
+		autoscaling["target_process_count"] = autoscalingTarget;
+		doc["autoscaling"] = autoscaling;
+	}
+	if (includeSecrets) {
+		doc["api_key"] = getApiKey().toStaticString().toString();
+	}
+
+	Json::Value processes(Json::arrayValue);
+	GroupSessionStatus::const_iterator s_it = sessionStatus.begin();
+	inspectProcessListJson(processes, enabledProcesses, s_it);
+	inspectProcessListJson(processes, disablingProcesses, s_it);
+	inspectProcessListJson(processes, disabledProcesses, s_it);
+	inspectProcessListJson(processes, detachedProcesses, s_it);
+	doc["processes"] = processes;
+}
+
+
+/****************************
+ *
+ * PoolStatusSnapshot
+ *
+ ****************************/
+
+
+PoolStatusSnapshot::PoolStatusSnapshot()
+	: version(0),
+	  max(0),
+	  processCount(0),
+	  capacityUsed(0),
+	  minIdleConnections(0),
+	  predictiveAutoscaling(false)
+	{ }
+
+bool
+PoolStatusSnapshot::authorizeByUid(uid_t uid) const {
+	if (uid == 0 || uid == geteuid()) {
+		return true;
+	}
+
+	vector<GroupStatusSnapshotPtr>::const_iterator it, end = groups.end();
+	for (it = groups.begin(); it != end; it++) {
+		if ((*it)->authorizeByUid(uid)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool
+PoolStatusSnapshot::authorizeByApiKey(const ApiKey &key) const {
+	if (key.isSuper()) {
+		return true;
+	}
+
+	vector<GroupStatusSnapshotPtr>::const_iterator it, end = groups.end();
+	for (it = groups.begin(); it != end; it++) {
+		if ((*it)->getApiKey() == key) {
+			return true;
+		}
+	}
+	return false;
+}
+
+
+} // namespace ApplicationPool2
+} // namespace Passenger
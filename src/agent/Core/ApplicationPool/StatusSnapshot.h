@@ -0,0 +1,197 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_APPLICATION_POOL2_STATUS_SNAPSHOT_H_
+#define _PASSENGER_APPLICATION_POOL2_STATUS_SNAPSHOT_H_
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <boost/shared_ptr.hpp>
+#include <jsoncpp/json.h>
+#include <Utils/ProcessMetricsCollector.h>
+#include <Core/ApplicationPool/Common.h>
+#include <Core/ApplicationPool/DemandEstimator.h>
+#include <Core/ApplicationPool/Options.h>
+#include <Core/ApplicationPool/Process.h>
+#include <Core/ApplicationPool/Group.h>
+#include <Shared/ApplicationPoolApiKey.h>
+
+namespace Passenger {
+namespace ApplicationPool2 {
+
+using namespace std;
+
+
+/**
+ * The session counters of a Process, as reported by the pool status
+ * inspection methods. These change every time a session is opened or
+ * closed, so they don't bump `Group::statusVersion` and are not part of
+ * GroupStatusSnapshot. Instead, `Pool::captureStatusSnapshot()` reads them
+ * again on every call, which is much cheaper than copying a whole Group.
+ */
+struct ProcessSessionStatus {
+	int sessions;
+	int busyness;
+	unsigned int processed;
+	unsigned long long lastUsed;
+	/** The number of sessions of each socket, in `process->getSockets()` order. */
+	vector<int> socketSessions;
+
+	explicit ProcessSessionStatus(const Process &process);
+
+	bool operator==(const ProcessSessionStatus &other) const;
+	bool operator!=(const ProcessSessionStatus &other) const {
+		return !(*this == other);
+	}
+};
+
+/**
+ * The state of a Process, as reported by the pool status inspection methods
+ * (`Pool::inspect()`, `Pool::toXml()` and `Pool::toCompactJson()`), copied at
+ * a point in time at which the pool lock was held.
+ *
+ * Only the fields that can change while the Process is in the pool are copied.
+ * Everything else (PID, GUPID, spawn times, sockets, connection pool
+ * statistics) is read through `process`, which is safe without holding the
+ * pool lock. The reference also keeps the Process object alive. The session
+ * counters are in ProcessSessionStatus.
+ */
+struct ProcessStatusSnapshot {
+	ProcessPtr process;
+	int concurrency;
+	Process::LifeStatus lifeStatus;
+	Process::EnabledStatus enabled;
+	ProcessMetrics metrics;
+
+	explicit ProcessStatusSnapshot(const ProcessPtr &process);
+
+	void inspectXml(std::ostream &stream, const ProcessSessionStatus &sessionStatus,
+		bool includeSockets) const;
+	void inspectJson(Json::Value &doc, const ProcessSessionStatus &sessionStatus) const;
+};
+
+/**
+ * The ProcessSessionStatuses of all processes in a Group, in the same order
+ * as the process lists of its GroupStatusSnapshot: enabled, disabling,
+ * disabled, detached.
+ */
+typedef vector<ProcessSessionStatus> GroupSessionStatus;
+
+/**
+ * The state of a Group, as reported by the pool status inspection methods,
+ * copied at a point in time at which the pool lock was held. Created by
+ * `Group::captureStatusSnapshot()`.
+ *
+ * Once created, a snapshot is never modified, so it can be shared between
+ * threads and serialized without holding the pool lock.
+ */
+struct GroupStatusSnapshot {
+	/**
+	 * Keeps the Group object alive, so that its immutable fields (name,
+	 * API key) can be read, and so that `Pool::captureStatusSnapshot()` can
+	 * identify the Group that this snapshot belongs to.
+	 */
+	boost::shared_ptr<const Group> group;
+	/** The value of `group->statusVersion` at the time this snapshot was taken. */
+	unsigned int version;
+
+	/** A persisted copy of `group->options`. */
+	Options options;
+	string uuid;
+	Group::LifeStatus lifeStatus;
+	unsigned int enabledCount;
+	unsigned int disablingCount;
+	unsigned int disabledCount;
+	unsigned int processCount;
+	unsigned int capacityUsed;
+	unsigned int getWaitlistSize;
+	unsigned int disableWaitlistSize;
+	unsigned int processesBeingSpawned;
+	bool spawning;
+	bool restarting;
+
+	/** Whether predictive autoscaling was enabled on the pool. */
+	bool predictiveAutoscaling;
+	DemandEstimator demandEstimator;
+	unsigned int autoscalingTarget;
+
+	vector<ProcessStatusSnapshot> enabledProcesses;
+	vector<ProcessStatusSnapshot> disablingProcesses;
+	vector<ProcessStatusSnapshot> disabledProcesses;
+	vector<ProcessStatusSnapshot> detachedProcesses;
+
+	GroupStatusSnapshot();
+
+	StaticString getName() const;
+	const ApiKey &getApiKey() const;
+	bool authorizeByUid(uid_t uid) const;
+	bool authorizeByApiKey(const ApiKey &key) const;
+
+	void inspectXml(std::ostream &stream, const GroupSessionStatus &sessionStatus,
+		bool includeSecrets) const;
+	void inspectJson(Json::Value &doc, const GroupSessionStatus &sessionStatus,
+		bool includeSecrets) const;
+};
+
+typedef boost::shared_ptr<const GroupStatusSnapshot> GroupStatusSnapshotPtr;
+
+/**
+ * The state of the whole Pool, as reported by the pool status inspection
+ * methods. Created by `Pool::captureStatusSnapshot()`, which reuses the
+ * GroupStatusSnapshots of Groups that haven't changed since the previous
+ * snapshot.
+ *
+ * `version` is incremented every time that the pool state (including the
+ * session counters) has changed since the previous snapshot. Two snapshots with the same version have the same
+ * contents (except for time-dependent values that are calculated at
+ * serialization time, such as uptimes and connection pool statistics).
+ */
+struct PoolStatusSnapshot {
+	unsigned long long version;
+	unsigned int max;
+	unsigned int processCount;
+	unsigned int capacityUsed;
+	unsigned int minIdleConnections;
+	bool predictiveAutoscaling;
+	/** The app group names of the requests in the Pool's get wait list. */
+	vector<string> getWaitlist;
+	vector<GroupStatusSnapshotPtr> groups;
+	/** The session counters of each Group, in `groups` order. */
+	vector<GroupSessionStatus> groupSessions;
+
+	PoolStatusSnapshot();
+
+	bool authorizeByUid(uid_t uid) const;
+	bool authorizeByApiKey(const ApiKey &key) const;
+};
+
+typedef boost::shared_ptr<const PoolStatusSnapshot> PoolStatusSnapshotPtr;
+
+
+} // namespace ApplicationPool2
+} // namespace Passenger
+
+#endif /* _PASSENGER_APPLICATION_POOL2_STATUS_SNAPSHOT_H_ */
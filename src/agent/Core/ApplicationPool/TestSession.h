@@ -57,6 +57,8 @@ private:
 	mutable bool closed;
 	mutable bool success;
 	mutable bool wantKeepAlive;
+	bool connectInProgress;
+	bool connecting;
 
 public:
 	TestSession()
@@ -67,7 +69,9 @@ public:
 		  stickySessionId(0),
 		  closed(false),
 		  success(false),
-		  wantKeepAlive(false)
+		  wantKeepAlive(false),
+		  connectInProgress(false),
+		  connecting(false)
 		{ }
 
 	virtual void ref() const {
@@ -169,9 +173,35 @@ public:
 		peerBufferedIO = BufferedIO(connection.second);
 		if (!blocking) {
 			setNonBlocking(connection.first);
+			connecting = connectInProgress;
 		}
 	}
 
+	/**
+	 * Simulates a non-blocking connect that does not finish until
+	 * setConnectInProgress(false) is called.
+	 */
+	void setConnectInProgress(bool value) {
+		boost::lock_guard<boost::mutex> l(syncher);
+		connectInProgress = value;
+	}
+
+	virtual bool isConnecting() const {
+		boost::lock_guard<boost::mutex> l(syncher);
+		return connecting;
+	}
+
+	virtual bool canPollForConnect() const {
+		// The socket pair is always writable.
+		return false;
+	}
+
+	virtual bool continueConnecting() {
+		boost::lock_guard<boost::mutex> l(syncher);
+		connecting = connectInProgress;
+		return !connecting;
+	}
+
 	virtual void close(bool _success, bool _wantKeepAlive = false) {
 		boost::lock_guard<boost::mutex> l(syncher);
 		closed = true;
@@ -88,14 +88,21 @@ using namespace std;
  *   api_server_file_buffered_channel_delay_in_file_mode_switching   unsigned integer   -          default(0)
  *   api_server_file_buffered_channel_max_disk_chunk_read_size       unsigned integer   -          default(0)
  *   api_server_file_buffered_channel_threshold                      unsigned integer   -          default(131072)
+ *   api_server_http2                                                boolean            -          default(false)
+ *   api_server_http2_max_concurrent_streams                         unsigned integer   -          default(100)
  *   api_server_mbuf_block_chunk_size                                unsigned integer   -          default(4096),read_only
+ *   api_server_mbuf_huge_pages                                      boolean            -          default(false),read_only
+ *   api_server_mbuf_max_spare_memory                                unsigned integer   -          default(67108864)
+ *   api_server_mbuf_slab_size                                       unsigned integer   -          default(0),read_only
  *   api_server_min_spare_clients                                    unsigned integer   -          default(0)
  *   api_server_request_freelist_limit                               unsigned integer   -          default(1024)
  *   api_server_start_reading_after_accept                           boolean            -          default(true)
+ *   app_connect_timeout                                             unsigned integer   -          default(10000)
  *   app_output_log_level                                            string             -          default("notice")
  *   benchmark_mode                                                  string             -          -
  *   config_manifest                                                 object             -          read_only
  *   controller_accept_burst_count                                   unsigned integer   -          default(32)
+ *   controller_accept_distribution                                  string             -          default("round-robin"),read_only
  *   controller_addresses                                            array of strings   -          default(["tcp://127.0.0.1:3000"]),read_only
  *   controller_client_freelist_limit                                unsigned integer   -          default(0)
  *   controller_cpu_affine                                           boolean            -          default(false),read_only
@@ -105,7 +112,12 @@ using namespace std;
  *   controller_file_buffered_channel_delay_in_file_mode_switching   unsigned integer   -          default(0)
  *   controller_file_buffered_channel_max_disk_chunk_read_size       unsigned integer   -          default(0)
  *   controller_file_buffered_channel_threshold                      unsigned integer   -          default(131072)
+ *   controller_http2                                                boolean            -          default(false)
+ *   controller_http2_max_concurrent_streams                         unsigned integer   -          default(100)
  *   controller_mbuf_block_chunk_size                                unsigned integer   -          default(4096),read_only
+ *   controller_mbuf_huge_pages                                      boolean            -          default(false),read_only
+ *   controller_mbuf_max_spare_memory                                unsigned integer   -          default(67108864)
+ *   controller_mbuf_slab_size                                       unsigned integer   -          default(0),read_only
  *   controller_min_spare_clients                                    unsigned integer   -          default(0)
  *   controller_request_freelist_limit                               unsigned integer   -          default(1024)
  *   controller_secure_headers_password                              any                -          secret
@@ -126,9 +138,11 @@ using namespace std;
  *   default_min_instances                                           unsigned integer   -          default(1)
  *   default_nodejs                                                  string             -          default("node")
  *   default_python                                                  string             -          default("python")
+ *   default_response_compression                                    boolean            -          default(false)
  *   default_ruby                                                    string             -          default("ruby")
  *   default_server_name                                             string             -          default
  *   default_server_port                                             unsigned integer   -          default
+ *   default_spawn_concurrency                                       unsigned integer   -          default(1)
  *   default_spawn_method                                            string             -          default("smart")
  *   default_sticky_sessions                                         boolean            -          default(false)
  *   default_sticky_sessions_cookie_name                             string             -          default("_passenger_route")
@@ -138,22 +152,32 @@ using namespace std;
  *   graceful_exit                                                   boolean            -          default(true)
  *   instance_dir                                                    string             -          read_only
  *   integration_mode                                                string             -          default("standalone")
+ *   log_async_buffer_size                                           unsigned integer   -          default(4096),read_only
+ *   log_async_overflow_policy                                       string             -          default("block")
+ *   log_async_writes                                                boolean            -          default(false)
  *   log_level                                                       string             -          default("notice")
  *   log_target                                                      any                -          default({"stderr": true})
  *   max_instances_per_app                                           unsigned integer   -          read_only
  *   max_pool_size                                                   unsigned integer   -          default(6)
+ *   max_spawn_concurrency                                           unsigned integer   -          default(4)
  *   multi_app                                                       boolean            -          default(false),read_only
  *   passenger_root                                                  string             required   read_only
  *   pid_file                                                        string             -          read_only
  *   pool_idle_time                                                  unsigned integer   -          default(300)
+ *   pool_min_idle_connections                                       unsigned integer   -          default(0)
+ *   pool_predictive_autoscaling                                     boolean            -          default(false)
  *   pool_selfchecks                                                 boolean            -          default(false)
  *   prestart_urls                                                   array of strings   -          default([]),read_only
  *   response_buffer_high_watermark                                  unsigned integer   -          default(134217728)
+ *   response_compression_level                                      unsigned integer   -          default(6)
+ *   response_compression_min_size                                   unsigned integer   -          default(256)
+ *   response_splice_threshold                                       unsigned integer   -          default(131072)
  *   security_update_checker_certificate_path                        string             -          -
  *   security_update_checker_disabled                                boolean            -          default(false)
  *   security_update_checker_interval                                unsigned integer   -          default(86400)
  *   security_update_checker_proxy_url                               string             -          -
  *   security_update_checker_url                                     string             -          default("https://securitycheck.phusionpassenger.com/v1/check.json")
+ *   sendfile_root                                                   string             -          -
  *   server_software                                                 string             -          default("Phusion_Passenger/5.3.2")
  *   show_version_in_header                                          boolean            -          default(true)
  *   single_app_mode_app_root                                        string             -          default,read_only
@@ -161,6 +185,10 @@ using namespace std;
  *   single_app_mode_startup_file                                    string             -          read_only
  *   standalone_engine                                               string             -          default
  *   stat_throttle_rate                                              unsigned integer   -          default(10)
+ *   turbocache_max_body_size                                        unsigned integer   -          default(131072),read_only
+ *   turbocache_max_entries                                          unsigned integer   -          default(1024),read_only
+ *   turbocache_max_memory                                           unsigned integer   -          default(8388608),read_only
+ *   turbocache_shared                                               boolean            -          default(false),read_only
  *   turbocaching                                                    boolean            -          default(true),read_only
  *   user_switching                                                  boolean            -          default(true)
  *   vary_turbocache_by_cookie                                       string             -          -
@@ -282,6 +310,9 @@ private:
 		if (config["max_pool_size"].asUInt() < 1) {
 			errors.push_back(Error("'{{max_pool_size}}' must be at least 1"));
 		}
+		if (config["max_spawn_concurrency"].asUInt() < 1) {
+			errors.push_back(Error("'{{max_spawn_concurrency}}' must be at least 1"));
+		}
 	}
 
 	static void validateController(const ConfigKit::Store &config, vector<ConfigKit::Error> &errors) {
@@ -290,6 +321,15 @@ private:
 		if (config["controller_threads"].asUInt() < 1) {
 			errors.push_back(Error("'{{controller_threads}}' must be at least 1"));
 		}
+
+		string distribution = config["controller_accept_distribution"].asString();
+		if (distribution != "round-robin"
+		 && distribution != "least-loaded"
+		 && distribution != "reuseport")
+		{
+			errors.push_back(Error("'{{controller_accept_distribution}}' must be"
+				" one of 'round-robin', 'least-loaded' or 'reuseport'"));
+		}
 	}
 
 	static void validateAddresses(const ConfigKit::Store &config, vector<ConfigKit::Error> &errors) {
@@ -379,6 +419,9 @@ public:
 		// Add subschema: loggingKit
 		loggingKit.translator.add("log_level", "level");
 		loggingKit.translator.add("log_target", "target");
+		loggingKit.translator.add("log_async_writes", "async_writes");
+		loggingKit.translator.add("log_async_buffer_size", "async_buffer_size");
+		loggingKit.translator.add("log_async_overflow_policy", "async_overflow_policy");
 		loggingKit.translator.finalize();
 		addSubSchema(loggingKit.schema, loggingKit.translator);
 		erase("redirect_stderr");
@@ -442,7 +485,10 @@ public:
 		add("web_server_version", STRING_TYPE, OPTIONAL | READ_ONLY);
 		addWithDynamicDefault("controller_threads", UINT_TYPE, OPTIONAL | READ_ONLY, getDefaultThreads);
 		add("max_pool_size", UINT_TYPE, OPTIONAL, DEFAULT_MAX_POOL_SIZE);
+		add("max_spawn_concurrency", UINT_TYPE, OPTIONAL, DEFAULT_MAX_SPAWN_CONCURRENCY);
 		add("pool_idle_time", UINT_TYPE, OPTIONAL, Json::UInt(DEFAULT_POOL_IDLE_TIME));
+		add("pool_min_idle_connections", UINT_TYPE, OPTIONAL, 0);
+		add("pool_predictive_autoscaling", BOOL_TYPE, OPTIONAL, false);
 		add("pool_selfchecks", BOOL_TYPE, OPTIONAL, false);
 		add("prestart_urls", STRING_ARRAY_TYPE, OPTIONAL | READ_ONLY, Json::arrayValue);
 		add("controller_secure_headers_password", ANY_TYPE, OPTIONAL | SECRET);
@@ -450,6 +496,7 @@ public:
 		add("controller_addresses", STRING_ARRAY_TYPE, OPTIONAL | READ_ONLY, getDefaultControllerAddresses());
 		add("api_server_addresses", STRING_ARRAY_TYPE, OPTIONAL | READ_ONLY, Json::arrayValue);
 		add("controller_cpu_affine", BOOL_TYPE, OPTIONAL | READ_ONLY, false);
+		add("controller_accept_distribution", STRING_TYPE, OPTIONAL | READ_ONLY, "round-robin");
 		add("file_descriptor_ulimit", UINT_TYPE, OPTIONAL | READ_ONLY, 0);
 
 		addValidator(validateMultiAppMode);
@@ -289,7 +289,11 @@ asyncCommitConfigChange(ConfigChangeRequest *req, const CommitConfigChangeCallba
 		req->forSecurityUpdateChecker);
 
 	wo->appPool->setMax(coreConfig->get("max_pool_size").asInt());
+	wo->appPool->setMaxSpawnConcurrency(coreConfig->get("max_spawn_concurrency").asUInt());
 	wo->appPool->setMaxIdleTime(coreConfig->get("pool_idle_time").asInt() * 1000000ULL);
+	wo->appPool->setMinIdleConnections(coreConfig->get("pool_min_idle_connections").asUInt());
+	wo->appPool->enablePredictiveAutoscaling(
+		coreConfig->get("pool_predictive_autoscaling").asBool());
 	wo->appPool->enableSelfChecking(coreConfig->get("pool_selfchecks").asBool());
 	{
 		LockGuard l(wo->appPoolContext->agentConfigSyncher);
@@ -0,0 +1,184 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_CONFIG_HANDLE_REGISTRY_H_
+#define _PASSENGER_CONFIG_HANDLE_REGISTRY_H_
+
+#include <boost/thread.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <string>
+#include <vector>
+#include <utility>
+#include <DataStructures/StringKeyTable.h>
+#include <DataStructures/HashedStaticString.h>
+#include <StaticString.h>
+
+namespace Passenger {
+
+using namespace std;
+
+
+/**
+ * Stores the per-location `!~PASSENGER_*` secure headers that a web server
+ * module registered under a config handle, so that subsequent requests only
+ * have to carry the handle instead of all the option headers.
+ *
+ * Handles are derived by the web server module from the option data, so a
+ * given handle always refers to the same set of headers. Entries are therefore
+ * immutable, and they are never removed until the registry is destroyed: the
+ * returned Entry pointers stay valid for the registry's entire lifetime, and
+ * callers may cache them without further synchronization. To bound memory
+ * usage (the set of handles grows every time the web server is reloaded with
+ * a changed configuration), at most `maxEntries` handles are accepted;
+ * registrations beyond that are refused, in which case the web server module
+ * just keeps sending the full option headers.
+ *
+ * This class is thread-safe.
+ */
+class ConfigHandleRegistry: private boost::noncopyable {
+public:
+	static const unsigned int DEFAULT_MAX_ENTRIES = 1024;
+
+	struct Header {
+		/** Points into Entry::data. */
+		StaticString name;
+		/** Points into Entry::data. */
+		StaticString value;
+		boost::uint32_t hash;
+	};
+
+	struct Entry {
+		vector<Header> headers;
+		string data;
+	};
+
+	typedef vector< pair<StaticString, StaticString> > HeaderList;
+
+private:
+	mutable boost::mutex syncher;
+	StringKeyTable<Entry *> entries;
+	unsigned int maxEntries;
+
+	static Entry *createEntry(const HeaderList &headers) {
+		Entry *entry = new Entry();
+		HeaderList::const_iterator it, end = headers.end();
+		size_t size = 0;
+
+		for (it = headers.begin(); it != end; it++) {
+			size += it->first.size() + it->second.size();
+		}
+		// Reserve up front so that the StaticStrings below stay valid.
+		entry->data.reserve(size);
+		entry->headers.reserve(headers.size());
+
+		for (it = headers.begin(); it != end; it++) {
+			Header header;
+			const char *name = entry->data.data() + entry->data.size();
+			entry->data.append(it->first.data(), it->first.size());
+			const char *value = entry->data.data() + entry->data.size();
+			entry->data.append(it->second.data(), it->second.size());
+
+			header.name = StaticString(name, it->first.size());
+			header.value = StaticString(value, it->second.size());
+			header.hash = HashedStaticString(header.name).hash();
+			entry->headers.push_back(header);
+		}
+
+		return entry;
+	}
+
+public:
+	ConfigHandleRegistry(unsigned int _maxEntries = DEFAULT_MAX_ENTRIES)
+		: entries(16),
+		  maxEntries(_maxEntries)
+		{ }
+
+	~ConfigHandleRegistry() {
+		StringKeyTable<Entry *>::Iterator it(entries);
+		while (*it != NULL) {
+			delete it.getValue();
+			it.next();
+		}
+	}
+
+	/**
+	 * Returns the entry registered under the given handle,
+	 * or NULL if there is none.
+	 */
+	const Entry *lookup(const HashedStaticString &handle) const {
+		boost::lock_guard<boost::mutex> l(syncher);
+		Entry * const *entry;
+
+		if (entries.lookup(handle, &entry)) {
+			return *entry;
+		} else {
+			return NULL;
+		}
+	}
+
+	/**
+	 * Registers the given headers under the given handle. If the handle
+	 * was already registered, then the existing entry is returned. Returns
+	 * NULL if the handle is invalid or if the registry is full.
+	 */
+	const Entry *add(const HashedStaticString &handle, const HeaderList &headers) {
+		if (handle.empty() || handle.size() > StringKeyTable<Entry *>::MAX_KEY_LENGTH) {
+			return NULL;
+		}
+
+		const Entry *existingEntry = lookup(handle);
+		if (existingEntry != NULL) {
+			return existingEntry;
+		}
+
+		// Copy the data outside the lock.
+		Entry *entry = createEntry(headers);
+
+		boost::lock_guard<boost::mutex> l(syncher);
+		Entry **existingEntryPtr;
+		if (entries.lookup(handle, &existingEntryPtr)) {
+			// Another thread registered the same handle in the mean time.
+			delete entry;
+			return *existingEntryPtr;
+		} else if (entries.size() >= maxEntries) {
+			delete entry;
+			return NULL;
+		} else {
+			entries.insert(handle, entry);
+			return entry;
+		}
+	}
+
+	unsigned int size() const {
+		boost::lock_guard<boost::mutex> l(syncher);
+		return entries.size();
+	}
+};
+
+
+} // namespace Passenger
+
+#endif /* _PASSENGER_CONFIG_HANDLE_REGISTRY_H_ */
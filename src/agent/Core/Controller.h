@@ -53,7 +53,9 @@
 
 #include <sys/types.h>
 #include <sys/uio.h>
+#include <fcntl.h>
 #include <utility>
+#include <vector>
 #include <typeinfo>
 #include <cstdio>
 #include <cstdlib>
@@ -82,6 +84,10 @@
 #include <Core/Controller/Client.h>
 #include <Core/Controller/AppResponse.h>
 #include <Core/Controller/TurboCaching.h>
+#include <Core/Controller/LatencyStats.h>
+#include <Core/Controller/ResponseCompressor.h>
+#include <Core/ConfigHandleRegistry.h>
+#include <Core/OpenFileCache.h>
 
 namespace Passenger {
 
@@ -116,12 +122,34 @@ private:
 	ControllerRequestConfigPtr requestConfig;
 	StringKeyTable< boost::shared_ptr<Options> > poolOptionsCache;
 
+	/**
+	 * The web server sends the same `!~PASSENGER_ENV_VARS` value with every
+	 * request to a given location, so we cache the base64-decoded value per
+	 * app group instead of decoding it for every request.
+	 */
+	struct DecodedEnvvars {
+		string encoded;
+		string decoded;
+	};
+	StringKeyTable<DecodedEnvvars> decodedEnvvarsCache;
+	/**
+	 * Thread-local cache of `configHandleRegistry` lookups, so that requests
+	 * that only carry a config handle do not have to lock the registry.
+	 * Registry entries are never freed, so it is safe to cache them.
+	 */
+	StringKeyTable<const ConfigHandleRegistry::Entry *> configHandleCache;
+	/** Latency statistics of the requests handled by this thread, per app group. */
+	StringKeyTable< boost::shared_ptr<RequestLatencyStats> > latencyStats;
+
 	HashedStaticString PASSENGER_APP_GROUP_NAME;
+	HashedStaticString PASSENGER_CONFIG_HANDLE;
+	HashedStaticString PASSENGER_REGISTER_CONFIG_HANDLE;
 	HashedStaticString PASSENGER_ENV_VARS;
 	HashedStaticString PASSENGER_MAX_REQUESTS;
 	HashedStaticString PASSENGER_SHOW_VERSION_IN_HEADER;
 	HashedStaticString PASSENGER_STICKY_SESSIONS;
 	HashedStaticString PASSENGER_STICKY_SESSIONS_COOKIE_NAME;
+	HashedStaticString PASSENGER_RESPONSE_COMPRESSION;
 	HashedStaticString PASSENGER_REQUEST_OOB_WORK;
 	HashedStaticString REMOTE_ADDR;
 	HashedStaticString REMOTE_PORT;
@@ -136,15 +164,44 @@ private:
 	HashedStaticString HTTP_CONNECTION;
 	HashedStaticString HTTP_STATUS;
 	HashedStaticString HTTP_TRANSFER_ENCODING;
+	HashedStaticString HTTP_RANGE;
+	HashedStaticString HTTP_IF_RANGE;
+	HashedStaticString HTTP_CONTENT_RANGE;
+	HashedStaticString HTTP_ACCEPT_RANGES;
+	HashedStaticString HTTP_ACCEPT_ENCODING;
+	HashedStaticString HTTP_CONTENT_ENCODING;
+	HashedStaticString HTTP_CACHE_CONTROL;
+	HashedStaticString HTTP_ETAG;
+	HashedStaticString HTTP_VARY;
 
 	friend class TurboCaching<Request>;
 	friend class ResponseCache<Request>;
 	struct ev_check checkWatcher;
+	struct ev_prepare prepareWatcher;
 	TurboCaching<Request> turboCaching;
+	/**
+	 * Empty pipes that were used for splicing app responses, kept around so
+	 * that the next response does not have to create a new one.
+	 */
+	vector< pair<int, int> > freeSplicePipes;
+	/** Set to false if the kernel refuses to splice from app sockets. */
+	bool spliceSupported;
+	boost::uint64_t totalBytesSpliced;
+	/** Files that we served because of X-Sendfile or X-Accel-Redirect. */
+	OpenFileCache openFileCache;
+	boost::uint64_t totalBytesSentFromFiles;
+	/**
+	 * Compressors that are not in use by any request. Initializing a zlib
+	 * stream is expensive, so we keep some of them around.
+	 */
+	vector<ResponseCompressor *> freeResponseCompressors;
+	/** Scratch space for the output of ResponseCompressor::compress(). */
+	vector<MemoryKit::mbuf> compressedBuffers;
+	boost::uint64_t totalBytesCompressed;
+	boost::uint64_t totalCompressedBytesSent;
 	ConfigKit::Store *singleAppModeConfig;
 
 	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
-		struct ev_prepare prepareWatcher;
 		ev_tstamp timeBeforeBlocking;
 	#endif
 
@@ -158,6 +215,9 @@ private:
 
 	struct RequestAnalysis;
 
+	bool applyConfigHandle(Client *client, Request *req);
+	void registerConfigHandle(Client *client, Request *req, const LString *handle);
+	void insertConfigHandleHeaders(Request *req, const ConfigHandleRegistry::Entry *entry);
 	void initializeFlags(Client *client, Request *req, RequestAnalysis &analysis);
 	bool respondFromTurboCache(Client *client, Request *req);
 	void initializePoolOptions(Client *client, Request *req, RequestAnalysis &analysis);
@@ -202,6 +262,14 @@ private:
 		const AbstractSessionPtr &session, const ExceptionPtr &e);
 	void maybeSend100Continue(Client *client, Request *req);
 	void initiateSession(Client *client, Request *req);
+	void handleSessionInitiationError(Client *client, Request *req,
+		const SystemException &e);
+	void beginConnectingToApp(Client *client, Request *req);
+	static void onAppConnectWritable(EV_P_ struct ev_io *io, int revents);
+	static void onAppConnectTimer(EV_P_ struct ev_timer *timer, int revents);
+	void continueConnectingToApp(Client *client, Request *req);
+	void stopConnectingToApp(Request *req);
+	void sessionInitiated(Client *client, Request *req);
 	static void checkoutSessionLater(Request *req);
 	void reportSessionCheckoutError(Client *client, Request *req,
 		const ExceptionPtr &e);
@@ -228,6 +296,7 @@ private:
 		SessionProtocolWorkingState &state, string delta_monotonic);
 	bool constructHeaderForSessionProtocol(Request *req, char * restrict buffer,
 		unsigned int &size, const SessionProtocolWorkingState &state, string delta_monotonic);
+	const DecodedEnvvars &decodeEnvvars(Request *req);
 	void sendHeaderToAppWithHttpProtocol(Client *client, Request *req);
 	bool constructHeaderBuffersForHttpProtocol(Request *req, struct iovec *buffers,
 		unsigned int maxbuffers, unsigned int & restrict_ref nbuffers,
@@ -286,18 +355,48 @@ private:
 	void outputBuffersFlushed(Client *client, Request *req);
 	static void _outputDataFlushed(FileBufferedChannel *_channel);
 	void outputDataFlushed(Client *client, Request *req);
+	bool shouldSpliceAppResponse(Client *client, Request *req) const;
+	void beginSplicingAppResponse(Client *client, Request *req);
+	static void onAppResponseSpliceEvent(EV_P_ struct ev_io *io, int revents);
+	void continueSplicingAppResponse(Client *client, Request *req);
+	void waitForAppResponseSpliceEvent(Request *req, int fd, int events);
+	void stopSplicingAppResponse(Request *req);
+	bool shouldCompressAppResponse(Client *client, Request *req);
+	void beginCompressingAppResponse(Client *client, Request *req);
+	void prepareCompressedAppResponseHeaders(Request *req);
+	bool compressedAppResponseIsChunked(const Request *req) const;
+	void writeCompressedResponse(Client *client, Request *req,
+		const MemoryKit::mbuf &buffer, bool finish);
+	void stopCompressingAppResponse(Request *req);
 	void handleAppResponseBodyEnd(Client *client, Request *req);
 	OXT_FORCE_INLINE void keepAliveAppConnection(Client *client, Request *req);
 	void storeAppResponseInTurboCache(Client *client, Request *req);
 
 
+	/****** Stage: send file on behalf of application ******/
+
+	enum ByteRangeParseResult {
+		BYTE_RANGE_IGNORED,
+		BYTE_RANGE_SATISFIABLE,
+		BYTE_RANGE_UNSATISFIABLE
+	};
+
+	bool prepareSendingFile(Client *client, Request *req);
+	static ByteRangeParseResult parseByteRange(const StaticString &value,
+		boost::uint64_t size, boost::uint64_t &start, boost::uint64_t &length);
+	bool resolveSendFilePath(Request *req, string &path) const;
+	void beginSendingFile(Client *client, Request *req);
+	static void onSendFileWritable(EV_P_ struct ev_io *io, int revents);
+	void continueSendingFile(Client *client, Request *req);
+	void endSendingFile(Client *client, Request *req);
+	void stopSendingFile(Request *req);
+
+
 	/***** Hooks ******/
 
 	static Channel::Result onBodyBufferData(Channel *_channel,
 		const MemoryKit::mbuf &buffer, int errcode);
-	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
-		static void onEventLoopPrepare(EV_P_ struct ev_prepare *w, int revents);
-	#endif
+	static void onEventLoopPrepare(EV_P_ struct ev_prepare *w, int revents);
 	static void onEventLoopCheck(EV_P_ struct ev_check *w, int revents);
 
 
@@ -322,6 +421,8 @@ private:
 		Number min, Number max);
 	static void gatherBuffers(char * restrict dest, unsigned int size,
 		const struct iovec *buffers, unsigned int nbuffers);
+	void recordLatencyStats(Request *req);
+	void recordResponseOutputLatency(Request *req);
 	static LString *resolveSymlink(const StaticString &path, psg_pool_t *pool);
 	void parseCookieHeader(psg_pool_t *pool, const LString *headerValue,
 		vector< pair<StaticString, StaticString> > &cookies) const;
@@ -344,6 +445,7 @@ protected:
 	virtual void deinitializeClient(Client *client);
 	virtual void reinitializeRequest(Client *client, Request *req);
 	virtual void deinitializeRequest(Client *client, Request *req);
+	virtual void onRequestOutputFlushed(Client *client, Request *req);
 	void reinitializeAppResponse(Client *client, Request *req);
 	void deinitializeAppResponse(Client *client, Request *req);
 	virtual Channel::Result onRequestBody(Client *client, Request *req,
@@ -365,6 +467,14 @@ public:
 	// Dependencies
 	ResourceLocator *resourceLocator;
 	PoolPtr appPool;
+	/** If not NULL, turbocaching uses this cache, which is shared by all threads. */
+	SharedResponseCache *sharedTurboCache;
+	/**
+	 * Stores the option headers that web server modules registered under
+	 * config handles. Shared by all threads. If NULL, config handles are
+	 * not supported.
+	 */
+	ConfigHandleRegistry *configHandleRegistry;
 
 
 	/****** Initialization and shutdown ******/
@@ -382,10 +492,20 @@ public:
 		  mainConfig(config),
 		  requestConfig(new ControllerRequestConfig(config)),
 		  poolOptionsCache(4),
+		  decodedEnvvarsCache(4),
+		  configHandleCache(4),
+		  latencyStats(4),
 
 		  turboCaching(),
+		  spliceSupported(true),
+		  totalBytesSpliced(0),
+		  totalBytesSentFromFiles(0),
+		  totalBytesCompressed(0),
+		  totalCompressedBytesSent(0),
 		  singleAppModeConfig(NULL),
-		  resourceLocator(NULL)
+		  resourceLocator(NULL),
+		  sharedTurboCache(NULL),
+		  configHandleRegistry(NULL)
 		  /**************************/
 	{
 		if (mainConfig.singleAppMode) {
@@ -420,6 +540,7 @@ public:
 	virtual Json::Value inspectStateAsJson() const;
 	virtual Json::Value inspectClientStateAsJson(const Client *client) const;
 	virtual Json::Value inspectRequestStateAsJson(const Request *req) const;
+	void collectLatencyStats(RequestLatencyStatsMap &result) const;
 
 
 	/****** Miscellaneous *******/
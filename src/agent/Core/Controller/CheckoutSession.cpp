@@ -40,6 +40,11 @@ using namespace std;
 using namespace boost;
 
 
+// How often to retry connecting to an application process whose
+// listen backlog was full.
+static const ev_tstamp APP_CONNECT_RETRY_INTERVAL = 0.01;
+
+
 /****************************
  *
  * Private methods
@@ -66,6 +71,9 @@ Controller::checkoutSession(Client *client, Request *req) {
 	callback.userData = req;
 
 	options.currentTime = SystemTime::getUsec();
+	if (req->checkoutBeganAt == 0) {
+		req->checkoutBeganAt = SystemTime::getMonotonicUsec();
+	}
 
 	refRequest(req, __FILE__, __LINE__);
 	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
@@ -138,6 +146,7 @@ Controller::sessionCheckedOutFromEventLoopThread(Client *client, Request *req,
 		SKC_DEBUG(client, "Session checked out: pid=" << session->getPid() <<
 			", gupid=" << session->getGupid());
 		req->session = session;
+		req->sessionCheckedOutAt = SystemTime::getMonotonicUsec();
 		UPDATE_TRACE_POINT();
 		maybeSend100Continue(client, req);
 		UPDATE_TRACE_POINT();
@@ -179,24 +188,133 @@ Controller::initiateSession(Client *client, Request *req) {
 	try {
 		req->session->initiate(false);
 	} catch (const SystemException &e2) {
-		if (req->sessionCheckoutTry < MAX_SESSION_CHECKOUT_TRY) {
-			SKC_DEBUG(client, "Error checking out session (" << e2.what() <<
-				"); retrying (attempt " << req->sessionCheckoutTry << ")");
-			refRequest(req, __FILE__, __LINE__);
-			getContext()->libev->runLater(boost::bind(checkoutSessionLater, req));
-		} else {
-			string message = "could not initiate a session (";
-			message.append(e2.what());
-			message.append(")");
-			disconnectWithError(&client, message);
-		}
+		handleSessionInitiationError(client, req, e2);
 		return;
 	}
 
 	UPDATE_TRACE_POINT();
+	if (req->session->isConnecting()) {
+		beginConnectingToApp(client, req);
+	} else {
+		sessionInitiated(client, req);
+	}
+}
 
-	UPDATE_TRACE_POINT();
+void
+Controller::handleSessionInitiationError(Client *client, Request *req,
+	const SystemException &e)
+{
+	if (req->sessionCheckoutTry < MAX_SESSION_CHECKOUT_TRY) {
+		SKC_DEBUG(client, "Error checking out session (" << e.what() <<
+			"); retrying (attempt " << req->sessionCheckoutTry << ")");
+		refRequest(req, __FILE__, __LINE__);
+		getContext()->libev->runLater(boost::bind(checkoutSessionLater, req));
+	} else {
+		string message = "could not initiate a session (";
+		message.append(e.what());
+		message.append(")");
+		disconnectWithError(&client, message);
+	}
+}
+
+/**
+ * The application process did not accept our connection immediately,
+ * e.g. because its listen backlog is full. We wait for the connection
+ * to be established in the background so that other clients on this
+ * event loop are not blocked in the mean time.
+ */
+void
+Controller::beginConnectingToApp(Client *client, Request *req) {
+	ev_tstamp now = ev_now(getLoop());
+	ev_tstamp timeout = mainConfig.appConnectTimeout / 1000.0;
+
+	SKC_TRACE(client, 2, "Connecting to application process in the background");
+	req->state = Request::CONNECTING_TO_APP;
+	req->appConnectDeadline = now + timeout;
+
+	if (req->session->canPollForConnect()) {
+		ev_io_set(&req->appConnectWatcher, req->session->fd(), EV_WRITE);
+		ev_io_start(getLoop(), &req->appConnectWatcher);
+		ev_timer_set(&req->appConnectTimer, timeout, 0);
+	} else {
+		ev_timer_set(&req->appConnectTimer,
+			std::min<ev_tstamp>(APP_CONNECT_RETRY_INTERVAL, timeout), 0);
+	}
+	ev_timer_start(getLoop(), &req->appConnectTimer);
+}
+
+void
+Controller::onAppConnectWritable(EV_P_ struct ev_io *io, int revents) {
+	Request *req = static_cast<Request *>(io->data);
+	Client *client = static_cast<Client *>(req->client);
+	Controller *self = static_cast<Controller *>(getServerFromClient(client));
+	SKC_LOG_EVENT_FROM_STATIC(self, Controller, client, "onAppConnectWritable");
+
+	self->continueConnectingToApp(client, req);
+}
+
+void
+Controller::onAppConnectTimer(EV_P_ struct ev_timer *timer, int revents) {
+	Request *req = static_cast<Request *>(timer->data);
+	Client *client = static_cast<Client *>(req->client);
+	Controller *self = static_cast<Controller *>(getServerFromClient(client));
+	SKC_LOG_EVENT_FROM_STATIC(self, Controller, client, "onAppConnectTimer");
+
+	if (req->ended()) {
+		self->stopConnectingToApp(req);
+	} else if (ev_now(EV_A) >= req->appConnectDeadline) {
+		self->stopConnectingToApp(req);
+		self->disconnectWithError(&client, "timed out connecting to the application");
+	} else {
+		self->continueConnectingToApp(client, req);
+	}
+}
+
+void
+Controller::continueConnectingToApp(Client *client, Request *req) {
+	TRACE_POINT();
+	bool connected;
+
+	if (req->ended()) {
+		stopConnectingToApp(req);
+		return;
+	}
+
+	try {
+		connected = req->session->continueConnecting();
+	} catch (const SystemException &e) {
+		stopConnectingToApp(req);
+		handleSessionInitiationError(client, req, e);
+		return;
+	}
+
+	if (connected) {
+		stopConnectingToApp(req);
+		sessionInitiated(client, req);
+	} else {
+		// Make sure we wake up again to either retry or to time out.
+		ev_tstamp after = std::max<ev_tstamp>(0,
+			req->appConnectDeadline - ev_now(getLoop()));
+		if (!req->session->canPollForConnect()) {
+			after = std::min<ev_tstamp>(after, APP_CONNECT_RETRY_INTERVAL);
+		}
+		ev_timer_stop(getLoop(), &req->appConnectTimer);
+		ev_timer_set(&req->appConnectTimer, after, 0);
+		ev_timer_start(getLoop(), &req->appConnectTimer);
+	}
+}
+
+void
+Controller::stopConnectingToApp(Request *req) {
+	ev_io_stop(getLoop(), &req->appConnectWatcher);
+	ev_timer_stop(getLoop(), &req->appConnectTimer);
+}
+
+void
+Controller::sessionInitiated(Client *client, Request *req) {
+	TRACE_POINT();
 	SKC_DEBUG(client, "Session initiated: fd=" << req->session->fd());
+	req->sessionInitiatedAt = SystemTime::getMonotonicUsec();
 	req->appSink.reinitialize(req->session->fd());
 	req->appSource.reinitialize(req->session->fd());
 	/***************/
@@ -82,6 +82,7 @@ parseControllerBenchmarkMode(const StaticString &mode) {
  * by 'rake configkit_schemas_inline_comments')
  *
  *   accept_burst_count                                  unsigned integer   -          default(32)
+ *   app_connect_timeout                                 unsigned integer   -          default(10000)
  *   benchmark_mode                                      string             -          -
  *   client_freelist_limit                               unsigned integer   -          default(0)
  *   default_abort_websockets_on_process_shutdown        boolean            -          default(true)
@@ -98,25 +99,37 @@ parseControllerBenchmarkMode(const StaticString &mode) {
  *   default_min_instances                               unsigned integer   -          default(1)
  *   default_nodejs                                      string             -          default("node")
  *   default_python                                      string             -          default("python")
+ *   default_response_compression                        boolean            -          default(false)
  *   default_ruby                                        string             -          default("ruby")
  *   default_server_name                                 string             required   -
  *   default_server_port                                 unsigned integer   required   -
+ *   default_spawn_concurrency                           unsigned integer   -          default(1)
  *   default_spawn_method                                string             -          default("smart")
  *   default_sticky_sessions                             boolean            -          default(false)
  *   default_sticky_sessions_cookie_name                 string             -          default("_passenger_route")
  *   default_user                                        string             -          default("nobody")
  *   graceful_exit                                       boolean            -          default(true)
+ *   http2                                               boolean            -          default(false)
+ *   http2_max_concurrent_streams                        unsigned integer   -          default(100)
  *   integration_mode                                    string             -          default("standalone"),read_only
  *   max_instances_per_app                               unsigned integer   -          read_only
  *   min_spare_clients                                   unsigned integer   -          default(0)
  *   multi_app                                           boolean            -          default(true),read_only
  *   request_freelist_limit                              unsigned integer   -          default(1024)
  *   response_buffer_high_watermark                      unsigned integer   -          default(134217728)
+ *   response_compression_level                          unsigned integer   -          default(6)
+ *   response_compression_min_size                       unsigned integer   -          default(256)
+ *   response_splice_threshold                           unsigned integer   -          default(131072)
+ *   sendfile_root                                       string             -          -
  *   server_software                                     string             -          default("Phusion_Passenger/5.3.2")
  *   show_version_in_header                              boolean            -          default(true)
  *   start_reading_after_accept                          boolean            -          default(true)
  *   stat_throttle_rate                                  unsigned integer   -          default(10)
  *   thread_number                                       unsigned integer   required   read_only
+ *   turbocache_max_body_size                            unsigned integer   -          default(131072),read_only
+ *   turbocache_max_entries                              unsigned integer   -          default(1024),read_only
+ *   turbocache_max_memory                               unsigned integer   -          default(8388608),read_only
+ *   turbocache_shared                                   boolean            -          default(false),read_only
  *   turbocaching                                        boolean            -          default(true),read_only
  *   user_switching                                      boolean            -          default(true)
  *   vary_turbocache_by_cookie                           string             -          -
@@ -133,12 +146,21 @@ private:
 		add("thread_number", UINT_TYPE, REQUIRED | READ_ONLY);
 		add("multi_app", BOOL_TYPE, OPTIONAL | READ_ONLY, true);
 		add("turbocaching", BOOL_TYPE, OPTIONAL | READ_ONLY, true);
+		add("turbocache_max_entries", UINT_TYPE, OPTIONAL | READ_ONLY, 1024);
+		add("turbocache_max_memory", UINT_TYPE, OPTIONAL | READ_ONLY, 1024 * 1024 * 8);
+		add("turbocache_max_body_size", UINT_TYPE, OPTIONAL | READ_ONLY, 1024 * 128);
+		add("turbocache_shared", BOOL_TYPE, OPTIONAL | READ_ONLY, false);
 		add("integration_mode", STRING_TYPE, OPTIONAL | READ_ONLY, DEFAULT_INTEGRATION_MODE);
 
 		add("user_switching", BOOL_TYPE, OPTIONAL, true);
 		add("stat_throttle_rate", UINT_TYPE, OPTIONAL, DEFAULT_STAT_THROTTLE_RATE);
 		add("show_version_in_header", BOOL_TYPE, OPTIONAL, true);
 		add("response_buffer_high_watermark", UINT_TYPE, OPTIONAL, DEFAULT_RESPONSE_BUFFER_HIGH_WATERMARK);
+		add("response_splice_threshold", UINT_TYPE, OPTIONAL, 1024 * 128);
+		add("response_compression_level", UINT_TYPE, OPTIONAL, DEFAULT_RESPONSE_COMPRESSION_LEVEL);
+		add("response_compression_min_size", UINT_TYPE, OPTIONAL, DEFAULT_RESPONSE_COMPRESSION_MIN_SIZE);
+		add("sendfile_root", STRING_TYPE, OPTIONAL);
+		add("app_connect_timeout", UINT_TYPE, OPTIONAL, 10000);
 		add("graceful_exit", BOOL_TYPE, OPTIONAL, true);
 		add("benchmark_mode", STRING_TYPE, OPTIONAL);
 
@@ -153,6 +175,7 @@ private:
 		add("default_server_port", UINT_TYPE, REQUIRED);
 		add("default_sticky_sessions", BOOL_TYPE, OPTIONAL, false);
 		add("default_sticky_sessions_cookie_name", STRING_TYPE, OPTIONAL, DEFAULT_STICKY_SESSIONS_COOKIE_NAME);
+		add("default_response_compression", BOOL_TYPE, OPTIONAL, false);
 		add("server_software", STRING_TYPE, OPTIONAL, SERVER_TOKEN_NAME "/" PASSENGER_VERSION);
 		add("vary_turbocache_by_cookie", STRING_TYPE, OPTIONAL);
 
@@ -165,6 +188,7 @@ private:
 		add("default_min_instances", UINT_TYPE, OPTIONAL, 1);
 		add("default_max_preloader_idle_time", UINT_TYPE, OPTIONAL, DEFAULT_MAX_PRELOADER_IDLE_TIME);
 		add("default_max_request_queue_size", UINT_TYPE, OPTIONAL, DEFAULT_MAX_REQUEST_QUEUE_SIZE);
+		add("default_spawn_concurrency", UINT_TYPE, OPTIONAL, DEFAULT_SPAWN_CONCURRENCY);
 		add("default_force_max_concurrent_requests_per_process", INT_TYPE, OPTIONAL, -1);
 		add("default_abort_websockets_on_process_shutdown", BOOL_TYPE, OPTIONAL, true);
 		add("default_max_requests", UINT_TYPE, OPTIONAL, 0);
@@ -176,6 +200,7 @@ private:
 
 		addValidator(validate);
 		addValidator(ConfigKit::validateIntegrationMode);
+		addNormalizer(normalizeSendfileRoot);
 	}
 
 	static Json::Value inferDefaultValueForDefaultGroup(const ConfigKit::Store &config) {
@@ -199,9 +224,29 @@ private:
 			errors.push_back(Error("'{{benchmark_mode}}' is not set to a valid value"));
 		}
 
+		unsigned int level = config["response_compression_level"].asUInt();
+		if (level < 1 || level > 9) {
+			errors.push_back(Error("'{{response_compression_level}}' must be between 1 and 9"));
+		}
+
+		if (config["default_spawn_concurrency"].asUInt() < 1) {
+			errors.push_back(Error("'{{default_spawn_concurrency}}' must be at least 1"));
+		}
+
 		/*******************/
 	}
 
+	static Json::Value normalizeSendfileRoot(const Json::Value &effectiveValues) {
+		Json::Value updates;
+		if (!effectiveValues["sendfile_root"].isNull()
+		 && !effectiveValues["sendfile_root"].asString().empty())
+		{
+			updates["sendfile_root"] = absolutizePath(
+				effectiveValues["sendfile_root"].asString());
+		}
+		return updates;
+	}
+
 public:
 	ControllerSchema()
 		: ServerKit::HttpServerSchema(false)
@@ -308,13 +353,23 @@ public:
 	unsigned int threadNumber;
 	unsigned int statThrottleRate;
 	unsigned int responseBufferHighWatermark;
+	unsigned int responseSpliceThreshold; // 0 = disabled
+	unsigned int responseCompressionLevel;
+	unsigned int responseCompressionMinSize;
+	unsigned int appConnectTimeout; // msec
 	StaticString integrationMode;
+	/**
+	 * If not empty, the controller serves X-Sendfile and X-Accel-Redirect
+	 * responses itself, from files under this directory.
+	 */
+	StaticString sendfileRoot;
 	StaticString serverLogName;
 	unsigned int maxInstancesPerApp;
 	ControllerBenchmarkMode benchmarkMode: 3;
 	bool singleAppMode: 1;
 	bool userSwitching: 1;
 	bool defaultStickySessions: 1;
+	bool defaultResponseCompression: 1;
 	bool gracefulExit: 1;
 
 	/*******************/
@@ -326,13 +381,19 @@ public:
 		  threadNumber(config["thread_number"].asUInt()),
 		  statThrottleRate(config["stat_throttle_rate"].asUInt()),
 		  responseBufferHighWatermark(config["response_buffer_high_watermark"].asUInt()),
+		  responseSpliceThreshold(config["response_splice_threshold"].asUInt()),
+		  responseCompressionLevel(config["response_compression_level"].asUInt()),
+		  responseCompressionMinSize(config["response_compression_min_size"].asUInt()),
+		  appConnectTimeout(config["app_connect_timeout"].asUInt()),
 		  integrationMode(psg_pstrdup(pool, config["integration_mode"].asString())),
+		  sendfileRoot(psg_pstrdup(pool, config["sendfile_root"].asString())),
 		  serverLogName(createServerLogName()),
 		  maxInstancesPerApp(config["max_instances_per_app"].asUInt()),
 		  benchmarkMode(parseControllerBenchmarkMode(config["benchmark_mode"].asString())),
 		  singleAppMode(!config["multi_app"].asBool()),
 		  userSwitching(config["user_switching"].asBool()),
 		  defaultStickySessions(config["default_sticky_sessions"].asBool()),
+		  defaultResponseCompression(config["default_response_compression"].asBool()),
 		  gracefulExit(config["graceful_exit"].asBool())
 
 		  /*******************/
@@ -356,12 +417,18 @@ public:
 		std::swap(threadNumber, other.threadNumber);
 		std::swap(statThrottleRate, other.statThrottleRate);
 		std::swap(responseBufferHighWatermark, other.responseBufferHighWatermark);
+		std::swap(responseSpliceThreshold, other.responseSpliceThreshold);
+		std::swap(responseCompressionLevel, other.responseCompressionLevel);
+		std::swap(responseCompressionMinSize, other.responseCompressionMinSize);
+		std::swap(appConnectTimeout, other.appConnectTimeout);
 		std::swap(integrationMode, other.integrationMode);
+		std::swap(sendfileRoot, other.sendfileRoot);
 		std::swap(serverLogName, other.serverLogName);
 		SWAP_BITFIELD(ControllerBenchmarkMode, benchmarkMode);
 		SWAP_BITFIELD(bool, singleAppMode);
 		SWAP_BITFIELD(bool, userSwitching);
 		SWAP_BITFIELD(bool, defaultStickySessions);
+		SWAP_BITFIELD(bool, defaultResponseCompression);
 		SWAP_BITFIELD(bool, gracefulExit);
 
 		/*******************/
@@ -400,10 +467,16 @@ public:
 	StaticString defaultEnvironment;
 	StaticString defaultSpawnMethod;
 	StaticString defaultMeteorAppSettings;
+	/**
+	 * The part of the session protocol header that is the same for
+	 * every request, pre-serialized.
+	 */
+	StaticString sessionProtocolStaticHeader;
 	unsigned int defaultAppFileDescriptorUlimit;
 	unsigned int defaultMinInstances;
 	unsigned int defaultMaxPreloaderIdleTime;
 	unsigned int defaultMaxRequestQueueSize;
+	unsigned int defaultSpawnConcurrency;
 	unsigned int defaultMaxRequests;
 	int defaultForceMaxConcurrentRequestsPerProcess;
 	bool showVersionInHeader: 1;
@@ -436,6 +509,7 @@ public:
 		  defaultMinInstances(config["default_min_instances"].asUInt()),
 		  defaultMaxPreloaderIdleTime(config["default_max_preloader_idle_time"].asUInt()),
 		  defaultMaxRequestQueueSize(config["default_max_request_queue_size"].asUInt()),
+		  defaultSpawnConcurrency(config["default_spawn_concurrency"].asUInt()),
 		  defaultMaxRequests(config["default_max_requests"].asUInt()),
 		  defaultForceMaxConcurrentRequestsPerProcess(config["default_force_max_concurrent_requests_per_process"].asInt()),
 		  showVersionInHeader(config["show_version_in_header"].asBool()),
@@ -443,7 +517,15 @@ public:
 		  defaultLoadShellEnvvars(config["default_load_shell_envvars"].asBool())
 
 		  /*******************/
-		{ }
+	{
+		string header;
+		header.append("SERVER_SOFTWARE", sizeof("SERVER_SOFTWARE"));
+		header.append(serverSoftware.data(), serverSoftware.size());
+		header.append(1, '\0');
+		header.append("SERVER_PROTOCOL", sizeof("SERVER_PROTOCOL"));
+		header.append("HTTP/1.1", sizeof("HTTP/1.1"));
+		sessionProtocolStaticHeader = psg_pstrdup(pool, header);
+	}
 
 	~ControllerRequestConfig() {
 		psg_destroy_pool(pool);
@@ -167,6 +167,9 @@ Controller::onAppSourceData(Client *client, Request *req, const MemoryKit::mbuf
 						endRequest(&client, &req);
 					} else {
 						maybeThrottleAppSource(client, req);
+						if (shouldSpliceAppResponse(client, req)) {
+							beginSplicingAppResponse(client, req);
+						}
 					}
 				}
 			} else {
@@ -208,7 +211,7 @@ Controller::onAppSourceData(Client *client, Request *req, const MemoryKit::mbuf
 				.feed(buffer));
 			resp->bodyAlreadyRead += event.consumed;
 
-			if (req->dechunkResponse) {
+			if (req->dechunkResponse || req->compressingResponse) {
 				UPDATE_TRACE_POINT();
 				switch (event.type) {
 				case ServerKit::HttpChunkedEvent::NONE:
@@ -290,11 +293,20 @@ Controller::onAppSourceData(Client *client, Request *req, const MemoryKit::mbuf
 			resp->bodyAlreadyRead += buffer.size();
 			writeResponseAndMarkForTurboCaching(client, req, buffer);
 			maybeThrottleAppSource(client, req);
+			if (shouldSpliceAppResponse(client, req)) {
+				beginSplicingAppResponse(client, req);
+			}
 			return Channel::Result(buffer.size(), false);
 		} else if (errcode == 0 || errcode == ECONNRESET) {
 			// EOF
 			UPDATE_TRACE_POINT();
 			SKC_TRACE(client, 2, "Application sent EOF");
+			if (req->compressingResponse) {
+				writeCompressedResponse(client, req, MemoryKit::mbuf(), true);
+				if (req->ended()) {
+					return Channel::Result(0, false);
+				}
+			}
 			SKC_TRACE(client, 2, "Not keep-aliving application session connection");
 			req->session->close(true, false);
 			endRequest(&client, &req);
@@ -319,6 +331,8 @@ Controller::onAppResponseBegin(Client *client, Request *req) {
 	ssize_t bytesWritten;
 	bool oobw;
 
+	req->appResponseBegunAt = SystemTime::getMonotonicUsec();
+
 	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
 		req->timeOnRequestHeaderSent = ev_now(getLoop());
 		reportLargeTimeDiff(client,
@@ -360,15 +374,36 @@ Controller::onAppResponseBegin(Client *client, Request *req) {
 	if (resp->headers.lookup(ServerKit::HTTP_X_SENDFILE) != NULL
 	 || resp->headers.lookup(ServerKit::HTTP_X_ACCEL_REDIRECT) != NULL)
 	{
-		// If X-Sendfile or X-Accel-Redirect is set, then HttpHeaderParser
-		// treats the app response as having no body, and removes the
-		// Content-Length and Transfer-Encoding headers. Because of this,
-		// the response that we output also doesn't Content-Length
-		// or Transfer-Encoding. So we should disable keep-alive.
-		req->wantKeepAlive = false;
+		if (!mainConfig.sendfileRoot.empty()
+		 && OXT_LIKELY(mainConfig.benchmarkMode != BM_RESPONSE_BEGIN))
+		{
+			// We send the file ourselves, so the response that we
+			// output gets a Content-Length. See SendFile.cpp.
+			if (!prepareSendingFile(client, req)) {
+				return;
+			}
+		} else {
+			// If X-Sendfile or X-Accel-Redirect is set, then HttpHeaderParser
+			// treats the app response as having no body, and removes the
+			// Content-Length and Transfer-Encoding headers. Because of this,
+			// the response that we output also doesn't Content-Length
+			// or Transfer-Encoding. So we should disable keep-alive.
+			req->wantKeepAlive = false;
+		}
+	}
+
+	if (shouldCompressAppResponse(client, req)) {
+		beginCompressingAppResponse(client, req);
 	}
 
 	prepareAppResponseCaching(client, req);
+	if (req->compressingResponse) {
+		// This adds a Vary header, so it must happen after
+		// prepareAppResponseCaching(), which doesn't cache responses that
+		// have one. The turbocache already stores compressed responses
+		// under their own key.
+		prepareCompressedAppResponseHeaders(req);
+	}
 
 	if (OXT_UNLIKELY(oobw)) {
 		SKC_TRACE(client, 2, "Response with OOBW detected");
@@ -389,7 +424,12 @@ Controller::onAppResponseBegin(Client *client, Request *req) {
 		}
 	}
 
-	if (!req->ended() && !resp->hasBody() && !resp->upgraded()) {
+	if (req->ended()) {
+		return;
+	} else if (req->sendingFile) {
+		UPDATE_TRACE_POINT();
+		beginSendingFile(client, req);
+	} else if (!resp->hasBody() && !resp->upgraded()) {
 		UPDATE_TRACE_POINT();
 		handleAppResponseBodyEnd(client, req);
 		endRequest(&client, &req);
@@ -406,10 +446,10 @@ Controller::prepareAppResponseCaching(Client *client, Request *req) {
 		 && turboCaching.responseCache.prepareRequestForStoring(req))
 		{
 			if (resp->bodyType == AppResponse::RBT_CONTENT_LENGTH
-			 && resp->aux.bodyInfo.contentLength > ResponseCache<Request>::MAX_BODY_SIZE)
+			 && resp->aux.bodyInfo.contentLength > turboCaching.responseCache.getMaxBodySize())
 			{
 				SKC_DEBUG(client, "Response body larger than " <<
-					ResponseCache<Request>::MAX_BODY_SIZE <<
+					turboCaching.responseCache.getMaxBodySize() <<
 					" bytes, so response is not eligible for turbocaching");
 				// Decrease store success ratio.
 				turboCaching.responseCache.incStores();
@@ -672,9 +712,18 @@ Controller::constructHeaderBuffersForResponse(Request *req, struct iovec *buffer
 		PUSH_STATIC_BUFFER("\r\n");
 	}
 
+	if (req->compressingResponse) {
+		PUSH_STATIC_BUFFER("Content-Encoding: gzip\r\n");
+	}
+
 	nCacheableBuffers = i;
 
-	if (resp->bodyType == AppResponse::RBT_CONTENT_LENGTH) {
+	if (req->compressingResponse) {
+		// The size of the compressed body is not known in advance.
+		if (compressedAppResponseIsChunked(req)) {
+			PUSH_STATIC_BUFFER("Transfer-Encoding: chunked\r\n");
+		}
+	} else if (resp->bodyType == AppResponse::RBT_CONTENT_LENGTH) {
 		PUSH_STATIC_BUFFER("Content-Length: ");
 		if (buffers != NULL) {
 			BEGIN_PUSH_NEXT_BUFFER();
@@ -767,6 +816,12 @@ Controller::constructHeaderBuffersForResponse(Request *req, struct iovec *buffer
 		PUSH_STATIC_BUFFER("\r\n");
 	}
 
+	if (req->configHandleRegistered) {
+		// Tells the web server module that it may send just the config
+		// handle from now on. The module strips this header.
+		PUSH_STATIC_BUFFER("X-Passenger-Config-Handle: registered\r\n");
+	}
+
 	if (req->config->showVersionInHeader) {
 		#ifdef PASSENGER_IS_ENTERPRISE
 			PUSH_STATIC_BUFFER("X-Powered-By: " PROGRAM_NAME " Enterprise " PASSENGER_VERSION "\r\n\r\n");
@@ -956,6 +1011,11 @@ void
 Controller::writeResponseAndMarkForTurboCaching(Client *client, Request *req,
 	const MemoryKit::mbuf &buffer)
 {
+	if (req->compressingResponse) {
+		// Marks the compressed data for turbocaching.
+		writeCompressedResponse(client, req, buffer, false);
+		return;
+	}
 	if (OXT_LIKELY(mainConfig.benchmarkMode != BM_RESPONSE_BEGIN)) {
 		writeResponse(client, buffer);
 	}
@@ -968,9 +1028,9 @@ Controller::markResponsePartForTurboCaching(Client *client, Request *req,
 {
 	if (!req->ended() && turboCaching.isEnabled() && !req->cacheKey.empty()) {
 		unsigned int totalSize = req->appResponse.bodyCacheBuffer.size + buffer.size();
-		if (totalSize > ResponseCache<Request>::MAX_BODY_SIZE) {
+		if (totalSize > turboCaching.responseCache.getMaxBodySize()) {
 			SKC_DEBUG(client, "Response body larger than " <<
-				ResponseCache<Request>::MAX_HEADER_SIZE <<
+				turboCaching.responseCache.getMaxBodySize() <<
 				" bytes, so response is not eligible for turbocaching");
 			// Decrease store success ratio.
 			turboCaching.responseCache.incStores();
@@ -1045,14 +1105,469 @@ void
 Controller::outputDataFlushed(Client *client, Request *req) {
 	if (!req->ended()) {
 		assert(!req->appSource.isStarted());
-		SKC_TRACE(client, 2, "The client is ready to receive more data. Resuming application socket");
 		client->output.setDataFlushedCallback(getClientOutputDataFlushedCallback());
-		req->appSource.start();
+		if (req->sendingFile) {
+			SKC_TRACE(client, 2, "Response headers have been sent. Sending file");
+			continueSendingFile(client, req);
+		} else {
+			SKC_TRACE(client, 2, "The client is ready to receive more data. Resuming application socket");
+			req->appSource.start();
+		}
+	}
+}
+
+/**
+ * Large response bodies are normally read from the app socket into mbufs
+ * by `req->appSource`, and then written to the client socket by
+ * `client->output`. splice() lets the kernel move the data from the app
+ * socket to the client socket through a pipe instead, without copying it
+ * through user space.
+ *
+ * We only switch to splicing when nothing else needs to see the body data:
+ * the body has a fixed length or lasts until EOF (chunked bodies must be
+ * parsed), it is not being stored in the turbocache or compressed, and
+ * `client->output` has no buffered data that the spliced data would
+ * otherwise overtake. Likewise, `appSource` must not have data left from a
+ * readv() that it has not fed to us yet, because splice() would skip it.
+ * Once splicing has begun, neither `appSource` nor `client->output` is used
+ * until the request ends.
+ */
+bool
+Controller::shouldSpliceAppResponse(Client *client, Request *req) const {
+	#ifdef __linux__
+		const AppResponse *resp = &req->appResponse;
+
+		if (mainConfig.responseSpliceThreshold == 0
+		 || !spliceSupported
+		 || req->ended()
+		 || !req->appSource.isStarted()
+		 || req->appSource.hasPendingBuffers()
+		 || !req->cacheKey.empty()
+		 || req->compressingResponse
+		 || mainConfig.benchmarkMode == BM_RESPONSE_BEGIN
+		 || client->output.ended()
+		 || client->output.getTotalBytesBuffered() > 0)
+		{
+			return false;
+		}
+
+		switch (resp->httpState) {
+		case AppResponse::PARSING_BODY_WITH_LENGTH:
+			return resp->aux.bodyInfo.contentLength - resp->bodyAlreadyRead
+				>= mainConfig.responseSpliceThreshold;
+		case AppResponse::PARSING_BODY_UNTIL_EOF:
+			// We don't know how large the body is going to be, so we
+			// only splice after the app has already sent a lot of data.
+			return resp->bodyAlreadyRead >= mainConfig.responseSpliceThreshold;
+		default:
+			return false;
+		}
+	#else
+		return false;
+	#endif
+}
+
+void
+Controller::beginSplicingAppResponse(Client *client, Request *req) {
+	int fds[2];
+
+	if (!freeSplicePipes.empty()) {
+		fds[0] = freeSplicePipes.back().first;
+		fds[1] = freeSplicePipes.back().second;
+		freeSplicePipes.pop_back();
+	} else {
+		#ifdef __linux__
+			if (pipe2(fds, O_NONBLOCK | O_CLOEXEC) == -1) {
+				int e = errno;
+				SKC_WARN(client, "Cannot create a pipe for forwarding the "
+					"application response: " << strerror(e) << " (errno=" << e << ")");
+				return;
+			}
+			P_LOG_FILE_DESCRIPTOR_OPEN4(fds[0], __FILE__, __LINE__,
+				"Response splice pipe (read end)");
+			P_LOG_FILE_DESCRIPTOR_OPEN4(fds[1], __FILE__, __LINE__,
+				"Response splice pipe (write end)");
+		#else
+			return;
+		#endif
+	}
+
+	SKC_TRACE(client, 2, "Forwarding the rest of the application response with splice()");
+	req->appSource.stop();
+	req->splicingAppResponse = true;
+	req->appResponseSplicePipe[0] = fds[0];
+	req->appResponseSplicePipe[1] = fds[1];
+	req->appResponseSplicePipeBytes = 0;
+	waitForAppResponseSpliceEvent(req, req->appSource.getFd(), EV_READ);
+}
+
+void
+Controller::onAppResponseSpliceEvent(EV_P_ struct ev_io *io, int revents) {
+	Request *req = static_cast<Request *>(io->data);
+	Client *client = static_cast<Client *>(req->client);
+	Controller *self = static_cast<Controller *>(getServerFromClient(client));
+	SKC_LOG_EVENT_FROM_STATIC(self, Controller, client, "onAppResponseSpliceEvent");
+
+	if (req->ended()) {
+		self->stopSplicingAppResponse(req);
+	} else {
+		self->continueSplicingAppResponse(client, req);
+	}
+}
+
+void
+Controller::continueSplicingAppResponse(Client *client, Request *req) {
+	#ifdef __linux__
+		TRACE_POINT();
+		AppResponse *resp = &req->appResponse;
+		int appFd = req->appSource.getFd();
+		int clientFd = client->getFd();
+		unsigned int i;
+		ssize_t ret;
+		int e;
+
+		// Limit the amount of work per event loop iteration so that
+		// other clients get a chance too.
+		for (i = 0; i < 16; i++) {
+			// Drain the pipe before reading more app data into it.
+			while (req->appResponseSplicePipeBytes > 0) {
+				do {
+					ret = splice(req->appResponseSplicePipe[0], NULL,
+						clientFd, NULL, req->appResponseSplicePipeBytes,
+						SPLICE_F_MOVE | SPLICE_F_NONBLOCK | SPLICE_F_MORE);
+				} while (OXT_UNLIKELY(ret == -1 && errno == EINTR));
+				if (ret > 0) {
+					req->appResponseSplicePipeBytes -= ret;
+					totalBytesSpliced += ret;
+				} else if (ret == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+					waitForAppResponseSpliceEvent(req, clientFd, EV_WRITE);
+					return;
+				} else {
+					e = (ret == -1) ? errno : EPIPE;
+					stopSplicingAppResponse(req);
+					disconnectWithClientSocketWriteError(&client, e);
+					return;
+				}
+			}
+
+			if (resp->httpState == AppResponse::PARSING_BODY_WITH_LENGTH
+			 && resp->bodyFullyRead())
+			{
+				UPDATE_TRACE_POINT();
+				SKC_TRACE(client, 2, "End of application response body reached");
+				stopSplicingAppResponse(req);
+				handleAppResponseBodyEnd(client, req);
+				endRequest(&client, &req);
+				return;
+			}
+
+			size_t max = 1024 * 64;
+			if (resp->httpState == AppResponse::PARSING_BODY_WITH_LENGTH) {
+				max = std::min<boost::uint64_t>(max,
+					resp->aux.bodyInfo.contentLength - resp->bodyAlreadyRead);
+			}
+			do {
+				ret = splice(appFd, NULL, req->appResponseSplicePipe[1], NULL, max,
+					SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+			} while (OXT_UNLIKELY(ret == -1 && errno == EINTR));
+
+			if (ret > 0) {
+				resp->bodyAlreadyRead += ret;
+				req->appResponseSplicePipeBytes = ret;
+				SKC_TRACE(client, 3, "Spliced " << ret << " bytes of application data");
+			} else if (ret == 0 || errno == ECONNRESET) {
+				// EOF
+				UPDATE_TRACE_POINT();
+				stopSplicingAppResponse(req);
+				if (resp->httpState == AppResponse::PARSING_BODY_UNTIL_EOF) {
+					SKC_TRACE(client, 2, "Application sent EOF");
+					SKC_TRACE(client, 2, "Not keep-aliving application session connection");
+					req->session->close(true, false);
+					endRequest(&client, &req);
+				} else {
+					SKC_WARN(client, "Application sent EOF before finishing response body: " <<
+						resp->bodyAlreadyRead << " bytes already read, " <<
+						resp->aux.bodyInfo.contentLength << " bytes expected");
+					endRequestWithAppSocketIncompleteResponse(&client, &req);
+				}
+				return;
+			} else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+				waitForAppResponseSpliceEvent(req, appFd, EV_READ);
+				return;
+			} else if (errno == EINVAL || errno == ENOSYS) {
+				// Older kernels cannot splice from Unix domain sockets.
+				// The pipe is empty, so we can simply go back to
+				// forwarding through user space.
+				SKC_DEBUG(client, "The kernel does not support splicing from the "
+					"application socket; forwarding the response normally");
+				spliceSupported = false;
+				stopSplicingAppResponse(req);
+				req->appSource.start();
+				return;
+			} else {
+				e = errno;
+				stopSplicingAppResponse(req);
+				endRequestWithAppSocketReadError(&client, &req, e);
+				return;
+			}
+		}
+
+		waitForAppResponseSpliceEvent(req, clientFd, EV_WRITE);
+	#endif
+}
+
+void
+Controller::waitForAppResponseSpliceEvent(Request *req, int fd, int events) {
+	struct ev_io *watcher = &req->appResponseSpliceWatcher;
+	ev_io_stop(getLoop(), watcher);
+	ev_io_set(watcher, fd, events);
+	ev_io_start(getLoop(), watcher);
+}
+
+void
+Controller::stopSplicingAppResponse(Request *req) {
+	if (!req->splicingAppResponse) {
+		return;
+	}
+
+	ev_io_stop(getLoop(), &req->appResponseSpliceWatcher);
+	req->splicingAppResponse = false;
+	if (req->appResponseSplicePipeBytes == 0 && freeSplicePipes.size() < 16) {
+		freeSplicePipes.push_back(make_pair(req->appResponseSplicePipe[0],
+			req->appResponseSplicePipe[1]));
+	} else {
+		safelyClose(req->appResponseSplicePipe[0], true);
+		P_LOG_FILE_DESCRIPTOR_CLOSE(req->appResponseSplicePipe[0]);
+		safelyClose(req->appResponseSplicePipe[1], true);
+		P_LOG_FILE_DESCRIPTOR_CLOSE(req->appResponseSplicePipe[1]);
 	}
+	req->appResponseSplicePipe[0] = -1;
+	req->appResponseSplicePipe[1] = -1;
+	req->appResponseSplicePipeBytes = 0;
+}
+
+/**
+ * If response compression is enabled for the app group and the client
+ * accepts gzip, then text responses are gzip-compressed on the fly. Every
+ * piece of the body that we read from the app is compressed and written to
+ * the client right away, so memory usage does not depend on the body size.
+ *
+ * The compressed body size is not known in advance, so we send the
+ * compressed body with chunked transfer encoding. If the client does not
+ * support that, or if the web server in front of us wants a dechunked
+ * response, then the body ends when the connection is closed.
+ *
+ * The turbocache stores the compressed response, under a different key than
+ * the uncompressed variant of the same response (see ResponseCache).
+ */
+bool
+Controller::shouldCompressAppResponse(Client *client, Request *req) {
+	const AppResponse *resp = &req->appResponse;
+	const LString *value;
+
+	if (!req->responseCompressionAllowed
+	 || req->sendingFile
+	 || !resp->hasBody()
+	 || resp->upgraded()
+	 || resp->statusCode == 206
+	 || mainConfig.benchmarkMode == BM_RESPONSE_BEGIN)
+	{
+		return false;
+	}
+	if (resp->bodyType == AppResponse::RBT_CONTENT_LENGTH
+	 && resp->aux.bodyInfo.contentLength < mainConfig.responseCompressionMinSize)
+	{
+		return false;
+	}
+	if (resp->headers.lookup(HTTP_CONTENT_ENCODING) != NULL
+	 || resp->headers.lookup(HTTP_CONTENT_RANGE) != NULL)
+	{
+		// Already compressed, or only part of the body.
+		return false;
+	}
+
+	value = resp->headers.lookup(HTTP_CACHE_CONTROL);
+	if (value != NULL && value->size > 0) {
+		value = psg_lstr_make_contiguous(value, req->pool);
+		if (StaticString(value->start->data, value->size).find(
+			P_STATIC_STRING("no-transform")) != string::npos)
+		{
+			return false;
+		}
+	}
+
+	value = resp->headers.lookup(HTTP_CONTENT_TYPE);
+	if (value == NULL || value->size == 0) {
+		return false;
+	}
+	value = psg_lstr_make_contiguous(value, req->pool);
+	return ResponseCompressor::isCompressibleContentType(
+		StaticString(value->start->data, value->size));
+}
+
+void
+Controller::beginCompressingAppResponse(Client *client, Request *req) {
+	ResponseCompressor *compressor;
+
+	if (!freeResponseCompressors.empty()) {
+		compressor = freeResponseCompressors.back();
+		freeResponseCompressors.pop_back();
+		if (compressor->getLevel() != (int) mainConfig.responseCompressionLevel) {
+			compressor->reset(mainConfig.responseCompressionLevel);
+		}
+	} else {
+		try {
+			compressor = new ResponseCompressor(mainConfig.responseCompressionLevel);
+		} catch (const RuntimeException &e) {
+			SKC_WARN(client, "Cannot compress the application response: " << e.what());
+			return;
+		}
+	}
+
+	SKC_TRACE(client, 2, "Compressing the application response with gzip");
+	req->compressingResponse = true;
+	req->responseCompressor = compressor;
+	if (!compressedAppResponseIsChunked(req)) {
+		req->wantKeepAlive = false;
+	}
+}
+
+/**
+ * The compressed body is a different representation than the one that the
+ * app described in its response headers. A strong ETag promises byte-for-byte
+ * equality, so we weaken it: otherwise a client or cache could combine a
+ * range of one representation with the other, or get a 304 for the wrong
+ * one. And caches must know that the response depends on the request's
+ * Accept-Encoding, so we add that to the app's Vary header, if any.
+ */
+void
+Controller::prepareCompressedAppResponseHeaders(Request *req) {
+	AppResponse *resp = &req->appResponse;
+	ServerKit::Header *header;
+	const LString *value;
+
+	header = resp->headers.lookupHeader(HTTP_ETAG);
+	if (header != NULL && header->val.size > 0) {
+		value = psg_lstr_make_contiguous(&header->val, req->pool);
+		if (!startsWith(StaticString(value->start->data, value->size),
+			P_STATIC_STRING("W/")))
+		{
+			LString weakETag;
+			psg_lstr_init(&weakETag);
+			psg_lstr_append(&weakETag, req->pool, "W/", 2);
+			psg_lstr_move_and_append(&header->val, req->pool, &weakETag);
+			header->val = weakETag;
+		}
+	}
+
+	header = resp->headers.lookupHeader(HTTP_VARY);
+	if (header == NULL) {
+		resp->headers.insert(req->pool, "Vary", "Accept-Encoding");
+	} else if (header->val.size == 0) {
+		psg_lstr_append(&header->val, req->pool, "Accept-Encoding");
+	} else {
+		value = psg_lstr_make_contiguous(&header->val, req->pool);
+		if (!ResponseCompressor::varyCoversAcceptEncoding(
+			StaticString(value->start->data, value->size)))
+		{
+			psg_lstr_append(&header->val, req->pool, ", Accept-Encoding");
+		}
+	}
+}
+
+bool
+Controller::compressedAppResponseIsChunked(const Request *req) const {
+	unsigned int httpVersion = req->httpMajor * 1000 + req->httpMinor * 10;
+	return !req->dechunkResponse && httpVersion >= 1010;
+}
+
+/**
+ * Compresses the given piece of the app response body, and writes the
+ * compressed data (if zlib produced any) to the client as a single chunk.
+ * If `finish` is true, then the compressed body is ended.
+ */
+void
+Controller::writeCompressedResponse(Client *client, Request *req,
+	const MemoryKit::mbuf &buffer, bool finish)
+{
+	TRACE_POINT();
+	bool chunked = compressedAppResponseIsChunked(req);
+	ssize_t size;
+	int flush;
+
+	if (finish) {
+		flush = Z_FINISH;
+	} else if (req->appResponse.bodyType == AppResponse::RBT_CONTENT_LENGTH) {
+		// Let zlib decide when to output data, for a better compression ratio.
+		flush = Z_NO_FLUSH;
+	} else {
+		// The app may be streaming. Don't hold back anything that
+		// it has sent so far.
+		flush = Z_SYNC_FLUSH;
+	}
+
+	assert(compressedBuffers.empty());
+	size = req->responseCompressor->compress(&getContext()->mbuf_pool,
+		buffer.start, buffer.size(), flush, compressedBuffers);
+	if (OXT_UNLIKELY(size == -1)) {
+		compressedBuffers.clear();
+		disconnectWithError(&client, "error compressing the response body");
+		return;
+	}
+	totalBytesCompressed += buffer.size();
+	totalCompressedBytesSent += size;
+	SKC_TRACE(client, 3, "Compressed " << buffer.size() << " bytes of application data into "
+		<< size << " bytes");
+
+	if (size > 0 && chunked) {
+		MemoryKit::mbuf chunkHeader(MemoryKit::mbuf_get(&getContext()->small_mbuf_pool));
+		unsigned int chunkHeaderSize = integerToOtherBase<boost::uint64_t, 16>(
+			size, chunkHeader.start, chunkHeader.size() - 2);
+		chunkHeader.start[chunkHeaderSize++] = '\r';
+		chunkHeader.start[chunkHeaderSize++] = '\n';
+		writeResponse(client, MemoryKit::mbuf(chunkHeader, 0, chunkHeaderSize));
+	}
+	for (unsigned int i = 0; i < compressedBuffers.size() && !req->ended(); i++) {
+		writeResponse(client, compressedBuffers[i]);
+		markResponsePartForTurboCaching(client, req, compressedBuffers[i]);
+	}
+	compressedBuffers.clear();
+
+	if (chunked && !req->ended()) {
+		if (size > 0 && finish) {
+			writeResponse(client, P_STATIC_STRING("\r\n0\r\n\r\n"));
+		} else if (size > 0) {
+			writeResponse(client, P_STATIC_STRING("\r\n"));
+		} else if (finish) {
+			writeResponse(client, P_STATIC_STRING("0\r\n\r\n"));
+		}
+	}
+}
+
+void
+Controller::stopCompressingAppResponse(Request *req) {
+	if (!req->compressingResponse) {
+		return;
+	}
+
+	req->compressingResponse = false;
+	if (freeResponseCompressors.size() < 16) {
+		req->responseCompressor->reset(mainConfig.responseCompressionLevel);
+		freeResponseCompressors.push_back(req->responseCompressor);
+	} else {
+		delete req->responseCompressor;
+	}
+	req->responseCompressor = NULL;
 }
 
 void
 Controller::handleAppResponseBodyEnd(Client *client, Request *req) {
+	if (req->compressingResponse) {
+		writeCompressedResponse(client, req, MemoryKit::mbuf(), true);
+		if (req->ended()) {
+			return;
+		}
+	}
 	keepAliveAppConnection(client, req);
 	storeAppResponseInTurboCache(client, req);
 	assert(!req->ended());
@@ -1085,32 +1600,14 @@ Controller::storeAppResponseInTurboCache(Client *client, Request *req) {
 	if (turboCaching.isEnabled() && !req->cacheKey.empty()) {
 		TRACE_POINT();
 		AppResponse *resp = &req->appResponse;
-		unsigned int headerSize = 0;
-		unsigned int i;
-
-		for (i = 0; i < resp->nHeaderCacheBuffers; i++) {
-			headerSize += resp->headerCacheBuffers[i].iov_len;
-		}
 		ResponseCache<Request>::Entry entry(
 			turboCaching.responseCache.store(req, ev_now(getLoop()),
-				headerSize, resp->bodyCacheBuffer.size));
+				resp->headerCacheBuffers, resp->nHeaderCacheBuffers,
+				&resp->bodyCacheBuffer));
 		if (entry.valid()) {
 			UPDATE_TRACE_POINT();
-			SKC_DEBUG(client, "Storing app response in turbocache");
+			SKC_DEBUG(client, "Stored app response in turbocache");
 			SKC_TRACE(client, 2, "Turbocache entries:\n" << turboCaching.responseCache.inspect());
-
-			gatherBuffers(entry.body->httpHeaderData,
-				ResponseCache<Request>::MAX_HEADER_SIZE,
-				resp->headerCacheBuffers, resp->nHeaderCacheBuffers);
-
-			char *pos = entry.body->httpBodyData;
-			const char *end = entry.body->httpBodyData
-				+ ResponseCache<Request>::MAX_BODY_SIZE;
-			const LString::Part *part = resp->bodyCacheBuffer.start;
-			while (part != NULL) {
-				pos = appendData(pos, end, part->data, part->size);
-				part = part->next;
-			}
 		} else {
 			SKC_DEBUG(client, "Could not store app response for turbocaching");
 		}
@@ -60,18 +60,20 @@ Controller::onBodyBufferData(Channel *_channel, const MemoryKit::mbuf &buffer, i
 	return self->whenSendingRequest_onRequestBody(client, req, buffer, errcode);
 }
 
-#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
-	void
-	Controller::onEventLoopPrepare(EV_P_ struct ev_prepare *w, int revents) {
-		Controller *self = static_cast<Controller *>(w->data);
+void
+Controller::onEventLoopPrepare(EV_P_ struct ev_prepare *w, int revents) {
+	Controller *self = static_cast<Controller *>(w->data);
+	self->turboCaching.threadOffline();
+	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
 		ev_now_update(EV_A);
 		self->timeBeforeBlocking = ev_now(EV_A);
-	}
-#endif
+	#endif
+}
 
 void
 Controller::onEventLoopCheck(EV_P_ struct ev_check *w, int revents) {
 	Controller *self = static_cast<Controller *>(w->data);
+	self->turboCaching.threadOnline();
 	self->turboCaching.updateState(ev_now(EV_A));
 	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
 		self->reportLargeTimeDiff(NULL, "Event loop slept",
@@ -107,6 +109,15 @@ Controller::onRequestObjectCreated(Client *client, Request *req) {
 	req->bodyBuffer.setContext(getContext());
 	req->bodyBuffer.setHooks(&req->hooks);
 	req->bodyBuffer.setDataCallback(onBodyBufferData);
+
+	ev_io_init(&req->appConnectWatcher, onAppConnectWritable, -1, EV_WRITE);
+	req->appConnectWatcher.data = req;
+	ev_timer_init(&req->appConnectTimer, onAppConnectTimer, 0, 0);
+	req->appConnectTimer.data = req;
+	ev_io_init(&req->appResponseSpliceWatcher, onAppResponseSpliceEvent, -1, EV_READ);
+	req->appResponseSpliceWatcher.data = req;
+	ev_io_init(&req->sendFileWatcher, onSendFileWritable, -1, EV_WRITE);
+	req->sendFileWatcher.data = req;
 }
 
 void
@@ -134,9 +145,27 @@ Controller::reinitializeRequest(Client *client, Request *req) {
 	req->appResponseInitialized = false;
 	req->strip100ContinueHeader = false;
 	req->hasPragmaHeader = false;
+	req->configHandleRegistered = false;
+	req->splicingAppResponse = false;
+	req->sendingFile = false;
+	req->responseCompressionAllowed = false;
+	req->compressingResponse = false;
 	req->host = NULL;
 	req->config = requestConfig;
 	req->bodyBytesBuffered = 0;
+	req->appConnectDeadline = 0;
+	req->appResponseSplicePipe[0] = -1;
+	req->appResponseSplicePipe[1] = -1;
+	req->appResponseSplicePipeBytes = 0;
+	req->sendFileOffset = 0;
+	req->sendFileRemaining = 0;
+	req->responseCompressor = NULL;
+	req->checkoutBeganAt = 0;
+	req->sessionCheckedOutAt = 0;
+	req->sessionInitiatedAt = 0;
+	req->headerSentToAppAt = 0;
+	req->appResponseBegunAt = 0;
+	req->pendingLatencyStats.reset();
 	req->cacheKey = HashedStaticString();
 	req->cacheControl = NULL;
 	req->varyCookie = NULL;
@@ -154,6 +183,13 @@ Controller::reinitializeRequest(Client *client, Request *req) {
 
 void
 Controller::deinitializeRequest(Client *client, Request *req) {
+	if (req->checkoutBeganAt != 0 && req->pendingLatencyStats == NULL) {
+		recordLatencyStats(req);
+	}
+	stopConnectingToApp(req);
+	stopSplicingAppResponse(req);
+	stopSendingFile(req);
+	stopCompressingAppResponse(req);
 	req->session.reset();
 	req->config.reset();
 
@@ -173,6 +209,13 @@ Controller::deinitializeRequest(Client *client, Request *req) {
 	ParentClass::deinitializeRequest(client, req);
 }
 
+void
+Controller::onRequestOutputFlushed(Client *client, Request *req) {
+	if (req->pendingLatencyStats != NULL) {
+		recordResponseOutputLatency(req);
+	}
+}
+
 void
 Controller::reinitializeAppResponse(Client *client, Request *req) {
 	AppResponse *resp = &req->appResponse;
@@ -52,6 +52,145 @@ struct Controller::RequestAnalysis {
 };
 
 
+/**
+ * Web server modules may register a location's option headers once under a
+ * "config handle" (by sending `!~PASSENGER_REGISTER_CONFIG_HANDLE` along with
+ * the option headers), and from then on send just the handle
+ * (`!~PASSENGER_CONFIG_HANDLE`) instead of the option headers. This method
+ * handles both cases: when given a handle, it inserts the registered option
+ * headers into the request's secure headers, as if the web server had sent
+ * them.
+ *
+ * If the handle is unknown (e.g. because the Core was restarted) then we
+ * respond with a 503 and an `X-Passenger-Config-Handle: retry` header
+ * without having processed the request. This tells the module to resend
+ * the request, this time with the option headers, so that the client
+ * never sees this response.
+ *
+ * Returns false if the request was ended.
+ */
+bool
+Controller::applyConfigHandle(Client *client, Request *req) {
+	const LString *handle = req->secureHeaders.lookup(PASSENGER_REGISTER_CONFIG_HANDLE);
+	if (handle != NULL) {
+		registerConfigHandle(client, req, handle);
+		return true;
+	}
+
+	handle = req->secureHeaders.lookup(PASSENGER_CONFIG_HANDLE);
+	if (handle == NULL) {
+		return true;
+	}
+
+	handle = psg_lstr_make_contiguous(handle, req->pool);
+	HashedStaticString hHandle(handle->start != NULL ? handle->start->data : "",
+		handle->size);
+	const ConfigHandleRegistry::Entry **cachedEntry;
+	const ConfigHandleRegistry::Entry *entry = NULL;
+
+	if (configHandleCache.lookup(hHandle, &cachedEntry)) {
+		entry = *cachedEntry;
+	} else if (configHandleRegistry != NULL && !hHandle.empty()) {
+		entry = configHandleRegistry->lookup(hHandle);
+		if (entry != NULL) {
+			configHandleCache.insert(hHandle, entry);
+		}
+	}
+
+	if (entry != NULL) {
+		insertConfigHandleHeaders(req, entry);
+		return true;
+	} else {
+		ServerKit::HeaderTable headers;
+
+		SKC_NOTICE(client, "Unknown config handle \"" << cEscapeString(hHandle)
+			<< "\", asking the web server to resend the request with its options");
+		headers.insert(req->pool, "cache-control", "no-cache, no-store, must-revalidate");
+		headers.insert(req->pool, "X-Passenger-Config-Handle", "retry");
+		writeSimpleResponse(client, 503, &headers,
+			"<h2>Unknown configuration handle</h2>");
+		endRequest(&client, &req);
+		return false;
+	}
+}
+
+void
+Controller::registerConfigHandle(Client *client, Request *req, const LString *handle) {
+	if (configHandleRegistry == NULL) {
+		return;
+	}
+
+	handle = psg_lstr_make_contiguous(handle, req->pool);
+	if (handle->size == 0) {
+		return;
+	}
+
+	ConfigHandleRegistry::HeaderList headers;
+	ServerKit::HeaderTable::ConstIterator it(req->secureHeaders);
+	HashedStaticString hHandle(handle->start->data, handle->size);
+	const ConfigHandleRegistry::Entry *entry;
+
+	while (*it != NULL) {
+		const ServerKit::Header *header = it->header;
+		if (psg_lstr_cmp(&header->key, P_STATIC_STRING("!~PASSENGER_"),
+				sizeof("!~PASSENGER_") - 1)
+		 && !psg_lstr_cmp(&header->key, PASSENGER_REGISTER_CONFIG_HANDLE)
+		 && !psg_lstr_cmp(&header->key, PASSENGER_CONFIG_HANDLE))
+		{
+			const LString *key = psg_lstr_make_contiguous(&header->key, req->pool);
+			const LString *val = psg_lstr_make_contiguous(&header->val, req->pool);
+			headers.push_back(make_pair(
+				StaticString(key->start->data, key->size),
+				val->size > 0
+					? StaticString(val->start->data, val->size)
+					: StaticString()));
+		}
+		it.next();
+	}
+
+	entry = configHandleRegistry->add(hHandle, headers);
+	if (entry != NULL) {
+		configHandleCache.insert(hHandle, entry);
+		req->configHandleRegistered = true;
+		SKC_TRACE(client, 2, "Registered config handle \""
+			<< cEscapeString(hHandle) << "\"");
+	} else {
+		SKC_DEBUG(client, "Cannot register config handle \""
+			<< cEscapeString(hHandle) << "\": the registry is full");
+	}
+}
+
+/**
+ * Inserts the option headers registered under a config handle into the
+ * request's secure headers, except for those that the request already
+ * carries (e.g. `!~PASSENGER_APP_GROUP_NAME` when it is not configured
+ * explicitly, in which case the web server module sends it with every
+ * request). The inserted headers point to the registry's memory instead
+ * of being copied; this is safe because registry entries are never freed.
+ */
+void
+Controller::insertConfigHandleHeaders(Request *req, const ConfigHandleRegistry::Entry *entry) {
+	vector<ConfigHandleRegistry::Header>::const_iterator it, end = entry->headers.end();
+
+	for (it = entry->headers.begin(); it != end; it++) {
+		HashedStaticString name(it->name.data(), it->name.size(), it->hash);
+		if (req->secureHeaders.lookupCell(name) != NULL) {
+			continue;
+		}
+
+		ServerKit::Header *header = (ServerKit::Header *) psg_palloc(req->pool,
+			sizeof(ServerKit::Header));
+		psg_lstr_init(&header->key);
+		psg_lstr_append(&header->key, req->pool, it->name.data(), it->name.size());
+		psg_lstr_init(&header->origKey);
+		psg_lstr_append(&header->origKey, req->pool, it->name.data(), it->name.size());
+		psg_lstr_init(&header->val);
+		psg_lstr_append(&header->val, req->pool, it->value.data(), it->value.size());
+		header->hash = it->hash;
+		req->secureHeaders.insert(&header, req->pool);
+	}
+}
+
 void
 Controller::initializeFlags(Client *client, Request *req, RequestAnalysis &analysis) {
 	if (analysis.flags != NULL) {
@@ -194,6 +333,7 @@ Controller::fillPoolOptionsFromConfigCaches(Options &options,
 	options.minProcesses = requestConfig->defaultMinInstances;
 	options.maxPreloaderIdleTime = requestConfig->defaultMaxPreloaderIdleTime;
 	options.maxRequestQueueSize = requestConfig->defaultMaxRequestQueueSize;
+	options.spawnConcurrency = requestConfig->defaultSpawnConcurrency;
 	options.abortWebsocketsOnProcessShutdown = requestConfig->defaultAbortWebsocketsOnProcessShutdown;
 	options.forceMaxConcurrentRequestsPerProcess = requestConfig->defaultForceMaxConcurrentRequestsPerProcess;
 	options.environment = requestConfig->defaultEnvironment;
@@ -363,6 +503,7 @@ Controller::createNewPoolOptions(Client *client, Request *req,
 	fillPoolOptionSecToMsec(req, options.startTimeout, "!~PASSENGER_START_TIMEOUT");
 	fillPoolOption(req, options.maxPreloaderIdleTime, "!~PASSENGER_MAX_PRELOADER_IDLE_TIME");
 	fillPoolOption(req, options.maxRequestQueueSize, "!~PASSENGER_MAX_REQUEST_QUEUE_SIZE");
+	fillPoolOption(req, options.spawnConcurrency, "!~PASSENGER_SPAWN_CONCURRENCY");
 	fillPoolOption(req, options.abortWebsocketsOnProcessShutdown, "!~PASSENGER_ABORT_WEBSOCKETS_ON_PROCESS_SHUTDOWN");
 	fillPoolOption(req, options.forceMaxConcurrentRequestsPerProcess, "!~PASSENGER_FORCE_MAX_CONCURRENT_REQUESTS_PER_PROCESS");
 	fillPoolOption(req, options.restartDir, "!~PASSENGER_RESTART_DIR");
@@ -434,6 +575,10 @@ Controller::onRequestBegin(Client *client, Request *req) {
 
 	CC_BENCHMARK_POINT(client, req, BM_AFTER_ACCEPT);
 
+	if (!applyConfigHandle(client, req)) {
+		return;
+	}
+
 	{
 		// Perform hash table operations as close to header parsing as possible,
 		// and localize them as much as possible, for better CPU caching.
@@ -444,6 +589,16 @@ Controller::onRequestBegin(Client *client, Request *req) {
 			: req->secureHeaders.lookupCell(PASSENGER_APP_GROUP_NAME);
 		req->stickySession = getBoolOption(req, PASSENGER_STICKY_SESSIONS,
 			mainConfig.defaultStickySessions);
+		if (getBoolOption(req, PASSENGER_RESPONSE_COMPRESSION,
+			mainConfig.defaultResponseCompression))
+		{
+			const LString *acceptEncoding = req->headers.lookup(HTTP_ACCEPT_ENCODING);
+			if (acceptEncoding != NULL && acceptEncoding->size > 0) {
+				acceptEncoding = psg_lstr_make_contiguous(acceptEncoding, req->pool);
+				req->responseCompressionAllowed = ResponseCompressor::acceptsGzip(
+					StaticString(acceptEncoding->start->data, acceptEncoding->size));
+			}
+		}
 		req->host = req->headers.lookup(HTTP_HOST);
 
 		/***************/
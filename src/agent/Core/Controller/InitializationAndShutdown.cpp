@@ -46,7 +46,20 @@ using namespace boost;
 
 Controller::~Controller() {
 	ev_check_stop(getLoop(), &checkWatcher);
+	ev_prepare_stop(getLoop(), &prepareWatcher);
 	delete singleAppModeConfig;
+
+	while (!freeSplicePipes.empty()) {
+		safelyClose(freeSplicePipes.back().first, true);
+		P_LOG_FILE_DESCRIPTOR_CLOSE(freeSplicePipes.back().first);
+		safelyClose(freeSplicePipes.back().second, true);
+		P_LOG_FILE_DESCRIPTOR_CLOSE(freeSplicePipes.back().second);
+		freeSplicePipes.pop_back();
+	}
+	while (!freeResponseCompressors.empty()) {
+		delete freeResponseCompressors.back();
+		freeResponseCompressors.pop_back();
+	}
 }
 
 void
@@ -56,20 +69,22 @@ Controller::preinitialize() {
 	ev_check_start(getLoop(), &checkWatcher);
 	checkWatcher.data = this;
 
+	ev_prepare_init(&prepareWatcher, onEventLoopPrepare);
+	prepareWatcher.data = this;
 	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
-		ev_prepare_init(&prepareWatcher, onEventLoopPrepare);
 		ev_prepare_start(getLoop(), &prepareWatcher);
-		prepareWatcher.data = this;
-
 		timeBeforeBlocking = 0;
 	#endif
 
 	PASSENGER_APP_GROUP_NAME = "!~PASSENGER_APP_GROUP_NAME";
+	PASSENGER_CONFIG_HANDLE = "!~PASSENGER_CONFIG_HANDLE";
+	PASSENGER_REGISTER_CONFIG_HANDLE = "!~PASSENGER_REGISTER_CONFIG_HANDLE";
 	PASSENGER_ENV_VARS = "!~PASSENGER_ENV_VARS";
 	PASSENGER_MAX_REQUESTS = "!~PASSENGER_MAX_REQUESTS";
 	PASSENGER_SHOW_VERSION_IN_HEADER = "!~PASSENGER_SHOW_VERSION_IN_HEADER";
 	PASSENGER_STICKY_SESSIONS = "!~PASSENGER_STICKY_SESSIONS";
 	PASSENGER_STICKY_SESSIONS_COOKIE_NAME = "!~PASSENGER_STICKY_SESSIONS_COOKIE_NAME";
+	PASSENGER_RESPONSE_COMPRESSION = "!~PASSENGER_RESPONSE_COMPRESSION";
 	PASSENGER_REQUEST_OOB_WORK = "!~Request-OOB-Work";
 	REMOTE_ADDR = "!~REMOTE_ADDR";
 	REMOTE_PORT = "!~REMOTE_PORT";
@@ -84,6 +99,15 @@ Controller::preinitialize() {
 	HTTP_CONNECTION = "connection";
 	HTTP_STATUS = "status";
 	HTTP_TRANSFER_ENCODING = "transfer-encoding";
+	HTTP_RANGE = "range";
+	HTTP_IF_RANGE = "if-range";
+	HTTP_CONTENT_RANGE = "content-range";
+	HTTP_ACCEPT_RANGES = "accept-ranges";
+	HTTP_ACCEPT_ENCODING = "accept-encoding";
+	HTTP_CONTENT_ENCODING = "content-encoding";
+	HTTP_CACHE_CONTROL = "cache-control";
+	HTTP_ETAG = "etag";
+	HTTP_VARY = "vary";
 
 	/**************************/
 }
@@ -99,7 +123,16 @@ Controller::initialize() {
 	}
 
 	ParentClass::initialize();
-	turboCaching.initialize(config["turbocaching"].asBool());
+	turboCaching.initialize(config["turbocaching"].asBool(),
+		config["turbocache_max_entries"].asUInt(),
+		config["turbocache_max_memory"].asUInt(),
+		config["turbocache_max_body_size"].asUInt());
+	if (sharedTurboCache != NULL) {
+		turboCaching.setSharedCache(sharedTurboCache, getThreadNumber() - 1);
+		if (!ev_is_active(&prepareWatcher)) {
+			ev_prepare_start(getLoop(), &prepareWatcher);
+		}
+	}
 
 	if (mainConfig.singleAppMode) {
 		boost::shared_ptr<Options> options = boost::make_shared<Options>();
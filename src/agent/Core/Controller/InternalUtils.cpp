@@ -201,6 +201,64 @@ Controller::gatherBuffers(char * restrict dest, unsigned int size,
 	}
 }
 
+static void
+recordStageLatency(LatencyHistogram &histogram, MonotonicTimeUsec begin,
+	MonotonicTimeUsec end)
+{
+	if (begin != 0 && end != 0) {
+		histogram.record(end - begin);
+	}
+}
+
+/**
+ * Called when a request that went to the application pool ends. Records
+ * the durations of all stages that the request went through, except for
+ * the stages that end when the response has been flushed to the client:
+ * those are recorded by `recordResponseOutputLatency()`.
+ */
+void
+Controller::recordLatencyStats(Request *req) {
+	HashedStaticString appGroupName(req->options.getAppGroupName());
+	boost::shared_ptr<RequestLatencyStats> *stats;
+
+	if (appGroupName.empty()
+	 || appGroupName.size() > latencyStats.MAX_KEY_LENGTH)
+	{
+		return;
+	}
+	if (!latencyStats.lookup(appGroupName, &stats)) {
+		stats = &latencyStats.insert(appGroupName,
+			boost::make_shared<RequestLatencyStats>())->value;
+	}
+
+	RequestLatencyStats &s = **stats;
+	recordStageLatency(s.checkoutWait, req->checkoutBeganAt, req->sessionCheckedOutAt);
+	recordStageLatency(s.appConnect, req->sessionCheckedOutAt, req->sessionInitiatedAt);
+	recordStageLatency(s.sendHeader, req->sessionInitiatedAt, req->headerSentToAppAt);
+	recordStageLatency(s.appProcessing, req->headerSentToAppAt, req->appResponseBegunAt);
+	if (req->appResponseBegunAt != 0) {
+		req->pendingLatencyStats = *stats;
+	} else {
+		// deinitializeRequest() may be called again if the client
+		// disconnects; don't record the same request twice.
+		req->checkoutBeganAt = 0;
+	}
+}
+
+/**
+ * Called when the response of a request, whose other stages were recorded
+ * by `recordLatencyStats()`, has been flushed to the client.
+ */
+void
+Controller::recordResponseOutputLatency(Request *req) {
+	RequestLatencyStats &s = *req->pendingLatencyStats;
+	MonotonicTimeUsec now = SystemTime::getMonotonicUsec();
+	recordStageLatency(s.responseOutput, req->appResponseBegunAt, now);
+	recordStageLatency(s.total, req->checkoutBeganAt, now);
+	req->pendingLatencyStats.reset();
+	req->checkoutBeganAt = 0;
+}
+
 // `path` MUST be NULL-terminated. Returns a contiguous LString.
 LString *
 Controller::resolveSymlink(const StaticString &path, psg_pool_t *pool) {
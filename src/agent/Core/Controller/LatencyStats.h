@@ -0,0 +1,97 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_CORE_CONTROLLER_LATENCY_STATS_H_
+#define _PASSENGER_CORE_CONTROLLER_LATENCY_STATS_H_
+
+#include <map>
+#include <string>
+#include <jsoncpp/json.h>
+#include <Utils/LatencyHistogram.h>
+
+namespace Passenger {
+namespace Core {
+
+using namespace std;
+
+
+/**
+ * Breaks down the time that the Controller spends on requests for a single
+ * application group into the stages that a request goes through. All
+ * durations are in microseconds:
+ *
+ *  - checkoutWait: from the first checkoutSession() call until a session
+ *    was checked out from the pool. This includes the time spent on the
+ *    group's wait list and on any retries.
+ *  - appConnect: until the session was initiated, i.e. until the connection
+ *    with the application process was established.
+ *  - sendHeader: until the request header was handed to the application
+ *    socket.
+ *  - appProcessing: until the application began sending its response.
+ *  - responseOutput: until the entire response was flushed to the client.
+ *    Not recorded if the client disconnects before that.
+ *  - total: from the first checkoutSession() call until the response was
+ *    flushed to the client.
+ *
+ * Each Controller (and thus each thread) has its own instance per app group,
+ * so recording requires no locking.
+ */
+struct RequestLatencyStats {
+	LatencyHistogram checkoutWait;
+	LatencyHistogram appConnect;
+	LatencyHistogram sendHeader;
+	LatencyHistogram appProcessing;
+	LatencyHistogram responseOutput;
+	LatencyHistogram total;
+
+	void merge(const RequestLatencyStats &other) {
+		checkoutWait.merge(other.checkoutWait);
+		appConnect.merge(other.appConnect);
+		sendHeader.merge(other.sendHeader);
+		appProcessing.merge(other.appProcessing);
+		responseOutput.merge(other.responseOutput);
+		total.merge(other.total);
+	}
+
+	Json::Value inspectAsJson() const {
+		Json::Value doc;
+		doc["checkout_wait"] = checkoutWait.inspectAsJson();
+		doc["app_connect"] = appConnect.inspectAsJson();
+		doc["send_header"] = sendHeader.inspectAsJson();
+		doc["app_processing"] = appProcessing.inspectAsJson();
+		doc["response_output"] = responseOutput.inspectAsJson();
+		doc["total"] = total.inspectAsJson();
+		return doc;
+	}
+};
+
+/** Maps app group names to their latency statistics. */
+typedef std::map<string, RequestLatencyStats> RequestLatencyStatsMap;
+
+
+} // namespace Core
+} // namespace Passenger
+
+#endif /* _PASSENGER_CORE_CONTROLLER_LATENCY_STATS_H_ */
@@ -34,9 +34,12 @@
 #include <ServerKit/FdSinkChannel.h>
 #include <ServerKit/FdSourceChannel.h>
 #include <LoggingKit/LoggingKit.h>
+#include <FileDescriptor.h>
+#include <Utils/SystemTime.h>
 #include <Core/ApplicationPool/Pool.h>
 #include <Core/Controller/Config.h>
 #include <Core/Controller/AppResponse.h>
+#include <Core/Controller/LatencyStats.h>
 
 namespace Passenger {
 namespace Core {
@@ -45,6 +48,8 @@ using namespace std;
 using namespace boost;
 using namespace ApplicationPool2;
 
+class ResponseCompressor;
+
 
 class Request: public ServerKit::BaseHttpRequest {
 public:
@@ -52,6 +57,7 @@ public:
 		ANALYZING_REQUEST,
 		BUFFERING_REQUEST_BODY,
 		CHECKING_OUT_SESSION,
+		CONNECTING_TO_APP,
 		SENDING_HEADER_TO_APP,
 		FORWARDING_BODY_TO_APP,
 		WAITING_FOR_APP_OUTPUT
@@ -78,19 +84,80 @@ public:
 	bool appResponseInitialized: 1;
 	bool strip100ContinueHeader: 1;
 	bool hasPragmaHeader: 1;
+	/** Whether this request registered a config handle with ConfigHandleRegistry. */
+	bool configHandleRegistered: 1;
+	/** Whether the app response body is being forwarded with splice(). */
+	bool splicingAppResponse: 1;
+	/**
+	 * Whether the response body is a file that we send ourselves, because
+	 * the app responded with X-Sendfile or X-Accel-Redirect.
+	 */
+	bool sendingFile: 1;
+	/**
+	 * Whether the response may be gzip-compressed: compression is enabled
+	 * for the app group, and the client accepts gzip. Compressed and
+	 * uncompressed responses are turbocached under different keys.
+	 */
+	bool responseCompressionAllowed: 1;
+	/** Whether the app response body is being compressed by `responseCompressor`. */
+	bool compressingResponse: 1;
 
 	Options options;
 	AbstractSessionPtr session;
 	const LString *host;
 	ControllerRequestConfigPtr config;
 
+	// Used in the CONNECTING_TO_APP state.
+	struct ev_io appConnectWatcher;
+	struct ev_timer appConnectTimer;
+	ev_tstamp appConnectDeadline;
+
 	ServerKit::FdSinkChannel appSink;
 	ServerKit::FdSourceChannel appSource;
 	AppResponse appResponse;
 
+	/**
+	 * Used instead of `appSource` and `client->output` while the app
+	 * response body is forwarded with splice(). See ForwardResponse.cpp.
+	 * The pipe is only valid while `splicingAppResponse` is true.
+	 */
+	struct ev_io appResponseSpliceWatcher;
+	int appResponseSplicePipe[2];
+	unsigned int appResponseSplicePipeBytes;
+
+	/**
+	 * Used while `sendingFile` is true. The file is written to the client
+	 * socket with sendfile(), so `client->output` is not used for the
+	 * response body. See SendFile.cpp.
+	 */
+	struct ev_io sendFileWatcher;
+	FileDescriptor sendFileFd;
+	boost::uint64_t sendFileOffset;
+	boost::uint64_t sendFileRemaining;
+
+	/** Only set while `compressingResponse` is true. See ForwardResponse.cpp. */
+	ResponseCompressor *responseCompressor;
+
 	ServerKit::FileBufferedChannel bodyBuffer;
 	boost::uint64_t bodyBytesBuffered; // After dechunking
 
+	/**
+	 * Monotonic timestamps (SystemTime::getMonotonicUsec()) of the moments
+	 * at which this request reached the stages that are tracked by
+	 * RequestLatencyStats. 0 means that the stage has not been reached.
+	 */
+	MonotonicTimeUsec checkoutBeganAt;
+	MonotonicTimeUsec sessionCheckedOutAt;
+	MonotonicTimeUsec sessionInitiatedAt;
+	MonotonicTimeUsec headerSentToAppAt;
+	MonotonicTimeUsec appResponseBegunAt;
+	/**
+	 * Set when the request has ended but its response is still being
+	 * flushed to the client. The `responseOutput` and `total` stages are
+	 * recorded into these statistics once that is done.
+	 */
+	boost::shared_ptr<RequestLatencyStats> pendingLatencyStats;
+
 	HashedStaticString cacheKey;
 	LString *cacheControl;
 	LString *varyCookie;
@@ -122,6 +189,8 @@ public:
 			return "BUFFERING_REQUEST_BODY";
 		case CHECKING_OUT_SESSION:
 			return "CHECKING_OUT_SESSION";
+		case CONNECTING_TO_APP:
+			return "CONNECTING_TO_APP";
 		case SENDING_HEADER_TO_APP:
 			return "SENDING_HEADER_TO_APP";
 		case FORWARDING_BODY_TO_APP:
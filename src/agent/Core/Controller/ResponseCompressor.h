@@ -0,0 +1,320 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_CORE_CONTROLLER_RESPONSE_COMPRESSOR_H_
+#define _PASSENGER_CORE_CONTROLLER_RESPONSE_COMPRESSOR_H_
+
+#include <algorithm>
+#include <vector>
+#include <cstring>
+#include <strings.h>
+#include <sys/types.h>
+#include <zlib.h>
+#include <boost/cstdint.hpp>
+#include <StaticString.h>
+#include <Exceptions.h>
+#include <MemoryKit/mbuf.h>
+#include <Utils/StrIntUtils.h>
+
+namespace Passenger {
+namespace Core {
+
+using namespace std;
+
+
+/**
+ * Gzip-compresses a response body incrementally. Every `compress()` call
+ * compresses one piece of the body, typically a single mbuf that was read
+ * from the application, into mbufs. The body is never buffered in its
+ * entirety: zlib only keeps its sliding window and whatever it has not
+ * flushed yet.
+ *
+ * Initializing a zlib stream allocates about 256 KB, so the Controller
+ * keeps a few ResponseCompressors around and reuses them with `reset()`.
+ */
+class ResponseCompressor {
+private:
+	z_stream stream;
+	int level;
+	/**
+	 * The unused remainder of the mbuf that we last compressed into.
+	 * Subsequent output is appended to the same mbuf_block, so that small
+	 * pieces of compressed data don't each occupy an entire block.
+	 */
+	MemoryKit::mbuf spare;
+
+	static StaticString trim(const StaticString &str) {
+		const char *begin = str.data();
+		const char *end = str.data() + str.size();
+		while (begin < end && (*begin == ' ' || *begin == '\t')) {
+			begin++;
+		}
+		while (end > begin && (end[-1] == ' ' || end[-1] == '\t')) {
+			end--;
+		}
+		return StaticString(begin, end - begin);
+	}
+
+	static bool equalsIgnoringCase(const StaticString &str, const StaticString &other) {
+		return str.size() == other.size()
+			&& strncasecmp(str.data(), other.data(), str.size()) == 0;
+	}
+
+	static bool startsWithIgnoringCase(const StaticString &str, const StaticString &prefix) {
+		return str.size() >= prefix.size()
+			&& strncasecmp(str.data(), prefix.data(), prefix.size()) == 0;
+	}
+
+	static bool endsWithIgnoringCase(const StaticString &str, const StaticString &suffix) {
+		return str.size() >= suffix.size()
+			&& strncasecmp(str.data() + str.size() - suffix.size(),
+				suffix.data(), suffix.size()) == 0;
+	}
+
+	/**
+	 * Given the parameters of an Accept-Encoding item (e.g. "; q=0.5"),
+	 * returns whether they contain a qvalue of 0, which means "not acceptable".
+	 */
+	static bool qvalueIsZero(const StaticString &params) {
+		const char *pos = params.data();
+		const char *end = params.data() + params.size();
+
+		while (pos < end) {
+			const char *paramEnd = (const char *) memchr(pos, ';', end - pos);
+			if (paramEnd == NULL) {
+				paramEnd = end;
+			}
+
+			StaticString param = trim(StaticString(pos, paramEnd - pos));
+			if (param.size() >= 2 && (param[0] == 'q' || param[0] == 'Q') && param[1] == '=') {
+				StaticString value = trim(param.substr(2));
+				if (value.empty() || value[0] != '0') {
+					return false;
+				}
+				for (string::size_type i = 1; i < value.size(); i++) {
+					if (value[i] != '.' && value[i] != '0') {
+						return false;
+					}
+				}
+				return true;
+			}
+
+			pos = paramEnd + 1;
+		}
+		return false;
+	}
+
+public:
+	ResponseCompressor(int _level)
+		: level(_level)
+	{
+		memset(&stream, 0, sizeof(stream));
+		// A window size of 15 + 16 means: the maximum window size,
+		// with a gzip header and trailer instead of a zlib one.
+		int ret = deflateInit2(&stream, level, Z_DEFLATED, 15 + 16, 8,
+			Z_DEFAULT_STRATEGY);
+		if (ret != Z_OK) {
+			throw RuntimeException("Cannot initialize a zlib compression stream (error "
+				+ toString(ret) + ")");
+		}
+	}
+
+	~ResponseCompressor() {
+		deflateEnd(&stream);
+	}
+
+	/**
+	 * Prepares this compressor for compressing a new response body.
+	 */
+	void reset(int newLevel) {
+		deflateReset(&stream);
+		if (newLevel != level) {
+			deflateParams(&stream, newLevel, Z_DEFAULT_STRATEGY);
+			level = newLevel;
+		}
+		spare = MemoryKit::mbuf();
+	}
+
+	int getLevel() const {
+		return level;
+	}
+
+	/** The number of uncompressed bytes fed since the last `reset()`. */
+	boost::uint64_t getBytesIn() const {
+		return stream.total_in;
+	}
+
+	/** The number of compressed bytes produced since the last `reset()`. */
+	boost::uint64_t getBytesOut() const {
+		return stream.total_out;
+	}
+
+	/**
+	 * Compresses `size` bytes at `data`, and appends the compressed data
+	 * that zlib produces to `output`, in mbufs allocated from `pool`.
+	 *
+	 * `flush` is a zlib flush mode. Z_NO_FLUSH allows zlib to hold back
+	 * output in order to compress better. Z_SYNC_FLUSH makes zlib output
+	 * everything that was fed so far, so that the client can decompress
+	 * it immediately. Z_FINISH ends the gzip stream.
+	 *
+	 * Returns the number of bytes appended to `output`, or -1 if zlib
+	 * reported an error.
+	 */
+	ssize_t compress(MemoryKit::mbuf_pool *pool, const char *data, size_t size,
+		int flush, vector<MemoryKit::mbuf> &output)
+	{
+		ssize_t total = 0;
+		int ret;
+
+		stream.next_in = (Bytef *) data;
+		stream.avail_in = size;
+
+		do {
+			if (spare.empty()) {
+				spare = MemoryKit::mbuf_get(pool);
+			}
+			stream.next_out = (Bytef *) spare.start;
+			stream.avail_out = spare.size();
+
+			ret = deflate(&stream, flush);
+			if (ret == Z_STREAM_ERROR) {
+				return -1;
+			}
+
+			unsigned int produced = spare.size() - stream.avail_out;
+			if (produced > 0) {
+				output.push_back(MemoryKit::mbuf(spare, 0, produced));
+				spare = MemoryKit::mbuf(spare, produced);
+				total += produced;
+			}
+			// If zlib filled the entire output buffer, then it may
+			// have more output.
+		} while (stream.avail_out == 0 && ret != Z_STREAM_END);
+
+		return total;
+	}
+
+	/**
+	 * Returns whether an Accept-Encoding header value allows a gzip-encoded
+	 * response: it lists "gzip", "x-gzip" or "*", and does not assign that
+	 * item a qvalue of 0.
+	 */
+	static bool acceptsGzip(const StaticString &acceptEncoding) {
+		const char *pos = acceptEncoding.data();
+		const char *end = acceptEncoding.data() + acceptEncoding.size();
+		// -1: not listed, 0: explicitly not acceptable, 1: acceptable
+		int gzip = -1, wildcard = -1;
+
+		while (pos < end) {
+			const char *itemEnd = (const char *) memchr(pos, ',', end - pos);
+			if (itemEnd == NULL) {
+				itemEnd = end;
+			}
+			const char *paramsBegin = (const char *) memchr(pos, ';', itemEnd - pos);
+			if (paramsBegin == NULL) {
+				paramsBegin = itemEnd;
+			}
+
+			StaticString coding = trim(StaticString(pos, paramsBegin - pos));
+			int acceptable = qvalueIsZero(StaticString(paramsBegin,
+				itemEnd - paramsBegin)) ? 0 : 1;
+			if (equalsIgnoringCase(coding, P_STATIC_STRING("gzip"))
+			 || equalsIgnoringCase(coding, P_STATIC_STRING("x-gzip")))
+			{
+				gzip = std::max(gzip, acceptable);
+			} else if (coding == P_STATIC_STRING("*")) {
+				wildcard = acceptable;
+			}
+
+			pos = itemEnd + 1;
+		}
+
+		if (gzip != -1) {
+			return gzip == 1;
+		} else {
+			return wildcard == 1;
+		}
+	}
+
+	/**
+	 * Returns whether a Vary header value already tells caches that the
+	 * response depends on Accept-Encoding: it lists "Accept-Encoding" or "*".
+	 */
+	static bool varyCoversAcceptEncoding(const StaticString &vary) {
+		const char *pos = vary.data();
+		const char *end = vary.data() + vary.size();
+
+		while (pos < end) {
+			const char *itemEnd = (const char *) memchr(pos, ',', end - pos);
+			if (itemEnd == NULL) {
+				itemEnd = end;
+			}
+
+			StaticString field = trim(StaticString(pos, itemEnd - pos));
+			if (field == P_STATIC_STRING("*")
+			 || equalsIgnoringCase(field, P_STATIC_STRING("accept-encoding")))
+			{
+				return true;
+			}
+
+			pos = itemEnd + 1;
+		}
+
+		return false;
+	}
+
+	/**
+	 * Returns whether response bodies of the given Content-Type are worth
+	 * compressing: text and text-based formats such as JSON, JavaScript,
+	 * XML and SVG. Formats such as images, video and archives are usually
+	 * compressed already. Server-sent event streams are excluded, because
+	 * they are long-lived and every event would have to be flushed separately.
+	 */
+	static bool isCompressibleContentType(const StaticString &contentType) {
+		const char *semicolon = (const char *) memchr(contentType.data(), ';',
+			contentType.size());
+		StaticString type = trim(StaticString(contentType.data(),
+			(semicolon == NULL) ? contentType.size() : semicolon - contentType.data()));
+
+		if (startsWithIgnoringCase(type, P_STATIC_STRING("text/"))) {
+			return !equalsIgnoringCase(type, P_STATIC_STRING("text/event-stream"));
+		} else {
+			return equalsIgnoringCase(type, P_STATIC_STRING("application/json"))
+				|| equalsIgnoringCase(type, P_STATIC_STRING("application/javascript"))
+				|| equalsIgnoringCase(type, P_STATIC_STRING("application/x-javascript"))
+				|| equalsIgnoringCase(type, P_STATIC_STRING("application/ecmascript"))
+				|| equalsIgnoringCase(type, P_STATIC_STRING("application/xml"))
+				|| endsWithIgnoringCase(type, P_STATIC_STRING("+json"))
+				|| endsWithIgnoringCase(type, P_STATIC_STRING("+xml"));
+		}
+	}
+};
+
+
+} // namespace Core
+} // namespace Passenger
+
+#endif /* _PASSENGER_CORE_CONTROLLER_RESPONSE_COMPRESSOR_H_ */
@@ -0,0 +1,421 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifdef __linux__
+	#include <sys/sendfile.h>
+#endif
+#include <Core/Controller.h>
+
+/*************************************************************************
+ *
+ * Implements Core::Controller methods pertaining sending files on behalf
+ * of the application, when it responds with X-Sendfile or
+ * X-Accel-Redirect and `sendfile_root` is set. Without that option, these
+ * responses are left to the web server in front of us.
+ *
+ *************************************************************************/
+
+namespace Passenger {
+namespace Core {
+
+using namespace std;
+using namespace boost;
+
+
+// The maximum amount of file data to send per event loop iteration,
+// so that other clients get a chance too.
+static const size_t SEND_FILE_MAX_CHUNK_SIZE = 1024 * 1024;
+
+
+/****************************
+ *
+ * Private methods
+ *
+ ****************************/
+
+
+static bool
+containsDotDotSegment(const StaticString &path) {
+	const char *pos = path.data();
+	const char *end = path.data() + path.size();
+
+	while (pos < end) {
+		const char *next = (const char *) memchr(pos, '/', end - pos);
+		if (next == NULL) {
+			next = end;
+		}
+		if (next - pos == 2 && pos[0] == '.' && pos[1] == '.') {
+			return true;
+		}
+		pos = next + 1;
+	}
+	return false;
+}
+
+/**
+ * Sends up to `count` bytes of `fd`, starting at `offset`, to the client
+ * socket. Behaves like sendfile(): returns the number of bytes sent, 0 if
+ * `offset` is at or beyond the end of the file, or -1 with errno set.
+ */
+static ssize_t
+sendFileData(int clientFd, int fd, boost::uint64_t offset, size_t count) {
+	ssize_t ret;
+
+	#ifdef __linux__
+		off_t pos = offset;
+		do {
+			ret = sendfile(clientFd, fd, &pos, count);
+		} while (OXT_UNLIKELY(ret == -1 && errno == EINTR));
+	#else
+		char buf[1024 * 16];
+		do {
+			ret = pread(fd, buf, std::min(count, sizeof(buf)), offset);
+		} while (OXT_UNLIKELY(ret == -1 && errno == EINTR));
+		if (ret > 0) {
+			ssize_t size = ret;
+			do {
+				ret = write(clientFd, buf, size);
+			} while (OXT_UNLIKELY(ret == -1 && errno == EINTR));
+		}
+	#endif
+
+	return ret;
+}
+
+/**
+ * Maps the X-Sendfile or X-Accel-Redirect response header onto a path
+ * under `sendfile_root`. X-Sendfile contains a filesystem path, which must
+ * lie under `sendfile_root`. X-Accel-Redirect contains a URI, which is
+ * looked up relative to `sendfile_root`, like Nginx does with an `alias`.
+ *
+ * Returns false if the header does not refer to a file under
+ * `sendfile_root`.
+ */
+bool
+Controller::resolveSendFilePath(Request *req, string &path) const {
+	const AppResponse *resp = &req->appResponse;
+	const StaticString root = mainConfig.sendfileRoot;
+	const LString *value;
+	StaticString target;
+
+	value = resp->headers.lookup(ServerKit::HTTP_X_SENDFILE);
+	if (value != NULL) {
+		if (value->size == 0) {
+			return false;
+		}
+		value = psg_lstr_make_contiguous(value, req->pool);
+		target = StaticString(value->start->data, value->size);
+		if (root != P_STATIC_STRING("/")
+		 && (!startsWith(target, root)
+		  || target.size() <= root.size()
+		  || target[root.size()] != '/'))
+		{
+			return false;
+		}
+		path.assign(target.data(), target.size());
+	} else {
+		value = resp->headers.lookup(ServerKit::HTTP_X_ACCEL_REDIRECT);
+		if (value == NULL || value->size == 0) {
+			return false;
+		}
+		value = psg_lstr_make_contiguous(value, req->pool);
+		target = StaticString(value->start->data, value->size);
+		target = target.substr(0, target.find('?'));
+		if (target.empty() || target[0] != '/') {
+			return false;
+		}
+		if (root != P_STATIC_STRING("/")) {
+			path.assign(root.data(), root.size());
+		}
+		path.append(target.data(), target.size());
+	}
+
+	return target[0] == '/'
+		&& path.find('\0') == string::npos
+		&& !containsDotDotSegment(path);
+}
+
+/**
+ * Parses a Range request header value. Only a single byte range is
+ * supported ("bytes=first-last", "bytes=first-" or "bytes=-suffix").
+ * Anything else results in BYTE_RANGE_IGNORED, in which case the whole
+ * file should be sent, as RFC 7233 allows.
+ */
+Controller::ByteRangeParseResult
+Controller::parseByteRange(const StaticString &value, boost::uint64_t size,
+	boost::uint64_t &start, boost::uint64_t &length)
+{
+	const char *pos = value.data();
+	const char *end = value.data() + value.size();
+	boost::uint64_t first = 0, last = 0;
+	bool hasFirst = false, hasLast = false;
+	unsigned int digits;
+
+	if (!startsWith(value, P_STATIC_STRING("bytes="))) {
+		return BYTE_RANGE_IGNORED;
+	}
+	pos += sizeof("bytes=") - 1;
+	while (pos < end && *pos == ' ') {
+		pos++;
+	}
+
+	for (digits = 0; pos < end && *pos >= '0' && *pos <= '9'; pos++, digits++) {
+		first = first * 10 + (*pos - '0');
+		hasFirst = true;
+	}
+	if (digits > 18 || pos == end || *pos != '-') {
+		return BYTE_RANGE_IGNORED;
+	}
+	pos++;
+	for (digits = 0; pos < end && *pos >= '0' && *pos <= '9'; pos++, digits++) {
+		last = last * 10 + (*pos - '0');
+		hasLast = true;
+	}
+	while (pos < end && *pos == ' ') {
+		pos++;
+	}
+	if (digits > 18 || pos != end || (!hasFirst && !hasLast)
+	 || (hasFirst && hasLast && last < first))
+	{
+		return BYTE_RANGE_IGNORED;
+	}
+
+	if (!hasFirst) {
+		// Suffix range: the last `last` bytes.
+		if (last == 0 || size == 0) {
+			return BYTE_RANGE_UNSATISFIABLE;
+		}
+		start = (last < size) ? size - last : 0;
+		length = size - start;
+		return BYTE_RANGE_SATISFIABLE;
+	} else if (first >= size) {
+		return BYTE_RANGE_UNSATISFIABLE;
+	} else {
+		if (!hasLast || last >= size) {
+			last = size - 1;
+		}
+		start = first;
+		length = last - first + 1;
+		return BYTE_RANGE_SATISFIABLE;
+	}
+}
+
+/**
+ * Opens the file that the app response refers to, and rewrites the app
+ * response so that its body is (a range of) that file. Upon failure, sends
+ * an error response, ends the request and returns false.
+ */
+bool
+Controller::prepareSendingFile(Client *client, Request *req) {
+	TRACE_POINT();
+	AppResponse *resp = &req->appResponse;
+	OpenFileCache::File file;
+	string path;
+	boost::uint64_t start = 0, length;
+	int e;
+
+	if (!resolveSendFilePath(req, path)) {
+		SKC_WARN(client, "The application asked to send a file outside "
+			"sendfile_root (" << mainConfig.sendfileRoot << "). Sending 403 response");
+		endRequestWithSimpleResponse(&client, &req, "<h2>Forbidden</h2>", 403);
+		return false;
+	}
+
+	e = openFileCache.get(path, ev_now(getLoop()), file);
+	if (e != 0) {
+		UPDATE_TRACE_POINT();
+		if (e == ENOENT || e == ENOTDIR || e == EISDIR) {
+			SKC_DEBUG(client, "Cannot send file " << path << ": not found");
+			endRequestWithSimpleResponse(&client, &req, "<h2>Not Found</h2>", 404);
+		} else if (e == EACCES || e == EPERM) {
+			SKC_WARN(client, "Cannot send file " << path << ": permission denied");
+			endRequestWithSimpleResponse(&client, &req, "<h2>Forbidden</h2>", 403);
+		} else {
+			SKC_ERROR(client, "Cannot open file " << path << ": " <<
+				strerror(e) << " (errno=" << e << ")");
+			endRequestWithSimpleResponse(&client, &req,
+				"<h2>Internal Server Error</h2>", 500);
+		}
+		return false;
+	}
+
+	UPDATE_TRACE_POINT();
+	SKC_TRACE(client, 2, "Sending file on behalf of the application: " << path);
+	length = file.size;
+	resp->headers.erase(ServerKit::HTTP_X_SENDFILE);
+	resp->headers.erase(ServerKit::HTTP_X_ACCEL_REDIRECT);
+	resp->headers.erase(HTTP_CONTENT_RANGE);
+	resp->headers.erase(HTTP_ACCEPT_RANGES);
+
+	if (resp->statusCode == 200) {
+		const LString *range = req->headers.lookup(HTTP_RANGE);
+		if (range != NULL && range->size > 0
+		 && req->headers.lookup(HTTP_IF_RANGE) == NULL)
+		{
+			range = psg_lstr_make_contiguous(range, req->pool);
+			switch (parseByteRange(StaticString(range->start->data, range->size),
+				file.size, start, length))
+			{
+			case BYTE_RANGE_SATISFIABLE:
+				resp->statusCode = 206;
+				resp->headers.insert(req->pool, "Content-Range",
+					psg_pstrdup(req->pool, "bytes " + toString(start)
+						+ "-" + toString(start + length - 1)
+						+ "/" + toString(file.size)));
+				break;
+			case BYTE_RANGE_UNSATISFIABLE:
+				resp->statusCode = 416;
+				resp->headers.insert(req->pool, "Content-Range",
+					psg_pstrdup(req->pool, "bytes */" + toString(file.size)));
+				start = 0;
+				length = 0;
+				break;
+			default:
+				break;
+			}
+		}
+		resp->headers.insert(req->pool, "Accept-Ranges", "bytes");
+	}
+
+	// Turn the app response into one with a fixed-length body, so that
+	// the response header that we send contains a Content-Length and
+	// allows keep-alive. The app itself did not send a body.
+	resp->bodyType = AppResponse::RBT_CONTENT_LENGTH;
+	resp->aux.bodyInfo.contentLength = length;
+	req->cacheKey = HashedStaticString();
+	req->sendingFile = true;
+	req->sendFileFd = file.fd;
+	req->sendFileOffset = start;
+	req->sendFileRemaining = (req->method == HTTP_HEAD) ? 0 : length;
+	return true;
+}
+
+/**
+ * Called after the response header has been sent or buffered.
+ */
+void
+Controller::beginSendingFile(Client *client, Request *req) {
+	// The app is done with this request: its response has no body and we
+	// send the file ourselves. So release the session now rather than after
+	// the file has been sent, otherwise a slow client would keep the app
+	// process busy for the whole download. This is only possible once the
+	// entire request body has been forwarded to the app.
+	if (req->state == Request::WAITING_FOR_APP_OUTPUT) {
+		keepAliveAppConnection(client, req);
+	}
+
+	if (req->sendFileRemaining == 0) {
+		endSendingFile(client, req);
+	} else if (client->output.getTotalBytesBuffered() > 0) {
+		// sendfile() writes to the client socket directly, so we must
+		// wait until the buffered response header has been written.
+		SKC_TRACE(client, 2, "Waiting until response headers have been sent");
+		client->output.setDataFlushedCallback(_outputDataFlushed);
+	} else {
+		continueSendingFile(client, req);
+	}
+}
+
+void
+Controller::onSendFileWritable(EV_P_ struct ev_io *io, int revents) {
+	Request *req = static_cast<Request *>(io->data);
+	Client *client = static_cast<Client *>(req->client);
+	Controller *self = static_cast<Controller *>(getServerFromClient(client));
+	SKC_LOG_EVENT_FROM_STATIC(self, Controller, client, "onSendFileWritable");
+
+	if (req->ended()) {
+		self->stopSendingFile(req);
+	} else {
+		self->continueSendingFile(client, req);
+	}
+}
+
+void
+Controller::continueSendingFile(Client *client, Request *req) {
+	TRACE_POINT();
+	int clientFd = client->getFd();
+	boost::uint64_t sent = 0;
+	ssize_t ret;
+	int e;
+
+	while (req->sendFileRemaining > 0 && sent < SEND_FILE_MAX_CHUNK_SIZE) {
+		ret = sendFileData(clientFd, req->sendFileFd, req->sendFileOffset,
+			std::min<boost::uint64_t>(req->sendFileRemaining,
+				SEND_FILE_MAX_CHUNK_SIZE - sent));
+		if (ret > 0) {
+			req->sendFileOffset += ret;
+			req->sendFileRemaining -= ret;
+			totalBytesSentFromFiles += ret;
+			sent += ret;
+		} else if (ret == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+			break;
+		} else if (ret == 0) {
+			UPDATE_TRACE_POINT();
+			SKC_WARN(client, "File became smaller while sending it: " <<
+				req->sendFileRemaining << " bytes left to send");
+			stopSendingFile(req);
+			disconnectWithError(&client, "file became smaller while sending it");
+			return;
+		} else {
+			UPDATE_TRACE_POINT();
+			e = errno;
+			stopSendingFile(req);
+			disconnectWithClientSocketWriteError(&client, e);
+			return;
+		}
+	}
+
+	if (req->sendFileRemaining == 0) {
+		UPDATE_TRACE_POINT();
+		SKC_TRACE(client, 2, "File sent");
+		endSendingFile(client, req);
+	} else if (!ev_is_active(&req->sendFileWatcher)) {
+		ev_io_set(&req->sendFileWatcher, clientFd, EV_WRITE);
+		ev_io_start(getLoop(), &req->sendFileWatcher);
+	}
+}
+
+void
+Controller::endSendingFile(Client *client, Request *req) {
+	stopSendingFile(req);
+	if (!req->session->isClosed()) {
+		// The session could not be released in beginSendingFile().
+		keepAliveAppConnection(client, req);
+	}
+	endRequest(&client, &req);
+}
+
+void
+Controller::stopSendingFile(Request *req) {
+	if (req->sendingFile) {
+		ev_io_stop(getLoop(), &req->sendFileWatcher);
+		req->sendingFile = false;
+		req->sendFileFd = FileDescriptor();
+	}
+}
+
+
+} // namespace Core
+} // namespace Passenger
@@ -60,17 +60,13 @@ struct Controller::SessionProtocolWorkingState {
 	const LString *remoteUser;
 	const LString *contentType;
 	const LString *contentLength;
-	char *environmentVariablesData;
+	const char *environmentVariablesData;
 	size_t environmentVariablesSize;
 	bool hasBaseURI;
 
 	SessionProtocolWorkingState()
 		: environmentVariablesData(NULL)
 		{ }
-
-	~SessionProtocolWorkingState() {
-		free(environmentVariablesData);
-	}
 };
 
 struct Controller::HttpHeaderConstructionCache {
@@ -343,19 +339,9 @@ Controller::determineHeaderSizeForSessionProtocol(Request *req,
 		state.contentLength = NULL;
 	}
 	if (req->envvars != NULL) {
-		size_t len = modp_b64_decode_len(req->envvars->size);
-		state.environmentVariablesData = (char *) malloc(len);
-		if (state.environmentVariablesData == NULL) {
-			throw RuntimeException("Unable to allocate memory for base64 "
-				"decoding of environment variables");
-		}
-		len = modp_b64_decode(state.environmentVariablesData,
-			req->envvars->start->data,
-			req->envvars->size);
-		if (len == (size_t) -1) {
-			throw RuntimeException("Unable to base64 decode environment variables");
-		}
-		state.environmentVariablesSize = len;
+		const DecodedEnvvars &envvars = decodeEnvvars(req);
+		state.environmentVariablesData = envvars.decoded.data();
+		state.environmentVariablesSize = envvars.decoded.size();
 	}
 
 	dataSize += sizeof("REQUEST_URI");
@@ -403,11 +389,7 @@ Controller::determineHeaderSizeForSessionProtocol(Request *req,
 	dataSize += sizeof("SERVER_PORT");
 	dataSize += state.serverPort.size() + 1;
 
-	dataSize += sizeof("SERVER_SOFTWARE");
-	dataSize += req->config->serverSoftware.size() + 1;
-
-	dataSize += sizeof("SERVER_PROTOCOL");
-	dataSize += sizeof("HTTP/1.1");
+	dataSize += req->config->sessionProtocolStaticHeader.size();
 
 	dataSize += sizeof("REMOTE_ADDR");
 	if (state.remoteAddr != NULL) {
@@ -506,12 +488,7 @@ Controller::constructHeaderForSessionProtocol(Request *req, char * restrict buff
 	pos = appendData(pos, end, state.serverPort);
 	pos = appendData(pos, end, "", 1);
 
-	pos = appendData(pos, end, P_STATIC_STRING_WITH_NULL("SERVER_SOFTWARE"));
-	pos = appendData(pos, end, req->config->serverSoftware);
-	pos = appendData(pos, end, "", 1);
-
-	pos = appendData(pos, end, P_STATIC_STRING_WITH_NULL("SERVER_PROTOCOL"));
-	pos = appendData(pos, end, P_STATIC_STRING_WITH_NULL("HTTP/1.1"));
+	pos = appendData(pos, end, req->config->sessionProtocolStaticHeader);
 
 	pos = appendData(pos, end, P_STATIC_STRING_WITH_NULL("REMOTE_ADDR"));
 	if (state.remoteAddr != NULL) {
@@ -610,6 +587,35 @@ Controller::constructHeaderForSessionProtocol(Request *req, char * restrict buff
 	return pos < end;
 }
 
+/**
+ * Returns the base64-decoded value of `req->envvars`, using the cached
+ * value for the request's app group if the encoded value hasn't changed.
+ */
+const Controller::DecodedEnvvars &
+Controller::decodeEnvvars(Request *req) {
+	HashedStaticString appGroupName = req->options.getAppGroupName();
+	StaticString encoded(req->envvars->start->data, req->envvars->size);
+	DecodedEnvvars *envvars;
+
+	if (decodedEnvvarsCache.lookup(appGroupName, &envvars)
+	 && envvars->encoded == encoded)
+	{
+		return *envvars;
+	}
+
+	DecodedEnvvars newEnvvars;
+	newEnvvars.decoded.resize(modp_b64_decode_len(encoded.size()));
+	size_t len = modp_b64_decode(&newEnvvars.decoded[0], encoded.data(),
+		encoded.size());
+	if (len == (size_t) -1) {
+		throw RuntimeException("Unable to base64 decode environment variables");
+	}
+	newEnvvars.decoded.resize(len);
+	newEnvvars.encoded.assign(encoded.data(), encoded.size());
+
+	return decodedEnvvarsCache.insert(appGroupName, newEnvvars)->value;
+}
+
 void
 Controller::sendHeaderToAppWithHttpProtocol(Client *client, Request *req) {
 	ssize_t bytesWritten;
@@ -918,6 +924,7 @@ void
 Controller::sendBodyToApp(Client *client, Request *req) {
 	TRACE_POINT();
 	assert(req->appSink.acceptingInput());
+	req->headerSentToAppAt = SystemTime::getMonotonicUsec();
 	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
 		req->timeOnRequestHeaderSent = ev_now(getLoop());
 		reportLargeTimeDiff(client,
@@ -62,11 +62,46 @@ Controller::inspectStateAsJson() const {
 		subdoc["stores"] = turboCaching.responseCache.getStores();
 		subdoc["store_successes"] = turboCaching.responseCache.getStoreSuccesses();
 		subdoc["store_success_ratio"] = turboCaching.responseCache.getStoreSuccessRatio();
+		subdoc["entry_count"] = turboCaching.responseCache.getEntryCount();
+		subdoc["max_entries"] = turboCaching.responseCache.getMaxEntries();
+		subdoc["memory_usage"] = byteSizeToJson(turboCaching.responseCache.getMemoryUsage());
+		subdoc["max_memory"] = byteSizeToJson(turboCaching.responseCache.getMaxMemory());
+		subdoc["evictions"] = turboCaching.responseCache.getEvictions();
+		subdoc["shared"] = turboCaching.responseCache.getSharedCache() != NULL;
 		doc["turbocaching"] = subdoc;
 	}
+	doc["total_bytes_spliced"] = byteSizeToJson(totalBytesSpliced);
+	if (totalBytesCompressed > 0) {
+		Json::Value subdoc;
+		subdoc["total_bytes_in"] = byteSizeToJson(totalBytesCompressed);
+		subdoc["total_bytes_out"] = byteSizeToJson(totalCompressedBytesSent);
+		subdoc["free_compressors"] = (Json::UInt) freeResponseCompressors.size();
+		doc["response_compression"] = subdoc;
+	}
+	if (!mainConfig.sendfileRoot.empty()) {
+		Json::Value subdoc;
+		subdoc["open_files"] = openFileCache.size();
+		subdoc["open_file_cache_hits"] = openFileCache.getHits();
+		subdoc["open_file_cache_misses"] = openFileCache.getMisses();
+		subdoc["total_bytes_sent"] = byteSizeToJson(totalBytesSentFromFiles);
+		doc["sendfile"] = subdoc;
+	}
 	return doc;
 }
 
+/**
+ * Merges this thread's latency statistics into `result`. Must be called
+ * from this Controller's event loop thread.
+ */
+void
+Controller::collectLatencyStats(RequestLatencyStatsMap &result) const {
+	StringKeyTable< boost::shared_ptr<RequestLatencyStats> >::ConstIterator it(latencyStats);
+	while (*it != NULL) {
+		result[it.getKey().toString()].merge(*it.getValue());
+		it.next();
+	}
+}
+
 Json::Value
 Controller::inspectClientStateAsJson(const Client *client) const {
 	Json::Value doc = ParentClass::inspectClientStateAsJson(client);
@@ -93,6 +128,9 @@ Controller::inspectRequestStateAsJson(const Request *req) const {
 	flags["dechunk_response"] = req->dechunkResponse;
 	flags["request_body_buffering"] = req->requestBodyBuffering;
 	flags["https"] = req->https;
+	flags["splicing_app_response"] = req->splicingAppResponse;
+	flags["sending_file"] = req->sendingFile;
+	flags["compressing_response"] = req->compressingResponse;
 	doc["flags"] = flags;
 
 	if (req->requestBodyBuffering) {
@@ -37,6 +37,7 @@
 #include <LoggingKit/LoggingKit.h>
 #include <Utils/StrIntUtils.h>
 #include <Core/ResponseCache.h>
+#include <Core/SharedResponseCache.h>
 
 namespace Passenger {
 namespace Core {
@@ -85,6 +86,7 @@ public:
 private:
 	State state;
 	ev_tstamp lastTimeout, nextTimeout;
+	unsigned int threadIndex;
 
 	struct ResponsePreparation {
 		Request *req;
@@ -195,19 +197,49 @@ public:
 	TurboCaching()
 		: state(ENABLED),
 		  lastTimeout(0),
-		  nextTimeout(0)
+		  nextTimeout(0),
+		  threadIndex(0)
 		{ }
 
-	void initialize(bool initiallyEnabled) {
+	void initialize(bool initiallyEnabled, unsigned int maxEntries,
+		size_t maxMemory, unsigned int maxBodySize)
+	{
 		state = initiallyEnabled ? ENABLED : DISABLED;
+		responseCache.setLimits(maxEntries, maxMemory, maxBodySize);
 		lastTimeout = (ev_tstamp) time(NULL);
 		nextTimeout = (ev_tstamp) time(NULL) + ENABLED_TIMEOUT;
 	}
 
+	/**
+	 * Makes this thread store responses in the given cache, which is shared
+	 * with other threads. `threadIndex` identifies this thread within the
+	 * shared cache. Call after `initialize()`.
+	 */
+	void setSharedCache(SharedResponseCache *cache, unsigned int _threadIndex) {
+		threadIndex = _threadIndex;
+		responseCache.setSharedCache(cache);
+	}
+
 	bool isEnabled() const {
 		return state == ENABLED;
 	}
 
+	// Call when the event loop multiplexer returns, before handling any events.
+	void threadOnline() {
+		SharedResponseCache *sharedCache = responseCache.getSharedCache();
+		if (sharedCache != NULL) {
+			sharedCache->threadOnline(threadIndex);
+		}
+	}
+
+	// Call before the event loop blocks.
+	void threadOffline() {
+		SharedResponseCache *sharedCache = responseCache.getSharedCache();
+		if (sharedCache != NULL) {
+			sharedCache->threadOffline(threadIndex);
+		}
+	}
+
 	// Call when the event loop multiplexer returns.
 	void updateState(ev_tstamp now) {
 		if (OXT_UNLIKELY(state == DISABLED)) {
@@ -243,11 +275,19 @@ public:
 				state = TEMPORARILY_DISABLED;
 				nextTimeout = now + TEMPORARY_DISABLE_TIMEOUT;
 			} else {
-				P_DEBUG("Clearing turbocache");
 				nextTimeout = now + ENABLED_TIMEOUT;
 			}
+			// Entries are bounded by the cache's own limits and are
+			// checked for freshness upon fetching, so we only clear
+			// the cache when it's no longer used. A shared cache is
+			// left alone because other threads may still be using it.
+			if (responseCache.getSharedCache() != NULL) {
+				responseCache.getSharedCache()->reclaim();
+			} else if (state == TEMPORARILY_DISABLED) {
+				P_DEBUG("Clearing turbocache");
+				responseCache.clear();
+			}
 			responseCache.resetStatistics();
-			responseCache.clear();
 			break;
 		case TEMPORARILY_DISABLED:
 			P_INFO("Re-enabling turbocaching");
@@ -275,19 +315,43 @@ public:
 		if (headerSize + entry.body->httpBodySize <= MBUF_MAX_SIZE) {
 			// Header and body fit inside a single mbuf
 			MemoryKit::mbuf buffer(MemoryKit::mbuf_get(&mbuf_pool));
+			char *pos;
 			buffer = MemoryKit::mbuf(buffer, 0, headerSize + entry.body->httpBodySize);
 
 			buildResponseHeader(prep, server, buffer.start, buffer.size());
-			memcpy(buffer.start + headerSize, entry.body->httpBodyData, entry.body->httpBodySize);
+			pos = buffer.start + headerSize;
+			for (unsigned int i = 0; i < entry.body->httpBodyData.size(); i++) {
+				const MemoryKit::mbuf &part = entry.body->httpBodyData[i];
+				memcpy(pos, part.start, part.size());
+				pos += part.size();
+			}
 
 			server->writeResponse(client, buffer);
-		} else {
+		} else if (responseCache.getSharedCache() != NULL) {
+			// Entries in the shared cache may be freed once this thread passes
+			// through a quiescent state, so we can't refer to their data.
 			char *buffer = (char *) psg_pnalloc(req->pool, headerSize + entry.body->httpBodySize);
 			buildResponseHeader(prep, server, buffer,
 				headerSize + entry.body->httpBodySize);
-			memcpy(buffer + headerSize, entry.body->httpBodyData, entry.body->httpBodySize);
+			if (entry.body->httpBodySize > 0) {
+				memcpy(buffer + headerSize, entry.body->httpBodyData[0].start,
+					entry.body->httpBodySize);
+			}
 
 			server->writeResponse(client, buffer, headerSize + entry.body->httpBodySize);
+		} else {
+			// Write the header separately, and share the body mbufs
+			// with the cache instead of copying them
+			char *buffer = (char *) psg_pnalloc(req->pool, headerSize);
+			buildResponseHeader(prep, server, buffer, headerSize);
+			server->writeResponse(client, buffer, headerSize);
+
+			for (unsigned int i = 0; i < entry.body->httpBodyData.size(); i++) {
+				if (req->ended()) {
+					break;
+				}
+				server->writeResponse(client, entry.body->httpBodyData[i]);
+			}
 		}
 	}
 };
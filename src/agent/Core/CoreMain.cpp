@@ -94,6 +94,8 @@
 #include <Utils/VariantMap.h>
 #include <Core/OptionParser.h>
 #include <Core/Controller.h>
+#include <Core/SharedResponseCache.h>
+#include <Core/ConfigHandleRegistry.h>
 #include <Core/ApiServer.h>
 #include <Core/Config.h>
 #include <Core/ConfigChange.h>
@@ -138,6 +140,14 @@ namespace Core {
 
 	struct WorkingObjects {
 		int serverFds[SERVER_KIT_MAX_SERVER_ENDPOINTS];
+		/**
+		 * In 'reuseport' accept distribution mode, every controller thread
+		 * owns its own socket for each TCP address. `serverFds[i]` is then
+		 * owned by thread 1, and `reusePortServerFds[i]` contains the
+		 * sockets for threads 2..n. Empty for addresses that are not
+		 * listened on with SO_REUSEPORT.
+		 */
+		vector<int> reusePortServerFds[SERVER_KIT_MAX_SERVER_ENDPOINTS];
 		int apiServerFds[SERVER_KIT_MAX_SERVER_ENDPOINTS];
 		string controllerSecureHeadersPassword;
 
@@ -152,6 +162,8 @@ namespace Core {
 		Json::Value singleAppModeConfig;
 
 		ServerKit::AcceptLoadBalancer<Controller> loadBalancer;
+		SharedResponseCache *sharedTurboCache;
+		ConfigHandleRegistry configHandleRegistry;
 		vector<ThreadWorkingObjects> threadWorkingObjects;
 		struct ev_signal sigintWatcher;
 		struct ev_signal sigtermWatcher;
@@ -170,7 +182,8 @@ namespace Core {
 		oxt::thread *adminPanelConnectorThread;
 
 		WorkingObjects()
-			: exitEvent(__FILE__, __LINE__, "WorkingObjects: exitEvent"),
+			: sharedTurboCache(NULL),
+			  exitEvent(__FILE__, __LINE__, "WorkingObjects: exitEvent"),
 			  allClientsDisconnectedEvent(__FILE__, __LINE__, "WorkingObjects: allClientsDisconnectedEvent"),
 			  terminationCount(0),
 			  shutdownCounter(0),
@@ -201,6 +214,7 @@ namespace Core {
 				delete it->serverKitContext;
 				delete it->bgloop;
 			}
+			delete sharedTurboCache;
 
 			delete apiWorkingObjects.apiServer;
 			delete apiWorkingObjects.serverKitContext;
@@ -405,12 +419,22 @@ makeFileWorldReadableAndWritable(const string &path) {
 	}
 #endif
 
+static bool
+shouldListenWithReusePort(const string &address) {
+	return coreConfig->get("controller_accept_distribution").asString() == "reuseport"
+		&& coreConfig->get("controller_threads").asUInt() > 1
+		&& getSocketAddressType(address) == SAT_TCP
+		&& reusePortSupported();
+}
+
 static void
 startListening() {
 	TRACE_POINT();
 	WorkingObjects *wo = workingObjects;
 	const Json::Value addresses = coreConfig->get("controller_addresses");
 	const Json::Value apiAddresses = coreConfig->get("api_server_addresses");
+	unsigned int nthreads = coreConfig->get("controller_threads").asUInt();
+	unsigned int backlog = coreConfig->get("controller_socket_backlog").asUInt();
 	Json::Value::const_iterator it;
 	unsigned int i;
 
@@ -420,10 +444,34 @@ startListening() {
 		setSelinuxSocketContext();
 	#endif
 
+	if (coreConfig->get("controller_accept_distribution").asString() == "reuseport"
+	 && nthreads > 1
+	 && !reusePortSupported())
+	{
+		P_WARN("The 'reuseport' accept distribution mode is not supported"
+			" on this platform. Falling back to 'least-loaded'");
+	}
+
 	for (it = addresses.begin(), i = 0; it != addresses.end(); it++, i++) {
-		wo->serverFds[i] = createServer(it->asString(),
-			coreConfig->get("controller_socket_backlog").asUInt(), true,
-			__FILE__, __LINE__);
+		if (shouldListenWithReusePort(it->asString())) {
+			string host;
+			unsigned short port;
+
+			parseTcpSocketAddress(it->asString(), host, port);
+			wo->serverFds[i] = createReusePortTcpServer(host.c_str(), port,
+				backlog, __FILE__, __LINE__);
+			wo->reusePortServerFds[i].reserve(nthreads - 1);
+			for (unsigned int t = 1; t < nthreads; t++) {
+				int fd = createReusePortTcpServer(host.c_str(), port,
+					backlog, __FILE__, __LINE__);
+				wo->reusePortServerFds[i].push_back(fd);
+				P_LOG_FILE_DESCRIPTOR_PURPOSE(fd,
+					"Server address: " << it->asString() << " (thread " << (t + 1) << ")");
+			}
+		} else {
+			wo->serverFds[i] = createServer(it->asString(), backlog, true,
+				__FILE__, __LINE__);
+		}
 		#ifdef USE_SELINUX
 			resetSelinuxSocketContext();
 			if (i == 0 && getSocketAddressType(it->asString()) == SAT_UNIX) {
@@ -496,7 +544,11 @@ inspectControllerConfigAsJson(Controller *controller, string *result) {
 
 static void
 getMbufStats(struct MemoryKit::mbuf_pool *input, struct MemoryKit::mbuf_pool *result) {
-	*result = *input;
+	// mbuf_pool contains an atomic and is therefore not copyable.
+	result->nfree_mbuf_blockq = input->nfree_mbuf_blockq;
+	result->nactive_mbuf_blockq = input->nactive_mbuf_blockq;
+	result->mbuf_block_chunk_size = input->mbuf_block_chunk_size;
+	result->nslabs = input->nslabs;
 }
 
 static void
@@ -542,6 +594,7 @@ printInfoInThread() {
 	cerr << "nfree_mbuf_blockq    : " << stats.nfree_mbuf_blockq << "\n";
 	cerr << "nactive_mbuf_blockq  : " << stats.nactive_mbuf_blockq << "\n";
 	cerr << "mbuf_block_chunk_size: " << stats.mbuf_block_chunk_size << "\n";
+	cerr << "nslabs               : " << stats.nslabs << "\n";
 	cerr << "\n";
 	cerr.flush();
 
@@ -672,13 +725,26 @@ initializeNonPrivilegedWorkingObjects() {
 	wo->appPool = boost::make_shared<Pool>(wo->appPoolContext.get());
 	wo->appPool->initialize();
 	wo->appPool->setMax(coreConfig->get("max_pool_size").asInt());
+	wo->appPool->setMaxSpawnConcurrency(coreConfig->get("max_spawn_concurrency").asUInt());
 	wo->appPool->setMaxIdleTime(coreConfig->get("pool_idle_time").asInt() * 1000000ULL);
+	wo->appPool->setMinIdleConnections(coreConfig->get("pool_min_idle_connections").asUInt());
+	wo->appPool->enablePredictiveAutoscaling(
+		coreConfig->get("pool_predictive_autoscaling").asBool());
 	wo->appPool->enableSelfChecking(coreConfig->get("pool_selfchecks").asBool());
 	wo->appPool->abortLongRunningConnectionsCallback = abortLongRunningConnections;
 
 	UPDATE_TRACE_POINT();
 	unsigned int nthreads = coreConfig->get("controller_threads").asUInt();
 	BackgroundEventLoop *firstLoop = NULL; // Avoid compiler warning
+	if (coreConfig->get("turbocaching").asBool()
+	 && coreConfig->get("turbocache_shared").asBool()
+	 && nthreads > 1)
+	{
+		wo->sharedTurboCache = new SharedResponseCache(
+			coreConfig->get("turbocache_max_entries").asUInt(),
+			coreConfig->get("turbocache_max_memory").asUInt(),
+			nthreads);
+	}
 	wo->threadWorkingObjects.reserve(nthreads);
 	for (unsigned int i = 0; i < nthreads; i++) {
 		UPDATE_TRACE_POINT();
@@ -715,6 +781,8 @@ initializeNonPrivilegedWorkingObjects() {
 			coreSchema->controllerSingleAppMode.translator);
 		two.controller->resourceLocator = &wo->resourceLocator;
 		two.controller->appPool = wo->appPool;
+		two.controller->sharedTurboCache = wo->sharedTurboCache;
+		two.controller->configHandleRegistry = &wo->configHandleRegistry;
 		two.controller->shutdownFinishCallback = controllerShutdownFinished;
 		two.controller->initialize();
 		wo->shutdownCounter.fetch_add(1, boost::memory_order_relaxed);
@@ -775,6 +843,13 @@ initializeNonPrivilegedWorkingObjects() {
 		if (nthreads == 1) {
 			ThreadWorkingObjects *two = &wo->threadWorkingObjects[0];
 			two->controller->listen(wo->serverFds[i]);
+		} else if (!wo->reusePortServerFds[i].empty()) {
+			// The kernel distributes clients among the threads' sockets.
+			wo->threadWorkingObjects[0].controller->listen(wo->serverFds[i]);
+			for (unsigned int t = 1; t < nthreads; t++) {
+				ThreadWorkingObjects *two = &wo->threadWorkingObjects[t];
+				two->controller->listen(wo->reusePortServerFds[i][t - 1]);
+			}
 		} else {
 			wo->loadBalancer.listen(wo->serverFds[i]);
 		}
@@ -784,6 +859,13 @@ initializeNonPrivilegedWorkingObjects() {
 		two->controller->createSpareClients();
 	}
 	if (nthreads > 1) {
+		// Addresses that cannot be listened on with SO_REUSEPORT (e.g.
+		// Unix domain sockets) still go through the load balancer,
+		// which is then load-aware.
+		if (coreConfig->get("controller_accept_distribution").asString() != "round-robin") {
+			wo->loadBalancer.distributionMode =
+				ServerKit::AcceptLoadBalancer<Controller>::LEAST_LOADED;
+		}
 		wo->loadBalancer.servers.reserve(nthreads);
 		for (unsigned int i = 0; i < nthreads; i++) {
 			ThreadWorkingObjects *two = &wo->threadWorkingObjects[i];
@@ -1041,7 +1123,7 @@ mainLoop() {
 	if (wo->apiWorkingObjects.apiServer != NULL) {
 		wo->apiWorkingObjects.bgloop->start("API event loop", 0);
 	}
-	if (wo->threadWorkingObjects.size() > 1) {
+	if (wo->loadBalancer.hasEndpoints()) {
 		wo->loadBalancer.start();
 	}
 	waitForExitEvent();
@@ -1211,6 +1293,9 @@ cleanup() {
 		if (wo->serverFds[i] != -1) {
 			close(wo->serverFds[i]);
 		}
+		for (unsigned int t = 0; t < wo->reusePortServerFds[i].size(); t++) {
+			close(wo->reusePortServerFds[i][t]);
+		}
 		if (wo->apiServerFds[i] != -1) {
 			close(wo->apiServerFds[i]);
 		}
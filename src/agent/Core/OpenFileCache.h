@@ -0,0 +1,238 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_CORE_OPEN_FILE_CACHE_H_
+#define _PASSENGER_CORE_OPEN_FILE_CACHE_H_
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <ctime>
+#include <cerrno>
+#include <string>
+#include <list>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/cstdint.hpp>
+#include <oxt/system_calls.hpp>
+
+#include <StaticString.h>
+#include <FileDescriptor.h>
+#include <Utils/StringMap.h>
+
+namespace Passenger {
+namespace Core {
+
+using namespace std;
+
+
+/**
+ * Keeps files open so that the controller does not have to open() and
+ * fstat() a file every time it serves that file because of an X-Sendfile
+ * or X-Accel-Redirect response header.
+ *
+ * A cached entry is trusted for `validity` seconds. After that, the file
+ * is stat()ed again, and reopened if it was modified or replaced. When the
+ * cache is full, the least recently used file is closed. Requests that are
+ * still sending that file are not affected, because they hold their own
+ * FileDescriptor reference.
+ *
+ * This class is not thread-safe. Each Controller has its own instance.
+ */
+class OpenFileCache {
+public:
+	struct File {
+		FileDescriptor fd;
+		boost::uint64_t size;
+		time_t mtime;
+
+		File()
+			: size(0),
+			  mtime(0)
+			{ }
+	};
+
+private:
+	struct Entry {
+		string path;
+		File file;
+		dev_t dev;
+		ino_t ino;
+		double lastValidated;
+	};
+
+	typedef boost::shared_ptr<Entry> EntryPtr;
+	typedef list<EntryPtr> EntryList;
+	typedef StringMap<EntryList::iterator> EntryMap;
+
+	unsigned int maxSize;
+	double validity;
+	EntryList entries;
+	EntryMap cache;
+	unsigned int hits;
+	unsigned int misses;
+
+	static bool sameFile(const Entry &entry, const struct stat &buf) {
+		return entry.dev == buf.st_dev
+			&& entry.ino == buf.st_ino
+			&& entry.file.mtime == buf.st_mtime
+			&& entry.file.size == (boost::uint64_t) buf.st_size;
+	}
+
+	static int openFile(const StaticString &path, Entry &entry) {
+		struct stat buf;
+		int fd, ret, e;
+
+		// O_NONBLOCK prevents us from blocking on FIFOs. It has no
+		// effect on regular files.
+		fd = syscalls::open(string(path.data(), path.size()).c_str(),
+			O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+		if (fd == -1) {
+			return errno;
+		}
+		FileDescriptor guard(fd, __FILE__, __LINE__);
+
+		do {
+			ret = fstat(fd, &buf);
+		} while (ret == -1 && errno == EINTR);
+		if (ret == -1) {
+			e = errno;
+			return e;
+		}
+		if (!S_ISREG(buf.st_mode)) {
+			return EISDIR;
+		}
+
+		entry.file.fd = guard;
+		entry.file.size = buf.st_size;
+		entry.file.mtime = buf.st_mtime;
+		entry.dev = buf.st_dev;
+		entry.ino = buf.st_ino;
+		return 0;
+	}
+
+	void removeEntry(EntryList::iterator it) {
+		cache.remove((*it)->path);
+		entries.erase(it);
+	}
+
+public:
+	OpenFileCache(unsigned int _maxSize = 256, double _validity = 1)
+		: maxSize(_maxSize),
+		  validity(_validity),
+		  hits(0),
+		  misses(0)
+		{ }
+
+	/**
+	 * Returns the open file for `path`, opening it if it is not in the
+	 * cache or if the cached entry turns out to be stale. `now` is the
+	 * current time, e.g. `ev_now()`.
+	 *
+	 * Returns 0 on success, or an errno value on failure. EISDIR is
+	 * returned if `path` exists but is not a regular file. Failures are
+	 * not cached.
+	 */
+	int get(const StaticString &path, double now, File &result) {
+		EntryList::iterator it(cache.get(path, entries.end()));
+		int e;
+
+		if (it != entries.end()) {
+			EntryPtr entry = *it;
+
+			if (now - entry->lastValidated >= validity) {
+				struct stat buf;
+				int ret;
+
+				do {
+					ret = stat(entry->path.c_str(), &buf);
+				} while (ret == -1 && errno == EINTR);
+				if (ret == -1 || !sameFile(*entry, buf)) {
+					removeEntry(it);
+					it = entries.end();
+				} else {
+					entry->lastValidated = now;
+				}
+			}
+
+			if (it != entries.end()) {
+				// Mark this entry as most recently used.
+				entries.splice(entries.begin(), entries, it);
+				cache.set(path, entries.begin());
+				hits++;
+				result = entry->file;
+				return 0;
+			}
+		}
+
+		misses++;
+		EntryPtr entry = boost::make_shared<Entry>();
+		e = openFile(path, *entry);
+		if (e != 0) {
+			return e;
+		}
+		entry->path = string(path.data(), path.size());
+		entry->lastValidated = now;
+
+		if (maxSize == 0) {
+			result = entry->file;
+			return 0;
+		}
+		if (cache.size() >= maxSize) {
+			EntryList::iterator last = entries.end();
+			last--;
+			removeEntry(last);
+		}
+		entries.push_front(entry);
+		cache.set(entry->path, entries.begin());
+		result = entry->file;
+		return 0;
+	}
+
+	/** Closes all cached files. */
+	void clear() {
+		while (!entries.empty()) {
+			removeEntry(entries.begin());
+		}
+	}
+
+	unsigned int size() const {
+		return cache.size();
+	}
+
+	unsigned int getHits() const {
+		return hits;
+	}
+
+	unsigned int getMisses() const {
+		return misses;
+	}
+};
+
+
+} // namespace Core
+} // namespace Passenger
+
+#endif /* _PASSENGER_CORE_OPEN_FILE_CACHE_H_ */
@@ -141,6 +141,17 @@ coreUsage() {
 	printf("      --pool-idle-time SECS\n");
 	printf("                            Maximum number of seconds an application process\n");
 	printf("                            may be idle. Default: %d\n", DEFAULT_POOL_IDLE_TIME);
+	printf("      --pool-min-idle-connections N\n");
+	printf("                            Number of idle connections to keep established\n");
+	printf("                            to each application process, so that requests\n");
+	printf("                            don't have to wait for a new connection. Only\n");
+	printf("                            applies to processes with unlimited concurrency.\n");
+	printf("                            Default: 0\n");
+	printf("      --predictive-autoscaling\n");
+	printf("                            Spawn processes ahead of the demand that is\n");
+	printf("                            predicted from each application's request rate\n");
+	printf("                            history, and shut them down gradually when it\n");
+	printf("                            drops\n");
 	printf("      --max-preloader-idle-time SECS\n");
 	printf("                            Maximum time that preloader processes may be\n");
 	printf("                            be idle. A value of 0 means that preloader\n");
@@ -150,6 +161,13 @@ coreUsage() {
 	printf("                            process can handle the given number of concurrent\n");
 	printf("                            requests per process\n");
 	printf("      --min-instances N     Minimum number of application processes. Default: 1\n");
+	printf("      --spawn-concurrency N\n");
+	printf("                            Number of processes that an application may spawn\n");
+	printf("                            in parallel. Default: %d\n", DEFAULT_SPAWN_CONCURRENCY);
+	printf("      --max-spawn-concurrency N\n");
+	printf("                            Maximum number of processes that may be spawned\n");
+	printf("                            in parallel across all applications. Default: %d\n",
+		DEFAULT_MAX_SPAWN_CONCURRENCY);
 	printf("      --memory-limit MB     Restart application processes that go over the\n");
 	printf("                            given memory limit (Enterprise only)\n");
 	printf("\n");
@@ -169,6 +187,30 @@ coreUsage() {
 	printf("                            Vary the turbocache by the cookie of the given name\n");
 	printf("      --disable-turbocaching\n");
 	printf("                            Disable turbocaching\n");
+	printf("      --turbocache-max-entries NUMBER\n");
+	printf("                            Maximum number of responses in the turbocache.\n");
+	printf("                            Default: 1024\n");
+	printf("      --turbocache-max-memory BYTES\n");
+	printf("                            Maximum amount of memory used by the turbocache.\n");
+	printf("                            Default: 8388608\n");
+	printf("      --turbocache-max-body-size BYTES\n");
+	printf("                            Maximum size of a response body in the\n");
+	printf("                            turbocache. Default: 131072\n");
+	printf("      --shared-turbocache   Use a single turbocache for all threads, instead\n");
+	printf("                            of one per thread\n");
+	printf("      --response-splice-threshold BYTES\n");
+	printf("                            Forward application response bodies of at least\n");
+	printf("                            this size with splice() (Linux only). 0 disables\n");
+	printf("                            this. Default: 131072\n");
+	printf("      --sendfile-root PATH  Serve X-Sendfile and X-Accel-Redirect responses\n");
+	printf("                            from files under this directory, instead of\n");
+	printf("                            leaving them to a web server in front of us\n");
+	printf("      --response-compression\n");
+	printf("                            Gzip-compress text responses for clients that\n");
+	printf("                            accept it\n");
+	printf("      --response-compression-level LEVEL\n");
+	printf("                            gzip compression level, from 1 (fastest) to 9\n");
+	printf("                            (smallest). Default: %d\n", DEFAULT_RESPONSE_COMPRESSION_LEVEL);
 	printf("      --no-abort-websockets-on-process-shutdown\n");
 	printf("                            Do not abort WebSocket connections on process\n");
 	printf("                            shutdown or restart\n");
@@ -177,6 +219,14 @@ coreUsage() {
 	printf("      --log-file PATH       Log to the given file.\n");
 	printf("      --log-level LEVEL     Logging level. Default: %d\n", DEFAULT_LOG_LEVEL);
 	printf("      --fd-log-file PATH    Log file descriptor activity to the given file.\n");
+	printf("      --log-async-writes    Write log lines from a background thread instead\n");
+	printf("                            of from the thread that logs them\n");
+	printf("      --log-async-buffer-size NUMBER\n");
+	printf("                            Number of log lines that can be queued for the\n");
+	printf("                            background log writer. Default: 4096\n");
+	printf("      --log-async-overflow-policy block|drop\n");
+	printf("                            What to do when the background log writer's\n");
+	printf("                            queue is full. Default: block\n");
 	printf("      --stat-throttle-rate SECONDS\n");
 	printf("                            Throttle filesystem restart.txt checks to at most\n");
 	printf("                            once per given seconds. Default: %d\n", DEFAULT_STAT_THROTTLE_RATE);
@@ -198,6 +248,12 @@ coreUsage() {
 	printf("                            Default: number of CPU cores (%d)\n",
 		boost::thread::hardware_concurrency());
 	printf("      --cpu-affine          Enable per-thread CPU affinity (Linux only)\n");
+	printf("      --accept-distribution MODE\n");
+	printf("                            How to distribute new clients over threads:\n");
+	printf("                            'round-robin', 'least-loaded' or 'reuseport'.\n");
+	printf("                            Default: round-robin\n");
+	printf("      --http2               Also accept HTTP/2 (prior knowledge h2c)\n");
+	printf("                            connections\n");
 	printf("      --core-file-descriptor-ulimit NUMBER\n");
 	printf("                            Set custom file descriptor ulimit for the core\n");
 	printf("      --admin-panel-url URL\n");
@@ -288,12 +344,24 @@ parseCoreOption(int argc, const char *argv[], int &i, Json::Value &updates) {
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--pool-idle-time")) {
 		updates["pool_idle_time"] = atoi(argv[i + 1]);
 		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--pool-min-idle-connections")) {
+		updates["pool_min_idle_connections"] = atoi(argv[i + 1]);
+		i += 2;
+	} else if (p.isFlag(argv[i], '\0', "--predictive-autoscaling")) {
+		updates["pool_predictive_autoscaling"] = true;
+		i++;
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--max-preloader-idle-time")) {
 		updates["default_max_preloader_idle_time"] = atoi(argv[i + 1]);
 		i += 2;
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--force-max-concurrent-requests-per-process")) {
 		updates["default_force_max_concurrent_requests_per_process"] = atoi(argv[i + 1]);
 		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--spawn-concurrency")) {
+		updates["default_spawn_concurrency"] = atoi(argv[i + 1]);
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--max-spawn-concurrency")) {
+		updates["max_spawn_concurrency"] = atoi(argv[i + 1]);
+		i += 2;
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--min-instances")) {
 		updates["default_min_instances"] = atoi(argv[i + 1]);
 		i += 2;
@@ -339,6 +407,30 @@ parseCoreOption(int argc, const char *argv[], int &i, Json::Value &updates) {
 	} else if (p.isFlag(argv[i], '\0', "--disable-turbocaching")) {
 		updates["turbocaching"] = false;
 		i++;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--turbocache-max-entries")) {
+		updates["turbocache_max_entries"] = atoi(argv[i + 1]);
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--turbocache-max-memory")) {
+		updates["turbocache_max_memory"] = atoi(argv[i + 1]);
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--turbocache-max-body-size")) {
+		updates["turbocache_max_body_size"] = atoi(argv[i + 1]);
+		i += 2;
+	} else if (p.isFlag(argv[i], '\0', "--shared-turbocache")) {
+		updates["turbocache_shared"] = true;
+		i++;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--response-splice-threshold")) {
+		updates["response_splice_threshold"] = atoi(argv[i + 1]);
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--sendfile-root")) {
+		updates["sendfile_root"] = argv[i + 1];
+		i += 2;
+	} else if (p.isFlag(argv[i], '\0', "--response-compression")) {
+		updates["default_response_compression"] = true;
+		i++;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--response-compression-level")) {
+		updates["response_compression_level"] = atoi(argv[i + 1]);
+		i += 2;
 	} else if (p.isFlag(argv[i], '\0', "--no-abort-websockets-on-process-shutdown")) {
 		updates["default_abort_websockets_on_process_shutdown"] = false;
 		i++;
@@ -366,6 +458,15 @@ parseCoreOption(int argc, const char *argv[], int &i, Json::Value &updates) {
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--fd-log-file")) {
 		updates["file_descriptor_log_target"] = argv[i + 1];
 		i += 2;
+	} else if (p.isFlag(argv[i], '\0', "--log-async-writes")) {
+		updates["log_async_writes"] = true;
+		i++;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--log-async-buffer-size")) {
+		updates["log_async_buffer_size"] = atoi(argv[i + 1]);
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--log-async-overflow-policy")) {
+		updates["log_async_overflow_policy"] = argv[i + 1];
+		i += 2;
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--stat-throttle-rate")) {
 		updates["stat_throttle_rate"] = atoi(argv[i + 1]);
 		i += 2;
@@ -390,6 +491,12 @@ parseCoreOption(int argc, const char *argv[], int &i, Json::Value &updates) {
 	} else if (p.isFlag(argv[i], '\0', "--cpu-affine")) {
 		updates["controller_cpu_affine"] = true;
 		i++;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--accept-distribution")) {
+		updates["controller_accept_distribution"] = argv[i + 1];
+		i += 2;
+	} else if (p.isFlag(argv[i], '\0', "--http2")) {
+		updates["controller_http2"] = true;
+		i++;
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--core-file-descriptor-ulimit")) {
 		updates["file_descriptor_ulimit"] = atoi(argv[i + 1]);
 		i += 2;
@@ -27,13 +27,23 @@
 #define _PASSENGER_RESPONSE_CACHE_H_
 
 #include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <sys/uio.h>
 #include <time.h>
+#include <algorithm>
+#include <vector>
 #include <cassert>
 #include <cstring>
+#include <cstdlib>
+#include <cctype>
+#include <psg_sysqueue.h>
+#include <MemoryKit/mbuf.h>
 #include <DataStructures/HashedStaticString.h>
+#include <DataStructures/StringKeyTable.h>
 #include <ServerKit/http_parser.h>
 #include <ServerKit/CookieUtils.h>
 #include <StaticString.h>
+#include <Core/SharedResponseCache.h>
 #include <Utils/DateParsing.h>
 #include <Utils/StrIntUtils.h>
 
@@ -43,22 +53,45 @@ namespace Passenger {
  * Relevant RFCs:
  * https://tools.ietf.org/html/rfc7234    HTTP 1.1 Caching
  * https://tools.ietf.org/html/rfc2109    HTTP State Management Mechanism
+ *
+ * Entries are looked up through a hash table keyed on the cache key.
+ * The cache is bounded both by a maximum number of entries and by a
+ * memory budget; when either limit is reached, the least recently used
+ * entries are evicted. Response bodies are stored in a chain of mbufs
+ * allocated from a pool that belongs to this cache, so that they can be
+ * written to clients without copying.
+ *
+ * Alternatively, entries can be stored in a SharedResponseCache that is
+ * shared with other threads (see `setSharedCache()`). This object then only
+ * implements the HTTP caching rules and keeps statistics for the current
+ * thread. Entries returned by `fetch()` then point into the shared cache,
+ * and may only be used until the thread passes through a quiescent state.
+ *
+ * This class is not thread-safe.
  */
 template<typename Request>
-class ResponseCache {
+class ResponseCache: private boost::noncopyable {
 public:
-	static const unsigned int MAX_ENTRIES     = 8; // Fits in exactly 2 cache lines
-	static const unsigned int MAX_KEY_LENGTH  = 256;
+	static const unsigned int DEFAULT_MAX_ENTRIES = 1024;
+	static const unsigned int DEFAULT_MAX_MEMORY  = 1024 * 1024 * 8;
+	static const unsigned int DEFAULT_MAX_BODY_SIZE = 1024 * 128;
+	static const unsigned int MAX_ENTRIES     = StringKeyTable<unsigned int>::MAX_ITEMS;
+	static const unsigned int MAX_KEY_LENGTH  = StringKeyTable<unsigned int>::MAX_KEY_LENGTH;
 	static const unsigned int MAX_HEADER_SIZE = 4096;
-	static const unsigned int MAX_BODY_SIZE   = 1024 * 32;
+	static const unsigned int BODY_MBUF_BLOCK_CHUNK_SIZE = 1024 * 4;
 	static const unsigned int DEFAULT_HEURISTIC_FRESHNESS = 10;
 	static const unsigned int MIN_HEURISTIC_FRESHNESS = 1;
 
+	/**
+	 * The parts of an entry that are touched on every lookup
+	 * and on every LRU list update.
+	 */
 	struct Header {
 		bool valid;
 		unsigned short keySize;
 		boost::uint32_t hash;
 		time_t date;
+		TAILQ_ENTRY(Header) nextInLruList;
 
 		Header()
 			: valid(false),
@@ -70,20 +103,27 @@ public:
 
 	struct Body {
 		unsigned short httpHeaderSize;
-		unsigned short httpBodySize;
+		unsigned int httpBodySize;
 		time_t expiryDate;
-		char key[MAX_KEY_LENGTH];
-		char httpHeaderData[MAX_HEADER_SIZE];
+		/** The number of bytes this entry counts towards the memory budget. */
+		size_t memoryUsage;
+		/**
+		 * Points to a single malloc()ed buffer that contains the
+		 * key, immediately followed by the HTTP header data.
+		 */
+		char *key;
+		char *httpHeaderData;
 		// This data is dechunked.
-		char httpBodyData[MAX_BODY_SIZE];
+		std::vector<MemoryKit::mbuf> httpBodyData;
 
 		Body()
 			: httpHeaderSize(0),
 			  httpBodySize(0),
-			  expiryDate(0)
-		{
-			key[0] = httpHeaderData[0] = httpBodyData[0] = '\0';
-		}
+			  expiryDate(0),
+			  memoryUsage(0),
+			  key(NULL),
+			  httpHeaderData(NULL)
+			{ }
 	};
 
 	struct Entry {
@@ -140,10 +180,68 @@ private:
 	HashedStaticString COOKIE;
 	HashedStaticString PASSENGER_VARY_TURBOCACHE_BY_COOKIE;
 
+	TAILQ_HEAD(LruList, Header);
+
 	unsigned int fetches, hits, stores, storeSuccesses;
+	unsigned int evictions;
 
-	Header headers[MAX_ENTRIES];
-	Body bodies[MAX_ENTRIES];
+	unsigned int maxEntries;
+	size_t maxMemory;
+	unsigned int maxBodySize;
+
+	Header *headers;
+	Body *bodies;
+	/** Maps cache keys to indices in `headers` and `bodies`. */
+	StringKeyTable<unsigned int> index;
+	/**
+	 * StringKeyTable does not reclaim key storage upon erasing. This is the
+	 * number of bytes that erased keys still occupy; once it gets too large,
+	 * we rebuild the index.
+	 */
+	unsigned int indexGarbageSize;
+	/** Valid entries, most recently used first. */
+	LruList lruList;
+	/** Indices of invalid entries. */
+	std::vector<unsigned int> freeIndices;
+	unsigned int entryCount;
+	size_t memoryUsage;
+	MemoryKit::mbuf_pool bodyMbufPool;
+
+	SharedResponseCache *sharedCache;
+	/** Describes the last entry that was looked up in the shared cache. */
+	Header sharedEntryHeader;
+	Body sharedEntryBody;
+
+	static unsigned int normalizeMaxEntries(unsigned int value) {
+		if (value == 0) {
+			return 1;
+		} else if (value > MAX_ENTRIES) {
+			return MAX_ENTRIES;
+		} else {
+			return value;
+		}
+	}
+
+	void allocateEntries() {
+		headers = new Header[maxEntries];
+		bodies = new Body[maxEntries];
+		TAILQ_INIT(&lruList);
+		freeIndices.clear();
+		freeIndices.reserve(maxEntries);
+		for (unsigned int i = maxEntries; i > 0; i--) {
+			freeIndices.push_back(i - 1);
+		}
+		entryCount = 0;
+		memoryUsage = 0;
+	}
+
+	void freeEntries() {
+		clear();
+		delete[] headers;
+		delete[] bodies;
+		headers = NULL;
+		bodies = NULL;
+	}
 
 	unsigned int calculateKeyLength(const LString * restrict host,
 		const LString * restrict varyCookie,
@@ -162,7 +260,12 @@ private:
 		}
 	}
 
-	void generateKey(bool https, const StaticString &path,
+	/**
+	 * The protocol flag is 'H' or 'S' (HTTPS). It is lowercase for
+	 * the gzip-compressed variant of a response, which is cached
+	 * separately from the uncompressed variant.
+	 */
+	void generateKey(bool https, bool compressed, const StaticString &path,
 		const LString * restrict host,
 		const LString * restrict varyCookie,
 		char * restrict output,
@@ -173,9 +276,9 @@ private:
 		const LString::Part *part;
 
 		if (https) {
-			pos = appendData(pos, end, "S", 1);
+			pos = appendData(pos, end, compressed ? "s" : "S", 1);
 		} else {
-			pos = appendData(pos, end, "H", 1);
+			pos = appendData(pos, end, compressed ? "h" : "H", 1);
 		}
 
 		if (host != NULL) {
@@ -217,34 +320,151 @@ private:
 	}
 
 	Entry lookup(const HashedStaticString &cacheKey) {
-		for (unsigned int i = 0; i < MAX_ENTRIES; i++) {
-			if (headers[i].valid
-			 && headers[i].hash == cacheKey.hash()
-			 && cacheKey == StaticString(bodies[i].key, headers[i].keySize))
-			{
-				return Entry(i, &headers[i], &bodies[i]);
-			}
+		unsigned int *i;
+
+		if (sharedCache != NULL) {
+			return lookupShared(cacheKey);
+		} else if (index.lookup(cacheKey, &i)) {
+			assert(headers[*i].valid);
+			return Entry(*i, &headers[*i], &bodies[*i]);
+		} else {
+			return Entry();
 		}
-		return Entry();
 	}
 
-	Entry lookupInvalidOrOldest() {
-		int oldest = -1;
+	Entry lookupShared(const HashedStaticString &cacheKey) {
+		return describeSharedEntry(sharedCache->lookup(cacheKey));
+	}
 
-		for (unsigned int i = 0; i < MAX_ENTRIES; i++) {
-			if (!headers[i].valid) {
-				return Entry(i, &headers[i], &bodies[i]);
-			} else if (oldest == -1 || headers[i].date < headers[oldest].date) {
-				oldest = i;
-			}
+	Entry describeSharedEntry(const SharedResponseCache::Entry *entry) {
+		if (entry == NULL) {
+			return Entry();
 		}
 
-		return Entry(oldest, &headers[oldest], &bodies[oldest]);
+		sharedEntryHeader.valid   = true;
+		sharedEntryHeader.hash    = entry->hash;
+		sharedEntryHeader.keySize = entry->keySize;
+		sharedEntryHeader.date    = entry->date;
+		sharedEntryBody.expiryDate = entry->expiryDate;
+		sharedEntryBody.memoryUsage = entry->memoryUsage;
+		sharedEntryBody.key = const_cast<char *>(entry->getKey());
+		sharedEntryBody.httpHeaderData = const_cast<char *>(entry->getHttpHeaderData());
+		sharedEntryBody.httpHeaderSize = entry->httpHeaderSize;
+		sharedEntryBody.httpBodySize   = entry->httpBodySize;
+		sharedEntryBody.httpBodyData.clear();
+		if (entry->httpBodySize > 0) {
+			// This mbuf does not own the data, so it must not outlive
+			// the current event loop iteration.
+			sharedEntryBody.httpBodyData.push_back(MemoryKit::mbuf(
+				entry->getHttpBodyData(), entry->httpBodySize));
+		}
+		return Entry(0, &sharedEntryHeader, &sharedEntryBody);
 	}
 
-	OXT_FORCE_INLINE
-	void erase(unsigned int index) {
-		headers[index].valid = false;
+	void erase(const Entry &entry) {
+		if (sharedCache != NULL) {
+			sharedCache->erase(HashedStaticString(entry.body->key,
+				entry.header->keySize, entry.header->hash));
+		} else {
+			erase(entry.index);
+		}
+	}
+
+	void erase(unsigned int i) {
+		Header *header = &headers[i];
+		Body *body = &bodies[i];
+
+		assert(header->valid);
+		index.erase(HashedStaticString(body->key, header->keySize, header->hash));
+		indexGarbageSize += header->keySize + 1;
+		TAILQ_REMOVE(&lruList, header, nextInLruList);
+
+		free(body->key);
+		body->key = NULL;
+		body->httpHeaderData = NULL;
+		body->httpBodyData.clear();
+		memoryUsage -= body->memoryUsage;
+		header->valid = false;
+
+		freeIndices.push_back(i);
+		entryCount--;
+
+		if (indexGarbageSize > 1024 * 64 && indexGarbageSize > entryCount * MAX_KEY_LENGTH) {
+			rebuildIndex();
+		}
+	}
+
+	void rebuildIndex() {
+		Header *header;
+
+		index.clear();
+		indexGarbageSize = 0;
+		TAILQ_FOREACH(header, &lruList, nextInLruList) {
+			unsigned int i = header - headers;
+			index.insert(HashedStaticString(bodies[i].key, header->keySize,
+				header->hash), i);
+		}
+	}
+
+	void touch(const Entry &entry) {
+		if (sharedCache != NULL) {
+			// SharedResponseCache::lookup() already marked it as used.
+			return;
+		}
+		TAILQ_REMOVE(&lruList, entry.header, nextInLruList);
+		TAILQ_INSERT_HEAD(&lruList, entry.header, nextInLruList);
+	}
+
+	/**
+	 * Evicts least recently used entries until there is room
+	 * for one more entry of the given size.
+	 */
+	void makeRoom(size_t entryMemoryUsage) {
+		while (!TAILQ_EMPTY(&lruList)
+			&& (entryCount >= maxEntries || memoryUsage + entryMemoryUsage > maxMemory))
+		{
+			Header *lru = TAILQ_LAST(&lruList, LruList);
+			erase(lru - headers);
+			evictions++;
+		}
+	}
+
+	size_t calculateMemoryUsage(unsigned int keySize, unsigned int headerSize,
+		unsigned int bodySize)
+	{
+		size_t blockDataSize = MemoryKit::mbuf_pool_data_size(&bodyMbufPool);
+		size_t nblocks = (bodySize + blockDataSize - 1) / blockDataSize;
+		return keySize + headerSize + nblocks * bodyMbufPool.mbuf_block_chunk_size;
+	}
+
+	void copyBody(Body *body, const LString *data) {
+		const LString::Part *part = data->start;
+		unsigned int partOffset = 0;
+		unsigned int remaining = data->size;
+
+		body->httpBodyData.reserve((remaining
+			+ MemoryKit::mbuf_pool_data_size(&bodyMbufPool) - 1)
+			/ MemoryKit::mbuf_pool_data_size(&bodyMbufPool));
+		while (remaining > 0) {
+			MemoryKit::mbuf buffer(MemoryKit::mbuf_get(&bodyMbufPool));
+			unsigned int size = std::min<unsigned int>(remaining, buffer.size());
+			unsigned int copied = 0;
+
+			while (copied < size) {
+				unsigned int n = std::min<unsigned int>(size - copied,
+					part->size - partOffset);
+				memcpy(buffer.start + copied, part->data + partOffset, n);
+				copied += n;
+				partOffset += n;
+				if (partOffset == part->size) {
+					part = part->next;
+					partOffset = 0;
+				}
+			}
+
+			body->httpBodyData.push_back(MemoryKit::mbuf(buffer, 0, size));
+			remaining -= size;
+		}
 	}
 
 	time_t parseDate(psg_pool_t *pool, const LString *date, ev_tstamp now) const {
@@ -400,16 +620,33 @@ private:
 		}
 
 		char *key = (char *) psg_pnalloc(req->pool, keySize);
-		generateKey(https, path, req->host, req->varyCookie, key, keySize);
+		generateKey(https, false, path, req->host, req->varyCookie, key, keySize);
+		eraseAllVariants(key, keySize);
+	}
 
-		Entry entry(lookup(StaticString(key, keySize)));
-		if (entry.valid()) {
-			entry.header->valid = false;
+	/**
+	 * Erases the entry with the given key, as well as the entry for the
+	 * other (compressed or uncompressed) variant of the same response.
+	 * Modifies the key.
+	 */
+	void eraseAllVariants(char *key, unsigned int keySize) {
+		for (unsigned int i = 0; i < 2; i++) {
+			Entry entry(lookup(StaticString(key, keySize)));
+			if (entry.valid()) {
+				erase(entry);
+			}
+			if (isupper(key[0])) {
+				key[0] = tolower(key[0]);
+			} else {
+				key[0] = toupper(key[0]);
+			}
 		}
 	}
 
 public:
-	ResponseCache()
+	ResponseCache(unsigned int _maxEntries = DEFAULT_MAX_ENTRIES,
+		size_t _maxMemory = DEFAULT_MAX_MEMORY,
+		unsigned int _maxBodySize = DEFAULT_MAX_BODY_SIZE)
 		: CACHE_CONTROL("cache-control"),
 		  PRAGMA_CONST("pragma"),
 		  AUTHORIZATION("authorization"),
@@ -426,8 +663,49 @@ public:
 		  fetches(0),
 		  hits(0),
 		  stores(0),
-		  storeSuccesses(0)
-		{ }
+		  storeSuccesses(0),
+		  evictions(0),
+		  maxEntries(normalizeMaxEntries(_maxEntries)),
+		  maxMemory(_maxMemory),
+		  maxBodySize(_maxBodySize),
+		  indexGarbageSize(0),
+		  sharedCache(NULL)
+	{
+		bodyMbufPool.mbuf_block_chunk_size = BODY_MBUF_BLOCK_CHUNK_SIZE;
+		MemoryKit::mbuf_pool_init(&bodyMbufPool);
+		allocateEntries();
+	}
+
+	~ResponseCache() {
+		freeEntries();
+		MemoryKit::mbuf_pool_deinit(&bodyMbufPool);
+	}
+
+	/**
+	 * Changes the cache limits. This clears the cache.
+	 */
+	void setLimits(unsigned int _maxEntries, size_t _maxMemory, unsigned int _maxBodySize) {
+		freeEntries();
+		maxEntries = normalizeMaxEntries(_maxEntries);
+		maxMemory = _maxMemory;
+		maxBodySize = _maxBodySize;
+		allocateEntries();
+	}
+
+	/**
+	 * Makes this object store entries in the given shared cache instead
+	 * of in its own storage. Pass NULL to switch back. This clears the
+	 * cache's own storage.
+	 */
+	void setSharedCache(SharedResponseCache *cache) {
+		clear();
+		sharedCache = cache;
+	}
+
+	OXT_FORCE_INLINE
+	SharedResponseCache *getSharedCache() const {
+		return sharedCache;
+	}
 
 	OXT_FORCE_INLINE
 	unsigned int getFetches() const {
@@ -446,7 +724,7 @@ public:
 
 	OXT_FORCE_INLINE
 	unsigned int getStores() const {
-		return fetches;
+		return stores;
 	}
 
 	OXT_FORCE_INLINE
@@ -459,6 +737,56 @@ public:
 		return storeSuccesses / (double) stores;
 	}
 
+	OXT_FORCE_INLINE
+	unsigned int getEvictions() const {
+		if (sharedCache != NULL) {
+			return sharedCache->getEvictions();
+		} else {
+			return evictions;
+		}
+	}
+
+	OXT_FORCE_INLINE
+	unsigned int getEntryCount() const {
+		if (sharedCache != NULL) {
+			return sharedCache->getEntryCount();
+		} else {
+			return entryCount;
+		}
+	}
+
+	OXT_FORCE_INLINE
+	unsigned int getMaxEntries() const {
+		if (sharedCache != NULL) {
+			return sharedCache->getMaxEntries();
+		} else {
+			return maxEntries;
+		}
+	}
+
+	OXT_FORCE_INLINE
+	size_t getMemoryUsage() const {
+		if (sharedCache != NULL) {
+			return sharedCache->getMemoryUsage();
+		} else {
+			return memoryUsage;
+		}
+	}
+
+	OXT_FORCE_INLINE
+	size_t getMaxMemory() const {
+		if (sharedCache != NULL) {
+			return sharedCache->getMaxMemory();
+		} else {
+			return maxMemory;
+		}
+	}
+
+	OXT_FORCE_INLINE
+	unsigned int getMaxBodySize() const {
+		return maxBodySize;
+	}
+
 	// For decreasing the store success ratio without calling store().
 	OXT_FORCE_INLINE
 	void incStores() {
@@ -470,12 +798,19 @@ public:
 		hits = 0;
 		stores = 0;
 		storeSuccesses = 0;
+		evictions = 0;
 	}
 
+	/**
+	 * Removes all entries from this cache's own storage. This does not
+	 * affect the shared cache, if any.
+	 */
 	void clear() {
-		for (unsigned int i = 0; i < MAX_ENTRIES; i++) {
-			headers[i].valid = false;
+		while (!TAILQ_EMPTY(&lruList)) {
+			erase(TAILQ_FIRST(&lruList) - headers);
 		}
+		index.clear();
+		indexGarbageSize = 0;
 	}
 
 
@@ -523,7 +858,8 @@ public:
 		}
 
 		char *key = (char *) psg_pnalloc(req->pool, size);
-		generateKey(req->https, StaticString(req->path.start->data, req->path.size),
+		generateKey(req->https, req->responseCompressionAllowed,
+			StaticString(req->path.start->data, req->path.size),
 			req->host, req->varyCookie, key, size);
 		req->cacheKey = HashedStaticString(key, size);
 		return true;
@@ -550,9 +886,10 @@ public:
 		if (entry.valid()) {
 			hits++;
 			if (isFresh(entry, now)) {
+				touch(entry);
 				return entry;
 			} else {
-				erase(entry.index);
+				erase(entry);
 				Entry result;
 				result.cacheMissReason = Entry::NOT_FRESH;
 				return result;
@@ -625,12 +962,27 @@ public:
 			|| req->appResponse.expiresHeader != NULL;
 	}
 
-	// @pre requestAllowsStoring()
-	// @pre prepareRequestForStoring()
-	Entry store(Request *req, ev_tstamp now, unsigned int headerSize, unsigned int bodySize) {
+	/**
+	 * Stores the response to the given request, consisting of the given
+	 * header data (without Content-Length and other fields that are
+	 * generated when writing the response) and the given dechunked body.
+	 *
+	 * @pre requestAllowsStoring()
+	 * @pre prepareRequestForStoring()
+	 */
+	Entry store(Request *req, ev_tstamp now, const struct iovec *headerBuffers,
+		unsigned int nHeaderBuffers, const LString *body)
+	{
+		unsigned int headerSize = 0;
+		unsigned int bodySize = body->size;
+		unsigned int i;
+
 		stores++;
 
-		if (headerSize > MAX_HEADER_SIZE || bodySize > MAX_BODY_SIZE) {
+		for (i = 0; i < nHeaderBuffers; i++) {
+			headerSize += headerBuffers[i].iov_len;
+		}
+		if (headerSize > MAX_HEADER_SIZE || bodySize > maxBodySize) {
 			return Entry();
 		}
 
@@ -645,18 +997,57 @@ public:
 		}
 
 		const HashedStaticString &cacheKey = req->cacheKey;
+		if (sharedCache != NULL) {
+			Entry entry(describeSharedEntry(sharedCache->store(cacheKey,
+				responseDate, expiryDate, headerBuffers, nHeaderBuffers, body)));
+			if (entry.valid()) {
+				storeSuccesses++;
+			}
+			return entry;
+		}
+
+		size_t entryMemoryUsage = calculateMemoryUsage(cacheKey.size(),
+			headerSize, bodySize);
+		if (entryMemoryUsage > maxMemory) {
+			return Entry();
+		}
+
 		Entry entry(lookup(cacheKey));
-		if (!entry.valid()) {
-			entry = lookupInvalidOrOldest();
-			entry.header->valid   = true;
-			entry.header->hash    = cacheKey.hash();
-			entry.header->keySize = cacheKey.size();
-			memcpy(entry.body->key, cacheKey.data(), cacheKey.size());
-		}
-		entry.header->date     = responseDate;
+		if (entry.valid()) {
+			erase(entry);
+		}
+		makeRoom(entryMemoryUsage);
+
+		char *keyAndHeaderData = (char *) malloc(cacheKey.size() + headerSize);
+		if (OXT_UNLIKELY(keyAndHeaderData == NULL)) {
+			return Entry();
+		}
+
+		i = freeIndices.back();
+		freeIndices.pop_back();
+		entry = Entry(i, &headers[i], &bodies[i]);
+		entry.header->valid   = true;
+		entry.header->hash    = cacheKey.hash();
+		entry.header->keySize = cacheKey.size();
+		entry.header->date    = responseDate;
 		entry.body->expiryDate = expiryDate;
+		entry.body->memoryUsage = entryMemoryUsage;
+		entry.body->key = keyAndHeaderData;
+		entry.body->httpHeaderData = keyAndHeaderData + cacheKey.size();
 		entry.body->httpHeaderSize = headerSize;
 		entry.body->httpBodySize   = bodySize;
+		memcpy(entry.body->key, cacheKey.data(), cacheKey.size());
+		char *pos = entry.body->httpHeaderData;
+		for (unsigned int j = 0; j < nHeaderBuffers; j++) {
+			memcpy(pos, headerBuffers[j].iov_base, headerBuffers[j].iov_len);
+			pos += headerBuffers[j].iov_len;
+		}
+		copyBody(entry.body, body);
+
+		index.insert(cacheKey, i);
+		TAILQ_INSERT_HEAD(&lruList, entry.header, nextInLruList);
+		entryCount++;
+		memoryUsage += entryMemoryUsage;
 		storeSuccesses++;
 		return entry;
 	}
@@ -670,25 +1061,37 @@ public:
 
 	// @pre requestAllowsInvalidating()
 	void invalidate(Request *req) {
-		Entry entry(lookup(req->cacheKey));
-		if (entry.valid()) {
-			entry.header->valid = false;
-		}
+		char *key = (char *) psg_pnalloc(req->pool, req->cacheKey.size());
+		memcpy(key, req->cacheKey.data(), req->cacheKey.size());
+		eraseAllVariants(key, req->cacheKey.size());
 
 		invalidateLocation(req, LOCATION);
 		invalidateLocation(req, CONTENT_LOCATION);
 	}
 
 
+	/**
+	 * Describes all entries, most recently used first.
+	 */
 	string inspect() const {
 		stringstream stream;
-		for (unsigned int i = 0; i < MAX_ENTRIES; i++) {
+		const Header *header;
+
+		stream << " " << getEntryCount() << "/" << getMaxEntries() << " entries, "
+			<< getMemoryUsage() << "/" << getMaxMemory() << " bytes";
+		if (sharedCache != NULL) {
+			stream << " (shared)\n";
+			return stream.str();
+		}
+		stream << "\n";
+		TAILQ_FOREACH(header, &lruList, nextInLruList) {
+			unsigned int i = header - headers;
 			time_t expiryDate = bodies[i].expiryDate;
-			stream << " #" << i << ": valid=" << headers[i].valid
-				<< ", hash=" << headers[i].hash
+			stream << " #" << i << ": valid=" << header->valid
+				<< ", hash=" << header->hash
 				<< ", expiryDate=" << expiryDate
-				<< ", keySize=" << headers[i].keySize << ", key=\""
-				<< cEscapeString(StaticString(bodies[i].key, headers[i].keySize)) << "\"\n";
+				<< ", keySize=" << header->keySize << ", key=\""
+				<< cEscapeString(StaticString(bodies[i].key, header->keySize)) << "\"\n";
 		}
 		return stream.str();
 	}
@@ -0,0 +1,508 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_SHARED_RESPONSE_CACHE_H_
+#define _PASSENGER_SHARED_RESPONSE_CACHE_H_
+
+#include <boost/thread.hpp>
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <oxt/macros.hpp>
+#include <sys/uio.h>
+#include <time.h>
+#include <new>
+#include <vector>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <DataStructures/HashedStaticString.h>
+#include <DataStructures/LString.h>
+#include <StaticString.h>
+
+namespace Passenger {
+
+using namespace std;
+
+
+/**
+ * Response storage for the turbocache that is shared by all Controller
+ * threads, so that a response only has to be stored once before every
+ * thread can serve it.
+ *
+ * Readers never block: entries are immutable once published, and are
+ * linked into hash buckets with atomic pointers. Writers (storing,
+ * erasing and evicting) serialize on a mutex, unlink entries from the
+ * buckets, and hand them over to a quiescent-state-based reclamation
+ * scheme: an unlinked entry is only freed after every reader thread has
+ * passed through a quiescent state, meaning that it can no longer hold
+ * a pointer to it.
+ *
+ * Every reader thread has a thread index (0..threadCount-1) and must:
+ *
+ *  - call `threadOnline()` before it starts looking up entries, and
+ *    periodically afterwards (e.g. once per event loop iteration);
+ *  - call `threadOffline()` before it blocks for a potentially long time
+ *    (e.g. before the event loop sleeps), so that it does not hold up
+ *    reclamation.
+ *
+ * Entry pointers returned by `lookup()` are valid until the thread's next
+ * call to `threadOnline()` or `threadOffline()`.
+ *
+ * Eviction uses the CLOCK algorithm. Readers set a per-entry reference
+ * bit instead of moving entries around in a list, so that hits do not
+ * have to write to shared data structures.
+ */
+class SharedResponseCache: private boost::noncopyable {
+public:
+	struct Entry {
+		boost::atomic<Entry *> nextInBucket;
+		mutable boost::atomic<bool> referenced;
+		boost::uint32_t hash;
+		unsigned short keySize;
+		unsigned short httpHeaderSize;
+		unsigned int httpBodySize;
+		/** Index in `slots`. Only accessed by writers. */
+		unsigned int slot;
+		time_t date;
+		time_t expiryDate;
+		size_t memoryUsage;
+		// Followed by the key, the HTTP header data and the (dechunked) body.
+		char data[1];
+
+		const char *getKey() const {
+			return data;
+		}
+
+		const char *getHttpHeaderData() const {
+			return data + keySize;
+		}
+
+		const char *getHttpBodyData() const {
+			return data + keySize + httpHeaderSize;
+		}
+	};
+
+private:
+	struct ThreadState {
+		/**
+		 * The global epoch at the time this thread last passed through
+		 * a quiescent state, or 0 if the thread is offline.
+		 */
+		boost::atomic<boost::uint64_t> epoch;
+		char padding[64 - sizeof(boost::atomic<boost::uint64_t>)];
+
+		ThreadState()
+			: epoch(0)
+			{ }
+	};
+
+	struct RetiredEntry {
+		Entry *entry;
+		boost::uint64_t epoch;
+
+		RetiredEntry(Entry *_entry, boost::uint64_t _epoch)
+			: entry(_entry),
+			  epoch(_epoch)
+			{ }
+	};
+
+	const unsigned int maxEntries;
+	const size_t maxMemory;
+	const unsigned int threadCount;
+	const unsigned int bucketMask;
+	boost::atomic<Entry *> *buckets;
+	ThreadState *threadStates;
+	boost::atomic<boost::uint64_t> globalEpoch;
+
+	/** Protects all fields below. */
+	mutable boost::mutex syncher;
+	vector<Entry *> slots;
+	vector<unsigned int> freeSlots;
+	vector<RetiredEntry> retiredEntries;
+	unsigned int clockHand;
+	unsigned int entryCount;
+	size_t memoryUsage;
+	unsigned int evictions;
+
+	static unsigned int calculateBucketCount(unsigned int maxEntries) {
+		unsigned int result = 16;
+		while (result < maxEntries * 2) {
+			result *= 2;
+		}
+		return result;
+	}
+
+	static bool keyEquals(const Entry *entry, const HashedStaticString &key) {
+		return entry->hash == key.hash()
+			&& entry->keySize == key.size()
+			&& memcmp(entry->getKey(), key.data(), key.size()) == 0;
+	}
+
+	static size_t calculateMemoryUsage(unsigned int keySize, unsigned int headerSize,
+		unsigned int bodySize)
+	{
+		return sizeof(Entry) + keySize + headerSize + bodySize;
+	}
+
+	boost::atomic<Entry *> &getBucket(boost::uint32_t hash) const {
+		return buckets[hash & bucketMask];
+	}
+
+	Entry *lookupWithLock(const HashedStaticString &key) const {
+		Entry *entry = getBucket(key.hash()).load(boost::memory_order_relaxed);
+		while (entry != NULL && !keyEquals(entry, key)) {
+			entry = entry->nextInBucket.load(boost::memory_order_relaxed);
+		}
+		return entry;
+	}
+
+	void unlinkWithLock(Entry *entry) {
+		boost::atomic<Entry *> *link = &getBucket(entry->hash);
+		Entry *current = link->load(boost::memory_order_relaxed);
+
+		while (current != entry) {
+			assert(current != NULL);
+			link = &current->nextInBucket;
+			current = link->load(boost::memory_order_relaxed);
+		}
+		// Readers that are currently looking at this entry can still
+		// follow its `nextInBucket` pointer, because the entry is not
+		// freed until they have passed through a quiescent state.
+		link->store(entry->nextInBucket.load(boost::memory_order_relaxed),
+			boost::memory_order_release);
+
+		slots[entry->slot] = NULL;
+		freeSlots.push_back(entry->slot);
+		entryCount--;
+		memoryUsage -= entry->memoryUsage;
+		retiredEntries.push_back(RetiredEntry(entry,
+			globalEpoch.fetch_add(1, boost::memory_order_seq_cst) + 1));
+	}
+
+	void evictOneWithLock() {
+		assert(entryCount > 0);
+		while (true) {
+			Entry *entry = slots[clockHand];
+			clockHand = (clockHand + 1) % maxEntries;
+			if (entry == NULL) {
+				continue;
+			} else if (entry->referenced.load(boost::memory_order_relaxed)) {
+				entry->referenced.store(false, boost::memory_order_relaxed);
+			} else {
+				unlinkWithLock(entry);
+				evictions++;
+				return;
+			}
+		}
+	}
+
+	boost::uint64_t getOldestThreadEpoch() const {
+		boost::uint64_t result = globalEpoch.load(boost::memory_order_seq_cst);
+		for (unsigned int i = 0; i < threadCount; i++) {
+			boost::uint64_t epoch = threadStates[i].epoch.load(boost::memory_order_seq_cst);
+			if (epoch != 0 && epoch < result) {
+				result = epoch;
+			}
+		}
+		return result;
+	}
+
+	void reclaimWithLock() {
+		if (retiredEntries.empty()) {
+			return;
+		}
+
+		boost::uint64_t oldestThreadEpoch = getOldestThreadEpoch();
+		vector<RetiredEntry>::iterator it, end = retiredEntries.end();
+		vector<RetiredEntry>::iterator dest = retiredEntries.begin();
+
+		for (it = retiredEntries.begin(); it != end; it++) {
+			if (it->epoch <= oldestThreadEpoch) {
+				destroyEntry(it->entry);
+			} else {
+				*dest = *it;
+				dest++;
+			}
+		}
+		retiredEntries.erase(dest, end);
+	}
+
+	static Entry *createEntry(const HashedStaticString &key, time_t date,
+		time_t expiryDate, const struct iovec *headerBuffers,
+		unsigned int nHeaderBuffers, unsigned int headerSize,
+		const LString *body)
+	{
+		size_t size = calculateMemoryUsage(key.size(), headerSize, body->size);
+		void *mem = malloc(size);
+		if (OXT_UNLIKELY(mem == NULL)) {
+			return NULL;
+		}
+
+		Entry *entry = new (mem) Entry();
+		entry->nextInBucket.store(NULL, boost::memory_order_relaxed);
+		entry->referenced.store(false, boost::memory_order_relaxed);
+		entry->hash = key.hash();
+		entry->keySize = key.size();
+		entry->httpHeaderSize = headerSize;
+		entry->httpBodySize = body->size;
+		entry->date = date;
+		entry->expiryDate = expiryDate;
+		entry->memoryUsage = size;
+
+		char *pos = entry->data;
+		memcpy(pos, key.data(), key.size());
+		pos += key.size();
+		for (unsigned int i = 0; i < nHeaderBuffers; i++) {
+			memcpy(pos, headerBuffers[i].iov_base, headerBuffers[i].iov_len);
+			pos += headerBuffers[i].iov_len;
+		}
+		const LString::Part *part = body->start;
+		while (part != NULL) {
+			memcpy(pos, part->data, part->size);
+			pos += part->size;
+			part = part->next;
+		}
+
+		return entry;
+	}
+
+	static void destroyEntry(Entry *entry) {
+		entry->~Entry();
+		free(entry);
+	}
+
+public:
+	SharedResponseCache(unsigned int _maxEntries, size_t _maxMemory,
+		unsigned int _threadCount)
+		: maxEntries(_maxEntries == 0 ? 1 : _maxEntries),
+		  maxMemory(_maxMemory),
+		  threadCount(_threadCount),
+		  bucketMask(calculateBucketCount(maxEntries) - 1),
+		  globalEpoch(1),
+		  clockHand(0),
+		  entryCount(0),
+		  memoryUsage(0),
+		  evictions(0)
+	{
+		buckets = new boost::atomic<Entry *>[bucketMask + 1];
+		for (unsigned int i = 0; i <= bucketMask; i++) {
+			buckets[i].store(NULL, boost::memory_order_relaxed);
+		}
+		threadStates = new ThreadState[threadCount];
+		slots.resize(maxEntries, NULL);
+		freeSlots.reserve(maxEntries);
+		for (unsigned int i = maxEntries; i > 0; i--) {
+			freeSlots.push_back(i - 1);
+		}
+	}
+
+	/**
+	 * @pre No threads are online.
+	 */
+	~SharedResponseCache() {
+		for (unsigned int i = 0; i < maxEntries; i++) {
+			if (slots[i] != NULL) {
+				destroyEntry(slots[i]);
+			}
+		}
+		for (unsigned int i = 0; i < retiredEntries.size(); i++) {
+			destroyEntry(retiredEntries[i].entry);
+		}
+		delete[] buckets;
+		delete[] threadStates;
+	}
+
+
+	/****** Reader thread registration ******/
+
+	/**
+	 * Marks the given thread as online, and reports that it is in a
+	 * quiescent state: it no longer holds any Entry pointers that it
+	 * obtained earlier.
+	 */
+	void threadOnline(unsigned int threadIndex) {
+		assert(threadIndex < threadCount);
+		threadStates[threadIndex].epoch.store(
+			globalEpoch.load(boost::memory_order_seq_cst),
+			boost::memory_order_seq_cst);
+		boost::atomic_thread_fence(boost::memory_order_seq_cst);
+	}
+
+	/**
+	 * Marks the given thread as offline. An offline thread must not
+	 * call `lookup()`, and does not hold up reclamation.
+	 */
+	void threadOffline(unsigned int threadIndex) {
+		assert(threadIndex < threadCount);
+		threadStates[threadIndex].epoch.store(0, boost::memory_order_seq_cst);
+	}
+
+
+	/****** Reading ******/
+
+	/**
+	 * Looks up the entry with the given key. Does not take any locks.
+	 *
+	 * @pre The calling thread is online.
+	 */
+	const Entry *lookup(const HashedStaticString &key) const {
+		const Entry *entry = getBucket(key.hash()).load(boost::memory_order_acquire);
+		while (entry != NULL) {
+			if (keyEquals(entry, key)) {
+				// Avoid writing to the cache line if we don't have to.
+				if (!entry->referenced.load(boost::memory_order_relaxed)) {
+					entry->referenced.store(true, boost::memory_order_relaxed);
+				}
+				return entry;
+			}
+			entry = entry->nextInBucket.load(boost::memory_order_acquire);
+		}
+		return NULL;
+	}
+
+
+	/****** Writing ******/
+
+	/**
+	 * Stores the given response, replacing any existing entry with the
+	 * same key. Evicts entries if necessary. Returns the new entry, or NULL
+	 * if the response could not be stored.
+	 *
+	 * The returned pointer is subject to the same rules as those
+	 * returned by `lookup()`.
+	 */
+	const Entry *store(const HashedStaticString &key, time_t date, time_t expiryDate,
+		const struct iovec *headerBuffers, unsigned int nHeaderBuffers,
+		const LString *body)
+	{
+		unsigned int headerSize = 0;
+
+		for (unsigned int i = 0; i < nHeaderBuffers; i++) {
+			headerSize += headerBuffers[i].iov_len;
+		}
+		if (calculateMemoryUsage(key.size(), headerSize, body->size) > maxMemory) {
+			return NULL;
+		}
+
+		// Build the entry outside the lock.
+		Entry *entry = createEntry(key, date, expiryDate, headerBuffers,
+			nHeaderBuffers, headerSize, body);
+		if (OXT_UNLIKELY(entry == NULL)) {
+			return NULL;
+		}
+
+		boost::lock_guard<boost::mutex> l(syncher);
+		Entry *existing = lookupWithLock(key);
+		if (existing != NULL) {
+			unlinkWithLock(existing);
+		}
+		while (entryCount > 0
+			&& (entryCount >= maxEntries || memoryUsage + entry->memoryUsage > maxMemory))
+		{
+			evictOneWithLock();
+		}
+
+		entry->slot = freeSlots.back();
+		freeSlots.pop_back();
+		slots[entry->slot] = entry;
+		entryCount++;
+		memoryUsage += entry->memoryUsage;
+
+		boost::atomic<Entry *> &bucket = getBucket(entry->hash);
+		entry->nextInBucket.store(bucket.load(boost::memory_order_relaxed),
+			boost::memory_order_relaxed);
+		bucket.store(entry, boost::memory_order_release);
+
+		reclaimWithLock();
+		return entry;
+	}
+
+	void erase(const HashedStaticString &key) {
+		boost::lock_guard<boost::mutex> l(syncher);
+		Entry *entry = lookupWithLock(key);
+		if (entry != NULL) {
+			unlinkWithLock(entry);
+		}
+		reclaimWithLock();
+	}
+
+	void clear() {
+		boost::lock_guard<boost::mutex> l(syncher);
+		for (unsigned int i = 0; i < maxEntries; i++) {
+			if (slots[i] != NULL) {
+				unlinkWithLock(slots[i]);
+			}
+		}
+		reclaimWithLock();
+	}
+
+	/**
+	 * Frees unlinked entries that no reader can reference anymore.
+	 * Storing and erasing already do this, so you only need to call
+	 * this if the cache isn't modified for a long time.
+	 */
+	void reclaim() {
+		boost::lock_guard<boost::mutex> l(syncher);
+		reclaimWithLock();
+	}
+
+
+	/****** Statistics ******/
+
+	unsigned int getMaxEntries() const {
+		return maxEntries;
+	}
+
+	size_t getMaxMemory() const {
+		return maxMemory;
+	}
+
+	unsigned int getEntryCount() const {
+		boost::lock_guard<boost::mutex> l(syncher);
+		return entryCount;
+	}
+
+	size_t getMemoryUsage() const {
+		boost::lock_guard<boost::mutex> l(syncher);
+		return memoryUsage;
+	}
+
+	unsigned int getEvictions() const {
+		boost::lock_guard<boost::mutex> l(syncher);
+		return evictions;
+	}
+
+	/** The number of unlinked entries that have not been freed yet. */
+	unsigned int getRetiredEntryCount() const {
+		boost::lock_guard<boost::mutex> l(syncher);
+		return retiredEntries.size();
+	}
+};
+
+
+} // namespace Passenger
+
+#endif /* _PASSENGER_SHARED_RESPONSE_CACHE_H_ */
@@ -64,6 +64,7 @@ private:
 	const string appLogFile;
 	const StaticString channelName;
 	mutable boost::mutex dataSyncher;
+	mutable boost::condition_variable stoppedCond;
 	string data;
 	oxt::thread *thr;
 	boost::function<void ()> endReachedCallback;
@@ -111,6 +112,7 @@ private:
 		{
 			boost::lock_guard<boost::mutex> l(dataSyncher);
 			stopped = true;
+			stoppedCond.notify_all();
 		}
 		if (endReachedCallback != NULL) {
 			endReachedCallback();
@@ -184,6 +186,23 @@ public:
 		boost::lock_guard<boost::mutex> l(dataSyncher);
 		return stopped;
 	}
+
+	/**
+	 * Waits until the end of the file descriptor has been reached, or until
+	 * the timeout (in microseconds) expires. Returns whether the end has been
+	 * reached.
+	 */
+	bool waitUntilStopped(unsigned long long timeout) const {
+		boost::unique_lock<boost::mutex> l(dataSyncher);
+		boost::system_time deadline = boost::get_system_time()
+			+ boost::posix_time::microseconds(timeout);
+		while (!stopped) {
+			if (!stoppedCond.timed_wait(l, deadline)) {
+				break;
+			}
+		}
+		return stopped;
+	}
 };
 
 typedef boost::shared_ptr<BackgroundIOCapturer> BackgroundIOCapturerPtr;
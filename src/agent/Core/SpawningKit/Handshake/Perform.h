@@ -81,6 +81,11 @@ private:
 		FINISH_INTERNAL_ERROR
 	};
 
+	// In microseconds. Socket pinging starts with the minimum interval,
+	// which doubles after every failed attempt up to the maximum.
+	static const unsigned long long MIN_SOCKET_PING_INTERVAL = 1000;
+	static const unsigned long long MAX_SOCKET_PING_INTERVAL = 10000;
+
 	HandshakeSession &session;
 	Config * const config;
 	const pid_t pid;
@@ -106,8 +111,9 @@ private:
 	string finishSignalWatcherErrorMessage;
 	ErrorCategory finishSignalWatcherErrorCategory;
 
-	oxt::thread *socketPingabilityWatcher;
+	bool watchingSocketPingability;
 	bool socketIsNowPingable;
+	unsigned long long socketPingInterval;
 
 
 	void initializeStdchannelsCapturing() {
@@ -182,25 +188,34 @@ private:
 		}
 	}
 
-	void startWatchingSocketPingability() {
-		socketPingabilityWatcher = new oxt::thread(
-			boost::bind(&HandshakePerform::watchSocketPingability, this),
-			"SpawningKit: socket pingability watcher", 64 * 1024);
-	}
-
-	void watchSocketPingability() {
+	/**
+	 * Checks whether the app is listening on the expected port yet, using
+	 * a non-blocking connect. Called by the thread that waits for the spawn
+	 * to finish, between waits of `socketPingInterval`, so that we notice
+	 * quickly when the app starts listening without needing a separate
+	 * thread that polls.
+	 */
+	void pingSocket(boost::unique_lock<boost::mutex> &l) {
 		TRACE_POINT();
+		unsigned long long timeout = socketPingInterval;
 
-		while (true) {
-			unsigned long long timeout = 100000;
+		l.unlock();
+		bool pingable;
+		try {
+			pingable = pingTcpServer("127.0.0.1", session.expectedStartPort, &timeout);
+		} catch (...) {
+			l.lock();
+			throw;
+		}
+		l.lock();
 
-			if (pingTcpServer("127.0.0.1", session.expectedStartPort, &timeout)) {
-				boost::lock_guard<boost::mutex> l(syncher);
-				socketIsNowPingable = true;
-				finishState = FINISH_SUCCESS;
-				wakeupEventLoop();
-			} else {
-				syscalls::usleep(50000);
+		if (pingable) {
+			socketIsNowPingable = true;
+			finishState = FINISH_SUCCESS;
+		} else {
+			socketPingInterval *= 2;
+			if (socketPingInterval > MAX_SOCKET_PING_INTERVAL) {
+				socketPingInterval = MAX_SOCKET_PING_INTERVAL;
 			}
 		}
 	}
@@ -211,10 +226,20 @@ private:
 
 		do {
 			boost::this_thread::interruption_point();
+			if (watchingSocketPingability && !socketIsNowPingable) {
+				pingSocket(l);
+			}
 			done = checkCurrentState();
 			if (!done) {
+				unsigned long long waitTime = session.timeoutUsec;
+				if (watchingSocketPingability && !socketIsNowPingable
+				 && socketPingInterval < waitTime)
+				{
+					waitTime = socketPingInterval;
+				}
+
 				MonotonicTimeUsec begin = SystemTime::getMonotonicUsec();
-				cond.timed_wait(l, posix_time::microseconds(session.timeoutUsec));
+				cond.timed_wait(l, posix_time::microseconds(waitTime));
 				MonotonicTimeUsec end = SystemTime::getMonotonicUsec();
 				if (end - begin > session.timeoutUsec) {
 					session.timeoutUsec = 0;
@@ -535,8 +560,15 @@ private:
 		}
 	}
 
+	/**
+	 * Gives the capturer a chance to capture output that the app wrote
+	 * right before it exited or reported an error. Returns as soon as the
+	 * output channel is closed, which is immediately if the app has exited.
+	 */
 	void sleepShortlyToCaptureMoreStdoutStderr() const {
-		syscalls::usleep(50000);
+		if (stdoutAndErrCapturer != NULL) {
+			stdoutAndErrCapturer->waitUntilStopped(50000);
+		}
 	}
 
 	void throwSpawnExceptionBecauseAppDidNotProvidePreloaderProtocolSockets() {
@@ -1407,11 +1439,6 @@ private:
 			delete finishSignalWatcher;
 			finishSignalWatcher = NULL;
 		}
-		if (socketPingabilityWatcher != NULL) {
-			socketPingabilityWatcher->interrupt_and_join();
-			delete socketPingabilityWatcher;
-			socketPingabilityWatcher = NULL;
-		}
 		if (stdoutAndErrCapturer != NULL) {
 			stdoutAndErrCapturer->stop();
 		}
@@ -1544,8 +1571,9 @@ public:
 		  finishSignalWatcher(NULL),
 		  processExited(false),
 		  finishState(NOT_FINISHED),
-		  socketPingabilityWatcher(NULL),
+		  watchingSocketPingability(false),
 		  socketIsNowPingable(false),
+		  socketPingInterval(MIN_SOCKET_PING_INTERVAL),
 		  debugSupport(NULL)
 	{
 		assert(_session.context != NULL);
@@ -1564,9 +1592,7 @@ public:
 		try {
 			initializeStdchannelsCapturing();
 			startWatchingProcessExit();
-			if (config->genericApp || config->findFreePort) {
-				startWatchingSocketPingability();
-			}
+			watchingSocketPingability = config->genericApp || config->findFreePort;
 			if (!config->genericApp) {
 				startWatchingFinishSignal();
 			}
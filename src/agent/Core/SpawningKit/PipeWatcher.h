@@ -28,21 +28,26 @@
 
 #include <boost/shared_ptr.hpp>
 #include <boost/enable_shared_from_this.hpp>
-#include <boost/thread.hpp>
-#include <boost/function.hpp>
 #include <boost/bind.hpp>
 #include <boost/foreach.hpp>
-#include <oxt/thread.hpp>
+#include <oxt/system_calls.hpp>
 #include <oxt/backtrace.hpp>
+#include <ev++.h>
 #include <string>
 #include <vector>
 
 #include <sys/types.h>
+#include <cstdio>
+#include <cerrno>
+#include <cstring>
 
 #include <FileDescriptor.h>
+#include <BackgroundEventLoop.h>
+#include <SafeLibev.h>
 #include <Constants.h>
 #include <LoggingKit/LoggingKit.h>
 #include <Utils.h>
+#include <Utils/IOUtils.h>
 #include <Utils/StrIntUtils.h>
 
 namespace Passenger {
@@ -51,7 +56,18 @@ namespace SpawningKit {
 using namespace boost;
 
 
-/** A PipeWatcher lives until the file descriptor is closed. */
+/**
+ * Forwards the output of an application process (or preloader) to the
+ * log, or to a log file if one is set.
+ *
+ * All PipeWatchers share a single event loop, which runs in a background
+ * thread that is started on first use. This way, watching the output of
+ * hundreds of processes does not require hundreds of mostly idle threads.
+ * The callbacks perform one read() per readiness notification, so output
+ * is split into lines in the same way as when every pipe had its own thread.
+ *
+ * A PipeWatcher lives until the other side of the pipe is closed.
+ */
 class PipeWatcher: public boost::enable_shared_from_this<PipeWatcher> {
 private:
 	FileDescriptor fd;
@@ -59,82 +75,79 @@ private:
 	string appGroupName;
 	string appLogFile;
 	pid_t pid;
-	bool started;
 	string logFile;
-	boost::mutex startSyncher;
-	boost::condition_variable startCond;
+	FILE *f;
+	struct ev_io watcher;
+	/** Keeps this object alive while it is registered with the event loop. */
+	boost::shared_ptr<PipeWatcher> self;
+
+	static BackgroundEventLoop *createEventLoop() {
+		BackgroundEventLoop *loop = new BackgroundEventLoop(true, false);
+		loop->start("PipeWatcher", POOL_HELPER_THREAD_STACK_SIZE);
+		return loop;
+	}
 
-	static void threadMain(boost::shared_ptr<PipeWatcher> self) {
-		TRACE_POINT();
-		self->threadMain();
+	static void onReadable(EV_P_ struct ev_io *io, int revents) {
+		static_cast<PipeWatcher *>(io->data)->onReadable();
 	}
 
-	void threadMain() {
+	void startWatching() {
 		TRACE_POINT();
-		{
-			boost::unique_lock<boost::mutex> lock(startSyncher);
-			while (!started) {
-				startCond.wait(lock);
-			}
-		}
+		self = shared_from_this();
+		ev_io_start(getEventLoop()->libev_loop, &watcher);
+	}
 
-		UPDATE_TRACE_POINT();
-		FILE *f = NULL;
-		if (!logFile.empty()) {
-			f = fopen(logFile.c_str(), "a");
-			if (f == NULL) {
-				P_ERROR("Cannot open log file " << logFile);
-				return;
-			}
+	void stopWatching() {
+		ev_io_stop(getEventLoop()->libev_loop, &watcher);
+		if (f != NULL) {
+			fclose(f);
+			f = NULL;
 		}
+		// May destroy this object, so must be the last thing we do.
+		self.reset();
+	}
 
-		UPDATE_TRACE_POINT();
-		while (!boost::this_thread::interruption_requested()) {
-			char buf[1024 * 8];
-			ssize_t ret;
+	void onReadable() {
+		TRACE_POINT();
+		char buf[1024 * 8];
+		ssize_t ret;
 
+		ret = syscalls::read(fd, buf, sizeof(buf));
+		if (ret == 0) {
+			stopWatching();
+		} else if (ret == -1) {
 			UPDATE_TRACE_POINT();
-			ret = syscalls::read(fd, buf, sizeof(buf));
-			if (ret == 0) {
-				break;
-			} else if (ret == -1) {
-				UPDATE_TRACE_POINT();
-				if (errno == ECONNRESET) {
-					break;
-				} else if (errno != EAGAIN) {
-					int e = errno;
-					P_WARN("Cannot read from process " << pid << " " << name <<
-						": " << strerror(e) << " (errno=" << e << ")");
-					break;
-				}
-			} else if (ret == 1 && buf[0] == '\n') {
-				UPDATE_TRACE_POINT();
-				printOrLogAppOutput(f, StaticString());
-			} else {
-				UPDATE_TRACE_POINT();
-				vector<StaticString> lines;
-				ssize_t ret2 = ret;
-				if (ret2 > 0 && buf[ret2 - 1] == '\n') {
-					ret2--;
-				}
-				split(StaticString(buf, ret2), '\n', lines);
-				foreach (const StaticString line, lines) {
-					printOrLogAppOutput(f, line);
-				}
+			if (errno == ECONNRESET) {
+				stopWatching();
+			} else if (errno != EAGAIN && errno != EINTR) {
+				int e = errno;
+				P_WARN("Cannot read from process " << pid << " " << name <<
+					": " << strerror(e) << " (errno=" << e << ")");
+				stopWatching();
+			}
+		} else if (ret == 1 && buf[0] == '\n') {
+			UPDATE_TRACE_POINT();
+			printOrLogAppOutput(StaticString());
+		} else {
+			UPDATE_TRACE_POINT();
+			vector<StaticString> lines;
+			ssize_t ret2 = ret;
+			if (ret2 > 0 && buf[ret2 - 1] == '\n') {
+				ret2--;
+			}
+			split(StaticString(buf, ret2), '\n', lines);
+			foreach (const StaticString line, lines) {
+				printOrLogAppOutput(line);
 			}
-		}
-
-		if (f != NULL) {
-			fclose(f);
 		}
 	}
 
-	void printOrLogAppOutput(FILE *f, const StaticString &line) {
+	void printOrLogAppOutput(const StaticString &line) {
 		if (f == NULL) {
 			LoggingKit::logAppOutput(appGroupName, pid, name, line.data(), line.size(), appLogFile);
 		} else {
 			fwrite(line.data(), 1, line.size(), f);
-			fwrite("\n", 1, 2, f);
+			fwrite("\n", 1, 1, f);
 			fflush(f);
 		}
 	}
@@ -148,23 +161,46 @@ public:
 		  appGroupName(_appGroupName),
 		  appLogFile(_appLogFile),
 		  pid(_pid),
-		  started(false)
-		{ }
+		  f(NULL)
+	{
+		ev_io_init(&watcher, onReadable, fd, EV_READ);
+		watcher.data = this;
+	}
+
+	~PipeWatcher() {
+		if (f != NULL) {
+			fclose(f);
+		}
+	}
+
+	/**
+	 * The event loop that all PipeWatchers share.
+	 */
+	static BackgroundEventLoop *getEventLoop() {
+		static BackgroundEventLoop *loop = createEventLoop();
+		return loop;
+	}
 
 	void setLogFile(const string &path) {
 		logFile = path;
 	}
 
 	void initialize() {
-		oxt::thread(boost::bind(threadMain, shared_from_this()),
-			"PipeWatcher: PID " + toString(pid) + " " + name + ", fd " + toString(fd),
-			POOL_HELPER_THREAD_STACK_SIZE);
+		TRACE_POINT();
+		if (!logFile.empty()) {
+			f = fopen(logFile.c_str(), "a");
+			if (f == NULL) {
+				P_ERROR("Cannot open log file " << logFile);
+			}
+		}
+		setNonBlocking(fd);
 	}
 
 	void start() {
-		boost::lock_guard<boost::mutex> lock(startSyncher);
-		started = true;
-		startCond.notify_all();
+		if (logFile.empty() || f != NULL) {
+			getEventLoop()->safe->runLater(boost::bind(&PipeWatcher::startWatching,
+				shared_from_this()));
+		}
 	}
 };
 
@@ -1215,7 +1215,7 @@ public:
 			m_lastUsed = SystemTime::getUsec();
 		}
 		UPDATE_TRACE_POINT();
-		boost::lock_guard<boost::mutex> l(syncher);
+		boost::unique_lock<boost::mutex> l(syncher);
 		if (!preloaderStarted()) {
 			UPDATE_TRACE_POINT();
 			startPreloader();
@@ -1252,6 +1252,10 @@ public:
 			ScopeGuard guard(boost::bind(nonInterruptableKillAndWaitpid, forkResult.pid));
 			P_DEBUG("Process forked for appRoot=" << options.appRoot << ": PID " << forkResult.pid);
 
+			// The handshake with the forked process does not involve the
+			// preloader, so let other threads fork processes in the meantime.
+			l.unlock();
+
 			UPDATE_TRACE_POINT();
 			session.journey.setStepPerformed(SPAWNING_KIT_PROCESS_RESPONSE_FROM_PRELOADER);
 			session.journey.setStepInProgress(PRELOADER_PREPARATION);
@@ -1266,9 +1270,15 @@ public:
 				", pid=" << forkResult.pid);
 			return session.result;
 		} catch (SpawnException &e) {
+			if (!l.owns_lock()) {
+				l.lock();
+			}
 			addPreloaderEnvDumps(e);
 			throw e;
 		} catch (const std::exception &originalException) {
+			if (!l.owns_lock()) {
+				l.lock();
+			}
 			session.journey.setStepErrored(stepToMarkAsErrored, true);
 			SpawnException e(originalException, session.journey,
 				&config);
@@ -63,10 +63,12 @@ using namespace std;
  *   admin_panel_username                                                     string             -          -
  *   admin_panel_websocketpp_debug_access                                     boolean            -          default(false)
  *   admin_panel_websocketpp_debug_error                                      boolean            -          default(false)
+ *   app_connect_timeout                                                      unsigned integer   -          default(10000)
  *   app_output_log_level                                                     string             -          default("notice")
  *   benchmark_mode                                                           string             -          -
  *   config_manifest                                                          object             -          read_only
  *   controller_accept_burst_count                                            unsigned integer   -          default(32)
+ *   controller_accept_distribution                                           string             -          default("round-robin"),read_only
  *   controller_addresses                                                     array of strings   -          default,read_only
  *   controller_client_freelist_limit                                         unsigned integer   -          default(0)
  *   controller_cpu_affine                                                    boolean            -          default(false),read_only
@@ -76,7 +78,12 @@ using namespace std;
  *   controller_file_buffered_channel_delay_in_file_mode_switching            unsigned integer   -          default(0)
  *   controller_file_buffered_channel_max_disk_chunk_read_size                unsigned integer   -          default(0)
  *   controller_file_buffered_channel_threshold                               unsigned integer   -          default(131072)
+ *   controller_http2                                                         boolean            -          default(false)
+ *   controller_http2_max_concurrent_streams                                  unsigned integer   -          default(100)
  *   controller_mbuf_block_chunk_size                                         unsigned integer   -          default(4096),read_only
+ *   controller_mbuf_huge_pages                                               boolean            -          default(false),read_only
+ *   controller_mbuf_max_spare_memory                                         unsigned integer   -          default(67108864)
+ *   controller_mbuf_slab_size                                                unsigned integer   -          default(0),read_only
  *   controller_min_spare_clients                                             unsigned integer   -          default(0)
  *   controller_pid_file                                                      string             -          default,read_only
  *   controller_request_freelist_limit                                        unsigned integer   -          default(1024)
@@ -94,7 +101,12 @@ using namespace std;
  *   core_api_server_file_buffered_channel_delay_in_file_mode_switching       unsigned integer   -          default(0)
  *   core_api_server_file_buffered_channel_max_disk_chunk_read_size           unsigned integer   -          default(0)
  *   core_api_server_file_buffered_channel_threshold                          unsigned integer   -          default(131072)
+ *   core_api_server_http2                                                    boolean            -          default(false)
+ *   core_api_server_http2_max_concurrent_streams                             unsigned integer   -          default(100)
  *   core_api_server_mbuf_block_chunk_size                                    unsigned integer   -          default(4096),read_only
+ *   core_api_server_mbuf_huge_pages                                          boolean            -          default(false),read_only
+ *   core_api_server_mbuf_max_spare_memory                                    unsigned integer   -          default(67108864)
+ *   core_api_server_mbuf_slab_size                                           unsigned integer   -          default(0),read_only
  *   core_api_server_min_spare_clients                                        unsigned integer   -          default(0)
  *   core_api_server_request_freelist_limit                                   unsigned integer   -          default(1024)
  *   core_api_server_start_reading_after_accept                               boolean            -          default(true)
@@ -115,9 +127,11 @@ using namespace std;
  *   default_min_instances                                                    unsigned integer   -          default(1)
  *   default_nodejs                                                           string             -          default("node")
  *   default_python                                                           string             -          default("python")
+ *   default_response_compression                                             boolean            -          default(false)
  *   default_ruby                                                             string             -          default("ruby")
  *   default_server_name                                                      string             -          default
  *   default_server_port                                                      unsigned integer   -          default
+ *   default_spawn_concurrency                                                unsigned integer   -          default(1)
  *   default_spawn_method                                                     string             -          default("smart")
  *   default_sticky_sessions                                                  boolean            -          default(false)
  *   default_sticky_sessions_cookie_name                                      string             -          default("_passenger_route")
@@ -134,18 +148,25 @@ using namespace std;
  *   log_target                                                               any                -          default({"stderr": true})
  *   max_instances_per_app                                                    unsigned integer   -          read_only
  *   max_pool_size                                                            unsigned integer   -          default(6)
+ *   max_spawn_concurrency                                                    unsigned integer   -          default(4)
  *   multi_app                                                                boolean            -          default(false),read_only
  *   passenger_root                                                           string             required   read_only
  *   pidfiles_to_delete_on_exit                                               array of strings   -          default([])
  *   pool_idle_time                                                           unsigned integer   -          default(300)
+ *   pool_min_idle_connections                                                unsigned integer   -          default(0)
+ *   pool_predictive_autoscaling                                              boolean            -          default(false)
  *   pool_selfchecks                                                          boolean            -          default(false)
  *   prestart_urls                                                            array of strings   -          default([]),read_only
  *   response_buffer_high_watermark                                           unsigned integer   -          default(134217728)
+ *   response_compression_level                                               unsigned integer   -          default(6)
+ *   response_compression_min_size                                            unsigned integer   -          default(256)
+ *   response_splice_threshold                                                unsigned integer   -          default(131072)
  *   security_update_checker_certificate_path                                 string             -          -
  *   security_update_checker_disabled                                         boolean            -          default(false)
  *   security_update_checker_interval                                         unsigned integer   -          default(86400)
  *   security_update_checker_proxy_url                                        string             -          -
  *   security_update_checker_url                                              string             -          default("https://securitycheck.phusionpassenger.com/v1/check.json")
+ *   sendfile_root                                                            string             -          -
  *   server_software                                                          string             -          default("Phusion_Passenger/5.3.2")
  *   setsid                                                                   boolean            -          default(false)
  *   show_version_in_header                                                   boolean            -          default(true)
@@ -155,6 +176,10 @@ using namespace std;
  *   standalone_engine                                                        string             -          default
  *   startup_report_file                                                      string             -          -
  *   stat_throttle_rate                                                       unsigned integer   -          default(10)
+ *   turbocache_max_body_size                                                 unsigned integer   -          default(131072),read_only
+ *   turbocache_max_entries                                                   unsigned integer   -          default(1024),read_only
+ *   turbocache_max_memory                                                    unsigned integer   -          default(8388608),read_only
+ *   turbocache_shared                                                        boolean            -          default(false),read_only
  *   turbocaching                                                             boolean            -          default(true),read_only
  *   user                                                                     string             -          default,read_only
  *   user_switching                                                           boolean            -          default(true)
@@ -169,7 +194,12 @@ using namespace std;
  *   watchdog_api_server_file_buffered_channel_delay_in_file_mode_switching   unsigned integer   -          default(0)
  *   watchdog_api_server_file_buffered_channel_max_disk_chunk_read_size       unsigned integer   -          default(0)
  *   watchdog_api_server_file_buffered_channel_threshold                      unsigned integer   -          default(131072)
+ *   watchdog_api_server_http2                                                boolean            -          default(false)
+ *   watchdog_api_server_http2_max_concurrent_streams                         unsigned integer   -          default(100)
  *   watchdog_api_server_mbuf_block_chunk_size                                unsigned integer   -          default(4096),read_only
+ *   watchdog_api_server_mbuf_huge_pages                                      boolean            -          default(false),read_only
+ *   watchdog_api_server_mbuf_max_spare_memory                                unsigned integer   -          default(67108864)
+ *   watchdog_api_server_mbuf_slab_size                                       unsigned integer   -          default(0),read_only
  *   watchdog_api_server_min_spare_clients                                    unsigned integer   -          default(0)
  *   watchdog_api_server_request_freelist_limit                               unsigned integer   -          default(1024)
  *   watchdog_api_server_start_reading_after_accept                           boolean            -          default(true)
@@ -0,0 +1,141 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_APACHE2_APP_TYPE_DETECTION_CACHE_H_
+#define _PASSENGER_APACHE2_APP_TYPE_DETECTION_CACHE_H_
+
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <string>
+#include <ctime>
+
+#include <AppTypes.h>
+#include <StaticString.h>
+#include <Utils/SystemTime.h>
+
+namespace Passenger {
+namespace Apache2Module {
+
+using namespace std;
+
+
+/**
+ * Remembers the results of application type autodetection, so that
+ * DirectoryMapper doesn't have to check the filesystem (and contend for
+ * the CachedFileStat mutex) on every request.
+ *
+ * This is a direct-mapped cache: every key maps to exactly one slot, and
+ * storing a result replaces whatever that slot held. Slots point to
+ * immutable entries and are read and replaced with the atomic shared_ptr
+ * operations, so threads looking up different keys don't contend with
+ * each other and no thread ever waits for a detection in progress.
+ *
+ * Entries expire after `ttl` seconds, the same time after which
+ * CachedFileStat would check the filesystem again. A TTL of 0 disables
+ * the cache.
+ *
+ * @note This class is thread-safe.
+ */
+class AppTypeDetectionCache {
+public:
+	struct Result {
+		PassengerAppType appType;
+		string appRoot;
+	};
+
+private:
+	struct Entry {
+		string key;
+		Result result;
+		time_t expiresAt;
+	};
+
+	typedef boost::shared_ptr<const Entry> EntryPtr;
+
+	static const unsigned int SLOTS = 256;
+
+	EntryPtr slots[SLOTS];
+	unsigned int ttl;
+
+	const EntryPtr *slotFor(const StaticString &key) const {
+		return &slots[StaticString::Hash()(key) % SLOTS];
+	}
+
+	EntryPtr *slotFor(const StaticString &key) {
+		return &slots[StaticString::Hash()(key) % SLOTS];
+	}
+
+public:
+	AppTypeDetectionCache(unsigned int _ttl)
+		: ttl(_ttl)
+		{ }
+
+	unsigned int getTtl() const {
+		return ttl;
+	}
+
+	/**
+	 * Looks up a non-expired result for `key`. Returns whether one was found.
+	 *
+	 * @throws TimeRetrievalException
+	 * @throws boost::thread_interrupted
+	 */
+	bool lookup(const StaticString &key, Result &result) const {
+		if (ttl == 0) {
+			return false;
+		}
+
+		EntryPtr entry = boost::atomic_load(slotFor(key));
+		if (entry != NULL && key == entry->key && SystemTime::get() < entry->expiresAt) {
+			result = entry->result;
+			return true;
+		} else {
+			return false;
+		}
+	}
+
+	/**
+	 * @throws TimeRetrievalException
+	 * @throws boost::thread_interrupted
+	 */
+	void store(const StaticString &key, PassengerAppType appType, const string &appRoot) {
+		if (ttl == 0) {
+			return;
+		}
+
+		boost::shared_ptr<Entry> entry = boost::make_shared<Entry>();
+		entry->key = key;
+		entry->result.appType = appType;
+		entry->result.appRoot = appRoot;
+		entry->expiresAt = SystemTime::get() + ttl;
+		boost::atomic_store(slotFor(key), EntryPtr(entry));
+	}
+};
+
+
+} // namespace Apache2Module
+} // namespace Passenger
+
+#endif /* _PASSENGER_APACHE2_APP_TYPE_DETECTION_CACHE_H_ */
@@ -62,6 +62,7 @@ bucket_destroy(void *data) {
 static apr_status_t
 bucket_read(apr_bucket *bucket, const char **str, apr_size_t *len, apr_read_type_e block) {
 	char *buf;
+	apr_size_t bufsize;
 	ssize_t ret;
 	BucketData *data;
 
@@ -69,6 +70,20 @@ bucket_read(apr_bucket *bucket, const char **str, apr_size_t *len, apr_read_type
 	*str = NULL;
 	*len = 0;
 
+	if (data->state->bodyRemaining == 0) {
+		/* The response body has been read entirely. Anything that follows on
+		 * the connection belongs to the next response, so don't read further.
+		 */
+		data->state->completed = true;
+		delete data;
+		bucket->data = NULL;
+
+		bucket = apr_bucket_immortal_make(bucket, "", 0);
+		*str = (const char *) bucket->data;
+		*len = 0;
+		return APR_SUCCESS;
+	}
+
 	if (!data->bufferResponse && block == APR_NONBLOCK_READ) {
 		/*
 		 * The bucket brigade that Hooks::handleRequest() passes using
@@ -94,14 +109,22 @@ bucket_read(apr_bucket *bucket, const char **str, apr_size_t *len, apr_read_type
 		return APR_ENOMEM;
 	}
 
+	bufsize = APR_BUCKET_BUFF_SIZE;
+	if (data->state->bodyRemaining > 0 && data->state->bodyRemaining < (apr_off_t) bufsize) {
+		bufsize = (apr_size_t) data->state->bodyRemaining;
+	}
+
 	do {
-		ret = read(data->state->connection, buf, APR_BUCKET_BUFF_SIZE);
+		ret = read(data->state->connection, buf, bufsize);
 	} while (ret == -1 && errno == EINTR);
 
 	if (ret > 0) {
 		apr_bucket_heap *h;
 
 		data->state->bytesRead += ret;
+		if (data->state->bodyRemaining > 0) {
+			data->state->bodyRemaining -= ret;
+		}
 
 		*str = buf;
 		*len = ret;
@@ -54,6 +54,13 @@ struct PassengerBucketState {
 	 */
 	int errorCode;
 
+	/** The number of response body bytes that are yet to be read, or -1
+	 * if the body lasts until EOF. Once this reaches 0, the PassengerBucket
+	 * completes without reading from the connection any further, so that
+	 * the connection can be reused for the next request.
+	 */
+	apr_off_t bodyRemaining;
+
 	/** Connection to the Passenger core. */
 	FileDescriptor connection;
 
@@ -61,8 +68,16 @@ struct PassengerBucketState {
 		bytesRead  = 0;
 		completed  = false;
 		errorCode  = 0;
+		bodyRemaining = -1;
 		connection = conn;
 	}
+
+	/** Whether the entire response body has been read, so that nothing
+	 * of this response is left on the connection.
+	 */
+	bool bodyFullyRead() const {
+		return completed && errorCode == 0 && bodyRemaining == 0;
+	}
 };
 
 typedef boost::shared_ptr<PassengerBucketState> PassengerBucketStatePtr;
@@ -84,6 +99,8 @@ typedef boost::shared_ptr<PassengerBucketState> PassengerBucketStatePtr;
  * - It ignores the APR_NONBLOCK_READ flag because that's known to cause
  *   strange I/O problems.
  * - It can store its current state in a PassengerBucketState data structure.
+ * - It stops at the end of the response body if the body size is known,
+ *   so that the connection with the Passenger core can be kept alive.
  */
 apr_bucket *passenger_bucket_create(const PassengerBucketStatePtr &state,
                                     apr_bucket_alloc_t *list,
@@ -118,6 +118,11 @@ AP_INIT_TAKE1("PassengerConcurrencyModel",
 	NULL,
 	RSRC_CONF | ACCESS_CONF,
 	"The concurrency model that should be used for applications."),
+AP_INIT_FLAG("PassengerCoreKeepAlive",
+	(FlagFunc) cmd_passenger_core_keep_alive,
+	NULL,
+	RSRC_CONF,
+	"Whether to reuse connections to the Phusion Passenger core across requests."),
 AP_INIT_TAKE2("PassengerCtl",
 	(Take2Func) cmd_passenger_ctl,
 	NULL,
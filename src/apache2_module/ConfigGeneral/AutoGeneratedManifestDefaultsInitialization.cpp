@@ -48,6 +48,11 @@ void
 ConfigManifestGenerator::autoGenerated_setGlobalConfigDefaults() {
 	Json::Value &globalConfigContainer = manifest["global_configuration"];
 
+	addOptionsContainerStaticDefaultBool(
+		globalConfigContainer,
+		"PassengerCoreKeepAlive",
+		true);
+
 	addOptionsContainerDynamicDefault(
 		globalConfigContainer,
 		"PassengerDataBufferDir",
@@ -211,6 +211,21 @@ cmd_passenger_buffer_upload(cmd_parms *cmd, void *pcfg, const char *arg) {
 	return NULL;
 }
 
+static const char *
+cmd_passenger_core_keep_alive(cmd_parms *cmd, void *pcfg, const char *arg) {
+	const char *err = ap_check_cmd_context(cmd, GLOBAL_ONLY);
+	if (err != NULL) {
+		ap_log_perror(APLOG_MARK, APLOG_STARTUP, 0, cmd->temp_pool,
+			"WARNING: %s", err);
+	}
+
+	serverConfig.coreKeepAliveSourceFile = cmd->directive->filename;
+	serverConfig.coreKeepAliveSourceLine = cmd->directive->line_num;
+	serverConfig.coreKeepAliveExplicitlySet = true;
+	serverConfig.coreKeepAlive = arg != NULL;
+	return NULL;
+}
+
 static const char *
 cmd_passenger_data_buffer_dir(cmd_parms *cmd, void *pcfg, const char *arg) {
 	const char *err = ap_check_cmd_context(cmd, GLOBAL_ONLY);
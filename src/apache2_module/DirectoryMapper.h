@@ -37,6 +37,8 @@
 #include <Utils.h>
 #include <Utils/CachedFileStat.hpp>
 
+#include "AppTypeDetectionCache.h"
+
 // The APR headers must come after the Passenger headers.
 // See Hooks.cpp to learn why.
 #include <httpd.h>
@@ -76,6 +78,7 @@ private:
 	request_rec *r;
 	CachedFileStat *cstat;
 	boost::mutex *cstatMutex;
+	AppTypeDetectionCache *appTypeCache;
 	const char *baseURI;
 	string publicDir;
 	string appRoot;
@@ -109,6 +112,56 @@ private:
 		return NULL;
 	}
 
+	/**
+	 * Autodetects the type of the application that `dir` belongs to, using
+	 * the AppTypeDetectionCache if possible. If `isDocumentRoot`, then `dir`
+	 * is a document root and the inferred app root is stored in `appRoot`.
+	 * Otherwise `dir` is the app root itself.
+	 *
+	 * @throws FileSystemException An error occured while examening the filesystem.
+	 * @throws TimeRetrievalException
+	 * @throws boost::thread_interrupted
+	 */
+	PassengerAppType detectAppType(const StaticString &dir, bool isDocumentRoot,
+		bool resolveFirstSymlink, string *appRoot)
+	{
+		string key;
+		if (appTypeCache != NULL) {
+			AppTypeDetectionCache::Result cached;
+
+			key.reserve(dir.size() + 1);
+			if (!isDocumentRoot) {
+				key.append(1, 'A');
+			} else if (resolveFirstSymlink) {
+				key.append(1, 'S');
+			} else {
+				key.append(1, 'D');
+			}
+			key.append(dir.data(), dir.size());
+
+			if (appTypeCache->lookup(key, cached)) {
+				if (isDocumentRoot) {
+					*appRoot = cached.appRoot;
+				}
+				return cached.appType;
+			}
+		}
+
+		AppTypeDetector detector(cstat, cstatMutex, throttleRate);
+		PassengerAppType appType;
+		if (isDocumentRoot) {
+			appType = detector.checkDocumentRoot(dir, resolveFirstSymlink, appRoot);
+		} else {
+			appType = detector.checkAppRoot(dir);
+		}
+
+		if (appTypeCache != NULL) {
+			appTypeCache->store(key, appType,
+				isDocumentRoot ? *appRoot : string());
+		}
+		return appType;
+	}
+
 	/**
 	 * @throws FileSystemException An error occured while examening the filesystem.
 	 * @throws DocumentRootDeterminationError Unable to query the location of the document root.
@@ -146,17 +199,16 @@ private:
 		}
 
 		UPDATE_TRACE_POINT();
-		AppTypeDetector detector(cstat, cstatMutex, throttleRate);
 		PassengerAppType appType;
 		string appRoot;
 		if (config->getAppType().empty()) {
 			if (config->getAppRoot().empty()) {
-				appType = detector.checkDocumentRoot(publicDir,
+				appType = detectAppType(publicDir, true,
 					baseURI != NULL,
 					&appRoot);
 			} else {
 				appRoot = config->getAppRoot();
-				appType = detector.checkAppRoot(appRoot);
+				appType = detectAppType(appRoot, false, false, NULL);
 			}
 		} else {
 			if (config->getAppRoot().empty()) {
@@ -181,15 +233,18 @@ public:
 	 * @param cstatMutex A mutex for locking CachedFileStat, making its
 	 *                   usage thread-safe.
 	 * @param throttleRate A throttling rate for cstat.
+	 * @param appTypeCache A cache for autodetection results. May be NULL.
 	 * @warning Do not use this object after the destruction of <tt>r</tt>,
-	 *          <tt>config</tt> or <tt>cstat</tt>.
+	 *          <tt>config</tt>, <tt>cstat</tt> or <tt>appTypeCache</tt>.
 	 */
 	DirectoryMapper(request_rec *r, DirConfig *config, CachedFileStat *cstat,
-	                boost::mutex *cstatMutex, unsigned int throttleRate) {
+	                boost::mutex *cstatMutex, unsigned int throttleRate,
+	                AppTypeDetectionCache *appTypeCache = NULL) {
 		this->r = r;
 		this->config = config;
 		this->cstat = cstat;
 		this->cstatMutex = cstatMutex;
+		this->appTypeCache = appTypeCache;
 		this->throttleRate = throttleRate;
 		appType = PAT_NONE;
 		baseURI = NULL;
@@ -42,6 +42,7 @@
 #define CORE_PRIVATE
 
 #include <boost/thread.hpp>
+#include <boost/atomic.hpp>
 
 #include <sys/time.h>
 #include <sys/resource.h>
@@ -49,6 +50,7 @@
 #include <exception>
 #include <cstdio>
 #include <fcntl.h>
+#include <poll.h>
 #include <unistd.h>
 
 #include <oxt/initialize.hpp>
@@ -235,6 +237,16 @@ private:
 	CachedFileStat cstat;
 	WatchdogLauncher watchdogLauncher;
 	boost::mutex cstatMutex;
+	AppTypeDetectionCache appTypeCache;
+
+	/**
+	 * A connection to the core that this thread kept alive after its
+	 * previous request. A thread only handles one request at a time,
+	 * so it never needs more than one.
+	 */
+	boost::thread_specific_ptr<FileDescriptor> idleCoreConnection;
+	boost::atomic<unsigned long long> coreConnectionsCreated;
+	boost::atomic<unsigned long long> coreConnectionsReused;
 
 	static Json::Value strsetToJson(const set<string> &input) {
 		Json::Value result(Json::arrayValue);
@@ -348,6 +360,109 @@ private:
 		return conn;
 	}
 
+	/**
+	 * Returns a connection to the core for the current request. If
+	 * `keepAlive` is true, then this thread's idle connection is reused
+	 * if it still looks usable.
+	 */
+	FileDescriptor checkoutCoreConnection(bool keepAlive, bool &reused) {
+		if (keepAlive && idleCoreConnection.get() != NULL) {
+			FileDescriptor conn = *idleCoreConnection;
+			idleCoreConnection.reset();
+			if (idleCoreConnectionIsUsable(conn)) {
+				reused = true;
+				coreConnectionsReused++;
+				return conn;
+			}
+		}
+
+		reused = false;
+		coreConnectionsCreated++;
+		return connectToCore();
+	}
+
+	/**
+	 * Keeps a connection to the core around for this thread's next request.
+	 * Must only be called once the core's response has been read entirely.
+	 */
+	void checkinCoreConnection(const FileDescriptor &conn) {
+		idleCoreConnection.reset(new FileDescriptor(conn));
+	}
+
+	/**
+	 * The core is not supposed to send anything on an idle connection, so if
+	 * the connection is readable then the core has closed it (e.g. because
+	 * it was restarted) or something is wrong with it.
+	 */
+	static bool idleCoreConnectionIsUsable(const FileDescriptor &conn) {
+		struct pollfd pfd;
+		int ret;
+
+		pfd.fd = conn;
+		pfd.events = POLLIN;
+		pfd.revents = 0;
+		do {
+			ret = poll(&pfd, 1, 0);
+		} while (ret == -1 && errno == EINTR);
+		return ret == 0;
+	}
+
+	/**
+	 * Whether a request may be sent again if the connection was closed before
+	 * a response was received: the methods that RFC 7230 section 6.3.1 calls
+	 * idempotent. HEAD requests have method number M_GET.
+	 */
+	static bool requestIsIdempotent(const request_rec *r) {
+		switch (r->method_number) {
+		case M_GET:
+		case M_OPTIONS:
+		case M_PUT:
+		case M_DELETE:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	/**
+	 * Determines how many response body bytes remain to be read from the
+	 * core, or -1 if that is unknown. Only responses whose end we know can
+	 * be followed by another request on the same connection.
+	 *
+	 * Must be called after the response header has been parsed. At that
+	 * point, `bb` may already contain part of the body.
+	 */
+	apr_off_t determineRemainingResponseBodySize(request_rec *r, apr_bucket_brigade *bb) {
+		apr_off_t bodySize;
+
+		if (r->header_only || r->status == HTTP_NO_CONTENT
+		 || r->status == HTTP_NOT_MODIFIED || ap_is_HTTP_INFO(r->status))
+		{
+			bodySize = 0;
+		} else {
+			const char *contentLength = lookupInTable(r->headers_out, "Content-Length");
+			if (contentLength == NULL) {
+				contentLength = lookupInTable(r->err_headers_out, "Content-Length");
+			}
+			if (contentLength == NULL || *contentLength < '0' || *contentLength > '9') {
+				return -1;
+			}
+			bodySize = (apr_off_t) stringToULL(contentLength);
+		}
+
+		for (apr_bucket *e = APR_BRIGADE_FIRST(bb);
+		     e != APR_BRIGADE_SENTINEL(bb) && e->length != (apr_size_t) -1;
+		     e = APR_BUCKET_NEXT(e))
+		{
+			bodySize -= e->length;
+		}
+		if (bodySize < 0) {
+			// The core sent more than it announced.
+			return -1;
+		}
+		return bodySize;
+	}
+
 	bool hasModRewrite() {
 		if (m_hasModRewrite == UNKNOWN) {
 			if (ap_find_linked_module("mod_rewrite.c")) {
@@ -443,7 +558,8 @@ private:
 	bool prepareRequest(request_rec *r, DirConfig *config, const char *filename, bool coreModuleWillBeRun = false) {
 		TRACE_POINT();
 
-		DirectoryMapper mapper(r, config, &cstat, &cstatMutex, serverConfig.statThrottleRate);
+		DirectoryMapper mapper(r, config, &cstat, &cstatMutex, serverConfig.statThrottleRate,
+			&appTypeCache);
 		try {
 			if (mapper.getApplicationType() == PAT_NONE) {
 				// (B) is not true.
@@ -634,59 +750,118 @@ private:
 
 			int ret;
 			bool bodyIsChunked = false;
+			bool keepAlive = serverConfig.coreKeepAlive;
+			bool connReused;
 
-			string headers = constructRequestHeaders(r, mapper, bodyIsChunked);
-			FileDescriptor conn = connectToCore();
-			writeExact(conn, headers);
-			headers.clear();
-			if (expectingBody) {
-				sendRequestBody(conn, r, bodyIsChunked);
-			}
+			string headers = constructRequestHeaders(r, mapper, bodyIsChunked, keepAlive);
+			FileDescriptor conn = checkoutCoreConnection(keepAlive, connReused);
+			apr_bucket_brigade *bb = NULL;
+			apr_bucket *b;
+			PassengerBucketStatePtr bucketState;
+			/* I know the required size for backendData because I read
+			 * util_script.c's source. :-(
+			 */
+			char backendData[MAX_STRING_LEN];
 
+			while (true) {
+				bool retry = false;
 
-			/********** Step 4: forwarding the response from the Passenger core
-			                    back to the HTTP client **********/
+				try {
+					writeExact(conn, headers);
+				} catch (const SystemException &e) {
+					if (connReused && (e.code() == EPIPE || e.code() == ECONNRESET)) {
+						retry = true;
+					} else {
+						throw;
+					}
+				}
 
-			UPDATE_TRACE_POINT();
-			apr_bucket_brigade *bb;
-			apr_bucket *b;
-			PassengerBucketStatePtr bucketState;
+				if (!retry) {
+					if (expectingBody) {
+						sendRequestBody(conn, r, bodyIsChunked);
+					}
 
-			/* Setup the bucket brigade. */
-			bb = apr_brigade_create(r->connection->pool, r->connection->bucket_alloc);
 
-			bucketState = boost::make_shared<PassengerBucketState>(conn);
-			b = passenger_bucket_create(bucketState, r->connection->bucket_alloc,
-				config->getBufferResponse());
-			APR_BRIGADE_INSERT_TAIL(bb, b);
+					/********** Step 4: forwarding the response from the Passenger core
+					                    back to the HTTP client **********/
 
-			b = apr_bucket_eos_create(r->connection->bucket_alloc);
-			APR_BRIGADE_INSERT_TAIL(bb, b);
+					UPDATE_TRACE_POINT();
 
-			/* Now read the HTTP response header, parse it and fill relevant
-			 * information in our request_rec structure. We skip the status line
-			 * because ap_scan_script_header_err_brigade() can't handle it.
-			 */
+					/* Setup the bucket brigade. */
+					bb = apr_brigade_create(r->connection->pool, r->connection->bucket_alloc);
 
-			/* I know the required size for backendData because I read
-			 * util_script.c's source. :-(
-			 */
-			char backendData[MAX_STRING_LEN];
-			getsfunc_BRIGADE(backendData, MAX_STRING_LEN, bb);
+					bucketState = boost::make_shared<PassengerBucketState>(conn);
+					b = passenger_bucket_create(bucketState, r->connection->bucket_alloc,
+						config->getBufferResponse());
+					APR_BRIGADE_INSERT_TAIL(bb, b);
+
+					b = apr_bucket_eos_create(r->connection->bucket_alloc);
+					APR_BRIGADE_INSERT_TAIL(bb, b);
+
+					/* Now read the HTTP response header, parse it and fill relevant
+					 * information in our request_rec structure. We skip the status line
+					 * because ap_scan_script_header_err_brigade() can't handle it.
+					 */
+					getsfunc_BRIGADE(backendData, MAX_STRING_LEN, bb);
+
+					/* The core may have closed the connection after the app
+					 * processed the request, so only requests that may be
+					 * executed twice are retried. For the others, the missing
+					 * response header is reported as an error below.
+					 */
+					if (connReused && bucketState->bytesRead == 0 && !expectingBody
+					 && requestIsIdempotent(r))
+					{
+						apr_brigade_cleanup(bb);
+						retry = true;
+					}
+				}
+
+				if (!retry) {
+					break;
+				}
+
+				/* The core closed the reused connection before it responded,
+				 * most likely because it was closing the idle connection at
+				 * the same time as we sent the request. Try again on a new
+				 * connection.
+				 */
+				UPDATE_TRACE_POINT();
+				P_DEBUG("Connection to the Passenger core was closed before it "
+					"responded; retrying on a new connection");
+				coreConnectionsCreated++;
+				conn = connectToCore();
+				connReused = false;
+			}
+			headers.clear();
 
 			// The bucket brigade is an interface to the HTTP response sent by the
 			// PassengerAgent. The scanner parses (line by line) response headers
 			// into error_headers_out (mostly) as well as headers_out.
 			ret = ap_scan_script_header_err_brigade(r, bb, backendData);
 
-			// The PassengerAgent sets the Connection: close header because it wants
+			// The PassengerAgent sets the Connection: close header if it wants
 			// the bb connection closed, but because we fed everything to the
 			// ap_scan_script it will also be set in the response to the client and
 			// that breaks HTTP 1.1 keep-alive, so unset it.
+			const char *coreConnectionHeader = lookupInTable(r->headers_out, "Connection");
+			if (coreConnectionHeader == NULL) {
+				coreConnectionHeader = lookupInTable(r->err_headers_out, "Connection");
+			}
+			if (coreConnectionHeader != NULL && strcasecmp(coreConnectionHeader, "close") == 0) {
+				keepAlive = false;
+			}
 			apr_table_unset(r->err_headers_out, "Connection");
 			// It's undefined in which of the tables it ends up in, so unset on both.
 			apr_table_unset(r->headers_out, "Connection");
 
+			if (ret == OK && keepAlive) {
+				// Stop reading at the end of the body, so that the connection
+				// can be reused. If the body size is unknown, then the core
+				// closes the connection after the body.
+				bucketState->bodyRemaining = determineRemainingResponseBodySize(r, bb);
+			}
+
 			if (ret == OK) {
 				// The API documentation for ap_scan_script_err_brigade() says it
 				// returns HTTP_OK on success, but it actually returns OK.
@@ -726,6 +901,9 @@ private:
 				} else if (ap_pass_brigade(r->output_filters, bb) == APR_SUCCESS) {
 					apr_brigade_cleanup(bb);
 				}
+				if (keepAlive && bucketState->bodyFullyRead()) {
+					checkinCoreConnection(conn);
+				}
 				return OK;
 			} else {
 				// Passenger core sent an empty response, or an invalid response.
@@ -856,8 +1034,12 @@ private:
 		return strstr(buffer, "upgrade");
 	}
 
+	/**
+	 * @param keepAlive Whether to ask the core to keep the connection alive.
+	 *                  Set to false if the request is a connection upgrade.
+	 */
 	string constructRequestHeaders(request_rec *r, DirectoryMapper &mapper,
-		bool &bodyIsChunked)
+		bool &bodyIsChunked, bool &keepAlive)
 	{
 		const char *baseURI = mapper.getBaseURI();
 		DirConfig *config = getDirConfig(r);
@@ -930,6 +1112,9 @@ private:
 
 		if (connectionHeader != NULL && connectionUpgradeFlagSet(connectionHeader->val)) {
 			result.append("Connection: upgrade\r\n", sizeof("Connection: upgrade\r\n") - 1);
+			keepAlive = false;
+		} else if (keepAlive) {
+			result.append("Connection: keep-alive\r\n", sizeof("Connection: keep-alive\r\n") - 1);
 		} else {
 			result.append("Connection: close\r\n", sizeof("Connection: close\r\n") - 1);
 		}
@@ -1245,7 +1430,10 @@ private:
 public:
 	Hooks(apr_pool_t *pconf, apr_pool_t *plog, apr_pool_t *ptemp, server_rec *s)
 	    : cstat(1024),
-	      watchdogLauncher(IM_APACHE)
+	      watchdogLauncher(IM_APACHE),
+	      appTypeCache(serverConfig.statThrottleRate),
+	      coreConnectionsCreated(0),
+	      coreConnectionsReused(0)
 	{
 		postprocessConfig(s, pconf, ptemp);
 
@@ -1371,6 +1559,15 @@ public:
 
 	void childInit(apr_pool_t *pchild, server_rec *s) {
 		watchdogLauncher.detach();
+		apr_pool_cleanup_register(pchild, this, childExit, apr_pool_cleanup_null);
+	}
+
+	static apr_status_t childExit(void *arg) {
+		Hooks *self = (Hooks *) arg;
+		P_DEBUG("Connections to the Passenger core made by this Apache process: " <<
+			self->coreConnectionsCreated.load() << " new, " <<
+			self->coreConnectionsReused.load() << " reused");
+		return APR_SUCCESS;
 	}
 
 	int prepareRequestWhenInHighPerformanceMode(request_rec *r) {
@@ -91,6 +91,15 @@ ConfigManifestGenerator::autoGenerated_generateConfigManifestForServerConfig() {
 			serverConfig.adminPanelUsername.data(),
 			serverConfig.adminPanelUsername.data() + serverConfig.adminPanelUsername.size());
 	}
+	if (serverConfig.coreKeepAliveExplicitlySet) {
+		Json::Value &optionContainer = findOrCreateOptionContainer(globalOptionsContainer,
+			"PassengerCoreKeepAlive",
+			sizeof("PassengerCoreKeepAlive") - 1);
+		Json::Value &hierarchyMember = addOptionContainerHierarchyMember(optionContainer,
+			serverConfig.coreKeepAliveSourceFile,
+			serverConfig.coreKeepAliveSourceLine);
+		hierarchyMember["value"] = serverConfig.coreKeepAlive == Apache2Module::ENABLED;
+	}
 	if (serverConfig.dataBufferDirExplicitlySet) {
 		Json::Value &optionContainer = findOrCreateOptionContainer(globalOptionsContainer,
 			"PassengerDataBufferDir",
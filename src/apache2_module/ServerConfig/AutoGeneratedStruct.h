@@ -39,6 +39,11 @@
 
 struct AutoGeneratedServerConfig {
 
+	/*
+	 * Whether to reuse connections to the Phusion Passenger core across requests.
+	 */
+	bool coreKeepAlive;
+
 	/*
 	 * Whether to disable the Phusion Passenger security update check & notification.
 	 */
@@ -170,6 +175,7 @@ struct AutoGeneratedServerConfig {
 	std::set<std::string> prestartURLs;
 
 
+	StaticString coreKeepAliveSourceFile;
 	StaticString disableSecurityUpdateCheckSourceFile;
 	StaticString showVersionInHeaderSourceFile;
 	StaticString turbocachingSourceFile;
@@ -197,6 +203,7 @@ struct AutoGeneratedServerConfig {
 	StaticString securityUpdateCheckProxySourceFile;
 	StaticString prestartURLsSourceFile;
 
+	unsigned int coreKeepAliveSourceLine;
 	unsigned int disableSecurityUpdateCheckSourceLine;
 	unsigned int showVersionInHeaderSourceLine;
 	unsigned int turbocachingSourceLine;
@@ -224,6 +231,7 @@ struct AutoGeneratedServerConfig {
 	unsigned int securityUpdateCheckProxySourceLine;
 	unsigned int prestartURLsSourceLine;
 
+	bool coreKeepAliveExplicitlySet: 1;
 	bool disableSecurityUpdateCheckExplicitlySet: 1;
 	bool showVersionInHeaderExplicitlySet: 1;
 	bool turbocachingExplicitlySet: 1;
@@ -253,6 +261,7 @@ struct AutoGeneratedServerConfig {
 
 
 	AutoGeneratedServerConfig() {
+		coreKeepAlive = true;
 		disableSecurityUpdateCheck = false;
 		showVersionInHeader = true;
 		turbocaching = true;
@@ -306,6 +315,7 @@ struct AutoGeneratedServerConfig {
 		 * prestartURLs: default initialized
 		 */
 
+		coreKeepAliveSourceLine = 0;
 		disableSecurityUpdateCheckSourceLine = 0;
 		showVersionInHeaderSourceLine = 0;
 		turbocachingSourceLine = 0;
@@ -333,6 +343,7 @@ struct AutoGeneratedServerConfig {
 		securityUpdateCheckProxySourceLine = 0;
 		prestartURLsSourceLine = 0;
 
+		coreKeepAliveExplicitlySet = false;
 		disableSecurityUpdateCheckExplicitlySet = false;
 		showVersionInHeaderExplicitlySet = false;
 		turbocachingExplicitlySet = false;
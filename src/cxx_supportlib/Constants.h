@@ -37,6 +37,7 @@
  */
 
 #define AGENT_EXE "PassengerAgent"
+#define AUTOSCALING_SCALE_DOWN_IDLE_TIME 10
 #define DEB_APACHE_MODULE_PACKAGE "libapache2-mod-passenger"
 #define DEB_DEV_PACKAGE "passenger-dev"
 #define DEB_MAIN_PACKAGE "passenger"
@@ -58,13 +59,19 @@
 #define DEFAULT_MAX_POOL_SIZE 6
 #define DEFAULT_MAX_PRELOADER_IDLE_TIME 300
 #define DEFAULT_MAX_REQUEST_QUEUE_SIZE 100
+#define DEFAULT_MAX_SPAWN_CONCURRENCY 4
 #define DEFAULT_MBUF_CHUNK_SIZE 4096
+#define DEFAULT_MBUF_MAX_SPARE_MEMORY 67108864
 #define DEFAULT_NODEJS "node"
 #define DEFAULT_POOL_IDLE_TIME 300
 #define DEFAULT_PYTHON "python"
 #define DEFAULT_RESPONSE_BUFFER_HIGH_WATERMARK 134217728
+#define DEFAULT_RESPONSE_COMPRESSION_LEVEL 6
+#define DEFAULT_RESPONSE_COMPRESSION_MIN_SIZE 256
 #define DEFAULT_RUBY "ruby"
+#define DEFAULT_SMALL_MBUF_CHUNK_SIZE 1024
 #define DEFAULT_SOCKET_BACKLOG 2048
+#define DEFAULT_SPAWN_CONCURRENCY 1
 #define DEFAULT_SPAWN_METHOD "smart"
 #define DEFAULT_START_TIMEOUT 90000
 #define DEFAULT_STAT_THROTTLE_RATE 10
@@ -0,0 +1,422 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_LOGGING_KIT_ASYNC_WRITER_H_
+#define _PASSENGER_LOGGING_KIT_ASYNC_WRITER_H_
+
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <oxt/thread.hpp>
+#include <oxt/macros.hpp>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <sched.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <jsoncpp/json.h>
+
+namespace Passenger {
+namespace LoggingKit {
+
+using namespace std;
+
+
+/**
+ * An optional asynchronous log sink. Logging threads copy their log lines
+ * into a bounded, lock-free multi-producer ring buffer, and a single
+ * background thread drains that buffer, coalescing consecutive lines for
+ * the same file descriptor into a single writev() call. This takes the
+ * write() system calls off the calling threads (e.g. the Controller's
+ * event loop threads), and turns a burst of N log lines into a few
+ * system calls instead of N.
+ *
+ * The ring buffer is the bounded MPMC queue by Dmitry Vyukov, with the
+ * consumer side simplified because there is only one consumer. When the
+ * buffer is full, `write()` behaves according to the given OverflowPolicy:
+ * it either waits until the writer thread has made room, or it drops the
+ * line. Both cases are counted, see `inspectStateAsJson()`.
+ *
+ * Lines that are still in the buffer when the process crashes are lost.
+ * Lines written from a forked child process are written synchronously,
+ * because the child does not have a writer thread.
+ */
+class AsyncWriter: private boost::noncopyable {
+public:
+	enum OverflowPolicy {
+		BLOCK_ON_OVERFLOW,
+		DROP_ON_OVERFLOW
+	};
+
+	static const unsigned int DEFAULT_CAPACITY = 4096;
+
+private:
+	/** Maximum number of lines passed to a single writev() call. */
+	static const unsigned int MAX_BATCH_SIZE = 64;
+
+	struct Slot {
+		boost::atomic<size_t> sequence;
+		int fd;
+		/** An fd to also write to, and to close afterwards. -1 if none. */
+		int ownedFd;
+		char *data;
+		unsigned int size;
+	};
+
+	Slot *slots;
+	size_t mask;
+	pid_t pid;
+
+	/** Only touched by producers. */
+	char padding1[64];
+	boost::atomic<size_t> enqueuePos;
+	/** Only touched by the writer thread. */
+	char padding2[64];
+	size_t dequeuePos;
+	char padding3[64];
+
+	boost::atomic<bool> writerSleeping;
+	boost::atomic<boost::uint64_t> linesWritten;
+	boost::atomic<boost::uint64_t> writeCalls;
+	boost::atomic<boost::uint64_t> linesDropped;
+	boost::atomic<boost::uint64_t> blockedWrites;
+
+	boost::mutex syncher;
+	boost::condition_variable cond;
+	bool quit;
+	oxt::thread *thread;
+
+	static size_t roundUpToPowerOf2(size_t v) {
+		size_t result = 1;
+		while (result < v) {
+			result *= 2;
+		}
+		return result;
+	}
+
+	/** Like writeExactWithoutOXT(), errors are ignored. */
+	static void writeAll(int fd, const char *str, unsigned int size) {
+		ssize_t ret;
+		unsigned int written = 0;
+		while (written < size) {
+			do {
+				ret = ::write(fd, str + written, size - written);
+			} while (ret == -1 && errno == EINTR);
+			if (ret == -1) {
+				break;
+			} else {
+				written += ret;
+			}
+		}
+	}
+
+	static void writevAll(int fd, struct iovec *iov, unsigned int count) {
+		ssize_t ret;
+		while (count > 0) {
+			do {
+				ret = ::writev(fd, iov, count);
+			} while (ret == -1 && errno == EINTR);
+			if (ret == -1) {
+				break;
+			}
+
+			// Skip over the fully written vectors and adjust
+			// the partially written one.
+			size_t written = ret;
+			while (count > 0 && written >= iov->iov_len) {
+				written -= iov->iov_len;
+				iov++;
+				count--;
+			}
+			if (count > 0) {
+				iov->iov_base = (char *) iov->iov_base + written;
+				iov->iov_len -= written;
+			}
+		}
+	}
+
+	bool tryPush(int fd, int ownedFd, char *data, unsigned int size) {
+		Slot *slot;
+		size_t pos = enqueuePos.load(boost::memory_order_relaxed);
+
+		while (true) {
+			slot = &slots[pos & mask];
+			size_t seq = slot->sequence.load(boost::memory_order_acquire);
+			ssize_t diff = (ssize_t) seq - (ssize_t) pos;
+			if (diff == 0) {
+				if (enqueuePos.compare_exchange_weak(pos, pos + 1,
+					boost::memory_order_relaxed))
+				{
+					break;
+				}
+			} else if (diff < 0) {
+				return false;
+			} else {
+				pos = enqueuePos.load(boost::memory_order_relaxed);
+			}
+		}
+
+		slot->fd = fd;
+		slot->ownedFd = ownedFd;
+		slot->data = data;
+		slot->size = size;
+		slot->sequence.store(pos + 1, boost::memory_order_release);
+		return true;
+	}
+
+	bool slotReady(size_t pos) const {
+		return slots[pos & mask].sequence.load(boost::memory_order_acquire) == pos + 1;
+	}
+
+	void wakeupWriter() {
+		// Pairs with the fence in threadMain(), so that either we see
+		// that the writer is going to sleep, or the writer sees our line.
+		boost::atomic_thread_fence(boost::memory_order_seq_cst);
+		if (writerSleeping.load(boost::memory_order_relaxed)) {
+			boost::lock_guard<boost::mutex> l(syncher);
+			cond.notify_one();
+		}
+	}
+
+	/**
+	 * Writes out up to MAX_BATCH_SIZE lines. Returns the number of
+	 * lines processed. Must only be called from a single thread.
+	 */
+	unsigned int processBatch() {
+		struct iovec iov[MAX_BATCH_SIZE];
+		unsigned int count = 0;
+		unsigned int i, iovCount;
+
+		while (count < MAX_BATCH_SIZE && slotReady(dequeuePos + count)) {
+			count++;
+		}
+		if (count == 0) {
+			return 0;
+		}
+
+		for (i = 0; i < count; i++) {
+			Slot *slot = &slots[(dequeuePos + i) & mask];
+			if (slot->ownedFd != -1) {
+				writeAll(slot->ownedFd, slot->data, slot->size);
+				::close(slot->ownedFd);
+			}
+		}
+
+		i = 0;
+		while (i < count) {
+			int fd = slots[(dequeuePos + i) & mask].fd;
+			iovCount = 0;
+			while (i < count && slots[(dequeuePos + i) & mask].fd == fd) {
+				Slot *slot = &slots[(dequeuePos + i) & mask];
+				iov[iovCount].iov_base = slot->data;
+				iov[iovCount].iov_len = slot->size;
+				iovCount++;
+				i++;
+			}
+			writevAll(fd, iov, iovCount);
+			writeCalls.fetch_add(1, boost::memory_order_relaxed);
+		}
+
+		for (i = 0; i < count; i++) {
+			Slot *slot = &slots[(dequeuePos + i) & mask];
+			free(slot->data);
+			slot->sequence.store(dequeuePos + i + mask + 1,
+				boost::memory_order_release);
+		}
+		dequeuePos += count;
+		linesWritten.fetch_add(count, boost::memory_order_relaxed);
+		return count;
+	}
+
+	void threadMain() {
+		while (true) {
+			if (processBatch() > 0) {
+				continue;
+			}
+
+			boost::unique_lock<boost::mutex> l(syncher);
+			writerSleeping.store(true, boost::memory_order_relaxed);
+			boost::atomic_thread_fence(boost::memory_order_seq_cst);
+			if (!slotReady(dequeuePos)) {
+				if (quit) {
+					writerSleeping.store(false, boost::memory_order_relaxed);
+					break;
+				}
+				// The timeout is only a safety net.
+				cond.timed_wait(l, boost::posix_time::milliseconds(100));
+			}
+			writerSleeping.store(false, boost::memory_order_relaxed);
+		}
+	}
+
+public:
+	/**
+	 * @throws boost::thread_resource_error The writer thread cannot be created.
+	 */
+	AsyncWriter(unsigned int capacity = DEFAULT_CAPACITY)
+		: pid(getpid()),
+		  enqueuePos(0),
+		  dequeuePos(0),
+		  writerSleeping(false),
+		  linesWritten(0),
+		  writeCalls(0),
+		  linesDropped(0),
+		  blockedWrites(0),
+		  quit(false),
+		  thread(NULL)
+	{
+		size_t size = roundUpToPowerOf2(std::max<unsigned int>(capacity, 2));
+		mask = size - 1;
+		slots = new Slot[size];
+		for (size_t i = 0; i < size; i++) {
+			slots[i].sequence.store(i, boost::memory_order_relaxed);
+		}
+
+		try {
+			thread = new oxt::thread(boost::bind(&AsyncWriter::threadMain, this),
+				"LoggingKit async writer", 128 * 1024);
+		} catch (...) {
+			delete[] slots;
+			throw;
+		}
+	}
+
+	/**
+	 * Writes out all remaining lines, then stops the writer thread.
+	 */
+	~AsyncWriter() {
+		{
+			boost::lock_guard<boost::mutex> l(syncher);
+			quit = true;
+			cond.notify_one();
+		}
+		thread->join();
+		delete thread;
+		delete[] slots;
+	}
+
+	/**
+	 * Queues `str` for writing to `fd`. If `ownedFd` is not -1, then the
+	 * data is written to that fd too, after which it is closed: ownership
+	 * of `ownedFd` is transferred to this AsyncWriter.
+	 *
+	 * Returns false if the line was dropped because of DROP_ON_OVERFLOW.
+	 */
+	bool write(int fd, const char *str, unsigned int size,
+		OverflowPolicy overflowPolicy = BLOCK_ON_OVERFLOW, int ownedFd = -1)
+	{
+		if (OXT_UNLIKELY(getpid() != pid)) {
+			if (ownedFd != -1) {
+				writeAll(ownedFd, str, size);
+				::close(ownedFd);
+			}
+			writeAll(fd, str, size);
+			return true;
+		}
+
+		char *data = (char *) malloc(size);
+		if (OXT_UNLIKELY(data == NULL)) {
+			linesDropped.fetch_add(1, boost::memory_order_relaxed);
+			if (ownedFd != -1) {
+				::close(ownedFd);
+			}
+			return false;
+		}
+		memcpy(data, str, size);
+
+		if (OXT_UNLIKELY(!tryPush(fd, ownedFd, data, size))) {
+			if (overflowPolicy == DROP_ON_OVERFLOW) {
+				linesDropped.fetch_add(1, boost::memory_order_relaxed);
+				free(data);
+				if (ownedFd != -1) {
+					::close(ownedFd);
+				}
+				return false;
+			}
+
+			blockedWrites.fetch_add(1, boost::memory_order_relaxed);
+			unsigned int tries = 0;
+			do {
+				wakeupWriter();
+				if (tries < 100) {
+					sched_yield();
+					tries++;
+				} else {
+					usleep(1000);
+				}
+			} while (!tryPush(fd, ownedFd, data, size));
+		}
+
+		wakeupWriter();
+		return true;
+	}
+
+	/**
+	 * Blocks until all lines that were queued before this call
+	 * have been written. Mainly useful in unit tests.
+	 */
+	void flush() {
+		size_t pos = enqueuePos.load(boost::memory_order_relaxed);
+		while (pos > 0 && slots[(pos - 1) & mask].sequence.load(boost::memory_order_acquire)
+			< pos + mask)
+		{
+			wakeupWriter();
+			usleep(1000);
+		}
+	}
+
+	unsigned int capacity() const {
+		return mask + 1;
+	}
+
+	boost::uint64_t getLinesDropped() const {
+		return linesDropped.load(boost::memory_order_relaxed);
+	}
+
+	boost::uint64_t getBlockedWrites() const {
+		return blockedWrites.load(boost::memory_order_relaxed);
+	}
+
+	Json::Value inspectStateAsJson() const {
+		Json::Value doc;
+		doc["capacity"] = capacity();
+		doc["lines_written"] = (Json::UInt64) linesWritten.load(boost::memory_order_relaxed);
+		doc["write_calls"] = (Json::UInt64) writeCalls.load(boost::memory_order_relaxed);
+		doc["lines_dropped"] = (Json::UInt64) linesDropped.load(boost::memory_order_relaxed);
+		doc["blocked_writes"] = (Json::UInt64) blockedWrites.load(boost::memory_order_relaxed);
+		return doc;
+	}
+};
+
+
+} // namespace LoggingKit
+} // namespace Passenger
+
+#endif /* _PASSENGER_LOGGING_KIT_ASYNC_WRITER_H_ */
@@ -34,6 +34,7 @@
 #include <vector>
 
 #include <LoggingKit/Forward.h>
+#include <LoggingKit/AsyncWriter.h>
 #include <ConfigKit/Schema.h>
 
 #include <jsoncpp/json.h>
@@ -49,12 +50,15 @@ using namespace std;
  * (do not edit: following text is automatically generated
  * by 'rake configkit_schemas_inline_comments')
  *
- *   app_output_log_level         string    -   default("notice")
- *   buffer_logs                  boolean   -   default(false)
- *   file_descriptor_log_target   any       -   -
- *   level                        string    -   default("notice")
- *   redirect_stderr              boolean   -   default(true)
- *   target                       any       -   default({"stderr": true})
+ *   app_output_log_level         string             -   default("notice")
+ *   async_buffer_size            unsigned integer   -   default(4096),read_only
+ *   async_overflow_policy        string             -   default("block")
+ *   async_writes                 boolean            -   default(false)
+ *   buffer_logs                  boolean            -   default(false)
+ *   file_descriptor_log_target   any                -   -
+ *   level                        string             -   default("notice")
+ *   redirect_stderr              boolean            -   default(true)
+ *   target                       any                -   default({"stderr": true})
  *
  * END
  */
@@ -65,6 +69,8 @@ private:
 		vector<ConfigKit::Error> &errors);
 	static void validateTarget(const string &key, const ConfigKit::Store &store,
 		vector<ConfigKit::Error> &errors);
+	static void validateAsyncOverflowPolicy(const ConfigKit::Store &store,
+		vector<ConfigKit::Error> &errors);
 
 public:
 	Schema();
@@ -85,6 +91,13 @@ struct ConfigRealization {
 	int targetFd;
 	bool saveLog;
 	int fileDescriptorLogTargetFd;
+	/**
+	 * Set by the Context if the "async_writes" option is enabled. Not owned
+	 * by this ConfigRealization: the Context keeps a single AsyncWriter
+	 * that is shared by all ConfigRealizations.
+	 */
+	AsyncWriter *asyncWriter;
+	AsyncWriter::OverflowPolicy asyncOverflowPolicy;
 	FdClosePolicy targetFdClosePolicy;
 	FdClosePolicy fileDescriptorLogTargetFdClosePolicy;
 	bool finalized;
@@ -37,6 +37,7 @@
 #include <ConfigKit/ConfigKit.h>
 #include <LoggingKit/Forward.h>
 #include <LoggingKit/Config.h>
+#include <LoggingKit/AsyncWriter.h>
 #include <Utils/SystemTime.h>
 #include <DataStructures/StringKeyTable.h>
 
@@ -74,6 +75,7 @@ private:
 	mutable boost::mutex syncher;
 	ConfigKit::Store config;
 	boost::atomic<ConfigRealization *> configRlz;
+	AsyncWriter *asyncWriter;
 
 	mutable boost::mutex gcSyncher;
 	oxt::thread *gcThread;
@@ -119,6 +121,7 @@ public:
 	void commitConfigChange(LoggingKit::ConfigChangeRequest &req)
 		BOOST_NOEXCEPT_OR_NOTHROW;
 	Json::Value inspectConfig() const;
+	Json::Value inspectAsyncWriterState() const;
 
 	OXT_FORCE_INLINE
 	const ConfigRealization *getConfigRealization() const {
@@ -132,6 +135,7 @@ private:
 	pair<ConfigRealization*,MonotonicTimeUsec> peekOldConfig();
 	void popOldConfig(ConfigRealization *oldConfig);
 	bool oldConfigsExist();
+	void setupAsyncWriter(ConfigRealization *rlz, const ConfigKit::Store &config);
 	void createGcThread();
 	void killGcThread();
 	void gcLockless(bool wait, boost::unique_lock<boost::mutex> &lock);
@@ -293,7 +293,12 @@ writeExactWithoutOXT(int fd, const char *str, unsigned int size) {
 void
 _writeLogEntry(const ConfigRealization *configRealization, const char *str, unsigned int size) {
 	if (OXT_LIKELY(configRealization != NULL)) {
-		writeExactWithoutOXT(configRealization->targetFd, str, size);
+		if (configRealization->asyncWriter != NULL) {
+			configRealization->asyncWriter->write(configRealization->targetFd,
+				str, size, configRealization->asyncOverflowPolicy);
+		} else {
+			writeExactWithoutOXT(configRealization->targetFd, str, size);
+		}
 	} else {
 		writeExactWithoutOXT(STDERR_FILENO, str, size);
 	}
@@ -306,7 +311,12 @@ _writeFileDescriptorLogEntry(const ConfigRealization *configRealization,
 	assert(configRealization != NULL);
 	assert(configRealization->fileDescriptorLogTargetType != UNKNOWN_TARGET);
 	assert(configRealization->fileDescriptorLogTargetFd != -1);
-	writeExactWithoutOXT(configRealization->fileDescriptorLogTargetFd, str, size);
+	if (configRealization->asyncWriter != NULL) {
+		configRealization->asyncWriter->write(configRealization->fileDescriptorLogTargetFd,
+			str, size, configRealization->asyncOverflowPolicy);
+	} else {
+		writeExactWithoutOXT(configRealization->fileDescriptorLogTargetFd, str, size);
+	}
 }
 
 void
@@ -409,7 +419,8 @@ realLogAppOutput(const HashedStaticString &groupName, int targetFd,
 	const char *pidStr, unsigned int pidStrLen,
 	const char *channelName, unsigned int channelNameLen,
 	const char *message, unsigned int messageLen, int appLogFile,
-	bool saveLog)
+	bool saveLog, AsyncWriter *asyncWriter,
+	AsyncWriter::OverflowPolicy asyncOverflowPolicy)
 {
 	char *pos = buf;
 	char *end = buf + bufSize;
@@ -425,10 +436,17 @@ realLogAppOutput(const HashedStaticString &groupName, int targetFd,
 	if (OXT_UNLIKELY(context != NULL && saveLog)) {
 		context->saveNewLog(groupName, pidStr, pidStrLen, message, messageLen);
 	}
-	if (appLogFile > -1) {
-		writeExactWithoutOXT(appLogFile, buf, pos - buf);
+	if (asyncWriter != NULL) {
+		// Transfers ownership of appLogFile to the AsyncWriter.
+		asyncWriter->write(targetFd, buf, pos - buf, asyncOverflowPolicy,
+			appLogFile);
+	} else {
+		if (appLogFile > -1) {
+			writeExactWithoutOXT(appLogFile, buf, pos - buf);
+			close(appLogFile);
+		}
+		writeExactWithoutOXT(targetFd, buf, pos - buf);
 	}
-	writeExactWithoutOXT(targetFd, buf, pos - buf);
 }
 
 void
@@ -437,6 +455,8 @@ logAppOutput(const HashedStaticString &groupName, pid_t pid, const StaticString
 {
 	int targetFd;
 	bool saveLog = false;
+	AsyncWriter *asyncWriter = NULL;
+	AsyncWriter::OverflowPolicy asyncOverflowPolicy = AsyncWriter::BLOCK_ON_OVERFLOW;
 
 	if (OXT_LIKELY(context != NULL)) {
 		const ConfigRealization *configRealization = context->getConfigRealization();
@@ -446,6 +466,8 @@ logAppOutput(const HashedStaticString &groupName, pid_t pid, const StaticString
 
 		targetFd = configRealization->targetFd;
 		saveLog = configRealization->saveLog;
+		asyncWriter = configRealization->asyncWriter;
+		asyncOverflowPolicy = configRealization->asyncOverflowPolicy;
 	} else {
 		targetFd = STDERR_FILENO;
 	}
@@ -476,16 +498,17 @@ logAppOutput(const HashedStaticString &groupName, pid_t pid, const StaticString
 			buf, sizeof(buf),
 			pidStr, pidStrLen,
 			channelName.data(), channelName.size(),
-			message, size, fd, saveLog);
+			message, size, fd, saveLog,
+			asyncWriter, asyncOverflowPolicy);
 	} else {
 		DynamicBuffer buf(totalLen);
 		realLogAppOutput(groupName, targetFd,
 			buf.data, totalLen,
 			pidStr, pidStrLen,
 			channelName.data(), channelName.size(),
-			message, size, fd, saveLog);
+			message, size, fd, saveLog,
+			asyncWriter, asyncOverflowPolicy);
 	}
-	if(fd > -1){close(fd);}
 }
 
 
@@ -523,10 +546,12 @@ normalizeConfig(const Json::Value &effectiveValues) {
 Context::Context(const Json::Value &initialConfig,
 	const ConfigKit::Translator &translator)
 	: config(schema, initialConfig, translator),
+	  asyncWriter(NULL),
 	  gcThread(NULL),
 	  shuttingDown(false)
 {
 	configRlz.store(new ConfigRealization(config));
+	setupAsyncWriter(configRlz.load(), config);
 	configRlz.load()->apply(config, NULL);
 	configRlz.load()->finalize();
 }
@@ -545,6 +570,10 @@ Context::~Context() {
 	killGcThread();
 	gcLockless(false, l);
 
+	// Writes out all remaining lines. This must happen before the
+	// ConfigRealization closes the fds that those lines are queued for.
+	delete asyncWriter;
+	asyncWriter = NULL;
 	delete configRlz.load();
 }
 
@@ -576,6 +605,7 @@ Context::commitConfigChange(LoggingKit::ConfigChangeRequest &req) BOOST_NOEXCEPT
 	ConfigRealization *oldConfigRlz = configRlz.load();
 	ConfigRealization *newConfigRlz = req.configRlz;
 
+	setupAsyncWriter(req.configRlz, *req.config);
 	req.configRlz->apply(*req.config, oldConfigRlz);
 
 	config.swap(*req.config);
@@ -592,6 +622,38 @@ Context::inspectConfig() const {
 	return config.inspect();
 }
 
+Json::Value
+Context::inspectAsyncWriterState() const {
+	boost::lock_guard<boost::mutex> l(syncher);
+	Json::Value doc;
+	if (asyncWriter != NULL) {
+		doc = asyncWriter->inspectStateAsJson();
+	} else {
+		doc = Json::objectValue;
+	}
+	doc["enabled"] = config["async_writes"].asBool();
+	return doc;
+}
+
+void
+Context::setupAsyncWriter(ConfigRealization *rlz, const ConfigKit::Store &config) {
+	// The AsyncWriter is created when async writes are first enabled,
+	// and lives until the Context is destroyed. Threads may still be
+	// writing through an older ConfigRealization, so it is never
+	// destroyed when async writes are disabled again.
+	if (config["async_writes"].asBool() && asyncWriter == NULL) {
+		try {
+			asyncWriter = new AsyncWriter(config["async_buffer_size"].asUInt());
+		} catch (const std::exception &e) {
+			P_ERROR("Error spawning background thread for asynchronous"
+				" log writing, falling back to synchronous writes: " << e.what());
+		}
+	}
+	if (config["async_writes"].asBool()) {
+		rlz->asyncWriter = asyncWriter;
+	}
+}
+
 pair<ConfigRealization*,MonotonicTimeUsec>
 Context::peekOldConfig() {
 	return oldConfigs.front();
@@ -599,6 +661,11 @@ Context::peekOldConfig() {
 
 void
 Context::popOldConfig(ConfigRealization *oldConfig) {
+	// Lines for the old config's fds may still be queued. Write them
+	// out before those fds are closed (and possibly reused).
+	if (oldConfig->asyncWriter != NULL) {
+		oldConfig->asyncWriter->flush();
+	}
 	delete oldConfig;
 	oldConfigs.pop();
 }
@@ -760,6 +827,18 @@ Schema::validateTarget(const string &key, const ConfigKit::Store &store,
 	}
 }
 
+void
+Schema::validateAsyncOverflowPolicy(const ConfigKit::Store &store,
+	vector<ConfigKit::Error> &errors)
+{
+	typedef ConfigKit::Error Error;
+	string policy = store["async_overflow_policy"].asString();
+	if (policy != "block" && policy != "drop") {
+		errors.push_back(Error("'{{async_overflow_policy}}' must be either"
+			" 'block' or 'drop'"));
+	}
+}
+
 static Json::Value
 filterTargetFd(const Json::Value &value) {
 	Json::Value result = value;
@@ -778,6 +857,9 @@ Schema::Schema() {
 	add("redirect_stderr", BOOL_TYPE, OPTIONAL, true);
 	add("app_output_log_level", STRING_TYPE, OPTIONAL, DEFAULT_APP_OUTPUT_LOG_LEVEL_NAME);
 	add("buffer_logs", BOOL_TYPE, OPTIONAL, false);
+	add("async_writes", BOOL_TYPE, OPTIONAL, false);
+	add("async_buffer_size", UINT_TYPE, OPTIONAL | READ_ONLY, AsyncWriter::DEFAULT_CAPACITY);
+	add("async_overflow_policy", STRING_TYPE, OPTIONAL, "block");
 
 	addValidator(boost::bind(validateLogLevel, "level",
 		boost::placeholders::_1, boost::placeholders::_2));
@@ -787,6 +869,7 @@ Schema::Schema() {
 		boost::placeholders::_1, boost::placeholders::_2));
 	addValidator(boost::bind(validateTarget, "file_descriptor_log_target",
 		boost::placeholders::_1, boost::placeholders::_2));
+	addValidator(validateAsyncOverflowPolicy);
 
 	addNormalizer(normalizeConfig);
 
@@ -798,6 +881,10 @@ ConfigRealization::ConfigRealization(const ConfigKit::Store &store)
 	: level(parseLevel(store["level"].asString())),
 	  appOutputLogLevel(parseLevel(store["app_output_log_level"].asString())),
 	  saveLog(store["buffer_logs"].asBool()),
+	  asyncWriter(NULL),
+	  asyncOverflowPolicy(store["async_overflow_policy"].asString() == "drop"
+		? AsyncWriter::DROP_ON_OVERFLOW
+		: AsyncWriter::BLOCK_ON_OVERFLOW),
 	  finalized(false)
 {
 	if (store["target"].isMember("stderr")) {
@@ -23,6 +23,8 @@
 #include <oxt/backtrace.hpp>
 #include <algorithm>
 #include <ostream>
+#include <sys/mman.h>
+#include <oxt/thread.hpp>
 #include <MemoryKit/mbuf.h>
 #include <LoggingKit/LoggingKit.h>
 #include <StaticString.h>
@@ -58,6 +60,41 @@ _mbuf_block_mark_as_active(struct mbuf_pool *pool, struct mbuf_block *mbuf_block
 	#endif
 	mbuf_block->refcount = 1;
 	pool->nactive_mbuf_blockq++;
+	if (mbuf_block->slab != NULL) {
+		mbuf_block->slab->nactive++;
+	}
+}
+
+/*
+ * Whether the calling thread may put mbuf_blocks directly on the pool's
+ * freelist. See mbuf_pool_set_owner().
+ */
+static bool
+_mbuf_pool_on_owner_thread(struct mbuf_pool *pool)
+{
+	#ifdef OXT_THREAD_LOCAL_KEYWORD_SUPPORTED
+		return pool->owner == NULL || oxt::thread_signature == pool->owner;
+	#else
+		return true;
+	#endif
+}
+
+/*
+ * Hands an mbuf_block whose reference count dropped to zero on a
+ * non-owner thread over to the owner thread. This is a lock-free stack
+ * push. The owner always takes the entire stack at once (see
+ * mbuf_pool_reclaim_remote_frees()), so there is no ABA problem.
+ */
+static void
+_mbuf_block_push_remote_free(struct mbuf_block *mbuf_block)
+{
+	struct mbuf_pool *pool = mbuf_block->pool;
+	struct mbuf_block *head = pool->remote_free_head.load(boost::memory_order_relaxed);
+
+	do {
+		mbuf_block->remote_next = head;
+	} while (!pool->remote_free_head.compare_exchange_weak(head, mbuf_block,
+		boost::memory_order_release, boost::memory_order_relaxed));
 }
 
 static struct mbuf_block *
@@ -113,7 +150,103 @@ _mbuf_block_init(struct mbuf_pool *pool, char *buf, size_t block_offset)
 	mbuf_block = (struct mbuf_block *)(buf + block_offset);
 	mbuf_block->magic = MBUF_BLOCK_MAGIC;
 	mbuf_block->pool  = pool;
+	mbuf_block->slab  = NULL;
+	mbuf_block->remote_next = NULL;
+	mbuf_block->offset = 0;
+	pool->nallocated++;
+
+	_mbuf_block_mark_as_active(pool, mbuf_block);
+	return mbuf_block;
+}
+
+static struct mbuf_slab *
+_mbuf_slab_new(struct mbuf_pool *pool)
+{
+	struct mbuf_slab *slab;
+	size_t map_size = pool->slab_size;
+	char *start;
+
+	slab = (struct mbuf_slab *) malloc(sizeof(struct mbuf_slab));
+	if (OXT_UNLIKELY(slab == NULL)) {
+		return NULL;
+	}
+
+	if (pool->huge_pages) {
+		// Over-allocate so that we can align the slab on a huge page
+		// boundary. The kernel only uses huge pages for aligned regions.
+		map_size += MBUF_HUGE_PAGE_SIZE;
+	}
+	start = (char *) mmap(NULL, map_size, PROT_READ | PROT_WRITE,
+		MAP_PRIVATE | MAP_ANON, -1, 0);
+	if (OXT_UNLIKELY(start == (char *) MAP_FAILED)) {
+		free(slab);
+		return NULL;
+	}
+
+	if (pool->huge_pages) {
+		char *aligned = (char *) (((uintptr_t) start + MBUF_HUGE_PAGE_SIZE - 1)
+			& ~((uintptr_t) MBUF_HUGE_PAGE_SIZE - 1));
+		if (aligned > start) {
+			munmap(start, aligned - start);
+		}
+		if (aligned + pool->slab_size < start + map_size) {
+			munmap(aligned + pool->slab_size,
+				(start + map_size) - (aligned + pool->slab_size));
+		}
+		start = aligned;
+		#ifdef MADV_HUGEPAGE
+			madvise(start, pool->slab_size, MADV_HUGEPAGE);
+		#endif
+	}
+
+	slab->start = start;
+	slab->size = pool->slab_size;
+	slab->ncarved = 0;
+	slab->nactive = 0;
+	slab->releasing = false;
+	LIST_INSERT_HEAD(&pool->slabs, slab, next);
+	pool->nslabs++;
+	return slab;
+}
+
+static void
+_mbuf_slab_free(struct mbuf_pool *pool, struct mbuf_slab *slab)
+{
+	assert(slab->nactive == 0);
+	if (pool->current_slab == slab) {
+		pool->current_slab = NULL;
+	}
+	LIST_REMOVE(slab, next);
+	pool->nslabs--;
+	munmap(slab->start, slab->size);
+	free(slab);
+}
+
+static struct mbuf_block *
+_mbuf_block_carve_from_slab(struct mbuf_pool *pool)
+{
+	struct mbuf_slab *slab = pool->current_slab;
+	struct mbuf_block *mbuf_block;
+
+	if (slab == NULL
+	 || (slab->ncarved + 1) * pool->mbuf_block_chunk_size > slab->size)
+	{
+		slab = pool->current_slab = _mbuf_slab_new(pool);
+		if (OXT_UNLIKELY(slab == NULL)) {
+			return NULL;
+		}
+	}
+
+	mbuf_block = (struct mbuf_block *) (slab->start
+		+ slab->ncarved * pool->mbuf_block_chunk_size
+		+ pool->mbuf_block_offset);
+	mbuf_block->magic = MBUF_BLOCK_MAGIC;
+	mbuf_block->pool  = pool;
+	mbuf_block->slab  = slab;
+	mbuf_block->remote_next = NULL;
 	mbuf_block->offset = 0;
+	slab->ncarved++;
+	pool->nallocated++;
 
 	_mbuf_block_mark_as_active(pool, mbuf_block);
 	return mbuf_block;
@@ -125,6 +258,12 @@ _mbuf_block_get(struct mbuf_pool *pool)
 	struct mbuf_block *mbuf_block;
 	char *buf;
 
+	if (STAILQ_EMPTY(&pool->free_mbuf_blockq)
+	 && pool->remote_free_head.load(boost::memory_order_relaxed) != NULL)
+	{
+		mbuf_pool_reclaim_remote_frees(pool);
+	}
+
 	if (!STAILQ_EMPTY(&pool->free_mbuf_blockq)) {
 		assert(pool->nfree_mbuf_blockq > 0);
 
@@ -138,6 +277,10 @@ _mbuf_block_get(struct mbuf_pool *pool)
 		return mbuf_block;
 	}
 
+	if (pool->slab_size > 0) {
+		return _mbuf_block_carve_from_slab(pool);
+	}
+
 	buf = (char *) malloc(pool->mbuf_block_chunk_size);
 	if (OXT_UNLIKELY(buf == NULL)) {
 		return NULL;
@@ -213,6 +356,7 @@ mbuf_block_free(struct mbuf_block *mbuf_block)
 
 	ASSERT_MBUF_BLOCK_PROPERTY(mbuf_block, STAILQ_NEXT(mbuf_block, next) == NULL);
 	ASSERT_MBUF_BLOCK_PROPERTY(mbuf_block, mbuf_block->magic == MBUF_BLOCK_MAGIC);
+	ASSERT_MBUF_BLOCK_PROPERTY(mbuf_block, mbuf_block->slab == NULL);
 
 	#ifdef MBUF_ENABLE_DEBUGGING
 		TAILQ_REMOVE(&mbuf_block->pool->active_mbuf_blockq, mbuf_block, active_q);
@@ -239,11 +383,20 @@ mbuf_block_put(struct mbuf_block *mbuf_block)
 	ASSERT_MBUF_BLOCK_PROPERTY(mbuf_block, STAILQ_NEXT(mbuf_block, next) == NULL);
 	ASSERT_MBUF_BLOCK_PROPERTY(mbuf_block, mbuf_block->magic == MBUF_BLOCK_MAGIC);
 	ASSERT_MBUF_BLOCK_PROPERTY(mbuf_block, mbuf_block->refcount == 0);
-	ASSERT_MBUF_BLOCK_PROPERTY(mbuf_block, mbuf_block->pool->nactive_mbuf_blockq > 0);
 	ASSERT_MBUF_BLOCK_PROPERTY(mbuf_block, mbuf_block->offset == 0);
 
+	if (!_mbuf_pool_on_owner_thread(mbuf_block->pool)) {
+		_mbuf_block_push_remote_free(mbuf_block);
+		return;
+	}
+
+	ASSERT_MBUF_BLOCK_PROPERTY(mbuf_block, mbuf_block->pool->nactive_mbuf_blockq > 0);
+
 	mbuf_block->pool->nfree_mbuf_blockq++;
 	mbuf_block->pool->nactive_mbuf_blockq--;
+	if (mbuf_block->slab != NULL) {
+		mbuf_block->slab->nactive--;
+	}
 	STAILQ_INSERT_HEAD(&mbuf_block->pool->free_mbuf_blockq, mbuf_block, next);
 
 	#ifdef MBUF_ENABLE_DEBUGGING
@@ -251,18 +404,6 @@ mbuf_block_put(struct mbuf_block *mbuf_block)
 	#endif
 }
 
-/*
- * Remove mbuf_block from the mhdr Q
- */
-static void
-mbuf_block_remove(struct mhdr *mhdr, struct mbuf_block *mbuf_block)
-{
-	//log_debug(LOG_VVERB, "remove mbuf_block %p", mbuf_block);
-
-	STAILQ_REMOVE(mhdr, mbuf_block, struct mbuf_block, next);
-	STAILQ_NEXT(mbuf_block, next) = NULL;
-}
-
 void
 _mbuf_block_assert_refcount_at_least_two(struct mbuf_block *mbuf_block) {
 	ASSERT_MBUF_BLOCK_PROPERTY(mbuf_block, mbuf_block->refcount >= 2);
@@ -280,6 +421,60 @@ mbuf_pool_init(struct mbuf_pool *pool)
 	#endif
 
 	pool->mbuf_block_offset = pool->mbuf_block_chunk_size - MBUF_BLOCK_HSIZE;
+
+	pool->slab_size = 0;
+	pool->huge_pages = false;
+	pool->nslabs = 0;
+	LIST_INIT(&pool->slabs);
+	pool->current_slab = NULL;
+
+	pool->owner = NULL;
+	pool->remote_free_head.store(NULL, boost::memory_order_relaxed);
+
+	pool->nallocated = 0;
+	pool->nremote_frees = 0;
+	pool->ntrimmed = 0;
+}
+
+/*
+ * Makes the pool carve mbuf_blocks out of `slab_size` bytes large mmap()ed
+ * regions instead of malloc()ing every block separately. This reduces
+ * allocator overhead and fragmentation, and allows using transparent huge
+ * pages. A slab is only returned to the OS once all its blocks are free.
+ *
+ * Must be called right after mbuf_pool_init(), before any block is allocated.
+ */
+void
+mbuf_pool_enable_slabs(struct mbuf_pool *pool, size_t slab_size, bool huge_pages)
+{
+	assert(pool->nallocated == 0);
+
+	if (huge_pages) {
+		slab_size = std::max<size_t>(slab_size, MBUF_HUGE_PAGE_SIZE);
+		slab_size = (slab_size + MBUF_HUGE_PAGE_SIZE - 1)
+			/ MBUF_HUGE_PAGE_SIZE * MBUF_HUGE_PAGE_SIZE;
+	} else {
+		slab_size = std::max<size_t>(slab_size, pool->mbuf_block_chunk_size);
+	}
+	// Blocks never straddle slabs.
+	slab_size = slab_size / pool->mbuf_block_chunk_size * pool->mbuf_block_chunk_size;
+
+	pool->slab_size = slab_size;
+	pool->huge_pages = huge_pages;
+}
+
+/*
+ * Declares that the pool is used by the thread whose oxt::thread_signature
+ * equals `owner` (in ServerKit: the event loop thread of the SafeLibev that
+ * the Context belongs to). From then on, blocks that are put on any other
+ * thread go to a lock-free queue instead of the freelist, and are reclaimed
+ * by the owner the next time its freelist runs empty or it calls
+ * mbuf_pool_reclaim_remote_frees().
+ */
+void
+mbuf_pool_set_owner(struct mbuf_pool *pool, const void *owner)
+{
+	pool->owner = owner;
 }
 
 void
@@ -298,22 +493,147 @@ mbuf_pool_data_size(struct mbuf_pool *pool)
 	return pool->mbuf_block_offset;
 }
 
+static void
+_mbuf_block_release_standalone(struct mbuf_block *mbuf_block)
+{
+	ASSERT_MBUF_BLOCK_PROPERTY(mbuf_block, mbuf_block->pool->nactive_mbuf_blockq > 0);
+	mbuf_block->pool->nactive_mbuf_blockq--;
+	mbuf_block_free(mbuf_block);
+}
+
+/*
+ * Puts all blocks that other threads released onto the freelist. Must be
+ * called from the owner thread. Returns the number of blocks reclaimed.
+ */
 unsigned int
-mbuf_pool_compact(struct mbuf_pool *pool)
+mbuf_pool_reclaim_remote_frees(struct mbuf_pool *pool)
 {
-	unsigned int count = pool->nfree_mbuf_blockq;
+	struct mbuf_block *mbuf_block = pool->remote_free_head.exchange(NULL,
+		boost::memory_order_acquire);
+	unsigned int count = 0;
+
+	while (mbuf_block != NULL) {
+		struct mbuf_block *next = mbuf_block->remote_next;
+		mbuf_block->remote_next = NULL;
+		ASSERT_MBUF_BLOCK_PROPERTY(mbuf_block, mbuf_block->refcount == 0);
+
+		if (mbuf_block->offset > 0) {
+			_mbuf_block_release_standalone(mbuf_block);
+		} else {
+			ASSERT_MBUF_BLOCK_PROPERTY(mbuf_block, pool->nactive_mbuf_blockq > 0);
+			pool->nfree_mbuf_blockq++;
+			pool->nactive_mbuf_blockq--;
+			if (mbuf_block->slab != NULL) {
+				mbuf_block->slab->nactive--;
+			}
+			STAILQ_INSERT_HEAD(&pool->free_mbuf_blockq, mbuf_block, next);
+			#ifdef MBUF_ENABLE_DEBUGGING
+				TAILQ_REMOVE(&pool->active_mbuf_blockq, mbuf_block, active_q);
+			#endif
+		}
+
+		mbuf_block = next;
+		count++;
+	}
+
+	pool->nremote_frees += count;
+	return count;
+}
 
+/*
+ * Goes through the freelist once and releases either the blocks that were
+ * malloc()ed separately (as long as there are more than `max_free` free
+ * blocks), or the blocks that belong to slabs marked as `releasing`.
+ * Returns the number of blocks removed from the freelist.
+ */
+static unsigned int
+_mbuf_pool_release_free_blocks(struct mbuf_pool *pool, unsigned int max_free,
+	bool from_slabs)
+{
+	struct mhdr kept;
+	unsigned int count = 0;
+
+	STAILQ_INIT(&kept);
 	while (!STAILQ_EMPTY(&pool->free_mbuf_blockq)) {
 		struct mbuf_block *mbuf_block = STAILQ_FIRST(&pool->free_mbuf_blockq);
-		mbuf_block_remove(&pool->free_mbuf_blockq, mbuf_block);
-		mbuf_block_free(mbuf_block);
-		pool->nfree_mbuf_blockq--;
+		bool release;
+
+		STAILQ_REMOVE_HEAD(&pool->free_mbuf_blockq, next);
+		STAILQ_NEXT(mbuf_block, next) = NULL;
+
+		if (from_slabs) {
+			release = mbuf_block->slab != NULL && mbuf_block->slab->releasing;
+		} else {
+			release = mbuf_block->slab == NULL
+				&& pool->nfree_mbuf_blockq > max_free;
+		}
+
+		if (release) {
+			pool->nfree_mbuf_blockq--;
+			count++;
+			if (!from_slabs) {
+				mbuf_block_free(mbuf_block);
+			}
+		} else {
+			STAILQ_INSERT_TAIL(&kept, mbuf_block, next);
+		}
 	}
-	assert(pool->nfree_mbuf_blockq == 0);
+	STAILQ_CONCAT(&pool->free_mbuf_blockq, &kept);
 
 	return count;
 }
 
+/*
+ * Releases free blocks to the OS until at most `max_free` free blocks are
+ * left. Blocks that belong to a slab can only be released together with
+ * the rest of the slab, so with slabs enabled more than `max_free` blocks
+ * may remain. Must be called from the owner thread. Returns the number of
+ * blocks released.
+ */
+unsigned int
+mbuf_pool_trim(struct mbuf_pool *pool, unsigned int max_free)
+{
+	struct mbuf_slab *slab, *next_slab;
+	unsigned int count;
+	boost::uint32_t remaining;
+
+	mbuf_pool_reclaim_remote_frees(pool);
+	if (pool->nfree_mbuf_blockq <= max_free) {
+		return 0;
+	}
+
+	count = _mbuf_pool_release_free_blocks(pool, max_free, false);
+
+	// Slabs without active blocks can be released in their entirety.
+	remaining = pool->nfree_mbuf_blockq;
+	LIST_FOREACH (slab, &pool->slabs, next) {
+		if (remaining <= max_free) {
+			break;
+		}
+		if (slab->nactive == 0) {
+			slab->releasing = true;
+			remaining -= slab->ncarved;
+		}
+	}
+	if (remaining != pool->nfree_mbuf_blockq) {
+		count += _mbuf_pool_release_free_blocks(pool, max_free, true);
+		LIST_FOREACH_SAFE (slab, &pool->slabs, next, next_slab) {
+			if (slab->releasing) {
+				_mbuf_slab_free(pool, slab);
+			}
+		}
+	}
+
+	pool->ntrimmed += count;
+	return count;
+}
+
+unsigned int
+mbuf_pool_compact(struct mbuf_pool *pool)
+{
+	return mbuf_pool_trim(pool, 0);
+}
+
 
 void
 mbuf_block_ref(struct mbuf_block *mbuf_block)
@@ -352,9 +672,11 @@ mbuf_block_unref(struct mbuf_block *mbuf_block)
 	mbuf_block->refcount--;
 	if (mbuf_block->refcount == 0) {
 		if (mbuf_block->offset > 0) {
-			ASSERT_MBUF_BLOCK_PROPERTY(mbuf_block, mbuf_block->pool->nactive_mbuf_blockq > 0);
-			mbuf_block->pool->nactive_mbuf_blockq--;
-			mbuf_block_free(mbuf_block);
+			if (_mbuf_pool_on_owner_thread(mbuf_block->pool)) {
+				_mbuf_block_release_standalone(mbuf_block);
+			} else {
+				_mbuf_block_push_remote_free(mbuf_block);
+			}
 		} else {
 			mbuf_block_put(mbuf_block);
 		}
@@ -408,6 +730,7 @@ mbuf_block_print(struct mbuf_block *mbuf_block, std::ostream &stream)
 			mbuf_block->end - mbuf_block->start)) << "\"\n"
 		"mbuf_block.refcount: " << mbuf_block->refcount << "\n"
 		"mbuf_block.offset: " << mbuf_block->offset << "\n"
+		"mbuf_block.slab: " << (void *) mbuf_block->slab << "\n"
 		"mbuf_block.pool: " << (void *) mbuf_block->pool << "\n"
 		"mbuf_block.pool.nfree_mbuf_blockq: " << mbuf_block->pool->nfree_mbuf_blockq << "\n"
 		"mbuf_block.pool.nactive_mbuf_blockq: " << mbuf_block->pool->nactive_mbuf_blockq << "\n"
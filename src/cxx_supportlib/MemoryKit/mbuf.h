@@ -27,6 +27,7 @@
 #include <oxt/macros.hpp>
 #include <boost/cstdint.hpp>
 #include <boost/move/core.hpp>
+#include <boost/atomic.hpp>
 
 /** A memory buffer allocator system taken from twemproxy and modified to
  * suit our needs.
@@ -54,6 +55,21 @@
  * This approach is similar to how Node.js manages buffer slices.
  * We also got rid of the global variables, and put them in an mbuf_pool
  * struct, which acts like a context structure.
+ *
+ * An mbuf_pool is meant to be used by a single thread (in ServerKit: one pool
+ * per Context, and thus per event loop), so that getting and putting blocks
+ * requires no locking. Blocks may however be handed over to another thread,
+ * for example by a cache that is shared between threads. If the pool has an
+ * owner (see mbuf_pool_set_owner()), then a block whose last reference is
+ * dropped on a different thread is pushed onto a lock-free queue, from which
+ * the owner reclaims it later. Note that the reference count itself is not
+ * atomic: a block may only be referenced from one thread at a time.
+ *
+ * By default each mbuf_block is allocated with malloc(). After
+ * mbuf_pool_enable_slabs(), blocks are carved out of larger mmap()ed slabs
+ * instead, which may be backed by transparent huge pages. Because slabs are
+ * carved on the owner thread, their pages are faulted in (and thus placed
+ * on the NUMA node of) the thread that uses them.
  */
 
 //#define MBUF_ENABLE_DEBUGGING
@@ -67,6 +83,7 @@ using namespace boost;
 
 
 struct mbuf_block;
+struct mbuf_slab;
 struct mhdr;
 
 typedef void (*mbuf_block_copy_t)(struct mbuf_block *, void *);
@@ -84,11 +101,24 @@ struct mbuf_block {
 	char              *start;     /* start of buffer (const) */
 	char              *end;       /* end of buffer (const) */
 	struct mbuf_pool  *pool;      /* containing pool (const) */
+	struct mbuf_slab  *slab;      /* containing slab, or NULL if malloc()ed (const) */
+	struct mbuf_block *remote_next; /* next block in pool's remote free queue */
 	boost::uint32_t    refcount;  /* number of references by mbuf subsets */
 	boost::uint32_t    offset;    /* standalone mbuf_block data size */
 };
 
+/* A memory region that mbuf_blocks are carved out of. See mbuf_pool_enable_slabs(). */
+struct mbuf_slab {
+	LIST_ENTRY(struct mbuf_slab) next;
+	char              *start;     /* start of the mmap()ed region (const) */
+	size_t             size;      /* size of the mmap()ed region (const) */
+	boost::uint32_t    ncarved;   /* # mbuf_blocks carved out of this slab so far */
+	boost::uint32_t    nactive;   /* # of those that are active (non-free) */
+	bool               releasing; /* used by mbuf_pool_trim() */
+};
+
 STAILQ_HEAD(mhdr, struct mbuf_block);
+LIST_HEAD(mbuf_slab_list, struct mbuf_slab);
 #ifdef MBUF_ENABLE_DEBUGGING
 	TAILQ_HEAD(active_mbuf_block_list, struct mbuf_block);
 #endif
@@ -103,6 +133,19 @@ struct mbuf_pool {
 
 	size_t mbuf_block_chunk_size; /* mbuf_block chunk size - header + data (const) */
 	size_t mbuf_block_offset;     /* mbuf_block offset in chunk (const) */
+
+	size_t slab_size;             /* 0 if slabs are disabled (const) */
+	bool huge_pages;              /* whether slabs use transparent huge pages (const) */
+	boost::uint32_t nslabs;       /* # slabs */
+	struct mbuf_slab_list slabs;
+	struct mbuf_slab *current_slab; /* slab that new mbuf_blocks are carved from */
+
+	const void *owner;            /* oxt::thread_signature of the owner thread, or NULL */
+	boost::atomic<struct mbuf_block *> remote_free_head; /* blocks put by other threads */
+
+	boost::uint64_t nallocated;   /* # mbuf_blocks obtained from malloc() or slabs */
+	boost::uint64_t nremote_frees; /* # mbuf_blocks reclaimed from remote_free_head */
+	boost::uint64_t ntrimmed;     /* # free mbuf_blocks released by mbuf_pool_trim() */
 };
 
 #define MBUF_BLOCK_MAGIC      0xdeadbeef
@@ -110,13 +153,18 @@ struct mbuf_pool {
 #define MBUF_BLOCK_MAX_SIZE   16777216
 #define MBUF_BLOCK_SIZE       16384
 #define MBUF_BLOCK_HSIZE      sizeof(struct mbuf_block)
+#define MBUF_HUGE_PAGE_SIZE   (2 * 1024 * 1024)
 
 #define MBUF_BLOCK_EMPTY(mbuf_block) ((mbuf_block)->pos  == (mbuf_block)->last)
 #define MBUF_BLOCK_FULL(mbuf_block)  ((mbuf_block)->last == (mbuf_block)->end)
 
 void mbuf_pool_init(struct mbuf_pool *pool);
+void mbuf_pool_enable_slabs(struct mbuf_pool *pool, size_t slab_size, bool huge_pages);
+void mbuf_pool_set_owner(struct mbuf_pool *pool, const void *owner);
 void mbuf_pool_deinit(struct mbuf_pool *pool);
 size_t mbuf_pool_data_size(struct mbuf_pool *pool);
+unsigned int mbuf_pool_reclaim_remote_frees(struct mbuf_pool *pool);
+unsigned int mbuf_pool_trim(struct mbuf_pool *pool, unsigned int max_free);
 unsigned int mbuf_pool_compact(struct mbuf_pool *pool);
 
 struct mbuf_block *mbuf_block_get(struct mbuf_pool *pool);
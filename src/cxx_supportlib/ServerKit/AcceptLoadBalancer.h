@@ -28,6 +28,7 @@
 
 #include <boost/bind.hpp>
 #include <boost/cstdint.hpp>
+#include <boost/atomic.hpp>
 #include <oxt/thread.hpp>
 #include <oxt/macros.hpp>
 #include <vector>
@@ -40,6 +41,7 @@
 #include <netinet/tcp.h>
 #include <arpa/inet.h>
 #include <poll.h>
+#include <unistd.h>
 
 #include <Constants.h>
 #include <LoggingKit/LoggingKit.h>
@@ -55,7 +57,8 @@ using namespace boost;
 
 /**
  * Listens for client connections and load balances them to multiple
- * Server objects in a round-robin manner.
+ * Server objects, either in a round-robin manner or by picking the
+ * least loaded Server.
  *
  * Normally, the Server class listens for client connections directly.
  * But this is inefficient in multithreaded situations where you are
@@ -72,8 +75,19 @@ using namespace boost;
  *
  * The AcceptLoadBalancer solves this problem by being the sole entity
  * that listens on the server socket. All client sockets that it
- * accepts are distributed to all registered Server objects, in a
- * round-robin manner.
+ * accepts are distributed to all registered Server objects. How
+ * they are distributed depends on `distributionMode`:
+ *
+ *  - ROUND_ROBIN: each Server gets the next client in turn. This
+ *    ignores how busy a Server already is, so with long-lived clients
+ *    (e.g. WebSockets or slow uploads) some threads may end up with many
+ *    more clients than others.
+ *  - LEAST_LOADED: each client is given to the Server with the fewest
+ *    active clients, using the "power of two choices" technique: two
+ *    Servers are picked at random and the least loaded one of the two
+ *    wins. This balances nearly as well as inspecting all Servers, but
+ *    avoids sending an entire burst of clients to the same Server
+ *    because of slightly out-of-date client counts.
  *
  * Inside the "PassengerAgent core", we activate AcceptLoadBalancer
  * only if `core_threads > 1`, which is often the case because
@@ -81,9 +95,32 @@ using namespace boost;
  */
 template<typename Server>
 class AcceptLoadBalancer {
+public:
+	enum DistributionMode {
+		ROUND_ROBIN,
+		LEAST_LOADED
+	};
+
 private:
 	static const unsigned int ACCEPT_BURST_COUNT = 16;
 
+	/**
+	 * Keeps track of clients that we've handed to a Server, but which
+	 * that Server's event loop hasn't processed yet. Those are not yet
+	 * reflected in Server::getActiveClientCountFromAnyThread().
+	 */
+	struct ServerLoadState {
+		/** Only accessed from the load balancer thread. */
+		unsigned int clientsHandedOver;
+		/** Incremented from the Server's event loop thread. */
+		boost::atomic<unsigned int> clientsFed;
+
+		ServerLoadState()
+			: clientsHandedOver(0),
+			  clientsFed(0)
+			{ }
+	};
+
 	int endpoints[SERVER_KIT_MAX_SERVER_ENDPOINTS];
 	struct pollfd pollers[1 + SERVER_KIT_MAX_SERVER_ENDPOINTS];
 	int newClients[ACCEPT_BURST_COUNT];
@@ -93,9 +130,11 @@ private:
 	boost::uint8_t nextServer;
 	bool accept4Available;
 	bool quit;
+	boost::uint32_t randomState;
 
 	int exitPipe[2];
 	oxt::thread *thread;
+	ServerLoadState *loadStates;
 
 	void pollAllEndpoints() {
 		pollers[0].fd = exitPipe[0];
@@ -156,22 +195,72 @@ private:
 	}
 
 	void distributeNewClients() {
-		unsigned int i;
+		unsigned int i, serverIndex;
 
 		for (i = 0; i < newClientCount; i++) {
-			ServerKit::Context *ctx = servers[nextServer]->getContext();
-			P_TRACE(2, "Feeding client to server thread " << (int) nextServer <<
+			if (distributionMode == LEAST_LOADED) {
+				serverIndex = selectLeastLoadedServer();
+			} else {
+				serverIndex = nextServer;
+				nextServer = (nextServer + 1) % servers.size();
+			}
+
+			ServerKit::Context *ctx = servers[serverIndex]->getContext();
+			P_TRACE(2, "Feeding client to server thread " << serverIndex <<
 				": file descriptor " << newClients[i]);
-			ctx->libev->runLater(boost::bind(feedNewClient, servers[nextServer],
-				newClients[i]));
-			nextServer = (nextServer + 1) % servers.size();
+			loadStates[serverIndex].clientsHandedOver++;
+			ctx->libev->runLater(boost::bind(feedNewClient, servers[serverIndex],
+				&loadStates[serverIndex], newClients[i]));
 		}
 
 		newClientCount = 0;
 	}
 
-	static void feedNewClient(Server *server, int fd) {
+	static void feedNewClient(Server *server, ServerLoadState *loadState, int fd) {
 		server->feedNewClients(&fd, 1);
+		loadState->clientsFed.fetch_add(1, boost::memory_order_relaxed);
+	}
+
+	unsigned int getServerLoad(unsigned int index) const {
+		const ServerLoadState &loadState = loadStates[index];
+		// Both counters wrap around in the same way, so the
+		// difference is correct even after overflow.
+		unsigned int inFlight = loadState.clientsHandedOver
+			- loadState.clientsFed.load(boost::memory_order_relaxed);
+		return servers[index]->getActiveClientCountFromAnyThread() + inFlight;
+	}
+
+	unsigned int selectLeastLoadedServer() {
+		unsigned int nservers = servers.size();
+		unsigned int a, b;
+
+		if (nservers == 1) {
+			return 0;
+		} else if (nservers == 2) {
+			a = 0;
+			b = 1;
+		} else {
+			a = nextRandom() % nservers;
+			b = nextRandom() % (nservers - 1);
+			if (b >= a) {
+				b++;
+			}
+		}
+
+		if (getServerLoad(a) <= getServerLoad(b)) {
+			return a;
+		} else {
+			return b;
+		}
+	}
+
+	boost::uint32_t nextRandom() {
+		// xorshift32. Not cryptographically secure, but that's
+		// not necessary for picking servers.
+		randomState ^= randomState << 13;
+		randomState ^= randomState >> 17;
+		randomState ^= randomState << 5;
+		return randomState;
 	}
 
 	int acceptNonBlockingSocket(int serverFd) {
@@ -244,6 +333,7 @@ private:
 
 public:
 	vector<Server *> servers;
+	DistributionMode distributionMode;
 
 	AcceptLoadBalancer()
 		: nEndpoints(0),
@@ -251,7 +341,10 @@ public:
 		  nextServer(0),
 		  accept4Available(true),
 		  quit(false),
-		  thread(NULL)
+		  randomState((boost::uint32_t) getpid() * 2654435761u | 1),
+		  thread(NULL),
+		  loadStates(NULL),
+		  distributionMode(ROUND_ROBIN)
 	{
 		if (pipe(exitPipe) == -1) {
 			int e = errno;
@@ -269,6 +362,7 @@ public:
 
 	~AcceptLoadBalancer() {
 		shutdown();
+		delete[] loadStates;
 		close(exitPipe[0]);
 		close(exitPipe[1]);
 		P_LOG_FILE_DESCRIPTOR_CLOSE(exitPipe[0]);
@@ -300,7 +394,17 @@ public:
 		#undef EXTENSION_EOPNOTSUPP
 	}
 
+	/**
+	 * Returns whether any endpoints have been registered through listen().
+	 */
+	bool hasEndpoints() const {
+		return nEndpoints > 0;
+	}
+
 	void start() {
+		assert(!servers.empty());
+		delete[] loadStates;
+		loadStates = new ServerLoadState[servers.size()];
 		boost::function<void ()> func = boost::bind(&AcceptLoadBalancer<Server>::mainLoop, this);
 		thread = new oxt::thread(boost::bind(runAndPrintExceptions, func, true),
 			"Load balancer");
@@ -59,6 +59,9 @@ using namespace std;
  *   file_buffered_channel_max_disk_chunk_read_size       unsigned integer   -   default(0)
  *   file_buffered_channel_threshold                      unsigned integer   -   default(131072)
  *   mbuf_block_chunk_size                                unsigned integer   -   default(4096),read_only
+ *   mbuf_huge_pages                                      boolean            -   default(false),read_only
+ *   mbuf_max_spare_memory                                unsigned integer   -   default(67108864)
+ *   mbuf_slab_size                                       unsigned integer   -   default(0),read_only
  *   secure_mode_password                                 string             -   secret
  *
  * END
@@ -94,6 +97,10 @@ public:
 
 		add("mbuf_block_chunk_size", UINT_TYPE, OPTIONAL | READ_ONLY,
 			DEFAULT_MBUF_CHUNK_SIZE);
+		add("mbuf_slab_size", UINT_TYPE, OPTIONAL | READ_ONLY, 0);
+		add("mbuf_huge_pages", BOOL_TYPE, OPTIONAL | READ_ONLY, false);
+		add("mbuf_max_spare_memory", UINT_TYPE, OPTIONAL,
+			DEFAULT_MBUF_MAX_SPARE_MEMORY);
 		add("secure_mode_password", STRING_TYPE, OPTIONAL | SECRET);
 
 		addNormalizer(normalize);
@@ -131,15 +138,18 @@ struct FileBufferedChannelConfig {
 
 struct Config {
 	string secureModePassword;
+	unsigned int mbufMaxSpareMemory;
 	FileBufferedChannelConfig fileBufferedChannelConfig;
 
 	Config(const ConfigKit::Store &config)
 		: secureModePassword(config["secure_mode_password"].asString()),
+		  mbufMaxSpareMemory(config["mbuf_max_spare_memory"].asUInt()),
 		  fileBufferedChannelConfig(config)
 		{ }
 
 	void swap(Config &other) BOOST_NOEXCEPT_OR_NOTHROW {
 		secureModePassword.swap(other.secureModePassword);
+		std::swap(mbufMaxSpareMemory, other.mbufMaxSpareMemory);
 		fileBufferedChannelConfig.swap(other.fileBufferedChannelConfig);
 	}
 };
@@ -52,6 +52,49 @@ class Context {
 private:
 	ConfigKit::Store configStore;
 
+	static Json::Value inspectMbufPoolAsJson(const struct MemoryKit::mbuf_pool &pool) {
+		Json::Value mbufDoc;
+
+		mbufDoc["free_blocks"] = (Json::UInt) pool.nfree_mbuf_blockq;
+		mbufDoc["active_blocks"] = (Json::UInt) pool.nactive_mbuf_blockq;
+		mbufDoc["chunk_size"] = (Json::UInt) pool.mbuf_block_chunk_size;
+		mbufDoc["offset"] = (Json::UInt) pool.mbuf_block_offset;
+		mbufDoc["spare_memory"] = byteSizeToJson(pool.nfree_mbuf_blockq
+			* pool.mbuf_block_chunk_size);
+		mbufDoc["active_memory"] = byteSizeToJson(pool.nactive_mbuf_blockq
+			* pool.mbuf_block_chunk_size);
+		mbufDoc["allocated_blocks"] = (Json::UInt64) pool.nallocated;
+		mbufDoc["remote_frees"] = (Json::UInt64) pool.nremote_frees;
+		mbufDoc["trimmed_blocks"] = (Json::UInt64) pool.ntrimmed;
+		if (pool.slab_size > 0) {
+			mbufDoc["slabs"] = (Json::UInt) pool.nslabs;
+			mbufDoc["slab_size"] = byteSizeToJson(pool.slab_size);
+			mbufDoc["huge_pages"] = pool.huge_pages;
+		}
+		#ifdef MBUF_ENABLE_DEBUGGING
+			struct MemoryKit::active_mbuf_block_list *list =
+				const_cast<struct MemoryKit::active_mbuf_block_list *>(
+					&pool.active_mbuf_blockq);
+			struct MemoryKit::mbuf_block *block;
+			Json::Value listJson(Json::arrayValue);
+
+			TAILQ_FOREACH (block, list, active_q) {
+				Json::Value blockJson;
+				blockJson["refcount"] = block->refcount;
+				#ifdef MBUF_ENABLE_BACKTRACES
+					blockJson["backtrace"] =
+						(block->backtrace == NULL)
+						? "(null)"
+						: block->backtrace;
+				#endif
+				listJson.append(blockJson);
+			}
+			mbufDoc["active_blocks_list"] = listJson;
+		#endif
+
+		return mbufDoc;
+	}
+
 public:
 	typedef ServerKit::ConfigChangeRequest ConfigChangeRequest;
 
@@ -62,6 +105,8 @@ public:
 	// Others
 	Config config;
 	struct MemoryKit::mbuf_pool mbuf_pool;
+	/** For reads that are expected to be small. See FdSourceChannel. */
+	struct MemoryKit::mbuf_pool small_mbuf_pool;
 
 	Context(const Schema &schema, const Json::Value &initialConfig = Json::Value(),
 		const ConfigKit::Translator &translator = ConfigKit::DummyTranslator())
@@ -72,6 +117,7 @@ public:
 
 	~Context() {
 		MemoryKit::mbuf_pool_deinit(&mbuf_pool);
+		MemoryKit::mbuf_pool_deinit(&small_mbuf_pool);
 	}
 
 	void initialize() {
@@ -84,6 +130,19 @@ public:
 
 		mbuf_pool.mbuf_block_chunk_size = configStore["mbuf_block_chunk_size"].asUInt();
 		MemoryKit::mbuf_pool_init(&mbuf_pool);
+		if (configStore["mbuf_slab_size"].asUInt() > 0) {
+			MemoryKit::mbuf_pool_enable_slabs(&mbuf_pool,
+				configStore["mbuf_slab_size"].asUInt(),
+				configStore["mbuf_huge_pages"].asBool());
+		}
+		// Blocks whose last reference is dropped on another thread are
+		// handed back to the event loop thread instead of corrupting the
+		// freelist.
+		MemoryKit::mbuf_pool_set_owner(&mbuf_pool, libev.get());
+
+		small_mbuf_pool.mbuf_block_chunk_size = DEFAULT_SMALL_MBUF_CHUNK_SIZE;
+		MemoryKit::mbuf_pool_init(&small_mbuf_pool);
+		MemoryKit::mbuf_pool_set_owner(&small_mbuf_pool, libev.get());
 	}
 
 	bool configure(const Json::Value &updates, vector<ConfigKit::Error> &errors) {
@@ -116,39 +175,8 @@ public:
 
 	Json::Value inspectStateAsJson() const {
 		Json::Value doc;
-		Json::Value mbufDoc;
-
-		mbufDoc["free_blocks"] = (Json::UInt) mbuf_pool.nfree_mbuf_blockq;
-		mbufDoc["active_blocks"] = (Json::UInt) mbuf_pool.nactive_mbuf_blockq;
-		mbufDoc["chunk_size"] = (Json::UInt) mbuf_pool.mbuf_block_chunk_size;
-		mbufDoc["offset"] = (Json::UInt) mbuf_pool.mbuf_block_offset;
-		mbufDoc["spare_memory"] = byteSizeToJson(mbuf_pool.nfree_mbuf_blockq
-			* mbuf_pool.mbuf_block_chunk_size);
-		mbufDoc["active_memory"] = byteSizeToJson(mbuf_pool.nactive_mbuf_blockq
-			* mbuf_pool.mbuf_block_chunk_size);
-		#ifdef MBUF_ENABLE_DEBUGGING
-			struct MemoryKit::active_mbuf_block_list *list =
-				const_cast<struct MemoryKit::active_mbuf_block_list *>(
-					&mbuf_pool.active_mbuf_blockq);
-			struct MemoryKit::mbuf_block *block;
-			Json::Value listJson(Json::arrayValue);
-
-			TAILQ_FOREACH (block, list, active_q) {
-				Json::Value blockJson;
-				blockJson["refcount"] = block->refcount;
-				#ifdef MBUF_ENABLE_BACKTRACES
-					blockJson["backtrace"] =
-						(block->backtrace == NULL)
-						? "(null)"
-						: block->backtrace;
-				#endif
-				listJson.append(blockJson);
-			}
-			mbufDoc["active_blocks_list"] = listJson;
-		#endif
-
-		doc["mbuf_pool"] = mbufDoc;
-
+		doc["mbuf_pool"] = inspectMbufPoolAsJson(mbuf_pool);
+		doc["small_mbuf_pool"] = inspectMbufPoolAsJson(small_mbuf_pool);
 		return doc;
 	}
 };
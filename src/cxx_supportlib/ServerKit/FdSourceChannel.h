@@ -28,7 +28,9 @@
 
 #include <oxt/macros.hpp>
 #include <boost/move/move.hpp>
+#include <algorithm>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <ev.h>
 #include <jsoncpp/json.h>
@@ -42,10 +44,49 @@ namespace ServerKit {
 using namespace oxt;
 
 
+/**
+ * Reads data from a file descriptor and feeds it to a Channel.
+ *
+ * ## Adaptive read sizing
+ *
+ * Every channel keeps an estimate of how many bytes become available per
+ * readable event, based on the read history of the current fd. The estimate
+ * decides what to read into:
+ *
+ *  - Reads that are expected to be small go to a block from the Context's
+ *    `small_mbuf_pool`, so that a small response that sits in a buffer
+ *    (e.g. because the client is slow) doesn't pin an entire block.
+ *  - Reads that are expected to be larger than the current buffer are done
+ *    with a single readv() into the current buffer plus up to
+ *    `MAX_READV_BUFFERS - 1` fresh blocks, instead of one read() per
+ *    block. Blocks that the readv() did not touch are returned to the pool
+ *    immediately.
+ *
+ * The estimate doubles every time the buffers are filled completely, and
+ * moves halfway towards the actual read size otherwise.
+ *
+ * reinitialize() resets the estimate, so that the first read on a new fd is
+ * never a readv() into several buffers. Channels are reused for many clients
+ * and requests though, so it does remember whether the previous fd's reads
+ * were small, and if so reads into a small block first.
+ */
 class FdSourceChannel: protected Channel {
+public:
+	static const unsigned int MAX_READV_BUFFERS = 8;
+
 private:
 	ev_io watcher;
 	MemoryKit::mbuf buffer;
+	/**
+	 * Extra buffers for readv(). After a readv(), the filled ones in
+	 * [pendingBegin, pendingEnd) still need to be fed. They stay here
+	 * when the Channel does not accept input.
+	 */
+	MemoryKit::mbuf readvBuffers[MAX_READV_BUFFERS - 1];
+	unsigned char pendingBegin, pendingEnd;
+	unsigned int readSizeEstimate;
+	unsigned int readCalls;
+	bool previousReadsSmall;
 
 	static void _onReadable(EV_P_ ev_io *io, int revents) {
 		static_cast<FdSourceChannel *>(io->data)->onReadable(io, revents);
@@ -56,67 +97,215 @@ private:
 		onReadableWithoutRefGuard();
 	}
 
+	void stopReadingUntilConsumed() {
+		ev_io_stop(ctx->libev->getLoop(), &watcher);
+		if (mayAcceptInputLater()) {
+			consumedCallback = onChannelConsumed;
+		}
+	}
+
+	/**
+	 * Feeds the buffers filled by the last readv(), for as long as the
+	 * Channel accepts input. Returns whether all of them have been fed.
+	 * If not, then either this object has been deinitialized, or the
+	 * remaining buffers will be fed when the Channel has consumed its data.
+	 */
+	bool feedPendingBuffers() {
+		unsigned int generation = this->generation;
+
+		while (pendingBegin < pendingEnd) {
+			if (!acceptingInput()) {
+				stopReadingUntilConsumed();
+				if (!mayAcceptInputLater()) {
+					clearReadvBuffers();
+				}
+				return false;
+			}
+
+			MemoryKit::mbuf buffer2(boost::move(readvBuffers[pendingBegin]));
+			pendingBegin++;
+			feedWithoutRefGuard(boost::move(buffer2));
+			if (generation != this->generation) {
+				// Callback deinitialized this object.
+				return false;
+			}
+		}
+
+		pendingBegin = pendingEnd = 0;
+		return true;
+	}
+
+	bool smallReadExpected() const {
+		if (readSizeEstimate == 0) {
+			return previousReadsSmall;
+		} else {
+			return readSizeEstimate <= MemoryKit::mbuf_pool_data_size(&ctx->small_mbuf_pool);
+		}
+	}
+
+	void clearReadvBuffers() {
+		for (unsigned int i = 0; i < MAX_READV_BUFFERS - 1; i++) {
+			readvBuffers[i] = MemoryKit::mbuf();
+		}
+		pendingBegin = pendingEnd = 0;
+	}
+
+	/**
+	 * Sets up `iov` to read into `buffer`, followed by as many extra buffers
+	 * as the read size estimate calls for. Returns the number of iovecs.
+	 */
+	unsigned int prepareReadBuffers(struct iovec *iov, size_t &capacity) {
+		unsigned int niov = 1;
+
+		if (buffer.empty()) {
+			if (smallReadExpected()) {
+				buffer = MemoryKit::mbuf_get(&ctx->small_mbuf_pool);
+			} else {
+				buffer = MemoryKit::mbuf_get(&ctx->mbuf_pool);
+			}
+		}
+
+		iov[0].iov_base = buffer.start;
+		iov[0].iov_len = buffer.size();
+		capacity = buffer.size();
+
+		while (capacity < readSizeEstimate && niov < MAX_READV_BUFFERS) {
+			MemoryKit::mbuf &extra = readvBuffers[niov - 1];
+			extra = MemoryKit::mbuf_get(&ctx->mbuf_pool);
+			iov[niov].iov_base = extra.start;
+			iov[niov].iov_len = extra.size();
+			capacity += extra.size();
+			niov++;
+		}
+
+		return niov;
+	}
+
+	/**
+	 * Splits the data that a read() or readv() placed in `buffer` and the
+	 * extra buffers into the buffer to feed first (returned) and the pending
+	 * buffers. The unused remainder of the last touched buffer becomes the
+	 * new `buffer`.
+	 */
+	MemoryKit::mbuf distributeReadData(unsigned int niov, size_t size) {
+		MemoryKit::mbuf first;
+		unsigned int i;
+
+		if (size < buffer.size()) {
+			first = MemoryKit::mbuf(buffer, 0, size);
+			buffer = MemoryKit::mbuf(buffer, size);
+			size = 0;
+		} else {
+			size -= buffer.size();
+			first = boost::move(buffer);
+			// Unref mbuf_block
+			buffer = MemoryKit::mbuf();
+		}
+
+		for (i = 0; i < niov - 1; i++) {
+			MemoryKit::mbuf &extra = readvBuffers[i];
+			if (size == 0) {
+				extra = MemoryKit::mbuf();
+			} else if (size < extra.size()) {
+				buffer = MemoryKit::mbuf(extra, size);
+				extra = MemoryKit::mbuf(extra, 0, size);
+				size = 0;
+				pendingEnd = i + 1;
+			} else {
+				size -= extra.size();
+				pendingEnd = i + 1;
+			}
+		}
+
+		return first;
+	}
+
+	void updateReadSizeEstimate(size_t size, size_t capacity) {
+		if (size == capacity) {
+			// The actual amount of available data is unknown, so
+			// grow quickly.
+			size_t max = MAX_READV_BUFFERS * MemoryKit::mbuf_pool_data_size(&ctx->mbuf_pool);
+			readSizeEstimate = (unsigned int) std::min<size_t>(
+				std::max<size_t>(readSizeEstimate, size) * 2, max);
+		} else {
+			readSizeEstimate = (unsigned int) ((readSizeEstimate + size + 1) / 2);
+		}
+	}
+
 	void onReadableWithoutRefGuard() {
 		unsigned int generation = this->generation;
-		unsigned int i, origBufferSize;
+		unsigned int i, niov;
+		struct iovec iov[MAX_READV_BUFFERS];
+		size_t capacity;
 		bool done = false;
 		ssize_t ret;
 		int e;
 
+		if (pendingBegin < pendingEnd && !feedPendingBuffers()) {
+			return;
+		}
+
 		if (!acceptingInput()) {
-			ev_io_stop(ctx->libev->getLoop(), &watcher);
-			if (mayAcceptInputLater()) {
-				consumedCallback = onChannelConsumed;
-			}
+			stopReadingUntilConsumed();
 			return;
 		}
 
 		for (i = 0; i < burstReadCount && !done; i++) {
-			if (buffer.empty()) {
-				buffer = MemoryKit::mbuf_get(&ctx->mbuf_pool);
+			if (adaptiveReadSizing) {
+				niov = prepareReadBuffers(iov, capacity);
+			} else {
+				if (buffer.empty()) {
+					buffer = MemoryKit::mbuf_get(&ctx->mbuf_pool);
+				}
+				niov = 1;
+				capacity = buffer.size();
 			}
 
-			origBufferSize = buffer.size();
 			do {
-				ret = ::read(watcher.fd, buffer.start, buffer.size());
+				if (niov == 1) {
+					ret = ::read(watcher.fd, buffer.start, buffer.size());
+				} else {
+					ret = ::readv(watcher.fd, iov, niov);
+				}
 			} while (OXT_UNLIKELY(ret == -1 && errno == EINTR));
+			readCalls++;
+
 			if (ret > 0) {
-				MemoryKit::mbuf buffer2(buffer, 0, ret);
-				if (size_t(ret) == size_t(buffer.size())) {
-					// Unref mbuf_block
-					buffer = MemoryKit::mbuf();
-				} else {
-					buffer = MemoryKit::mbuf(buffer, ret);
+				if (adaptiveReadSizing) {
+					updateReadSizeEstimate(ret, capacity);
 				}
+				MemoryKit::mbuf buffer2(distributeReadData(niov, ret));
 				feedWithoutRefGuard(boost::move(buffer2));
 				if (generation != this->generation) {
 					// Callback deinitialized this object.
 					return;
 				}
+				if (pendingBegin < pendingEnd && !feedPendingBuffers()) {
+					return;
+				}
 
 				if (!acceptingInput()) {
 					done = true;
-					ev_io_stop(ctx->libev->getLoop(), &watcher);
-					if (mayAcceptInputLater()) {
-						consumedCallback = onChannelConsumed;
-					}
+					stopReadingUntilConsumed();
 				} else {
 					// If we were unable to fill the entire buffer, then it's likely that
 					// the client is slow and that the next read() will fail with
 					// EAGAIN, so we stop looping and return to the event loop poller.
-					done = (size_t) ret < origBufferSize;
+					done = (size_t) ret < capacity;
 				}
 
 			} else if (ret == 0) {
 				done = true;
 				ev_io_stop(ctx->libev->getLoop(), &watcher);
 				buffer = MemoryKit::mbuf();
+				clearReadvBuffers();
 				feedWithoutRefGuard(MemoryKit::mbuf());
 
 			} else {
 				e = errno;
 				done = true;
 				buffer = MemoryKit::mbuf();
+				clearReadvBuffers();
 				if (e != EAGAIN && e != EWOULDBLOCK) {
 					ev_io_stop(ctx->libev->getLoop(), &watcher);
 					feedError(e);
@@ -130,11 +319,21 @@ private:
 		self->consumedCallback = NULL;
 		if (self->acceptingInput()) {
 			ev_io_start(self->ctx->libev->getLoop(), &self->watcher);
+			if (self->pendingBegin < self->pendingEnd) {
+				// The data is already read, so the fd may never become
+				// readable again. Feed it in the next event loop iteration.
+				ev_feed_event(self->ctx->libev->getLoop(), &self->watcher, EV_READ);
+			}
 		}
 	}
 
 	void initialize() {
 		burstReadCount = 1;
+		adaptiveReadSizing = true;
+		pendingBegin = pendingEnd = 0;
+		readSizeEstimate = 0;
+		readCalls = 0;
+		previousReadsSmall = false;
 		watcher.active = false;
 		watcher.fd = -1;
 		watcher.data = this;
@@ -142,6 +341,8 @@ private:
 
 public:
 	unsigned int burstReadCount;
+	/** Whether to use the read history to pick buffer sizes; see the class docs. */
+	bool adaptiveReadSizing;
 
 	FdSourceChannel() {
 		initialize();
@@ -168,10 +369,14 @@ public:
 	void reinitialize(int fd) {
 		Channel::reinitialize();
 		ev_io_init(&watcher, _onReadable, fd, EV_READ);
+		previousReadsSmall = readSizeEstimate > 0 && smallReadExpected();
+		readSizeEstimate = 0;
+		readCalls = 0;
 	}
 
 	void deinitialize() {
 		buffer = MemoryKit::mbuf();
+		clearReadvBuffers();
 		if (ev_is_active(&watcher)) {
 			ev_io_stop(ctx->libev->getLoop(), &watcher);
 		}
@@ -237,10 +442,37 @@ public:
 		this->hooks = hooks;
 	}
 
+	/** The number of read() and readv() calls since reinitialize(). */
+	OXT_FORCE_INLINE
+	unsigned int getReadCalls() const {
+		return readCalls;
+	}
+
+	OXT_FORCE_INLINE
+	unsigned int getReadSizeEstimate() const {
+		return readSizeEstimate;
+	}
+
+	/**
+	 * Whether data from the last readv() has been read from the fd, but not
+	 * yet fed to the Channel. Anyone who wants to read from the fd directly
+	 * (instead of through this channel) must wait until this is false,
+	 * otherwise that data is skipped.
+	 */
+	OXT_FORCE_INLINE
+	bool hasPendingBuffers() const {
+		return pendingBegin < pendingEnd;
+	}
+
 	Json::Value inspectAsJson() const {
 		Json::Value doc = Channel::inspectAsJson();
 		doc["initialized"] = watcher.fd != -1;
 		doc["io_watcher_active"] = (bool) watcher.active;
+		doc["read_calls"] = readCalls;
+		doc["read_size_estimate"] = readSizeEstimate;
+		if (pendingBegin < pendingEnd) {
+			doc["pending_readv_buffers"] = pendingEnd - pendingBegin;
+		}
 		return doc;
 	}
 };
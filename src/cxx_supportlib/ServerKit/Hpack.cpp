@@ -0,0 +1,429 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#include <cstring>
+#include <ServerKit/Hpack.h>
+
+namespace Passenger {
+namespace ServerKit {
+
+
+struct HpackStaticTableEntry {
+	const char *name;
+	const char *value;
+};
+
+// RFC 7541 appendix A. Index 0 is unused.
+static const HpackStaticTableEntry HPACK_STATIC_TABLE[] = {
+	{ "", "" },
+	{ ":authority", "" },
+	{ ":method", "GET" },
+	{ ":method", "POST" },
+	{ ":path", "/" },
+	{ ":path", "/index.html" },
+	{ ":scheme", "http" },
+	{ ":scheme", "https" },
+	{ ":status", "200" },
+	{ ":status", "204" },
+	{ ":status", "206" },
+	{ ":status", "304" },
+	{ ":status", "400" },
+	{ ":status", "404" },
+	{ ":status", "500" },
+	{ "accept-charset", "" },
+	{ "accept-encoding", "gzip, deflate" },
+	{ "accept-language", "" },
+	{ "accept-ranges", "" },
+	{ "accept", "" },
+	{ "access-control-allow-origin", "" },
+	{ "age", "" },
+	{ "allow", "" },
+	{ "authorization", "" },
+	{ "cache-control", "" },
+	{ "content-disposition", "" },
+	{ "content-encoding", "" },
+	{ "content-language", "" },
+	{ "content-length", "" },
+	{ "content-location", "" },
+	{ "content-range", "" },
+	{ "content-type", "" },
+	{ "cookie", "" },
+	{ "date", "" },
+	{ "etag", "" },
+	{ "expect", "" },
+	{ "expires", "" },
+	{ "from", "" },
+	{ "host", "" },
+	{ "if-match", "" },
+	{ "if-modified-since", "" },
+	{ "if-none-match", "" },
+	{ "if-range", "" },
+	{ "if-unmodified-since", "" },
+	{ "last-modified", "" },
+	{ "link", "" },
+	{ "location", "" },
+	{ "max-forwards", "" },
+	{ "proxy-authenticate", "" },
+	{ "proxy-authorization", "" },
+	{ "range", "" },
+	{ "referer", "" },
+	{ "refresh", "" },
+	{ "retry-after", "" },
+	{ "server", "" },
+	{ "set-cookie", "" },
+	{ "strict-transport-security", "" },
+	{ "transfer-encoding", "" },
+	{ "user-agent", "" },
+	{ "vary", "" },
+	{ "via", "" },
+	{ "www-authenticate", "" }
+};
+
+static const size_t HPACK_STATIC_TABLE_SIZE =
+	sizeof(HPACK_STATIC_TABLE) / sizeof(HpackStaticTableEntry) - 1;
+
+/*
+ * The HPACK Huffman code (RFC 7541 appendix B) is a canonical Huffman code:
+ * codes of the same length are consecutive integers, assigned in symbol order,
+ * and shorter codes come first. So instead of the full code table we only need
+ * to know, for every code length, the first code and how many codes there are,
+ * plus the list of symbols sorted by (code length, symbol).
+ */
+
+static const boost::uint16_t HPACK_HUFFMAN_SYMBOLS[257] = {
+	48, 49, 50, 97, 99, 101, 105, 111, 115, 116, 32, 37, 45, 46, 47, 51,
+	52, 53, 54, 55, 56, 57, 61, 65, 95, 98, 100, 102, 103, 104, 108, 109,
+	110, 112, 114, 117, 58, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76,
+	77, 78, 79, 80, 81, 82, 83, 84, 85, 86, 87, 89, 106, 107, 113, 118,
+	119, 120, 121, 122, 38, 42, 44, 59, 88, 90, 33, 34, 40, 41, 63, 39,
+	43, 124, 35, 62, 0, 36, 64, 91, 93, 126, 94, 125, 60, 96, 123, 92,
+	195, 208, 128, 130, 131, 162, 184, 194, 224, 226, 153, 161, 167, 172, 176, 177,
+	179, 209, 216, 217, 227, 229, 230, 129, 132, 133, 134, 136, 146, 154, 156, 160,
+	163, 164, 169, 170, 173, 178, 181, 185, 186, 187, 189, 190, 196, 198, 228, 232,
+	233, 1, 135, 137, 138, 139, 140, 141, 143, 147, 149, 150, 151, 152, 155, 157,
+	158, 165, 166, 168, 174, 175, 180, 182, 183, 188, 191, 197, 231, 239, 9, 142,
+	144, 145, 148, 159, 171, 206, 215, 225, 236, 237, 199, 207, 234, 235, 192, 193,
+	200, 201, 202, 205, 210, 213, 218, 219, 238, 240, 242, 243, 255, 203, 204, 211,
+	212, 214, 221, 222, 223, 241, 244, 245, 246, 247, 248, 250, 251, 252, 253, 254,
+	2, 3, 4, 5, 6, 7, 8, 11, 12, 14, 15, 16, 17, 18, 19, 20,
+	21, 23, 24, 25, 26, 27, 28, 29, 30, 31, 127, 220, 249, 10, 13, 22,
+	256
+};
+
+// Indexed by code length.
+static const boost::uint32_t HPACK_HUFFMAN_FIRST_CODE[31] = {
+	0, 0, 0, 0, 0, 0, 20, 92,
+	248, 0, 1016, 2042, 4090, 8184, 16380, 32764,
+	0, 0, 0, 524272, 1048550, 2097116, 4194258, 8388568,
+	16777194, 33554412, 67108832, 134217694, 268435426, 0, 1073741820
+};
+
+// Indexed by code length. Index into HPACK_HUFFMAN_SYMBOLS.
+static const boost::uint16_t HPACK_HUFFMAN_FIRST_INDEX[31] = {
+	0, 0, 0, 0, 0, 0, 10, 36, 68, 0, 74, 79, 82, 84, 90, 92,
+	0, 0, 0, 95, 98, 106, 119, 145, 174, 186, 190, 205, 224, 0, 253
+};
+
+// Indexed by code length.
+static const boost::uint16_t HPACK_HUFFMAN_COUNT[31] = {
+	0, 0, 0, 0, 0, 10, 26, 32, 6, 0, 5, 3, 2, 6, 2, 3,
+	0, 0, 0, 3, 8, 13, 26, 29, 12, 4, 15, 19, 29, 0, 4
+};
+
+static const unsigned int HPACK_HUFFMAN_EOS = 256;
+
+// Each entry takes up its name and value size, plus 32 bytes of overhead.
+static const size_t HPACK_ENTRY_OVERHEAD = 32;
+
+
+HpackDecoder::HpackDecoder(size_t maxTableSize, size_t _maxHeaderListSize)
+	: dynamicTableSize(0),
+	  maxDynamicTableSize(maxTableSize),
+	  settingsMaxDynamicTableSize(maxTableSize),
+	  maxHeaderListSize(_maxHeaderListSize)
+	{ }
+
+bool
+HpackDecoder::decodeInteger(const unsigned char **pos, const unsigned char *end,
+	unsigned int prefixBits, size_t *result)
+{
+	const unsigned char *p = *pos;
+	size_t maxPrefix = (1 << prefixBits) - 1;
+	size_t value;
+	unsigned int shift = 0;
+
+	if (p == end) {
+		return false;
+	}
+	value = *p & maxPrefix;
+	p++;
+	if (value == maxPrefix) {
+		do {
+			if (p == end || shift > 28) {
+				return false;
+			}
+			value += size_t(*p & 0x7f) << shift;
+			shift += 7;
+			p++;
+		} while (p[-1] & 0x80);
+	}
+
+	*pos = p;
+	*result = value;
+	return true;
+}
+
+bool
+HpackDecoder::decodeHuffman(const unsigned char *data, size_t size, string &result) {
+	boost::uint32_t code = 0;
+	unsigned int len = 0;
+
+	result.reserve(result.size() + size * 8 / 5);
+	for (size_t i = 0; i < size; i++) {
+		for (int bit = 7; bit >= 0; bit--) {
+			code = (code << 1) | ((data[i] >> bit) & 1);
+			len++;
+			if (len > 30) {
+				return false;
+			}
+
+			boost::uint32_t offset = code - HPACK_HUFFMAN_FIRST_CODE[len];
+			if (HPACK_HUFFMAN_COUNT[len] > 0 && offset < HPACK_HUFFMAN_COUNT[len]) {
+				unsigned int symbol = HPACK_HUFFMAN_SYMBOLS[
+					HPACK_HUFFMAN_FIRST_INDEX[len] + offset];
+				if (symbol == HPACK_HUFFMAN_EOS) {
+					return false;
+				}
+				result.append(1, (char) symbol);
+				code = 0;
+				len = 0;
+			}
+		}
+	}
+
+	// The remaining bits must be padding: a prefix of EOS (all ones),
+	// and shorter than 8 bits.
+	return len < 8 && code == (boost::uint32_t(1) << len) - 1;
+}
+
+bool
+HpackDecoder::lookup(size_t index, const char **name, size_t *nameSize,
+	const char **value, size_t *valueSize) const
+{
+	if (index == 0) {
+		return false;
+	} else if (index <= HPACK_STATIC_TABLE_SIZE) {
+		*name = HPACK_STATIC_TABLE[index].name;
+		*nameSize = strlen(*name);
+		*value = HPACK_STATIC_TABLE[index].value;
+		*valueSize = strlen(*value);
+		return true;
+	} else if (index - HPACK_STATIC_TABLE_SIZE <= dynamicTable.size()) {
+		const pair<string, string> &entry = dynamicTable[index - HPACK_STATIC_TABLE_SIZE - 1];
+		*name = entry.first.data();
+		*nameSize = entry.first.size();
+		*value = entry.second.data();
+		*valueSize = entry.second.size();
+		return true;
+	} else {
+		return false;
+	}
+}
+
+void
+HpackDecoder::evict(size_t maxSize) {
+	while (dynamicTableSize > maxSize) {
+		const pair<string, string> &entry = dynamicTable.back();
+		dynamicTableSize -= entry.first.size() + entry.second.size()
+			+ HPACK_ENTRY_OVERHEAD;
+		dynamicTable.pop_back();
+	}
+}
+
+void
+HpackDecoder::insert(const string &name, const string &value) {
+	size_t size = name.size() + value.size() + HPACK_ENTRY_OVERHEAD;
+	if (size > maxDynamicTableSize) {
+		// An entry larger than the table empties the table.
+		evict(0);
+	} else {
+		evict(maxDynamicTableSize - size);
+		dynamicTable.push_front(make_pair(name, value));
+		dynamicTableSize += size;
+	}
+}
+
+static bool
+decodeString(const unsigned char **pos, const unsigned char *end, string &result) {
+	bool huffman;
+	size_t size;
+
+	if (*pos == end) {
+		return false;
+	}
+	huffman = **pos & 0x80;
+	if (!HpackDecoder::decodeInteger(pos, end, 7, &size)) {
+		return false;
+	}
+	if (size > size_t(end - *pos)) {
+		return false;
+	}
+
+	result.clear();
+	if (huffman) {
+		if (!HpackDecoder::decodeHuffman(*pos, size, result)) {
+			return false;
+		}
+	} else {
+		result.assign((const char *) *pos, size);
+	}
+	*pos += size;
+	return true;
+}
+
+bool
+HpackDecoder::decode(const char *data, size_t size, HpackHeaderList &headers) {
+	const unsigned char *pos = (const unsigned char *) data;
+	const unsigned char *end = pos + size;
+	const char *name, *value;
+	size_t nameSize, valueSize, index;
+	size_t headerListSize = 0;
+	bool headerSeen = false;
+
+	while (pos < end) {
+		unsigned char c = *pos;
+
+		if (c & 0x80) {
+			// Indexed header field.
+			if (!decodeInteger(&pos, end, 7, &index)
+			 || !lookup(index, &name, &nameSize, &value, &valueSize))
+			{
+				return false;
+			}
+			headerListSize += nameSize + valueSize + HPACK_ENTRY_OVERHEAD;
+			if (headerListSize > maxHeaderListSize) {
+				return false;
+			}
+			headers.push_back(make_pair(string(name, nameSize), string(value, valueSize)));
+			headerSeen = true;
+
+		} else if ((c & 0xe0) == 0x20) {
+			// Dynamic table size update. Only allowed at the beginning
+			// of a header block.
+			if (headerSeen || !decodeInteger(&pos, end, 5, &index)
+			 || index > settingsMaxDynamicTableSize)
+			{
+				return false;
+			}
+			maxDynamicTableSize = index;
+			evict(maxDynamicTableSize);
+
+		} else {
+			// Literal header field, with incremental indexing (01xxxxxx),
+			// without indexing (0000xxxx) or never indexed (0001xxxx).
+			bool addToTable = (c & 0xc0) == 0x40;
+			unsigned int prefixBits = addToTable ? 6 : 4;
+			pair<string, string> header;
+
+			if (!decodeInteger(&pos, end, prefixBits, &index)) {
+				return false;
+			}
+			if (index == 0) {
+				if (!decodeString(&pos, end, header.first)) {
+					return false;
+				}
+			} else if (lookup(index, &name, &nameSize, &value, &valueSize)) {
+				header.first.assign(name, nameSize);
+			} else {
+				return false;
+			}
+			if (!decodeString(&pos, end, header.second)) {
+				return false;
+			}
+			headerListSize += header.first.size() + header.second.size()
+				+ HPACK_ENTRY_OVERHEAD;
+			if (headerListSize > maxHeaderListSize) {
+				return false;
+			}
+
+			if (addToTable) {
+				insert(header.first, header.second);
+			}
+			headers.push_back(header);
+			headerSeen = true;
+		}
+	}
+
+	return true;
+}
+
+
+void
+HpackEncoder::encodeInteger(string &output, unsigned char firstByte,
+	unsigned int prefixBits, size_t value)
+{
+	size_t maxPrefix = (1 << prefixBits) - 1;
+	if (value < maxPrefix) {
+		output.append(1, (char) (firstByte | value));
+	} else {
+		output.append(1, (char) (firstByte | maxPrefix));
+		value -= maxPrefix;
+		while (value >= 128) {
+			output.append(1, (char) ((value & 0x7f) | 0x80));
+			value >>= 7;
+		}
+		output.append(1, (char) value);
+	}
+}
+
+void
+HpackEncoder::encode(string &output, const StaticString &name, const StaticString &value) {
+	size_t nameIndex = 0;
+
+	for (size_t i = 1; i <= HPACK_STATIC_TABLE_SIZE; i++) {
+		if (name == HPACK_STATIC_TABLE[i].name) {
+			if (value == HPACK_STATIC_TABLE[i].value) {
+				// Indexed header field.
+				encodeInteger(output, 0x80, 7, i);
+				return;
+			} else if (nameIndex == 0) {
+				nameIndex = i;
+			}
+		}
+	}
+
+	// Literal header field without indexing.
+	encodeInteger(output, 0x00, 4, nameIndex);
+	if (nameIndex == 0) {
+		encodeInteger(output, 0x00, 7, name.size());
+		output.append(name.data(), name.size());
+	}
+	encodeInteger(output, 0x00, 7, value.size());
+	output.append(value.data(), value.size());
+}
+
+
+} // namespace ServerKit
+} // namespace Passenger
@@ -0,0 +1,123 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_SERVER_KIT_HPACK_H_
+#define _PASSENGER_SERVER_KIT_HPACK_H_
+
+#include <boost/cstdint.hpp>
+#include <string>
+#include <vector>
+#include <deque>
+#include <utility>
+#include <cstddef>
+#include <StaticString.h>
+
+namespace Passenger {
+namespace ServerKit {
+
+using namespace std;
+
+
+/**
+ * HPACK (RFC 7541) header compression, as used by HTTP/2.
+ *
+ * HpackDecoder implements the complete decoding side: the static and dynamic
+ * tables, all header field representations and Huffman-coded strings.
+ *
+ * HpackEncoder is deliberately simple: it never adds entries to the dynamic
+ * table and never Huffman-codes strings. It only uses the static table to
+ * shorten header names and common `:status` values. This is allowed by the
+ * spec and means that it doesn't need to track the peer's table size.
+ */
+
+typedef vector< pair<string, string> > HpackHeaderList;
+
+class HpackDecoder {
+private:
+	deque< pair<string, string> > dynamicTable;
+	size_t dynamicTableSize;
+	size_t maxDynamicTableSize;
+	size_t settingsMaxDynamicTableSize;
+	size_t maxHeaderListSize;
+
+	bool lookup(size_t index, const char **name, size_t *nameSize,
+		const char **value, size_t *valueSize) const;
+	void insert(const string &name, const string &value);
+	void evict(size_t maxSize);
+
+public:
+	static const size_t DEFAULT_MAX_DYNAMIC_TABLE_SIZE = 4096;
+	/** Same as the HTTP/1 header size limit, HTTP_MAX_HEADER_SIZE. */
+	static const size_t DEFAULT_MAX_HEADER_LIST_SIZE = 80 * 1024;
+
+	HpackDecoder(size_t maxTableSize = DEFAULT_MAX_DYNAMIC_TABLE_SIZE,
+		size_t maxHeaderListSize = DEFAULT_MAX_HEADER_LIST_SIZE);
+
+	/**
+	 * Decodes a complete header block and appends the decoded headers to
+	 * `headers`. Returns false if the header block is malformed, or if the
+	 * decoded header list is larger than `maxHeaderListSize` (as defined
+	 * by SETTINGS_MAX_HEADER_LIST_SIZE: the sum of the name and value sizes
+	 * plus 32 bytes per header). A small block can otherwise expand to a
+	 * huge header list by repeatedly referring to a large table entry.
+	 * In case of failure the decoder state is undefined and the connection
+	 * must be terminated with a COMPRESSION_ERROR.
+	 */
+	bool decode(const char *data, size_t size, HpackHeaderList &headers);
+
+	size_t getMaxHeaderListSize() const {
+		return maxHeaderListSize;
+	}
+
+	size_t getDynamicTableSize() const {
+		return dynamicTableSize;
+	}
+
+	size_t getDynamicTableEntryCount() const {
+		return dynamicTable.size();
+	}
+
+	static bool decodeInteger(const unsigned char **pos, const unsigned char *end,
+		unsigned int prefixBits, size_t *result);
+	static bool decodeHuffman(const unsigned char *data, size_t size, string &result);
+};
+
+class HpackEncoder {
+public:
+	static void encodeInteger(string &output, unsigned char firstByte,
+		unsigned int prefixBits, size_t value);
+
+	/**
+	 * Appends the encoding of the given header to `output`. `name` must be in
+	 * lowercase.
+	 */
+	static void encode(string &output, const StaticString &name, const StaticString &value);
+};
+
+
+} // namespace ServerKit
+} // namespace Passenger
+
+#endif /* _PASSENGER_SERVER_KIT_HPACK_H_ */
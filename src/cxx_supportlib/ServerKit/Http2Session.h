@@ -0,0 +1,1301 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_SERVER_KIT_HTTP2_SESSION_H_
+#define _PASSENGER_SERVER_KIT_HTTP2_SESSION_H_
+
+#include <boost/cstdint.hpp>
+#include <oxt/macros.hpp>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <cstring>
+#include <cerrno>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <jsoncpp/json.h>
+#include <LoggingKit/LoggingKit.h>
+#include <MemoryKit/mbuf.h>
+#include <ServerKit/Context.h>
+#include <ServerKit/Hooks.h>
+#include <ServerKit/Channel.h>
+#include <ServerKit/FdSourceChannel.h>
+#include <ServerKit/FileBufferedFdSinkChannel.h>
+#include <ServerKit/Hpack.h>
+#include <ServerKit/http_parser.h>
+#include <Exceptions.h>
+#include <Utils/IOUtils.h>
+#include <Utils/StrIntUtils.h>
+
+namespace Passenger {
+namespace ServerKit {
+
+using namespace std;
+
+
+extern const char HTTP2_CONNECTION_PREFACE[];
+extern const unsigned int HTTP2_CONNECTION_PREFACE_SIZE;
+
+class Http2Session;
+
+/**
+ * Connects an Http2Session to the server that owns the HTTP/2 client
+ * connection.
+ */
+class Http2SessionHooks {
+public:
+	virtual ~Http2SessionHooks() { }
+
+	/** Writes raw frame data to the HTTP/2 client. */
+	virtual void h2_write(Http2Session *session, const MemoryKit::mbuf &buffer) = 0;
+
+	/**
+	 * Hands the server side of a stream's socket pair to the HTTP/1 server,
+	 * which processes it like any other client. Returns false if the server
+	 * does not accept new clients at this time.
+	 */
+	virtual bool h2_feedNewClient(Http2Session *session, int fd) = 0;
+
+	/** Disconnects the HTTP/2 client after a connection error. */
+	virtual void h2_disconnect(Http2Session *session) = 0;
+};
+
+
+/**
+ * Implements the server side of an HTTP/2 connection (RFC 7540), using
+ * "prior knowledge" h2c: the client starts the connection with the HTTP/2
+ * connection preface instead of an HTTP/1 request.
+ *
+ * HttpServer and its subclasses assume that a client has exactly one
+ * current request, so HTTP/2 streams cannot be mapped onto the existing
+ * request objects directly. Instead, every stream is bridged through a Unix
+ * socket pair: the stream's request is translated to an HTTP/1.1 request
+ * and written into one end, while the other end is fed to the server as if
+ * it were a newly accepted client. The HTTP/1.1 response that the server
+ * writes back is parsed and translated into HEADERS and DATA frames. This
+ * way the entire request processing pipeline (request parsing, routing,
+ * spawning, body buffering and response forwarding) is reused unchanged,
+ * at the cost of one socket pair per stream.
+ *
+ * Request bodies are buffered by the stream's sink channel (in memory or on
+ * disk, like all other request bodies), so receive windows are replenished
+ * immediately. Response data honors the client's flow control windows: when
+ * a stream has too much pending data, reading from the server is paused
+ * until the client sends a WINDOW_UPDATE.
+ *
+ * Server push, priorities and the HTTP/1 "Upgrade: h2c" mechanism are not
+ * supported.
+ *
+ * Http2Session is reference counted. It starts with a refcount of 1, which
+ * belongs to the creator. The creator must call `shutdown()` and `unref()`
+ * when the client disconnects. All methods must be called from the event
+ * loop thread.
+ */
+class Http2Session {
+public:
+	enum FrameType {
+		DATA_FRAME          = 0x0,
+		HEADERS_FRAME       = 0x1,
+		PRIORITY_FRAME      = 0x2,
+		RST_STREAM_FRAME    = 0x3,
+		SETTINGS_FRAME      = 0x4,
+		PUSH_PROMISE_FRAME  = 0x5,
+		PING_FRAME          = 0x6,
+		GOAWAY_FRAME        = 0x7,
+		WINDOW_UPDATE_FRAME = 0x8,
+		CONTINUATION_FRAME  = 0x9
+	};
+
+	enum FrameFlag {
+		END_STREAM_FLAG  = 0x1,
+		ACK_FLAG         = 0x1,
+		END_HEADERS_FLAG = 0x4,
+		PADDED_FLAG      = 0x8,
+		PRIORITY_FLAG    = 0x20
+	};
+
+	enum ErrorCode {
+		NO_ERROR            = 0x0,
+		PROTOCOL_ERROR      = 0x1,
+		INTERNAL_ERROR      = 0x2,
+		FLOW_CONTROL_ERROR  = 0x3,
+		SETTINGS_TIMEOUT    = 0x4,
+		STREAM_CLOSED       = 0x5,
+		FRAME_SIZE_ERROR    = 0x6,
+		REFUSED_STREAM      = 0x7,
+		CANCEL              = 0x8,
+		COMPRESSION_ERROR   = 0x9,
+		ENHANCE_YOUR_CALM   = 0xb
+	};
+
+	enum SettingId {
+		SETTINGS_HEADER_TABLE_SIZE      = 0x1,
+		SETTINGS_ENABLE_PUSH            = 0x2,
+		SETTINGS_MAX_CONCURRENT_STREAMS = 0x3,
+		SETTINGS_INITIAL_WINDOW_SIZE    = 0x4,
+		SETTINGS_MAX_FRAME_SIZE         = 0x5,
+		SETTINGS_MAX_HEADER_LIST_SIZE   = 0x6
+	};
+
+	static const unsigned int FRAME_HEADER_SIZE = 9;
+	static const unsigned int DEFAULT_MAX_FRAME_SIZE = 16384;
+	static const unsigned int DEFAULT_WINDOW_SIZE = 65535;
+	static const boost::int64_t MAX_WINDOW_SIZE = 0x7fffffff;
+	static const unsigned int MAX_HEADER_BLOCK_SIZE = 64 * 1024;
+	/** The decoded header list may be as large as an HTTP/1 header. */
+	static const unsigned int MAX_HEADER_LIST_SIZE = HTTP_MAX_HEADER_SIZE;
+	/**
+	 * When a stream has more than this amount of response data that could
+	 * not be sent yet because of flow control, stop reading the response.
+	 */
+	static const unsigned int STREAM_PENDING_DATA_THRESHOLD = 64 * 1024;
+
+	enum State {
+		WAITING_FOR_PREFACE,
+		ACTIVE,
+		SHUT_DOWN
+	};
+
+	void *userData;
+
+private:
+	struct Stream {
+		Http2Session *session;
+		boost::uint32_t id;
+		unsigned int refcount;
+		int fd;
+		Hooks hooks;
+		FileBufferedFdSinkChannel requestSink;
+		FdSourceChannel responseSource;
+
+		http_parser responseParser;
+		HpackHeaderList responseHeaders;
+		string pendingData;
+		size_t pendingDataOffset;
+		boost::int64_t sendWindow;
+
+		bool isHeadRequest: 1;
+		bool requestBodyChunked: 1;
+		bool requestEnded: 1;
+		bool lastHeaderCallbackWasValue: 1;
+		bool responseHeadersSent: 1;
+		bool responseComplete: 1;
+		bool responseSourcePaused: 1;
+
+		Stream(Http2Session *_session, boost::uint32_t _id, int _fd)
+			: session(_session),
+			  id(_id),
+			  refcount(1),
+			  fd(_fd),
+			  pendingDataOffset(0),
+			  sendWindow(_session->peerInitialWindowSize),
+			  isHeadRequest(false),
+			  requestBodyChunked(false),
+			  requestEnded(false),
+			  lastHeaderCallbackWasValue(false),
+			  responseHeadersSent(false),
+			  responseComplete(false),
+			  responseSourcePaused(false)
+			{ }
+
+		size_t getPendingDataSize() const {
+			return pendingData.size() - pendingDataOffset;
+		}
+	};
+
+	class StreamHooksImpl: public HooksImpl {
+	public:
+		virtual bool hook_isConnected(Hooks *hooks, void *source) {
+			return static_cast<Stream *>(hooks->userData)->session != NULL;
+		}
+
+		virtual void hook_ref(Hooks *hooks, void *source, const char *file, unsigned int line) {
+			static_cast<Stream *>(hooks->userData)->refcount++;
+		}
+
+		virtual void hook_unref(Hooks *hooks, void *source, const char *file, unsigned int line) {
+			unrefStream(static_cast<Stream *>(hooks->userData));
+		}
+	};
+
+	struct SessionRefGuard {
+		Http2Session *session;
+
+		SessionRefGuard(Http2Session *_session)
+			: session(_session)
+		{
+			session->ref();
+		}
+
+		~SessionRefGuard() {
+			session->unref();
+		}
+	};
+
+	typedef map<boost::uint32_t, Stream *> StreamMap;
+
+	Context *ctx;
+	Http2SessionHooks *hooks;
+	StreamHooksImpl streamHooksImpl;
+	unsigned int refcount;
+	unsigned int maxConcurrentStreams;
+	State state;
+
+	string inputBuffer;
+	HpackDecoder hpackDecoder;
+	string headerBlock;
+	boost::uint32_t headerBlockStreamId;
+	boost::uint8_t headerBlockFlags;
+
+	StreamMap streams;
+	boost::uint32_t lastStreamId;
+	boost::int64_t sendWindow;
+	boost::int64_t peerInitialWindowSize;
+	unsigned int peerMaxFrameSize;
+	bool goingAway;
+
+	unsigned long long totalStreamsOpened;
+	unsigned long long totalStreamsRefused;
+
+
+	/***** Helpers *****/
+
+	static boost::uint32_t readUint32(const unsigned char *data) {
+		return ((boost::uint32_t) data[0] << 24)
+			| ((boost::uint32_t) data[1] << 16)
+			| ((boost::uint32_t) data[2] << 8)
+			| (boost::uint32_t) data[3];
+	}
+
+	static void writeUint32(unsigned char *data, boost::uint32_t value) {
+		data[0] = (value >> 24) & 0xff;
+		data[1] = (value >> 16) & 0xff;
+		data[2] = (value >> 8) & 0xff;
+		data[3] = value & 0xff;
+	}
+
+	MemoryKit::mbuf copyToMbuf(const char *data, size_t size) {
+		MemoryKit::mbuf buffer(MemoryKit::mbuf_get_with_size(&ctx->mbuf_pool, size));
+		memcpy(buffer.start, data, size);
+		return buffer;
+	}
+
+	static void unrefStream(Stream *stream) {
+		assert(stream->refcount > 0);
+		stream->refcount--;
+		if (stream->refcount == 0) {
+			delete stream;
+		}
+	}
+
+	Stream *lookupStream(boost::uint32_t id) const {
+		StreamMap::const_iterator it = streams.find(id);
+		if (it == streams.end()) {
+			return NULL;
+		} else {
+			return it->second;
+		}
+	}
+
+
+	/***** Frame output *****/
+
+	void writeFrame(FrameType type, boost::uint8_t flags, boost::uint32_t streamId,
+		const char *payload, size_t size)
+	{
+		if (hooks == NULL) {
+			return;
+		}
+
+		MemoryKit::mbuf buffer(MemoryKit::mbuf_get_with_size(&ctx->mbuf_pool,
+			FRAME_HEADER_SIZE + size));
+		unsigned char *header = (unsigned char *) buffer.start;
+		header[0] = (size >> 16) & 0xff;
+		header[1] = (size >> 8) & 0xff;
+		header[2] = size & 0xff;
+		header[3] = (unsigned char) type;
+		header[4] = flags;
+		writeUint32(header + 5, streamId & 0x7fffffff);
+		if (size > 0) {
+			memcpy(buffer.start + FRAME_HEADER_SIZE, payload, size);
+		}
+		hooks->h2_write(this, buffer);
+	}
+
+	void writeSettings() {
+		unsigned char payload[12];
+		payload[0] = 0;
+		payload[1] = SETTINGS_MAX_CONCURRENT_STREAMS;
+		writeUint32(payload + 2, maxConcurrentStreams);
+		payload[6] = 0;
+		payload[7] = SETTINGS_MAX_HEADER_LIST_SIZE;
+		writeUint32(payload + 8, MAX_HEADER_LIST_SIZE);
+		writeFrame(SETTINGS_FRAME, 0, 0, (const char *) payload, sizeof(payload));
+	}
+
+	void writeWindowUpdate(boost::uint32_t streamId, boost::uint32_t increment) {
+		unsigned char payload[4];
+		writeUint32(payload, increment);
+		writeFrame(WINDOW_UPDATE_FRAME, 0, streamId, (const char *) payload, sizeof(payload));
+	}
+
+	void writeRstStream(boost::uint32_t streamId, ErrorCode code) {
+		unsigned char payload[4];
+		writeUint32(payload, code);
+		writeFrame(RST_STREAM_FRAME, 0, streamId, (const char *) payload, sizeof(payload));
+	}
+
+	void writeGoaway(ErrorCode code) {
+		unsigned char payload[8];
+		writeUint32(payload, lastStreamId);
+		writeUint32(payload + 4, code);
+		writeFrame(GOAWAY_FRAME, 0, 0, (const char *) payload, sizeof(payload));
+	}
+
+	/**
+	 * Writes a header block, split into a HEADERS frame and as many
+	 * CONTINUATION frames as necessary.
+	 */
+	void writeHeaderBlock(boost::uint32_t streamId, const string &block) {
+		size_t pos = 0;
+		bool first = true;
+
+		do {
+			size_t size = std::min<size_t>(block.size() - pos, peerMaxFrameSize);
+			boost::uint8_t flags = (pos + size == block.size()) ? END_HEADERS_FLAG : 0;
+			writeFrame(first ? HEADERS_FRAME : CONTINUATION_FRAME, flags,
+				streamId, block.data() + pos, size);
+			pos += size;
+			first = false;
+		} while (pos < block.size());
+	}
+
+	void connectionError(ErrorCode code, const char *reason) {
+		P_DEBUG("[HTTP/2 session " << (void *) this << "] Connection error: "
+			<< reason);
+		writeGoaway(code);
+		if (hooks != NULL) {
+			hooks->h2_disconnect(this);
+		}
+		shutdown();
+	}
+
+
+	/***** Frame input *****/
+
+	void processFrame(FrameType type, boost::uint8_t flags, boost::uint32_t streamId,
+		const char *payload, size_t size)
+	{
+		if (headerBlockStreamId != 0
+		 && (type != CONTINUATION_FRAME || streamId != headerBlockStreamId))
+		{
+			connectionError(PROTOCOL_ERROR, "expected a CONTINUATION frame");
+			return;
+		}
+
+		switch (type) {
+		case DATA_FRAME:
+			processDataFrame(flags, streamId, payload, size);
+			break;
+		case HEADERS_FRAME:
+			processHeadersFrame(flags, streamId, payload, size);
+			break;
+		case CONTINUATION_FRAME:
+			processContinuationFrame(flags, streamId, payload, size);
+			break;
+		case RST_STREAM_FRAME:
+			processRstStreamFrame(streamId, payload, size);
+			break;
+		case SETTINGS_FRAME:
+			processSettingsFrame(flags, streamId, payload, size);
+			break;
+		case PUSH_PROMISE_FRAME:
+			connectionError(PROTOCOL_ERROR, "clients may not send PUSH_PROMISE");
+			break;
+		case PING_FRAME:
+			processPingFrame(flags, streamId, payload, size);
+			break;
+		case GOAWAY_FRAME:
+			goingAway = true;
+			break;
+		case WINDOW_UPDATE_FRAME:
+			processWindowUpdateFrame(streamId, payload, size);
+			break;
+		default:
+			// PRIORITY and unknown frame types are ignored.
+			break;
+		}
+	}
+
+	/**
+	 * Removes padding from a DATA or HEADERS frame payload. Returns false
+	 * if the padding is invalid.
+	 */
+	static bool stripPadding(boost::uint8_t flags, const char **payload, size_t *size) {
+		if (flags & PADDED_FLAG) {
+			if (*size < 1) {
+				return false;
+			}
+			size_t padLength = (unsigned char) (*payload)[0];
+			if (padLength >= *size) {
+				return false;
+			}
+			(*payload)++;
+			*size -= 1 + padLength;
+		}
+		return true;
+	}
+
+	void processDataFrame(boost::uint8_t flags, boost::uint32_t streamId,
+		const char *payload, size_t size)
+	{
+		if (streamId == 0) {
+			connectionError(PROTOCOL_ERROR, "DATA frame on stream 0");
+			return;
+		}
+
+		// Flow control applies to the entire frame payload, including padding.
+		// Request bodies are buffered by the stream's sink channel,
+		// so we can replenish the windows right away.
+		size_t frameSize = size;
+		if (frameSize > 0) {
+			writeWindowUpdate(0, frameSize);
+		}
+
+		if (!stripPadding(flags, &payload, &size)) {
+			connectionError(PROTOCOL_ERROR, "invalid padding");
+			return;
+		}
+
+		Stream *stream = lookupStream(streamId);
+		if (stream == NULL || stream->requestEnded) {
+			writeRstStream(streamId, STREAM_CLOSED);
+			return;
+		}
+
+		if (frameSize > 0 && !(flags & END_STREAM_FLAG)) {
+			writeWindowUpdate(streamId, frameSize);
+		}
+		if (size > 0) {
+			if (stream->requestBodyChunked) {
+				char header[sizeof(size_t) * 2 + 3];
+				unsigned int headerSize = integerToHex<size_t>(size, header);
+				header[headerSize++] = '\r';
+				header[headerSize++] = '\n';
+				stream->requestSink.feed(copyToMbuf(header, headerSize));
+				stream->requestSink.feed(copyToMbuf(payload, size));
+				stream->requestSink.feed(MemoryKit::mbuf("\r\n", 2));
+			} else {
+				stream->requestSink.feed(copyToMbuf(payload, size));
+			}
+		}
+		if (flags & END_STREAM_FLAG) {
+			endRequestBody(stream);
+		}
+	}
+
+	void processHeadersFrame(boost::uint8_t flags, boost::uint32_t streamId,
+		const char *payload, size_t size)
+	{
+		if (streamId == 0 || streamId % 2 == 0) {
+			connectionError(PROTOCOL_ERROR, "invalid stream ID in HEADERS frame");
+			return;
+		}
+		if (!stripPadding(flags, &payload, &size)) {
+			connectionError(PROTOCOL_ERROR, "invalid padding");
+			return;
+		}
+		if (flags & PRIORITY_FLAG) {
+			if (size < 5) {
+				connectionError(FRAME_SIZE_ERROR, "HEADERS frame too small");
+				return;
+			}
+			payload += 5;
+			size -= 5;
+		}
+
+		headerBlock.assign(payload, size);
+		headerBlockStreamId = streamId;
+		headerBlockFlags = flags;
+		if (flags & END_HEADERS_FLAG) {
+			processHeaderBlock();
+		}
+	}
+
+	void processContinuationFrame(boost::uint8_t flags, boost::uint32_t streamId,
+		const char *payload, size_t size)
+	{
+		if (headerBlockStreamId == 0) {
+			connectionError(PROTOCOL_ERROR, "unexpected CONTINUATION frame");
+			return;
+		}
+		if (headerBlock.size() + size > MAX_HEADER_BLOCK_SIZE) {
+			connectionError(ENHANCE_YOUR_CALM, "header block too large");
+			return;
+		}
+		headerBlock.append(payload, size);
+		if (flags & END_HEADERS_FLAG) {
+			processHeaderBlock();
+		}
+	}
+
+	void processHeaderBlock() {
+		boost::uint32_t streamId = headerBlockStreamId;
+		bool endStream = headerBlockFlags & END_STREAM_FLAG;
+		HpackHeaderList headers;
+
+		headerBlockStreamId = 0;
+		// The header block must always be decoded, even if the stream is
+		// refused, in order to keep the decoder's dynamic table in sync.
+		if (!hpackDecoder.decode(headerBlock.data(), headerBlock.size(), headers)) {
+			connectionError(COMPRESSION_ERROR, "invalid or too large header block");
+			return;
+		}
+		headerBlock.clear();
+
+		Stream *stream = lookupStream(streamId);
+		if (stream != NULL) {
+			// Trailers. HTTP/1.1 chunked trailers are not worth the trouble,
+			// so we just treat them as the end of the request body.
+			if (!endStream) {
+				closeStream(stream, PROTOCOL_ERROR);
+			} else if (!stream->requestEnded) {
+				endRequestBody(stream);
+			}
+			return;
+		}
+
+		if (streamId <= lastStreamId) {
+			connectionError(PROTOCOL_ERROR, "HEADERS frame on a closed stream");
+			return;
+		}
+		lastStreamId = streamId;
+
+		if (goingAway || streams.size() >= maxConcurrentStreams) {
+			totalStreamsRefused++;
+			writeRstStream(streamId, REFUSED_STREAM);
+			return;
+		}
+
+		openStream(streamId, headers, endStream);
+	}
+
+	void processRstStreamFrame(boost::uint32_t streamId, const char *payload, size_t size) {
+		if (streamId == 0) {
+			connectionError(PROTOCOL_ERROR, "RST_STREAM frame on stream 0");
+			return;
+		}
+		if (size != 4) {
+			connectionError(FRAME_SIZE_ERROR, "invalid RST_STREAM frame size");
+			return;
+		}
+
+		Stream *stream = lookupStream(streamId);
+		if (stream != NULL) {
+			closeStream(stream);
+		}
+	}
+
+	void processSettingsFrame(boost::uint8_t flags, boost::uint32_t streamId,
+		const char *payload, size_t size)
+	{
+		if (streamId != 0) {
+			connectionError(PROTOCOL_ERROR, "SETTINGS frame on a stream");
+			return;
+		}
+		if (flags & ACK_FLAG) {
+			return;
+		}
+		if (size % 6 != 0) {
+			connectionError(FRAME_SIZE_ERROR, "invalid SETTINGS frame size");
+			return;
+		}
+
+		const unsigned char *pos = (const unsigned char *) payload;
+		const unsigned char *end = pos + size;
+		bool windowIncreased = false;
+
+		for (; pos < end; pos += 6) {
+			unsigned int id = (pos[0] << 8) | pos[1];
+			boost::uint32_t value = readUint32(pos + 2);
+
+			switch (id) {
+			case SETTINGS_INITIAL_WINDOW_SIZE: {
+				if (value > MAX_WINDOW_SIZE) {
+					connectionError(FLOW_CONTROL_ERROR, "invalid initial window size");
+					return;
+				}
+				boost::int64_t delta = (boost::int64_t) value - peerInitialWindowSize;
+				StreamMap::iterator it, streamsEnd = streams.end();
+				for (it = streams.begin(); it != streamsEnd; it++) {
+					it->second->sendWindow += delta;
+				}
+				peerInitialWindowSize = value;
+				windowIncreased = windowIncreased || delta > 0;
+				break;
+			}
+			case SETTINGS_MAX_FRAME_SIZE:
+				if (value < DEFAULT_MAX_FRAME_SIZE || value > 0xffffff) {
+					connectionError(PROTOCOL_ERROR, "invalid maximum frame size");
+					return;
+				}
+				// We never receive frames larger than our own maximum,
+				// so there's no point in sending larger ones either.
+				peerMaxFrameSize = std::min<unsigned int>(value, (unsigned int) DEFAULT_MAX_FRAME_SIZE);
+				break;
+			default:
+				// Our HPACK encoder never uses the dynamic table, and we never
+				// push, so the other settings don't matter to us.
+				break;
+			}
+		}
+
+		writeFrame(SETTINGS_FRAME, ACK_FLAG, 0, NULL, 0);
+		if (windowIncreased) {
+			flushAllStreams();
+		}
+	}
+
+	void processPingFrame(boost::uint8_t flags, boost::uint32_t streamId,
+		const char *payload, size_t size)
+	{
+		if (streamId != 0) {
+			connectionError(PROTOCOL_ERROR, "PING frame on a stream");
+		} else if (size != 8) {
+			connectionError(FRAME_SIZE_ERROR, "invalid PING frame size");
+		} else if (!(flags & ACK_FLAG)) {
+			writeFrame(PING_FRAME, ACK_FLAG, 0, payload, size);
+		}
+	}
+
+	void processWindowUpdateFrame(boost::uint32_t streamId, const char *payload, size_t size) {
+		if (size != 4) {
+			connectionError(FRAME_SIZE_ERROR, "invalid WINDOW_UPDATE frame size");
+			return;
+		}
+
+		boost::uint32_t increment = readUint32((const unsigned char *) payload) & 0x7fffffff;
+		if (streamId == 0) {
+			if (increment == 0) {
+				connectionError(PROTOCOL_ERROR, "zero WINDOW_UPDATE increment");
+				return;
+			}
+			sendWindow += increment;
+			if (sendWindow > MAX_WINDOW_SIZE) {
+				connectionError(FLOW_CONTROL_ERROR, "connection window too large");
+				return;
+			}
+			flushAllStreams();
+		} else {
+			Stream *stream = lookupStream(streamId);
+			if (stream == NULL) {
+				return;
+			}
+			if (increment == 0) {
+				closeStream(stream, PROTOCOL_ERROR);
+				return;
+			}
+			stream->sendWindow += increment;
+			if (stream->sendWindow > MAX_WINDOW_SIZE) {
+				closeStream(stream, FLOW_CONTROL_ERROR);
+				return;
+			}
+			flushStream(stream);
+		}
+	}
+
+
+	/***** Streams *****/
+
+	static bool isValidHeaderName(const string &name) {
+		if (name.empty()) {
+			return false;
+		}
+		for (string::const_iterator it = name.begin(); it != name.end(); it++) {
+			char ch = *it;
+			if (ch <= ' ' || ch == ':' || ch >= 0x7f || (ch >= 'A' && ch <= 'Z')) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static bool isValidHeaderValue(const string &value) {
+		for (string::const_iterator it = value.begin(); it != value.end(); it++) {
+			char ch = *it;
+			if (ch == '\r' || ch == '\n' || ch == '\0') {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static bool isValidRequestLineComponent(const string &value) {
+		if (value.empty()) {
+			return false;
+		}
+		for (string::const_iterator it = value.begin(); it != value.end(); it++) {
+			if ((unsigned char) *it <= ' ' || *it == 0x7f) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static bool isConnectionSpecificHeader(const string &name) {
+		return name == "connection"
+			|| name == "keep-alive"
+			|| name == "proxy-connection"
+			|| name == "transfer-encoding"
+			|| name == "upgrade"
+			|| name == "te";
+	}
+
+	/**
+	 * Translates an HTTP/2 request header list to an HTTP/1.1 request head.
+	 * Returns false if the header list is malformed.
+	 */
+	static bool translateRequestHeaders(const HpackHeaderList &headers, bool endStream,
+		string &result, bool *isHeadRequest, bool *chunked)
+	{
+		HpackHeaderList::const_iterator it, end = headers.end();
+		const string *method = NULL, *path = NULL, *authority = NULL;
+		string cookies;
+		bool hasHost = false, hasContentLength = false;
+
+		for (it = headers.begin(); it != end && !it->first.empty() && it->first[0] == ':'; it++) {
+			if (it->first == ":method") {
+				method = &it->second;
+			} else if (it->first == ":path") {
+				path = &it->second;
+			} else if (it->first == ":authority") {
+				authority = &it->second;
+			} else if (it->first != ":scheme") {
+				return false;
+			}
+		}
+		if (method == NULL || path == NULL
+		 || !isValidRequestLineComponent(*method)
+		 || !isValidRequestLineComponent(*path)
+		 || *method == "CONNECT")
+		{
+			return false;
+		}
+
+		result.append(*method);
+		result.append(" ", 1);
+		result.append(*path);
+		result.append(" HTTP/1.1\r\n", sizeof(" HTTP/1.1\r\n") - 1);
+
+		for (; it != end; it++) {
+			const string &name = it->first;
+			const string &value = it->second;
+
+			if (!isValidHeaderName(name) || !isValidHeaderValue(value)) {
+				return false;
+			}
+			if (isConnectionSpecificHeader(name)) {
+				continue;
+			}
+			if (name == "cookie") {
+				// HTTP/2 allows the Cookie header to be split into
+				// multiple fields, but HTTP/1.1 does not.
+				if (!cookies.empty()) {
+					cookies.append("; ", 2);
+				}
+				cookies.append(value);
+				continue;
+			}
+
+			if (name == "host") {
+				hasHost = true;
+			} else if (name == "content-length") {
+				hasContentLength = true;
+			}
+			result.append(name);
+			result.append(": ", 2);
+			result.append(value);
+			result.append("\r\n", 2);
+		}
+
+		if (!hasHost && authority != NULL) {
+			if (!isValidHeaderValue(*authority)) {
+				return false;
+			}
+			result.append("host: ", sizeof("host: ") - 1);
+			result.append(*authority);
+			result.append("\r\n", 2);
+		}
+		if (!cookies.empty()) {
+			result.append("cookie: ", sizeof("cookie: ") - 1);
+			result.append(cookies);
+			result.append("\r\n", 2);
+		}
+		*chunked = !endStream && !hasContentLength;
+		if (*chunked) {
+			result.append("transfer-encoding: chunked\r\n",
+				sizeof("transfer-encoding: chunked\r\n") - 1);
+		}
+		result.append("connection: close\r\n\r\n", sizeof("connection: close\r\n\r\n") - 1);
+
+		*isHeadRequest = *method == "HEAD";
+		return true;
+	}
+
+	void openStream(boost::uint32_t streamId, const HpackHeaderList &headers, bool endStream) {
+		string request;
+		bool isHeadRequest, chunked;
+		int fds[2];
+
+		if (!translateRequestHeaders(headers, endStream, request, &isHeadRequest, &chunked)) {
+			writeRstStream(streamId, PROTOCOL_ERROR);
+			return;
+		}
+
+		if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == -1) {
+			int e = errno;
+			P_WARN("[HTTP/2 session " << (void *) this << "] Cannot create a "
+				"socket pair for stream " << streamId << ": " << strerror(e)
+				<< " (errno=" << e << ")");
+			writeRstStream(streamId, REFUSED_STREAM);
+			return;
+		}
+		P_LOG_FILE_DESCRIPTOR_OPEN4(fds[0], __FILE__, __LINE__,
+			"HTTP/2 stream " << streamId << " socket (session side)");
+		P_LOG_FILE_DESCRIPTOR_OPEN4(fds[1], __FILE__, __LINE__,
+			"HTTP/2 stream " << streamId << " socket (server side)");
+		setNonBlocking(fds[0]);
+		setNonBlocking(fds[1]);
+
+		if (!hooks->h2_feedNewClient(this, fds[1])) {
+			safelyClose(fds[0], true);
+			P_LOG_FILE_DESCRIPTOR_CLOSE(fds[0]);
+			safelyClose(fds[1], true);
+			P_LOG_FILE_DESCRIPTOR_CLOSE(fds[1]);
+			totalStreamsRefused++;
+			writeRstStream(streamId, REFUSED_STREAM);
+			return;
+		}
+
+		Stream *stream = new Stream(this, streamId, fds[0]);
+		stream->hooks.impl = &streamHooksImpl;
+		stream->hooks.userData = stream;
+		stream->isHeadRequest = isHeadRequest;
+		stream->requestBodyChunked = chunked;
+		streams.insert(make_pair(streamId, stream));
+		totalStreamsOpened++;
+
+		http_parser_init(&stream->responseParser, HTTP_RESPONSE);
+		stream->responseParser.data = stream;
+
+		stream->requestSink.setContext(ctx);
+		stream->requestSink.setHooks(&stream->hooks);
+		stream->requestSink.reinitialize(fds[0]);
+		stream->requestSink.feed(copyToMbuf(request.data(), request.size()));
+		if (endStream) {
+			stream->requestEnded = true;
+		}
+
+		stream->responseSource.setContext(ctx);
+		stream->responseSource.setHooks(&stream->hooks);
+		stream->responseSource.setDataCallback(onResponseSourceData);
+		stream->responseSource.reinitialize(fds[0]);
+		stream->responseSource.startReadingInNextTick();
+	}
+
+	void endRequestBody(Stream *stream) {
+		stream->requestEnded = true;
+		if (stream->requestBodyChunked) {
+			stream->requestSink.feed(MemoryKit::mbuf("0\r\n\r\n", 5));
+		}
+	}
+
+	/**
+	 * Closes the stream and releases the socket pair. If `code` is not
+	 * NO_ERROR, then a RST_STREAM frame is sent with that error code.
+	 */
+	void closeStream(Stream *stream, ErrorCode code = NO_ERROR) {
+		if (code != NO_ERROR) {
+			writeRstStream(stream->id, code);
+		}
+
+		streams.erase(stream->id);
+		stream->session = NULL;
+		stream->requestSink.deinitialize();
+		stream->responseSource.deinitialize();
+		safelyClose(stream->fd, true);
+		P_LOG_FILE_DESCRIPTOR_CLOSE(stream->fd);
+		stream->fd = -1;
+		unrefStream(stream);
+	}
+
+	/**
+	 * Sends as much of the stream's pending response data as the flow
+	 * control windows allow, and finishes the stream once the entire
+	 * response has been sent.
+	 */
+	void flushStream(Stream *stream) {
+		while (stream->getPendingDataSize() > 0 && sendWindow > 0 && stream->sendWindow > 0) {
+			size_t size = std::min<boost::int64_t>(
+				std::min<boost::int64_t>(stream->getPendingDataSize(), peerMaxFrameSize),
+				std::min<boost::int64_t>(sendWindow, stream->sendWindow));
+			writeFrame(DATA_FRAME, 0, stream->id,
+				stream->pendingData.data() + stream->pendingDataOffset, size);
+			stream->pendingDataOffset += size;
+			sendWindow -= size;
+			stream->sendWindow -= size;
+		}
+
+		if (stream->getPendingDataSize() == 0) {
+			stream->pendingData.clear();
+			stream->pendingDataOffset = 0;
+			if (stream->responseComplete) {
+				writeFrame(DATA_FRAME, END_STREAM_FLAG, stream->id, NULL, 0);
+				closeStream(stream);
+				return;
+			}
+		}
+
+		if (stream->responseSourcePaused
+		 && stream->getPendingDataSize() < STREAM_PENDING_DATA_THRESHOLD)
+		{
+			stream->responseSourcePaused = false;
+			stream->responseSource.start();
+		}
+	}
+
+	void flushAllStreams() {
+		// flushStream() may close streams, so iterate over a copy of the IDs.
+		vector<boost::uint32_t> ids;
+		StreamMap::const_iterator it, end = streams.end();
+
+		ids.reserve(streams.size());
+		for (it = streams.begin(); it != end; it++) {
+			ids.push_back(it->first);
+		}
+		for (unsigned int i = 0; i < ids.size() && sendWindow > 0 && state == ACTIVE; i++) {
+			Stream *stream = lookupStream(ids[i]);
+			if (stream != NULL) {
+				flushStream(stream);
+			}
+		}
+	}
+
+
+	/***** Response translation *****/
+
+	static Channel::Result onResponseSourceData(Channel *channel,
+		const MemoryKit::mbuf &buffer, int errcode)
+	{
+		FdSourceChannel *source = reinterpret_cast<FdSourceChannel *>(channel);
+		Stream *stream = static_cast<Stream *>(source->getHooks()->userData);
+		Http2Session *self = stream->session;
+
+		if (self == NULL) {
+			return Channel::Result(0, true);
+		}
+
+		SessionRefGuard guard(self);
+		return self->processResponseData(stream, buffer, errcode);
+	}
+
+	Channel::Result processResponseData(Stream *stream, const MemoryKit::mbuf &buffer,
+		int errcode)
+	{
+		http_parser_settings settings;
+
+		settings.on_message_begin = NULL;
+		settings.on_url = NULL;
+		settings.on_status = NULL;
+		settings.on_header_field = onResponseHeaderField;
+		settings.on_header_value = onResponseHeaderValue;
+		settings.on_headers_complete = onResponseHeadersComplete;
+		settings.on_body = onResponseBody;
+		settings.on_message_complete = onResponseMessageComplete;
+
+		if (buffer.size() > 0) {
+			size_t ret = http_parser_execute(&stream->responseParser, &settings,
+				buffer.start, buffer.size());
+			if (stream->session == NULL) {
+				return Channel::Result(0, true);
+			}
+			if (ret != buffer.size() && !stream->responseComplete) {
+				P_DEBUG("[HTTP/2 session " << (void *) this << "] Cannot parse the "
+					"response for stream " << stream->id << ": " <<
+					http_errno_description(HTTP_PARSER_ERRNO(&stream->responseParser)));
+				closeStream(stream, INTERNAL_ERROR);
+				return Channel::Result(0, true);
+			}
+		} else if (errcode == 0) {
+			// EOF. Responses without a Content-Length or chunked encoding
+			// are terminated by EOF.
+			http_parser_execute(&stream->responseParser, &settings, NULL, 0);
+			if (stream->session == NULL) {
+				return Channel::Result(0, true);
+			}
+			if (!stream->responseComplete) {
+				closeStream(stream, INTERNAL_ERROR);
+				return Channel::Result(0, true);
+			}
+		} else {
+			closeStream(stream, INTERNAL_ERROR);
+			return Channel::Result(0, true);
+		}
+
+		flushStream(stream);
+		if (stream->session != NULL
+		 && stream->getPendingDataSize() >= STREAM_PENDING_DATA_THRESHOLD)
+		{
+			stream->responseSourcePaused = true;
+			stream->responseSource.stop();
+		}
+		return Channel::Result(buffer.size(), buffer.empty());
+	}
+
+	static int onResponseHeaderField(http_parser *parser, const char *data, size_t len) {
+		Stream *stream = static_cast<Stream *>(parser->data);
+		if (stream->lastHeaderCallbackWasValue || stream->responseHeaders.empty()) {
+			stream->responseHeaders.push_back(make_pair(string(), string()));
+			stream->lastHeaderCallbackWasValue = false;
+		}
+		stream->responseHeaders.back().first.append(data, len);
+		return 0;
+	}
+
+	static int onResponseHeaderValue(http_parser *parser, const char *data, size_t len) {
+		Stream *stream = static_cast<Stream *>(parser->data);
+		stream->responseHeaders.back().second.append(data, len);
+		stream->lastHeaderCallbackWasValue = true;
+		return 0;
+	}
+
+	static int onResponseHeadersComplete(http_parser *parser) {
+		Stream *stream = static_cast<Stream *>(parser->data);
+		unsigned int status = parser->status_code;
+
+		if (status >= 100 && status < 200) {
+			// Informational responses are not forwarded.
+			stream->responseHeaders.clear();
+			stream->lastHeaderCallbackWasValue = false;
+			return 0;
+		}
+
+		string block;
+		char statusStr[4];
+		HpackHeaderList::iterator it, end = stream->responseHeaders.end();
+
+		integerToOtherBase<unsigned int, 10>(status, statusStr, sizeof(statusStr));
+		HpackEncoder::encode(block, P_STATIC_STRING(":status"), statusStr);
+		for (it = stream->responseHeaders.begin(); it != end; it++) {
+			string name(it->first.size(), '\0');
+			convertLowerCase((const unsigned char *) it->first.data(),
+				(unsigned char *) &name[0], name.size());
+			if (isConnectionSpecificHeader(name) || name == "status") {
+				continue;
+			}
+			HpackEncoder::encode(block, name, it->second);
+		}
+		stream->responseHeaders.clear();
+
+		stream->session->writeHeaderBlock(stream->id, block);
+		stream->responseHeadersSent = true;
+
+		// Tell the parser to skip the body of HEAD responses.
+		return stream->isHeadRequest ? 1 : 0;
+	}
+
+	static int onResponseBody(http_parser *parser, const char *data, size_t len) {
+		Stream *stream = static_cast<Stream *>(parser->data);
+		stream->pendingData.append(data, len);
+		return 0;
+	}
+
+	static int onResponseMessageComplete(http_parser *parser) {
+		Stream *stream = static_cast<Stream *>(parser->data);
+		if (stream->responseHeadersSent) {
+			stream->responseComplete = true;
+			// Ignore everything after the response.
+			return 1;
+		} else {
+			return 0;
+		}
+	}
+
+public:
+	Http2Session(Context *context, Http2SessionHooks *_hooks,
+		unsigned int _maxConcurrentStreams = 100)
+		: userData(NULL),
+		  ctx(context),
+		  hooks(_hooks),
+		  refcount(1),
+		  maxConcurrentStreams(_maxConcurrentStreams),
+		  state(WAITING_FOR_PREFACE),
+		  hpackDecoder(HpackDecoder::DEFAULT_MAX_DYNAMIC_TABLE_SIZE, MAX_HEADER_LIST_SIZE),
+		  headerBlockStreamId(0),
+		  headerBlockFlags(0),
+		  lastStreamId(0),
+		  sendWindow(DEFAULT_WINDOW_SIZE),
+		  peerInitialWindowSize(DEFAULT_WINDOW_SIZE),
+		  peerMaxFrameSize(DEFAULT_MAX_FRAME_SIZE),
+		  goingAway(false),
+		  totalStreamsOpened(0),
+		  totalStreamsRefused(0)
+		{ }
+
+	~Http2Session() {
+		assert(streams.empty());
+	}
+
+	/**
+	 * Processes data received from the client. Connection errors are handled
+	 * by sending GOAWAY, calling `h2_disconnect()` and shutting down the
+	 * session, so after this method returns, the caller should check
+	 * `getState()`.
+	 */
+	void feed(const char *data, size_t size) {
+		SessionRefGuard guard(this);
+		const char *pos, *end;
+
+		if (state == SHUT_DOWN) {
+			return;
+		}
+
+		if (inputBuffer.empty()) {
+			pos = data;
+			end = data + size;
+		} else {
+			inputBuffer.append(data, size);
+			pos = inputBuffer.data();
+			end = pos + inputBuffer.size();
+		}
+
+		if (state == WAITING_FOR_PREFACE) {
+			size_t len = std::min<size_t>(end - pos, HTTP2_CONNECTION_PREFACE_SIZE);
+			if (memcmp(pos, HTTP2_CONNECTION_PREFACE, len) != 0) {
+				connectionError(PROTOCOL_ERROR, "invalid connection preface");
+				return;
+			} else if (len < HTTP2_CONNECTION_PREFACE_SIZE) {
+				inputBuffer.assign(pos, end - pos);
+				return;
+			}
+			pos += HTTP2_CONNECTION_PREFACE_SIZE;
+			state = ACTIVE;
+			writeSettings();
+		}
+
+		while (state == ACTIVE && size_t(end - pos) >= FRAME_HEADER_SIZE) {
+			const unsigned char *header = (const unsigned char *) pos;
+			size_t length = (header[0] << 16) | (header[1] << 8) | header[2];
+
+			if (length > DEFAULT_MAX_FRAME_SIZE) {
+				connectionError(FRAME_SIZE_ERROR, "frame too large");
+				return;
+			}
+			if (size_t(end - pos) < FRAME_HEADER_SIZE + length) {
+				break;
+			}
+
+			processFrame((FrameType) header[3], header[4],
+				readUint32(header + 5) & 0x7fffffff,
+				pos + FRAME_HEADER_SIZE, length);
+			pos += FRAME_HEADER_SIZE + length;
+		}
+
+		if (state == ACTIVE) {
+			// Save the remaining partial frame, if any.
+			string remaining(pos, end - pos);
+			inputBuffer.swap(remaining);
+		}
+	}
+
+	/**
+	 * Closes all streams and detaches the session from its hooks.
+	 * Idempotent.
+	 */
+	void shutdown() {
+		if (state == SHUT_DOWN) {
+			return;
+		}
+
+		SessionRefGuard guard(this);
+		state = SHUT_DOWN;
+		while (!streams.empty()) {
+			closeStream(streams.begin()->second);
+		}
+		hooks = NULL;
+		inputBuffer.clear();
+		headerBlock.clear();
+	}
+
+	void ref() {
+		refcount++;
+	}
+
+	void unref() {
+		assert(refcount > 0);
+		refcount--;
+		if (refcount == 0) {
+			delete this;
+		}
+	}
+
+	State getState() const {
+		return state;
+	}
+
+	unsigned int getStreamCount() const {
+		return streams.size();
+	}
+
+	Json::Value inspectStateAsJson() const {
+		Json::Value doc;
+		switch (state) {
+		case WAITING_FOR_PREFACE:
+			doc["state"] = "WAITING_FOR_PREFACE";
+			break;
+		case ACTIVE:
+			doc["state"] = "ACTIVE";
+			break;
+		case SHUT_DOWN:
+			doc["state"] = "SHUT_DOWN";
+			break;
+		}
+		doc["stream_count"] = (Json::UInt) streams.size();
+		doc["last_stream_id"] = (Json::UInt) lastStreamId;
+		doc["total_streams_opened"] = (Json::UInt64) totalStreamsOpened;
+		doc["total_streams_refused"] = (Json::UInt64) totalStreamsRefused;
+		doc["send_window"] = (Json::Int64) sendWindow;
+		doc["hpack_dynamic_table_size"] = (Json::UInt) hpackDecoder.getDynamicTableSize();
+		doc["going_away"] = goingAway;
+		return doc;
+	}
+};
+
+
+} // namespace ServerKit
+} // namespace Passenger
+
+#endif /* _PASSENGER_SERVER_KIT_HTTP2_SESSION_H_ */
@@ -0,0 +1,226 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+// Implementation is in its own file so that we can compile the SIMD variants
+// with target-specific instruction sets while the rest of the code base stays
+// compatible with older CPUs.
+
+#include <ServerKit/HttpCharScanner.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) \
+	&& ((defined(__clang__) && __clang_major__ >= 4) \
+		|| (!defined(__clang__) && defined(__GNUC__) \
+			&& (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+	#define PSG_HTTP_CHAR_SCANNER_X86
+	#include <immintrin.h>
+#endif
+
+namespace Passenger {
+namespace ServerKit {
+
+
+typedef const char *(*ScanFunction)(const char *begin, const char *end);
+
+
+/****** Scalar implementations ******/
+
+static inline bool
+isCommonFieldChar(unsigned char ch) {
+	// Must match the ranges used by skipHeaderFieldCharsSse42().
+	return (ch >= 'a' && ch <= 'z')
+		|| (ch >= 'A' && ch <= 'Z')
+		|| (ch >= '0' && ch <= '9')
+		|| ch == '-' || ch == '.'
+		|| ch == '!' || (ch >= '#' && ch <= '\'')
+		|| ch == '*' || ch == '+'
+		|| ch == '^' || ch == '_' || ch == '`';
+}
+
+static const char *
+findHeaderValueEndScalar(const char *p, const char *end) {
+	while (p < end && *p != '\r' && *p != '\n') {
+		p++;
+	}
+	return p;
+}
+
+static const char *
+skipHeaderFieldCharsScalar(const char *p, const char *end) {
+	while (p < end && isCommonFieldChar((unsigned char) *p)) {
+		p++;
+	}
+	return p;
+}
+
+
+/****** x86 SIMD implementations ******/
+
+#ifdef PSG_HTTP_CHAR_SCANNER_X86
+
+__attribute__((target("sse4.2")))
+static const char *
+findHeaderValueEndSse42(const char *p, const char *end) {
+	const __m128i cr = _mm_set1_epi8('\r');
+	const __m128i lf = _mm_set1_epi8('\n');
+
+	while (end - p >= 16) {
+		__m128i data = _mm_loadu_si128((const __m128i *) p);
+		int mask = _mm_movemask_epi8(_mm_or_si128(
+			_mm_cmpeq_epi8(data, cr),
+			_mm_cmpeq_epi8(data, lf)));
+		if (mask != 0) {
+			return p + __builtin_ctz(mask);
+		}
+		p += 16;
+	}
+	return findHeaderValueEndScalar(p, end);
+}
+
+__attribute__((target("avx2")))
+static const char *
+findHeaderValueEndAvx2(const char *p, const char *end) {
+	const __m256i cr = _mm256_set1_epi8('\r');
+	const __m256i lf = _mm256_set1_epi8('\n');
+
+	while (end - p >= 32) {
+		__m256i data = _mm256_loadu_si256((const __m256i *) p);
+		unsigned int mask = (unsigned int) _mm256_movemask_epi8(_mm256_or_si256(
+			_mm256_cmpeq_epi8(data, cr),
+			_mm256_cmpeq_epi8(data, lf)));
+		if (mask != 0) {
+			return p + __builtin_ctz(mask);
+		}
+		p += 32;
+	}
+	return findHeaderValueEndSse42(p, end);
+}
+
+__attribute__((target("sse4.2")))
+static const char *
+skipHeaderFieldCharsSse42(const char *p, const char *end) {
+	// PCMPESTRI supports at most 8 ranges, which is not enough to cover
+	// all token characters. '|' and '~' are left out because they are rare
+	// in header names; http_parser's state machine handles them anyway.
+	const __m128i ranges = _mm_setr_epi8(
+		'a', 'z', 'A', 'Z', '0', '9', '-', '.',
+		'^', '`', '#', '\'', '*', '+', '!', '!');
+
+	while (end - p >= 16) {
+		__m128i data = _mm_loadu_si128((const __m128i *) p);
+		int index = _mm_cmpestri(ranges, 16, data, 16,
+			_SIDD_UBYTE_OPS | _SIDD_CMP_RANGES
+			| _SIDD_NEGATIVE_POLARITY | _SIDD_LEAST_SIGNIFICANT);
+		if (index != 16) {
+			return p + index;
+		}
+		p += 16;
+	}
+	return skipHeaderFieldCharsScalar(p, end);
+}
+
+#endif /* PSG_HTTP_CHAR_SCANNER_X86 */
+
+
+/****** Dispatching ******/
+
+static ScanFunction findHeaderValueEndFunction = findHeaderValueEndScalar;
+static ScanFunction skipHeaderFieldCharsFunction = skipHeaderFieldCharsScalar;
+static HttpCharScannerLevel currentLevel =
+	httpCharScannerSetLevel(httpCharScannerDetectLevel());
+
+
+const char *
+httpFindHeaderValueEnd(const char *begin, const char *end) {
+	return findHeaderValueEndFunction(begin, end);
+}
+
+const char *
+httpSkipHeaderFieldChars(const char *begin, const char *end) {
+	return skipHeaderFieldCharsFunction(begin, end);
+}
+
+HttpCharScannerLevel
+httpCharScannerDetectLevel() {
+	#ifdef PSG_HTTP_CHAR_SCANNER_X86
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx2")) {
+			return HCS_AVX2;
+		} else if (__builtin_cpu_supports("sse4.2")) {
+			return HCS_SSE42;
+		}
+	#endif
+	return HCS_SCALAR;
+}
+
+HttpCharScannerLevel
+httpCharScannerGetLevel() {
+	return currentLevel;
+}
+
+HttpCharScannerLevel
+httpCharScannerSetLevel(HttpCharScannerLevel level) {
+	HttpCharScannerLevel maxLevel = httpCharScannerDetectLevel();
+	if (level > maxLevel) {
+		level = maxLevel;
+	}
+
+	switch (level) {
+	#ifdef PSG_HTTP_CHAR_SCANNER_X86
+	case HCS_AVX2:
+		findHeaderValueEndFunction = findHeaderValueEndAvx2;
+		skipHeaderFieldCharsFunction = skipHeaderFieldCharsSse42;
+		break;
+	case HCS_SSE42:
+		findHeaderValueEndFunction = findHeaderValueEndSse42;
+		skipHeaderFieldCharsFunction = skipHeaderFieldCharsSse42;
+		break;
+	#endif
+	default:
+		level = HCS_SCALAR;
+		findHeaderValueEndFunction = findHeaderValueEndScalar;
+		skipHeaderFieldCharsFunction = skipHeaderFieldCharsScalar;
+		break;
+	}
+
+	currentLevel = level;
+	return level;
+}
+
+const char *
+httpCharScannerLevelToString(HttpCharScannerLevel level) {
+	switch (level) {
+	case HCS_AVX2:
+		return "avx2";
+	case HCS_SSE42:
+		return "sse4.2";
+	default:
+		return "scalar";
+	}
+}
+
+
+} // namespace ServerKit
+} // namespace Passenger
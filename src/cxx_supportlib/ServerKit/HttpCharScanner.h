@@ -0,0 +1,85 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_SERVER_KIT_HTTP_CHAR_SCANNER_H_
+#define _PASSENGER_SERVER_KIT_HTTP_CHAR_SCANNER_H_
+
+namespace Passenger {
+namespace ServerKit {
+
+
+/**
+ * Vectorized helpers that let http_parser skip over long runs of
+ * uninteresting bytes instead of running its state machine once per byte.
+ *
+ * The best implementation for the current CPU is selected at program startup.
+ * On x86 that is AVX2 or SSE4.2 if the CPU supports it; everywhere else a
+ * scalar implementation is used.
+ */
+enum HttpCharScannerLevel {
+	HCS_SCALAR,
+	HCS_SSE42,
+	HCS_AVX2
+};
+
+/**
+ * Returns a pointer to the first CR or LF in [begin, end), or `end` if there
+ * is none.
+ */
+const char *httpFindHeaderValueEnd(const char *begin, const char *end);
+
+/**
+ * Returns a pointer to the first byte in [begin, end) that is not a common
+ * header field name character (letters, digits and the most frequently
+ * used token punctuation), or `end` if there is none.
+ *
+ * This is a fast pre-filter only: the returned byte may still be a valid
+ * token character that the caller must handle on its own.
+ */
+const char *httpSkipHeaderFieldChars(const char *begin, const char *end);
+
+/**
+ * Returns the highest level that the current CPU supports.
+ */
+HttpCharScannerLevel httpCharScannerDetectLevel();
+
+HttpCharScannerLevel httpCharScannerGetLevel();
+
+/**
+ * Forces the use of a specific implementation. Levels that the CPU does not
+ * support are lowered to the highest supported level. Only meant for use
+ * by tests and benchmarks; this is not thread-safe.
+ *
+ * @return The level that is actually in use.
+ */
+HttpCharScannerLevel httpCharScannerSetLevel(HttpCharScannerLevel level);
+
+const char *httpCharScannerLevelToString(HttpCharScannerLevel level);
+
+
+} // namespace ServerKit
+} // namespace Passenger
+
+#endif /* _PASSENGER_SERVER_KIT_HTTP_CHAR_SCANNER_H_ */
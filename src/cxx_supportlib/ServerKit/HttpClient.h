@@ -34,6 +34,8 @@ namespace Passenger {
 namespace ServerKit {
 
 
+class Http2Session;
+
 template<typename Request = HttpRequest>
 class BaseHttpClient: public BaseClient {
 public:
@@ -48,11 +50,24 @@ public:
 	 */
 	Request *currentRequest;
 	unsigned int requestsBegun;
+	/**
+	 * Non-NULL if this client speaks HTTP/2. In that case, currentRequest
+	 * is NULL and all client data is handled by the session.
+	 */
+	Http2Session *http2Session;
+	/**
+	 * The number of bytes at the start of the connection that matched the
+	 * HTTP/2 connection preface so far, while HTTP/2 is enabled and the
+	 * preface hasn't been fully received yet.
+	 */
+	unsigned int http2PrefaceBytesReceived;
 
 	BaseHttpClient(void *server)
 		: BaseClient(server),
 		  currentRequest(NULL),
-		  requestsBegun(0)
+		  requestsBegun(0),
+		  http2Session(NULL),
+		  http2PrefaceBytesReceived(0)
 		{ }
 };
 
@@ -235,7 +235,6 @@ private:
 
 		psg_lstr_append(&self->state->currentHeader->val, self->pool,
 			*self->currentBuffer, data, len);
-		self->state->hasher.update(data, len);
 
 		return 0;
 	}
@@ -42,6 +42,7 @@
 #include <ServerKit/HttpRequestRef.h>
 #include <ServerKit/HttpHeaderParser.h>
 #include <ServerKit/HttpChunkedBodyParser.h>
+#include <ServerKit/Http2Session.h>
 #include <Algorithms/MovingAverage.h>
 #include <Integrations/LibevJsonUtils.h>
 #include <Utils/SystemTime.h>
@@ -65,11 +66,13 @@ extern const unsigned int DEFAULT_INTERNAL_SERVER_ERROR_RESPONSE_SIZE;
  * (do not edit: following text is automatically generated
  * by 'rake configkit_schemas_inline_comments')
  *
- *   accept_burst_count           unsigned integer   -   default(32)
- *   client_freelist_limit        unsigned integer   -   default(0)
- *   min_spare_clients            unsigned integer   -   default(0)
- *   request_freelist_limit       unsigned integer   -   default(1024)
- *   start_reading_after_accept   boolean            -   default(true)
+ *   accept_burst_count             unsigned integer   -   default(32)
+ *   client_freelist_limit          unsigned integer   -   default(0)
+ *   http2                          boolean            -   default(false)
+ *   http2_max_concurrent_streams   unsigned integer   -   default(100)
+ *   min_spare_clients              unsigned integer   -   default(0)
+ *   request_freelist_limit         unsigned integer   -   default(1024)
+ *   start_reading_after_accept     boolean            -   default(true)
  *
  * END
  */
@@ -79,6 +82,8 @@ private:
 		using namespace ConfigKit;
 
 		add("request_freelist_limit", UINT_TYPE, OPTIONAL, 1024);
+		add("http2", BOOL_TYPE, OPTIONAL, false);
+		add("http2_max_concurrent_streams", UINT_TYPE, OPTIONAL, 100);
 	}
 
 public:
@@ -98,13 +103,19 @@ public:
 
 struct HttpServerConfigRealization {
 	unsigned int requestFreelistLimit;
+	unsigned int http2MaxConcurrentStreams;
+	bool http2;
 
 	HttpServerConfigRealization(const ConfigKit::Store &config)
-		: requestFreelistLimit(config["request_freelist_limit"].asUInt())
+		: requestFreelistLimit(config["request_freelist_limit"].asUInt()),
+		  http2MaxConcurrentStreams(config["http2_max_concurrent_streams"].asUInt()),
+		  http2(config["http2"].asBool())
 		{ }
 
 	void swap(HttpServerConfigRealization &other) BOOST_NOEXCEPT_OR_NOTHROW {
 		std::swap(requestFreelistLimit, other.requestFreelistLimit);
+		std::swap(http2MaxConcurrentStreams, other.http2MaxConcurrentStreams);
+		std::swap(http2, other.http2);
 	}
 };
 
@@ -157,6 +168,31 @@ private:
 
 	friend class RequestHooksImpl;
 
+	class Http2SessionHooksImpl: public Http2SessionHooks {
+	public:
+		virtual void h2_write(Http2Session *session, const MemoryKit::mbuf &buffer) {
+			Client *client = static_cast<Client *>(session->userData);
+			client->output.feed(buffer);
+		}
+
+		virtual bool h2_feedNewClient(Http2Session *session, int fd) {
+			Client *client     = static_cast<Client *>(session->userData);
+			HttpServer *server = static_cast<HttpServer *>(HttpServer::getServerFromClient(client));
+			if (server->serverState == HttpServer::ACTIVE) {
+				server->feedNewClients(&fd, 1);
+				return true;
+			} else {
+				return false;
+			}
+		}
+
+		virtual void h2_disconnect(Http2Session *session) {
+			Client *client     = static_cast<Client *>(session->userData);
+			HttpServer *server = static_cast<HttpServer *>(HttpServer::getServerFromClient(client));
+			server->disconnect(&client);
+		}
+	};
+
 
 	/***** Configuration *****/
 
@@ -166,6 +202,7 @@ private:
 	/***** Working state *****/
 
 	RequestHooksImpl requestHooksImpl;
+	Http2SessionHooksImpl http2SessionHooksImpl;
 	object_pool<HttpHeaderParserState> headerParserStatePool;
 
 
@@ -283,6 +320,7 @@ private:
 
 		P_ASSERT_EQ(req->httpState, Request::WAITING_FOR_REFERENCES);
 		assert(req->pool != NULL);
+		onRequestOutputFlushed(c, req);
 		c->currentRequest = NULL;
 		if (!psg_reset_pool(req->pool, PSG_DEFAULT_POOL_SIZE)) {
 			psg_destroy_pool(req->pool);
@@ -321,6 +359,88 @@ private:
 
 	/***** Client data handling *****/
 
+	bool mayBeHttp2Preface(Client *client, Request *req) const {
+		// Only look at the very first data on the connection, so that
+		// HTTP/1 clients pay nothing more than a few comparisons.
+		return configRlz.http2
+			&& client->requestsBegun == 0
+			&& req->parserState.headerParser->state == HttpHeaderParserState::PARSING_NOT_STARTED;
+	}
+
+	/**
+	 * Switches to HTTP/2 once the full connection preface has been received,
+	 * which may arrive in pieces. Since the preface is constant, the pieces
+	 * received so far aren't buffered; only their size is remembered. If the
+	 * data turns out not to be the preface, then it is handed to the HTTP/1
+	 * parser, including the held back part.
+	 */
+	Channel::Result processClientDataWhenDetectingHttp2(Client *client, Request *req,
+		const MemoryKit::mbuf &buffer, int errcode)
+	{
+		unsigned int received = client->http2PrefaceBytesReceived;
+		size_t len = std::min<size_t>(buffer.size(),
+			HTTP2_CONNECTION_PREFACE_SIZE - received);
+
+		if (len > 0 && memcmp(buffer.start, HTTP2_CONNECTION_PREFACE + received, len) == 0) {
+			if (received + len < HTTP2_CONNECTION_PREFACE_SIZE) {
+				client->http2PrefaceBytesReceived += len;
+				return Channel::Result(len, false);
+			} else {
+				return switchToHttp2(client, req, buffer);
+			}
+		}
+
+		client->http2PrefaceBytesReceived = 0;
+		if (received > 0) {
+			MemoryKit::mbuf prefix(MemoryKit::mbuf_get(&this->getContext()->small_mbuf_pool));
+			memcpy(prefix.start, HTTP2_CONNECTION_PREFACE, received);
+			prefix = MemoryKit::mbuf(prefix, 0, received);
+			Channel::Result result = processClientDataWhenParsingHeaders(client, req,
+				prefix, 0);
+			if (result.end || req->httpState != Request::PARSING_HEADERS) {
+				return Channel::Result(0, result.end);
+			}
+		}
+		return processClientDataWhenParsingHeaders(client, req, buffer, errcode);
+	}
+
+	Channel::Result switchToHttp2(Client *client, Request *req, const MemoryKit::mbuf &buffer) {
+		unsigned int received = client->http2PrefaceBytesReceived;
+
+		SKC_DEBUG(client, "HTTP/2 connection preface received; switching to HTTP/2");
+
+		// HTTP/2 streams are handled by the session, so the client
+		// no longer has a current request.
+		deinitializeRequestAndAddToFreelist(client, req);
+		client->currentRequest = NULL;
+		unrefRequest(req, __FILE__, __LINE__);
+
+		client->http2PrefaceBytesReceived = 0;
+		client->http2Session = new Http2Session(this->getContext(),
+			&http2SessionHooksImpl, configRlz.http2MaxConcurrentStreams);
+		client->http2Session->userData = client;
+		if (received > 0) {
+			client->http2Session->feed(HTTP2_CONNECTION_PREFACE, received);
+		}
+		return processClientDataForHttp2(client, buffer, 0);
+	}
+
+	Channel::Result processClientDataForHttp2(Client *client, const MemoryKit::mbuf &buffer,
+		int errcode)
+	{
+		if (buffer.empty()) {
+			this->disconnect(&client);
+			return Channel::Result(0, true);
+		}
+
+		client->http2Session->feed(buffer.start, buffer.size());
+		if (client->connected()) {
+			return Channel::Result(buffer.size(), false);
+		} else {
+			return Channel::Result(0, true);
+		}
+	}
+
 	Channel::Result processClientDataWhenParsingHeaders(Client *client, Request *req,
 		const MemoryKit::mbuf &buffer, int errcode)
 	{
@@ -767,6 +887,10 @@ protected:
 		int errcode)
 	{
 		SKC_LOG_EVENT(HttpServer, client, "onClientDataReceived");
+		if (client->http2Session != NULL) {
+			return processClientDataForHttp2(client, buffer, errcode);
+		}
+
 		assert(client->currentRequest != NULL);
 		Request *req = client->currentRequest;
 		RequestRef ref(req, __FILE__, __LINE__);
@@ -782,6 +906,9 @@ protected:
 		// Moved outside switch() so that the CPU branch predictor can do its work
 		if (req->httpState == Request::PARSING_HEADERS) {
 			assert(!ended);
+			if (OXT_UNLIKELY(mayBeHttp2Preface(client, req))) {
+				return processClientDataWhenDetectingHttp2(client, req, buffer, errcode);
+			}
 			return processClientDataWhenParsingHeaders(client, req, buffer, errcode);
 		} else {
 			switch (req->bodyType) {
@@ -825,11 +952,19 @@ protected:
 			client->currentRequest = NULL;
 			unrefRequest(req, __FILE__, __LINE__);
 		}
+
+		if (client->http2Session != NULL) {
+			Http2Session *session = client->http2Session;
+			client->http2Session = NULL;
+			session->shutdown();
+			session->unref();
+		}
 	}
 
 	virtual void deinitializeClient(Client *client) {
 		ParentClass::deinitializeClient(client);
 		client->currentRequest = NULL;
+		assert(client->http2Session == NULL);
 	}
 
 	virtual bool shouldDisconnectClientOnShutdown(Client *client) {
@@ -889,6 +1024,16 @@ protected:
 		// Do nothing.
 	}
 
+	/**
+	 * Called when the response of a request that was ended with endRequest()
+	 * has been completely flushed to the client. The request has already
+	 * been deinitialized at this point. Not called if the client disconnects
+	 * before the output is flushed.
+	 */
+	virtual void onRequestOutputFlushed(Client *client, Request *req) {
+		// Do nothing.
+	}
+
 	virtual bool supportsUpgrade(Client *client, Request *req) {
 		return false;
 	}
@@ -906,7 +1051,9 @@ protected:
 	virtual void reinitializeClient(Client *client, int fd) {
 		ParentClass::reinitializeClient(client, fd);
 		client->requestsBegun = 0;
+		client->http2PrefaceBytesReceived = 0;
 		assert(client->currentRequest == NULL);
+		assert(client->http2Session == NULL);
 	}
 
 	virtual void reinitializeRequest(Client *client, Request *req) {
@@ -1277,6 +1424,9 @@ public:
 		}
 		doc["requests_begun"] = client->requestsBegun;
 		doc["lingering_request_count"] = client->lingeringRequestCount;
+		if (client->http2Session != NULL) {
+			doc["http2_session"] = client->http2Session->inspectStateAsJson();
+		}
 		return doc;
 	}
 
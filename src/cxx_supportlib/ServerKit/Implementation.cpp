@@ -38,6 +38,8 @@ extern const HashedStaticString HTTP_X_SENDFILE;
 extern const HashedStaticString HTTP_X_ACCEL_REDIRECT;
 extern const char DEFAULT_INTERNAL_SERVER_ERROR_RESPONSE[];
 extern const unsigned int DEFAULT_INTERNAL_SERVER_ERROR_RESPONSE_SIZE;
+extern const char HTTP2_CONNECTION_PREFACE[];
+extern const unsigned int HTTP2_CONNECTION_PREFACE_SIZE;
 
 const char DEFAULT_INTERNAL_SERVER_ERROR_RESPONSE[] =
 	"Status: 500 Internal Server Error\r\n"
@@ -48,6 +50,9 @@ const char DEFAULT_INTERNAL_SERVER_ERROR_RESPONSE[] =
 	"Internal server error\n";
 const unsigned int DEFAULT_INTERNAL_SERVER_ERROR_RESPONSE_SIZE =
 	sizeof(DEFAULT_INTERNAL_SERVER_ERROR_RESPONSE) - 1;
+const char HTTP2_CONNECTION_PREFACE[] = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+const unsigned int HTTP2_CONNECTION_PREFACE_SIZE =
+	sizeof(HTTP2_CONNECTION_PREFACE) - 1;
 const HashedStaticString HTTP_COOKIE("cookie");
 const HashedStaticString HTTP_SET_COOKIE("set-cookie");
 const HashedStaticString HTTP_CONTENT_LENGTH("content-length");
@@ -31,6 +31,7 @@
 #include <boost/cstdint.hpp>
 #include <boost/config.hpp>
 #include <boost/scoped_ptr.hpp>
+#include <boost/atomic.hpp>
 #include <oxt/system_calls.hpp>
 #include <oxt/backtrace.hpp>
 #include <oxt/macros.hpp>
@@ -301,6 +302,8 @@ public:
 
 private:
 	Context *ctx;
+	/** A copy of `activeClientCount` that other threads may read. */
+	boost::atomic<unsigned int> sharedActiveClientCount;
 	unsigned int nextClientNumber: 28;
 	uint8_t nEndpoints: 3;
 	bool accept4Available: 1;
@@ -365,6 +368,7 @@ private:
 		}
 
 		if (acceptCount > 0) {
+			publishActiveClientCount();
 			SKS_DEBUG(acceptCount << " new client(s) accepted; there are now " <<
 				activeClientCount << " active client(s)");
 		}
@@ -441,15 +445,44 @@ private:
 
 		this->onUpdateStatistics();
 		this->onFinalizeStatisticsUpdate();
+		trimMbufPools();
 
 		timer.repeat = timeToNextMultipleD(5, ev_now(this->getLoop()));
 		timer.again();
 	}
 
+	/**
+	 * Returns spare mbuf_blocks to the OS once they take up more than
+	 * `mbuf_max_spare_memory` bytes, so that a burst of traffic does not
+	 * pin its peak buffer memory forever.
+	 */
+	void trimMbufPools() {
+		trimMbufPool(&ctx->mbuf_pool);
+		trimMbufPool(&ctx->small_mbuf_pool);
+	}
+
+	void trimMbufPool(struct MemoryKit::mbuf_pool *pool) {
+		unsigned int maxFree = ctx->config.mbufMaxSpareMemory
+			/ pool->mbuf_block_chunk_size;
+
+		MemoryKit::mbuf_pool_reclaim_remote_frees(pool);
+		if (pool->nfree_mbuf_blockq > maxFree) {
+			unsigned int count = MemoryKit::mbuf_pool_trim(pool, maxFree);
+			if (count > 0) {
+				SKS_DEBUG("Released " << count << " spare mbuf blocks of "
+					<< pool->mbuf_block_chunk_size << " bytes");
+			}
+		}
+	}
+
 	unsigned int getNextClientNumber() {
 		return nextClientNumber++;
 	}
 
+	void publishActiveClientCount() {
+		sharedActiveClientCount.store(activeClientCount, boost::memory_order_relaxed);
+	}
+
 	Client *checkoutClientObject() {
 		// Try to obtain client object from freelist.
 		if (!STAILQ_EMPTY(&freeClients)) {
@@ -748,6 +781,7 @@ public:
 		  clientAcceptSpeed1m(-1),
 		  clientAcceptSpeed1h(-1),
 		  ctx(context),
+		  sharedActiveClientCount(0),
 		  nextClientNumber(1),
 		  nEndpoints(0),
 		  accept4Available(true)
@@ -866,6 +900,7 @@ public:
 
 		activeClientCount += size;
 		totalClientsAccepted += size;
+		publishActiveClientCount();
 
 		for (unsigned int i = 0; i < size; i++) {
 			client = checkoutClientObject();
@@ -1050,6 +1085,7 @@ public:
 		c->setConnState(ClientType::DISCONNECTED);
 		TAILQ_REMOVE(&activeClients, c, nextClient.activeOrDisconnectedClient);
 		activeClientCount--;
+		publishActiveClientCount();
 		TAILQ_INSERT_HEAD(&disconnectedClients, c, nextClient.activeOrDisconnectedClient);
 		disconnectedClientCount++;
 
@@ -1099,6 +1135,15 @@ public:
 		return ctx->libev->getLoop();
 	}
 
+	/**
+	 * Returns the number of active clients. Unlike `activeClientCount`, this
+	 * may be called from any thread, but the result may be slightly out of date.
+	 */
+	OXT_FORCE_INLINE
+	unsigned int getActiveClientCountFromAnyThread() const {
+		return sharedActiveClientCount.load(boost::memory_order_relaxed);
+	}
+
 	virtual StaticString getServerName() const {
 		return P_STATIC_STRING("Server");
 	}
@@ -22,6 +22,7 @@
  * IN THE SOFTWARE.
  */
 #include <ServerKit/http_parser.h>
+#include <ServerKit/HttpCharScanner.h>
 #include <assert.h>
 #include <stddef.h>
 #include <ctype.h>
@@ -573,6 +574,20 @@ parse_url_char(enum state s, const char ch)
   return s_dead;
 }
 
+/* Returns how far a bulk scan that starts at `p` may look ahead without
+ * crossing `end` or the HTTP_MAX_HEADER_SIZE limit.
+ */
+static inline const char *
+header_scan_limit (const http_parser *parser, const char *p, const char *end)
+{
+  size_t max = (HTTP_MAX_HEADER_SIZE) - parser->nread;
+  if ((size_t) (end - p) > max) {
+    return p + max;
+  } else {
+    return end;
+  }
+}
+
 size_t http_parser_execute (http_parser *parser,
                             const http_parser_settings *settings,
                             const char *data,
@@ -1283,7 +1298,15 @@ size_t http_parser_execute (http_parser *parser,
         if (c) {
           switch (parser->header_state) {
             case h_general:
+            {
+              /* Fast path: skip the rest of the header name in bulk. */
+              const char *start = p + 1;
+              const char *pe = Passenger::ServerKit::httpSkipHeaderFieldChars(
+                start, header_scan_limit(parser, start, data + len));
+              parser->nread += pe - start;
+              p = pe - 1;
               break;
+            }
 
             case h_C:
               parser->index++;
@@ -1492,7 +1515,15 @@ size_t http_parser_execute (http_parser *parser,
 
         switch (parser->header_state) {
           case h_general:
+          {
+            /* Fast path: skip ahead to the CR or LF that ends the value. */
+            const char *start = p + 1;
+            const char *pe = Passenger::ServerKit::httpFindHeaderValueEnd(
+              start, header_scan_limit(parser, start, data + len));
+            parser->nread += pe - start;
+            p = pe - 1;
             break;
+          }
 
           case h_connection:
           case h_transfer_encoding:
@@ -26,6 +26,7 @@
 
 // Implementation is in its own file so that we can enable compiler optimizations for these functions only.
 
+#include <cstring>
 #include <Utils/Hasher.h>
 
 namespace Passenger {
@@ -50,4 +51,131 @@ JenkinsHash::finalize() {
 	return hash;
 }
 
+
+static const boost::uint32_t XXH_PRIME32_1 = 2654435761U;
+static const boost::uint32_t XXH_PRIME32_2 = 2246822519U;
+static const boost::uint32_t XXH_PRIME32_3 = 3266489917U;
+static const boost::uint32_t XXH_PRIME32_4 =  668265263U;
+static const boost::uint32_t XXH_PRIME32_5 =  374761393U;
+
+static inline boost::uint32_t
+xxhRotl(boost::uint32_t x, int r) {
+	return (x << r) | (x >> (32 - r));
+}
+
+/* Assembles the integer byte by byte so that the result is the same on
+ * big-endian machines. Compilers turn this into a single load on x86.
+ */
+static inline boost::uint32_t
+xxhRead32(const unsigned char *p) {
+	return (boost::uint32_t) p[0]
+		| ((boost::uint32_t) p[1] << 8)
+		| ((boost::uint32_t) p[2] << 16)
+		| ((boost::uint32_t) p[3] << 24);
+}
+
+static inline boost::uint32_t
+xxhRound(boost::uint32_t acc, boost::uint32_t input) {
+	acc += input * XXH_PRIME32_2;
+	acc = xxhRotl(acc, 13);
+	acc *= XXH_PRIME32_1;
+	return acc;
+}
+
+static inline const unsigned char *
+xxhConsumeStripes(boost::uint32_t *acc, const unsigned char *p,
+	const unsigned char *end)
+{
+	boost::uint32_t v1 = acc[0];
+	boost::uint32_t v2 = acc[1];
+	boost::uint32_t v3 = acc[2];
+	boost::uint32_t v4 = acc[3];
+
+	while (end - p >= 16) {
+		v1 = xxhRound(v1, xxhRead32(p));
+		v2 = xxhRound(v2, xxhRead32(p + 4));
+		v3 = xxhRound(v3, xxhRead32(p + 8));
+		v4 = xxhRound(v4, xxhRead32(p + 12));
+		p += 16;
+	}
+
+	acc[0] = v1;
+	acc[1] = v2;
+	acc[2] = v3;
+	acc[3] = v4;
+	return p;
+}
+
+void
+XXHash32::reset() {
+	acc[0] = XXH_PRIME32_1 + XXH_PRIME32_2;
+	acc[1] = XXH_PRIME32_2;
+	acc[2] = 0;
+	acc[3] = 0 - XXH_PRIME32_1;
+	totalSize = 0;
+	bufferSize = 0;
+}
+
+void
+XXHash32::update(const char *data, unsigned int size) {
+	const unsigned char *p = (const unsigned char *) data;
+	const unsigned char *end = p + size;
+
+	totalSize += size;
+
+	if (bufferSize + size < 16) {
+		memcpy(buffer + bufferSize, p, size);
+		bufferSize += size;
+		return;
+	}
+
+	if (bufferSize > 0) {
+		unsigned int fill = 16 - bufferSize;
+		memcpy(buffer + bufferSize, p, fill);
+		xxhConsumeStripes(acc, buffer, buffer + 16);
+		p += fill;
+		bufferSize = 0;
+	}
+
+	p = xxhConsumeStripes(acc, p, end);
+
+	if (p < end) {
+		bufferSize = end - p;
+		memcpy(buffer, p, bufferSize);
+	}
+}
+
+boost::uint32_t
+XXHash32::finalize() const {
+	const unsigned char *p = buffer;
+	const unsigned char *end = buffer + bufferSize;
+	boost::uint32_t h;
+
+	if (totalSize >= 16) {
+		h = xxhRotl(acc[0], 1) + xxhRotl(acc[1], 7)
+			+ xxhRotl(acc[2], 12) + xxhRotl(acc[3], 18);
+	} else {
+		h = acc[2] + XXH_PRIME32_5;
+	}
+	h += totalSize;
+
+	while (end - p >= 4) {
+		h += xxhRead32(p) * XXH_PRIME32_3;
+		h = xxhRotl(h, 17) * XXH_PRIME32_4;
+		p += 4;
+	}
+	while (p < end) {
+		h += (*p) * XXH_PRIME32_5;
+		h = xxhRotl(h, 11) * XXH_PRIME32_1;
+		p++;
+	}
+
+	h ^= h >> 15;
+	h *= XXH_PRIME32_2;
+	h ^= h >> 13;
+	h *= XXH_PRIME32_3;
+	h ^= h >> 16;
+	return h;
+}
+
 } // namespace Passenger
@@ -31,9 +31,10 @@
 namespace Passenger {
 
 
-// TODO: use SpookyHash on x86_64
-// TODO: use streaming murmurhash implementation: https://github.com/c9/murmur3
-
+/**
+ * Bob Jenkins's one-at-a-time hash. Processes one byte per step. No longer
+ * used by default, but kept around for comparison in benchmarks.
+ */
 struct JenkinsHash {
 	static const boost::uint32_t EMPTY_STRING_HASH = 0;
 
@@ -51,7 +52,35 @@ struct JenkinsHash {
 	}
 };
 
-typedef JenkinsHash Hasher;
+/**
+ * Streaming implementation of the 32-bit xxHash algorithm
+ * (https://github.com/Cyan4973/xxHash), with seed 0.
+ *
+ * Input is consumed in 16-byte stripes using four independent accumulators,
+ * which the compiler can keep in registers (or vector lanes) in parallel.
+ * Because HTTP header names are hashed incrementally as they arrive from the
+ * network, up to 15 bytes of input are buffered between `update()` calls.
+ * The resulting hash therefore does not depend on how the input was split
+ * up: hashing "foo" and then "bar" yields the same value as hashing "foobar".
+ */
+struct XXHash32 {
+	static const boost::uint32_t EMPTY_STRING_HASH = 0x02CC5D05;
+
+	boost::uint32_t acc[4];
+	boost::uint32_t totalSize;
+	boost::uint32_t bufferSize;
+	unsigned char buffer[16];
+
+	XXHash32() {
+		reset();
+	}
+
+	void update(const char *data, unsigned int size);
+	boost::uint32_t finalize() const;
+	void reset();
+};
+
+typedef XXHash32 Hasher;
 
 
 } // namespace Passenger
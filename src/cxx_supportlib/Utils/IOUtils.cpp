@@ -368,9 +368,9 @@ createUnixServer(const StaticString &filename, unsigned int backlogSize, bool au
 	return fd;
 }
 
-int
-createTcpServer(const char *address, unsigned short port, unsigned int backlogSize,
-	const char *file, unsigned int line)
+static int
+createTcpServerWithOptions(const char *address, unsigned short port, unsigned int backlogSize,
+	bool reusePort, const char *file, unsigned int line)
 {
 	union {
 		struct sockaddr_in v4;
@@ -423,6 +423,19 @@ createTcpServer(const char *address, unsigned short port, unsigned int backlogSi
 	// Ignore SO_REUSEADDR error, it's not fatal.
 
 	FdGuard guard(fd, file, line, true);
+	if (reusePort) {
+		#ifdef SO_REUSEPORT
+			optval = 1;
+			if (syscalls::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT,
+				&optval, sizeof(optval)) == -1)
+			{
+				int e = errno;
+				throw SystemException("Cannot set SO_REUSEPORT on a TCP socket", e);
+			}
+		#else
+			throw RuntimeException("SO_REUSEPORT is not supported on this platform");
+		#endif
+	}
 	if (family == AF_INET) {
 		ret = syscalls::bind(fd, (const struct sockaddr *) &addr.v4, sizeof(struct sockaddr_in));
 	} else {
@@ -454,6 +467,31 @@ createTcpServer(const char *address, unsigned short port, unsigned int backlogSi
 	return fd;
 }
 
+int
+createTcpServer(const char *address, unsigned short port, unsigned int backlogSize,
+	const char *file, unsigned int line)
+{
+	return createTcpServerWithOptions(address, port, backlogSize, false,
+		file, line);
+}
+
+int
+createReusePortTcpServer(const char *address, unsigned short port, unsigned int backlogSize,
+	const char *file, unsigned int line)
+{
+	return createTcpServerWithOptions(address, port, backlogSize, true,
+		file, line);
+}
+
+bool
+reusePortSupported() {
+	#ifdef SO_REUSEPORT
+		return true;
+	#else
+		return false;
+	#endif
+}
+
 int
 connectToServer(const StaticString &address, const char *file, unsigned int line) {
 	TRACE_POINT();
@@ -675,7 +713,7 @@ connectToTcpServer(NTCP_State &state) {
 
 	ret = syscalls::connect(state.fd, state.res->ai_addr, state.res->ai_addrlen);
 	if (ret == -1) {
-		if (errno == EINPROGRESS || errno == EWOULDBLOCK) {
+		if (errno == EINPROGRESS || errno == EALREADY || errno == EWOULDBLOCK) {
 			return false;
 		} else if (errno == EISCONN) {
 			freeaddrinfo(state.res);
@@ -208,6 +208,29 @@ int createTcpServer(const char *address = "0.0.0.0",
 	const char *file = __FILE__,
 	unsigned int line = __LINE__);
 
+/**
+ * Like createTcpServer(), but also sets SO_REUSEPORT on the socket, so that
+ * multiple sockets can be bound to the same address and port. The kernel
+ * then distributes incoming connections among all those sockets.
+ *
+ * @throws SystemException Something went wrong while creating the server socket.
+ * @throws ArgumentException The given address cannot be parsed.
+ * @throws RuntimeException SO_REUSEPORT is not supported on this platform.
+ * @throws boost::thread_interrupted A system call has been interrupted.
+ * @ingroup Support
+ */
+int createReusePortTcpServer(const char *address,
+	unsigned short port,
+	unsigned int backlogSize = 0,
+	const char *file = __FILE__,
+	unsigned int line = __LINE__);
+
+/**
+ * Returns whether the current platform supports SO_REUSEPORT, i.e.
+ * whether createReusePortTcpServer() can work at all.
+ */
+bool reusePortSupported();
+
 /**
  * Connect to a server at the given address in a blocking manner.
  *
@@ -335,7 +358,9 @@ void setupNonBlockingTcpSocket(NTCP_State & restrict_ref state,
 	int port, const char *file, unsigned int line);
 
 /**
- * Connect a TCP socket in non-blocking mode.
+ * Connect a TCP socket in non-blocking mode. May be called again on the same
+ * state structure once the socket has become writable, in order to find out
+ * whether the connection has been established.
  *
  * @param state A state structure.
  * @return True if the socket was successfully connected, false if the socket isn't
@@ -0,0 +1,232 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_LATENCY_HISTOGRAM_H_
+#define _PASSENGER_LATENCY_HISTOGRAM_H_
+
+#include <boost/cstdint.hpp>
+#include <algorithm>
+#include <cstring>
+#include <jsoncpp/json.h>
+#include <Utils/JsonUtils.h>
+
+namespace Passenger {
+
+
+/**
+ * A histogram of durations in microseconds, in the spirit of HdrHistogram.
+ * Values are counted in buckets whose width grows with the magnitude of the
+ * value: every power of two is split into `SUB_BUCKET_COUNT` equally sized
+ * buckets, so any reported value is within 1/16th (6.25%) of the real value,
+ * no matter whether it is 50 microseconds or 50 seconds.
+ *
+ * Recording a value is a handful of integer operations and involves no memory
+ * allocation, so a histogram can be updated for every request. The memory
+ * usage is fixed at about 4 KB per histogram.
+ *
+ * Values larger than `MAX_VALUE` (about 71 minutes) are counted as `MAX_VALUE`.
+ *
+ * This class is not thread-safe. Keep one histogram per thread and `merge()`
+ * them when reporting.
+ */
+class LatencyHistogram {
+public:
+	static const unsigned int SUB_BUCKET_BITS = 4;
+	static const unsigned int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+	static const unsigned int MAX_VALUE_BITS = 32;
+	static const unsigned int BUCKET_COUNT =
+		(MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+	static const boost::uint64_t MAX_VALUE = (((boost::uint64_t) 1) << MAX_VALUE_BITS) - 1;
+
+private:
+	boost::uint64_t counts[BUCKET_COUNT];
+	boost::uint64_t totalCount;
+	boost::uint64_t sum;
+	boost::uint64_t minValue;
+	boost::uint64_t maxValue;
+
+	static unsigned int findMostSignificantBit(boost::uint32_t value) {
+		#if defined(__GNUC__)
+			return 31 - __builtin_clz(value);
+		#else
+			unsigned int result = 0;
+			while (value >>= 1) {
+				result++;
+			}
+			return result;
+		#endif
+	}
+
+public:
+	LatencyHistogram() {
+		reset();
+	}
+
+	/**
+	 * Returns the index of the bucket that `value` is counted in. Values
+	 * smaller than `2 * SUB_BUCKET_COUNT` have a bucket of their own.
+	 */
+	static unsigned int getBucketIndex(boost::uint64_t value) {
+		if (value > MAX_VALUE) {
+			value = MAX_VALUE;
+		}
+		if (value < 2 * SUB_BUCKET_COUNT) {
+			return (unsigned int) value;
+		} else {
+			unsigned int shift = findMostSignificantBit((boost::uint32_t) value)
+				- SUB_BUCKET_BITS;
+			return (shift + 1) * SUB_BUCKET_COUNT
+				+ (unsigned int) (value >> shift) - SUB_BUCKET_COUNT;
+		}
+	}
+
+	/** Returns the smallest value that is counted in the given bucket. */
+	static boost::uint64_t getBucketLowerBound(unsigned int index) {
+		if (index < 2 * SUB_BUCKET_COUNT) {
+			return index;
+		} else {
+			unsigned int shift = index / SUB_BUCKET_COUNT - 1;
+			boost::uint64_t subBucket = index % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT;
+			return subBucket << shift;
+		}
+	}
+
+	/** Returns the largest value that is counted in the given bucket. */
+	static boost::uint64_t getBucketUpperBound(unsigned int index) {
+		if (index + 1 == BUCKET_COUNT) {
+			return MAX_VALUE;
+		} else {
+			return getBucketLowerBound(index + 1) - 1;
+		}
+	}
+
+	void record(boost::uint64_t value) {
+		if (value > MAX_VALUE) {
+			value = MAX_VALUE;
+		}
+		counts[getBucketIndex(value)]++;
+		if (totalCount == 0 || value < minValue) {
+			minValue = value;
+		}
+		if (value > maxValue) {
+			maxValue = value;
+		}
+		totalCount++;
+		sum += value;
+	}
+
+	void merge(const LatencyHistogram &other) {
+		if (other.totalCount == 0) {
+			return;
+		}
+		for (unsigned int i = 0; i < BUCKET_COUNT; i++) {
+			counts[i] += other.counts[i];
+		}
+		if (totalCount == 0 || other.minValue < minValue) {
+			minValue = other.minValue;
+		}
+		if (other.maxValue > maxValue) {
+			maxValue = other.maxValue;
+		}
+		totalCount += other.totalCount;
+		sum += other.sum;
+	}
+
+	void reset() {
+		memset(counts, 0, sizeof(counts));
+		totalCount = 0;
+		sum = 0;
+		minValue = 0;
+		maxValue = 0;
+	}
+
+	boost::uint64_t getCount() const {
+		return totalCount;
+	}
+
+	boost::uint64_t getMin() const {
+		return minValue;
+	}
+
+	boost::uint64_t getMax() const {
+		return maxValue;
+	}
+
+	double getMean() const {
+		if (totalCount == 0) {
+			return 0;
+		} else {
+			return (double) sum / totalCount;
+		}
+	}
+
+	/**
+	 * Returns the value below which `percentile` percent of the recorded
+	 * values fall. The result is the upper bound of the bucket that the
+	 * value was counted in, capped at the largest recorded value, so it
+	 * never underestimates by more than the bucket precision.
+	 */
+	boost::uint64_t getValueAtPercentile(double percentile) const {
+		if (totalCount == 0) {
+			return 0;
+		}
+		if (percentile > 100) {
+			percentile = 100;
+		}
+
+		boost::uint64_t target = (boost::uint64_t) (percentile / 100 * totalCount + 0.5);
+		boost::uint64_t seen = 0;
+		if (target == 0) {
+			target = 1;
+		}
+		for (unsigned int i = 0; i < BUCKET_COUNT; i++) {
+			seen += counts[i];
+			if (seen >= target) {
+				return std::min(getBucketUpperBound(i), maxValue);
+			}
+		}
+		return maxValue;
+	}
+
+	Json::Value inspectAsJson() const {
+		Json::Value doc;
+		doc["count"] = (Json::UInt64) totalCount;
+		if (totalCount > 0) {
+			doc["min"] = durationToJson(minValue);
+			doc["mean"] = durationToJson((unsigned long long) getMean());
+			doc["p50"] = durationToJson(getValueAtPercentile(50));
+			doc["p90"] = durationToJson(getValueAtPercentile(90));
+			doc["p99"] = durationToJson(getValueAtPercentile(99));
+			doc["p99_9"] = durationToJson(getValueAtPercentile(99.9));
+			doc["max"] = durationToJson(maxValue);
+		}
+		return doc;
+	}
+};
+
+
+} // namespace Passenger
+
+#endif /* _PASSENGER_LATENCY_HISTOGRAM_H_ */
@@ -49,17 +49,21 @@
 #endif
 
 #include <sys/types.h>
+#include <sys/stat.h>
 #include <sys/wait.h>
 #include <sys/time.h>
 #include <sys/resource.h>
 #include <unistd.h>
 #include <signal.h>
+#include <fcntl.h>
+#include <cstdio>
 #include <cstdlib>
 #include <cerrno>
 #include <cstring>
 
 #include <StaticString.h>
 #include <Exceptions.h>
+#include <LoggingKit/LoggingKit.h>
 #include <ProcessManagement/Spawn.h>
 #include <FileTools/FileManip.h>
 #include <Utils/ScopeGuard.h>
@@ -196,6 +200,16 @@ private:
 	bool canMeasureRealMemory;
 	string psOutput;
 
+	#ifdef __linux__
+		bool canReadProcFs;
+		bool hasSmapsRollup;
+		long clockTicksPerSecond;
+		long pageSizeInKb;
+		/** Reused between reads so that collecting metrics for many
+		 * processes doesn't allocate for every file. */
+		mutable string procFileBuffer;
+	#endif
+
 	template<typename Collection, typename ConstIterator>
 	ProcessMetricMap parsePsOutput(const string &output, const Collection &allowedPids) const {
 		ProcessMetricMap result;
@@ -261,6 +275,247 @@ private:
 		setpriority(PRIO_PROCESS, getpid(), prio);
 	}
 
+	#ifdef __linux__
+		/**
+		 * Reads the given /proc file into `procFileBuffer` and NUL-terminates
+		 * it. Returns the number of bytes read in `size`, and the file's
+		 * owner in `uid` if it's not NULL.
+		 *
+		 * Returns false if the file does not exist (e.g. because the process
+		 * has exited), if we do not have permission to read it, or if the
+		 * process exited while we were reading it.
+		 *
+		 * @throws SystemException Any other error.
+		 */
+		bool readProcFile(const char *path, size_t &size, uid_t *uid = NULL) const {
+			int fd = syscalls::open(path, O_RDONLY);
+			if (fd == -1) {
+				int e = errno;
+				if (e == ENOENT || e == ESRCH || e == EACCES || e == EPERM) {
+					return false;
+				} else {
+					throw SystemException(string("Cannot open ") + path, e);
+				}
+			}
+
+			FdGuard guard(fd, NULL, 0);
+			if (uid != NULL) {
+				struct stat buf;
+				if (fstat(fd, &buf) == -1) {
+					int e = errno;
+					throw SystemException(string("Cannot stat ") + path, e);
+				}
+				*uid = buf.st_uid;
+			}
+
+			size = 0;
+			if (procFileBuffer.size() < 1024 * 4) {
+				procFileBuffer.resize(1024 * 4);
+			}
+			while (true) {
+				ssize_t ret = syscalls::read(fd, &procFileBuffer[size],
+					procFileBuffer.size() - size);
+				if (ret == -1) {
+					int e = errno;
+					if (e == ESRCH || e == EACCES || e == EPERM) {
+						return false;
+					} else {
+						throw SystemException(string("Cannot read ") + path, e);
+					}
+				} else if (ret == 0) {
+					break;
+				}
+				size += ret;
+				if (size == procFileBuffer.size()) {
+					procFileBuffer.resize(procFileBuffer.size() * 2);
+				}
+			}
+
+			procFileBuffer[size] = '\0';
+			return true;
+		}
+
+		/**
+		 * Parses /proc/<pid>/stat, whose format is:
+		 *
+		 *     pid (comm) state ppid pgrp session tty_nr tpgid flags minflt
+		 *     cminflt majflt cmajflt utime stime cutime cstime priority nice
+		 *     num_threads itrealvalue starttime vsize rss ...
+		 *
+		 * `comm` may contain spaces and parentheses, so we scan from the
+		 * last ')'.
+		 *
+		 * @throws ParseException
+		 */
+		void parseProcStat(const char *data, double uptime, ProcessMetrics &metrics,
+			string &comm) const
+		{
+			const char *commStart = strchr(data, '(');
+			const char *commEnd = strrchr(data, ')');
+			if (commStart == NULL || commEnd == NULL || commEnd < commStart) {
+				throw ParseException();
+			}
+			comm.assign(commStart + 1, commEnd - commStart - 1);
+
+			const char *pos = commEnd + 1;
+			long long utime, stime, starttime;
+			unsigned int i;
+
+			readNextWord(&pos); // state
+			metrics.ppid = (pid_t) readNextWordAsLongLong(&pos);
+			metrics.processGroupId = (pid_t) readNextWordAsLongLong(&pos);
+			for (i = 0; i < 8; i++) {
+				readNextWord(&pos);
+			}
+			utime = readNextWordAsLongLong(&pos);
+			stime = readNextWordAsLongLong(&pos);
+			for (i = 0; i < 6; i++) {
+				readNextWord(&pos);
+			}
+			starttime = readNextWordAsLongLong(&pos);
+			metrics.vmsize = (ssize_t) (readNextWordAsLongLong(&pos) / 1024);
+			metrics.rss = (ssize_t) (readNextWordAsLongLong(&pos) * pageSizeInKb);
+
+			// Same formula as ps's %cpu: CPU time used divided by
+			// the time that the process has been running.
+			double elapsed = uptime - (double) starttime / clockTicksPerSecond;
+			if (elapsed > 0) {
+				metrics.cpu = (boost::uint8_t) (100.0 * (utime + stime)
+					/ clockTicksPerSecond / elapsed);
+			} else {
+				metrics.cpu = 0;
+			}
+		}
+
+		/**
+		 * Parses the totals in /proc/<pid>/smaps_rollup, which is much cheaper
+		 * for the kernel to produce than /proc/<pid>/smaps.
+		 */
+		static void parseSmapsRollup(const char *data, ssize_t &pss,
+			ssize_t &privateDirty, ssize_t &swap)
+		{
+			pss = -1;
+			privateDirty = -1;
+			swap = -1;
+
+			// Skip the line with the address range.
+			if (!skipToNextLine(&data)) {
+				return;
+			}
+			try {
+				while (*data != '\0') {
+					if (startsWith(data, "Pss:")) {
+						readNextWord(&data);
+						pss = readNextWordAsLongLong(&data);
+					} else if (startsWith(data, "Private_Dirty:")) {
+						readNextWord(&data);
+						privateDirty = readNextWordAsLongLong(&data);
+					} else if (startsWith(data, "Swap:")) {
+						readNextWord(&data);
+						swap = readNextWordAsLongLong(&data);
+					}
+					if (!skipToNextLine(&data)) {
+						break;
+					}
+				}
+			} catch (const ParseException &) {
+				pss = -1;
+				privateDirty = -1;
+				swap = -1;
+			}
+		}
+
+		/**
+		 * Collects metrics by reading /proc directly instead of running ps.
+		 * Returns false if /proc could not be read in the way we expect,
+		 * in which case the caller should fall back to ps.
+		 */
+		template<typename Collection, typename ConstIterator>
+		bool collectFromProcFs(const Collection &pids, ProcessMetricMap &result) const {
+			char path[64];
+			string comm;
+			size_t size;
+			double uptime;
+
+			try {
+				if (!readProcFile("/proc/uptime", size)) {
+					return false;
+				}
+				const char *pos = procFileBuffer.c_str();
+				uptime = readNextWordAsDouble(&pos);
+
+				ConstIterator it, end = pids.end();
+				for (it = pids.begin(); it != end; it++) {
+					ProcessMetrics metrics;
+					pid_t pid = *it;
+
+					// /proc/<pid> files are owned by the process's effective UID,
+					// which is what ps reports as well.
+					snprintf(path, sizeof(path), "/proc/%d/stat", (int) pid);
+					if (!readProcFile(path, size, &metrics.uid)) {
+						// The process doesn't exist (anymore).
+						continue;
+					}
+					metrics.pid = pid;
+					parseProcStat(procFileBuffer.c_str(), uptime, metrics, comm);
+
+					snprintf(path, sizeof(path), "/proc/%d/cmdline", (int) pid);
+					if (readProcFile(path, size)) {
+						parseProcCmdline(procFileBuffer.data(), size, metrics.command);
+					}
+					if (metrics.command.empty()) {
+						// Zombie, or the process exited in the mean time.
+						// ps shows the executable name in brackets in this case.
+						metrics.command.reserve(comm.size() + 2);
+						metrics.command.append(1, '[');
+						metrics.command.append(comm);
+						metrics.command.append(1, ']');
+					}
+
+					if (hasSmapsRollup) {
+						snprintf(path, sizeof(path), "/proc/%d/smaps_rollup", (int) pid);
+						if (readProcFile(path, size)) {
+							parseSmapsRollup(procFileBuffer.c_str(), metrics.pss,
+								metrics.privateDirty, metrics.swap);
+						}
+					} else if (canMeasureRealMemory) {
+						measureRealMemory(pid, metrics.pss, metrics.privateDirty,
+							metrics.swap);
+					}
+
+					result[pid] = metrics;
+				}
+			} catch (const ParseException &) {
+				P_WARN("Cannot parse process information in /proc; falling back to 'ps'");
+				result.clear();
+				return false;
+			} catch (const SystemException &e) {
+				P_WARN("Cannot read process information from /proc: " << e.what() <<
+					"; falling back to 'ps'");
+				result.clear();
+				return false;
+			}
+
+			return true;
+		}
+
+		/**
+		 * Turns the NUL-separated contents of /proc/<pid>/cmdline into
+		 * a space-separated string, like ps does.
+		 */
+		static void parseProcCmdline(const char *data, size_t size, string &command) {
+			while (size > 0 && data[size - 1] == '\0') {
+				size--;
+			}
+			command.assign(data, size);
+			for (size_t i = 0; i < size; i++) {
+				if (command[i] == '\0') {
+					command[i] = ' ';
+				}
+			}
+		}
+	#endif
+
 public:
 	ProcessMetricsCollector() {
 		#ifdef __APPLE__
@@ -268,6 +523,12 @@ public:
 		#else
 			canMeasureRealMemory = fileExists("/proc/self/smaps");
 		#endif
+		#ifdef __linux__
+			canReadProcFs = fileExists("/proc/self/stat");
+			hasSmapsRollup = fileExists("/proc/self/smaps_rollup");
+			clockTicksPerSecond = sysconf(_SC_CLK_TCK);
+			pageSizeInKb = sysconf(_SC_PAGESIZE) / 1024;
+		#endif
 	}
 
 	/** Mock 'ps' output, used by unit tests. */
@@ -281,6 +542,11 @@ public:
 	 *
 	 * Returns a map which maps a given PID to its collected metrics.
 	 *
+	 * On Linux, the metrics are read from /proc. Elsewhere, or if /proc
+	 * cannot be read, the 'ps' command is used.
+	 *
+	 * Not thread-safe: a collector reuses internal buffers between calls.
+	 *
 	 * @throws ParseException The ps output cannot be parsed.
 	 * @throws SystemException Error collecting the ps output or error querying memory usage.
 	 */
@@ -290,6 +556,15 @@ public:
 			return ProcessMetricMap();
 		}
 
+		#ifdef __linux__
+			if (canReadProcFs && this->psOutput.empty()) {
+				ProcessMetricMap result;
+				if (collectFromProcFs<Collection, ConstIterator>(pids, result)) {
+					return result;
+				}
+			}
+		#endif
+
 		ConstIterator it;
 		// The list of PIDs must follow -p without a space.
 		// https://groups.google.com/forum/#!topic/phusion-passenger/WKXy61nJBMA
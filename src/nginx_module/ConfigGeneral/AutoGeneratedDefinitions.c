@@ -158,6 +158,14 @@
     offsetof(passenger_main_conf_t, autogenerated.turbocaching),
     NULL
 },
+{
+    ngx_string("passenger_config_handles"),
+    NGX_HTTP_MAIN_CONF | NGX_CONF_FLAG,
+    passenger_conf_set_config_handles,
+    NGX_HTTP_MAIN_CONF_OFFSET,
+    offsetof(passenger_main_conf_t, autogenerated.config_handles),
+    NULL
+},
 {
     ngx_string("passenger_user_switching"),
     NGX_HTTP_MAIN_CONF | NGX_CONF_FLAG,
@@ -100,6 +100,12 @@ set_manifest_autogenerated_global_conf_defaults(manifest_gen_ctx_t *ctx) {
         sizeof("passenger_turbocaching") - 1,
         1);
 
+    add_manifest_options_container_static_default_bool(ctx,
+        ctx->global_config_container,
+        "passenger_config_handles",
+        sizeof("passenger_config_handles") - 1,
+        0);
+
     add_manifest_options_container_static_default_bool(ctx,
         ctx->global_config_container,
         "passenger_user_switching",
@@ -253,6 +253,18 @@ passenger_conf_set_turbocaching(ngx_conf_t *cf, ngx_command_t *cmd, void *conf)
     return ngx_conf_set_flag_slot(cf, cmd, conf);
 }
 
+static char *
+passenger_conf_set_config_handles(ngx_conf_t *cf, ngx_command_t *cmd, void *conf) {
+    passenger_main_conf_t *passenger_conf = conf;
+
+    passenger_conf->autogenerated.config_handles_explicitly_set = 1;
+    record_main_conf_source_location(cf,
+        &passenger_conf->autogenerated.config_handles_source_file,
+        &passenger_conf->autogenerated.config_handles_source_line);
+
+    return ngx_conf_set_flag_slot(cf, cmd, conf);
+}
+
 static char *
 passenger_conf_set_user_switching(ngx_conf_t *cf, ngx_command_t *cmd, void *conf) {
     passenger_main_conf_t *passenger_conf = conf;
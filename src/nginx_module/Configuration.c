@@ -28,6 +28,7 @@
 #include <ngx_config.h>
 #include <ngx_core.h>
 #include <ngx_http.h>
+#include <ngx_md5.h>
 
 #include <sys/types.h>
 #include <pwd.h>
@@ -115,6 +116,10 @@ passenger_init_main_conf(ngx_conf_t *cf, void *conf_pointer)
         conf->autogenerated.show_version_in_header = 1;
     }
 
+    if (conf->autogenerated.config_handles == NGX_CONF_UNSET) {
+        conf->autogenerated.config_handles = 0;
+    }
+
     if (conf->autogenerated.default_user.len == 0) {
         conf->autogenerated.default_user.len  = sizeof(DEFAULT_WEB_APP_USER) - 1;
         conf->autogenerated.default_user.data = (u_char *) DEFAULT_WEB_APP_USER;
@@ -265,6 +270,9 @@ passenger_create_loc_conf(ngx_conf_t *cf)
     conf->options_cache.len   = 0;
     conf->env_vars_cache.data = NULL;
     conf->env_vars_cache.len  = 0;
+    conf->config_handle.data  = NULL;
+    conf->config_handle.len   = 0;
+    conf->config_handle_registered = 0;
 
     return conf;
 }
@@ -276,6 +284,8 @@ serialize_loc_conf_to_headers(ngx_conf_t *cf, passenger_loc_conf_t *conf)
     ngx_keyval_t  *env_vars;
     size_t         unencoded_len;
     u_char        *unencoded_buf;
+    ngx_md5_t      md5;
+    u_char         digest[16];
 
     if (passenger_serialize_autogenerated_loc_conf_to_headers(cf, conf) == 0) {
         return NGX_ERROR;
@@ -341,6 +351,25 @@ serialize_loc_conf_to_headers(ngx_conf_t *cf, passenger_loc_conf_t *conf)
         free(unencoded_buf);
     }
 
+    /* Derive the config handle from the serialized data, so that locations
+     * with the same configuration share a handle, and so that a changed
+     * configuration (e.g. after a reload) results in a different handle.
+     */
+    conf->config_handle.data = ngx_pnalloc(cf->pool, 2 * sizeof(digest));
+    if (conf->config_handle.data == NULL) {
+        ngx_conf_log_error(NGX_LOG_EMERG, cf, 0,
+                           "cannot allocate buffer of %z bytes for config handle",
+                           2 * sizeof(digest));
+        return NGX_ERROR;
+    }
+    ngx_md5_init(&md5);
+    ngx_md5_update(&md5, conf->options_cache.data, conf->options_cache.len);
+    ngx_md5_update(&md5, "\n", 1);
+    ngx_md5_update(&md5, conf->env_vars_cache.data, conf->env_vars_cache.len);
+    ngx_md5_final(digest, &md5);
+    conf->config_handle.len = ngx_hex_dump(conf->config_handle.data,
+        digest, sizeof(digest)) - conf->config_handle.data;
+
     return NGX_OK;
 }
 
@@ -63,6 +63,18 @@ struct passenger_loc_conf_s {
     /** Raw HTTP header data for this location are cached here. */
     ngx_str_t    options_cache;
     ngx_str_t    env_vars_cache;
+
+    /**
+     * Identifies options_cache and env_vars_cache when registered with the
+     * core (see passenger_config_handles). Hex-encoded MD5 of both.
+     */
+    ngx_str_t    config_handle;
+    /**
+     * Whether the core acknowledged the registration of config_handle.
+     * Per worker process, because each worker has its own copy of the
+     * configuration.
+     */
+    ngx_flag_t   config_handle_registered;
 };
 
 #ifndef _PASSENGER_NGINX_MODULE_CONF_STRUCT_TYPEDEFS_H_
@@ -345,8 +345,17 @@ typedef struct {
     ngx_str_t     content_length;
     ngx_str_t     core_password;
     ngx_str_t     remote_port;
+    /* One of the CONFIG_HANDLE_* constants. */
+    ngx_uint_t    config_handle_mode;
 } buffer_construction_state;
 
+/* Send the location's option headers. */
+#define CONFIG_HANDLE_NONE      0
+/* Send the location's option headers and register them under the config handle. */
+#define CONFIG_HANDLE_REGISTER  1
+/* Only send the config handle, the core already knows the option headers. */
+#define CONFIG_HANDLE_USE       2
+
 static ngx_int_t
 prepare_request_buffer_construction(ngx_http_request_t *r, passenger_context_t *context,
     buffer_construction_state *state)
@@ -757,18 +766,36 @@ construct_request_buffer(ngx_http_request_t *r, passenger_loc_conf_t *slcf,
     total_size += state->app_type.len;
     PUSH_STATIC_STR("\r\n");
 
-    if (b != NULL) {
-        b->last = ngx_copy(b->last, slcf->options_cache.data, slcf->options_cache.len);
-    }
-    total_size += slcf->options_cache.len;
-
-    if (slcf->env_vars_cache.data != NULL) {
-        PUSH_STATIC_STR("!~PASSENGER_ENV_VARS: ");
+    if (state->config_handle_mode == CONFIG_HANDLE_USE) {
+        PUSH_STATIC_STR("!~PASSENGER_CONFIG_HANDLE: ");
         if (b != NULL) {
-            b->last = ngx_copy(b->last, slcf->env_vars_cache.data, slcf->env_vars_cache.len);
+            b->last = ngx_copy(b->last, slcf->config_handle.data, slcf->config_handle.len);
         }
-        total_size += slcf->env_vars_cache.len;
+        total_size += slcf->config_handle.len;
         PUSH_STATIC_STR("\r\n");
+    } else {
+        if (state->config_handle_mode == CONFIG_HANDLE_REGISTER) {
+            PUSH_STATIC_STR("!~PASSENGER_REGISTER_CONFIG_HANDLE: ");
+            if (b != NULL) {
+                b->last = ngx_copy(b->last, slcf->config_handle.data, slcf->config_handle.len);
+            }
+            total_size += slcf->config_handle.len;
+            PUSH_STATIC_STR("\r\n");
+        }
+
+        if (b != NULL) {
+            b->last = ngx_copy(b->last, slcf->options_cache.data, slcf->options_cache.len);
+        }
+        total_size += slcf->options_cache.len;
+
+        if (slcf->env_vars_cache.data != NULL) {
+            PUSH_STATIC_STR("!~PASSENGER_ENV_VARS: ");
+            if (b != NULL) {
+                b->last = ngx_copy(b->last, slcf->env_vars_cache.data, slcf->env_vars_cache.len);
+            }
+            total_size += slcf->env_vars_cache.len;
+            PUSH_STATIC_STR("\r\n");
+        }
     }
 
     /* D = Dechunk response
@@ -791,13 +818,42 @@ construct_request_buffer(ngx_http_request_t *r, passenger_loc_conf_t *slcf,
     #undef PUSH_STATIC_STR
 }
 
+static ngx_buf_t *
+create_request_header_buffer(ngx_http_request_t *r, passenger_loc_conf_t *slcf,
+    passenger_context_t *context)
+{
+    buffer_construction_state      state;
+    ngx_uint_t                     request_size;
+    ngx_buf_t                     *b;
+
+    if (prepare_request_buffer_construction(r, context, &state) != NGX_OK) {
+        return NULL;
+    }
+    if (!passenger_main_conf.autogenerated.config_handles
+     || slcf->config_handle.data == NULL)
+    {
+        state.config_handle_mode = CONFIG_HANDLE_NONE;
+    } else if (slcf->config_handle_registered) {
+        state.config_handle_mode = CONFIG_HANDLE_USE;
+    } else {
+        state.config_handle_mode = CONFIG_HANDLE_REGISTER;
+    }
+    request_size = construct_request_buffer(r, slcf, context, &state, NULL);
+
+    b = ngx_create_temp_buf(r->pool, request_size);
+    if (b == NULL) {
+        return NULL;
+    }
+
+    construct_request_buffer(r, slcf, context, &state, b);
+    return b;
+}
+
 static ngx_int_t
 create_request(ngx_http_request_t *r)
 {
     passenger_loc_conf_t          *slcf;
     passenger_context_t           *context;
-    buffer_construction_state      state;
-    ngx_uint_t                     request_size;
     ngx_buf_t                     *b;
     ngx_chain_t                   *cl, *body;
 
@@ -809,12 +865,7 @@ create_request(ngx_http_request_t *r)
 
     /* Construct and pass request headers */
 
-    if (prepare_request_buffer_construction(r, context, &state) != NGX_OK) {
-        return NGX_ERROR;
-    }
-    request_size = construct_request_buffer(r, slcf, context, &state, NULL);
-
-    b = ngx_create_temp_buf(r->pool, request_size);
+    b = create_request_header_buffer(r, slcf, context);
     if (b == NULL) {
         return NGX_ERROR;
     }
@@ -824,8 +875,6 @@ create_request(ngx_http_request_t *r)
     }
     cl->buf = b;
 
-    construct_request_buffer(r, slcf, context, &state, b);
-
     /* Pass request body */
 
     body = r->upstream->request_bufs;
@@ -859,7 +908,10 @@ create_request(ngx_http_request_t *r)
 static ngx_int_t
 reinit_request(ngx_http_request_t *r)
 {
-    passenger_context_t  *context;
+    passenger_loc_conf_t  *slcf;
+    passenger_context_t   *context;
+    ngx_chain_t           *cl;
+    ngx_buf_t             *b;
 
     context = ngx_http_get_module_ctx(r, ngx_http_passenger_module);
 
@@ -867,6 +919,24 @@ reinit_request(ngx_http_request_t *r)
         return NGX_OK;
     }
 
+    slcf = ngx_http_get_module_loc_conf(r, ngx_http_passenger_module);
+    cl = r->upstream->request_bufs;
+    if (context->config_handle_retried
+     && !slcf->config_handle_registered
+     && cl != NULL)
+    {
+        /* The core did not know our config handle, so the request we sent
+         * only contained the handle. Resend it with the option headers.
+         * The first buffer in the chain contains the request headers.
+         */
+        b = create_request_header_buffer(r, slcf, context);
+        if (b == NULL) {
+            return NGX_ERROR;
+        }
+        b->flush = cl->buf->flush;
+        cl->buf = b;
+    }
+
     context->status = 0;
     context->status_count = 0;
     context->status_start = NULL;
@@ -1146,6 +1216,62 @@ done:
 }
 
 
+/**
+ * The core did not process the request because it did not know our config
+ * handle. Arrange for the request to be resent once, with the option headers
+ * (see reinit_request()), so that the client doesn't see the core's 503.
+ *
+ * The resend is done by Nginx's "next upstream" mechanism, which normally
+ * doesn't apply here: the core is a single peer, for which the round-robin
+ * balancer allows no further tries, and the location's next upstream
+ * conditions may not cover this case. So we release the peer ourselves and
+ * use a per-request copy of the upstream configuration.
+ *
+ * Returns NGX_DECLINED if the request cannot be resent, in which case the
+ * core's response is passed to the client.
+ */
+static ngx_int_t
+prepare_config_handle_retry(ngx_http_request_t *r)
+{
+    ngx_http_upstream_t       *u;
+    ngx_http_upstream_conf_t  *conf;
+    passenger_context_t       *context;
+
+    u = r->upstream;
+    context = ngx_http_get_module_ctx(r, ngx_http_passenger_module);
+    if (context == NULL
+     || context->config_handle_retried
+     || r->request_body_no_buffering)
+    {
+        return NGX_DECLINED;
+    }
+
+    conf = ngx_palloc(r->pool, sizeof(ngx_http_upstream_conf_t));
+    if (conf == NULL) {
+        return NGX_ERROR;
+    }
+    ngx_memcpy(conf, u->conf, sizeof(ngx_http_upstream_conf_t));
+    conf->next_upstream |= NGX_HTTP_UPSTREAM_FT_INVALID_HEADER;
+#ifdef NGX_HTTP_UPSTREAM_FT_NON_IDEMPOTENT
+    conf->next_upstream |= NGX_HTTP_UPSTREAM_FT_NON_IDEMPOTENT;
+#endif
+    conf->next_upstream_timeout = 0;
+    u->conf = conf;
+
+    if (u->peer.sockaddr) {
+        u->peer.free(&u->peer, u->peer.data, 0);
+        u->peer.sockaddr = NULL;
+    }
+    u->peer.tries = 1;
+
+    context->config_handle_retried = 1;
+    ngx_log_debug0(NGX_LOG_DEBUG_HTTP, r->connection->log, 0,
+                   "Passenger core does not know the config handle, "
+                   "resending request with options");
+    return NGX_OK;
+}
+
+
 static ngx_int_t
 process_header(ngx_http_request_t *r)
 {
@@ -1156,6 +1282,7 @@ process_header(ngx_http_request_t *r)
     ngx_http_upstream_header_t     *hh;
     ngx_http_upstream_main_conf_t  *umcf;
     ngx_http_core_loc_conf_t       *clcf;
+    passenger_loc_conf_t           *slcf;
 
     umcf = ngx_http_get_module_main_conf(r, ngx_http_upstream_module);
     clcf = ngx_http_get_module_loc_conf(r, ngx_http_core_module);
@@ -1168,6 +1295,34 @@ process_header(ngx_http_request_t *r)
 
             /* a header line has been parsed successfully */
 
+            if ((size_t) (r->header_name_end - r->header_name_start)
+                    == sizeof("X-Passenger-Config-Handle") - 1
+             && ngx_strncasecmp(r->header_name_start,
+                    (u_char *) "X-Passenger-Config-Handle",
+                    sizeof("X-Passenger-Config-Handle") - 1) == 0)
+            {
+                /* The core tells us whether it knows our config handle
+                 * ("registered") or not ("retry", e.g. because it was
+                 * restarted). This header is not meant for the client.
+                 */
+                slcf = ngx_http_get_module_loc_conf(r, ngx_http_passenger_module);
+                slcf->config_handle_registered =
+                    (size_t) (r->header_end - r->header_start) == sizeof("registered") - 1
+                    && ngx_strncmp(r->header_start, "registered",
+                        sizeof("registered") - 1) == 0;
+                if ((size_t) (r->header_end - r->header_start) == sizeof("retry") - 1
+                 && ngx_strncmp(r->header_start, "retry", sizeof("retry") - 1) == 0)
+                {
+                    rc = prepare_config_handle_retry(r);
+                    if (rc == NGX_OK) {
+                        return NGX_HTTP_UPSTREAM_INVALID_HEADER;
+                    } else if (rc == NGX_ERROR) {
+                        return NGX_ERROR;
+                    }
+                }
+                continue;
+            }
+
             h = ngx_list_push(&r->upstream->headers_in.headers);
             if (h == NULL) {
                 return NGX_ERROR;
@@ -48,6 +48,11 @@ typedef struct {
 
     /** The application's type. */
     PassengerAppType app_type;
+
+    /** Whether the request has been resent with the location's option
+     * headers because the core did not know our config handle.
+     */
+    unsigned    config_handle_retried: 1;
 } passenger_context_t;
 
 
@@ -62,6 +62,7 @@ passenger_create_autogenerated_main_conf(passenger_autogenerated_main_conf_t *co
     conf->instance_registry_dir.data = NULL;
     conf->instance_registry_dir.len  = 0;
     conf->turbocaching = NGX_CONF_UNSET;
+    conf->config_handles = NGX_CONF_UNSET;
     conf->user_switching = NGX_CONF_UNSET;
     conf->default_user.data = NULL;
     conf->default_user.len  = 0;
@@ -143,6 +144,10 @@ passenger_create_autogenerated_main_conf(passenger_autogenerated_main_conf_t *co
     conf->turbocaching_source_file.len = 0;
     conf->turbocaching_source_line = 0;
     conf->turbocaching_explicitly_set = 0;
+    conf->config_handles_source_file.data = NULL;
+    conf->config_handles_source_file.len = 0;
+    conf->config_handles_source_line = 0;
+    conf->config_handles_explicitly_set = 0;
     conf->user_switching_source_file.data = NULL;
     conf->user_switching_source_file.len = 0;
     conf->user_switching_source_line = 0;
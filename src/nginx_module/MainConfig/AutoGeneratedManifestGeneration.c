@@ -216,6 +216,17 @@ generate_config_manifest_for_autogenerated_main_conf(manifest_gen_ctx_t *ctx, pa
         psg_json_value_set_bool(hierarchy_member, "value",
             conf->autogenerated.turbocaching);
     }
+    if (conf->autogenerated.config_handles_explicitly_set) {
+        option_container = find_or_create_manifest_option_container(ctx,
+            ctx->global_config_container,
+            "passenger_config_handles",
+            sizeof("passenger_config_handles") - 1);
+        hierarchy_member = add_manifest_option_container_hierarchy_member(option_container,
+            &conf->autogenerated.config_handles_source_file,
+            conf->autogenerated.config_handles_source_line);
+        psg_json_value_set_bool(hierarchy_member, "value",
+            conf->autogenerated.config_handles);
+    }
     if (conf->autogenerated.user_switching_explicitly_set) {
         option_container = find_or_create_manifest_option_container(ctx,
             ctx->global_config_container,
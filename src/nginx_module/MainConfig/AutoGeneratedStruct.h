@@ -41,6 +41,7 @@
 typedef struct {
     ngx_flag_t abort_on_startup_error;
     ngx_uint_t app_file_descriptor_ulimit;
+    ngx_flag_t config_handles;
     ngx_uint_t core_file_descriptor_ulimit;
     ngx_array_t *ctl;
     ngx_flag_t disable_security_update_check;
@@ -75,6 +76,7 @@ typedef struct {
     ngx_str_t admin_panel_url_source_file;
     ngx_str_t admin_panel_username_source_file;
     ngx_str_t app_file_descriptor_ulimit_source_file;
+    ngx_str_t config_handles_source_file;
     ngx_str_t core_file_descriptor_ulimit_source_file;
     ngx_str_t ctl_source_file;
     ngx_str_t data_buffer_dir_source_file;
@@ -105,6 +107,7 @@ typedef struct {
     ngx_uint_t admin_panel_url_source_line;
     ngx_uint_t admin_panel_username_source_line;
     ngx_uint_t app_file_descriptor_ulimit_source_line;
+    ngx_uint_t config_handles_source_line;
     ngx_uint_t core_file_descriptor_ulimit_source_line;
     ngx_uint_t ctl_source_line;
     ngx_uint_t data_buffer_dir_source_line;
@@ -135,6 +138,7 @@ typedef struct {
     ngx_int_t admin_panel_url_explicitly_set;
     ngx_int_t admin_panel_username_explicitly_set;
     ngx_int_t app_file_descriptor_ulimit_explicitly_set;
+    ngx_int_t config_handles_explicitly_set;
     ngx_int_t core_file_descriptor_ulimit_explicitly_set;
     ngx_int_t ctl_explicitly_set;
     ngx_int_t data_buffer_dir_explicitly_set;
@@ -265,6 +265,13 @@
     :default   => 0,
     :desc      => 'The maximum number of simultaneously alive application instances a single application may occupy.'
   },
+  {
+    :name      => 'PassengerCoreKeepAlive',
+    :type      => :flag,
+    :context   => :global,
+    :default   => true,
+    :desc      => "Whether to reuse connections to the #{PROGRAM_NAME} core across requests."
+  },
   {
     :name      => 'PassengerAdminPanelUrl',
     :type      => :string,
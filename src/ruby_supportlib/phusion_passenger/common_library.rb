@@ -337,10 +337,18 @@ def locate_source_file(path)
     :source   => 'ServerKit/http_parser.cpp',
     :category => :other,
     :optimize => :very_heavy
+  define_component 'ServerKit/HttpCharScanner.o',
+    :source   => 'ServerKit/HttpCharScanner.cpp',
+    :category => :other,
+    :optimize => :very_heavy
   define_component 'ServerKit/Implementation.o',
     :source   => 'ServerKit/Implementation.cpp',
     :category => :other,
     :optimize => true
+  define_component 'ServerKit/Hpack.o',
+    :source   => 'ServerKit/Hpack.cpp',
+    :category => :other,
+    :optimize => true
   define_component 'DataStructures/LString.o',
     :source   => 'DataStructures/LString.cpp',
     :category => :other
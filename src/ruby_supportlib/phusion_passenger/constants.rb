@@ -58,12 +58,23 @@ module SharedConstants
     DEFAULT_WEB_APP_USER = "nobody"
     DEFAULT_APP_ENV = "production"
     DEFAULT_SPAWN_METHOD = "smart"
+    # Number of processes that a single application group may spawn at the same time.
+    DEFAULT_SPAWN_CONCURRENCY = 1
+    # Upper bound on the number of processes that the entire pool may spawn at the same
+    # time through parallel spawning, so that scaling up many apps at once doesn't
+    # overload the host.
+    DEFAULT_MAX_SPAWN_CONCURRENCY = 4
     # Apache's unixd.h also defines DEFAULT_USER, so we avoid naming clash here.
     PASSENGER_DEFAULT_USER = "nobody"
     DEFAULT_CONCURRENCY_MODEL = "process"
     DEFAULT_STICKY_SESSIONS_COOKIE_NAME = "_passenger_route"
     DEFAULT_APP_THREAD_COUNT = 1
     DEFAULT_RESPONSE_BUFFER_HIGH_WATERMARK = 1024 * 1024 * 128
+    # gzip level for responses compressed by the core (1 = fastest, 9 = smallest).
+    DEFAULT_RESPONSE_COMPRESSION_LEVEL = 6
+    # Response bodies with a Content-Length below this size are not compressed,
+    # because the gzip header and trailer would eat most of the savings.
+    DEFAULT_RESPONSE_COMPRESSION_MIN_SIZE = 256
     DEFAULT_MAX_REQUEST_QUEUE_SIZE = 100
     DEFAULT_STAT_THROTTLE_RATE = 10
     DEFAULT_ANALYTICS_LOG_USER = DEFAULT_WEB_APP_USER
@@ -80,6 +91,13 @@ module SharedConstants
     # also introduce context switching and smaller transfer writes. The size is picked
     # to balance this out.
     DEFAULT_MBUF_CHUNK_SIZE = 1024 * 4
+    # Free mbufs above this amount (per event loop) are returned to the OS during
+    # periodic maintenance, so that a traffic spike does not pin memory forever.
+    DEFAULT_MBUF_MAX_SPARE_MEMORY = 1024 * 1024 * 64
+    # Reads that are expected to be small (according to the read history of a
+    # channel) go to blocks of this size, so that small responses don't pin
+    # an entire DEFAULT_MBUF_CHUNK_SIZE block while they're being buffered.
+    DEFAULT_SMALL_MBUF_CHUNK_SIZE = 1024
     # Affects input and output buffering (between app and client). Threshold is picked
     # such that it fits most output (i.e. html page size, not assets), and allows for
     # high concurrency with low mem overhead. On the upload side there is a penalty
@@ -91,6 +109,9 @@ module SharedConstants
     # Time limits
     PROCESS_SHUTDOWN_TIMEOUT = 60 # In seconds
     PROCESS_SHUTDOWN_TIMEOUT_DISPLAY = "1 minute"
+    # Predictive autoscaling only shuts down processes that the predicted demand
+    # no longer needs once they have been idle for at least this long.
+    AUTOSCALING_SCALE_DOWN_IDLE_TIME = 10 # In seconds
 
     # Versions
     PASSENGER_VERSION = PhusionPassenger::VERSION_STRING
@@ -224,6 +224,14 @@
     :context  => [:main],
     :struct   => 'NGX_HTTP_MAIN_CONF_OFFSET'
   },
+  {
+    :name     => 'passenger_config_handles',
+    :scope    => :global,
+    :type     => :flag,
+    :default  => false,
+    :context  => [:main],
+    :struct   => 'NGX_HTTP_MAIN_CONF_OFFSET'
+  },
   {
     :name     => 'passenger_user_switching',
     :scope    => :global,
@@ -0,0 +1,118 @@
+#include <TestSupport.h>
+#include <../../src/apache2_module/AppTypeDetectionCache.h>
+#include <Utils/StrIntUtils.h>
+
+using namespace Passenger;
+using namespace Passenger::Apache2Module;
+using namespace std;
+
+namespace tut {
+	struct Apache2Module_AppTypeDetectionCacheTest {
+		AppTypeDetectionCache::Result result;
+
+		Apache2Module_AppTypeDetectionCacheTest() {
+			SystemTime::force(1000);
+		}
+
+		~Apache2Module_AppTypeDetectionCacheTest() {
+			SystemTime::releaseAll();
+		}
+
+		/**
+		 * Returns a key, other than `key`, that maps to the same slot as `key`.
+		 * Found by observing which store evicts `key`, so that the test doesn't
+		 * depend on the number of slots.
+		 */
+		string findCollidingKey(AppTypeDetectionCache &cache, const string &key) {
+			for (unsigned int i = 0; i < 100000; i++) {
+				string other = "/webapps/other" + toString(i);
+				cache.store(key, PAT_RACK, key);
+				cache.store(other, PAT_WSGI, other);
+				if (!cache.lookup(key, result)) {
+					return other;
+				}
+			}
+			fail("No colliding key found");
+			return string();
+		}
+	};
+
+	DEFINE_TEST_GROUP(Apache2Module_AppTypeDetectionCacheTest);
+
+	TEST_METHOD(1) {
+		set_test_name("Looking up a key that was never stored fails");
+		AppTypeDetectionCache cache(10);
+		ensure(!cache.lookup("/webapps/foo", result));
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("Stored results can be looked up until the TTL expires");
+		AppTypeDetectionCache cache(10);
+		cache.store("/webapps/foo", PAT_NODE, "/webapps/foo/app");
+
+		ensure(cache.lookup("/webapps/foo", result));
+		ensure_equals(result.appType, PAT_NODE);
+		ensure_equals(result.appRoot, "/webapps/foo/app");
+
+		SystemTime::force(1009);
+		ensure("(1)", cache.lookup("/webapps/foo", result));
+
+		SystemTime::force(1010);
+		ensure("(2)", !cache.lookup("/webapps/foo", result));
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("Storing a key again replaces its result and resets its expiry time");
+		AppTypeDetectionCache cache(10);
+		cache.store("/webapps/foo", PAT_RACK, "/webapps/foo");
+
+		SystemTime::force(1005);
+		cache.store("/webapps/foo", PAT_NONE, "");
+		ensure(cache.lookup("/webapps/foo", result));
+		ensure_equals(result.appType, PAT_NONE);
+		ensure_equals(result.appRoot, "");
+
+		SystemTime::force(1014);
+		ensure("(1)", cache.lookup("/webapps/foo", result));
+		SystemTime::force(1015);
+		ensure("(2)", !cache.lookup("/webapps/foo", result));
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("Storing a key that maps to an occupied slot evicts the previous key");
+		AppTypeDetectionCache cache(10);
+		string key = "/webapps/foo";
+		string other = findCollidingKey(cache, key);
+
+		cache.store(key, PAT_RACK, key);
+		ensure("(1)", cache.lookup(key, result));
+		ensure_equals("(2)", result.appRoot, key);
+		ensure("(3)", !cache.lookup(other, result));
+
+		cache.store(other, PAT_WSGI, other);
+		ensure("(4)", !cache.lookup(key, result));
+		ensure("(5)", cache.lookup(other, result));
+		ensure_equals("(6)", result.appType, PAT_WSGI);
+		ensure_equals("(7)", result.appRoot, other);
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("Keys in different slots don't evict each other");
+		AppTypeDetectionCache cache(10);
+		cache.store("/webapps/foo", PAT_RACK, "/webapps/foo");
+		cache.store("/webapps/bar", PAT_WSGI, "/webapps/bar");
+
+		ensure("(1)", cache.lookup("/webapps/foo", result));
+		ensure_equals("(2)", result.appType, PAT_RACK);
+		ensure("(3)", cache.lookup("/webapps/bar", result));
+		ensure_equals("(4)", result.appType, PAT_WSGI);
+	}
+
+	TEST_METHOD(6) {
+		set_test_name("A TTL of 0 disables the cache");
+		AppTypeDetectionCache cache(0);
+		ensure_equals(cache.getTtl(), 0u);
+		cache.store("/webapps/foo", PAT_RACK, "/webapps/foo");
+		ensure(!cache.lookup("/webapps/foo", result));
+	}
+}
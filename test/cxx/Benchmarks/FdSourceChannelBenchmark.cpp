@@ -0,0 +1,204 @@
+/*
+ * Benchmark for reading app responses with ServerKit::FdSourceChannel.
+ * Compares fixed-size reads (one mbuf_block per read()) against adaptive
+ * read sizing (small mbufs for small reads, readv() for large ones).
+ *
+ * Every request writes a response into a socket pair and reads it
+ * through the same channel object, like a Request's appSource. The fed
+ * buffers are kept until the request is done, as happens when the client
+ * is slower than the app. Per request, it reports:
+ *
+ *  - the number of read()/readv() calls;
+ *  - the bytes wasted: the capacity of all mbuf_blocks that were pinned by
+ *    the response, minus the size of the response.
+ *
+ * Run with: rake test:cxx:benchmarks
+ */
+#include <boost/make_shared.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <vector>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <ev.h>
+#include <uv.h>
+#include <SafeLibev.h>
+#include <ServerKit/Context.h>
+#include <ServerKit/FdSourceChannel.h>
+#include <MemoryKit/mbuf.h>
+#include <Utils/SystemTime.h>
+
+using namespace std;
+using namespace Passenger;
+using namespace Passenger::ServerKit;
+
+namespace {
+
+struct Profile {
+	const char *name;
+	size_t responseSize;
+};
+
+const Profile PROFILES[] = {
+	{ "Small API response", 300 },
+	{ "Redirect with body", 900 },
+	{ "HTML page", 12 * 1024 },
+	{ "Large asset", 256 * 1024 }
+};
+
+struct RequestState: public Hooks {
+	vector<MemoryKit::mbuf> held;
+	size_t bytesRead;
+	bool eof;
+};
+
+Channel::Result
+onData(Channel *channel, const MemoryKit::mbuf &buffer, int errcode) {
+	FdSourceChannel *source = reinterpret_cast<FdSourceChannel *>(channel);
+	RequestState *state = static_cast<RequestState *>(source->getHooks());
+
+	if (buffer.empty()) {
+		if (errcode != 0) {
+			fprintf(stderr, "Read error: %s\n", strerror(errcode));
+			abort();
+		}
+		state->eof = true;
+		return Channel::Result(0, true);
+	} else {
+		state->held.push_back(buffer);
+		state->bytesRead += buffer.size();
+		return Channel::Result(buffer.size(), false);
+	}
+}
+
+size_t
+pinnedCapacity(const vector<MemoryKit::mbuf> &buffers) {
+	set<MemoryKit::mbuf_block *> blocks;
+	size_t result = 0;
+
+	for (unsigned int i = 0; i < buffers.size(); i++) {
+		MemoryKit::mbuf_block *block = buffers[i].mbuf_block;
+		if (blocks.insert(block).second) {
+			result += block->end - block->start;
+		}
+	}
+	return result;
+}
+
+struct Result {
+	double readCalls;
+	double bytesWasted;
+	double usecPerRequest;
+};
+
+Result
+run(Context &ctx, const Profile &profile, bool adaptive, unsigned int iterations) {
+	FdSourceChannel channel(&ctx);
+	RequestState state;
+	string response(profile.responseSize, 'x');
+	unsigned long long totalReadCalls = 0, totalWasted = 0;
+	MonotonicTimeUsec start = 0;
+	const unsigned int warmup = 10;
+
+	state.impl = NULL;
+	state.userData = NULL;
+	channel.setHooks(&state);
+	channel.setDataCallback(onData);
+	channel.adaptiveReadSizing = adaptive;
+
+	for (unsigned int i = 0; i < warmup + iterations; i++) {
+		int fds[2];
+		size_t written = 0;
+
+		if (i == warmup) {
+			totalReadCalls = totalWasted = 0;
+			start = SystemTime::getMonotonicUsec();
+		}
+
+		if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == -1) {
+			perror("socketpair");
+			abort();
+		}
+		fcntl(fds[1], F_SETFL, O_NONBLOCK);
+
+		state.bytesRead = 0;
+		state.eof = false;
+		channel.reinitialize(fds[0]);
+		channel.startReadingInNextTick();
+
+		while (!state.eof) {
+			if (fds[1] != -1) {
+				ssize_t ret = write(fds[1], response.data() + written,
+					response.size() - written);
+				if (ret > 0) {
+					written += ret;
+				} else if (ret == -1 && errno != EAGAIN) {
+					perror("write");
+					abort();
+				}
+				if (written == response.size()) {
+					close(fds[1]);
+					fds[1] = -1;
+				}
+			}
+			ev_run(ctx.libev->getLoop(), EVRUN_ONCE);
+		}
+
+		if (state.bytesRead != response.size()) {
+			fprintf(stderr, "Read %u bytes instead of %u\n",
+				(unsigned int) state.bytesRead, (unsigned int) response.size());
+			abort();
+		}
+		totalReadCalls += channel.getReadCalls();
+		totalWasted += pinnedCapacity(state.held) - state.bytesRead;
+
+		state.held.clear();
+		channel.deinitialize();
+		close(fds[0]);
+	}
+
+	Result result;
+	result.readCalls = (double) totalReadCalls / iterations;
+	result.bytesWasted = (double) totalWasted / iterations;
+	result.usecPerRequest = (double) (SystemTime::getMonotonicUsec() - start) / iterations;
+	return result;
+}
+
+void
+report(const char *name, const Result &result) {
+	printf("  %-10s %8.1f read calls   %9.0f bytes wasted   %8.1f us\n",
+		name, result.readCalls, result.bytesWasted, result.usecPerRequest);
+}
+
+} // anonymous namespace
+
+int
+main() {
+	const unsigned int iterations = 2000;
+	struct ev_loop *loop = ev_loop_new(EVFLAG_AUTO);
+	SafeLibevPtr libev = boost::make_shared<SafeLibev>(loop);
+	uv_loop_t uvLoop;
+	ServerKit::Schema schema;
+	ServerKit::Context ctx(schema);
+
+	uv_loop_init(&uvLoop);
+	libev->setCurrentThread();
+	ctx.libev = libev;
+	ctx.libuv = &uvLoop;
+	ctx.initialize();
+
+	for (unsigned int i = 0; i < sizeof(PROFILES) / sizeof(Profile); i++) {
+		const Profile &profile = PROFILES[i];
+		printf("%s (%u bytes), per request:\n", profile.name,
+			(unsigned int) profile.responseSize);
+		report("fixed", run(ctx, profile, false, iterations));
+		report("adaptive", run(ctx, profile, true, iterations));
+		printf("\n");
+	}
+
+	return 0;
+}
@@ -0,0 +1,103 @@
+#include <TestSupport.h>
+#include <Core/ApplicationPool/DemandEstimator.h>
+#include <Utils/SystemTime.h>
+
+using namespace Passenger;
+using namespace Passenger::ApplicationPool2;
+using namespace std;
+
+namespace tut {
+	struct Core_ApplicationPool_DemandEstimatorTest {
+		DemandEstimator estimator;
+		unsigned long long now;
+		unsigned long long arrivals;
+
+		Core_ApplicationPool_DemandEstimatorTest() {
+			now = 1000000000000ull;
+			arrivals = 0;
+		}
+
+		~Core_ApplicationPool_DemandEstimatorTest() {
+			SystemTime::releaseAll();
+		}
+
+		/**
+		 * Feeds the estimator once per second for the given number of
+		 * seconds, with the given arrival rate and concurrency.
+		 */
+		void feed(unsigned int seconds, unsigned int requestsPerSecond,
+			double concurrency)
+		{
+			for (unsigned int i = 0; i < seconds; i++) {
+				now += 1000000;
+				arrivals += requestsPerSecond;
+				SystemTime::forceAll(now);
+				estimator.update(arrivals, concurrency, now);
+			}
+		}
+	};
+
+	DEFINE_TEST_GROUP(Core_ApplicationPool_DemandEstimatorTest);
+
+	TEST_METHOD(1) {
+		set_test_name("No demand means no processes are needed");
+		ensure_equals("(1)", estimator.processesNeeded(1), 0u);
+		feed(30, 0, 0);
+		ensure_equals("(2)", estimator.getArrivalRate(), 0.0);
+		ensure_equals("(3)", estimator.processesNeeded(1), 0u);
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("It measures the arrival rate");
+		feed(1, 10, 1);
+		ensure_equals("(1)", estimator.getArrivalRate(), -1.0);
+		feed(10, 10, 1);
+		ensure("(2)", estimator.getArrivalRate() > 9.9);
+		ensure("(3)", estimator.getArrivalRate() < 10.1);
+		ensure("(4)", estimator.getLongTermArrivalRate() > 9.9);
+		ensure("(5)", estimator.getLongTermArrivalRate() < 10.1);
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("Under steady demand, the prediction covers the concurrency");
+		feed(120, 10, 3);
+		ensure("(1)", estimator.getAverageConcurrency() > 2.99);
+		ensure("(2)", estimator.getConcurrencyStddev() < 0.01);
+		ensure_equals("(3)", estimator.processesNeeded(1), 3u);
+		ensure_equals("(4)", estimator.processesNeeded(2), 2u);
+		ensure_equals("(5)", estimator.processesNeeded(0), 1u);
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("A growing arrival rate causes more processes to be predicted"
+			" before the concurrency has caught up");
+		feed(300, 10, 2);
+		unsigned int steady = estimator.processesNeeded(1);
+		feed(3, 30, 2);
+		ensure("(1)", estimator.getGrowthFactor() > 2);
+		ensure("(2)", estimator.getGrowthFactor() <= DemandEstimator::MAX_GROWTH_FACTOR);
+		ensure("(3)", estimator.processesNeeded(1) > steady);
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("After a burst, the prediction goes down gradually");
+		feed(120, 10, 8);
+		ensure_equals("(1)", estimator.processesNeeded(1), 8u);
+
+		feed(5, 0, 0);
+		unsigned int afterFiveSeconds = estimator.processesNeeded(1);
+		ensure("(2)", afterFiveSeconds > 1);
+		ensure("(3)", afterFiveSeconds < 8 + 8);
+
+		feed(600, 0, 0);
+		ensure_equals("(4)", estimator.processesNeeded(1), 0u);
+	}
+
+	TEST_METHOD(6) {
+		set_test_name("The current concurrency is always covered");
+		feed(120, 1, 0);
+		feed(1, 1, 5);
+		ensure("(1)", estimator.getPredictedConcurrency() >= 5);
+		ensure("(2)", estimator.processesNeeded(1) >= 5u);
+	}
+}
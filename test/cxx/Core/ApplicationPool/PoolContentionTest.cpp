@@ -0,0 +1,160 @@
+#include <TestSupport.h>
+#include <Core/ApplicationPool/Pool.h>
+#include <LoggingKit/Context.h>
+#include <Utils/StrIntUtils.h>
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include <vector>
+
+using namespace std;
+using namespace Passenger;
+using namespace Passenger::ApplicationPool2;
+
+/*
+ * Drives many threads through Pool::get() and Session::close() at the same
+ * time, in order to check that the session checkout/checkin fast paths keep
+ * the pool's accounting intact.
+ */
+namespace tut {
+	struct Core_ApplicationPool_PoolContentionTest {
+		SpawningKit::Context::Schema skContextSchema;
+		SpawningKit::Context::DebugSupport skDebugSupport;
+		SpawningKit::Context skContext;
+		Context context;
+		PoolPtr pool;
+		vector<string> groupNames;
+		vector<Options> groupOptions;
+
+		Core_ApplicationPool_PoolContentionTest()
+			: skContext(skContextSchema)
+		{
+			skDebugSupport.dummyConcurrency = 0;
+			skContext.resourceLocator = resourceLocator;
+			skContext.integrationMode = "standalone";
+			skContext.debugSupport = &skDebugSupport;
+			skContext.finalize();
+			context.spawningKitFactory = boost::make_shared<SpawningKit::Factory>(&skContext);
+			context.finalize();
+			pool = boost::make_shared<Pool>(&context);
+			pool->initialize();
+			pool->setMax(64);
+
+			Json::Value config;
+			vector<ConfigKit::Error> errors;
+			LoggingKit::ConfigChangeRequest req;
+			config["level"] = "warn";
+
+			if (LoggingKit::context->prepareConfigChange(config, errors, req)) {
+				LoggingKit::context->commitConfigChange(req);
+			} else {
+				P_BUG("Error configuring LoggingKit: " << ConfigKit::toString(errors));
+			}
+		}
+
+		~Core_ApplicationPool_PoolContentionTest() {
+			pool->destroy();
+			pool.reset();
+
+			Json::Value config;
+			vector<ConfigKit::Error> errors;
+			LoggingKit::ConfigChangeRequest req;
+			config["level"] = DEFAULT_LOG_LEVEL_NAME;
+
+			if (LoggingKit::context->prepareConfigChange(config, errors, req)) {
+				LoggingKit::context->commitConfigChange(req);
+			} else {
+				P_BUG("Error configuring LoggingKit: " << ConfigKit::toString(errors));
+			}
+		}
+
+		Options createOptions(const string &groupName) {
+			Options options;
+			options.spawnMethod = "dummy";
+			options.appRoot = "stub/rack";
+			options.appGroupName = groupName;
+			options.startCommand = "ruby\t" "start.rb";
+			options.startupFile  = "start.rb";
+			options.loadShellEnvvars = false;
+			options.minProcesses = 2;
+			options.statThrottleRate = 60;
+			options.user = testConfig["normal_user_1"].asCString();
+			options.defaultUser = testConfig["default_user"].asCString();
+			options.defaultGroup = testConfig["default_group"].asCString();
+			return options;
+		}
+
+		// Creates `n` groups with 2 processes each.
+		void createGroups(unsigned int n) {
+			groupNames.reserve(n);
+			for (unsigned int i = 0; i < n; i++) {
+				groupNames.push_back("contention-" + toString(i));
+			}
+			for (unsigned int i = 0; i < n; i++) {
+				Ticket ticket;
+				groupOptions.push_back(createOptions(groupNames[i]));
+				SessionPtr session = pool->get(groupOptions.back(), &ticket);
+				session->close(true);
+			}
+			EVENTUALLY(5,
+				result = pool->getProcessCount() == 2 * n;
+			);
+		}
+
+		void worker(unsigned int id, unsigned int iterations) {
+			Ticket ticket;
+			const Options &options = groupOptions[id % groupOptions.size()];
+			for (unsigned int i = 0; i < iterations; i++) {
+				SessionPtr session = pool->get(options, &ticket);
+				session->close(true);
+			}
+		}
+
+		void runWorkers(unsigned int nthreads, unsigned int iterations) {
+			boost::thread_group threads;
+			for (unsigned int i = 0; i < nthreads; i++) {
+				threads.create_thread(boost::bind(
+					&Core_ApplicationPool_PoolContentionTest::worker,
+					this, i, iterations));
+			}
+			threads.join_all();
+		}
+
+		unsigned long long totalProcessed() {
+			PoolLockGuard l(pool->syncher);
+			vector<ProcessPtr> processes = pool->getProcesses(false);
+			unsigned long long result = 0;
+			for (unsigned int i = 0; i < processes.size(); i++) {
+				result += processes[i]->processed;
+			}
+			return result;
+		}
+	};
+
+	DEFINE_TEST_GROUP(Core_ApplicationPool_PoolContentionTest);
+
+	TEST_METHOD(1) {
+		set_test_name("Concurrent get() and close() on many groups keep the accounting consistent");
+
+		createGroups(4);
+		unsigned long long processedBefore = totalProcessed();
+		runWorkers(8, 2000);
+		ensure_equals("All sessions have been accounted for",
+			totalProcessed() - processedBefore, 8u * 2000u);
+
+		PoolLockGuard l(pool->syncher);
+		pool->fullVerifyInvariants();
+		vector<ProcessPtr> processes = pool->getProcesses(false);
+		for (unsigned int i = 0; i < processes.size(); i++) {
+			ensure_equals("(2) sessions", processes[i]->sessions, 0);
+			ensure_equals("(3) busyness", processes[i]->busyness(), 0);
+		}
+		GroupMap::ConstIterator g_it(pool->groups);
+		while (*g_it != NULL) {
+			const GroupPtr &group = g_it.getValue();
+			ensure_equals("(4) nEnabledProcessesTotallyBusy",
+				group->nEnabledProcessesTotallyBusy, 0);
+			ensure("(5) getWaitlist", group->getWaitlist.empty());
+			g_it.next();
+		}
+	}
+}
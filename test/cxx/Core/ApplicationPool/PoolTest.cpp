@@ -235,7 +235,7 @@ namespace tut {
 		// as the new process is done spawning.
 		Options options = createOptions();
 
-		ScopedLock l(pool->syncher);
+		PoolScopedLock l(pool->syncher);
 		pool->asyncGet(options, callback, false);
 		ensure_equals("(1)", number, 0);
 		ensure("(2)", pool->getWaitlist.empty());
@@ -270,7 +270,7 @@ namespace tut {
 		ensure(!process->isTotallyBusy());
 
 		// Verify test assertion.
-		ScopedLock l(pool->syncher);
+		PoolScopedLock l(pool->syncher);
 		pool->asyncGet(options, callback, false);
 		ensure_equals("callback is immediately called", number, 2);
 	}
@@ -391,7 +391,7 @@ namespace tut {
 
 		// Now open another session. It should complete immediately
 		// and should not use the first process.
-		ScopedLock l(pool->syncher);
+		PoolScopedLock l(pool->syncher);
 		pool->asyncGet(options, callback, false);
 		ensure_equals("asyncGet() completed immediately", number, 2);
 		SessionPtr session2 = currentSession;
@@ -424,7 +424,7 @@ namespace tut {
 		pool->setMax(2);
 		GroupPtr group = pool->findOrCreateGroup(options);
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			group->spawn();
 		}
 		EVENTUALLY(5,
@@ -543,7 +543,7 @@ namespace tut {
 		);
 
 		// The next asyncGet() should spawn a new process and the action should be queued.
-		ScopedLock l(pool->syncher);
+		PoolScopedLock l(pool->syncher);
 		skDebugSupport.dummySpawnDelay = 5000000;
 		pool->asyncGet(options, callback, false);
 		ensure(group->spawning());
@@ -844,7 +844,7 @@ namespace tut {
 		SystemTime::force(2);
 		GroupPtr barGroup = pool->get(options2, &ticket)->getGroup()->shared_from_this();
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals("(1)", barGroup->spawn(), SR_OK);
 		}
 		debug->debugger->recv("Begin spawn loop iteration 1");
@@ -867,7 +867,7 @@ namespace tut {
 		debug->messages->send("Proceed with spawn loop iteration 2");
 		debug->debugger->recv("Spawn loop done");
 		EVENTUALLY(5,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			vector<ProcessPtr> processes = pool->getProcesses(false);
 			if (processes.size() == 1) {
 				GroupPtr group = processes[0]->getGroup()->shared_from_this();
@@ -929,7 +929,7 @@ namespace tut {
 		debug->messages->send("Proceed with spawn loop iteration 2");
 		debug->debugger->recv("Spawn loop done");
 		EVENTUALLY(5,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			vector<ProcessPtr> processes = pool->getProcesses(false);
 			if (processes.size() == 1) {
 				GroupPtr group = processes[0]->getGroup()->shared_from_this();
@@ -964,7 +964,7 @@ namespace tut {
 		ProcessPtr process = currentSession->getProcess()->shared_from_this();
 		pool->detachProcess(process);
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure(process->enabled == Process::DETACHED);
 		}
 		EVENTUALLY(5,
@@ -995,13 +995,13 @@ namespace tut {
 		pool->asyncGet(options, callback);
 
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(pool->groups.lookupCopy("test")->getWaitlist.size(), 1u);
 		}
 
 		pool->detachProcess(session1->getProcess()->shared_from_this());
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure(pool->groups.lookupCopy("test")->spawning());
 			ensure_equals(pool->groups.lookupCopy("test")->enabledCount, 0);
 			ensure_equals(pool->groups.lookupCopy("test")->getWaitlist.size(), 1u);
@@ -1033,7 +1033,7 @@ namespace tut {
 		skDebugSupport.dummySpawnDelay = 90000;
 		pool->asyncGet(options2, callback);
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(pool->getWaitlist.size(), 1u);
 		}
 
@@ -1046,7 +1046,7 @@ namespace tut {
 		currentSession.reset();
 		pool->detachProcess(session1->getProcess()->shared_from_this());
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure(pool->groups.lookupCopy("test2") != NULL);
 			ensure_equals(pool->getWaitlist.size(), 0u);
 		}
@@ -1067,7 +1067,7 @@ namespace tut {
 		currentSession.reset();
 		GroupPtr group = process->getGroup()->shared_from_this();
 		pool->detachProcess(process);
-		LockGuard l(pool->syncher);
+		PoolLockGuard l(pool->syncher);
 		ensure_equals(pool->groups.size(), 1u);
 		ensure(group->isAlive());
 		ensure(!group->garbageCollectable());
@@ -1084,18 +1084,18 @@ namespace tut {
 
 		ensure(pool->detachProcess(process));
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(process->enabled, Process::DETACHED);
 		}
 		SHOULD_NEVER_HAPPEN(100,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = !process->isAlive()
 				|| !process->osProcessExists();
 		);
 
 		session.reset();
 		EVENTUALLY(1,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = process->enabled == Process::DETACHED
 				&& !process->osProcessExists()
 				&& process->isDead();
@@ -1115,7 +1115,7 @@ namespace tut {
 
 		ensure(pool->detachProcess(process));
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(process->enabled, Process::DETACHED);
 		}
 		EVENTUALLY(1,
@@ -1123,7 +1123,7 @@ namespace tut {
 		);
 
 		SHOULD_NEVER_HAPPEN(100,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = process->isDead()
 				|| !process->osProcessExists();
 		);
@@ -1132,7 +1132,7 @@ namespace tut {
 		g.clear();
 
 		EVENTUALLY(1,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = process->enabled == Process::DETACHED
 				&& !process->osProcessExists()
 				&& process->isDead();
@@ -1162,7 +1162,7 @@ namespace tut {
 		pool->detachProcess(process);
 		debug->debugger->recv("About to start detached processes checker");
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure(process->enabled == Process::DETACHED);
 		}
 
@@ -1194,7 +1194,7 @@ namespace tut {
 		ensure_equals("Disabling succeeds",
 			pool->disableProcess(processes[0]->getGupid()), DR_SUCCESS);
 
-		LockGuard l(pool->syncher);
+		PoolLockGuard l(pool->syncher);
 		ensure(processes[0]->isAlive());
 		ensure_equals("Process is disabled",
 			processes[0]->enabled,
@@ -1269,7 +1269,7 @@ namespace tut {
 		TempThread thr2(boost::bind(&Core_ApplicationPool_PoolTest::disableProcess,
 			this, process2, &code2));
 		EVENTUALLY(5,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = group->enabledCount == 0
 				&& group->disablingCount == 2
 				&& group->disabledCount == 0;
@@ -1288,7 +1288,7 @@ namespace tut {
 			result = code2 == DR_SUCCESS;
 		);
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(group->enabledCount, 1);
 			ensure_equals(group->disablingCount, 0);
 			ensure_equals(group->disabledCount, 2);
@@ -1316,7 +1316,7 @@ namespace tut {
 			this, session2->getProcess()->shared_from_this(), &code2));
 		EVENTUALLY(2,
 			GroupPtr group = session1->getGroup()->shared_from_this();
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = group->enabledCount == 0
 				&& group->disablingCount == 2
 				&& group->disabledCount == 0;
@@ -1335,7 +1335,7 @@ namespace tut {
 		);
 		{
 			GroupPtr group = session1->getGroup()->shared_from_this();
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(group->enabledCount, 2);
 			ensure_equals(group->disablingCount, 0);
 			ensure_equals(group->disabledCount, 0);
@@ -1394,7 +1394,7 @@ namespace tut {
 		ensure_equals(result, DR_SUCCESS);
 
 		{
-			ScopedLock l(pool->syncher);
+			PoolScopedLock l(pool->syncher);
 			GroupPtr group = processes[0]->getGroup()->shared_from_this();
 			ensure_equals(group->enabledCount, 1);
 			ensure_equals(group->disablingCount, 0);
@@ -1942,7 +1942,7 @@ namespace tut {
 		}
 		ensure_equals(number, 0);
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(group->getWaitlist.size(),
 				3u);
 		}
@@ -2032,6 +2032,337 @@ namespace tut {
 		currentSession.reset();
 	}
 
+	TEST_METHOD(80) {
+		// By default, a group spawns one process at a time.
+		Options options = createOptions();
+		options.minProcesses = 3;
+		skDebugSupport.dummySpawnDelay = 100000;
+		GroupPtr group = pool->findOrCreateGroup(options);
+		{
+			PoolLockGuard l(pool->syncher);
+			group->spawn();
+			ensure_equals((int) group->processesBeingSpawned, 1);
+		}
+		EVENTUALLY(5,
+			result = pool->getProcessCount() == 3;
+		);
+	}
+
+	TEST_METHOD(81) {
+		// If spawnConcurrency > 1, then a group spawns as many processes
+		// in parallel as are needed to satisfy minProcesses.
+		Options options = createOptions();
+		options.minProcesses = 3;
+		options.spawnConcurrency = 4;
+		skDebugSupport.dummySpawnDelay = 100000;
+		GroupPtr group = pool->findOrCreateGroup(options);
+		{
+			PoolLockGuard l(pool->syncher);
+			group->spawn();
+			ensure_equals((int) group->processesBeingSpawned, 3);
+			ensure_equals(group->capacityUsed(), 3u);
+		}
+		EVENTUALLY(5,
+			result = pool->getProcessCount() == 3;
+		);
+		PoolLockGuard l(pool->syncher);
+		ensure(!group->spawning());
+	}
+
+	TEST_METHOD(82) {
+		// Parallel spawning respects the pool-wide spawn concurrency limit.
+		Options options = createOptions();
+		options.minProcesses = 4;
+		options.spawnConcurrency = 4;
+		pool->setMaxSpawnConcurrency(2);
+		skDebugSupport.dummySpawnDelay = 100000;
+		GroupPtr group = pool->findOrCreateGroup(options);
+		{
+			PoolLockGuard l(pool->syncher);
+			group->spawn();
+			ensure_equals((int) group->processesBeingSpawned, 2);
+		}
+		EVENTUALLY(5,
+			result = pool->getProcessCount() == 4;
+		);
+	}
+
+	TEST_METHOD(83) {
+		// Parallel spawning respects the pool's capacity.
+		Options options = createOptions();
+		options.minProcesses = 4;
+		options.spawnConcurrency = 4;
+		pool->setMax(2);
+		skDebugSupport.dummySpawnDelay = 100000;
+		GroupPtr group = pool->findOrCreateGroup(options);
+		{
+			PoolLockGuard l(pool->syncher);
+			group->spawn();
+			ensure_equals((int) group->processesBeingSpawned, 2);
+		}
+		EVENTUALLY(5,
+			result = pool->getProcessCount() == 2;
+		);
+		SHOULD_NEVER_HAPPEN(300,
+			result = pool->getProcessCount() > 2;
+		);
+	}
+
+	TEST_METHOD(84) {
+		// When requests queue up while a process is being spawned, more
+		// processes are spawned in parallel to serve them.
+		Options options = createOptions();
+		options.spawnConcurrency = 4;
+		skDebugSupport.dummySpawnDelay = 1000000;
+		GroupPtr group = pool->findOrCreateGroup(options);
+		PoolScopedLock l(pool->syncher);
+		for (int i = 0; i < 3; i++) {
+			pool->asyncGet(options, callback, false);
+		}
+		ensure_equals(group->getWaitlist.size(), 3u);
+		ensure(group->processesBeingSpawned > 1);
+		l.unlock();
+		EVENTUALLY(5,
+			result = number == 3;
+		);
+	}
+
+	TEST_METHOD(90) {
+		// If one of several parallel spawns fails, then only the get waiters
+		// that the other spawns can't serve are failed.
+		initPoolDebugging();
+		Options options = createOptions();
+		options.spawnConcurrency = 4;
+		GroupPtr group = pool->findOrCreateGroup(options);
+		{
+			PoolScopedLock l(pool->syncher);
+			for (int i = 0; i < 4; i++) {
+				pool->asyncGet(options, callback, false);
+			}
+			ensure_equals("(1)", group->getWaitlist.size(), 4u);
+			ensure_equals("(2)", (int) group->processesBeingSpawned, 3);
+		}
+		debug->debugger->recv("Begin spawn loop iteration 1");
+		debug->debugger->recv("Begin spawn loop iteration 2");
+		debug->debugger->recv("Begin spawn loop iteration 3");
+
+		// The 2 remaining spawns can serve 2 of the 4 get waiters.
+		LoggingKit::setLevel(LoggingKit::CRIT);
+		debug->messages->send("Fail spawn loop iteration 1");
+		EVENTUALLY(5,
+			result = number == 2;
+		);
+		{
+			LockGuard l(syncher);
+			ensure("(3)", currentException != NULL);
+		}
+		SHOULD_NEVER_HAPPEN(100,
+			result = number > 2;
+		);
+
+		debug->messages->send("Proceed with spawn loop iteration 2");
+		debug->messages->send("Proceed with spawn loop iteration 3");
+		EVENTUALLY(5,
+			result = number == 4;
+		);
+		LockGuard l(syncher);
+		ensure("(4)", currentException == NULL);
+		ensure("(5)", currentSession != NULL);
+	}
+
+	TEST_METHOD(86) {
+		// Predictive autoscaling spawns processes ahead of predicted demand,
+		// and the estimator state is visible in the pool status.
+		Options options = createOptions();
+		options.spawnConcurrency = 4;
+		GroupPtr group = pool->findOrCreateGroup(options);
+		{
+			PoolLockGuard l(pool->syncher);
+			group->spawn();
+		}
+		EVENTUALLY(5,
+			result = pool->getProcessCount() == 1;
+		);
+
+		unsigned long long now = SystemTime::getUsec();
+		{
+			PoolLockGuard l(pool->syncher);
+			for (int i = 0; i < 60; i++) {
+				now += 1000000;
+				SystemTime::forceAll(now);
+				group->sessionsOpened += 10;
+				group->demandEstimator.update(group->sessionsOpened, 3, now);
+			}
+			now += 1000000;
+			SystemTime::forceAll(now);
+			group->autoscale(now);
+			ensure("(1)", group->autoscalingTarget >= 3);
+			ensure("(2)", group->spawning());
+		}
+		EVENTUALLY(5,
+			result = pool->getProcessCount() >= 3;
+		);
+
+		pool->enablePredictiveAutoscaling(true);
+		ensure("(3)", containsSubstring(pool->inspect(), "Autoscaling: "));
+		ensure("(4)", containsSubstring(pool->toXml(), "<autoscaling>"));
+		pool->enablePredictiveAutoscaling(false);
+		PoolLockGuard l(pool->syncher);
+		ensure_equals("(5)", group->autoscalingTarget, 0u);
+	}
+
+	TEST_METHOD(87) {
+		// Predictive autoscaling shuts down idle processes that are no
+		// longer needed, one process at a time.
+		Options options = createOptions();
+		options.minProcesses = 3;
+		pool->setMaxIdleTime(30 * 1000000);
+		GroupPtr group = pool->findOrCreateGroup(options);
+		{
+			PoolLockGuard l(pool->syncher);
+			group->spawn();
+		}
+		EVENTUALLY(5,
+			result = pool->getProcessCount() == 3;
+		);
+
+		unsigned long long now = SystemTime::getUsec() + 60 * 60 * 1000000ull;
+		boost::container::vector<Callback> actions;
+		PoolScopedLock l(pool->syncher);
+		group->options.minProcesses = 0;
+		SystemTime::forceAll(now);
+
+		group->autoscale(now);
+		ensure_equals("(1)", group->autoscalingTarget, 0u);
+		ProcessPtr process = group->findProcessToScaleDown(now);
+		ensure("(2)", process != NULL);
+		pool->detachProcessUnlocked(process, actions);
+		ensure_equals("(3)", group->getProcessCount(), 2u);
+
+		// Processes that were used recently are kept.
+		group->enabledProcesses[0]->lastUsed = now;
+		group->enabledProcesses[1]->lastUsed = now;
+		ensure("(4)", group->findProcessToScaleDown(now) == NULL);
+
+		// Processes are kept until they have been idle for the max idle time,
+		// even if that is longer than AUTOSCALING_SCALE_DOWN_IDLE_TIME.
+		now += (AUTOSCALING_SCALE_DOWN_IDLE_TIME + 1) * 1000000ull;
+		ensure("(5)", group->findProcessToScaleDown(now) == NULL);
+
+		// So are processes needed by minProcesses.
+		now += 30 * 1000000ull;
+		group->options.minProcesses = 2;
+		ensure("(6)", group->findProcessToScaleDown(now) == NULL);
+		group->options.minProcesses = 1;
+		ensure("(7)", group->findProcessToScaleDown(now) != NULL);
+
+		// A max idle time of 0 means that idle processes are never shut down.
+		pool->maxIdleTime = 0;
+		ensure("(8)", group->findProcessToScaleDown(now) == NULL);
+
+		l.unlock();
+		Pool::runAllActions(actions);
+	}
+
+	TEST_METHOD(91) {
+		// The autoscaler thread only runs while predictive autoscaling
+		// is enabled.
+		{
+			PoolLockGuard l(pool->syncher);
+			ensure("(1)", !pool->autoscalerRunning);
+		}
+
+		pool->enablePredictiveAutoscaling(true);
+		{
+			PoolLockGuard l(pool->syncher);
+			ensure("(2)", pool->autoscalerRunning);
+		}
+
+		pool->enablePredictiveAutoscaling(false);
+		EVENTUALLY(3,
+			PoolLockGuard l(pool->syncher);
+			result = !pool->autoscalerRunning;
+		);
+	}
+
+	TEST_METHOD(88) {
+		// Status snapshots are reused as long as the pool doesn't change.
+		// Opening and closing sessions only updates the session counters;
+		// the group snapshots are reused.
+		Options options = createOptions();
+		options.appRoot = "/foo";
+		pool->get(options, &ticket);
+		options.appRoot = "/bar";
+		pool->get(options, &ticket);
+		// The thread that handed out the sessions may release its
+		// references to them a little later.
+		EVENTUALLY(5,
+			PoolLockGuard l(pool->syncher);
+			vector<ProcessPtr> processes = pool->getProcesses(false);
+			result = processes.size() == 2
+				&& processes[0]->sessions == 0
+				&& processes[1]->sessions == 0;
+		);
+
+		PoolStatusSnapshotPtr snapshot1 = pool->captureStatusSnapshot();
+		PoolStatusSnapshotPtr snapshot2 = pool->captureStatusSnapshot();
+		ensure("(1)", snapshot1 == snapshot2);
+		ensure_equals("(2)", snapshot1->groups.size(), 2u);
+		ensure_equals("(3)", snapshot1->processCount, 2u);
+
+		options.appRoot = "/foo";
+		SessionPtr session = pool->get(options, &ticket);
+		PoolStatusSnapshotPtr snapshot3 = pool->captureStatusSnapshot();
+		ensure("(4)", snapshot3 != snapshot1);
+		ensure("(5)", snapshot3->version > snapshot1->version);
+		ensure_equals("(6)", snapshot3->groups.size(), 2u);
+		for (unsigned int i = 0; i < snapshot3->groups.size(); i++) {
+			const GroupStatusSnapshotPtr &group = snapshot3->groups[i];
+			ensure("(7)", group == snapshot1->groups[i]);
+			if (group->getName() == "/foo") {
+				ensure_equals("(8)", snapshot3->groupSessions[i][0].sessions, 1);
+			} else {
+				ensure_equals("(9)", snapshot3->groupSessions[i][0].sessions, 0);
+			}
+		}
+
+		session.reset();
+		PoolStatusSnapshotPtr snapshot4 = pool->captureStatusSnapshot();
+		ensure("(10)", snapshot4->version > snapshot3->version);
+		ensure("(11)", containsSubstring(pool->inspect(), "Sessions: 0 "));
+
+		// Detaching a group discards the last snapshot, so that it
+		// doesn't keep the group alive.
+		ensure("(12)", pool->detachGroupByName("/bar"));
+		{
+			PoolLockGuard l(pool->syncher);
+			ensure("(13)", pool->lastStatusSnapshot == NULL);
+		}
+	}
+
+	TEST_METHOD(89) {
+		// toCompactJson() reports the snapshot version, groups and processes.
+		Options options = createOptions();
+		SessionPtr session = pool->get(options, &ticket);
+
+		Json::Value doc;
+		Json::Reader reader;
+		ensure("(1)", reader.parse(pool->toCompactJson(), doc));
+		ensure("(2)", doc["version"].asUInt64() > 0);
+		ensure_equals("(3)", doc["process_count"].asUInt(), 1u);
+		ensure_equals("(4)", doc["groups"].size(), 1u);
+		ensure_equals("(5)", doc["groups"][0]["name"].asString(), "stub/rack");
+		ensure_equals("(6)", doc["groups"][0]["processes"].size(), 1u);
+		ensure_equals("(7)", doc["groups"][0]["processes"][0]["pid"].asInt(),
+			(int) session->getPid());
+		ensure_equals("(8)", doc["groups"][0]["processes"][0]["sessions"].asInt(), 1);
+
+		// Unchanged pool state yields the same version.
+		Json::Value doc2;
+		ensure("(9)", reader.parse(pool->toCompactJson(), doc2));
+		ensure_equals("(10)", doc2["version"].asUInt64(), doc["version"].asUInt64());
+	}
+
 	// TODO: Persistent connections.
 	// TODO: If one closes the session before it has reached EOF, and process's maximum concurrency
 	//       has already been reached, then the pool should ping the process so that it can detect
@@ -231,4 +231,87 @@ namespace tut {
 				&& contents.find("stdout and err 4\n") != string::npos;
 		);
 	}
+
+	TEST_METHOD(6) {
+		set_test_name("warmConnectionPools() pre-establishes connections to sockets "
+			"with unlimited concurrency, and checking them out counts as pool hits");
+		// The warmed up connections are never accepted, so use a
+		// server with a large enough backlog.
+		FileDescriptor server(createTcpServer("127.0.0.1", 0, 16, __FILE__, __LINE__),
+			NULL, 0);
+		struct sockaddr_in addr;
+		socklen_t len = sizeof(addr);
+		getsockname(server, (struct sockaddr *) &addr, &len);
+		sockets.resize(1);
+		sockets[0].address = "tcp://127.0.0.1:" + toString(ntohs(addr.sin_port));
+		sockets[0].concurrency = 0;
+		ProcessPtr process = createProcess();
+		Socket *socket = process->findSocketsAcceptingHttpRequestsAndWithLowestBusyness();
+
+		process->setMinIdleConnections(2);
+		process->warmConnectionPools();
+		ConnectionPoolStats stats = socket->getConnectionPoolStats();
+		ensure_equals("(1)", stats.idleConnections, 2u);
+		ensure_equals("(2)", stats.totalConnections, 2u);
+		ensure_equals("(3)", stats.connects, 2ull);
+
+		Connection connection = socket->checkoutConnection();
+		stats = socket->getConnectionPoolStats();
+		ensure_equals("(4)", stats.idleConnections, 1u);
+		ensure_equals("(5)", stats.hits, 1ull);
+		ensure_equals("(6)", stats.misses, 0ull);
+
+		connection.wantKeepAlive = false;
+		ensure("(7)", socket->checkinConnection(connection));
+		process->warmConnectionPools();
+		stats = socket->getConnectionPoolStats();
+		ensure_equals("(8)", stats.idleConnections, 2u);
+		ensure_equals("(9)", stats.totalConnections, 2u);
+		ensure_equals("(10)", stats.connects, 3ull);
+	}
+
+	TEST_METHOD(7) {
+		set_test_name("warmConnectionPools() does not pre-establish connections to "
+			"sockets with limited concurrency");
+		ProcessPtr process = createProcess();
+		process->setMinIdleConnections(2);
+		process->warmConnectionPools();
+		ConnectionPoolStats stats = process->getSockets()[0].getConnectionPoolStats();
+		ensure_equals(stats.idleConnections, 0u);
+		ensure_equals(stats.totalConnections, 0u);
+	}
+
+	TEST_METHOD(8) {
+		set_test_name("checkoutConnection() discards idle connections that "
+			"were closed by the application");
+		FileDescriptor server(createTcpServer("127.0.0.1", 0, 16, __FILE__, __LINE__),
+			NULL, 0);
+		struct sockaddr_in addr;
+		socklen_t len = sizeof(addr);
+		getsockname(server, (struct sockaddr *) &addr, &len);
+		sockets.resize(1);
+		sockets[0].address = "tcp://127.0.0.1:" + toString(ntohs(addr.sin_port));
+		sockets[0].concurrency = 0;
+		ProcessPtr process = createProcess();
+		Socket *socket = process->findSocketsAcceptingHttpRequestsAndWithLowestBusyness();
+
+		process->setMinIdleConnections(2);
+		process->warmConnectionPools();
+		// Simulate the application closing its idle connections.
+		for (int i = 0; i < 2; i++) {
+			FileDescriptor fd(accept(server, NULL, NULL), __FILE__, __LINE__);
+			ensure("(1)", fd != -1);
+			fd.close();
+		}
+
+		Connection connection = socket->checkoutConnection();
+		ConnectionPoolStats stats = socket->getConnectionPoolStats();
+		ensure_equals("(2)", stats.idleConnections, 0u);
+		ensure_equals("(3)", stats.totalConnections, 1u);
+		ensure_equals("(4)", stats.hits, 0ull);
+		ensure_equals("(5)", stats.misses, 1ull);
+
+		connection.wantKeepAlive = false;
+		socket->checkinConnection(connection);
+	}
 }
@@ -1,8 +1,10 @@
 #include <TestSupport.h>
+#include <zlib.h>
 #include <Constants.h>
 #include <Utils/IOUtils.h>
 #include <Utils/BufferedIO.h>
 #include <Utils/MessageIO.h>
+#include <FileTools/FileManip.h>
 #include <Core/ApplicationPool/TestSession.h>
 #include <Core/Controller.h>
 
@@ -47,6 +49,7 @@ namespace tut {
 		SpawningKit::FactoryPtr spawningKitFactory;
 		ApplicationPool2::Context apContext;
 		PoolPtr appPool;
+		ConfigHandleRegistry configHandleRegistry;
 		Json::Value config, singleAppModeConfig;
 		int serverSocket;
 		TestSession testSession;
@@ -122,6 +125,7 @@ namespace tut {
 				singleAppModeSchema, singleAppModeConfig);
 			controller->resourceLocator = resourceLocator;
 			controller->appPool = appPool;
+			controller->configHandleRegistry = &configHandleRegistry;
 			controller->initialize();
 			controller->listen(serverSocket);
 			startLoop();
@@ -147,12 +151,16 @@ namespace tut {
 			ensure_equals(getTotalBytesConsumed(), totalBytesConsumed + data.size());
 		}
 
-		void useTestSessionObject() {
-			bg.safe->runSync(boost::bind(&Core_ControllerTest::_setTestSessionObject, this));
+		void useTestSessionObject(TestSession *session = NULL) {
+			if (session == NULL) {
+				session = &testSession;
+			}
+			bg.safe->runSync(boost::bind(&Core_ControllerTest::_setTestSessionObject,
+				this, session));
 		}
 
-		void _setTestSessionObject() {
-			controller->sessionToReturn.reset(&testSession, false);
+		void _setTestSessionObject(TestSession *session) {
+			controller->sessionToReturn.reset(session, false);
 		}
 
 		MyController::State getServerState() {
@@ -190,8 +198,12 @@ namespace tut {
 		}
 
 		void sendPeerResponse(const StaticString &data) {
-			writeExact(testSession.peerFd(), data);
-			testSession.closePeerFd();
+			sendPeerResponseTo(&testSession, data);
+		}
+
+		void sendPeerResponseTo(TestSession *session, const StaticString &data) {
+			writeExact(session->peerFd(), data);
+			session->closePeerFd();
 		}
 
 		bool tryDrainPeerConnection() {
@@ -265,9 +277,95 @@ namespace tut {
 		string readResponseBody() {
 			return clientConnectionIO.readAll();
 		}
+
+		unsigned long long getTotalBytesSpliced() {
+			unsigned long long result;
+			bg.safe->runSync(boost::bind(&Core_ControllerTest::_getTotalBytesSpliced,
+				this, &result));
+			return result;
+		}
+
+		void _getTotalBytesSpliced(unsigned long long *result) {
+			*result = controller->inspectStateAsJson()["total_bytes_spliced"]["bytes"].asUInt64();
+		}
+
+		string sendRequestAndFileResponse(const StaticString &request,
+			const StaticString &appResponseHeader, string *header = NULL)
+		{
+			init();
+			useTestSessionObject();
+			testSession.setProtocol("http_session");
+
+			connectToServer();
+			sendRequest(request);
+			waitUntilSessionInitiated();
+			readPeerRequestHeader();
+			sendPeerResponse(appResponseHeader);
+
+			string responseHeader = readResponseHeader();
+			if (header != NULL) {
+				*header = responseHeader;
+			}
+			return readResponseBody();
+		}
+
+		RequestLatencyStatsMap collectLatencyStats() {
+			RequestLatencyStatsMap result;
+			bg.safe->runSync(boost::bind(&MyController::collectLatencyStats,
+				controller, boost::ref(result)));
+			return result;
+		}
+
+		string createLargeBody(unsigned int size) {
+			string body;
+			body.reserve(size);
+			for (unsigned int i = 0; i < size; i++) {
+				body.append(1, (char) ('a' + (i + i / 1000) % 26));
+			}
+			return body;
+		}
+
+		static string dechunk(const string &data) {
+			string result;
+			string::size_type pos = 0;
+
+			while (true) {
+				string::size_type lineEnd = data.find("\r\n", pos);
+				ensure("Chunk header is complete", lineEnd != string::npos);
+				unsigned int size = hexToUint(data.substr(pos, lineEnd - pos));
+				pos = lineEnd + 2;
+				if (size == 0) {
+					return result;
+				}
+				ensure("Chunk is complete", pos + size + 2 <= data.size());
+				result.append(data, pos, size);
+				pos += size + 2;
+			}
+		}
+
+		static string gunzip(const string &data) {
+			z_stream stream;
+			char buf[1024];
+			string result;
+			int ret;
+
+			memset(&stream, 0, sizeof(stream));
+			ensure_equals(inflateInit2(&stream, 15 + 16), Z_OK);
+			stream.next_in = (Bytef *) data.data();
+			stream.avail_in = data.size();
+			do {
+				stream.next_out = (Bytef *) buf;
+				stream.avail_out = sizeof(buf);
+				ret = inflate(&stream, Z_NO_FLUSH);
+				result.append(buf, sizeof(buf) - stream.avail_out);
+			} while (ret == Z_OK);
+			inflateEnd(&stream);
+			ensure_equals("The gzip stream is complete", ret, Z_STREAM_END);
+			return result;
+		}
 	};
 
-	DEFINE_TEST_GROUP(Core_ControllerTest);
+	DEFINE_TEST_GROUP_WITH_LIMIT(Core_ControllerTest, 100);
 
 
 	/***** Passing request information to the app *****/
@@ -311,6 +409,140 @@ namespace tut {
 			"GET /hello?foo=bar HTTP/1.1\r\n"));
 	}
 
+	TEST_METHOD(3) {
+		set_test_name("Session protocol: server software and protocol");
+
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		readPeerRequestHeader();
+		ensure("(1)", containsSubstring(peerRequestHeader,
+			P_STATIC_STRING("\0SERVER_SOFTWARE\0")));
+		ensure("(2)", containsSubstring(peerRequestHeader,
+			P_STATIC_STRING("\0SERVER_PROTOCOL\0HTTP/1.1\0")));
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("Session protocol: environment variables");
+
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"!~: x\r\n"
+			"!~PASSENGER_ENV_VARS: Rk9PAGJhcgA=\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		readPeerRequestHeader();
+		ensure(containsSubstring(peerRequestHeader,
+			P_STATIC_STRING("\0FOO\0bar\0")));
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("Config handles: registering a handle");
+
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"!~: x\r\n"
+			"!~PASSENGER_REGISTER_CONFIG_HANDLE: abc\r\n"
+			"!~PASSENGER_ENV_VARS: Rk9PAGJhcgA=\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		readPeerRequestHeader();
+		ensure("(1)", containsSubstring(peerRequestHeader,
+			P_STATIC_STRING("\0FOO\0bar\0")));
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"Connection: close\r\n"
+			"Content-Length: 5\r\n\r\n"
+			"hello");
+
+		string header = readResponseHeader();
+		ensure("(2)", containsSubstring(header, "X-Passenger-Config-Handle: registered\r\n"));
+		ensure_equals("(3)", readResponseBody(), "hello");
+
+		const ConfigHandleRegistry::Entry *entry = configHandleRegistry.lookup("abc");
+		ensure("(4)", entry != NULL);
+		ensure_equals("(5)", entry->headers.size(), 1u);
+		ensure_equals("(6)", entry->headers[0].name, "!~PASSENGER_ENV_VARS");
+		ensure_equals("(7)", entry->headers[0].value, "Rk9PAGJhcgA=");
+	}
+
+	TEST_METHOD(6) {
+		set_test_name("Config handles: sending only a registered handle");
+
+		ConfigHandleRegistry::HeaderList headers;
+		headers.push_back(make_pair(P_STATIC_STRING("!~PASSENGER_ENV_VARS"),
+			P_STATIC_STRING("Rk9PAGJhcgA=")));
+		configHandleRegistry.add("abc", headers);
+
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"!~: x\r\n"
+			"!~PASSENGER_CONFIG_HANDLE: abc\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		readPeerRequestHeader();
+		ensure("(1)", containsSubstring(peerRequestHeader,
+			P_STATIC_STRING("\0FOO\0bar\0")));
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"Connection: close\r\n"
+			"Content-Length: 5\r\n\r\n"
+			"hello");
+
+		string header = readResponseHeader();
+		ensure("(2)", !containsSubstring(header, "X-Passenger-Config-Handle"));
+	}
+
+	TEST_METHOD(7) {
+		set_test_name("Config handles: sending an unknown handle");
+
+		init();
+
+		LoggingKit::setLevel(LoggingKit::CRIT);
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"!~: x\r\n"
+			"!~PASSENGER_CONFIG_HANDLE: abc\r\n"
+			"\r\n");
+
+		string header = readResponseHeader();
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 503 Service Unavailable\r\n"));
+		ensure("(2)", containsSubstring(header, "X-Passenger-Config-Handle: retry\r\n"));
+		ensure_equals("(3)", testSession.fd(), -1);
+	}
+
 
 	/***** Application response body handling *****/
 
@@ -872,4 +1104,790 @@ namespace tut {
 		string header = readResponseHeader();
 		ensure(containsSubstring(header, "HTTP/1.1 502"));
 	}
+
+
+	/***** Connecting to the application *****/
+
+	TEST_METHOD(50) {
+		set_test_name("If the connection to the application is still in progress,"
+			" then the request header is sent once the connection is established");
+
+		init();
+		useTestSessionObject();
+		testSession.setConnectInProgress(true);
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		unsigned long long timeout = 100000;
+		ensure("The request header is not sent while connecting",
+			!waitUntilReadable(testSession.peerFd(), &timeout));
+
+		testSession.setConnectInProgress(false);
+		readPeerRequestHeader();
+		ensure(containsSubstring(peerRequestHeader,
+			P_STATIC_STRING("REQUEST_URI\0/hello\0")));
+	}
+
+	TEST_METHOD(51) {
+		set_test_name("If the connection to the application cannot be established"
+			" within app_connect_timeout, then the client is disconnected");
+
+		config["app_connect_timeout"] = 100;
+		init();
+		useTestSessionObject();
+		testSession.setConnectInProgress(true);
+		LoggingKit::setLevel(LoggingKit::CRIT);
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+
+		ensure_equals(readResponseBody(), "");
+		waitUntilSessionClosed();
+		ensure(!testSession.isSuccessful());
+	}
+
+
+	/***** Forwarding large response bodies *****/
+
+	TEST_METHOD(60) {
+		set_test_name("Large response bodies with a Content-Length are forwarded with splice()");
+
+		config["response_splice_threshold"] = 1024;
+		init();
+		useTestSessionObject();
+		testSession.setProtocol("http_session");
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		readPeerRequestHeader();
+		string body = createLargeBody(1024 * 1024);
+		string response =
+			"HTTP/1.1 200 OK\r\n"
+			"Content-Type: text/plain\r\n"
+			"Content-Length: " + toString(body.size()) + "\r\n\r\n" +
+			body;
+		// Writing the response may block until we read from the client connection.
+		TempThread writer(boost::bind(&Core_ControllerTest::sendPeerResponse,
+			this, StaticString(response)));
+
+		string header = readResponseHeader();
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		string responseBody = readResponseBody();
+		ensure_equals("(2)", responseBody.size(), body.size());
+		ensure("(3)", responseBody == body);
+		writer.join();
+
+		waitUntilSessionClosed();
+		ensure("(4)", testSession.isSuccessful());
+		ensure("(5)", testSession.wantsKeepAlive());
+		ensure("(6)", getTotalBytesSpliced() > 0);
+	}
+
+	TEST_METHOD(61) {
+		set_test_name("Large response bodies that last until EOF are forwarded with splice()");
+
+		config["response_splice_threshold"] = 1024;
+		init();
+		useTestSessionObject();
+		testSession.setProtocol("http_session");
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		readPeerRequestHeader();
+		string body = createLargeBody(1024 * 1024);
+		string response =
+			"HTTP/1.1 200 OK\r\n"
+			"Content-Type: text/plain\r\n"
+			"Connection: close\r\n\r\n" +
+			body;
+		TempThread writer(boost::bind(&Core_ControllerTest::sendPeerResponse,
+			this, StaticString(response)));
+
+		string header = readResponseHeader();
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		string responseBody = readResponseBody();
+		ensure_equals("(2)", responseBody.size(), body.size());
+		ensure("(3)", responseBody == body);
+		writer.join();
+
+		waitUntilSessionClosed();
+		ensure("(4)", testSession.isSuccessful());
+		ensure("(5)", !testSession.wantsKeepAlive());
+	}
+
+	TEST_METHOD(62) {
+		set_test_name("Response bodies are not spliced if response_splice_threshold is 0");
+
+		config["response_splice_threshold"] = 0;
+		init();
+		useTestSessionObject();
+		testSession.setProtocol("http_session");
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		readPeerRequestHeader();
+		string body = createLargeBody(256 * 1024);
+		string response =
+			"HTTP/1.1 200 OK\r\n"
+			"Content-Type: text/plain\r\n"
+			"Content-Length: " + toString(body.size()) + "\r\n\r\n" +
+			body;
+		TempThread writer(boost::bind(&Core_ControllerTest::sendPeerResponse,
+			this, StaticString(response)));
+
+		readResponseHeader();
+		ensure("(1)", readResponseBody() == body);
+		writer.join();
+
+		waitUntilSessionClosed();
+		ensure("(2)", testSession.isSuccessful());
+		ensure_equals("(3)", getTotalBytesSpliced(), 0ull);
+	}
+
+	TEST_METHOD(63) {
+		set_test_name("Large response bodies are forwarded intact when the request object is reused");
+
+		config["response_splice_threshold"] = 1024;
+		init();
+
+		// A large chunked response, which is never spliced, makes the
+		// app source channel read large amounts at once.
+		TestSession firstSession;
+		firstSession.setProtocol("http_session");
+		useTestSessionObject(&firstSession);
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		EVENTUALLY(5,
+			result = firstSession.fd() != -1;
+		);
+
+		readHeader(firstSession.getPeerBufferedIO());
+		string body = createLargeBody(1024 * 1024);
+		string chunkedBody = integerToHex(body.size()) + "\r\n" +
+			body + "\r\n"
+			"0\r\n\r\n";
+		string response =
+			"HTTP/1.1 200 OK\r\n"
+			"Content-Type: text/plain\r\n"
+			"Transfer-Encoding: chunked\r\n\r\n" +
+			chunkedBody;
+		{
+			TempThread writer(boost::bind(&Core_ControllerTest::sendPeerResponseTo,
+				this, &firstSession, StaticString(response)));
+			readResponseHeader();
+			ensure("(1)", readResponseBody() == chunkedBody);
+			writer.join();
+		}
+		EVENTUALLY(5,
+			result = firstSession.isClosed();
+		);
+
+		// The second request gets the same request object, and thus
+		// the same app source channel.
+		useTestSessionObject();
+		testSession.setProtocol("http_session");
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		readPeerRequestHeader();
+		response =
+			"HTTP/1.1 200 OK\r\n"
+			"Content-Type: text/plain\r\n"
+			"Content-Length: " + toString(body.size()) + "\r\n\r\n" +
+			body;
+		TempThread writer(boost::bind(&Core_ControllerTest::sendPeerResponse,
+			this, StaticString(response)));
+
+		string header = readResponseHeader();
+		ensure("(2)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		string responseBody = readResponseBody();
+		ensure_equals("(3)", responseBody.size(), body.size());
+		ensure("(4)", responseBody == body);
+		writer.join();
+
+		waitUntilSessionClosed();
+		ensure("(5)", testSession.isSuccessful());
+	}
+
+
+	/***** Sending files on behalf of the application *****/
+
+	TEST_METHOD(70) {
+		set_test_name("If sendfile_root is set, then X-Sendfile responses are served by us");
+
+		TempDir tmpDir("tmp.sendfile");
+		createFile("tmp.sendfile/file.txt", "hello world");
+		config["sendfile_root"] = "tmp.sendfile";
+
+		string header;
+		string body = sendRequestAndFileResponse(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n",
+			"HTTP/1.1 200 OK\r\n"
+			"Content-Type: text/plain\r\n"
+			"X-Sendfile: " + absolutizePath("tmp.sendfile/file.txt") + "\r\n"
+			"\r\n",
+			&header);
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		ensure("(2)", containsSubstring(header, "Content-Length: 11\r\n"));
+		ensure("(3)", containsSubstring(header, "Accept-Ranges: bytes\r\n"));
+		ensure("(4)", containsSubstring(header, "Content-Type: text/plain\r\n"));
+		ensure("(5)", !containsSubstring(header, "X-Sendfile"));
+		ensure_equals(body, "hello world");
+		waitUntilSessionClosed();
+		ensure("(6)", testSession.isSuccessful());
+	}
+
+	TEST_METHOD(71) {
+		set_test_name("X-Sendfile responses with a Content-Length allow keep-alive");
+
+		TempDir tmpDir("tmp.sendfile");
+		createFile("tmp.sendfile/file.txt", "hello world");
+		config["sendfile_root"] = "tmp.sendfile";
+		init();
+		useTestSessionObject();
+		testSession.setProtocol("http_session");
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+		readPeerRequestHeader();
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"X-Sendfile: " + absolutizePath("tmp.sendfile/file.txt") + "\r\n"
+			"\r\n");
+
+		string header = readResponseHeader();
+		ensure("(1)", containsSubstring(header, "Content-Length: 11\r\n"));
+		ensure("(2)", !containsSubstring(header, "Connection: close"));
+		char buf[11];
+		ensure_equals(clientConnectionIO.read(buf, sizeof(buf)), 11u);
+		ensure_equals(string(buf, sizeof(buf)), "hello world");
+	}
+
+	TEST_METHOD(72) {
+		set_test_name("X-Accel-Redirect URIs are looked up relative to sendfile_root");
+
+		TempDir tmpDir("tmp.sendfile");
+		makeDirTree("tmp.sendfile/protected");
+		createFile("tmp.sendfile/protected/file.txt", "hello world");
+		config["sendfile_root"] = "tmp.sendfile";
+
+		string header;
+		string body = sendRequestAndFileResponse(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n",
+			"HTTP/1.1 200 OK\r\n"
+			"X-Accel-Redirect: /protected/file.txt?foo=bar\r\n"
+			"\r\n",
+			&header);
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		ensure_equals(body, "hello world");
+	}
+
+	TEST_METHOD(73) {
+		set_test_name("Range requests on X-Sendfile responses are supported");
+
+		TempDir tmpDir("tmp.sendfile");
+		createFile("tmp.sendfile/file.txt", "hello world");
+		config["sendfile_root"] = "tmp.sendfile";
+
+		string header;
+		string body = sendRequestAndFileResponse(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Range: bytes=6-\r\n"
+			"Connection: close\r\n"
+			"\r\n",
+			"HTTP/1.1 200 OK\r\n"
+			"X-Accel-Redirect: /file.txt\r\n"
+			"\r\n",
+			&header);
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 206 Partial Content\r\n"));
+		ensure("(2)", containsSubstring(header, "Content-Range: bytes 6-10/11\r\n"));
+		ensure("(3)", containsSubstring(header, "Content-Length: 5\r\n"));
+		ensure_equals(body, "world");
+	}
+
+	TEST_METHOD(74) {
+		set_test_name("Suffix ranges on X-Sendfile responses are supported");
+
+		TempDir tmpDir("tmp.sendfile");
+		createFile("tmp.sendfile/file.txt", "hello world");
+		config["sendfile_root"] = "tmp.sendfile";
+
+		string header;
+		string body = sendRequestAndFileResponse(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Range: bytes=-3\r\n"
+			"Connection: close\r\n"
+			"\r\n",
+			"HTTP/1.1 200 OK\r\n"
+			"X-Accel-Redirect: /file.txt\r\n"
+			"\r\n",
+			&header);
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 206 Partial Content\r\n"));
+		ensure("(2)", containsSubstring(header, "Content-Range: bytes 8-10/11\r\n"));
+		ensure_equals(body, "rld");
+	}
+
+	TEST_METHOD(75) {
+		set_test_name("Unsatisfiable ranges result in a 416 response");
+
+		TempDir tmpDir("tmp.sendfile");
+		createFile("tmp.sendfile/file.txt", "hello world");
+		config["sendfile_root"] = "tmp.sendfile";
+
+		string header;
+		string body = sendRequestAndFileResponse(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Range: bytes=20-30\r\n"
+			"Connection: close\r\n"
+			"\r\n",
+			"HTTP/1.1 200 OK\r\n"
+			"X-Accel-Redirect: /file.txt\r\n"
+			"\r\n",
+			&header);
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 416 "));
+		ensure("(2)", containsSubstring(header, "Content-Range: bytes */11\r\n"));
+		ensure_equals(body, "");
+	}
+
+	TEST_METHOD(76) {
+		set_test_name("Files outside sendfile_root are not served");
+
+		TempDir tmpDir("tmp.sendfile");
+		makeDirTree("tmp.sendfile/root");
+		createFile("tmp.sendfile/secret.txt", "secret");
+		config["sendfile_root"] = "tmp.sendfile/root";
+		LoggingKit::setLevel(LoggingKit::CRIT);
+
+		string header;
+		string body = sendRequestAndFileResponse(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n",
+			"HTTP/1.1 200 OK\r\n"
+			"X-Accel-Redirect: /../secret.txt\r\n"
+			"\r\n",
+			&header);
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 403 "));
+		ensure("(2)", !containsSubstring(body, "secret"));
+	}
+
+	TEST_METHOD(77) {
+		set_test_name("Nonexistent files result in a 404 response");
+
+		TempDir tmpDir("tmp.sendfile");
+		config["sendfile_root"] = "tmp.sendfile";
+
+		string header;
+		sendRequestAndFileResponse(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n",
+			"HTTP/1.1 200 OK\r\n"
+			"X-Sendfile: " + absolutizePath("tmp.sendfile/nonexistent.txt") + "\r\n"
+			"\r\n",
+			&header);
+		ensure(containsSubstring(header, "HTTP/1.1 404 "));
+	}
+
+	TEST_METHOD(78) {
+		set_test_name("If sendfile_root is not set, then X-Sendfile responses are"
+			" passed through to the web server");
+
+		string header;
+		string body = sendRequestAndFileResponse(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"\r\n",
+			"HTTP/1.1 200 OK\r\n"
+			"X-Sendfile: /etc/passwd\r\n"
+			"\r\n",
+			&header);
+		ensure("(1)", containsSubstring(header, "X-Sendfile: /etc/passwd\r\n"));
+		ensure("(2)", containsSubstring(header, "Connection: close\r\n"));
+		ensure_equals(body, "");
+	}
+
+	TEST_METHOD(79) {
+		set_test_name("Files larger than the socket buffers are sent completely");
+
+		TempDir tmpDir("tmp.sendfile");
+		string contents = createLargeBody(4 * 1024 * 1024);
+		createFile("tmp.sendfile/file.txt", contents);
+		config["sendfile_root"] = "tmp.sendfile";
+
+		string body = sendRequestAndFileResponse(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n",
+			"HTTP/1.1 200 OK\r\n"
+			"X-Accel-Redirect: /file.txt\r\n"
+			"\r\n");
+		ensure_equals("(1)", body.size(), contents.size());
+		ensure("(2)", body == contents);
+		waitUntilSessionClosed();
+		ensure("(3)", testSession.isSuccessful());
+	}
+
+	TEST_METHOD(82) {
+		set_test_name("The app session is released before the file is sent");
+
+		TempDir tmpDir("tmp.sendfile");
+		string contents = createLargeBody(4 * 1024 * 1024);
+		createFile("tmp.sendfile/file.txt", contents);
+		config["sendfile_root"] = "tmp.sendfile";
+		init();
+		useTestSessionObject();
+		testSession.setProtocol("http_session");
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+		readPeerRequestHeader();
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"X-Accel-Redirect: /file.txt\r\n"
+			"\r\n");
+
+		// The client doesn't read the file, so it can't have been
+		// sent completely yet.
+		waitUntilSessionClosed();
+		ensure("(1)", testSession.isSuccessful());
+
+		string header = readResponseHeader();
+		ensure("(2)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		string body = readResponseBody();
+		ensure_equals("(3)", body.size(), contents.size());
+		ensure("(4)", body == contents);
+	}
+
+
+	/***** Latency statistics *****/
+
+	TEST_METHOD(80) {
+		set_test_name("The duration of each request stage is recorded per app group");
+
+		init();
+		useTestSessionObject();
+		testSession.setProtocol("http_session");
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+		readPeerRequestHeader();
+		ensure_equals("(1)", collectLatencyStats().size(), 0u);
+
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"Content-Length: 2\r\n"
+			"\r\n"
+			"ok");
+		ensure("(2)", containsSubstring(readResponseHeader(), "HTTP/1.1 200 OK\r\n"));
+		ensure_equals("(3)", readResponseBody(), "ok");
+
+		RequestLatencyStatsMap stats = collectLatencyStats();
+		ensure_equals("(4)", stats.size(), 1u);
+		const RequestLatencyStats &groupStats = stats.begin()->second;
+		ensure_equals("(5)", groupStats.checkoutWait.getCount(), 1u);
+		ensure_equals("(6)", groupStats.appConnect.getCount(), 1u);
+		ensure_equals("(7)", groupStats.sendHeader.getCount(), 1u);
+		ensure_equals("(8)", groupStats.appProcessing.getCount(), 1u);
+		ensure_equals("(9)", groupStats.responseOutput.getCount(), 1u);
+		ensure_equals("(10)", groupStats.total.getCount(), 1u);
+		ensure("(11)", groupStats.total.getMax() >= groupStats.appProcessing.getMax());
+	}
+
+	TEST_METHOD(81) {
+		set_test_name("Requests that end before the app responds only record the stages they reached");
+
+		init();
+		useTestSessionObject();
+		testSession.setProtocol("http_session");
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+		readPeerRequestHeader();
+		testSession.closePeerFd();
+		readResponseHeader();
+
+		RequestLatencyStatsMap stats = collectLatencyStats();
+		ensure_equals("(1)", stats.size(), 1u);
+		const RequestLatencyStats &groupStats = stats.begin()->second;
+		ensure_equals("(2)", groupStats.checkoutWait.getCount(), 1u);
+		ensure_equals("(3)", groupStats.sendHeader.getCount(), 1u);
+		ensure_equals("(4)", groupStats.appProcessing.getCount(), 0u);
+		ensure_equals("(5)", groupStats.total.getCount(), 0u);
+	}
+
+	TEST_METHOD(83) {
+		set_test_name("The response output stage ends when the response has been flushed to the client");
+
+		// Make sure that the response is buffered instead of spliced.
+		config["response_splice_threshold"] = 0;
+		init();
+		useTestSessionObject();
+		testSession.setProtocol("http_session");
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+		readPeerRequestHeader();
+
+		// The client doesn't read the response yet, so it can't
+		// have been flushed completely.
+		string body = createLargeBody(4 * 1024 * 1024);
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"Content-Length: " + toString(body.size()) + "\r\n"
+			"\r\n" + body);
+		RequestLatencyStatsMap stats;
+		EVENTUALLY(5,
+			stats = collectLatencyStats();
+			result = !stats.empty() && stats.begin()->second.appProcessing.getCount() == 1;
+		);
+		ensure_equals("(1)", stats.begin()->second.responseOutput.getCount(), 0u);
+		ensure_equals("(2)", stats.begin()->second.total.getCount(), 0u);
+
+		readResponseHeader();
+		ensure_equals("(3)", readResponseBody().size(), body.size());
+		stats = collectLatencyStats();
+		ensure_equals("(4)", stats.begin()->second.responseOutput.getCount(), 1u);
+		ensure_equals("(5)", stats.begin()->second.total.getCount(), 1u);
+	}
+
+	/***** Response compression *****/
+
+	TEST_METHOD(90) {
+		set_test_name("Responses of unknown length are gzip-compressed and chunked"
+			" if the client accepts gzip");
+
+		config["default_response_compression"] = true;
+		string body = createLargeBody(100000);
+		string header;
+		string responseBody = sendRequestAndFileResponse(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Accept-Encoding: deflate, gzip\r\n"
+			"Connection: close\r\n"
+			"\r\n",
+			"HTTP/1.1 200 OK\r\n"
+			"Content-Type: text/html; charset=utf-8\r\n"
+			"\r\n" + body,
+			&header);
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		ensure("(2)", containsSubstring(header, "Content-Encoding: gzip\r\n"));
+		ensure("(3)", containsSubstring(header, "Vary: Accept-Encoding\r\n"));
+		ensure("(4)", containsSubstring(header, "Transfer-Encoding: chunked\r\n"));
+		ensure("(5)", !containsSubstring(header, "Content-Length"));
+		string decompressed = gunzip(dechunk(responseBody));
+		ensure_equals("(6)", decompressed.size(), body.size());
+		ensure("(7)", decompressed == body);
+		ensure("(8)", responseBody.size() < body.size());
+	}
+
+	TEST_METHOD(91) {
+		set_test_name("The Content-Length of compressed responses is removed");
+
+		config["default_response_compression"] = true;
+		string body = createLargeBody(10000);
+		string header;
+		string responseBody = sendRequestAndFileResponse(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Accept-Encoding: gzip\r\n"
+			"Connection: close\r\n"
+			"\r\n",
+			"HTTP/1.1 200 OK\r\n"
+			"Content-Type: application/json\r\n"
+			"Content-Length: " + toString(body.size()) + "\r\n"
+			"\r\n" + body,
+			&header);
+		ensure("(1)", containsSubstring(header, "Content-Encoding: gzip\r\n"));
+		ensure("(2)", !containsSubstring(header, "Content-Length"));
+		ensure("(3)", gunzip(dechunk(responseBody)) == body);
+	}
+
+	TEST_METHOD(92) {
+		set_test_name("Responses are not compressed if the client does not accept gzip");
+
+		config["default_response_compression"] = true;
+		string header;
+		string responseBody = sendRequestAndFileResponse(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Accept-Encoding: gzip;q=0, deflate\r\n"
+			"Connection: close\r\n"
+			"\r\n",
+			"HTTP/1.1 200 OK\r\n"
+			"Content-Type: text/plain\r\n"
+			"Content-Length: 1000\r\n"
+			"\r\n" + string(1000, 'x'),
+			&header);
+		ensure("(1)", !containsSubstring(header, "Content-Encoding"));
+		ensure("(2)", containsSubstring(header, "Content-Length: 1000\r\n"));
+		ensure_equals("(3)", responseBody, string(1000, 'x'));
+	}
+
+	TEST_METHOD(93) {
+		set_test_name("Responses are not compressed if their content type is not compressible");
+
+		config["default_response_compression"] = true;
+		string header;
+		string responseBody = sendRequestAndFileResponse(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Accept-Encoding: gzip\r\n"
+			"Connection: close\r\n"
+			"\r\n",
+			"HTTP/1.1 200 OK\r\n"
+			"Content-Type: image/png\r\n"
+			"Content-Length: 1000\r\n"
+			"\r\n" + string(1000, 'x'),
+			&header);
+		ensure("(1)", !containsSubstring(header, "Content-Encoding"));
+		ensure_equals("(2)", responseBody, string(1000, 'x'));
+	}
+
+	TEST_METHOD(94) {
+		set_test_name("Responses are not compressed if compression is not enabled");
+
+		string header;
+		string responseBody = sendRequestAndFileResponse(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Accept-Encoding: gzip\r\n"
+			"Connection: close\r\n"
+			"\r\n",
+			"HTTP/1.1 200 OK\r\n"
+			"Content-Type: text/plain\r\n"
+			"Content-Length: 1000\r\n"
+			"\r\n" + string(1000, 'x'),
+			&header);
+		ensure("(1)", !containsSubstring(header, "Content-Encoding"));
+		ensure_equals("(2)", responseBody, string(1000, 'x'));
+	}
+
+	TEST_METHOD(95) {
+		set_test_name("Compressed responses get a weak ETag, and Accept-Encoding"
+			" is merged into the app's Vary header");
+
+		config["default_response_compression"] = true;
+		string body = createLargeBody(10000);
+		string header;
+		string responseBody = sendRequestAndFileResponse(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Accept-Encoding: gzip\r\n"
+			"Connection: close\r\n"
+			"\r\n",
+			"HTTP/1.1 200 OK\r\n"
+			"Content-Type: text/plain\r\n"
+			"ETag: \"abc\"\r\n"
+			"Vary: Cookie\r\n"
+			"Content-Length: " + toString(body.size()) + "\r\n"
+			"\r\n" + body,
+			&header);
+		ensure("(1)", containsSubstring(header, "Content-Encoding: gzip\r\n"));
+		ensure("(2)", containsSubstring(header, "ETag: W/\"abc\"\r\n"));
+		ensure("(3)", containsSubstring(header, "Vary: Cookie, Accept-Encoding\r\n"));
+		ensure_equals("(4)", header.find("Vary:"), header.rfind("Vary:"));
+		ensure("(5)", gunzip(dechunk(responseBody)) == body);
+	}
+
+	TEST_METHOD(96) {
+		set_test_name("Weak ETags and a Vary header that covers Accept-Encoding"
+			" are left alone when compressing");
+
+		config["default_response_compression"] = true;
+		string body = createLargeBody(10000);
+		string header;
+		string responseBody = sendRequestAndFileResponse(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Accept-Encoding: gzip\r\n"
+			"Connection: close\r\n"
+			"\r\n",
+			"HTTP/1.1 200 OK\r\n"
+			"Content-Type: text/plain\r\n"
+			"ETag: W/\"abc\"\r\n"
+			"Vary: Accept-Encoding\r\n"
+			"Content-Length: " + toString(body.size()) + "\r\n"
+			"\r\n" + body,
+			&header);
+		ensure("(1)", containsSubstring(header, "Content-Encoding: gzip\r\n"));
+		ensure("(2)", containsSubstring(header, "ETag: W/\"abc\"\r\n"));
+		ensure("(3)", containsSubstring(header, "Vary: Accept-Encoding\r\n"));
+		ensure_equals("(4)", header.find("Vary:"), header.rfind("Vary:"));
+		ensure("(5)", gunzip(dechunk(responseBody)) == body);
+	}
 }
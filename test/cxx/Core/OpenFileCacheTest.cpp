@@ -0,0 +1,103 @@
+#include <TestSupport.h>
+#include <FileTools/FileManip.h>
+#include <Core/OpenFileCache.h>
+
+using namespace Passenger;
+using namespace Passenger::Core;
+using namespace std;
+
+namespace tut {
+	struct Core_OpenFileCacheTest {
+		TempDir tmpDir;
+		OpenFileCache cache;
+		OpenFileCache::File file;
+
+		Core_OpenFileCacheTest()
+			: tmpDir("tmp.openfilecache"),
+			  cache(2, 1)
+		{
+			createFile("tmp.openfilecache/a", "hello");
+			createFile("tmp.openfilecache/b", "world!");
+			createFile("tmp.openfilecache/c", "foo");
+		}
+
+		string readFile(const OpenFileCache::File &file) {
+			char buf[64];
+			ssize_t ret = pread(file.fd, buf, sizeof(buf), 0);
+			ensure(ret >= 0);
+			return string(buf, ret);
+		}
+	};
+
+	DEFINE_TEST_GROUP(Core_OpenFileCacheTest);
+
+	TEST_METHOD(1) {
+		set_test_name("Files are opened once, and served from the cache after that");
+
+		ensure_equals(cache.get("tmp.openfilecache/a", 100, file), 0);
+		ensure_equals(file.size, 5u);
+		ensure_equals(readFile(file), "hello");
+		int fd = file.fd;
+
+		ensure_equals(cache.get("tmp.openfilecache/a", 100.5, file), 0);
+		ensure_equals("The same file descriptor is returned", (int) file.fd, fd);
+		ensure_equals(cache.getHits(), 1u);
+		ensure_equals(cache.getMisses(), 1u);
+		ensure_equals(cache.size(), 1u);
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("Files that changed are reopened once the entry is no longer trusted");
+
+		ensure_equals(cache.get("tmp.openfilecache/a", 100, file), 0);
+		OpenFileCache::File oldFile = file;
+
+		unlink("tmp.openfilecache/a");
+		createFile("tmp.openfilecache/a", "hello world");
+
+		ensure_equals(cache.get("tmp.openfilecache/a", 100.5, file), 0);
+		ensure_equals("The cached entry is trusted within the validity period",
+			file.size, 5u);
+
+		ensure_equals(cache.get("tmp.openfilecache/a", 101, file), 0);
+		ensure_equals(file.size, 11u);
+		ensure_equals(readFile(file), "hello world");
+		ensure_equals("Holders of the old file can still read it",
+			readFile(oldFile), "hello");
+		ensure_equals(cache.getMisses(), 2u);
+
+		unlink("tmp.openfilecache/a");
+		ensure_equals(cache.get("tmp.openfilecache/a", 102, file), ENOENT);
+		ensure_equals("Deleted files are removed from the cache", cache.size(), 0u);
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("The least recently used file is closed when the cache is full");
+
+		ensure_equals(cache.get("tmp.openfilecache/a", 100, file), 0);
+		ensure_equals(cache.get("tmp.openfilecache/b", 100, file), 0);
+		ensure_equals(cache.get("tmp.openfilecache/a", 100, file), 0);
+		ensure_equals(cache.get("tmp.openfilecache/c", 100, file), 0);
+		ensure_equals(cache.size(), 2u);
+		ensure_equals(cache.getMisses(), 3u);
+
+		ensure_equals(cache.get("tmp.openfilecache/a", 100, file), 0);
+		ensure_equals(cache.getMisses(), 3u);
+		ensure_equals(cache.get("tmp.openfilecache/b", 100, file), 0);
+		ensure_equals("b was evicted", cache.getMisses(), 4u);
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("Errors are returned, and not cached");
+
+		ensure_equals(cache.get("tmp.openfilecache/nonexistent", 100, file), ENOENT);
+		ensure_equals(cache.get("tmp.openfilecache", 100, file), EISDIR);
+		ensure_equals(cache.get("tmp.openfilecache/a/b", 100, file), ENOTDIR);
+		ensure_equals(cache.size(), 0u);
+
+		cache.clear();
+		ensure_equals(cache.get("tmp.openfilecache/a", 100, file), 0);
+		cache.clear();
+		ensure_equals(cache.size(), 0u);
+	}
+}
@@ -5,6 +5,9 @@
 #include <Core/Controller/Request.h>
 #include <Core/Controller/AppResponse.h>
 #include <Core/ResponseCache.h>
+#include <Core/SharedResponseCache.h>
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
 
 using namespace Passenger;
 using namespace Passenger::Core;
@@ -64,6 +67,7 @@ namespace tut {
 			req.requestBodyBuffering = false;
 			req.https     = false;
 			req.stickySession = false;
+			req.responseCompressionAllowed = false;
 			req.sessionCheckoutTry = 0;
 			req.halfClosePolicy = Request::HALF_CLOSE_POLICY_UNINITIALIZED;
 			req.appResponseInitialized = false;
@@ -152,6 +156,71 @@ namespace tut {
 			req.appResponse.bodyType = AppResponse::RBT_CONTENT_LENGTH;
 			req.appResponse.aux.bodyInfo.contentLength = body.size();
 		}
+
+		ResponseCacheType::Entry storeResponse(const string &headers, const string &body) {
+			struct iovec buffer;
+			buffer.iov_base = (void *) headers.data();
+			buffer.iov_len  = headers.size();
+			psg_lstr_init(&req.appResponse.bodyCacheBuffer);
+			psg_lstr_append(&req.appResponse.bodyCacheBuffer, req.pool,
+				body.data(), body.size());
+			return responseCache.store(&req, time(NULL), &buffer, 1,
+				&req.appResponse.bodyCacheBuffer);
+		}
+
+		bool storeCacheableResponse(const string &path, const string &body = "hello") {
+			reset();
+			psg_lstr_init(&req.path);
+			psg_lstr_append(&req.path, req.pool, path.data(), path.size());
+			initCacheableResponse();
+			initResponseBody(body);
+			return responseCache.prepareRequest(this, &req)
+				&& responseCache.requestAllowsStoring(&req)
+				&& responseCache.prepareRequestForStoring(&req)
+				&& storeResponse("cache-control: public,max-age=99999\r\n", body).valid();
+		}
+
+		bool isCached(const string &path) {
+			reset();
+			psg_lstr_init(&req.path);
+			psg_lstr_append(&req.path, req.pool, path.data(), path.size());
+			return responseCache.prepareRequest(this, &req)
+				&& responseCache.requestAllowsFetching(&req)
+				&& responseCache.fetch(&req, time(NULL)).valid();
+		}
+
+		static void sharedCacheReader(SharedResponseCache *cache, unsigned int threadIndex,
+			boost::atomic<bool> *done, boost::atomic<unsigned int> *errors)
+		{
+			unsigned int i = 0;
+			while (!done->load(boost::memory_order_relaxed)) {
+				cache->threadOnline(threadIndex);
+				for (unsigned int j = 0; j < 8; j++, i++) {
+					string key = "key" + toString(i % 16);
+					const SharedResponseCache::Entry *entry = cache->lookup(key);
+					if (entry != NULL
+					 && StaticString(entry->getHttpBodyData(), entry->httpBodySize)
+						!= StaticString("body of " + key))
+					{
+						errors->fetch_add(1);
+					}
+				}
+				if (i % 64 == 0) {
+					cache->threadOffline(threadIndex);
+					boost::this_thread::yield();
+				}
+			}
+			cache->threadOffline(threadIndex);
+		}
+
+		string getBody(const ResponseCacheType::Entry &entry) {
+			string result;
+			for (unsigned int i = 0; i < entry.body->httpBodyData.size(); i++) {
+				const MemoryKit::mbuf &part = entry.body->httpBodyData[i];
+				result.append(part.start, part.size());
+			}
+			return result;
+		}
 	};
 
 	DEFINE_TEST_GROUP_WITH_LIMIT(Core_ResponseCacheTest, 100);
@@ -213,8 +282,8 @@ namespace tut {
 		ensure("(2)", responseCache.requestAllowsStoring(&req));
 		ensure("(3)", responseCache.prepareRequestForStoring(&req));
 
-		ResponseCacheType::Entry entry(responseCache.store(&req, time(NULL),
-			responseHeadersStr.size(), responseBodyStr.size()));
+		ResponseCacheType::Entry entry(storeResponse(responseHeadersStr,
+			responseBodyStr));
 		ensure("(5)", entry.valid());
 		ensure_equals("(6)", entry.index, 0u);
 
@@ -227,6 +296,9 @@ namespace tut {
 		ensure_equals("(13)", entry2.index, 0u);
 		ensure_equals<int>("(14)", entry2.body->httpHeaderSize, responseHeadersStr.size());
 		ensure_equals<int>("(15)", entry2.body->httpBodySize, responseBodyStr.size());
+		ensure_equals("(16)", StaticString(entry2.body->httpHeaderData,
+			entry2.body->httpHeaderSize), StaticString(responseHeadersStr));
+		ensure_equals("(17)", getBody(entry2), responseBodyStr);
 	}
 
 	TEST_METHOD(11) {
@@ -475,8 +547,8 @@ namespace tut {
 		ensure("(2)", responseCache.requestAllowsStoring(&req));
 		ensure("(3)", responseCache.prepareRequestForStoring(&req));
 
-		ResponseCacheType::Entry entry(responseCache.store(&req, time(NULL),
-			responseHeadersStr.size(), responseBodyStr.size()));
+		ResponseCacheType::Entry entry(storeResponse(responseHeadersStr,
+			responseBodyStr));
 		ensure("(5)", entry.valid());
 		ensure_equals("(6)", entry.index, 0u);
 
@@ -508,8 +580,8 @@ namespace tut {
 		ensure("(2)", responseCache.requestAllowsStoring(&req));
 		ensure("(3)", responseCache.prepareRequestForStoring(&req));
 
-		ResponseCacheType::Entry entry(responseCache.store(&req, time(NULL),
-			responseHeadersStr.size(), responseBodyStr.size()));
+		ResponseCacheType::Entry entry(storeResponse(responseHeadersStr,
+			responseBodyStr));
 		ensure("(5)", entry.valid());
 		ensure_equals("(6)", entry.index, 0u);
 
@@ -546,8 +618,8 @@ namespace tut {
 		ensure("(2)", responseCache.requestAllowsStoring(&req));
 		ensure("(3)", responseCache.prepareRequestForStoring(&req));
 
-		ResponseCacheType::Entry entry(responseCache.store(&req, time(NULL),
-			responseHeadersStr.size(), responseBodyStr.size()));
+		ResponseCacheType::Entry entry(storeResponse(responseHeadersStr,
+			responseBodyStr));
 		ensure("(5)", entry.valid());
 		ensure_equals("(6)", entry.index, 0u);
 
@@ -571,4 +643,244 @@ namespace tut {
 		ResponseCacheType::Entry entry2(responseCache.fetch(&req, time(NULL)));
 		ensure("(22)", !entry2.valid());
 	}
+
+	TEST_METHOD(63) {
+		set_test_name("Compressed and uncompressed variants are cached separately, and invalidated together");
+		initCacheableResponse();
+		initResponseBody("hello");
+		req.responseCompressionAllowed = true;
+		ensure("(1)", responseCache.prepareRequest(this, &req));
+		ensure("(2)", responseCache.prepareRequestForStoring(&req));
+		ensure("(3)", storeResponse("cache-control: public,max-age=99999\r\n"
+			"content-encoding: gzip\r\n", "hello").valid());
+
+		ensure("(4)", !isCached("/"));
+		req.responseCompressionAllowed = true;
+		ensure("(5)", responseCache.prepareRequest(this, &req));
+		ensure("(6)", responseCache.fetch(&req, time(NULL)).valid());
+
+		ensure("(7)", storeCacheableResponse("/"));
+		ensure_equals("(8)", responseCache.getEntryCount(), 2u);
+
+		reset();
+		req.method = HTTP_POST;
+		ensure("(10)", responseCache.prepareRequest(this, &req));
+		responseCache.invalidate(&req);
+		ensure_equals("(11)", responseCache.getEntryCount(), 0u);
+	}
+
+
+
+	/***** Capacity *****/
+
+	TEST_METHOD(70) {
+		set_test_name("It can hold many entries, and stores large bodies as a chain of mbufs");
+		string body(ResponseCacheType::BODY_MBUF_BLOCK_CHUNK_SIZE * 3, 'x');
+
+		for (unsigned int i = 0; i < 500; i++) {
+			ensure(storeCacheableResponse("/" + toString(i)));
+		}
+		ensure(storeCacheableResponse("/large", body));
+		ensure_equals(responseCache.getEntryCount(), 501u);
+		for (unsigned int i = 0; i < 500; i++) {
+			ensure("Entry " + toString(i) + " is cached", isCached("/" + toString(i)));
+		}
+
+		reset();
+		psg_lstr_init(&req.path);
+		psg_lstr_append(&req.path, req.pool, "/large");
+		ensure(responseCache.prepareRequest(this, &req));
+		ResponseCacheType::Entry entry(responseCache.fetch(&req, time(NULL)));
+		ensure(entry.valid());
+		ensure(entry.body->httpBodyData.size() > 1);
+		ensure(getBody(entry) == body);
+	}
+
+	TEST_METHOD(71) {
+		set_test_name("It evicts the least recently used entry when the maximum number of entries is reached");
+		responseCache.setLimits(3, ResponseCacheType::DEFAULT_MAX_MEMORY,
+			ResponseCacheType::DEFAULT_MAX_BODY_SIZE);
+		ensure(storeCacheableResponse("/a"));
+		ensure(storeCacheableResponse("/b"));
+		ensure(storeCacheableResponse("/c"));
+		ensure(isCached("/a"));
+		ensure(storeCacheableResponse("/d"));
+
+		ensure_equals(responseCache.getEntryCount(), 3u);
+		ensure_equals(responseCache.getEvictions(), 1u);
+		ensure(isCached("/a"));
+		ensure(!isCached("/b"));
+		ensure(isCached("/c"));
+		ensure(isCached("/d"));
+	}
+
+	TEST_METHOD(72) {
+		set_test_name("It evicts least recently used entries to stay within the memory budget");
+		string body(ResponseCacheType::BODY_MBUF_BLOCK_CHUNK_SIZE, 'x');
+		responseCache.setLimits(100, ResponseCacheType::BODY_MBUF_BLOCK_CHUNK_SIZE * 5,
+			ResponseCacheType::DEFAULT_MAX_BODY_SIZE);
+
+		// Each of these bodies occupies 2 mbuf blocks, so only 2 fit.
+		ensure(storeCacheableResponse("/a", body));
+		ensure(storeCacheableResponse("/b", body));
+		ensure(storeCacheableResponse("/c", body));
+		ensure(responseCache.getMemoryUsage() <= responseCache.getMaxMemory());
+		ensure(!isCached("/a"));
+		ensure(isCached("/b"));
+		ensure(isCached("/c"));
+
+		ensure("Entries larger than the budget are not stored",
+			!storeCacheableResponse("/d", string(ResponseCacheType::BODY_MBUF_BLOCK_CHUNK_SIZE * 6, 'x')));
+		ensure(isCached("/b"));
+	}
+
+	TEST_METHOD(73) {
+		set_test_name("Storing an existing key replaces the entry");
+		ensure(storeCacheableResponse("/a", "hello"));
+		ensure(storeCacheableResponse("/a", "world"));
+		ensure_equals(responseCache.getEntryCount(), 1u);
+
+		reset();
+		psg_lstr_init(&req.path);
+		psg_lstr_append(&req.path, req.pool, "/a");
+		ensure(responseCache.prepareRequest(this, &req));
+		ResponseCacheType::Entry entry(responseCache.fetch(&req, time(NULL)));
+		ensure(entry.valid());
+		ensure_equals(getBody(entry), "world");
+	}
+
+
+	/***** Sharing between threads *****/
+
+	TEST_METHOD(80) {
+		set_test_name("In shared mode, responses stored by one thread can be fetched by another");
+		SharedResponseCache sharedCache(16, 1024 * 1024, 2);
+		ResponseCacheType otherCache;
+		responseCache.setSharedCache(&sharedCache);
+		otherCache.setSharedCache(&sharedCache);
+		sharedCache.threadOnline(0);
+		sharedCache.threadOnline(1);
+
+		ensure("(1)", storeCacheableResponse("/a", "hello"));
+		ensure_equals("(2)", sharedCache.getEntryCount(), 1u);
+
+		reset();
+		psg_lstr_init(&req.path);
+		psg_lstr_append(&req.path, req.pool, "/a");
+		ensure("(3)", otherCache.prepareRequest(this, &req));
+		ResponseCacheType::Entry entry(otherCache.fetch(&req, time(NULL)));
+		ensure("(4)", entry.valid());
+		ensure_equals("(5)", getBody(entry), "hello");
+		ensure_equals("(6)", StaticString(entry.body->httpHeaderData, entry.body->httpHeaderSize),
+			StaticString("cache-control: public,max-age=99999\r\n"));
+
+		// Statistics are kept per thread
+		ensure_equals("(7)", otherCache.getHits(), 1u);
+		ensure_equals("(8)", otherCache.getStores(), 0u);
+		ensure_equals("(9)", responseCache.getHits(), 0u);
+		ensure_equals("(10)", responseCache.getStores(), 1u);
+
+		sharedCache.threadOffline(0);
+		sharedCache.threadOffline(1);
+	}
+
+	TEST_METHOD(81) {
+		set_test_name("In shared mode, invalidations by one thread are visible to other threads");
+		SharedResponseCache sharedCache(16, 1024 * 1024, 2);
+		ResponseCacheType otherCache;
+		responseCache.setSharedCache(&sharedCache);
+		otherCache.setSharedCache(&sharedCache);
+		sharedCache.threadOnline(0);
+		sharedCache.threadOnline(1);
+
+		ensure("(1)", storeCacheableResponse("/", "hello"));
+
+		reset();
+		req.method = HTTP_POST;
+		ensure("(2)", otherCache.prepareRequest(this, &req));
+		ensure("(3)", otherCache.requestAllowsInvalidating(&req));
+		otherCache.invalidate(&req);
+
+		ensure("(4)", !isCached("/"));
+		ensure_equals("(5)", sharedCache.getEntryCount(), 0u);
+
+		sharedCache.threadOffline(0);
+		sharedCache.threadOffline(1);
+	}
+
+	TEST_METHOD(82) {
+		set_test_name("Shared entries are only freed after all online threads have passed through a quiescent state");
+		SharedResponseCache sharedCache(16, 1024 * 1024, 2);
+		responseCache.setSharedCache(&sharedCache);
+		sharedCache.threadOnline(0);
+		sharedCache.threadOnline(1);
+
+		ensure("(1)", storeCacheableResponse("/a", "hello"));
+		ensure("(2)", storeCacheableResponse("/a", "world"));
+		ensure_equals("(3)", sharedCache.getRetiredEntryCount(), 1u);
+
+		sharedCache.threadOnline(0);
+		sharedCache.reclaim();
+		ensure_equals("(4)", sharedCache.getRetiredEntryCount(), 1u);
+
+		sharedCache.threadOffline(1);
+		sharedCache.reclaim();
+		ensure_equals("(5)", sharedCache.getRetiredEntryCount(), 0u);
+		ensure("(6)", isCached("/a"));
+
+		sharedCache.threadOffline(0);
+	}
+
+	TEST_METHOD(83) {
+		set_test_name("The shared cache evicts entries that have not been used recently");
+		SharedResponseCache sharedCache(2, 1024 * 1024, 1);
+		responseCache.setSharedCache(&sharedCache);
+		sharedCache.threadOnline(0);
+
+		ensure("(1)", storeCacheableResponse("/a"));
+		ensure("(2)", storeCacheableResponse("/b"));
+		ensure("(3)", isCached("/a"));
+		ensure("(4)", storeCacheableResponse("/c"));
+
+		ensure_equals("(5)", sharedCache.getEntryCount(), 2u);
+		ensure_equals("(6)", sharedCache.getEvictions(), 1u);
+		ensure("(7)", isCached("/a"));
+		ensure("(8)", !isCached("/b"));
+		ensure("(9)", isCached("/c"));
+
+		sharedCache.threadOffline(0);
+	}
+
+	TEST_METHOD(84) {
+		set_test_name("Readers see consistent entries while another thread modifies the shared cache");
+		SharedResponseCache sharedCache(8, 1024 * 1024, 4);
+		boost::atomic<bool> done(false);
+		boost::atomic<unsigned int> errors(0);
+		boost::thread_group threads;
+
+		for (unsigned int i = 0; i < 4; i++) {
+			threads.create_thread(boost::bind(sharedCacheReader, &sharedCache, i,
+				&done, &errors));
+		}
+
+		for (unsigned int i = 0; i < 20000; i++) {
+			string key = "key" + toString(i % 16);
+			string body = "body of " + key;
+			LString bodyStr;
+			psg_lstr_init(&bodyStr);
+			psg_lstr_append(&bodyStr, req.pool, body.data(), body.size());
+			if (i % 3 == 0) {
+				sharedCache.erase(key);
+			} else {
+				sharedCache.store(key, 0, 0, NULL, 0, &bodyStr);
+			}
+			psg_lstr_deinit(&bodyStr);
+		}
+
+		done.store(true);
+		threads.join_all();
+		ensure_equals(errors.load(), 0u);
+		sharedCache.reclaim();
+		ensure_equals(sharedCache.getRetiredEntryCount(), 0u);
+	}
 }
@@ -0,0 +1,163 @@
+#include <TestSupport.h>
+#include <Core/Controller/ResponseCompressor.h>
+
+using namespace Passenger;
+using namespace Passenger::Core;
+using namespace Passenger::MemoryKit;
+using namespace std;
+
+namespace tut {
+	struct Core_ResponseCompressorTest {
+		mbuf_pool pool;
+		ResponseCompressor compressor;
+		vector<mbuf> output;
+
+		Core_ResponseCompressorTest()
+			: compressor(6)
+		{
+			pool.mbuf_block_chunk_size = 512;
+			mbuf_pool_init(&pool);
+		}
+
+		~Core_ResponseCompressorTest() {
+			output.clear();
+			compressor.reset(6);
+			mbuf_pool_deinit(&pool);
+		}
+
+		ssize_t compress(const string &data, int flush) {
+			return compressor.compress(&pool, data.data(), data.size(), flush, output);
+		}
+
+		string joinOutput() {
+			string result;
+			for (unsigned int i = 0; i < output.size(); i++) {
+				result.append(output[i].start, output[i].size());
+			}
+			return result;
+		}
+
+		// Decompresses as much of `data` as possible. Sets `complete` to
+		// whether the end of the gzip stream was reached.
+		static string gunzip(const string &data, bool *complete = NULL) {
+			z_stream stream;
+			char buf[1024];
+			string result;
+			int ret;
+
+			memset(&stream, 0, sizeof(stream));
+			ensure_equals(inflateInit2(&stream, 15 + 16), Z_OK);
+			stream.next_in = (Bytef *) data.data();
+			stream.avail_in = data.size();
+			do {
+				stream.next_out = (Bytef *) buf;
+				stream.avail_out = sizeof(buf);
+				ret = inflate(&stream, Z_SYNC_FLUSH);
+				result.append(buf, sizeof(buf) - stream.avail_out);
+			} while (ret == Z_OK && stream.avail_out == 0);
+			inflateEnd(&stream);
+
+			ensure("Inflating succeeds", ret == Z_OK || ret == Z_STREAM_END
+				|| ret == Z_BUF_ERROR);
+			if (complete != NULL) {
+				*complete = ret == Z_STREAM_END;
+			}
+			return result;
+		}
+	};
+
+	DEFINE_TEST_GROUP(Core_ResponseCompressorTest);
+
+	TEST_METHOD(1) {
+		set_test_name("Compressing a body in pieces results in a valid gzip stream");
+		string body;
+		ssize_t total = 0;
+
+		for (unsigned int i = 0; i < 100; i++) {
+			string piece = "Line " + toString(i) + " of the response body\n";
+			body.append(piece);
+			total += compress(piece, Z_NO_FLUSH);
+		}
+		total += compress("", Z_FINISH);
+
+		string compressed = joinOutput();
+		ensure_equals("(1)", (size_t) total, compressed.size());
+		ensure("(2)", compressed.size() < body.size());
+		ensure("(3)", output.size() > 1);
+
+		bool complete;
+		ensure_equals("(4)", gunzip(compressed, &complete), body);
+		ensure("(5)", complete);
+		ensure_equals("(6)", compressor.getBytesIn(), (boost::uint64_t) body.size());
+		ensure_equals("(7)", compressor.getBytesOut(), (boost::uint64_t) compressed.size());
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("Z_SYNC_FLUSH outputs everything that was fed so far");
+		ensure("(1)", compress("hello ", Z_SYNC_FLUSH) > 0);
+		bool complete;
+		ensure_equals("(2)", gunzip(joinOutput(), &complete), "hello ");
+		ensure("(3)", !complete);
+
+		ensure("(4)", compress("world", Z_SYNC_FLUSH) > 0);
+		ensure_equals("(5)", gunzip(joinOutput(), &complete), "hello world");
+		ensure("(6)", !complete);
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("After a reset, a new gzip stream is started");
+		compress("hello", Z_FINISH);
+		output.clear();
+		compressor.reset(1);
+		ensure_equals("(1)", compressor.getLevel(), 1);
+		ensure_equals("(2)", compressor.getBytesIn(), (boost::uint64_t) 0);
+
+		compress("world", Z_FINISH);
+		bool complete;
+		ensure_equals("(3)", gunzip(joinOutput(), &complete), "world");
+		ensure("(4)", complete);
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("Accept-Encoding parsing");
+		ensure("(1)", ResponseCompressor::acceptsGzip("gzip"));
+		ensure("(2)", ResponseCompressor::acceptsGzip("deflate, gzip, br"));
+		ensure("(3)", ResponseCompressor::acceptsGzip("br;q=1.0, GZIP;q=0.5"));
+		ensure("(4)", ResponseCompressor::acceptsGzip("x-gzip"));
+		ensure("(5)", ResponseCompressor::acceptsGzip("*"));
+		ensure("(6)", !ResponseCompressor::acceptsGzip(""));
+		ensure("(7)", !ResponseCompressor::acceptsGzip("identity"));
+		ensure("(8)", !ResponseCompressor::acceptsGzip("deflate, br"));
+		ensure("(9)", !ResponseCompressor::acceptsGzip("gzip;q=0"));
+		ensure("(10)", !ResponseCompressor::acceptsGzip("gzip; q=0.000, deflate"));
+		ensure("(11)", !ResponseCompressor::acceptsGzip("*, gzip;q=0"));
+		ensure("(12)", !ResponseCompressor::acceptsGzip("*;q=0"));
+		ensure("(13)", !ResponseCompressor::acceptsGzip("gzipped"));
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("Compressible content types");
+		ensure("(1)", ResponseCompressor::isCompressibleContentType("text/html"));
+		ensure("(2)", ResponseCompressor::isCompressibleContentType("text/html; charset=utf-8"));
+		ensure("(3)", ResponseCompressor::isCompressibleContentType("Text/CSS"));
+		ensure("(4)", ResponseCompressor::isCompressibleContentType("application/json"));
+		ensure("(5)", ResponseCompressor::isCompressibleContentType("application/javascript"));
+		ensure("(6)", ResponseCompressor::isCompressibleContentType("application/vnd.api+json"));
+		ensure("(7)", ResponseCompressor::isCompressibleContentType("image/svg+xml"));
+		ensure("(8)", !ResponseCompressor::isCompressibleContentType("image/png"));
+		ensure("(9)", !ResponseCompressor::isCompressibleContentType("application/octet-stream"));
+		ensure("(10)", !ResponseCompressor::isCompressibleContentType("application/gzip"));
+		ensure("(11)", !ResponseCompressor::isCompressibleContentType("text/event-stream"));
+		ensure("(12)", !ResponseCompressor::isCompressibleContentType(""));
+	}
+
+	TEST_METHOD(6) {
+		set_test_name("Vary parsing");
+		ensure("(1)", ResponseCompressor::varyCoversAcceptEncoding("Accept-Encoding"));
+		ensure("(2)", ResponseCompressor::varyCoversAcceptEncoding("Cookie, accept-encoding"));
+		ensure("(3)", ResponseCompressor::varyCoversAcceptEncoding("*"));
+		ensure("(4)", !ResponseCompressor::varyCoversAcceptEncoding(""));
+		ensure("(5)", !ResponseCompressor::varyCoversAcceptEncoding("Cookie"));
+		ensure("(6)", !ResponseCompressor::varyCoversAcceptEncoding("Accept-Encoding-Extra"));
+	}
+}
@@ -181,6 +181,35 @@ namespace tut {
 		);
 	}
 
+	TEST_METHOD(4) {
+		set_test_name("If the app is generic, it keeps waiting while the app is not pingable,"
+			" and finishes soon after it becomes pingable");
+
+		FreePortDebugSupport debugSupport;
+		this->debugSupport = &debugSupport;
+		config.genericApp = true;
+		init(SPAWN_DIRECTLY);
+		debugSupport.test = this;
+		debugSupport.session = session.get();
+		TempThread thr(boost::bind(&Core_SpawningKit_HandshakePerformTest::execute, this));
+
+		EVENTUALLY(1,
+			result = counter == 1;
+		);
+		SHOULD_NEVER_HAPPEN(100,
+			result = counter > 1;
+		);
+
+		MonotonicTimeUsec begin = SystemTime::getMonotonicUsec();
+		server.assign(createTcpServer("127.0.0.1", debugSupport.expectedStartPort.get()),
+			NULL, 0);
+		EVENTUALLY2(1000, 1,
+			result = counter == 2;
+		);
+		ensure("Completion is detected without waiting for the old 50 ms interval",
+			SystemTime::getMonotonicUsec() - begin < 50000);
+	}
+
 	TEST_METHOD(10) {
 		set_test_name("It raises an error if the process exits prematurely");
 
@@ -221,6 +250,27 @@ namespace tut {
 		}
 	}
 
+	TEST_METHOD(12) {
+		set_test_name("If the app is generic, it raises a timeout error if the app"
+			" does not become pingable in time");
+
+		config.genericApp = true;
+		config.startTimeoutMsec = 100;
+		init(SPAWN_DIRECTLY);
+
+		unsigned long long timeout = session->timeoutUsec;
+		MonotonicTimeUsec begin = SystemTime::getMonotonicUsec();
+		try {
+			execute();
+			fail("SpawnException expected");
+		} catch (const SpawnException &e) {
+			ensure_equals(e.getErrorCategory(), SpawningKit::TIMEOUT_ERROR);
+		}
+		MonotonicTimeUsec elapsed = SystemTime::getMonotonicUsec() - begin;
+		ensure("The timeout is honored across ping intervals (1)", elapsed >= timeout);
+		ensure("The timeout is honored across ping intervals (2)", elapsed < 1000000);
+	}
+
 	TEST_METHOD(15) {
 		set_test_name("In the event of an error, it sets the SPAWNING_KIT_HANDSHAKE_PERFORM step to the errored state");
 
@@ -0,0 +1,67 @@
+#include <TestSupport.h>
+#include <boost/make_shared.hpp>
+#include <boost/weak_ptr.hpp>
+#include <Core/SpawningKit/PipeWatcher.h>
+#include <Utils/IOUtils.h>
+
+using namespace Passenger;
+using namespace Passenger::SpawningKit;
+
+namespace tut {
+	struct Core_SpawningKit_PipeWatcherTest {
+		~Core_SpawningKit_PipeWatcherTest() {
+			unlink("tmp.output1");
+			unlink("tmp.output2");
+		}
+
+		PipeWatcherPtr createWatcher(const FileDescriptor &fd, const string &logFile) {
+			PipeWatcherPtr watcher = boost::make_shared<PipeWatcher>(fd,
+				"output", "appgroup", "", getpid());
+			watcher->setLogFile(logFile);
+			watcher->initialize();
+			watcher->start();
+			return watcher;
+		}
+	};
+
+	DEFINE_TEST_GROUP(Core_SpawningKit_PipeWatcherTest);
+
+	TEST_METHOD(1) {
+		set_test_name("It forwards the output of all watched pipes");
+
+		Pipe p1 = createPipe(__FILE__, __LINE__);
+		Pipe p2 = createPipe(__FILE__, __LINE__);
+		createWatcher(p1.first, "tmp.output1");
+		createWatcher(p2.first, "tmp.output2");
+
+		writeExact(p1.second, "hello\n");
+		writeExact(p2.second, "world\n");
+		EVENTUALLY(5,
+			result = fileExists("tmp.output1") && readAll("tmp.output1") == "hello\n"
+				&& fileExists("tmp.output2") && readAll("tmp.output2") == "world\n";
+		);
+
+		writeExact(p1.second, "foo\nbar\n");
+		EVENTUALLY(5,
+			result = readAll("tmp.output1") == "hello\nfoo\nbar\n";
+		);
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("It stops watching when the other side of the pipe is closed");
+
+		Pipe p = createPipe(__FILE__, __LINE__);
+		boost::weak_ptr<PipeWatcher> watcher = createWatcher(p.first, "tmp.output1");
+
+		writeExact(p.second, "hello\n");
+		EVENTUALLY(5,
+			result = fileExists("tmp.output1") && readAll("tmp.output1") == "hello\n";
+		);
+		ensure("(1)", !watcher.expired());
+
+		p.second.close();
+		EVENTUALLY(5,
+			result = watcher.expired();
+		);
+	}
+}
@@ -78,6 +78,17 @@ namespace tut {
 			options.loadShellEnvvars = false;
 			return options;
 		}
+
+		static void spawnAndStoreResult(boost::shared_ptr<SmartSpawner> spawner,
+			SpawningKit::AppPoolOptions options, AtomicInt *spawned)
+		{
+			try {
+				spawner->spawn(options);
+				*spawned = 1;
+			} catch (const SpawnException &) {
+				*spawned = 0;
+			}
+		}
 	};
 
 	DEFINE_TEST_GROUP_WITH_LIMIT(Core_SpawningKit_SmartSpawnerTest, 90);
@@ -216,4 +227,34 @@ namespace tut {
 			ensure(containsSubstring(e.getSubprocessEnvvars(), "PASSENGER_FOO=foo\n"));
 		}
 	}
+
+	TEST_METHOD(85) {
+		set_test_name("Processes can be spawned concurrently, and a failing spawn"
+			" doesn't affect the others");
+
+		SpawningKit::AppPoolOptions options = createOptions();
+		options.appRoot      = "stub/rack";
+		options.startCommand = "ruby start.rb";
+		options.startupFile  = "start.rb";
+		SpawningKit::AppPoolOptions failingOptions = options;
+		failingOptions.startCommand = "false";
+		boost::shared_ptr<SmartSpawner> spawner = createSpawner(options);
+		LoggingKit::setLevel(LoggingKit::CRIT);
+
+		AtomicInt spawned1 = -1, spawned2 = -1, spawned3 = -1;
+		{
+			TempThread thr1(boost::bind(spawnAndStoreResult, spawner, options, &spawned1));
+			TempThread thr2(boost::bind(spawnAndStoreResult, spawner, failingOptions, &spawned2));
+			TempThread thr3(boost::bind(spawnAndStoreResult, spawner, options, &spawned3));
+			thr1.join();
+			thr2.join();
+			thr3.join();
+		}
+		ensure_equals("(1)", (int) spawned1, 1);
+		ensure_equals("(2)", (int) spawned2, 0);
+		ensure_equals("(3)", (int) spawned3, 1);
+
+		// The failing spawn released the spawner lock.
+		spawner->spawn(options);
+	}
 }
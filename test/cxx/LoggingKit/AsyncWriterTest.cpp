@@ -0,0 +1,159 @@
+#include <TestSupport.h>
+#include <LoggingKit/AsyncWriter.h>
+#include <LoggingKit/Context.h>
+#include <Utils/IOUtils.h>
+#include <fcntl.h>
+
+using namespace Passenger;
+using namespace Passenger::LoggingKit;
+using namespace std;
+
+namespace tut {
+	struct LoggingKit_AsyncWriterTest {
+		Pipe p;
+
+		LoggingKit_AsyncWriterTest() {
+			p = createPipe(__FILE__, __LINE__);
+		}
+
+		~LoggingKit_AsyncWriterTest() {
+			unlink("tmp.applog");
+		}
+
+		string readAvailable(unsigned int size) {
+			string result;
+			while (result.size() < size) {
+				char buf[1024];
+				ssize_t ret = read(p.first, buf, std::min<size_t>(sizeof(buf),
+					size - result.size()));
+				if (ret <= 0) {
+					break;
+				}
+				result.append(buf, ret);
+			}
+			return result;
+		}
+	};
+
+	DEFINE_TEST_GROUP(LoggingKit_AsyncWriterTest);
+
+	TEST_METHOD(1) {
+		set_test_name("It writes all lines, in order");
+
+		AsyncWriter writer(16);
+		string expected;
+		for (int i = 0; i < 100; i++) {
+			string line = "line " + toString(i) + "\n";
+			ensure(writer.write(p.second, line.data(), line.size()));
+			expected.append(line);
+		}
+		writer.flush();
+
+		ensure_equals(readAvailable(expected.size()), expected);
+		ensure_equals(writer.getLinesDropped(), 0u);
+		ensure_equals(writer.inspectStateAsJson()["lines_written"].asUInt(), 100u);
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("It writes to the owned file descriptor too, and closes it afterwards");
+
+		int fd = open("tmp.applog", O_WRONLY | O_CREAT | O_TRUNC, 0600);
+		ensure(fd != -1);
+		{
+			AsyncWriter writer;
+			ensure(writer.write(p.second, "hello\n", 6,
+				AsyncWriter::BLOCK_ON_OVERFLOW, fd));
+		}
+
+		ensure_equals(readAvailable(6), "hello\n");
+		ensure_equals(readAll("tmp.applog"), "hello\n");
+		ensure_equals("The fd is closed", fcntl(fd, F_GETFD), -1);
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("It drops lines when the buffer is full and the drop policy is used");
+
+		AsyncWriter writer(2);
+		// Stall the writer thread by filling the pipe.
+		string chunk(1024 * 128, 'x');
+		writer.write(p.second, chunk.data(), chunk.size());
+
+		unsigned int dropped = 0;
+		for (int i = 0; i < 10; i++) {
+			if (!writer.write(p.second, "y\n", 2, AsyncWriter::DROP_ON_OVERFLOW)) {
+				dropped++;
+			}
+		}
+		ensure("Some lines are dropped", dropped > 0);
+		ensure_equals(writer.getLinesDropped(), (boost::uint64_t) dropped);
+		ensure_equals(writer.inspectStateAsJson()["lines_dropped"].asUInt(), dropped);
+
+		// Unstall the writer thread.
+		ensure_equals(readAvailable(chunk.size()), chunk);
+		writer.flush();
+		ensure_equals(readAvailable(2 * (10 - dropped)).size(), 2 * (10 - dropped));
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("It waits for room when the buffer is full and the block policy is used");
+
+		AsyncWriter writer(2);
+		string chunk(1024 * 128, 'x');
+		writer.write(p.second, chunk.data(), chunk.size());
+
+		TempThread thr(boost::bind(&LoggingKit_AsyncWriterTest::readAvailable,
+			this, (unsigned int) chunk.size() + 20));
+		for (int i = 0; i < 10; i++) {
+			ensure(writer.write(p.second, "y\n", 2, AsyncWriter::BLOCK_ON_OVERFLOW));
+		}
+		writer.flush();
+		ensure_equals(writer.getLinesDropped(), 0u);
+		ensure_equals(writer.inspectStateAsJson()["lines_written"].asUInt(), 11u);
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("A Context writes out all queued lines before closing its log target");
+
+		Json::Value config;
+		config["target"]["path"] = "pipe";
+		config["target"]["fd"] = dup(p.second);
+		config["redirect_stderr"] = false;
+		config["async_writes"] = true;
+		Context *context = new Context(config);
+		string expected;
+		for (int i = 0; i < 1000; i++) {
+			string line = "line " + toString(i) + "\n";
+			_writeLogEntry(context->getConfigRealization(), line.data(), line.size());
+			expected.append(line);
+		}
+		delete context;
+
+		setNonBlocking(p.first);
+		ensure_equals(readAvailable(expected.size()), expected);
+	}
+
+	TEST_METHOD(6) {
+		set_test_name("Queued lines for the same fd are written with a single call");
+
+		AsyncWriter writer(64);
+		// Stall the writer thread by filling the pipe, so that
+		// the lines below are all queued by the time it continues.
+		string chunk(1024 * 128, 'x');
+		writer.write(p.second, chunk.data(), chunk.size());
+
+		string expected;
+		for (int i = 0; i < 50; i++) {
+			string line = "line " + toString(i) + "\n";
+			ensure(writer.write(p.second, line.data(), line.size()));
+			expected.append(line);
+		}
+
+		// Unstall the writer thread.
+		ensure_equals("(1)", readAvailable(chunk.size()), chunk);
+		writer.flush();
+		ensure_equals("(2)", readAvailable(expected.size()), expected);
+		ensure_equals("(3)", writer.inspectStateAsJson()["lines_written"].asUInt(), 51u);
+		// At most one call for the chunk, and one for all the lines.
+		ensure("(4)", writer.inspectStateAsJson()["write_calls"].asUInt() <= 2u);
+	}
+}
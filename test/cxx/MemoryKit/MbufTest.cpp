@@ -1,5 +1,8 @@
 #include <TestSupport.h>
 #include <boost/move/move.hpp>
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include <oxt/thread.hpp>
 #include <Constants.h>
 #include <MemoryKit/mbuf.h>
 
@@ -18,6 +21,13 @@ namespace tut {
 
 		~MemoryKit_MbufTest() {
 			mbuf_pool_deinit(&pool);
+			#ifdef OXT_THREAD_LOCAL_KEYWORD_SUPPORTED
+				oxt::thread_signature = NULL;
+			#endif
+		}
+
+		static void releaseBuffers(vector<mbuf> *buffers) {
+			buffers->clear();
 		}
 	};
 
@@ -264,4 +274,103 @@ namespace tut {
 		ensure_equals("(5)", pool.nfree_mbuf_blockq, 0u);
 		ensure_equals("(6)", pool.nactive_mbuf_blockq, 0u);
 	}
+
+	TEST_METHOD(24) {
+		set_test_name("mbuf_pool_trim() releases free blocks until max_free are left");
+		vector<mbuf> buffers;
+		for (unsigned int i = 0; i < 10; i++) {
+			buffers.push_back(mbuf_get(&pool));
+		}
+		buffers.clear();
+		ensure_equals("(1)", pool.nfree_mbuf_blockq, 10u);
+
+		ensure_equals("(2)", mbuf_pool_trim(&pool, 4), 6u);
+		ensure_equals("(3)", pool.nfree_mbuf_blockq, 4u);
+		ensure_equals("(4)", mbuf_pool_trim(&pool, 4), 0u);
+		ensure_equals("(5)", pool.nfree_mbuf_blockq, 4u);
+	}
+
+	TEST_METHOD(25) {
+		set_test_name("Slabs are only released once all their blocks are free");
+		mbuf_pool_enable_slabs(&pool, DEFAULT_MBUF_CHUNK_SIZE * 4, false);
+		ensure_equals("(1)", pool.slab_size, (size_t) DEFAULT_MBUF_CHUNK_SIZE * 4);
+
+		vector<mbuf> buffers;
+		for (unsigned int i = 0; i < 6; i++) {
+			buffers.push_back(mbuf_get(&pool));
+		}
+		ensure_equals("(2)", pool.nslabs, 2u);
+		ensure_equals("(3)", pool.nactive_mbuf_blockq, 6u);
+
+		// Free all blocks of the first slab, and one block of the second slab.
+		mbuf keep(buffers[4]);
+		buffers.clear();
+		ensure_equals("(4)", pool.nfree_mbuf_blockq, 5u);
+
+		ensure_equals("(5)", mbuf_pool_trim(&pool, 0), 4u);
+		ensure_equals("(6)", pool.nslabs, 1u);
+		ensure_equals("(7)", pool.nfree_mbuf_blockq, 1u);
+
+		keep = mbuf();
+		ensure_equals("(8)", mbuf_pool_trim(&pool, 0), 2u);
+		ensure_equals("(9)", pool.nslabs, 0u);
+		ensure_equals("(10)", pool.nfree_mbuf_blockq, 0u);
+		ensure_equals("(11)", pool.nactive_mbuf_blockq, 0u);
+	}
+
+	TEST_METHOD(26) {
+		set_test_name("Slab blocks are reused through the freelist");
+		mbuf_pool_enable_slabs(&pool, DEFAULT_MBUF_CHUNK_SIZE * 4, false);
+		{
+			mbuf buffer(mbuf_get(&pool));
+			memcpy(buffer.start, "hello", 6);
+		}
+		mbuf buffer(mbuf_get(&pool));
+		ensure_equals("(1)", pool.nslabs, 1u);
+		ensure_equals("(2)", pool.nfree_mbuf_blockq, 0u);
+		ensure_equals("(3)", pool.nactive_mbuf_blockq, 1u);
+		ensure_equals("(4)", pool.nallocated, (boost::uint64_t) 1);
+	}
+
+	TEST_METHOD(27) {
+		set_test_name("Blocks released on other threads are reclaimed by the owner thread");
+		#ifdef OXT_THREAD_LOCAL_KEYWORD_SUPPORTED
+			oxt::thread_signature = &pool;
+			mbuf_pool_set_owner(&pool, &pool);
+
+			vector<mbuf> buffers;
+			buffers.push_back(mbuf_get(&pool));
+			buffers.push_back(mbuf_get(&pool));
+			buffers.push_back(mbuf_get_with_size(&pool, mbuf_pool_data_size(&pool) + 10));
+
+			boost::thread thr(boost::bind(releaseBuffers, &buffers));
+			thr.join();
+			ensure_equals("Remote frees do not touch the freelist",
+				pool.nfree_mbuf_blockq, 0u);
+			ensure_equals("(2)", pool.nactive_mbuf_blockq, 3u);
+
+			ensure_equals("(3)", mbuf_pool_reclaim_remote_frees(&pool), 3u);
+			ensure_equals("(4)", pool.nfree_mbuf_blockq, 2u);
+			ensure_equals("(5)", pool.nactive_mbuf_blockq, 0u);
+			ensure_equals("(6)", pool.nremote_frees, (boost::uint64_t) 3);
+		#endif
+	}
+
+	TEST_METHOD(28) {
+		set_test_name("Remote frees are reclaimed when the freelist runs empty");
+		#ifdef OXT_THREAD_LOCAL_KEYWORD_SUPPORTED
+			oxt::thread_signature = &pool;
+			mbuf_pool_set_owner(&pool, &pool);
+
+			vector<mbuf> buffers;
+			buffers.push_back(mbuf_get(&pool));
+			boost::thread thr(boost::bind(releaseBuffers, &buffers));
+			thr.join();
+
+			mbuf buffer(mbuf_get(&pool));
+			ensure_equals("(1)", pool.nallocated, (boost::uint64_t) 1);
+			ensure_equals("(2)", pool.nfree_mbuf_blockq, 0u);
+			ensure_equals("(3)", pool.nactive_mbuf_blockq, 1u);
+		#endif
+	}
 }
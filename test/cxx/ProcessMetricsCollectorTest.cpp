@@ -113,4 +113,46 @@ namespace tut {
 			ensure(swap < 10000 || swap == -1);
 		#endif
 	}
+
+	TEST_METHOD(4) {
+		// It collects the metrics for the given PIDs without 'ps'
+		// on platforms that support it.
+		child = spawnChild(50);
+		usleep(500000);
+		vector<pid_t> pids;
+		pids.push_back(getpid());
+		pids.push_back(child);
+		ProcessMetricMap result = collector.collect(pids);
+
+		ensure_equals(result.size(), 2u);
+		ensure_equals(result[child].pid, child);
+		ensure_equals(result[child].ppid, getpid());
+		ensure_equals(result[child].uid, geteuid());
+		ensure("RSS is correct", result[child].rss > 50000 && result[child].rss < 60000);
+		ensure("VM size is correct", result[child].vmsize >= result[child].rss);
+		ensure("Command is correct", containsSubstring(result[child].command,
+			"allocate_memory 50"));
+		ensure("Private dirty is correct", result[child].privateDirty == -1
+			|| (result[child].privateDirty > 50000 && result[child].privateDirty < 60000));
+		ensure_equals(result[getpid()].processGroupId, getpgrp());
+	}
+
+	TEST_METHOD(5) {
+		// It does not collect the metrics for PIDs that don't exist
+		// on platforms that support collecting without 'ps'.
+		child = spawnChild(1);
+		kill(child, SIGKILL);
+		waitpid(child, NULL, 0);
+		pid_t deadChild = child;
+		child = -1;
+
+		vector<pid_t> pids;
+		pids.push_back(getpid());
+		pids.push_back(deadChild);
+		ProcessMetricMap result = collector.collect(pids);
+
+		ensure_equals(result.size(), 1u);
+		ensure(result.find(getpid()) != result.end());
+		ensure(result.find(deadChild) == result.end());
+	}
 }
@@ -0,0 +1,169 @@
+#include <TestSupport.h>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <oxt/system_calls.hpp>
+#include <vector>
+#include <BackgroundEventLoop.h>
+#include <ServerKit/Server.h>
+#include <ServerKit/AcceptLoadBalancer.h>
+#include <LoggingKit/LoggingKit.h>
+#include <FileDescriptor.h>
+#include <Utils/IOUtils.h>
+
+using namespace Passenger;
+using namespace Passenger::ServerKit;
+using namespace std;
+using namespace oxt;
+
+namespace tut {
+	struct ServerKit_AcceptLoadBalancerTest {
+		typedef Server<Client> ServerType;
+
+		BackgroundEventLoop bg1, bg2;
+		ServerKit::Schema skSchema;
+		ServerKit::Context context1, context2;
+		ServerKit::BaseServerSchema schema;
+		boost::shared_ptr<ServerType> server1, server2;
+		AcceptLoadBalancer<ServerType> loadBalancer;
+		int balancedSocket, directSocket;
+		vector<FileDescriptor> clients;
+
+		ServerKit_AcceptLoadBalancerTest()
+			: bg1(false, true),
+			  bg2(false, true),
+			  context1(skSchema),
+			  context2(skSchema)
+		{
+			LoggingKit::setLevel(LoggingKit::CRIT);
+			context1.libev = bg1.safe;
+			context1.libuv = bg1.libuv_loop;
+			context1.initialize();
+			context2.libev = bg2.safe;
+			context2.libuv = bg2.libuv_loop;
+			context2.initialize();
+			balancedSocket = createUnixServer("tmp.balanced");
+			directSocket = createUnixServer("tmp.direct");
+
+			server1 = boost::make_shared<ServerType>(&context1, schema);
+			server1->initialize();
+			// Clients connecting to directSocket always end up in server1,
+			// which allows us to make server1 busier than server2.
+			server1->listen(directSocket);
+			server2 = boost::make_shared<ServerType>(&context2, schema);
+			server2->initialize();
+
+			loadBalancer.listen(balancedSocket);
+			loadBalancer.servers.push_back(server1.get());
+			loadBalancer.servers.push_back(server2.get());
+		}
+
+		~ServerKit_AcceptLoadBalancerTest() {
+			loadBalancer.shutdown();
+			clients.clear();
+			if (!bg1.isStarted()) {
+				bg1.start();
+			}
+			if (!bg2.isStarted()) {
+				bg2.start();
+			}
+			bg1.safe->runSync(boost::bind(&ServerType::shutdown, server1.get(), true));
+			bg2.safe->runSync(boost::bind(&ServerType::shutdown, server2.get(), true));
+			while (getServerState(bg1, server1) != ServerType::FINISHED_SHUTDOWN
+				|| getServerState(bg2, server2) != ServerType::FINISHED_SHUTDOWN)
+			{
+				syscalls::usleep(10000);
+			}
+			bg1.safe->runSync(boost::bind(&ServerKit_AcceptLoadBalancerTest::destroyServers,
+				this));
+			safelyClose(balancedSocket);
+			safelyClose(directSocket);
+			unlink("tmp.balanced");
+			unlink("tmp.direct");
+			LoggingKit::setLevel(LoggingKit::Level(DEFAULT_LOG_LEVEL));
+			bg1.stop();
+			bg2.stop();
+		}
+
+		void start() {
+			bg1.start();
+			bg2.start();
+			loadBalancer.start();
+		}
+
+		void destroyServers() {
+			server1.reset();
+			server2.reset();
+		}
+
+		static ServerType::State getServerState(BackgroundEventLoop &bg,
+			const boost::shared_ptr<ServerType> &server)
+		{
+			ServerType::State result;
+			bg.safe->runSync(boost::bind(_getServerState, server.get(), &result));
+			return result;
+		}
+
+		static void _getServerState(ServerType *server, ServerType::State *result) {
+			*result = server->serverState;
+		}
+
+		void connect(const char *filename, unsigned int count) {
+			for (unsigned int i = 0; i < count; i++) {
+				clients.push_back(FileDescriptor(
+					connectToUnixServer(filename, __FILE__, __LINE__), NULL, 0));
+			}
+		}
+	};
+
+	DEFINE_TEST_GROUP(ServerKit_AcceptLoadBalancerTest);
+
+	TEST_METHOD(1) {
+		set_test_name("Server::getActiveClientCountFromAnyThread() reflects the number of active clients");
+
+		start();
+		ensure_equals(server1->getActiveClientCountFromAnyThread(), 0u);
+		connect("tmp.direct", 2);
+		EVENTUALLY(5,
+			result = server1->getActiveClientCountFromAnyThread() == 2u;
+		);
+		clients.pop_back();
+		EVENTUALLY(5,
+			result = server1->getActiveClientCountFromAnyThread() == 1u;
+		);
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("In round-robin mode, clients are distributed evenly regardless of load");
+
+		start();
+		connect("tmp.direct", 3);
+		EVENTUALLY(5,
+			result = server1->getActiveClientCountFromAnyThread() == 3u;
+		);
+
+		connect("tmp.balanced", 4);
+		EVENTUALLY(5,
+			result = server1->getActiveClientCountFromAnyThread() == 5u
+				&& server2->getActiveClientCountFromAnyThread() == 2u;
+		);
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("In least-loaded mode, clients are given to the least busy server");
+
+		loadBalancer.distributionMode = AcceptLoadBalancer<ServerType>::LEAST_LOADED;
+		start();
+		connect("tmp.direct", 3);
+		EVENTUALLY(5,
+			result = server1->getActiveClientCountFromAnyThread() == 3u;
+		);
+
+		connect("tmp.balanced", 3);
+		EVENTUALLY(5,
+			result = server2->getActiveClientCountFromAnyThread() == 3u;
+		);
+		SHOULD_NEVER_HAPPEN(100,
+			result = server1->getActiveClientCountFromAnyThread() != 3u;
+		);
+	}
+}
@@ -0,0 +1,197 @@
+#include <TestSupport.h>
+#include <BackgroundEventLoop.h>
+#include <ServerKit/FdSourceChannel.h>
+#include <Constants.h>
+#include <Utils.h>
+#include <Utils/IOUtils.h>
+
+using namespace Passenger;
+using namespace Passenger::ServerKit;
+using namespace Passenger::MemoryKit;
+using namespace std;
+
+namespace tut {
+	struct ServerKit_FdSourceChannelTest: public ServerKit::Hooks {
+		BackgroundEventLoop bg;
+		ServerKit::Schema skSchema;
+		ServerKit::Context context;
+		FdSourceChannel channel;
+		SocketPair sockets;
+		boost::mutex syncher;
+		string data;
+		bool eof;
+		bool consumeAsynchronously;
+		unsigned int smallBuffers, buffers;
+
+		ServerKit_FdSourceChannelTest()
+			: bg(false, true),
+			  context(skSchema),
+			  channel(&context)
+		{
+			context.libev = bg.safe;
+			context.libuv = bg.libuv_loop;
+			context.initialize();
+			Hooks::impl = NULL;
+			Hooks::userData = this;
+			channel.setHooks(this);
+			channel.setDataCallback(onData);
+			eof = false;
+			consumeAsynchronously = false;
+			smallBuffers = 0;
+			buffers = 0;
+			bg.start();
+		}
+
+		~ServerKit_FdSourceChannelTest() {
+			bg.safe->runSync(boost::bind(&FdSourceChannel::deinitialize, &channel));
+			bg.stop();
+		}
+
+		static Channel::Result onData(Channel *_channel, const mbuf &buffer, int errcode) {
+			FdSourceChannel *channel = reinterpret_cast<FdSourceChannel *>(_channel);
+			ServerKit_FdSourceChannelTest *self = static_cast<ServerKit_FdSourceChannelTest *>(
+				channel->getHooks()->userData);
+			boost::lock_guard<boost::mutex> l(self->syncher);
+
+			if (buffer.empty()) {
+				self->eof = true;
+				return Channel::Result(0, true);
+			}
+
+			self->data.append(buffer.start, buffer.size());
+			self->buffers++;
+			if (buffer.mbuf_block->pool == &self->context.small_mbuf_pool) {
+				self->smallBuffers++;
+			}
+			if (self->consumeAsynchronously) {
+				self->bg.safe->runLater(boost::bind(&FdSourceChannel::consumed,
+					channel, (unsigned int) buffer.size(), false));
+				return Channel::Result(-1, false);
+			} else {
+				return Channel::Result(buffer.size(), false);
+			}
+		}
+
+		void startReading() {
+			bg.safe->runSync(boost::bind(&ServerKit_FdSourceChannelTest::startReadingInLoop,
+				this));
+		}
+
+		void startReadingInLoop() {
+			eof = false;
+			data.clear();
+			smallBuffers = 0;
+			buffers = 0;
+			channel.deinitialize();
+			channel.reinitialize(sockets.first);
+			channel.startReading();
+		}
+
+		// Writes all input before the channel starts reading, so that
+		// the number of read calls is deterministic.
+		string readAllThroughChannel(const string &input) {
+			sockets = createUnixSocketPair(__FILE__, __LINE__);
+			writeExact(sockets.second, input);
+			sockets.second.close();
+			startReading();
+			EVENTUALLY(5,
+				boost::lock_guard<boost::mutex> l(syncher);
+				result = eof;
+			);
+			boost::lock_guard<boost::mutex> l(syncher);
+			return data;
+		}
+
+		unsigned int getReadCalls() {
+			unsigned int result;
+			bg.safe->runSync(boost::bind(&ServerKit_FdSourceChannelTest::getReadCallsInLoop,
+				this, &result));
+			return result;
+		}
+
+		void getReadCallsInLoop(unsigned int *result) {
+			*result = channel.getReadCalls();
+		}
+
+		unsigned int getReadSizeEstimate() {
+			unsigned int result;
+			bg.safe->runSync(boost::bind(&ServerKit_FdSourceChannelTest::getReadSizeEstimateInLoop,
+				this, &result));
+			return result;
+		}
+
+		void getReadSizeEstimateInLoop(unsigned int *result) {
+			*result = channel.getReadSizeEstimate();
+		}
+
+		void reinitializeInLoop() {
+			channel.deinitialize();
+			channel.reinitialize(sockets.first);
+		}
+	};
+
+	DEFINE_TEST_GROUP(ServerKit_FdSourceChannelTest);
+
+	TEST_METHOD(1) {
+		set_test_name("It feeds all data in order, followed by EOF");
+		string input;
+		for (unsigned int i = 0; i < 5000; i++) {
+			input.append(toString(i));
+			input.append(1, ',');
+		}
+		ensure_equals(readAllThroughChannel(input), input);
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("Large amounts of data are read with fewer calls than with fixed-size reads");
+		string input(64 * 1024, 'x');
+
+		channel.adaptiveReadSizing = false;
+		ensure_equals("(1)", readAllThroughChannel(input), input);
+		unsigned int fixedReadCalls = getReadCalls();
+
+		channel.adaptiveReadSizing = true;
+		ensure_equals("(2)", readAllThroughChannel(input), input);
+		unsigned int adaptiveReadCalls = getReadCalls();
+
+		ensure("(3)", fixedReadCalls > input.size() / DEFAULT_MBUF_CHUNK_SIZE);
+		ensure("(4)", adaptiveReadCalls * 2 < fixedReadCalls);
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("Once the history shows small reads, the small mbuf pool is used");
+		string input(100, 'x');
+
+		ensure_equals("(1)", readAllThroughChannel(input), input);
+		ensure_equals("(2)", smallBuffers, 0u);
+
+		ensure_equals("(3)", readAllThroughChannel(input), input);
+		ensure_equals("(4)", smallBuffers, 1u);
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("Data read with readv() is fed in order when the consumer is asynchronous");
+		string input;
+		for (unsigned int i = 0; i < 10000; i++) {
+			input.append(toString(i));
+			input.append(1, ',');
+		}
+		consumeAsynchronously = true;
+
+		ensure_equals("(1)", readAllThroughChannel(input), input);
+		ensure("(2)", buffers > getReadCalls());
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("The read size estimate does not carry over to the next fd");
+		string input(64 * 1024, 'x');
+
+		ensure_equals("(1)", readAllThroughChannel(input), input);
+		ensure("(2)", getReadSizeEstimate() > DEFAULT_MBUF_CHUNK_SIZE);
+
+		sockets = createUnixSocketPair(__FILE__, __LINE__);
+		bg.safe->runSync(boost::bind(&ServerKit_FdSourceChannelTest::reinitializeInLoop,
+			this));
+		ensure_equals("(3)", getReadSizeEstimate(), 0u);
+	}
+}
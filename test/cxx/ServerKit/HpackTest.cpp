@@ -0,0 +1,224 @@
+#include <TestSupport.h>
+#include <ServerKit/Hpack.h>
+
+using namespace Passenger;
+using namespace Passenger::ServerKit;
+using namespace std;
+
+namespace tut {
+	struct ServerKit_HpackTest {
+		HpackDecoder decoder;
+		HpackHeaderList headers;
+
+		static string fromHex(const char *hex) {
+			string result;
+			unsigned int value = 0;
+			bool high = true;
+
+			for (; *hex != '\0'; hex++) {
+				if (*hex == ' ') {
+					continue;
+				}
+				unsigned int nibble = (*hex >= 'a') ? (*hex - 'a' + 10) : (*hex - '0');
+				if (high) {
+					value = nibble << 4;
+				} else {
+					result.append(1, (char) (value | nibble));
+				}
+				high = !high;
+			}
+			return result;
+		}
+
+		bool decode(const char *hex) {
+			string data = fromHex(hex);
+			headers.clear();
+			return decoder.decode(data.data(), data.size(), headers);
+		}
+
+		size_t decodeInteger(const char *hex, unsigned int prefixBits) {
+			string data = fromHex(hex);
+			const unsigned char *pos = (const unsigned char *) data.data();
+			const unsigned char *end = pos + data.size();
+			size_t result;
+
+			ensure("Integer is valid", HpackDecoder::decodeInteger(&pos, end, prefixBits, &result));
+			ensure("The entire integer is consumed", pos == end);
+			return result;
+		}
+
+		void ensureHeader(unsigned int index, const string &name, const string &value) {
+			string prefix = "Header " + toString(index);
+			ensure((prefix + " exists").c_str(), index < headers.size());
+			ensure_equals((prefix + " name").c_str(), headers[index].first, name);
+			ensure_equals((prefix + " value").c_str(), headers[index].second, value);
+		}
+	};
+
+	DEFINE_TEST_GROUP(ServerKit_HpackTest);
+
+	TEST_METHOD(1) {
+		set_test_name("Integers are decoded as in RFC 7541 appendix C.1");
+		ensure_equals(decodeInteger("0a", 5), 10u);
+		ensure_equals(decodeInteger("1f 9a 0a", 5), 1337u);
+		ensure_equals(decodeInteger("2a", 8), 42u);
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("Integers are encoded as in RFC 7541 appendix C.1");
+		string output;
+
+		HpackEncoder::encodeInteger(output, 0, 5, 10);
+		ensure_equals(output, fromHex("0a"));
+
+		output.clear();
+		HpackEncoder::encodeInteger(output, 0, 5, 1337);
+		ensure_equals(output, fromHex("1f 9a 0a"));
+
+		output.clear();
+		HpackEncoder::encodeInteger(output, 0, 8, 42);
+		ensure_equals(output, fromHex("2a"));
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("Truncated and overlong integers are rejected");
+		string data = fromHex("1f 9a");
+		const unsigned char *pos = (const unsigned char *) data.data();
+		size_t result;
+
+		ensure(!HpackDecoder::decodeInteger(&pos, pos + data.size(), 5, &result));
+
+		data = fromHex("1f ff ff ff ff ff ff 01");
+		pos = (const unsigned char *) data.data();
+		ensure(!HpackDecoder::decodeInteger(&pos, pos + data.size(), 5, &result));
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("Request examples without Huffman coding (RFC 7541 appendix C.3)");
+
+		ensure("(1)", decode("8286 8441 0f77 7777 2e65 7861 6d70 6c65 2e63 6f6d"));
+		ensure_equals(headers.size(), 4u);
+		ensureHeader(0, ":method", "GET");
+		ensureHeader(1, ":scheme", "http");
+		ensureHeader(2, ":path", "/");
+		ensureHeader(3, ":authority", "www.example.com");
+		ensure_equals(decoder.getDynamicTableSize(), 57u);
+
+		ensure("(2)", decode("8286 84be 5808 6e6f 2d63 6163 6865"));
+		ensure_equals(headers.size(), 5u);
+		ensureHeader(3, ":authority", "www.example.com");
+		ensureHeader(4, "cache-control", "no-cache");
+		ensure_equals(decoder.getDynamicTableSize(), 110u);
+
+		ensure("(3)", decode("8287 85bf 400a 6375 7374 6f6d 2d6b 6579 0c63 7573 746f 6d2d 7661 6c75 65"));
+		ensure_equals(headers.size(), 5u);
+		ensureHeader(1, ":scheme", "https");
+		ensureHeader(2, ":path", "/index.html");
+		ensureHeader(3, ":authority", "www.example.com");
+		ensureHeader(4, "custom-key", "custom-value");
+		ensure_equals(decoder.getDynamicTableSize(), 164u);
+		ensure_equals(decoder.getDynamicTableEntryCount(), 3u);
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("Request examples with Huffman coding (RFC 7541 appendix C.4)");
+
+		ensure("(1)", decode("8286 8441 8cf1 e3c2 e5f2 3a6b a0ab 90f4 ff"));
+		ensureHeader(3, ":authority", "www.example.com");
+		ensure_equals(decoder.getDynamicTableSize(), 57u);
+
+		ensure("(2)", decode("8286 84be 5886 a8eb 1064 9cbf"));
+		ensureHeader(4, "cache-control", "no-cache");
+		ensure_equals(decoder.getDynamicTableSize(), 110u);
+
+		ensure("(3)", decode("8287 85bf 4088 25a8 49e9 5ba9 7d7f 8925 a849 e95b b8e8 b4bf"));
+		ensureHeader(2, ":path", "/index.html");
+		ensureHeader(4, "custom-key", "custom-value");
+		ensure_equals(decoder.getDynamicTableSize(), 164u);
+	}
+
+	TEST_METHOD(6) {
+		set_test_name("Invalid Huffman padding is rejected");
+		string data, result;
+
+		// "a" is 00011, padded with zeroes instead of ones.
+		data = fromHex("18");
+		ensure("(1)", !HpackDecoder::decodeHuffman((const unsigned char *) data.data(),
+			data.size(), result));
+
+		// More than 7 bits of padding.
+		data = fromHex("1f ff");
+		ensure("(2)", !HpackDecoder::decodeHuffman((const unsigned char *) data.data(),
+			data.size(), result));
+
+		data = fromHex("1f");
+		result.clear();
+		ensure("(3)", HpackDecoder::decodeHuffman((const unsigned char *) data.data(),
+			data.size(), result));
+		ensure_equals(result, "a");
+	}
+
+	TEST_METHOD(7) {
+		set_test_name("Invalid header blocks are rejected");
+		ensure("Index 0", !decode("80"));
+		ensure("Index beyond the dynamic table", !decode("be"));
+		ensure("Truncated literal", !decode("400a 6375 7374"));
+		ensure("Table size update larger than allowed", !decode("3fe2 1f"));
+		ensure("Table size update after a header", !decode("82 20"));
+	}
+
+	TEST_METHOD(8) {
+		set_test_name("Dynamic table size updates evict entries");
+		ensure("(1)", decode("8286 8441 0f77 7777 2e65 7861 6d70 6c65 2e63 6f6d"));
+		ensure_equals(decoder.getDynamicTableEntryCount(), 1u);
+		ensure("(2)", decode("20 82"));
+		ensure_equals(decoder.getDynamicTableEntryCount(), 0u);
+		ensure_equals(decoder.getDynamicTableSize(), 0u);
+		ensureHeader(0, ":method", "GET");
+	}
+
+	TEST_METHOD(9) {
+		set_test_name("Encoded headers decode to the original headers");
+		string block;
+
+		HpackEncoder::encode(block, ":status", "200");
+		HpackEncoder::encode(block, ":status", "418");
+		HpackEncoder::encode(block, "content-type", "text/plain");
+		HpackEncoder::encode(block, "x-custom", "hello world");
+		ensure(decoder.decode(block.data(), block.size(), headers));
+		ensure_equals(headers.size(), 4u);
+		ensureHeader(0, ":status", "200");
+		ensureHeader(1, ":status", "418");
+		ensureHeader(2, "content-type", "text/plain");
+		ensureHeader(3, "x-custom", "hello world");
+		ensure_equals("The encoder does not use the dynamic table",
+			decoder.getDynamicTableEntryCount(), 0u);
+		ensure_equals("Indexed representation is used for full matches",
+			block[0], (char) 0x88);
+	}
+
+	TEST_METHOD(10) {
+		set_test_name("Header blocks that decode to too large header lists are rejected");
+		string block, value(4000, 'x');
+
+		// A literal with incremental indexing, followed by many
+		// 1-byte references to the resulting dynamic table entry.
+		block.append(1, (char) 0x40);
+		HpackEncoder::encodeInteger(block, 0, 7, 1);
+		block.append("a");
+		HpackEncoder::encodeInteger(block, 0, 7, value.size());
+		block.append(value);
+		block.append(100, (char) 0xbe);
+
+		ensure("(1)", !decoder.decode(block.data(), block.size(), headers));
+		ensure("(2)", headers.size() * (value.size() + 1 + 32)
+			<= HpackDecoder::DEFAULT_MAX_HEADER_LIST_SIZE);
+
+		HpackDecoder smallDecoder(HpackDecoder::DEFAULT_MAX_DYNAMIC_TABLE_SIZE, 100);
+		headers.clear();
+		ensure("(3)", smallDecoder.decode("\x82\x86", 2, headers));
+		ensure_equals("(4)", headers.size(), 2u);
+		headers.clear();
+		ensure("(5)", !smallDecoder.decode("\x82\x86\x84", 3, headers));
+	}
+}
@@ -0,0 +1,215 @@
+#include <TestSupport.h>
+#include <ServerKit/HttpCharScanner.h>
+#include <ServerKit/http_parser.h>
+#include <cstring>
+
+using namespace Passenger;
+using namespace Passenger::ServerKit;
+using namespace std;
+
+namespace tut {
+	struct ServerKit_HttpCharScannerTest {
+		HttpCharScannerLevel origLevel;
+		string parsed;
+
+		ServerKit_HttpCharScannerTest() {
+			origLevel = httpCharScannerGetLevel();
+		}
+
+		~ServerKit_HttpCharScannerTest() {
+			httpCharScannerSetLevel(origLevel);
+		}
+
+		static int onHeaderField(http_parser *parser, const char *data, size_t len) {
+			ServerKit_HttpCharScannerTest *self =
+				static_cast<ServerKit_HttpCharScannerTest *>(parser->data);
+			self->parsed.append("F[");
+			self->parsed.append(data, len);
+			self->parsed.append("]");
+			return 0;
+		}
+
+		static int onHeaderValue(http_parser *parser, const char *data, size_t len) {
+			ServerKit_HttpCharScannerTest *self =
+				static_cast<ServerKit_HttpCharScannerTest *>(parser->data);
+			self->parsed.append("V[");
+			self->parsed.append(data, len);
+			self->parsed.append("]");
+			return 0;
+		}
+
+		static int onHeadersComplete(http_parser *parser) {
+			ServerKit_HttpCharScannerTest *self =
+				static_cast<ServerKit_HttpCharScannerTest *>(parser->data);
+			self->parsed.append("$");
+			return 0;
+		}
+
+		// Feeds the data to http_parser in chunks of the given size and
+		// returns the sequence of callbacks, merged per header.
+		string parse(const string &data, size_t chunkSize, enum http_errno *error = NULL) {
+			http_parser parser;
+			http_parser_settings settings;
+			size_t pos = 0;
+
+			memset(&settings, 0, sizeof(settings));
+			settings.on_header_field = onHeaderField;
+			settings.on_header_value = onHeaderValue;
+			settings.on_headers_complete = onHeadersComplete;
+			http_parser_init(&parser, HTTP_REQUEST);
+			parser.data = this;
+			parsed.clear();
+
+			while (pos < data.size() && HTTP_PARSER_ERRNO(&parser) == HPE_OK) {
+				size_t size = std::min(chunkSize, data.size() - pos);
+				http_parser_execute(&parser, &settings, data.data() + pos, size);
+				pos += size;
+			}
+			if (error != NULL) {
+				*error = HTTP_PARSER_ERRNO(&parser);
+			}
+
+			string result;
+			string::size_type i = 0;
+			char lastType = '\0';
+			while (i < parsed.size()) {
+				if (parsed[i] == '$') {
+					result.append(1, '$');
+					i++;
+				} else {
+					char type = parsed[i];
+					string::size_type end = parsed.find(']', i);
+					if (type != lastType) {
+						lastType = type;
+						result.append("\n");
+						result.append(1, type);
+						result.append(":");
+					}
+					result.append(parsed, i + 2, end - i - 2);
+					i = end + 1;
+				}
+			}
+			return result;
+		}
+
+		vector<HttpCharScannerLevel> supportedLevels() {
+			vector<HttpCharScannerLevel> result;
+			HttpCharScannerLevel max = httpCharScannerDetectLevel();
+			result.push_back(HCS_SCALAR);
+			if (max >= HCS_SSE42) {
+				result.push_back(HCS_SSE42);
+			}
+			if (max >= HCS_AVX2) {
+				result.push_back(HCS_AVX2);
+			}
+			return result;
+		}
+	};
+
+	DEFINE_TEST_GROUP(ServerKit_HttpCharScannerTest);
+
+	TEST_METHOD(1) {
+		set_test_name("httpFindHeaderValueEnd() finds CR and LF at any position");
+		vector<HttpCharScannerLevel> levels = supportedLevels();
+
+		for (unsigned int i = 0; i < levels.size(); i++) {
+			httpCharScannerSetLevel(levels[i]);
+			string prefix = string("level ") + httpCharScannerLevelToString(levels[i]);
+
+			for (size_t size = 0; size < 80; size++) {
+				string data(size, 'x');
+				ensure((prefix + ": no delimiter").c_str(),
+					httpFindHeaderValueEnd(data.data(), data.data() + size) == data.data() + size);
+
+				for (size_t pos = 0; pos < size; pos++) {
+					data[pos] = (pos % 2 == 0) ? '\r' : '\n';
+					if (pos > 0) {
+						data[pos - 1] = '\xff';
+					}
+					ensure_equals((prefix + ": delimiter at " + toString(pos)).c_str(),
+						httpFindHeaderValueEnd(data.data(), data.data() + size) - data.data(),
+						(ptrdiff_t) pos);
+				}
+			}
+		}
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("httpSkipHeaderFieldChars() behaves the same at every level");
+		vector<HttpCharScannerLevel> levels = supportedLevels();
+		string data(40, 'a');
+
+		for (unsigned int ch = 0; ch < 256; ch++) {
+			for (size_t pos = 0; pos < data.size(); pos += 3) {
+				data.assign(40, 'a');
+				data[pos] = (char) ch;
+
+				httpCharScannerSetLevel(HCS_SCALAR);
+				const char *expected = httpSkipHeaderFieldChars(data.data(),
+					data.data() + data.size());
+				if ((ch >= 'a' && ch <= 'z') || (ch >= '0' && ch <= '9') || ch == '-') {
+					ensure(expected == data.data() + data.size());
+				} else if (ch == ':' || ch == ' ' || ch == '\r' || ch == '(' || ch >= 0x80) {
+					ensure(expected == data.data() + pos);
+				}
+
+				for (unsigned int i = 1; i < levels.size(); i++) {
+					httpCharScannerSetLevel(levels[i]);
+					ensure_equals(("char " + toString(ch) + " at " + toString(pos)
+						+ ", level " + httpCharScannerLevelToString(levels[i])).c_str(),
+						httpSkipHeaderFieldChars(data.data(), data.data() + data.size()),
+						expected);
+				}
+			}
+		}
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("http_parser yields the same headers at every level and chunk size");
+		vector<HttpCharScannerLevel> levels = supportedLevels();
+		string request =
+			"GET /foo HTTP/1.1\r\n"
+			"Host: www.example.com\r\n"
+			"X-A-Rather-Long-Header-Name_With~Rare|Chars: value\r\n"
+			"Content-Type: text/plain; charset=utf-8, with a long value\r\n"
+			"Connection: keep-alive\r\n"
+			"X-Empty:\r\n"
+			"X-Folded: first line\r\n"
+			"  continued\r\n"
+			"Cookie: " + string(100, 'c') + "\r\n"
+			"\r\n";
+
+		httpCharScannerSetLevel(HCS_SCALAR);
+		string expected = parse(request, request.size());
+		ensure(containsSubstring(expected,
+			"F:X-A-Rather-Long-Header-Name_With~Rare|Chars\nV:value\n"));
+		ensure(containsSubstring(expected,
+			"F:Content-Type\nV:text/plain; charset=utf-8, with a long value\n"));
+		ensure(containsSubstring(expected, "V:" + string(100, 'c') + "$"));
+
+		for (unsigned int i = 0; i < levels.size(); i++) {
+			httpCharScannerSetLevel(levels[i]);
+			for (size_t chunkSize = 1; chunkSize <= request.size(); chunkSize++) {
+				ensure_equals(("level " + string(httpCharScannerLevelToString(levels[i]))
+					+ ", chunk size " + toString(chunkSize)).c_str(),
+					parse(request, chunkSize), expected);
+			}
+		}
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("Bulk scanning does not bypass the maximum header size");
+		vector<HttpCharScannerLevel> levels = supportedLevels();
+		string request = "GET / HTTP/1.1\r\n"
+			"X-Big: " + string(HTTP_MAX_HEADER_SIZE, 'x') + "\r\n\r\n";
+		enum http_errno error;
+
+		for (unsigned int i = 0; i < levels.size(); i++) {
+			httpCharScannerSetLevel(levels[i]);
+			parse(request, request.size(), &error);
+			ensure_equals(error, HPE_HEADER_OVERFLOW);
+			parse(request, 4096, &error);
+			ensure_equals(error, HPE_HEADER_OVERFLOW);
+		}
+	}
+}
@@ -487,9 +487,122 @@ namespace tut {
 			} while (true);
 			return result;
 		}
+
+		void enableHttp2() {
+			Json::Value updates;
+			vector<ConfigKit::Error> errors;
+			MyServer::ConfigChangeRequest req;
+
+			updates["http2"] = true;
+			ensure(server->prepareConfigChange(updates, errors, req));
+			server->commitConfigChange(req);
+		}
+
+		static string http2Frame(Http2Session::FrameType type, unsigned char flags,
+			unsigned int streamId, const string &payload = string())
+		{
+			char header[9];
+			header[0] = (payload.size() >> 16) & 0xff;
+			header[1] = (payload.size() >> 8) & 0xff;
+			header[2] = payload.size() & 0xff;
+			header[3] = type;
+			header[4] = flags;
+			header[5] = (streamId >> 24) & 0x7f;
+			header[6] = (streamId >> 16) & 0xff;
+			header[7] = (streamId >> 8) & 0xff;
+			header[8] = streamId & 0xff;
+			return string(header, sizeof(header)) + payload;
+		}
+
+		static string http2RequestHeaders(const char *method, const char *path,
+			const char *extraName = NULL, const char *extraValue = NULL)
+		{
+			string block;
+			HpackEncoder::encode(block, ":method", method);
+			HpackEncoder::encode(block, ":scheme", "http");
+			HpackEncoder::encode(block, ":path", path);
+			HpackEncoder::encode(block, ":authority", "foo");
+			if (extraName != NULL) {
+				HpackEncoder::encode(block, extraName, extraValue);
+			}
+			return block;
+		}
+
+		void sendHttp2Preface() {
+			sendRequest(P_STATIC_STRING("PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n")
+				+ http2Frame(Http2Session::SETTINGS_FRAME, 0, 0));
+		}
+
+		struct Http2Frame {
+			unsigned int type;
+			unsigned int flags;
+			unsigned int streamId;
+			string payload;
+		};
+
+		Http2Frame readHttp2Frame() {
+			unsigned char header[9];
+			Http2Frame frame;
+
+			unsigned int size;
+
+			ensure_equals("Frame header received",
+				io.read(header, sizeof(header)), (unsigned int) sizeof(header));
+			frame.type = header[3];
+			frame.flags = header[4];
+			frame.streamId = ((header[5] & 0x7f) << 24) | (header[6] << 16)
+				| (header[7] << 8) | header[8];
+			size = (header[0] << 16) | (header[1] << 8) | header[2];
+			frame.payload.resize(size);
+			if (size > 0) {
+				ensure_equals("Frame payload received",
+					io.read(&frame.payload[0], size), size);
+			}
+			return frame;
+		}
+
+		/**
+		 * Reads frames until the given stream ends, and returns the decoded
+		 * response headers and the response body.
+		 */
+		void readHttp2Response(unsigned int streamId, HpackHeaderList &headers, string &body) {
+			HpackDecoder decoder;
+			bool done = false;
+
+			while (!done) {
+				Http2Frame frame = readHttp2Frame();
+				if (frame.streamId != streamId) {
+					continue;
+				}
+				switch (frame.type) {
+				case Http2Session::HEADERS_FRAME:
+					ensure("Response headers are valid", decoder.decode(frame.payload.data(),
+						frame.payload.size(), headers));
+					break;
+				case Http2Session::DATA_FRAME:
+					body.append(frame.payload);
+					done = frame.flags & Http2Session::END_STREAM_FLAG;
+					break;
+				case Http2Session::WINDOW_UPDATE_FRAME:
+					break;
+				default:
+					fail(("Unexpected frame type " + toString(frame.type)).c_str());
+				}
+			}
+		}
+
+		static string lookupHeader(const HpackHeaderList &headers, const string &name) {
+			HpackHeaderList::const_iterator it;
+			for (it = headers.begin(); it != headers.end(); it++) {
+				if (it->first == name) {
+					return it->second;
+				}
+			}
+			return string();
+		}
 	};
 
-	DEFINE_TEST_GROUP_WITH_LIMIT(ServerKit_HttpServerTest, 100);
+	DEFINE_TEST_GROUP_WITH_LIMIT(ServerKit_HttpServerTest, 110);
 
 
 	/***** Valid HTTP header parsing *****/
@@ -1744,4 +1857,157 @@ namespace tut {
 			result = getActiveClientCount() == 0;
 		);
 	}
+
+
+	/***** HTTP/2 *****/
+
+	TEST_METHOD(98) {
+		set_test_name("HTTP/2 support is disabled by default");
+
+		connectToServer();
+		sendRequest("PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n");
+		string header = readResponseHeader();
+		ensure(containsSubstring(header, "Status: 400 Bad Request\r\n"));
+	}
+
+	TEST_METHOD(99) {
+		set_test_name("HTTP/2 requests with prior knowledge are processed");
+
+		enableHttp2();
+		connectToServer();
+		sendHttp2Preface();
+		sendRequest(http2Frame(Http2Session::HEADERS_FRAME,
+			Http2Session::END_HEADERS_FLAG | Http2Session::END_STREAM_FLAG, 1,
+			http2RequestHeaders("GET", "/hello", "foo", "bar")));
+
+		Http2Frame frame = readHttp2Frame();
+		ensure_equals("The server sends its settings first",
+			frame.type, (unsigned int) Http2Session::SETTINGS_FRAME);
+		ensure("The server advertises its maximum header list size",
+			containsSubstring(frame.payload,
+				string(1, '\0') + (char) Http2Session::SETTINGS_MAX_HEADER_LIST_SIZE));
+
+		HpackHeaderList headers;
+		string body;
+		readHttp2Response(1, headers, body);
+		ensure_equals(lookupHeader(headers, ":status"), "200");
+		ensure_equals(lookupHeader(headers, "content-type"), "text/plain");
+		ensure_equals("Connection-specific headers are removed",
+			lookupHeader(headers, "connection"), "");
+		ensure_equals(body, "hello /hello\nFoo: bar");
+	}
+
+	TEST_METHOD(100) {
+		set_test_name("HTTP/2 request bodies are forwarded");
+
+		enableHttp2();
+		connectToServer();
+		sendHttp2Preface();
+		sendRequest(http2Frame(Http2Session::HEADERS_FRAME,
+			Http2Session::END_HEADERS_FLAG, 1,
+			http2RequestHeaders("POST", "/body_test")));
+		sendRequest(http2Frame(Http2Session::DATA_FRAME, 0, 1, "hello "));
+		sendRequest(http2Frame(Http2Session::DATA_FRAME,
+			Http2Session::END_STREAM_FLAG, 1, "world"));
+
+		HpackHeaderList headers;
+		string body;
+		readHttp2Response(1, headers, body);
+		ensure_equals(lookupHeader(headers, ":status"), "200");
+		ensure_equals(body, "11 bytes: hello world");
+	}
+
+	TEST_METHOD(101) {
+		set_test_name("HTTP/2 PING frames are acknowledged");
+
+		enableHttp2();
+		connectToServer();
+		sendHttp2Preface();
+		sendRequest(http2Frame(Http2Session::PING_FRAME, 0, 0, "12345678"));
+
+		Http2Frame frame;
+		do {
+			frame = readHttp2Frame();
+		} while (frame.type != Http2Session::PING_FRAME);
+		ensure_equals(frame.flags, (unsigned int) Http2Session::ACK_FLAG);
+		ensure_equals(frame.payload, "12345678");
+	}
+
+	TEST_METHOD(102) {
+		set_test_name("HTTP/2 connection errors result in GOAWAY and a disconnect");
+
+		enableHttp2();
+		connectToServer();
+		sendHttp2Preface();
+		sendRequest(http2Frame(Http2Session::DATA_FRAME, 0, 0, "x"));
+
+		Http2Frame frame;
+		do {
+			frame = readHttp2Frame();
+		} while (frame.type != Http2Session::GOAWAY_FRAME);
+		ensure_equals(frame.payload.size(), 8u);
+		ensure_equals("PROTOCOL_ERROR", frame.payload[7], (char) Http2Session::PROTOCOL_ERROR);
+		ensure_equals("The connection is closed", io.readAll(), "");
+	}
+
+	TEST_METHOD(103) {
+		set_test_name("HTTP/2 responses to HEAD requests have no body");
+
+		enableHttp2();
+		connectToServer();
+		sendHttp2Preface();
+		sendRequest(http2Frame(Http2Session::HEADERS_FRAME,
+			Http2Session::END_HEADERS_FLAG | Http2Session::END_STREAM_FLAG, 1,
+			http2RequestHeaders("HEAD", "/")));
+
+		HpackHeaderList headers;
+		string body;
+		readHttp2Response(1, headers, body);
+		ensure_equals(lookupHeader(headers, ":status"), "200");
+		ensure_equals(lookupHeader(headers, "content-length"), "7");
+		ensure_equals(body, "");
+	}
+
+	TEST_METHOD(104) {
+		set_test_name("The HTTP/2 connection preface may arrive in multiple parts");
+
+		enableHttp2();
+		connectToServer();
+		sendRequestAndWait("P");
+		sendRequestAndWait("RI * HTTP/2.0\r\n");
+		sendRequest(P_STATIC_STRING("\r\nSM\r\n\r\n")
+			+ http2Frame(Http2Session::SETTINGS_FRAME, 0, 0)
+			+ http2Frame(Http2Session::HEADERS_FRAME,
+				Http2Session::END_HEADERS_FLAG | Http2Session::END_STREAM_FLAG, 1,
+				http2RequestHeaders("GET", "/hello")));
+
+		HpackHeaderList headers;
+		string body;
+		readHttp2Response(1, headers, body);
+		ensure_equals(lookupHeader(headers, ":status"), "200");
+		ensure_equals(body, "hello /hello");
+	}
+
+	TEST_METHOD(105) {
+		set_test_name("HTTP/1 requests that begin like the HTTP/2 connection preface"
+			" are processed as HTTP/1");
+
+		enableHttp2();
+		connectToServer();
+		sendRequestAndWait("P");
+		sendRequest(
+			"UT / HTTP/1.1\r\n"
+			"Connection: close\r\n"
+			"Content-Length: 0\r\n"
+			"Host: foo\r\n\r\n");
+		string response = readAll(fd);
+		ensure_equals(response,
+			"HTTP/1.1 200 OK\r\n"
+			"Status: 200 OK\r\n"
+			"Content-Type: text/plain\r\n"
+			"Date: Thu, 11 Sep 2014 12:54:09 GMT\r\n"
+			"Connection: close\r\n"
+			"Content-Length: 7\r\n\r\n"
+			"hello /");
+	}
 }
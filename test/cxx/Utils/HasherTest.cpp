@@ -0,0 +1,73 @@
+#include <TestSupport.h>
+#include <Utils/Hasher.h>
+#include <DataStructures/HashedStaticString.h>
+#include <DataStructures/LString.h>
+
+using namespace Passenger;
+using namespace std;
+
+namespace tut {
+	struct Utils_HasherTest {
+		static boost::uint32_t hash(const string &data) {
+			XXHash32 h;
+			h.update(data.data(), data.size());
+			return h.finalize();
+		}
+	};
+
+	DEFINE_TEST_GROUP(Utils_HasherTest);
+
+	TEST_METHOD(1) {
+		set_test_name("XXHash32 produces the reference xxHash32 values");
+		ensure_equals(hash(""), 0x02CC5D05u);
+		ensure_equals(hash("a"), 0x550D7456u);
+		ensure_equals(hash("abc"), 0x32D153FFu);
+		ensure_equals(hash("content-type"), 0xECB9D206u);
+		ensure_equals(hash("x-forwarded-for-some-long-header-name"), 0x6AB15844u);
+		ensure_equals(hash("Nobody inspects the spammish repetition"), 0xE2293B2Fu);
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("Hashing in pieces yields the same value as hashing in one go");
+		string data;
+		for (unsigned int i = 0; i < 100; i++) {
+			data.append(1, (char) ('a' + i % 26));
+		}
+
+		for (size_t size = 0; size <= data.size(); size++) {
+			boost::uint32_t expected = hash(data.substr(0, size));
+			for (size_t chunkSize = 1; chunkSize <= 17; chunkSize++) {
+				XXHash32 h;
+				for (size_t pos = 0; pos < size; pos += chunkSize) {
+					h.update(data.data() + pos, std::min(chunkSize, size - pos));
+				}
+				ensure_equals(("size " + toString(size) + ", chunk size "
+					+ toString(chunkSize)).c_str(),
+					h.finalize(), expected);
+			}
+		}
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("reset() restores the initial state");
+		XXHash32 h;
+		h.update("some previous header name", 25);
+		h.reset();
+		h.update("abc", 3);
+		ensure_equals(h.finalize(), 0x32D153FFu);
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("HashedStaticString and LString hashes agree with the Hasher");
+		psg_pool_t *pool = psg_create_pool(PSG_DEFAULT_POOL_SIZE);
+		LString str;
+
+		psg_lstr_init(&str);
+		psg_lstr_append(&str, pool, "x-forwarded-", 12);
+		psg_lstr_append(&str, pool, "for", 3);
+		ensure_equals(psg_lstr_hash(&str), HashedStaticString("x-forwarded-for").hash());
+		ensure_equals(HashedStaticString().hash(), HashedStaticString("").hash());
+		psg_lstr_deinit(&str);
+		psg_destroy_pool(pool);
+	}
+}
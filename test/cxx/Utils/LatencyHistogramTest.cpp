@@ -0,0 +1,104 @@
+#include <TestSupport.h>
+#include <Utils/LatencyHistogram.h>
+
+using namespace Passenger;
+using namespace std;
+
+namespace tut {
+	struct Utils_LatencyHistogramTest {
+		LatencyHistogram histogram;
+	};
+
+	DEFINE_TEST_GROUP(Utils_LatencyHistogramTest);
+
+	TEST_METHOD(1) {
+		set_test_name("Small values have a bucket of their own");
+		for (unsigned int i = 0; i < 2 * LatencyHistogram::SUB_BUCKET_COUNT; i++) {
+			ensure_equals(LatencyHistogram::getBucketIndex(i), i);
+			ensure_equals(LatencyHistogram::getBucketLowerBound(i), i);
+			ensure_equals(LatencyHistogram::getBucketUpperBound(i), i);
+		}
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("Buckets are contiguous and every value falls within the bounds of its bucket");
+		boost::uint64_t expectedLowerBound = 0;
+		for (unsigned int i = 0; i < LatencyHistogram::BUCKET_COUNT; i++) {
+			boost::uint64_t lowerBound = LatencyHistogram::getBucketLowerBound(i);
+			boost::uint64_t upperBound = LatencyHistogram::getBucketUpperBound(i);
+			ensure_equals("(1)", lowerBound, expectedLowerBound);
+			ensure("(2)", upperBound >= lowerBound);
+			ensure_equals("(3)", LatencyHistogram::getBucketIndex(lowerBound), i);
+			ensure_equals("(4)", LatencyHistogram::getBucketIndex(upperBound), i);
+			// The relative error is bounded by the sub-bucket precision.
+			ensure("(5)", (upperBound - lowerBound) * LatencyHistogram::SUB_BUCKET_COUNT
+				<= std::max<boost::uint64_t>(lowerBound, LatencyHistogram::SUB_BUCKET_COUNT));
+			expectedLowerBound = upperBound + 1;
+		}
+		ensure("(6)", expectedLowerBound - 1 == LatencyHistogram::MAX_VALUE);
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("Values larger than MAX_VALUE are counted as MAX_VALUE");
+		boost::uint64_t maxValue = LatencyHistogram::MAX_VALUE;
+		histogram.record(maxValue * 10);
+		ensure_equals(histogram.getCount(), 1u);
+		ensure_equals(histogram.getMax(), maxValue);
+		ensure_equals(histogram.getValueAtPercentile(100), maxValue);
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("Percentiles are accurate within the bucket precision");
+		for (unsigned int i = 1; i <= 10000; i++) {
+			histogram.record(i * 100);
+		}
+		ensure_equals(histogram.getCount(), 10000u);
+		ensure_equals(histogram.getMin(), 100u);
+		ensure_equals(histogram.getMax(), 1000000u);
+		ensure_equals(histogram.getMean(), 500050.0);
+
+		boost::uint64_t p50 = histogram.getValueAtPercentile(50);
+		boost::uint64_t p99 = histogram.getValueAtPercentile(99);
+		ensure("p50 >= real value", p50 >= 500000);
+		ensure("p50 within precision", p50 <= 500000 + 500000 / 16);
+		ensure("p99 >= real value", p99 >= 990000);
+		ensure("p99 within precision", p99 <= 990000 + 990000 / 16);
+		ensure_equals("p100", histogram.getValueAtPercentile(100), 1000000u);
+		ensure_equals("p0", histogram.getValueAtPercentile(0),
+			LatencyHistogram::getBucketUpperBound(LatencyHistogram::getBucketIndex(100)));
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("Merging histograms yields the same result as recording into a single one");
+		LatencyHistogram other, combined;
+
+		for (unsigned int i = 0; i < 1000; i++) {
+			histogram.record(i);
+			combined.record(i);
+			other.record(i * 1000 + 5);
+			combined.record(i * 1000 + 5);
+		}
+		histogram.merge(other);
+		ensure_equals(histogram.getCount(), combined.getCount());
+		ensure_equals(histogram.getMin(), combined.getMin());
+		ensure_equals(histogram.getMax(), combined.getMax());
+		ensure_equals(histogram.getMean(), combined.getMean());
+		for (unsigned int p = 0; p <= 100; p += 5) {
+			ensure_equals(histogram.getValueAtPercentile(p),
+				combined.getValueAtPercentile(p));
+		}
+	}
+
+	TEST_METHOD(6) {
+		set_test_name("An empty histogram reports only its count");
+		Json::Value doc = histogram.inspectAsJson();
+		ensure_equals(doc["count"].asUInt64(), 0u);
+		ensure(!doc.isMember("p50"));
+		ensure_equals(histogram.getValueAtPercentile(50), 0u);
+
+		histogram.record(1500);
+		doc = histogram.inspectAsJson();
+		ensure_equals(doc["count"].asUInt64(), 1u);
+		ensure_equals(doc["p50"]["microseconds"].asUInt64(), 1500u);
+	}
+}